@@ -13,6 +13,7 @@
 
 #include "dxc/DXIL/DxilConstants.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -111,6 +112,10 @@ public:
   static const char kDxilSourceDefinesMDName[];
   static const char kDxilSourceMainFileNameMDName[];
   static const char kDxilSourceArgsMDName[];
+  // With -fembed-source-hash, a dx.source.contents entry holds this prefix
+  // followed by the lowercase hex MD5 of the file's text instead of the text
+  // itself; an external content-addressed store resolves the hash.
+  static const char kDxilSourceContentHashPrefix[];
 
   static const unsigned kDxilEntryPointNumFields  = 5;
   static const unsigned kDxilEntryPointFunction   = 0;  // Entry point function symbol.
@@ -298,19 +303,19 @@ public:
     ExtraPropertyHelper(llvm::Module *pModule);
     virtual ~ExtraPropertyHelper() {}
 
-    virtual void EmitSRVProperties(const DxilResource &SRV, std::vector<llvm::Metadata *> &MDVals) = 0;
+    virtual void EmitSRVProperties(const DxilResource &SRV, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals) = 0;
     virtual void LoadSRVProperties(const llvm::MDOperand &MDO, DxilResource &SRV) = 0;
 
-    virtual void EmitUAVProperties(const DxilResource &UAV, std::vector<llvm::Metadata *> &MDVals) = 0;
+    virtual void EmitUAVProperties(const DxilResource &UAV, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals) = 0;
     virtual void LoadUAVProperties(const llvm::MDOperand &MDO, DxilResource &UAV) = 0;
 
-    virtual void EmitCBufferProperties(const DxilCBuffer &CB, std::vector<llvm::Metadata *> &MDVals) = 0;
+    virtual void EmitCBufferProperties(const DxilCBuffer &CB, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals) = 0;
     virtual void LoadCBufferProperties(const llvm::MDOperand &MDO, DxilCBuffer &CB) = 0;
 
-    virtual void EmitSamplerProperties(const DxilSampler &S, std::vector<llvm::Metadata *> &MDVals) = 0;
+    virtual void EmitSamplerProperties(const DxilSampler &S, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals) = 0;
     virtual void LoadSamplerProperties(const llvm::MDOperand &MDO, DxilSampler &S) = 0;
 
-    virtual void EmitSignatureElementProperties(const DxilSignatureElement &SE, std::vector<llvm::Metadata *> &MDVals) = 0;
+    virtual void EmitSignatureElementProperties(const DxilSignatureElement &SE, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals) = 0;
     virtual void LoadSignatureElementProperties(const llvm::MDOperand &MDO, DxilSignatureElement &SE) = 0;
 
   protected:
@@ -483,7 +488,7 @@ private:
   llvm::MDTuple *EmitDxilASState(const unsigned *NumThreads, unsigned payloadSizeInBytes);
   void LoadDxilASState(const llvm::MDOperand &MDO, unsigned *NumThreads, unsigned &payloadSizeInBytes);
 
-  void AddCounterIfNonZero(uint32_t value, llvm::StringRef name, std::vector<llvm::Metadata*> &MDVals);
+  void AddCounterIfNonZero(uint32_t value, llvm::StringRef name, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals);
   void LoadCounterMD(const llvm::MDOperand &MDName, const llvm::MDOperand &MDValue, DxilCounters &counters) const;
 public:
   // Utility functions.
@@ -542,19 +547,19 @@ public:
   DxilExtraPropertyHelper(llvm::Module *pModule);
   virtual ~DxilExtraPropertyHelper() {}
 
-  virtual void EmitSRVProperties(const DxilResource &SRV, std::vector<llvm::Metadata *> &MDVals);
+  virtual void EmitSRVProperties(const DxilResource &SRV, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals);
   virtual void LoadSRVProperties(const llvm::MDOperand &MDO, DxilResource &SRV);
 
-  virtual void EmitUAVProperties(const DxilResource &UAV, std::vector<llvm::Metadata *> &MDVals);
+  virtual void EmitUAVProperties(const DxilResource &UAV, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals);
   virtual void LoadUAVProperties(const llvm::MDOperand &MDO, DxilResource &UAV);
 
-  virtual void EmitCBufferProperties(const DxilCBuffer &CB, std::vector<llvm::Metadata *> &MDVals);
+  virtual void EmitCBufferProperties(const DxilCBuffer &CB, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals);
   virtual void LoadCBufferProperties(const llvm::MDOperand &MDO, DxilCBuffer &CB);
 
-  virtual void EmitSamplerProperties(const DxilSampler &S, std::vector<llvm::Metadata *> &MDVals);
+  virtual void EmitSamplerProperties(const DxilSampler &S, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals);
   virtual void LoadSamplerProperties(const llvm::MDOperand &MDO, DxilSampler &S);
 
-  virtual void EmitSignatureElementProperties(const DxilSignatureElement &SE, std::vector<llvm::Metadata *> &MDVals);
+  virtual void EmitSignatureElementProperties(const DxilSignatureElement &SE, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals);
   virtual void LoadSignatureElementProperties(const llvm::MDOperand &MDO, DxilSignatureElement &SE);
 };
 
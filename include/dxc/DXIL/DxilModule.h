@@ -15,6 +15,7 @@
 #include "dxc/DXIL/DxilMetadataHelper.h"
 #include "dxc/DXIL/DxilCBuffer.h"
 #include "dxc/DXIL/DxilResource.h"
+#include "dxc/DXIL/DxilResourceProperties.h"
 #include "dxc/DXIL/DxilSampler.h"
 #include "dxc/DXIL/DxilShaderFlags.h"
 #include "dxc/DXIL/DxilSignature.h"
@@ -32,6 +33,7 @@ class LLVMContext;
 class Module;
 class Function;
 class Instruction;
+class Constant;
 class MDTuple;
 class MDOperand;
 class DebugInfoFinder;
@@ -106,6 +108,27 @@ public:
   const DxilResource &GetUAV(unsigned idx) const;
   const std::vector<std::unique_ptr<DxilResource> > &GetUAVs() const;
 
+  // Constant-time resource lookup across all four resource tables, by global
+  // symbol or by (class, space, lower bound). The indexes are built lazily on
+  // first lookup and discarded whenever a resource is added or removed;
+  // passes that rebind resources or reassign global symbols in place must
+  // call InvalidateResourceIndexes before the next lookup. Returns nullptr
+  // when no resource matches.
+  DxilResourceBase *LookupResourceBySymbol(const llvm::Constant *pSymbol) const;
+  DxilResourceBase *LookupResourceByBinding(DXIL::ResourceClass RC,
+                                            unsigned SpaceID,
+                                            unsigned LowerBound) const;
+  void InvalidateResourceIndexes() const;
+
+  // Decode an annotateHandle's resource properties through a per-module
+  // cache. The props constant is uniqued in the LLVMContext, so its pointer
+  // identifies the packed dword pair; a module typically carries well under
+  // a hundred distinct values while handle-heavy shaders annotate far more
+  // instructions than that. Constants are immutable, so the cache never
+  // needs invalidation.
+  DxilResourceProperties
+  GetCachedResourceProperties(DxilInst_AnnotateHandle &annotateHandle) const;
+
   void LoadDxilResourceBaseFromMDNode(llvm::MDNode *MD, DxilResourceBase &R);
   void LoadDxilResourceFromMDNode(llvm::MDNode *MD, DxilResource &R);
   void LoadDxilSamplerFromMDNode(llvm::MDNode *MD, DxilSampler &S);
@@ -156,7 +179,9 @@ public:
   // Update validator version metadata to current setting
   void UpdateValidatorVersionMetadata();
 
-  // DXIL type system.
+  // DXIL type system. Decoded from metadata on first touch after
+  // LoadDxilMetadata - it is by far the largest section for libraries and
+  // many consumers (entry-point queries, PIX passes) never read it.
   DxilTypeSystem &GetTypeSystem();
 
   /// Emit llvm.used array to make sure that optimizations do not remove unreferenced globals.
@@ -226,6 +251,12 @@ public:
   ShaderFlags m_ShaderFlags;
   void CollectShaderFlagsForModule(ShaderFlags &Flags);
 
+  // Returns the per-function flags recorded by the last
+  // CollectShaderFlagsForModule, or nullptr if the function was not seen
+  // then. Lets container assembly reuse the collection walk instead of
+  // re-deriving flags for every library function.
+  const ShaderFlags *GetCachedFunctionShaderFlags(const llvm::Function *F) const;
+
   // Check if DxilModule contains multi component UAV Loads.
   // This funciton must be called after unused resources are removed from DxilModule
   bool ModuleHasMulticomponentUAVLoads();
@@ -311,6 +342,24 @@ private:
   std::vector<std::unique_ptr<DxilCBuffer> > m_CBuffers;
   std::vector<std::unique_ptr<DxilSampler> > m_Samplers;
 
+  // Per-function shader flags from the last CollectShaderFlagsForModule run;
+  // see GetCachedFunctionShaderFlags.
+  std::unordered_map<const llvm::Function *, ShaderFlags>
+      m_FunctionShaderFlags;
+
+  // Lazily-built resource lookup indexes; see LookupResourceBySymbol.
+  mutable std::unordered_map<const llvm::Constant *, DxilResourceBase *>
+      m_ResourceSymbolIndex;
+  mutable std::unordered_map<uint64_t, DxilResourceBase *>
+      m_ResourceBindingIndex[(unsigned)DXIL::ResourceClass::Invalid];
+  mutable bool m_bResourceIndexesValid;
+  void BuildResourceIndexes() const;
+
+  // Decoded annotateHandle properties keyed by the uniqued props constant;
+  // see GetCachedResourceProperties.
+  mutable std::unordered_map<const llvm::Constant *, DxilResourceProperties>
+      m_DecodedResourceProps;
+
   // Geometry shader.
   DXIL::PrimitiveTopology m_StreamPrimitiveTopology;
   unsigned m_ActiveStreamMask;
@@ -373,6 +422,14 @@ private:
   // m_bMetadataErrors is true if non-fatal metadata errors were encountered.
   // Validator will fail in this case, but should not block module load.
   bool m_bMetadataErrors;
+
+  // True between LoadDxilMetadata and the first type system touch; the
+  // dx.typeAnnotations decode is deferred until then. The annotation tuples
+  // are snapshotted at load time so a ClearDxilMetadata before the first
+  // touch cannot drop them (uniqued nodes stay alive in the context).
+  bool m_bTypeSystemPending;
+  std::vector<const llvm::MDTuple *> m_PendingTypeAnnotations;
+  void MaterializeTypeSystem();
 };
 
 } // namespace hlsl
@@ -139,6 +139,10 @@ private:
 
   struct OpCodeCacheItem {
     llvm::SmallMapVector<llvm::Type *, llvm::Function *, 8> pOverloads;
+    // Direct-indexed view of pOverloads for the fixed scalar overload slots,
+    // so the hot lookup in GetOpFunc is an array index. UDT and object
+    // overloads stay map-only because many distinct types share those slots.
+    llvm::Function *pSlotFuncs[kNumTypeOverloads];
   };
   OpCodeCacheItem m_OpCodeClassCache[(unsigned)OpCodeClass::NumOpClasses];
   std::unordered_map<const llvm::Function *, OpCodeClass> m_FunctionToOpClass;
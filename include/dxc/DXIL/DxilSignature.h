@@ -36,6 +36,11 @@ public:
 
   unsigned AppendElement(std::unique_ptr<DxilSignatureElement> pSE, bool bSetID = true);
 
+  // Removes the element at idx and returns it. Element IDs are not
+  // renumbered; the caller is responsible for keeping IDs consistent with
+  // any instructions that reference them.
+  std::unique_ptr<DxilSignatureElement> RemoveElement(unsigned idx);
+
   DxilSignatureElement &GetElement(unsigned idx);
   const DxilSignatureElement &GetElement(unsigned idx) const;
   const std::vector<std::unique_ptr<DxilSignatureElement> > &GetElements() const;
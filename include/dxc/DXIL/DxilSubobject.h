@@ -17,6 +17,7 @@
 #include <map>
 #include "DxilConstants.h"
 #include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 
 namespace hlsl {
@@ -117,8 +118,10 @@ private:
 
 class DxilSubobjects {
 public:
-  typedef std::pair<std::unique_ptr<char[]>, size_t> StoredBytes;
-  typedef llvm::MapVector< llvm::StringRef, StoredBytes > BytesStorage;
+  // Interned strings and raw bytes. The StringMapEntry owns a null-terminated
+  // copy of the key bytes, so one probe both finds an existing entry and, on a
+  // miss, allocates the canonical storage; the value is unused.
+  typedef llvm::StringMap<char> BytesStorage;
   typedef llvm::MapVector< llvm::StringRef, std::unique_ptr<DxilSubobject> > SubobjectStorage;
   using Kind = DXIL::SubobjectKind;
 
@@ -73,6 +73,10 @@ namespace dxilutil {
   bool RemoveUnusedFunctions(llvm::Module &M, llvm::Function *EntryFunc,
                              llvm::Function *PatchConstantFunc, bool IsLib);
 
+  // Strip names and metadata that only aid debugging from a finalized module,
+  // shrinking the serialized DXIL part (/Qminimize).
+  void MinimizeModuleForRuntime(llvm::Module &M);
+
   llvm::DIGlobalVariable *FindGlobalVariableDebugInfo(llvm::GlobalVariable *GV,
                                                 llvm::DebugInfoFinder &DbgInfoFinder);
 
@@ -62,4 +62,5 @@ private:
   HRESULT UpdateContainerHeader(AbstractMemoryStream *pStream, uint32_t containerSize);
   HRESULT UpdateOffsetTable(AbstractMemoryStream *pStream);
   HRESULT UpdateParts(AbstractMemoryStream *pStream);
+  HRESULT PatchOriginalContainer(_COM_Outptr_result_maybenull_ IDxcBlob **ppResult);
 };
\ No newline at end of file
@@ -20,7 +20,10 @@
 #include "dxc/Support/WinAdapter.h"
 
 struct IDxcContainerReflection;
-namespace llvm { class Module; }
+namespace llvm {
+class Module;
+template <typename T> class SmallVectorImpl;
+}
 
 namespace hlsl {
 
@@ -44,6 +47,8 @@ enum class DxilShaderHashFlags : uint32_t {
   None = 0,           // No flags defined.
   IncludesSource = 1, // This flag indicates that the shader hash was computed
                       // taking into account source information (-Zss)
+  FastProfileValidated = 2, // The container was validated with the fast
+                            // (reduced) rule profile, not the full rule set.
 };
 
 typedef struct DxilShaderHash {
@@ -95,6 +100,7 @@ enum DxilFourCC {
   DFCC_PipelineStateValidation  = DXIL_FOURCC('P', 'S', 'V', '0'),
   DFCC_RuntimeData              = DXIL_FOURCC('R', 'D', 'A', 'T'),
   DFCC_ShaderHash               = DXIL_FOURCC('H', 'A', 'S', 'H'),
+  DFCC_CompressedShaderDebugInfoDXIL = DXIL_FOURCC('I', 'L', 'D', 'Z'),
 };
 
 #undef DXIL_FOURCC
@@ -103,6 +109,18 @@ struct DxilShaderFeatureInfo {
   uint64_t FeatureFlags;
 };
 
+/// Payload header for DFCC_CompressedShaderDebugInfoDXIL. The header is
+/// followed by CompressedSizeInBytes of zlib-compressed data (then zero
+/// padding up to the part size); decompression yields exactly the payload a
+/// DFCC_ShaderDebugInfoDXIL part would otherwise carry, i.e. a
+/// DxilProgramHeader plus the debug module bitcode. The part is only emitted
+/// when SerializeDxilFlags::CompressDebugInfoPart is requested and zlib is
+/// available, so consumers that do not opt in never encounter it.
+struct DxilCompressedPartHeader {
+  uint32_t UncompressedSizeInBytes; // Size of the payload after decompression.
+  uint32_t CompressedSizeInBytes;   // Size of the zlib stream that follows.
+};
+
 // DXIL program information.
 struct DxilBitcodeHeader {
   uint32_t DxilMagic;       // ACSII "DXIL".
@@ -265,6 +283,11 @@ DxilContainerHeader *IsDxilContainerLike(void *ptr, size_t length);
 /// Checks whether the DXIL container is valid and in-bounds.
 bool IsValidDxilContainer(const DxilContainerHeader *pHeader, size_t length);
 
+/// Decompresses the payload of a DFCC_CompressedShaderDebugInfoDXIL part into
+/// Output. Fails when zlib is unavailable or the part is malformed.
+HRESULT DecompressDxilCompressedPart(const DxilPartHeader *pPart,
+                                     llvm::SmallVectorImpl<char> &Output);
+
 /// Use this type as a unary predicate functor.
 struct DxilPartIsType {
   uint32_t IsFourCC;
@@ -413,6 +436,7 @@ enum class SerializeDxilFlags : uint32_t {
   StripReflectionFromDxilPart = 1 << 3, // Strip Reflection info from DXIL part.
   IncludeReflectionPart       = 1 << 4, // Include reflection in STAT part.
   StripRootSignature          = 1 << 5, // Strip Root Signature from main shader container.
+  CompressDebugInfoPart       = 1 << 6, // Emit the debug info part zlib-compressed (DFCC_CompressedShaderDebugInfoDXIL).
 };
 inline SerializeDxilFlags& operator |=(SerializeDxilFlags& l, const SerializeDxilFlags& r) {
   l = static_cast<SerializeDxilFlags>(static_cast<int>(l) | static_cast<int>(r));
@@ -46,6 +46,12 @@ DxilPartWriter *NewRDATWriter(const DxilModule &M, uint32_t InfoVersion = 0);
 
 DxilContainerWriter *NewDxilContainerWriter();
 
+/// Enables overlapping container serialization work that does not touch the
+/// LLVMContext - currently the source-based shader hash over the input
+/// bitcode - with the clone/strip/re-serialize stages on a helper thread.
+/// Off by default. The setting is process-wide.
+void SetDxilContainerParallelSerialization(bool Enabled);
+
 void SerializeDxilContainerForModule(hlsl::DxilModule *pModule,
                                      AbstractMemoryStream *pModuleBitcode,
                                      AbstractMemoryStream *pStream,
@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "dxc/Support/Global.h"
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/DxilContainer/DxilContainer.h"
@@ -56,12 +58,36 @@ namespace hlsl {
     HRESULT GetPartFourCC(uint32_t idx, _Out_ uint32_t *pResult);
     HRESULT FindFirstPartKind(uint32_t kind, _Out_ uint32_t *pResult);
 
+    // Looks up the first part of each requested kind against the part index
+    // built during Load. Writes the part index, or
+    // DXIL_CONTAINER_BLOB_NOT_FOUND for kinds the container does not have.
+    // kinds and pResults must have the same length.
+    HRESULT FindFirstPartKinds(llvm::ArrayRef<uint32_t> kinds,
+                               llvm::MutableArrayRef<uint32_t> results);
+
+    // Returns a zero-copy view of the content of the part at idx. The part
+    // bounds were validated against the container extents during Load.
+    HRESULT GetPartView(uint32_t idx, _Out_ llvm::ArrayRef<uint8_t> *pResult);
+
   private:
+    // One entry per part, sorted by FourCC then part index, so kind lookups
+    // are a binary search instead of a rescan of the part table.
+    struct PartEntry {
+      uint32_t FourCC;
+      uint32_t Index;
+      bool operator<(const PartEntry &other) const {
+        return FourCC < other.FourCC ||
+               (FourCC == other.FourCC && Index < other.Index);
+      }
+    };
+
     const void* m_pContainer = nullptr;
     uint32_t m_uContainerSize = 0;
     const DxilContainerHeader *m_pHeader = nullptr;
+    llvm::SmallVector<PartEntry, 8> m_partIndex;
 
     bool IsLoaded() const { return m_pHeader != nullptr; }
+    const PartEntry *FindPartEntry(uint32_t kind) const;
   };
   
 } // namespace hlsl
\ No newline at end of file
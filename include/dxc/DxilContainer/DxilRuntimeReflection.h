@@ -697,7 +697,9 @@ struct DxilLibraryDesc {
 class DxilRuntimeReflection {
 public:
   virtual ~DxilRuntimeReflection() {}
-  // This call will allocate memory for GetLibraryReflection call
+  // Validates headers and prepares the readers over the RDAT bytes, which
+  // must stay alive for the lifetime of this object. Descs are decoded on
+  // the first GetLibraryReflection call.
   virtual bool InitFromRDAT(const void *pRDAT, size_t size) = 0;
   // DxilRuntimeReflection owns the memory pointed to by DxilLibraryDesc
   virtual const DxilLibraryDesc GetLibraryReflection() = 0;
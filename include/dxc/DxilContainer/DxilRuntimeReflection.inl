@@ -220,6 +220,11 @@ private:
   std::unordered_map<DxilFunctionDesc *, WStringList> m_FuncToDependenciesMap;
   std::unordered_map<DxilSubobjectDesc *, WStringList> m_SubobjectToExportsMap;
   bool m_initialized;
+  // Whether the desc lists have been decoded from the runtime data. The
+  // table readers index the mapped RDAT bytes directly, so until someone
+  // asks for the library desc no per-row decoding or string conversion is
+  // needed; InitFromRDAT only validates headers.
+  bool m_reflectionBuilt;
 
   const wchar_t *GetWideString(const char *ptr);
   void AddString(const char *ptr);
@@ -241,7 +246,7 @@ public:
   DxilRuntimeReflection_impl()
       : m_RuntimeData(), m_StringMap(), m_BytesMap(), m_Resources(), m_Functions(),
         m_FuncToResMap(), m_FuncToDependenciesMap(), m_SubobjectToExportsMap(),
-        m_initialized(false) {}
+        m_initialized(false), m_reflectionBuilt(false) {}
   virtual ~DxilRuntimeReflection_impl() {}
   // This call will allocate memory for GetLibraryReflection call
   bool InitFromRDAT(const void *pRDAT, size_t size) override;
@@ -281,14 +286,20 @@ const void *DxilRuntimeReflection_impl::GetBytes(const void *ptr, size_t size) {
 
 bool DxilRuntimeReflection_impl::InitFromRDAT(const void *pRDAT, size_t size) {
   assert(!m_initialized && "may only initialize once");
+  // Only validate headers and set up the zero-copy table readers here.
+  // Decoding rows into descs (and converting names to wide strings) is
+  // deferred to the first GetLibraryReflection call; callers that just
+  // verify the part never pay for it.
   m_initialized = m_RuntimeData.InitFromRDAT(pRDAT, size);
-  if (m_initialized)
-    InitializeReflection();
   return m_initialized;
 }
 
 const DxilLibraryDesc DxilRuntimeReflection_impl::GetLibraryReflection() {
   DxilLibraryDesc reflection = {};
+  if (m_initialized && !m_reflectionBuilt) {
+    m_reflectionBuilt = true;
+    InitializeReflection();
+  }
   if (m_initialized) {
     reflection.NumResources =
         m_RuntimeData.GetResourceTableReader()->GetNumResources();
@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// DxilShaderArchive.h                                                       //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Provides declarations for the dxarc packed shader-archive format.         //
+//                                                                           //
+// A shader archive stores many DXIL containers whose parts are deduplicated //
+// into a content-addressed part store. Each shader is a manifest of part    //
+// references plus the original container hash and version, so containers    //
+// reconstitute bit-exact. All tables are flat, fixed-stride and offset-     //
+// addressed so an archive can be memory-mapped and consumed in place:       //
+// shader lookup is an open-addressed hash probe over a bucket array, and    //
+// part content is served as zero-copy views into the mapping.               //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "dxc/DxilContainer/DxilContainer.h"
+#include "dxc/Support/WinAdapter.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct IDxcBlob;
+struct IMalloc;
+
+namespace llvm {
+class raw_ostream;
+}
+
+namespace hlsl {
+
+#pragma pack(push, 1)
+
+static const uint32_t DxilArchiveFourCC =
+    ((uint32_t)'D' | (uint32_t)'X' << 8 | (uint32_t)'A' << 16 |
+     (uint32_t)'R' << 24); // 'DXAR'
+static const uint16_t DxilArchiveVersionMajor = 1;
+static const uint16_t DxilArchiveVersionMinor = 0;
+
+/// Use this type to describe a packed archive of DXIL containers.
+/// All offsets are byte offsets from the start of this header; all part
+/// data offsets are at least four-byte aligned.
+struct DxilArchiveHeader {
+  uint32_t HeaderFourCC;       // DxilArchiveFourCC
+  uint16_t VersionMajor;       // DxilArchiveVersionMajor
+  uint16_t VersionMinor;       // DxilArchiveVersionMinor
+  uint64_t ArchiveSizeInBytes; // From start of this header.
+  uint32_t PartCount;          // Unique parts in the part store.
+  uint32_t ShaderCount;        // Shaders (containers) in the archive.
+  uint32_t PartRefCount;       // Entries in the part-reference table.
+  uint32_t BucketCount;        // Power of two; zero iff ShaderCount is zero.
+  uint64_t PartTableOffset;    // DxilArchivePartEntry[PartCount]
+  uint64_t ShaderTableOffset;  // DxilArchiveShaderEntry[ShaderCount]
+  uint64_t PartRefTableOffset; // uint32_t[PartRefCount], part-table indices
+  uint64_t BucketTableOffset;  // uint32_t[BucketCount], shader index + 1,
+                               // zero marks an empty bucket
+  uint64_t StringTableOffset;  // NUL-terminated UTF-8 shader names
+  uint64_t StringTableSize;
+};
+
+/// One unique part in the content-addressed store. The stored bytes at
+/// DataOffset are the full part as it appears in a container - the
+/// DxilPartHeader followed by PartSize bytes of content - so a container
+/// reconstitutes by copying stored parts back to back, and a part view
+/// is a pointer into the mapping.
+struct DxilArchivePartEntry {
+  uint32_t PartFourCC;
+  uint32_t PartSize;   // Content size, excluding the DxilPartHeader.
+  uint64_t DataOffset; // To the DxilPartHeader; four-byte aligned.
+  uint8_t Hash[DxilContainerHashSize]; // MD5 of the stored bytes.
+};
+
+enum DxilArchiveShaderFlags : uint32_t {
+  // The original container bytes appear verbatim and contiguous in the
+  // archive starting at ContainerOffset, so the container can be served
+  // as a zero-copy view of the mapping.
+  DxilArchiveShaderFlag_Contiguous = 1,
+};
+
+/// One shader manifest. Parts are listed in original container order in the
+/// part-reference table; NameHash is DxilArchiveHashName of the UTF-8 name.
+struct DxilArchiveShaderEntry {
+  uint64_t NameHash;
+  uint32_t NameOffset;   // Into the string table.
+  uint32_t FirstPartRef; // Into the part-reference table.
+  uint32_t NumParts;
+  uint32_t Flags;           // DxilArchiveShaderFlags
+  uint64_t ContainerOffset; // Valid with DxilArchiveShaderFlag_Contiguous.
+  DxilContainerVersion ContainerVersion;
+  DxilContainerHash ContainerHash;
+};
+
+#pragma pack(pop)
+
+/// FNV-1a, spelled out because the hash is persisted in the archive and
+/// must stay stable across builds, unlike llvm::hash_value.
+inline uint64_t DxilArchiveHashName(llvm::StringRef name) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : name) {
+    hash ^= (uint8_t)c;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+const DxilArchiveHeader *IsDxilArchiveLike(const void *ptr, uint64_t length);
+bool IsValidDxilArchive(const DxilArchiveHeader *pHeader, uint64_t length);
+
+//=============================================================================
+// DxilShaderArchiveWriter
+//
+// Collects named DXIL containers and writes them as one packed archive.
+// Unique part bytes are copied once at AddShader time, so input containers
+// need not outlive the call; duplicated parts cost only a table entry.
+//
+class DxilShaderArchiveWriter {
+public:
+  // Validates and records one container. Returns E_INVALIDARG for a
+  // malformed container or a duplicate name.
+  HRESULT AddShader(llvm::StringRef name, _In_reads_bytes_(containerSize)
+                        const void *pContainer,
+                    uint32_t containerSize);
+
+  void Write(llvm::raw_ostream &OS) const;
+
+  uint32_t GetShaderCount() const { return (uint32_t)m_shaders.size(); }
+  uint32_t GetUniquePartCount() const { return (uint32_t)m_parts.size(); }
+  // Bytes of container input accepted so far vs. unique part bytes kept;
+  // the ratio is the deduplication win before table overhead.
+  uint64_t GetInputSizeInBytes() const { return m_inputBytes; }
+  uint64_t GetUniquePartSizeInBytes() const { return m_uniquePartBytes; }
+
+private:
+  struct PartRecord {
+    uint32_t FourCC;
+    uint32_t Size; // Content size, excluding the DxilPartHeader.
+    uint8_t Hash[DxilContainerHashSize];
+    std::vector<uint8_t> Bytes; // Full part: header plus content.
+  };
+  struct ShaderRecord {
+    std::string Name;
+    DxilContainerVersion Version;
+    DxilContainerHash Hash;
+    std::vector<uint32_t> PartIndices;
+    // All parts were first seen in this shader and the source container
+    // had the canonical tightly-packed layout, so its bytes can be laid
+    // out verbatim and served zero-copy.
+    bool OwnsAllParts;
+  };
+  struct PartKey {
+    uint32_t FourCC;
+    uint32_t Size;
+    uint8_t Hash[DxilContainerHashSize];
+    bool operator<(const PartKey &other) const;
+  };
+
+  std::vector<PartRecord> m_parts;
+  std::vector<ShaderRecord> m_shaders;
+  std::map<PartKey, uint32_t> m_partIndex;
+  std::map<std::string, uint32_t> m_shaderIndex;
+  uint64_t m_inputBytes = 0;
+  uint64_t m_uniquePartBytes = 0;
+};
+
+//=============================================================================
+// DxilShaderArchiveReader
+//
+// Parses a shader archive in place - typically over a memory-mapped file.
+// The archive memory must stay valid for the lifetime of the reader and of
+// any blob it returns; part views and contiguous containers are zero-copy
+// references into that memory.
+//
+class DxilShaderArchiveReader {
+public:
+  HRESULT Load(_In_reads_bytes_(archiveSize) const void *pArchive,
+               uint64_t archiveSize);
+
+  uint32_t GetShaderCount() const;
+  uint32_t GetPartCount() const;
+
+  // O(1) expected: hashes the name and probes the archive's bucket table.
+  HRESULT FindShader(llvm::StringRef name, _Out_ uint32_t *pIndex) const;
+  HRESULT GetShaderName(uint32_t shaderIndex, _Outptr_ const char **ppName) const;
+
+  // Reconstitutes the container for a shader. Contiguous shaders are served
+  // as a zero-copy view of the archive memory; others are assembled into a
+  // pMalloc allocation (null pMalloc uses the global heap).
+  HRESULT GetShaderContainer(uint32_t shaderIndex, _In_opt_ IMalloc *pMalloc,
+                             _COM_Outptr_ IDxcBlob **ppContainer) const;
+
+  // Returns a zero-copy view of the content of the first part of the given
+  // kind, without reconstituting the container.
+  HRESULT GetShaderPartContent(uint32_t shaderIndex, uint32_t fourCC,
+                               _COM_Outptr_ IDxcBlob **ppContent) const;
+
+  // Size the container for a shader would have once reconstituted.
+  HRESULT GetShaderContainerSize(uint32_t shaderIndex,
+                                 _Out_ uint32_t *pSize) const;
+
+private:
+  const uint8_t *m_pArchive = nullptr;
+  const DxilArchiveHeader *m_pHeader = nullptr;
+  const DxilArchivePartEntry *m_pParts = nullptr;
+  const DxilArchiveShaderEntry *m_pShaders = nullptr;
+  const uint32_t *m_pPartRefs = nullptr;
+  const uint32_t *m_pBuckets = nullptr;
+  const char *m_pStrings = nullptr;
+
+  bool IsLoaded() const { return m_pHeader != nullptr; }
+  const DxilArchivePartEntry *GetShaderPart(
+      const DxilArchiveShaderEntry &shader, uint32_t partOrdinal) const;
+};
+
+} // namespace hlsl
@@ -91,6 +91,7 @@ public:
   const std::vector<unsigned> &GetSerialized();
   const std::vector<unsigned> &
   GetSerialized() const; // returns previously serialized data
+  std::vector<unsigned> TakeSerialized(); // moves previously serialized data out
   void Deserialize(const unsigned *pData, unsigned DataSizeInUINTs);
   void PrintSets(llvm::raw_ostream &OS);
 
@@ -30,6 +30,11 @@ using PostDomRelationType = llvm::DominatorTreeBase<llvm::BasicBlock>;
 class ControlDependence {
 public:
   void Compute(llvm::Function *F, PostDomRelationType &PostDomRel);
+  // Sparse variant: records the conditional CFG edges and answers
+  // GetCDBlocks queries lazily from the post-dominator tree, which the
+  // caller must keep alive. Straight-line functions have no conditional
+  // edges and never compute or allocate a dependence set.
+  void ComputeSparse(llvm::Function *F, PostDomRelationType &PostDomRel);
   void Clear();
   const BasicBlockSet &GetCDBlocks(llvm::BasicBlock *pBB) const;
   void print(llvm::raw_ostream &OS);
@@ -37,15 +42,19 @@ public:
 
 private:
   using BasicBlockVector = std::vector<llvm::BasicBlock *>;
+  using BasicBlockEdge = std::pair<llvm::BasicBlock *, llvm::BasicBlock *>;
   using ControlDependenceType = std::unordered_map<llvm::BasicBlock *, BasicBlockSet>;
 
   llvm::Function *m_pFunc;
-  ControlDependenceType m_ControlDependence;
+  PostDomRelationType *m_pPostDomRel = nullptr;  // borrowed; sparse mode only
+  std::vector<BasicBlockEdge> m_CondEdges;       // sparse mode only
+  mutable ControlDependenceType m_ControlDependence;
   BasicBlockSet m_EmptyBBSet;
 
   llvm::BasicBlock *GetIPostDom(PostDomRelationType &PostDomRel, llvm::BasicBlock *pBB);
   void ComputeRevTopOrderRec(PostDomRelationType &PostDomRel, llvm::BasicBlock *pBB,
                              BasicBlockVector &RevTopOrder, BasicBlockSet &VisitedBBs);
+  const BasicBlockSet &ComputeForBlock(llvm::BasicBlock *pBB) const;
 };
 
 } // end of hlsl namespace
@@ -61,11 +61,14 @@ ModulePass *createHLDeadFunctionEliminationPass();
 ModulePass *createHLPreprocessPass();
 ModulePass *createDxilPrecisePropagatePass();
 FunctionPass *createDxilPreserveAllOutputsPass();
+ModulePass *createDxilTrimUnusedOutputsPass();
 FunctionPass *createDxilPromoteLocalResources();
 ModulePass *createDxilPromoteStaticResources();
 ModulePass *createDxilLegalizeResources();
 ModulePass *createDxilLegalizeEvalOperationsPass();
 FunctionPass *createDxilLegalizeSampleOffsetPass();
+FunctionPass *createDxilScheduleForPressurePass();
+ModulePass *createDxilSpecializeConstantsPass();
 FunctionPass *createDxilSimpleGVNHoistPass();
 ModulePass *createInvalidateUndefResourcesPass();
 FunctionPass *createSimplifyInstPass();
@@ -94,11 +97,14 @@ void initializeDxilConvergentMarkPass(llvm::PassRegistry&);
 void initializeDxilConvergentClearPass(llvm::PassRegistry&);
 void initializeDxilPrecisePropagatePassPass(llvm::PassRegistry&);
 void initializeDxilPreserveAllOutputsPass(llvm::PassRegistry&);
+void initializeDxilTrimUnusedOutputsPass(llvm::PassRegistry&);
 void initializeDxilPromoteLocalResourcesPass(llvm::PassRegistry&);
 void initializeDxilPromoteStaticResourcesPass(llvm::PassRegistry&);
 void initializeDxilLegalizeResourcesPass(llvm::PassRegistry&);
 void initializeDxilLegalizeEvalOperationsPass(llvm::PassRegistry&);
 void initializeDxilLegalizeSampleOffsetPassPass(llvm::PassRegistry&);
+void initializeDxilScheduleForPressurePass(llvm::PassRegistry&);
+void initializeDxilSpecializeConstantsPass(llvm::PassRegistry&);
 void initializeDxilSimpleGVNHoistPass(llvm::PassRegistry&);
 void initializeInvalidateUndefResourcesPass(llvm::PassRegistry&);
 void initializeSimplifyInstPass(llvm::PassRegistry&);
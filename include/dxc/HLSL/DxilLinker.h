@@ -42,6 +42,10 @@ public:
   virtual bool RegisterLib(llvm::StringRef name,
                            std::unique_ptr<llvm::Module> pModule,
                            std::unique_ptr<llvm::Module> pDebugModule) = 0;
+  // Removes a registered library (detaching it first if needed) so a new
+  // version can be registered under the same name without rebuilding the
+  // whole link session.
+  virtual bool UnregisterLib(llvm::StringRef name) = 0;
   virtual bool AttachLib(llvm::StringRef name) = 0;
   virtual bool DetachLib(llvm::StringRef name) = 0;
   virtual void DetachAll() = 0;
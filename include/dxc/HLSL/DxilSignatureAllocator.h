@@ -120,6 +120,7 @@ public:
     ConflictType DetectRowConflict(uint8_t flags, uint8_t indexFlags, DXIL::InterpolationMode interp, unsigned width, DXIL::SignatureDataWidth dataWidth);
     ConflictType DetectColConflict(uint8_t flags, unsigned col, unsigned width);
     void PlaceElement(uint8_t flags, uint8_t indexFlags, DXIL::InterpolationMode interp, unsigned col, unsigned width, DXIL::SignatureDataWidth dataWidth);
+    bool IsFullyOccupied() const;
   };
 
   DxilSignatureAllocator(unsigned numRegisters, bool useMinPrecision);
@@ -150,6 +151,13 @@ public:
 
 protected:
   std::vector<PackedRegister> m_Registers;
+  // Occupancy bitmap with one bit per register, set once all four components
+  // of that register are occupied. FindNext uses it to reject saturated rows
+  // without rescanning their component flags. Bits are only ever set through
+  // PlaceElement; a clear bit for a full register (e.g. when registers are
+  // copied into a temp allocator directly) is safe - it just disables the
+  // fast reject for that row.
+  uint64_t m_FullRegisterMask;
   bool m_bIgnoreIndexing;
   bool m_bUseMinPrecision;
 };
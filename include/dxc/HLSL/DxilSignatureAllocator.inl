@@ -150,8 +150,17 @@ void DxilSignatureAllocator::PackedRegister::PlaceElement(
   }
 }
 
+bool DxilSignatureAllocator::PackedRegister::IsFullyOccupied() const {
+  for (unsigned i = 0; i < 4; ++i) {
+    if ((Flags[i] & kEFOccupied) == 0)
+      return false;
+  }
+  return true;
+}
+
 DxilSignatureAllocator::DxilSignatureAllocator(unsigned numRegisters, bool useMinPrecision)
-  : m_bIgnoreIndexing(false), m_bUseMinPrecision(useMinPrecision) {
+  : m_FullRegisterMask(0), m_bIgnoreIndexing(false), m_bUseMinPrecision(useMinPrecision) {
+  DXASSERT(numRegisters <= 64, "otherwise, m_FullRegisterMask needs more than one bit per register");
   m_Registers.resize(numRegisters);
 }
 
@@ -192,6 +201,8 @@ void DxilSignatureAllocator::PlaceElement(const PackElement *SE, unsigned row, u
   for (unsigned i = 0; i < rows; ++i) {
     uint8_t indexFlags = m_bIgnoreIndexing ? 0 : GetIndexFlags(i, rows);
     m_Registers[row + i].PlaceElement(flags, indexFlags, interp, col, cols, SE->GetDataBitWidth());
+    if (m_Registers[row + i].IsFullyOccupied())
+      m_FullRegisterMask |= 1ull << (row + i);
   }
 }
 
@@ -239,6 +250,10 @@ unsigned DxilSignatureAllocator::FindNext(
   DXASSERT_NOMSG(startCol + cols <= 4);
 
   for (unsigned row = startRow; row <= (startRow + numRows - rows); ++row) {
+    // Fast reject: a fully occupied register anywhere in the candidate row
+    // range cannot accept any element, so skip the detailed conflict checks.
+    if (m_FullRegisterMask & (((rows < 64 ? (1ull << rows) : 0) - 1) << row))
+      continue;
     if (DetectRowConflict(SE, row))
       continue;
     for (unsigned col = startCol; col <= 4 - cols; ++col) {
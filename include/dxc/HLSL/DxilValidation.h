@@ -279,8 +279,31 @@ enum class ValidationRule : unsigned {
 
 const char *GetValidationRuleText(ValidationRule value);
 void GetValidationVersion(_Out_ unsigned *pMajor, _Out_ unsigned *pMinor);
+// Named validation profiles. Full runs every rule. Fast runs only the
+// structural and resource phases, skipping control-flow analysis and the
+// per-instruction function walk; it is meant for inner-loop iteration and
+// must not be used to sign shaders shipped to release environments.
+enum class DxilValidationProfile { Full, Fast };
+
+// Per-call validation settings. Every Validate entry point carries its own
+// copy, so concurrent validations with different flags cannot observe one
+// another's settings.
+struct DxilValidationOptions {
+  // Shards per-function validation across up to ThreadCount worker threads.
+  // Zero or one keeps the serial walk. Diagnostic output is deterministic
+  // and identical to serial validation.
+  unsigned ThreadCount = 0;
+  // When quiet, validation records failing rule IDs but formats and emits
+  // no diagnostic text; intended for callers that only need pass/fail.
+  bool bQuietMode = false;
+  // Profile to validate under; see DxilValidationProfile.
+  DxilValidationProfile Profile = DxilValidationProfile::Full;
+};
+
 HRESULT ValidateDxilModule(_In_ llvm::Module *pModule,
-                           _In_opt_ llvm::Module *pDebugModule);
+                           _In_opt_ llvm::Module *pDebugModule,
+                           const DxilValidationOptions &Opts =
+                               DxilValidationOptions());
 
 // DXIL Container Verification Functions (return false on failure)
 
@@ -336,12 +359,16 @@ HRESULT ValidateLoadModuleFromContainerLazy(
 // Load and validate Dxil module from bitcode.
 HRESULT ValidateDxilBitcode(_In_reads_bytes_(ILLength) const char *pIL,
                             _In_ uint32_t ILLength,
-                            _In_ llvm::raw_ostream &DiagStream);
+                            _In_ llvm::raw_ostream &DiagStream,
+                            const DxilValidationOptions &Opts =
+                                DxilValidationOptions());
 
 // Full container validation, including ValidateDxilModule
 HRESULT ValidateDxilContainer(_In_reads_bytes_(ContainerSize) const void *pContainer,
                               _In_ uint32_t ContainerSize,
-                              _In_ llvm::raw_ostream &DiagStream);
+                              _In_ llvm::raw_ostream &DiagStream,
+                              const DxilValidationOptions &Opts =
+                                  DxilValidationOptions());
 
 class PrintDiagnosticContext {
 private:
@@ -35,6 +35,7 @@ class Module;
 class Function;
 class Instruction;
 class CallInst;
+class Constant;
 class MDTuple;
 class MDNode;
 class GlobalVariable;
@@ -125,6 +126,14 @@ public:
   const HLResource &GetUAV(unsigned idx) const;
   const std::vector<std::unique_ptr<HLResource> > &GetUAVs() const;
 
+  // Constant-time resource lookup by global symbol across all four resource
+  // tables. The index is built lazily on first lookup and discarded when a
+  // resource is added or removed; passes that reassign global symbols in
+  // place must call InvalidateResourceIndexes before the next lookup.
+  // Returns nullptr when no resource matches.
+  DxilResourceBase *LookupResourceBySymbol(const llvm::Constant *pSymbol) const;
+  void InvalidateResourceIndexes() const;
+
   void RemoveGlobal(llvm::GlobalVariable *GV);
   void RemoveFunction(llvm::Function *F);
 
@@ -261,6 +270,12 @@ private:
   std::vector<std::unique_ptr<DxilCBuffer> > m_CBuffers;
   std::vector<std::unique_ptr<DxilSampler> > m_Samplers;
 
+  // Lazily-built resource lookup index; see LookupResourceBySymbol.
+  mutable std::unordered_map<const llvm::Constant *, DxilResourceBase *>
+      m_ResourceSymbolIndex;
+  mutable bool m_bResourceIndexesValid;
+  void BuildResourceIndexes() const;
+
   // ThreadGroupSharedMemory.
   std::vector<llvm::GlobalVariable*>  m_TGSMVariables;
 
@@ -317,7 +332,7 @@ public:
   HLExtraPropertyHelper(llvm::Module *pModule);
   virtual ~HLExtraPropertyHelper() {}
 
-  virtual void EmitSignatureElementProperties(const DxilSignatureElement &SE, std::vector<llvm::Metadata *> &MDVals);
+  virtual void EmitSignatureElementProperties(const DxilSignatureElement &SE, llvm::SmallVectorImpl<llvm::Metadata *> &MDVals);
   virtual void LoadSignatureElementProperties(const llvm::MDOperand &MDO, DxilSignatureElement &SE);
 };
 
@@ -161,6 +161,15 @@ DxcCreateBlobFromFile(_In_opt_ IMalloc *pMalloc, LPCWSTR pFileName,
 HRESULT DxcCreateBlobFromFile(LPCWSTR pFileName, _In_opt_ UINT32 *pCodePage,
                               _COM_Outptr_ IDxcBlobEncoding **ppBlobEncoding) throw();
 
+// Zero-copy variant: memory-maps the file read-only instead of copying it
+// into a heap buffer; the mapping is released with the blob. Encoding is
+// left unknown so detection and any conversion happen on first access.
+// Fails (rather than falling back) when the file cannot be mapped; callers
+// should retry with DxcCreateBlobFromFile.
+HRESULT
+DxcCreateBlobFromFileMapped(_In_opt_ IMalloc *pMalloc, LPCWSTR pFileName,
+                            _COM_Outptr_ IDxcBlobEncoding **ppBlobEncoding) throw();
+
 // Given a blob, creates a subrange view.
 HRESULT DxcCreateBlobFromBlob(_In_ IDxcBlob *pBlob, UINT32 offset,
                               UINT32 length,
@@ -232,6 +241,19 @@ public:
   virtual HRESULT Reserve(ULONG targetSize) throw() = 0;
 };
 HRESULT CreateMemoryStream(_In_ IMalloc *pMalloc, _COM_Outptr_ AbstractMemoryStream** ppResult) throw();
+
+// Per-thread high-water sizing for transient memory streams. The compile path
+// creates and discards a module bitcode stream and a container stream on every
+// invocation, growing each through a series of reallocations. Streams created
+// against a pool record the largest buffer they reached on the current thread,
+// and the next stream created against the same pool reserves that much up
+// front, so steady-state compilation allocates each buffer exactly once.
+enum class MemoryStreamPool : unsigned {
+  ModuleBitcode = 0,
+  Container,
+  Count // Not a pool; used to size per-thread state.
+};
+HRESULT CreateMemoryStream(_In_ IMalloc *pMalloc, MemoryStreamPool pool, _COM_Outptr_ AbstractMemoryStream** ppResult) throw();
 HRESULT CreateReadOnlyBlobStream(_In_ IDxcBlob *pSource, _COM_Outptr_ IStream** ppResult) throw();
 HRESULT CreateFixedSizeMemoryStream(_In_ LPBYTE pBuffer, size_t size, _COM_Outptr_ AbstractMemoryStream** ppResult) throw();
 
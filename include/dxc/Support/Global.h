@@ -45,6 +45,17 @@ struct IMalloc;
 HRESULT DxcInitThreadMalloc() throw();
 void DxcCleanupThreadMalloc() throw();
 
+// Installs the process-default allocator used whenever no per-invocation
+// IMalloc is active on the thread. Must be called before DxcInitThreadMalloc
+// captures the default; fails with E_FAIL afterwards.
+HRESULT DxcSetDefaultMalloc(IMalloc *pMalloc) throw();
+
+// Creates a thread-caching allocator suited to heavy in-process parallel
+// compilation: small blocks come from per-thread size-class freelists and
+// only chunk refills and cross-thread frees touch shared state. Intended to
+// be installed through DxcSetDefaultMalloc or passed to DxcCreateInstance2.
+HRESULT DxcCreateScalableMalloc(IMalloc **ppMalloc) throw();
+
 // Used by APIs entry points to set up per-thread/invocation allocator.
 // Setting the IMalloc on the thread increases the reference count,
 // clearing it decreases it.
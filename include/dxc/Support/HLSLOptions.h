@@ -132,13 +132,26 @@ public:
 
   bool AllResourcesBound = false; // OPT_all_resources_bound
   bool AstDump = false; // OPT_ast_dump
+  bool EmitPCH = false; // OPT_emit_pch
+  llvm::StringRef IncludePCH; // OPT_include_pch
   bool ColorCodeAssembly = false; // OPT_Cc
   bool CodeGenHighLevel = false; // OPT_fcgl
+  bool ParallelCodeGen = false; // OPT_fparallel_codegen
+  bool Deterministic = false; // OPT_fdeterministic
+  bool VerifyDeterministic = false; // OPT_verify_deterministic
+  bool ContextPool = false; // OPT_fcontext_pool
+  bool CacheIncludes = false; // OPT_fcache_includes
+  bool TimeTrace = false; // OPT_ftime_trace
+  bool CompressDebug = false; // OPT_fcompress_debug
+  unsigned DiagRenderLimit = 0; // OPT_fdiagnostics_render_limit_EQ (0 = unlimited)
+  bool EmbedSourceHash = false; // OPT_fembed_source_hash
   bool AllowPreserveValues = false; // OPT_preserve_intermediate_values
   bool DebugInfo = false; // OPT__SLASH_Zi
   bool DebugNameForBinary = false; // OPT_Zsb
   bool DebugNameForSource = false; // OPT_Zss
   bool DumpBin = false;        // OPT_dumpbin
+  bool ScanDeps = false;       // OPT_scan_deps
+  bool ScanDepsJson = false;   // OPT_scan_deps_json
   bool WarningAsError = false; // OPT__SLASH_WX
   bool IEEEStrict = false;     // OPT_Gis
   bool IgnoreLineDirectives = false; // OPT_ignore_line_directives
@@ -175,6 +188,7 @@ public:
   bool StripReflection = false; // OPT_Qstrip_reflect
   bool KeepReflectionInDxil = false; // OPT_Qkeep_reflect_in_dxil
   bool StripReflectionFromDxil = false; // OPT_Qstrip_reflect_from_dxil
+  bool MinimizeContainer = false; // OPT_Qminimize
   bool ExtractRootSignature = false; // OPT_extractrootsignature
   bool DisassembleColorCoded = false; // OPT_Cc
   bool DisassembleInstNumbers = false; //OPT_Ni
@@ -187,6 +201,8 @@ public:
   bool ResMayAlias = false; // OPT_res_may_alias
   unsigned long ValVerMajor = UINT_MAX, ValVerMinor = UINT_MAX; // OPT_validator_version
   unsigned ScanLimit = 0; // OPT_memdep_block_scan_limit
+  llvm::StringRef ProfileUnrollUse; // OPT_fprofile_unroll_use_EQ
+  bool PressureSchedule = false; // OPT_fpressure_schedule
 
   // Rewriter Options
   RewriterOpts RWOpt;
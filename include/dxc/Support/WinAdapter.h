@@ -124,6 +124,7 @@
 #define ERROR_FUNCTION_NOT_CALLED ENOSYS
 #define ERROR_IO_DEVICE EIO
 #define ERROR_INSUFFICIENT_BUFFER ENOBUFS
+#define ERROR_NO_UNICODE_TRANSLATION EILSEQ
 #define ERROR_INVALID_HANDLE EBADF
 #define ERROR_INVALID_PARAMETER EINVAL
 #define ERROR_OUT_OF_STRUCTURES ENOMEM
@@ -17,6 +17,8 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/ADT/ArrayRef.h"
 
+#include <functional>
+
 // Simple adaptor for IStream. Can probably do better.
 class raw_stream_ostream : public llvm::raw_ostream {
 private:
@@ -96,13 +98,14 @@ inline DxcOutputType DxcGetOutputType(DXC_OUT_KIND kind) {
   case DXC_OUT_DISASSEMBLY:
   case DXC_OUT_HLSL:
   case DXC_OUT_TEXT:
+  case DXC_OUT_TIME_TRACE:
     return DxcOutputType_Text;
   }
   return DxcOutputType_None;
 }
 
 // Update when new results are allowed
-static const unsigned kNumDxcOutputTypes = DXC_OUT_ROOT_SIGNATURE;
+static const unsigned kNumDxcOutputTypes = DXC_OUT_TIME_TRACE;
 static const SIZE_T kAutoSize = (SIZE_T)-1;
 static const LPCWSTR DxcOutNoName = nullptr;
 
@@ -110,6 +113,9 @@ struct DxcOutputObject {
   CComPtr<IUnknown> object;
   CComPtr<IDxcBlobUtf16> name;
   DXC_OUT_KIND kind = DXC_OUT_NONE;
+  // When set and object is null, invoked on first access to produce the
+  // output; the result is cached in object and the producer dropped.
+  std::function<HRESULT(IDxcBlob **)> producer;
 
   /////////////////////////
   // Convenient set methods
@@ -310,8 +316,11 @@ public:
     if (m_resultType == DXC_OUT_NONE)
       return S_OK;
     DxcOutputObject *pObject = Output(m_resultType);
-    if (pObject && pObject->object)
-      return pObject->object->QueryInterface(ppResult);
+    if (pObject) {
+      IFR(MaterializeOutput(*pObject));
+      if (pObject->object)
+        return pObject->object->QueryInterface(ppResult);
+    }
     return S_OK;
   }
 
@@ -346,6 +355,9 @@ public:
     *ppvObject = nullptr;
     if (ppOutputName)
       *ppOutputName = nullptr;
+    IFR(MaterializeOutput(object));
+    if (!object.object)
+      return E_FAIL;
     IFR(object.object->QueryInterface(iid, ppvObject));
     if (ppOutputName && object.name) {
       object.name.CopyTo(ppOutputName);
@@ -402,6 +414,34 @@ public:
     output.kind = DXC_OUT_NONE;
     output.object.Release();
     output.name.Release();
+    output.producer = nullptr;
+    return S_OK;
+  }
+
+  // Runs a deferred producer, caching its blob as the output object.
+  HRESULT MaterializeOutput(DxcOutputObject &output) {
+    if (output.object || !output.producer)
+      return S_OK;
+    CComPtr<IDxcBlob> pBlob;
+    IFR(output.producer(&pBlob));
+    output.producer = nullptr;
+    output.object = pBlob;
+    return S_OK;
+  }
+
+  // Register an output that is produced on first access rather than up
+  // front; kind becomes active immediately so HasOutput and enumeration
+  // reflect it.
+  HRESULT SetDeferredOutput(DXC_OUT_KIND kind,
+                            std::function<HRESULT(IDxcBlob **)> producer) {
+    if (kind <= DXC_OUT_NONE || (unsigned)kind > kNumDxcOutputTypes)
+      return E_INVALIDARG;
+    if (!producer)
+      return E_INVALIDARG;
+    DxcOutputObject &output = m_outputs[(unsigned)kind - 1];
+    output.kind = kind;
+    output.object.Release();
+    output.producer = std::move(producer);
     return S_OK;
   }
 
@@ -119,6 +119,11 @@ public:
   HRESULT CreateInstance2(IMalloc *pMalloc, REFCLSID clsid, REFIID riid, _Outptr_ IUnknown **pResult) {
     if (pResult == nullptr) return E_POINTER;
     if (m_dll == nullptr) return E_FAIL;
+    if (pMalloc == nullptr) {
+      // Without a custom allocator the plain entry point is equivalent, and
+      // is available even on libraries that don't export the '2' variant.
+      return m_createFn(clsid, riid, (LPVOID*)pResult);
+    }
     if (m_createFn2 == nullptr) return E_FAIL;
     HRESULT hr = m_createFn2(pMalloc, clsid, riid, (LPVOID*)pResult);
     return hr;
@@ -38,6 +38,7 @@ public:
   virtual void GetStdOutpuHandleStream(IStream **ppResultStream) = 0;
   virtual void WriteStdErrToStream(llvm::raw_string_ostream &s) = 0;
   virtual void EnableDisplayIncludeProcess() = 0;
+  virtual void EnableSharedIncludeCache() = 0;
   virtual HRESULT CreateStdStreams(_In_ IMalloc *pMalloc) = 0;
   virtual HRESULT RegisterOutputStream(LPCWSTR pName, IStream *pStream) = 0;
 };
@@ -46,4 +47,9 @@ DxcArgsFileSystem *
 CreateDxcArgsFileSystem(_In_ IDxcBlobUtf8 *pSource, _In_ LPCWSTR pSourceName,
                         _In_opt_ IDxcIncludeHandler *pIncludeHandler);
 
+/// Drops every entry from the process-wide include cache used by
+/// -fcache-includes. Hosts must call this whenever the include tree may have
+/// changed; compiles that don't pass the flag never consult the cache.
+void ClearSharedIncludeCache();
+
 } // namespace dxcutil
\ No newline at end of file
@@ -78,16 +78,22 @@ public:
 
 #define DXC_MICROCOM_REF_FIELD(m_dwRef)                                        \
   volatile std::atomic<llvm::sys::cas_flag> m_dwRef = {0};
+// Taking a new reference needs no ordering: the caller already holds a
+// reference that keeps the object alive. Dropping a reference releases the
+// caller's writes to the object, and the thread that performs the final
+// release acquires them before running the destructor.
 #define DXC_MICROCOM_ADDREF_IMPL(m_dwRef)                                      \
   ULONG STDMETHODCALLTYPE AddRef() override {                                  \
-    return (ULONG)++m_dwRef;                                                   \
+    return (ULONG)m_dwRef.fetch_add(1, std::memory_order_relaxed) + 1;         \
   }
 #define DXC_MICROCOM_ADDREF_RELEASE_IMPL(m_dwRef)                              \
   DXC_MICROCOM_ADDREF_IMPL(m_dwRef)                                            \
   ULONG STDMETHODCALLTYPE Release() override {                                 \
-    ULONG result = (ULONG)--m_dwRef;                                           \
-    if (result == 0)                                                           \
+    ULONG result = (ULONG)m_dwRef.fetch_sub(1, std::memory_order_release) - 1; \
+    if (result == 0) {                                                         \
+      std::atomic_thread_fence(std::memory_order_acquire);                     \
       delete this;                                                             \
+    }                                                                          \
     return result;                                                             \
   }
 
@@ -113,8 +119,9 @@ void DxcCallDestructor(T *obj) {
 #define DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()                                  \
   DXC_MICROCOM_ADDREF_IMPL(m_dwRef)                                            \
   ULONG STDMETHODCALLTYPE Release() override {                                 \
-    ULONG result = (ULONG)--m_dwRef;                                           \
+    ULONG result = (ULONG)m_dwRef.fetch_sub(1, std::memory_order_release) - 1; \
     if (result == 0) {                                                         \
+      std::atomic_thread_fence(std::memory_order_acquire);                     \
       CComPtr<IMalloc> pTmp(m_pMalloc);                                        \
       DxcThreadMalloc M(pTmp);                                                 \
       DxcCallDestructor(this);                                                 \
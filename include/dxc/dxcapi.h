@@ -187,6 +187,24 @@ IDxcIncludeHandler : public IUnknown {
   DECLARE_CROSS_PLATFORM_UUIDOF(IDxcIncludeHandler)
 };
 
+// Optional extension of an IDxcIncludeHandler implementation. When the
+// handler passed to Compile also implements this interface, the compiler
+// hands it batches of filenames it expects to request through LoadSource
+// soon, discovered by scanning opened sources for #include directives ahead
+// of the lexer. The handler may begin loading them asynchronously so the
+// later synchronous LoadSource calls hit warm data, or ignore any of them.
+// Names are unresolved candidates: they may not exist, may resolve to other
+// paths during header search, and may never be requested.
+struct __declspec(uuid("51610a2b-530a-44f5-bcbd-103677aff599"))
+IDxcIncludePrefetchHandler : public IUnknown {
+  virtual HRESULT STDMETHODCALLTYPE PrefetchSources(
+    _In_count_(count) LPCWSTR *pFilenames, // Candidate filenames, in order of appearance.
+    _In_ UINT32 count                      // Number of filenames.
+    ) = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcIncludePrefetchHandler)
+};
+
 // Structure for supplying bytes or text input to Dxc APIs.
 // Use Encoding = 0 for non-text bytes, ANSI text, or unknown with BOM.
 typedef struct DxcBuffer {
@@ -461,6 +479,7 @@ typedef enum DXC_OUT_KIND {
   DXC_OUT_TEXT = 7,           // IDxcBlobUtf8 or IDxcBlobUtf16 - other text, such as -ast-dump or -Odump
   DXC_OUT_REFLECTION = 8,     // IDxcBlob - RDAT part with reflection data
   DXC_OUT_ROOT_SIGNATURE = 9, // IDxcBlob - Serialized root signature output
+  DXC_OUT_TIME_TRACE = 10,    // IDxcBlobUtf8 or IDxcBlobUtf16 - chrome://tracing JSON from -ftime-trace
 
   DXC_OUT_FORCE_DWORD = 0xFFFFFFFF
 } DXC_OUT_KIND;
@@ -479,6 +498,13 @@ IDxcResult : public IDxcOperationResult {
   DECLARE_CROSS_PLATFORM_UUIDOF(IDxcResult)
 };
 
+// Thread-safety: Compile and Disassemble are re-entrant. They keep all
+// per-compile state on the stack and allocate through the IMalloc captured at
+// object creation, so a single IDxcCompiler3 instance may service concurrent
+// calls from multiple threads without external locking. Methods inherited
+// from other interfaces on the same object (e.g. IDxcLangExtensions
+// registration) mutate instance state and must not run concurrently with
+// Compile.
 struct __declspec(uuid("228B4687-5A6A-4730-900C-9702B2203F54"))
 IDxcCompiler3 : public IUnknown {
   // Compile a single entry point to the target shader model,
@@ -502,11 +528,125 @@ IDxcCompiler3 : public IUnknown {
   DECLARE_CROSS_PLATFORM_UUIDOF(IDxcCompiler3)
 };
 
+struct __declspec(uuid("05BFB70C-BA2B-4B5E-8AA0-44CF51937B23"))
+IDxcCompiler4 : public IDxcCompiler3 {
+  // Compile one source text under several argument sets (e.g. define
+  // permutations), amortizing per-batch setup across the sets. On success
+  // ppResults[i] receives the result for pArgumentSets[i]; results that
+  // could not be produced are left null and reflected in the return value.
+  virtual HRESULT STDMETHODCALLTYPE CompileMany(
+    _In_ const DxcBuffer *pSource,                   // Source text to compile
+    _In_count_(setCount) LPCWSTR **pArgumentSets,    // Array of argument vectors, one per permutation
+    _In_count_(setCount) UINT32 *pArgCounts,         // Number of arguments in each vector
+    _In_ UINT32 setCount,                            // Number of argument vectors
+    _In_opt_ IDxcIncludeHandler *pIncludeHandler,    // user-provided interface to handle #include directives (optional)
+    _In_ REFIID riid,                                // Interface for each result, e.g. IDxcResult
+    _Out_writes_(setCount) LPVOID *ppResults         // Receives setCount result pointers
+  ) = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcCompiler4)
+};
+
+// Caller-implemented completion callback for CompileAsync. Invoked exactly
+// once per submitted compile, on an internal worker thread.
+struct __declspec(uuid("9C9C5D04-2C4B-4D26-92D7-2A7E1F5D3A61"))
+IDxcAsyncCompileCallback : public IUnknown {
+  // hrCompile and pResult carry what a blocking Compile call would have
+  // returned. For a compile canceled before it started, hrCompile is E_ABORT
+  // and pResult is null.
+  virtual void STDMETHODCALLTYPE OnCompileComplete(
+    _In_ HRESULT hrCompile, _In_opt_ IDxcResult *pResult) = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcAsyncCompileCallback)
+};
+
+struct __declspec(uuid("3E2A79F1-7B4D-4E0B-B2A8-6C5E94D1F87B"))
+IDxcAsyncCompileOperation : public IUnknown {
+  // Cancels the compile if it has not started yet; its callback then fires
+  // with E_ABORT and no result. Returns S_OK if the compile was canceled,
+  // S_FALSE if it was already running or complete - a compile in flight
+  // cannot be interrupted.
+  virtual HRESULT STDMETHODCALLTYPE Cancel() = 0;
+
+  // Blocks until the callback for this operation has returned. Must not be
+  // called from within the callback itself.
+  virtual HRESULT STDMETHODCALLTYPE WaitForCompletion() = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcAsyncCompileOperation)
+};
+
+struct __declspec(uuid("6B8F2E3A-0D71-4C49-A5B2-8E14C9F0D27C"))
+IDxcCompiler5 : public IDxcCompiler4 {
+  // Caps how many CompileAsync operations from this instance run at once.
+  // 0 selects the hardware thread count. The limit is fixed once the first
+  // CompileAsync call has created the queue; later calls fail with E_FAIL.
+  virtual HRESULT STDMETHODCALLTYPE SetMaxAsyncConcurrency(
+    _In_ UINT32 maxConcurrency) = 0;
+
+  // Queues a compile and returns immediately; the source text and argument
+  // strings are copied, so the caller's buffers may be released as soon as
+  // this returns. Work runs on an internal pool shared by all CompileAsync
+  // calls in the process, and pCallback fires once per submission. The
+  // optional operation object supports cancellation and waiting; releasing
+  // it does not cancel the compile.
+  virtual HRESULT STDMETHODCALLTYPE CompileAsync(
+    _In_ const DxcBuffer *pSource,                // Source text to compile
+    _In_opt_count_(argCount) LPCWSTR *pArguments, // Array of pointers to arguments
+    _In_ UINT32 argCount,                         // Number of arguments
+    _In_opt_ IDxcIncludeHandler *pIncludeHandler, // user-provided interface to handle #include directives (optional)
+    _In_ IDxcAsyncCompileCallback *pCallback,     // Receives the IDxcResult when the compile finishes
+    _COM_Outptr_opt_ IDxcAsyncCompileOperation **ppOperation // Optional handle for cancellation and waiting
+  ) = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcCompiler5)
+};
+
+struct __declspec(uuid("2AE64D52-3C5E-4F1B-9A8D-7E0C61B54A29"))
+IDxcCompiler6 : public IDxcCompiler5 {
+  // Compile several entry points from one source text with a single
+  // front-end pass: the translation unit is parsed and checked once, then
+  // code generation and the backend run per entry over the shared AST. The
+  // shared arguments must not carry -E; entry-specific diagnostics are
+  // delivered on that entry's result, front-end diagnostics on every
+  // result. Restricted to plain shader targets: preprocessing, AST or
+  // pass dumps, PCH emission, -fcgl, library and rootsig profiles must go
+  // through Compile. On success ppResults[i] receives the result for
+  // pEntryPoints[i]; slots that could not be produced are left null and
+  // the first failing HRESULT is returned.
+  virtual HRESULT STDMETHODCALLTYPE CompileEntryPoints(
+    _In_ const DxcBuffer *pSource,                 // Source text to compile
+    _In_opt_count_(argCount) LPCWSTR *pArguments,  // Arguments shared by all entry points
+    _In_ UINT32 argCount,                          // Number of shared arguments
+    _In_count_(entryCount) LPCWSTR *pEntryPoints,  // Entry point names, as with -E
+    _In_ UINT32 entryCount,                        // Number of entry points
+    _In_opt_ IDxcIncludeHandler *pIncludeHandler,  // user-provided interface to handle #include directives (optional)
+    _In_ REFIID riid,                              // Interface for each result, e.g. IDxcResult
+    _Out_writes_(entryCount) LPVOID *ppResults     // Receives entryCount result pointers
+  ) = 0;
+
+  // Caps the process-wide worker pool backing all in-process parallelism:
+  // parallel validation, parallel container serialization, and CompileAsync
+  // all draw from one set of workers. 0 selects the hardware thread count.
+  // Hosts running many compiler instances concurrently should set this to
+  // their per-process budget before the first parallel feature is used; the
+  // cap is fixed once the workers have started, after which this fails with
+  // E_FAIL. The setting is process-global, not per compiler instance.
+  virtual HRESULT STDMETHODCALLTYPE SetMaxWorkerThreads(
+    _In_ UINT32 maxWorkers) = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcCompiler6)
+};
+
 static const UINT32 DxcValidatorFlags_Default = 0;
 static const UINT32 DxcValidatorFlags_InPlaceEdit = 1;  // Validator is allowed to update shader blob in-place.
 static const UINT32 DxcValidatorFlags_RootSignatureOnly = 2;
 static const UINT32 DxcValidatorFlags_ModuleOnly = 4;
-static const UINT32 DxcValidatorFlags_ValidMask = 0x7;
+static const UINT32 DxcValidatorFlags_InParallel = 8;   // Shard per-function validation across threads; diagnostics stay deterministic.
+static const UINT32 DxcValidatorFlags_QuietMode = 0x10; // Report pass/fail only; skip diagnostic message formatting.
+static const UINT32 DxcValidatorFlags_FastProfile = 0x20; // Structural and resource rules only; skips control-flow and
+                                                          // per-instruction checks. For inner-loop iteration; the shader
+                                                          // hash records that the reduced profile was used.
+static const UINT32 DxcValidatorFlags_ValidMask = 0x3F;
 
 struct __declspec(uuid("A6E82BD2-1FD7-4826-9811-2857E797F49A"))
 IDxcValidator : public IUnknown {
@@ -553,6 +693,19 @@ IDxcContainerReflection : public IUnknown {
   DECLARE_CROSS_PLATFORM_UUIDOF(IDxcContainerReflection)
 };
 
+struct __declspec(uuid("feeefb2d-3925-46b7-ad81-6d5a0c0d3bdf"))
+IDxcShaderStatistics : public IUnknown {
+  // Queries an instruction counter gathered by the compiler over the DXIL
+  // module. Obtained via QueryInterface from the reflection interfaces
+  // returned by IDxcContainerReflection::GetPartReflection. Counter names
+  // match the entries of the dx.counters module metadata, for example
+  // "insts", "floats", "branches", "barrier" or "atomic".
+  virtual HRESULT STDMETHODCALLTYPE GetCounterValue(_In_z_ LPCSTR pCounterName,
+    _Out_ UINT32 *pValue) = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcShaderStatistics)
+};
+
 struct __declspec(uuid("AE2CD79F-CC22-453F-9B6B-B124E7A5204C"))
 IDxcOptimizerPass : public IUnknown {
   virtual HRESULT STDMETHODCALLTYPE GetOptionName(_COM_Outptr_ LPWSTR *ppResult) = 0;
@@ -576,6 +729,32 @@ IDxcOptimizer : public IUnknown {
   DECLARE_CROSS_PLATFORM_UUIDOF(IDxcOptimizer)
 };
 
+struct __declspec(uuid("b48a9b2f-d4b6-4556-853c-be1e62319b6d"))
+IDxcOptimizerPipeline : public IUnknown {
+  // A pass list compiled once via IDxcOptimizer2::CompilePipeline and
+  // reusable against many modules. Run from one thread at a time.
+  virtual HRESULT STDMETHODCALLTYPE GetPassCount(_Out_ UINT32 *pCount) = 0;
+  virtual HRESULT STDMETHODCALLTYPE RunOptimizer(IDxcBlob *pBlob,
+    _COM_Outptr_ IDxcBlob **ppOutputModule,
+    _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) = 0;
+  // Totals accumulated over all RunOptimizer calls on this pipeline.
+  virtual HRESULT STDMETHODCALLTYPE GetRunStatistics(_Out_ UINT32 *pRunCount,
+    _Out_ UINT64 *pTotalMicroseconds) = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcOptimizerPipeline)
+};
+
+struct __declspec(uuid("7957d650-b1f7-4e72-bbd6-24243add272c"))
+IDxcOptimizer2 : public IDxcOptimizer {
+  // Parses and validates a pass description once; the returned pipeline
+  // can then be run against many modules without re-parsing.
+  virtual HRESULT STDMETHODCALLTYPE CompilePipeline(
+    _In_count_(optionCount) LPCWSTR *ppOptions, UINT32 optionCount,
+    _COM_Outptr_ IDxcOptimizerPipeline **ppPipeline) = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcOptimizer2)
+};
+
 static const UINT32 DxcVersionInfoFlags_None = 0;
 static const UINT32 DxcVersionInfoFlags_Debug = 1; // Matches VS_FF_DEBUG
 static const UINT32 DxcVersionInfoFlags_Internal = 2; // Internal Validator (non-signing)
@@ -243,4 +243,32 @@ public:
   virtual HRESULT STDMETHODCALLTYPE RegisterDxilContainerEventHandler(IDxcContainerEventsHandler *pHandler, UINT64 *pCookie) = 0;
   virtual HRESULT STDMETHODCALLTYPE UnRegisterDxilContainerEventHandler(UINT64 cookie) = 0;
 };
+
+struct __declspec(uuid("8a9acaac-ce4d-47ae-abb4-83a8450a964f"))
+IDxcCacheStorage : public IUnknown
+{
+public:
+  /// <summary>Looks up a previously stored compiled result.</summary>
+  /// <remarks>Returns S_OK and the stored blob on a hit; returns S_FALSE and
+  /// a null blob on a miss. The key is a hex digest string.</remarks>
+  virtual HRESULT STDMETHODCALLTYPE Lookup(LPCSTR pKey, _COM_Outptr_result_maybenull_ IDxcBlob **ppResult) = 0;
+  /// <summary>Stores a compiled result under the given key.</summary>
+  virtual HRESULT STDMETHODCALLTYPE Store(LPCSTR pKey, _In_ IDxcBlob *pResult) = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcCacheStorage)
+};
+
+struct __declspec(uuid("006836c6-3519-4d41-a1ca-7030d3908402"))
+IDxcCompileCache : public IUnknown
+{
+public:
+  /// <summary>Registers a storage backend for the compiled-result cache.
+  /// While one is registered, Compile() keys full-container compiles on a
+  /// digest of the preprocessed source and the argument vector, and returns
+  /// the stored container on a hit.</summary>
+  virtual HRESULT STDMETHODCALLTYPE RegisterCacheStorage(IDxcCacheStorage *pStorage) = 0;
+  virtual HRESULT STDMETHODCALLTYPE UnRegisterCacheStorage() = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcCompileCache)
+};
 #endif
@@ -153,6 +153,13 @@ typedef enum DxcTranslationUnitFlags
 
   // Used to indicate that the translation unit should be built with an
   // implicit precompiled header for the preamble.
+  //
+  // Note: this flag is currently accepted but has no effect. The compiler
+  // has no support for AST serialization, which the preamble PCH relies on,
+  // so reparses always process the full translation unit. Callers that want
+  // lower keystroke-driven reparse latency should prefer
+  // DxcTranslationUnitFlags_SkipFunctionBodies for queries that only need
+  // declarations.
   DxcTranslationUnitFlags_PrecompiledPreamble = 0x04,
 
   // Used to indicate that the translation unit should cache some
@@ -80,4 +80,50 @@ IDxcRewriter2 : public IDxcRewriter {
   DECLARE_CROSS_PLATFORM_UUIDOF(IDxcRewriter2)
 };
 
+struct __declspec(uuid("5d4b21a4-8d39-4d91-a1cf-3e6c2b48e0a3"))
+IDxcIncrementalCompiler : public IUnknown {
+
+  // Compiles an HLSL source like IDxcCompiler::Compile, but splits the
+  // preprocessed source into per-function libraries, compiles only the
+  // functions whose content hash is not already in the process-wide cache,
+  // and relinks the libraries into the final shader. Iterative edits that
+  // touch one function recompile one library.
+  virtual HRESULT STDMETHODCALLTYPE Compile(
+      _In_ IDxcBlob *pSource,                       // Source text to compile
+      _In_opt_z_ LPCWSTR pSourceName,               // Optional file name for pSource
+      _In_opt_z_ LPCWSTR pEntryPoint,               // Entry point name
+      _In_z_ LPCWSTR pTargetProfile,                // Shader profile to compile
+      _In_opt_count_(argCount) LPCWSTR *pArguments, // Array of pointers to arguments
+      _In_ UINT32 argCount,                         // Number of arguments
+      _In_count_(defineCount)
+        const DxcDefine *pDefines,                  // Array of defines
+      _In_ UINT32 defineCount,                      // Number of defines
+      _In_opt_ IDxcIncludeHandler *pIncludeHandler, // Handler for #include directives (optional)
+      _COM_Outptr_ IDxcOperationResult **ppResult   // Compiler output status, buffer, and errors
+      ) = 0;
+
+  // Drops every cached function library. Call when the cache may be stale
+  // for reasons hashing cannot see (e.g. a compiler upgrade in-place).
+  virtual HRESULT STDMETHODCALLTYPE ClearCache() = 0;
+
+  // Reports how the most recent Compile on this instance split the source:
+  // the number of function chunks and how many of them were served from the
+  // cache instead of being recompiled. Lets build tooling (and tests)
+  // observe how incremental a rebuild actually was.
+  virtual HRESULT STDMETHODCALLTYPE GetLastCompileStats(
+      _Out_opt_ UINT32 *pChunkCount,   // Chunks the source split into
+      _Out_opt_ UINT32 *pCacheHitCount // Chunks reused from the cache
+      ) = 0;
+
+  DECLARE_CROSS_PLATFORM_UUIDOF(IDxcIncrementalCompiler)
+};
+
+CLSID_SCOPE const CLSID
+    CLSID_DxcIncrementalCompiler = {/* 7a0ccf4d-3f32-4a21-825e-ba6b8a0f6c52 */
+                                    0x7a0ccf4d,
+                                    0x3f32,
+                                    0x4a21,
+                                    {0x82, 0x5e, 0xba, 0x6b, 0x8a, 0x0f, 0x6c,
+                                     0x52}};
+
 #endif
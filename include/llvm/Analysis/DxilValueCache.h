@@ -11,7 +11,10 @@
 #define LLVM_ANALYSIS_DXILVALUECACHE_H
 
 #include "llvm/Pass.h"
-#include "llvm/IR/ValueMap.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/ValueHandle.h"
+
+#include <memory>
 
 namespace llvm {
 
@@ -19,11 +22,18 @@ class Module;
 class DominatorTree;
 class Constant;
 class ConstantInt;
+class Function;
 
 struct DxilValueCache : public ImmutablePass {
   static char ID;
 
   // Special Weak Value to Weak Value map.
+  //
+  // Invalidation is lazy: deleting or RAUW'ing a value nulls the entry's
+  // handles, and the dead entry is skipped on read and swept out in bulk
+  // later, instead of being erased eagerly by a per-key callback the way
+  // ValueMap would. Entries are sharded by the function that owns the key
+  // so function-at-a-time passes touch disjoint maps.
   struct WeakValueMap {
     struct ValueVH : public CallbackVH {
       ValueVH(Value *V) : CallbackVH(V) {}
@@ -36,7 +46,7 @@ struct DxilValueCache : public ImmutablePass {
       inline void Set(llvm::Value *Key, llvm::Value *V) { Self = Key; Value = V; }
       inline bool IsStale() const { return Self == nullptr; }
     };
-    ValueMap<const Value *, ValueEntry> Map;
+    WeakValueMap() : StaleReads(0), InsertsSinceSweep(0) {}
     Value *Get(Value *V);
     void Set(Value *Key, Value *V);
     bool Seen(Value *v);
@@ -44,7 +54,15 @@ struct DxilValueCache : public ImmutablePass {
     void ResetUnknowns();
     void dump() const;
   private:
+    typedef DenseMap<const Value *, ValueEntry> ShardMap;
+    static const Function *ShardFor(const Value *V);
+    ShardMap &GetShard(const Value *V);
+    void NoteStaleRead();
+    void SweepStaleEntries();
     Value *GetSentinel(LLVMContext &Ctx);
+    DenseMap<const Function *, ShardMap> Shards;
+    unsigned StaleReads;
+    unsigned InsertsSinceSweep;
     std::unique_ptr<Value> Sentinel;
   };
 
@@ -76,6 +76,14 @@ public:
   /// custom metadata IDs registered in this LLVMContext.
   void getMDKindNames(SmallVectorImpl<StringRef> &Result) const;
 
+  // HLSL Change - Begin
+  /// Strip the names from all identified struct types in this context and
+  /// reset the name-collision counter. A context reused across independent
+  /// compiles would otherwise suffix colliding struct names (for example
+  /// "struct.S.0"), making the emitted IR depend on compile history.
+  void anonymizeStructTypeNames();
+  // HLSL Change - End
+
 
   typedef void (*InlineAsmDiagHandlerTy)(const SMDiagnostic&, void *Context,
                                          unsigned LocCookie);
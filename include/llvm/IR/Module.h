@@ -661,6 +661,15 @@ public:
   void print(raw_ostream &OS, AssemblyAnnotationWriter *AAW,
              bool ShouldPreserveUseListOrder = false) const;
 
+  // HLSL Change begin - parallel disassembly.
+  /// Print the module to an output stream, formatting function bodies on up
+  /// to \c NumThreads worker threads (0 selects the hardware concurrency).
+  /// Produces output identical to print(); falls back to the serial printer
+  /// for small modules where threading would not pay for itself.
+  void printParallel(raw_ostream &OS, AssemblyAnnotationWriter *AAW,
+                     unsigned NumThreads = 0) const;
+  // HLSL Change end
+
   /// Dump the module to stderr (for debugging).
   void dump() const;
   
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// ThreadPool.h                                                              //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source    //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Process-wide work-stealing thread pool shared by all in-process          //
+// parallelism (parallel validation, container serialization, async        //
+// compilation). Centralizing the workers keeps N concurrent compiles on   //
+// an N-core host from each spawning their own threads and oversubscribing //
+// the machine.                                                              //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef LLVM_SUPPORT_THREADPOOL_H
+#define LLVM_SUPPORT_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hlsl {
+
+class ThreadPoolTaskGroup;
+
+// Relative scheduling class for submitted tasks. High tasks are claimed
+// before Normal ones regardless of submission order; use High for work a
+// caller is blocked on and Normal for background or batch work.
+enum class ThreadPoolPriority : unsigned {
+  High = 0,
+  Normal = 1,
+};
+
+class ThreadPool {
+public:
+  // Returns the process-wide pool, creating its workers on first use.
+  static ThreadPool &Get();
+
+  // Caps the process-wide worker count; zero selects the hardware thread
+  // count. Returns false once the pool exists - the cap is fixed when the
+  // first task starts the workers.
+  static bool SetWorkerCountCap(unsigned maxWorkers);
+
+  unsigned GetWorkerCount() const { return m_workerCount; }
+
+  // Queues fn for execution on a worker thread. Tasks must not let
+  // exceptions escape; a throwing task terminates the process, exactly as
+  // it would have on a dedicated std::thread. When pGroup is given its
+  // Wait() blocks until the task has completed.
+  void Async(std::function<void()> fn,
+             ThreadPoolPriority priority = ThreadPoolPriority::High,
+             ThreadPoolTaskGroup *pGroup = nullptr);
+
+  // Claims and runs one queued task on the calling thread, preferring High
+  // priority work. Returns false if no task was available.
+  bool TryExecuteOneTask();
+
+private:
+  friend class ThreadPoolTaskGroup;
+
+  struct Task {
+    std::function<void()> Fn;
+    ThreadPoolTaskGroup *Group;
+  };
+
+  // One lock-protected pair of deques per worker, indexed by priority. The
+  // owner pops its own newest task (LIFO, cache-warm); everyone else steals
+  // the oldest (FIFO), which is the classic work-stealing discipline.
+  struct WorkerQueue {
+    std::mutex Mutex;
+    std::deque<Task> Tasks[2];
+  };
+
+  explicit ThreadPool(unsigned workerCount);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  void WorkerLoop(unsigned workerIndex);
+  bool PopTask(unsigned workerIndex, Task &task);
+  void RunTask(Task &task);
+
+  const unsigned m_workerCount;
+  std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+  std::atomic<unsigned> m_nextQueue;
+  std::atomic<size_t> m_pendingTasks;
+  std::mutex m_sleepMutex;
+  std::condition_variable m_sleepCv;
+};
+
+// Completion tracking for a set of related tasks; stack-scoped at the
+// submission site. The destructor waits, so captured-by-reference state
+// outlives every task submitted against the group.
+class ThreadPoolTaskGroup {
+public:
+  ThreadPoolTaskGroup() = default;
+  ThreadPoolTaskGroup(const ThreadPoolTaskGroup &) = delete;
+  ThreadPoolTaskGroup &operator=(const ThreadPoolTaskGroup &) = delete;
+  ~ThreadPoolTaskGroup() { Wait(); }
+
+  // Blocks until every task submitted against this group has completed.
+  // The calling thread drains queued pool work while it waits, so waiting
+  // from inside a pool task cannot deadlock a fully occupied pool.
+  void Wait();
+
+private:
+  friend class ThreadPool;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  size_t m_outstanding = 0;
+};
+
+} // namespace hlsl
+
+#endif // LLVM_SUPPORT_THREADPOOL_H
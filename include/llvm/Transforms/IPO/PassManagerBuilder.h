@@ -15,6 +15,7 @@
 #ifndef LLVM_TRANSFORMS_IPO_PASSMANAGERBUILDER_H
 #define LLVM_TRANSFORMS_IPO_PASSMANAGERBUILDER_H
 
+#include <string> // HLSL Change
 #include <vector>
 
 namespace hlsl {
@@ -131,6 +132,8 @@ public:
   hlsl::HLSLExtensionsCodegenHelper *HLSLExtensionsCodeGen = nullptr; // HLSL Change
   bool HLSLResMayAlias = false; // HLSL Change
   unsigned ScanLimit = 0; // HLSL Change
+  std::string HLSLProfileUnrollUse; // HLSL Change - per-loop unroll factors from profiling
+  bool HLSLPressureSchedule = false; // HLSL Change - late sink-toward-uses scheduling
 
 private:
   /// ExtensionList - This is list of all of the extensions that are registered.
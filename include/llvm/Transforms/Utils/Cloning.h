@@ -18,6 +18,7 @@
 #ifndef LLVM_TRANSFORMS_UTILS_CLONING_H
 #define LLVM_TRANSFORMS_UTILS_CLONING_H
 
+#include "llvm/ADT/STLExtras.h" // HLSL Change - for function_ref
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/IR/ValueHandle.h"
@@ -28,6 +29,7 @@ namespace llvm {
 
 class Module;
 class Function;
+class GlobalValue; // HLSL Change
 class Instruction;
 class Pass;
 class LPPassManager;
@@ -52,6 +54,16 @@ class DominatorTree;
 Module *CloneModule(const Module *M);
 Module *CloneModule(const Module *M, ValueToValueMapTy &VMap);
 
+// HLSL Change - begin
+/// Return a copy of the specified module. The ShouldCloneDefinition callback
+/// controls whether a specific GlobalValue's definition is cloned. If the
+/// callback returns false, the global is reduced to an external declaration,
+/// which avoids cloning its body or initializer.
+Module *CloneModule(const Module *M, ValueToValueMapTy &VMap,
+                    function_ref<bool(const GlobalValue *)>
+                        ShouldCloneDefinition);
+// HLSL Change - end
+
 /// ClonedCodeInfo - This struct can be used to capture information about code
 /// being cloned, while it is being cloned.
 struct ClonedCodeInfo {
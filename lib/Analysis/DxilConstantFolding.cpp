@@ -34,6 +34,7 @@
 #include <cmath>
 #include <algorithm>
 #include <functional>
+#include <initializer_list>
 
 #include "dxc/DXIL/DXIL.h"
 #include "dxc/HLSL/DxilConvergentName.h"
@@ -434,105 +435,167 @@ static Constant *ConstantFoldQuaternaryIntInstrinsic(OP::OpCode opcode, Type *Ty
   return ConstantInt::get(Ty, result);
 }
 
-// Top level function to constant fold floating point intrinsics.
-static Constant *ConstantFoldFPIntrinsic(OP::OpCode opcode, Type *Ty, const DxilIntrinsicOperands &IntrinsicOperands) {
+// Per-arity adapters that unpack call operands and hand off to the
+// evaluation routines above. These are the targets of the opcode-indexed
+// dispatch table below.
+static Constant *FoldUnaryFP(OP::OpCode opcode, Type *Ty, const DxilIntrinsicOperands &IntrinsicOperands) {
   if (!Ty->isHalfTy() && !Ty->isFloatTy() && !Ty->isDoubleTy())
     return nullptr;
+  assert(IntrinsicOperands.Size() == 1);
+  ConstantFP *Op = IntrinsicOperands.GetConstantFloat(0);
 
-  OP::OpCodeClass opClass = OP::GetOpCodeClass(opcode);
+  if (!IsValidOp(Op))
+    return nullptr;
 
-  switch (opClass) {
-  default: break;
-  case OP::OpCodeClass::Unary: {
-    assert(IntrinsicOperands.Size() == 1);
-    ConstantFP *Op = IntrinsicOperands.GetConstantFloat(0);
+  return ConstantFoldUnaryFPIntrinsic(opcode, Ty, Op);
+}
 
-    if (!IsValidOp(Op))
-      return nullptr;
+static Constant *FoldBinaryFP(OP::OpCode opcode, Type *Ty, const DxilIntrinsicOperands &IntrinsicOperands) {
+  if (!Ty->isHalfTy() && !Ty->isFloatTy() && !Ty->isDoubleTy())
+    return nullptr;
+  assert(IntrinsicOperands.Size() == 2);
+  ConstantFP *Op1 = IntrinsicOperands.GetConstantFloat(0);
+  ConstantFP *Op2 = IntrinsicOperands.GetConstantFloat(1);
 
-    return ConstantFoldUnaryFPIntrinsic(opcode, Ty, Op);
-  }
-  case OP::OpCodeClass::Binary: {
-    assert(IntrinsicOperands.Size() == 2);
-    ConstantFP *Op1 = IntrinsicOperands.GetConstantFloat(0);
-    ConstantFP *Op2 = IntrinsicOperands.GetConstantFloat(1);
+  if (!IsValidOp(Op1) || !IsValidOp(Op2))
+    return nullptr;
 
-    if (!IsValidOp(Op1) || !IsValidOp(Op2))
-      return nullptr;
+  return ConstantFoldBinaryFPIntrinsic(opcode, Ty, Op1, Op2);
+}
 
-    return ConstantFoldBinaryFPIntrinsic(opcode, Ty, Op1, Op2);
-  }
-  case OP::OpCodeClass::Tertiary: {
-    assert(IntrinsicOperands.Size() == 3);
-    ConstantFP *Op1 = IntrinsicOperands.GetConstantFloat(0);
-    ConstantFP *Op2 = IntrinsicOperands.GetConstantFloat(1);
-    ConstantFP *Op3 = IntrinsicOperands.GetConstantFloat(2);
+static Constant *FoldTernaryFP(OP::OpCode opcode, Type *Ty, const DxilIntrinsicOperands &IntrinsicOperands) {
+  if (!Ty->isHalfTy() && !Ty->isFloatTy() && !Ty->isDoubleTy())
+    return nullptr;
+  assert(IntrinsicOperands.Size() == 3);
+  ConstantFP *Op1 = IntrinsicOperands.GetConstantFloat(0);
+  ConstantFP *Op2 = IntrinsicOperands.GetConstantFloat(1);
+  ConstantFP *Op3 = IntrinsicOperands.GetConstantFloat(2);
+
+  if (!IsValidOp(Op1) || !IsValidOp(Op2) || !IsValidOp(Op3))
+    return nullptr;
 
-    if (!IsValidOp(Op1) || !IsValidOp(Op2) || !IsValidOp(Op3))
-      return nullptr;
+  return ConstantFoldTernaryFPIntrinsic(opcode, Ty, Op1, Op2, Op3);
+}
 
-    return ConstantFoldTernaryFPIntrinsic(opcode, Ty, Op1, Op2, Op3);
-  }
-  case OP::OpCodeClass::Dot2:
-  case OP::OpCodeClass::Dot3:
-  case OP::OpCodeClass::Dot4:
-    return ConstantFoldDot(opcode, Ty, IntrinsicOperands);
-  }
+static Constant *FoldDotFP(OP::OpCode opcode, Type *Ty, const DxilIntrinsicOperands &IntrinsicOperands) {
+  if (!Ty->isHalfTy() && !Ty->isFloatTy() && !Ty->isDoubleTy())
+    return nullptr;
+  return ConstantFoldDot(opcode, Ty, IntrinsicOperands);
+}
 
-  return nullptr;
+static bool IsFoldableIntTy(Type *Ty) {
+  return Ty->isIntegerTy() &&
+         Ty->getScalarSizeInBits() <= (sizeof(int64_t) * CHAR_BIT);
 }
 
-// Top level function to constant fold integer intrinsics.
-static Constant *ConstantFoldIntIntrinsic(OP::OpCode opcode, Type *Ty, const DxilIntrinsicOperands &IntrinsicOperands) {
-  if (Ty->getScalarSizeInBits() > (sizeof(int64_t) * CHAR_BIT))
+static Constant *FoldUnaryInt(OP::OpCode opcode, Type *Ty, const DxilIntrinsicOperands &IntrinsicOperands) {
+  if (!IsFoldableIntTy(Ty))
+    return nullptr;
+  assert(IntrinsicOperands.Size() == 1);
+  ConstantInt *Op = IntrinsicOperands.GetConstantInt(0);
+  if (!Op)
     return nullptr;
 
-  OP::OpCodeClass opClass = OP::GetOpCodeClass(opcode);
+  return ConstantFoldUnaryIntIntrinsic(opcode, Ty, Op);
+}
 
-  switch (opClass) {
-  default: break;
-  case OP::OpCodeClass::Unary:
-  case OP::OpCodeClass::UnaryBits: {
-    assert(IntrinsicOperands.Size() == 1);
-    ConstantInt *Op = IntrinsicOperands.GetConstantInt(0);
-    if (!Op)
-      return nullptr;
-
-    return ConstantFoldUnaryIntIntrinsic(opcode, Ty, Op);
-  }
-  case OP::OpCodeClass::Binary: {
-    assert(IntrinsicOperands.Size() == 2);
-    ConstantInt *Op1 = IntrinsicOperands.GetConstantInt(0);
-    ConstantInt *Op2 = IntrinsicOperands.GetConstantInt(1);
-    if (!Op1 || !Op2)
-      return nullptr;
-    
-    return ConstantFoldBinaryIntIntrinsic(opcode, Ty, Op1, Op2);
-  }
-  case OP::OpCodeClass::Tertiary: {
-    assert(IntrinsicOperands.Size() == 3);
-    ConstantInt *Op1 = IntrinsicOperands.GetConstantInt(0);
-    ConstantInt *Op2 = IntrinsicOperands.GetConstantInt(1);
-    ConstantInt *Op3 = IntrinsicOperands.GetConstantInt(2);
-    if (!Op1 || !Op2 || !Op3)
-      return nullptr;
-    
-    return ConstantFoldTernaryIntIntrinsic(opcode, Ty, Op1, Op2, Op3);
-  }
-  case OP::OpCodeClass::Quaternary: {
-    assert(IntrinsicOperands.Size() == 4);
-    ConstantInt *Op1 = IntrinsicOperands.GetConstantInt(0);
-    ConstantInt *Op2 = IntrinsicOperands.GetConstantInt(1);
-    ConstantInt *Op3 = IntrinsicOperands.GetConstantInt(2);
-    ConstantInt *Op4 = IntrinsicOperands.GetConstantInt(3);
-    if (!Op1 || !Op2 || !Op3 || !Op4)
-      return nullptr;
+static Constant *FoldBinaryInt(OP::OpCode opcode, Type *Ty, const DxilIntrinsicOperands &IntrinsicOperands) {
+  if (!IsFoldableIntTy(Ty))
+    return nullptr;
+  assert(IntrinsicOperands.Size() == 2);
+  ConstantInt *Op1 = IntrinsicOperands.GetConstantInt(0);
+  ConstantInt *Op2 = IntrinsicOperands.GetConstantInt(1);
+  if (!Op1 || !Op2)
+    return nullptr;
 
-    return ConstantFoldQuaternaryIntInstrinsic(opcode, Ty, Op1, Op2, Op3, Op4);
-  }
+  return ConstantFoldBinaryIntIntrinsic(opcode, Ty, Op1, Op2);
+}
+
+static Constant *FoldTernaryInt(OP::OpCode opcode, Type *Ty, const DxilIntrinsicOperands &IntrinsicOperands) {
+  if (!IsFoldableIntTy(Ty))
+    return nullptr;
+  assert(IntrinsicOperands.Size() == 3);
+  ConstantInt *Op1 = IntrinsicOperands.GetConstantInt(0);
+  ConstantInt *Op2 = IntrinsicOperands.GetConstantInt(1);
+  ConstantInt *Op3 = IntrinsicOperands.GetConstantInt(2);
+  if (!Op1 || !Op2 || !Op3)
+    return nullptr;
+
+  return ConstantFoldTernaryIntIntrinsic(opcode, Ty, Op1, Op2, Op3);
+}
+
+static Constant *FoldQuaternaryInt(OP::OpCode opcode, Type *Ty, const DxilIntrinsicOperands &IntrinsicOperands) {
+  if (!IsFoldableIntTy(Ty))
+    return nullptr;
+  assert(IntrinsicOperands.Size() == 4);
+  ConstantInt *Op1 = IntrinsicOperands.GetConstantInt(0);
+  ConstantInt *Op2 = IntrinsicOperands.GetConstantInt(1);
+  ConstantInt *Op3 = IntrinsicOperands.GetConstantInt(2);
+  ConstantInt *Op4 = IntrinsicOperands.GetConstantInt(3);
+  if (!Op1 || !Op2 || !Op3 || !Op4)
+    return nullptr;
+
+  return ConstantFoldQuaternaryIntInstrinsic(opcode, Ty, Op1, Op2, Op3, Op4);
+}
+
+// Dispatch table indexed directly by DXIL opcode. Each foldable opcode maps
+// to its per-arity adapter; everything else stays null, so the common case
+// of an op we do not fold is a single table load instead of two chained
+// switches through the opcode class.
+typedef Constant *(*DxilFoldFn)(OP::OpCode, Type *, const DxilIntrinsicOperands &);
+
+namespace {
+struct DxilFoldTable {
+  DxilFoldFn Fns[static_cast<unsigned>(OP::OpCode::NumOpCodes)];
+  void Set(OP::OpCode op, DxilFoldFn Fn) { Fns[static_cast<unsigned>(op)] = Fn; }
+  DxilFoldTable() {
+    std::fill(Fns, Fns + static_cast<unsigned>(OP::OpCode::NumOpCodes),
+              nullptr);
+    // Unary float.
+    for (OP::OpCode op : { OP::OpCode::FAbs, OP::OpCode::Saturate,
+                           OP::OpCode::Cos, OP::OpCode::Sin, OP::OpCode::Tan,
+                           OP::OpCode::Acos, OP::OpCode::Asin, OP::OpCode::Atan,
+                           OP::OpCode::Hcos, OP::OpCode::Hsin, OP::OpCode::Htan,
+                           OP::OpCode::Exp, OP::OpCode::Frc, OP::OpCode::Log,
+                           OP::OpCode::Sqrt, OP::OpCode::Rsqrt,
+                           OP::OpCode::Round_ne, OP::OpCode::Round_ni,
+                           OP::OpCode::Round_pi, OP::OpCode::Round_z })
+      Set(op, FoldUnaryFP);
+    // Binary float.
+    Set(OP::OpCode::FMax, FoldBinaryFP);
+    Set(OP::OpCode::FMin, FoldBinaryFP);
+    // Ternary float.
+    Set(OP::OpCode::FMad, FoldTernaryFP);
+    Set(OP::OpCode::Fma, FoldTernaryFP);
+    // Dot products.
+    Set(OP::OpCode::Dot2, FoldDotFP);
+    Set(OP::OpCode::Dot3, FoldDotFP);
+    Set(OP::OpCode::Dot4, FoldDotFP);
+    // Unary int.
+    for (OP::OpCode op : { OP::OpCode::Bfrev, OP::OpCode::Countbits,
+                           OP::OpCode::FirstbitLo, OP::OpCode::FirstbitHi,
+                           OP::OpCode::FirstbitSHi })
+      Set(op, FoldUnaryInt);
+    // Binary int.
+    for (OP::OpCode op : { OP::OpCode::IMin, OP::OpCode::IMax,
+                           OP::OpCode::UMin, OP::OpCode::UMax })
+      Set(op, FoldBinaryInt);
+    // Ternary int.
+    for (OP::OpCode op : { OP::OpCode::IMad, OP::OpCode::UMad,
+                           OP::OpCode::Ubfe, OP::OpCode::Ibfe })
+      Set(op, FoldTernaryInt);
+    // Quaternary int.
+    Set(OP::OpCode::Bfi, FoldQuaternaryInt);
+  }
+  DxilFoldFn Get(OP::OpCode op) const {
+    return Fns[static_cast<unsigned>(op)];
   }
+};
+}
 
-  return nullptr;
+static DxilFoldFn LookupDxilFoldFn(OP::OpCode opcode) {
+  static const DxilFoldTable Table;
+  return Table.Get(opcode);
 }
 
 // External entry point to constant fold dxil intrinsics.
@@ -540,13 +603,9 @@ static Constant *ConstantFoldIntIntrinsic(OP::OpCode opcode, Type *Ty, const Dxi
 Constant *hlsl::ConstantFoldScalarCall(StringRef Name, Type *Ty, ArrayRef<Constant *> RawOperands) {
   OP::OpCode opcode;
   if (GetDxilOpcode(Name, RawOperands, opcode)) {
-    DxilIntrinsicOperands IntrinsicOperands(RawOperands);
-
-    if (Ty->isFloatingPointTy()) {
-      return ConstantFoldFPIntrinsic(opcode, Ty, IntrinsicOperands);
-    }
-    else if (Ty->isIntegerTy()) {
-      return ConstantFoldIntIntrinsic(opcode, Ty, IntrinsicOperands);
+    if (DxilFoldFn Fn = LookupDxilFoldFn(opcode)) {
+      DxilIntrinsicOperands IntrinsicOperands(RawOperands);
+      return Fn(opcode, Ty, IntrinsicOperands);
     }
   } else if (IsConvergentMarker(Name.data())) {
     assert(RawOperands.size() == 1);
@@ -39,6 +39,234 @@ DXIL::OpCode GetOpcode(Value *opArg) {
   }
   return DXIL::OpCode::NumOpCodes;
 }
+
+// Algebraic rule table for the ALU opcode space. Each opcode maps to the
+// identity family that applies to it; the handlers below interpret the
+// rule. Only identities that hold for every input are used - with the
+// fast-math latitude HLSL grants, since precise calls are rejected before
+// rules are consulted.
+enum class RuleKind : uint8_t {
+  None,
+  UnaryIdempotent, // f(f(x)) == f(x)
+  MinMax,          // f(x, x) == x, plus integer identity/absorbing consts
+  Mad,             // a * b + c with 0 or 1 multiplicands
+  Dot,             // lanes with constant 0 or 1 components collapse
+};
+
+// For integer min/max, the operand value that leaves the other operand
+// unchanged; its dual (the opposite extreme) absorbs instead.
+enum class IdentityValue : uint8_t {
+  None,
+  Zero,      // UMax
+  AllBits,   // UMin
+  SignedMin, // IMax
+  SignedMax, // IMin
+};
+
+struct OpRule {
+  RuleKind Kind = RuleKind::None;
+  IdentityValue Identity = IdentityValue::None;
+  unsigned DotSize = 0; // Components per vector operand for RuleKind::Dot.
+};
+
+OpRule GetOpRule(DXIL::OpCode opcode) {
+  OpRule rule;
+  switch (opcode) {
+  default:
+    break;
+  case DXIL::OpCode::Saturate:
+  case DXIL::OpCode::FAbs:
+    rule.Kind = RuleKind::UnaryIdempotent;
+    break;
+  case DXIL::OpCode::FMax:
+  case DXIL::OpCode::FMin:
+    rule.Kind = RuleKind::MinMax;
+    break;
+  case DXIL::OpCode::IMax:
+    rule.Kind = RuleKind::MinMax;
+    rule.Identity = IdentityValue::SignedMin;
+    break;
+  case DXIL::OpCode::IMin:
+    rule.Kind = RuleKind::MinMax;
+    rule.Identity = IdentityValue::SignedMax;
+    break;
+  case DXIL::OpCode::UMax:
+    rule.Kind = RuleKind::MinMax;
+    rule.Identity = IdentityValue::Zero;
+    break;
+  case DXIL::OpCode::UMin:
+    rule.Kind = RuleKind::MinMax;
+    rule.Identity = IdentityValue::AllBits;
+    break;
+  case DXIL::OpCode::FMad:
+  case DXIL::OpCode::IMad:
+  case DXIL::OpCode::UMad:
+    rule.Kind = RuleKind::Mad;
+    break;
+  case DXIL::OpCode::Dot2:
+    rule.Kind = RuleKind::Dot;
+    rule.DotSize = 2;
+    break;
+  case DXIL::OpCode::Dot3:
+    rule.Kind = RuleKind::Dot;
+    rule.DotSize = 3;
+    break;
+  case DXIL::OpCode::Dot4:
+    rule.Kind = RuleKind::Dot;
+    rule.DotSize = 4;
+    break;
+  }
+  return rule;
+}
+
+// Returns true when V is a call to the dxil op with the given opcode.
+bool IsDxilOpCall(Value *V, DXIL::OpCode opcode) {
+  CallInst *CI = dyn_cast<CallInst>(V);
+  if (!CI)
+    return false;
+  Function *F = CI->getCalledFunction();
+  if (!F || !OP::IsDxilOpFunc(F) || CI->getNumArgOperands() == 0)
+    return false;
+  return GetOpcode(CI->getArgOperand(0)) == opcode;
+}
+
+Value *SimplifyUnaryIdempotent(DXIL::OpCode opcode, ArrayRef<Value *> Args) {
+  Value *src = Args[DXIL::OperandIndex::kUnarySrc0OpIdx];
+  // f(f(x)) == f(x): saturate of saturate, abs of abs.
+  if (IsDxilOpCall(src, opcode))
+    return src;
+  // abs of an already-saturated value is a no-op; [0,1] is non-negative.
+  if (opcode == DXIL::OpCode::FAbs && IsDxilOpCall(src, DXIL::OpCode::Saturate))
+    return src;
+  return nullptr;
+}
+
+Value *SimplifyMinMax(const OpRule &rule, ArrayRef<Value *> Args) {
+  Value *op0 = Args[DXIL::OperandIndex::kBinarySrc0OpIdx];
+  Value *op1 = Args[DXIL::OperandIndex::kBinarySrc1OpIdx];
+  // min(x, x) == x and max(x, x) == x; this holds for NaN as well, both
+  // DXIL orderings return the same value when the operands are the one
+  // value.
+  if (op0 == op1)
+    return op0;
+  if (rule.Identity == IdentityValue::None)
+    return nullptr;
+
+  Type *Ty = op0->getType();
+  unsigned bitWidth = Ty->getScalarSizeInBits();
+  Constant *identity = nullptr;
+  Constant *absorbing = nullptr;
+  switch (rule.Identity) {
+  case IdentityValue::Zero: // UMax
+    identity = ConstantInt::get(Ty, 0);
+    absorbing = Constant::getAllOnesValue(Ty);
+    break;
+  case IdentityValue::AllBits: // UMin
+    identity = Constant::getAllOnesValue(Ty);
+    absorbing = ConstantInt::get(Ty, 0);
+    break;
+  case IdentityValue::SignedMin: // IMax
+    identity = ConstantInt::get(Ty, APInt::getSignedMinValue(bitWidth));
+    absorbing = ConstantInt::get(Ty, APInt::getSignedMaxValue(bitWidth));
+    break;
+  case IdentityValue::SignedMax: // IMin
+    identity = ConstantInt::get(Ty, APInt::getSignedMaxValue(bitWidth));
+    absorbing = ConstantInt::get(Ty, APInt::getSignedMinValue(bitWidth));
+    break;
+  default:
+    return nullptr;
+  }
+  // f(x, identity) == x; f(x, absorbing) == absorbing.
+  if (op0 == identity)
+    return op1;
+  if (op1 == identity)
+    return op0;
+  if (op0 == absorbing || op1 == absorbing)
+    return op0 == absorbing ? op0 : op1;
+  return nullptr;
+}
+
+Value *SimplifyMad(DXIL::OpCode opcode, ArrayRef<Value *> Args,
+                   Instruction *I) {
+  Value *op0 = Args[DXIL::OperandIndex::kTrinarySrc0OpIdx];
+  Value *op1 = Args[DXIL::OperandIndex::kTrinarySrc1OpIdx];
+  Value *op2 = Args[DXIL::OperandIndex::kTrinarySrc2OpIdx];
+  if (opcode == DXIL::OpCode::FMad) {
+    Constant *zero = ConstantFP::get(op0->getType(), 0);
+    if (op0 == zero || op1 == zero)
+      return op2;
+
+    Constant *one = ConstantFP::get(op0->getType(), 1);
+    if (op0 == one || op1 == one) {
+      IRBuilder<> Builder(I);
+      llvm::FastMathFlags FMF;
+      FMF.setUnsafeAlgebraHLSL();
+      Builder.SetFastMathFlags(FMF);
+      return Builder.CreateFAdd(op0 == one ? op1 : op0, op2);
+    }
+    return nullptr;
+  }
+
+  Constant *zero = ConstantInt::get(op0->getType(), 0);
+  if (op0 == zero || op1 == zero)
+    return op2;
+
+  Constant *one = ConstantInt::get(op0->getType(), 1);
+  if (op0 == one || op1 == one) {
+    IRBuilder<> Builder(I);
+    return Builder.CreateAdd(op0 == one ? op1 : op0, op2);
+  }
+  return nullptr;
+}
+
+// Collapses dot-product lanes whose components are constant: a lane with a
+// 0 on either side drops out, a lane with a 1 contributes the other
+// component directly. When at least one lane collapses the remaining lanes
+// are expanded to scalar multiply-adds, which instcombine and the generated
+// material graphs downstream handle far better than an opaque dot call.
+Value *SimplifyDot(Function *F, unsigned dotSize, ArrayRef<Value *> Args,
+                   Instruction *I) {
+  SmallVector<std::pair<Value *, Value *>, 4> terms;
+  bool simplifiedLane = false;
+  for (unsigned i = 0; i < dotSize; ++i) {
+    Value *a = Args[1 + i];
+    Value *b = Args[1 + dotSize + i];
+    ConstantFP *ca = dyn_cast<ConstantFP>(a);
+    ConstantFP *cb = dyn_cast<ConstantFP>(b);
+    if ((ca && ca->isZero()) || (cb && cb->isZero())) {
+      simplifiedLane = true;
+      continue;
+    }
+    if (ca && ca->isExactlyValue(1.0)) {
+      terms.emplace_back(b, nullptr);
+      simplifiedLane = true;
+      continue;
+    }
+    if (cb && cb->isExactlyValue(1.0)) {
+      terms.emplace_back(a, nullptr);
+      simplifiedLane = true;
+      continue;
+    }
+    terms.emplace_back(a, b); // Lane still needs its multiply.
+  }
+  if (!simplifiedLane)
+    return nullptr;
+  if (terms.empty())
+    return ConstantFP::get(F->getReturnType(), 0);
+
+  IRBuilder<> Builder(I);
+  llvm::FastMathFlags FMF;
+  FMF.setUnsafeAlgebraHLSL();
+  Builder.SetFastMathFlags(FMF);
+  Value *sum = nullptr;
+  for (std::pair<Value *, Value *> &term : terms) {
+    Value *lane = term.second == nullptr
+                      ? term.first
+                      : Builder.CreateFMul(term.first, term.second);
+    sum = sum == nullptr ? lane : Builder.CreateFAdd(sum, lane);
+  }
+  return sum;
+}
 } // namespace
 
 namespace hlsl {
@@ -54,12 +282,18 @@ bool CanSimplify(const llvm::Function *F) {
   const bool found =
       F->getParent()->GetDxilModule().GetOP()->GetOpCodeClass(F, opClass);
 
-  // Return true for those dxil operation classes we can simplify.
+  // Return true for those dxil operation classes the rule table covers;
+  // opcodes in these classes without a rule fail fast in SimplifyDxilCall.
   if (found) {
     switch (opClass) {
     default:
       break;
+    case OP::OpCodeClass::Unary:
+    case OP::OpCodeClass::Binary:
     case OP::OpCodeClass::Tertiary:
+    case OP::OpCodeClass::Dot2:
+    case OP::OpCodeClass::Dot3:
+    case OP::OpCodeClass::Dot4:
       return true;
     }
   }
@@ -111,60 +345,20 @@ Value *SimplifyDxilCall(llvm::Function *F, ArrayRef<Value *> Args,
                                           ConstantArgs);
   }
 
-  switch (opcode) {
-  default:
-    return nullptr;
-  case DXIL::OpCode::FMad: {
-    Value *op0 = Args[DXIL::OperandIndex::kTrinarySrc0OpIdx];
-    Value *op2 = Args[DXIL::OperandIndex::kTrinarySrc2OpIdx];
-    Constant *zero = ConstantFP::get(op0->getType(), 0);
-    if (op0 == zero)
-      return op2;
-    Value *op1 = Args[DXIL::OperandIndex::kTrinarySrc1OpIdx];
-    if (op1 == zero)
-      return op2;
-
-    Constant *one = ConstantFP::get(op0->getType(), 1);
-    if (op0 == one) {
-      IRBuilder<> Builder(I);
-      llvm::FastMathFlags FMF;
-      FMF.setUnsafeAlgebraHLSL();
-      Builder.SetFastMathFlags(FMF);
-      return Builder.CreateFAdd(op1, op2);
-    }
-    if (op1 == one) {
-      IRBuilder<> Builder(I);
-      llvm::FastMathFlags FMF;
-      FMF.setUnsafeAlgebraHLSL();
-      Builder.SetFastMathFlags(FMF);
-
-      return Builder.CreateFAdd(op0, op2);
-    }
-    return nullptr;
-  } break;
-  case DXIL::OpCode::IMad:
-  case DXIL::OpCode::UMad: {
-    Value *op0 = Args[DXIL::OperandIndex::kTrinarySrc0OpIdx];
-    Value *op2 = Args[DXIL::OperandIndex::kTrinarySrc2OpIdx];
-    Constant *zero = ConstantInt::get(op0->getType(), 0);
-    if (op0 == zero)
-      return op2;
-    Value *op1 = Args[DXIL::OperandIndex::kTrinarySrc1OpIdx];
-    if (op1 == zero)
-      return op2;
-
-    Constant *one = ConstantInt::get(op0->getType(), 1);
-    if (op0 == one) {
-      IRBuilder<> Builder(I);
-      return Builder.CreateAdd(op1, op2);
-    }
-    if (op1 == one) {
-      IRBuilder<> Builder(I);
-      return Builder.CreateAdd(op0, op2);
-    }
+  const OpRule rule = GetOpRule(opcode);
+  switch (rule.Kind) {
+  case RuleKind::None:
     return nullptr;
-  } break;
+  case RuleKind::UnaryIdempotent:
+    return SimplifyUnaryIdempotent(opcode, Args);
+  case RuleKind::MinMax:
+    return SimplifyMinMax(rule, Args);
+  case RuleKind::Mad:
+    return SimplifyMad(opcode, Args, I);
+  case RuleKind::Dot:
+    return SimplifyDot(F, rule.DotSize, Args, I);
   }
+  return nullptr;
 }
 
 } // namespace hlsl
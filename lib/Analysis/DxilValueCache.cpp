@@ -287,25 +287,76 @@ Value *DxilValueCache::SimplifyAndCacheResult(Instruction *I, DominatorTree *DT)
 
 STATISTIC(StaleValuesEncountered, "Stale Values Encountered");
 
+// How many stale hits or insertions we tolerate before sweeping dead
+// entries out of the shards in bulk.
+static const unsigned kStaleReadSweepThreshold = 64;
+static const unsigned kInsertSweepThreshold = 4096;
+
+const Function *DxilValueCache::WeakValueMap::ShardFor(const Value *V) {
+  if (const Instruction *I = dyn_cast<Instruction>(V)) {
+    if (const BasicBlock *BB = I->getParent())
+      return BB->getParent();
+    return nullptr;
+  }
+  if (const BasicBlock *BB = dyn_cast<BasicBlock>(V))
+    return BB->getParent();
+  return nullptr;
+}
+
+DxilValueCache::WeakValueMap::ShardMap &
+DxilValueCache::WeakValueMap::GetShard(const Value *V) {
+  return Shards[ShardFor(V)];
+}
+
+// Dead entries are only detected lazily, so count how often we trip over
+// them (and how much we've inserted since the last sweep) and compact once
+// enough have accumulated. This keeps bulk instruction deletion O(1) per
+// value - just the value handles nulling out - instead of a map erase per
+// deleted key.
+void DxilValueCache::WeakValueMap::NoteStaleRead() {
+  ++StaleValuesEncountered;
+  if (++StaleReads >= kStaleReadSweepThreshold)
+    SweepStaleEntries();
+}
+
+void DxilValueCache::WeakValueMap::SweepStaleEntries() {
+  for (auto &ShardPair : Shards) {
+    ShardMap &Shard = ShardPair.second;
+    for (auto It = Shard.begin(), E = Shard.end(); It != E;) {
+      auto CurIt = It++;
+      if (CurIt->second.IsStale())
+        Shard.erase(CurIt);
+    }
+  }
+  StaleReads = 0;
+  InsertsSinceSweep = 0;
+}
+
 bool DxilValueCache::WeakValueMap::Seen(Value *V) {
-  auto FindIt = Map.find(V);
-  if (FindIt == Map.end())
+  ShardMap &Shard = GetShard(V);
+  auto FindIt = Shard.find(V);
+  if (FindIt == Shard.end())
     return false;
 
   auto &Entry = FindIt->second;
-  if (Entry.IsStale())
+  if (Entry.IsStale()) {
+    NoteStaleRead();
     return false;
+  }
   return Entry.Value;
 }
 
 Value *DxilValueCache::WeakValueMap::Get(Value *V) {
-  auto FindIt = Map.find(V);
-  if (FindIt == Map.end())
+  ShardMap &Shard = GetShard(V);
+  auto FindIt = Shard.find(V);
+  if (FindIt == Shard.end())
     return nullptr;
 
   auto &Entry = FindIt->second;
-  if (Entry.IsStale())
+  if (Entry.IsStale()) {
+    NoteStaleRead();
     return nullptr;
+  }
 
   Value *Result = Entry.Value;
   if (Result == GetSentinel(V->getContext()))
@@ -315,7 +366,9 @@ Value *DxilValueCache::WeakValueMap::Get(Value *V) {
 }
 
 void DxilValueCache::WeakValueMap::SetSentinel(Value *Key) {
-  Map[Key].Set(Key, GetSentinel(Key->getContext()));
+  if (++InsertsSinceSweep >= kInsertSweepThreshold)
+    SweepStaleEntries();
+  GetShard(Key)[Key].Set(Key, GetSentinel(Key->getContext()));
 }
 
 Value *DxilValueCache::WeakValueMap::GetSentinel(LLVMContext &Ctx) {
@@ -328,15 +381,25 @@ Value *DxilValueCache::WeakValueMap::GetSentinel(LLVMContext &Ctx) {
 void DxilValueCache::WeakValueMap::ResetUnknowns() {
   if (!Sentinel)
     return;
-  for (auto it = Map.begin(); it != Map.end(); it++) {
-    if (it->second.Value == Sentinel.get())
-      it->second.Value = nullptr;
+  // Take the chance to compact dead entries as well.
+  for (auto &ShardPair : Shards) {
+    ShardMap &Shard = ShardPair.second;
+    for (auto It = Shard.begin(), E = Shard.end(); It != E;) {
+      auto CurIt = It++;
+      if (CurIt->second.IsStale())
+        Shard.erase(CurIt);
+      else if (CurIt->second.Value == Sentinel.get())
+        CurIt->second.Value = nullptr;
+    }
   }
+  StaleReads = 0;
+  InsertsSinceSweep = 0;
 }
 
 LLVM_DUMP_METHOD
 void DxilValueCache::WeakValueMap::dump() const {
-  for (auto It = Map.begin(), E = Map.end(); It != E; It++) {
+  for (const auto &ShardPair : Shards) {
+  for (auto It = ShardPair.second.begin(), E = ShardPair.second.end(); It != E; It++) {
     const Value *Key = It->first;
     if (It->second.IsStale())
       continue;
@@ -362,10 +425,13 @@ void DxilValueCache::WeakValueMap::dump() const {
     }
     dbgs() << "\n";
   }
+  }
 }
 
 void DxilValueCache::WeakValueMap::Set(Value *Key, Value *V) {
-  Map[Key].Set(Key, V);
+  if (++InsertsSinceSweep >= kInsertSweepThreshold)
+    SweepStaleEntries();
+  GetShard(Key)[Key].Set(Key, V);
 }
 
 // If there's a cached value, return it. Otherwise, return
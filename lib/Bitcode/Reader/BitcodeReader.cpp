@@ -4888,6 +4888,13 @@ void BitcodeReader::dematerialize(GlobalValue *GV) {
   F->setIsMaterializable(true);
 }
 
+// HLSL Change - note on parallelism: function bodies must be decoded
+// serially. Every instruction and constant built here goes through the
+// LLVMContext uniquing tables, which have no locking in this tree, so
+// splitting the body blocks across threads would race in the context.
+// Callers that only need part of a large module should use the lazy
+// path (getLazyBitcodeModule) and materialize just the functions they
+// touch, as the reflection, validation and linker paths do.
 std::error_code BitcodeReader::materializeModule(Module *M) {
   assert(M == TheModule &&
          "Can only Materialize the Module this BitcodeReader is attached to.");
@@ -58,8 +58,25 @@ enum {
   FUNCTION_INST_RET_VAL_ABBREV,
   FUNCTION_INST_UNREACHABLE_ABBREV,
   FUNCTION_INST_GEP_ABBREV,
+  FUNCTION_INST_CALL_ABBREV,       // HLSL Change - DXIL abbreviations
+  FUNCTION_INST_EXTRACTVAL_ABBREV, // HLSL Change - DXIL abbreviations
 };
 
+// HLSL Change Begin - DXIL-tuned abbreviations.
+// DXIL functions are dominated by calls to dx.op.* intrinsics and by
+// extractvalue chains on their returned resource structs, and the DXIL
+// metadata helpers emit a large number of plain metadata tuples. None of
+// these records have abbreviations in the stock LLVM 3.7 tables, so they all
+// fall back to the expensive unabbreviated encoding. When writing a DXIL
+// module we register extra abbreviations for them. Abbreviations are
+// self-describing in the bitstream, so no reader changes are required. DXIL
+// is detected through the dx.version named metadata to avoid a layering
+// dependency on the HLSL libraries.
+static bool HasDxilMetadata(const Module *M) {
+  return M->getNamedMetadata("dx.version") != nullptr;
+}
+// HLSL Change End
+
 static unsigned GetEncodedCastOpcode(unsigned Opcode) {
   switch (Opcode) {
   default: llvm_unreachable("Unknown cast instruction!");
@@ -788,7 +805,9 @@ static void WriteMDTuple(const MDTuple *N, const ValueEnumerator &VE,
   }
   Stream.EmitRecord(N->isDistinct() ? bitc::METADATA_DISTINCT_NODE
                                     : bitc::METADATA_NODE,
-                    Record, Abbrev);
+                    // HLSL Change - the abbreviation encodes METADATA_NODE as
+                    // a literal, so distinct nodes cannot use it.
+                    Record, N->isDistinct() ? 0 : Abbrev);
   Record.clear();
 }
 
@@ -1224,6 +1243,19 @@ static void WriteModuleMetadata(const Module *M,
     NameAbbrev = Stream.EmitAbbrev(Abbv.get());
   }
 
+  // HLSL Change Begin - DXIL-tuned abbreviations.
+  if (HasDxilMetadata(M)) {
+    // Abbrev for METADATA_NODE. DXIL modules are tuple-dense (resources,
+    // signatures, type annotations, entry points), and the operands are
+    // small metadata ids.
+    IntrusiveRefCntPtr<BitCodeAbbrev> Abbv = new BitCodeAbbrev();
+    Abbv->Add(BitCodeAbbrevOp(bitc::METADATA_NODE));
+    Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Array));
+    Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6));
+    MDTupleAbbrev = Stream.EmitAbbrev(Abbv.get());
+  }
+  // HLSL Change End
+
   SmallVector<uint64_t, 64> Record;
   for (const Metadata *MD : MDs) {
     if (const MDNode *N = dyn_cast<MDNode>(MD)) {
@@ -1684,7 +1716,8 @@ static void pushValueSigned(const Value *V, unsigned InstID,
 /// WriteInstruction - Emit an instruction to the specified stream.
 static void WriteInstruction(const Instruction &I, unsigned InstID,
                              ValueEnumerator &VE, BitstreamWriter &Stream,
-                             SmallVectorImpl<unsigned> &Vals) {
+                             SmallVectorImpl<unsigned> &Vals,
+                             bool IsDxilModule) { // HLSL Change - DXIL abbrevs
   unsigned Code = 0;
   unsigned AbbrevToUse = 0;
   VE.setInstructionID(&I);
@@ -1724,6 +1757,8 @@ static void WriteInstruction(const Instruction &I, unsigned InstID,
   }
   case Instruction::ExtractValue: {
     Code = bitc::FUNC_CODE_INST_EXTRACTVAL;
+    if (IsDxilModule) // HLSL Change - DXIL abbreviations
+      AbbrevToUse = FUNCTION_INST_EXTRACTVAL_ABBREV;
     PushValueAndType(I.getOperand(0), InstID, Vals, VE);
     const ExtractValueInst *EVI = cast<ExtractValueInst>(&I);
     Vals.append(EVI->idx_begin(), EVI->idx_end());
@@ -1974,8 +2009,16 @@ static void WriteInstruction(const Instruction &I, unsigned InstID,
     Code = bitc::FUNC_CODE_INST_CALL;
 
     Vals.push_back(VE.getAttributeID(CI.getAttributes()));
-    Vals.push_back((CI.getCallingConv() << 1) | unsigned(CI.isTailCall()) |
-                   unsigned(CI.isMustTailCall()) << 14 | 1 << 15);
+    // HLSL Change Begin - name the flags word so the abbrev can be guarded.
+    const unsigned CCInfo =
+        (CI.getCallingConv() << 1) | unsigned(CI.isTailCall()) |
+        unsigned(CI.isMustTailCall()) << 14 | 1 << 15;
+    Vals.push_back(CCInfo);
+    // The abbreviation encodes the flags word in 16 fixed bits; every DXIL
+    // call fits (calling conv is always C), but stay correct for arbitrary IR.
+    if (IsDxilModule && !FTy->isVarArg() && CCInfo < (1u << 16))
+      AbbrevToUse = FUNCTION_INST_CALL_ABBREV;
+    // HLSL Change End
     Vals.push_back(VE.getTypeID(FTy));
     PushValueAndType(CI.getCalledValue(), InstID, Vals, VE);  // Callee
 
@@ -2120,7 +2163,8 @@ static void WriteUseListBlock(const Function *F, ValueEnumerator &VE,
 
 /// WriteFunction - Emit a function body to the module stream.
 static void WriteFunction(const Function &F, ValueEnumerator &VE,
-                          BitstreamWriter &Stream) {
+                          BitstreamWriter &Stream,
+                          bool IsDxilModule) { // HLSL Change - DXIL abbrevs
   Stream.EnterSubblock(bitc::FUNCTION_BLOCK_ID, 4);
   VE.incorporateFunction(F);
 
@@ -2151,7 +2195,8 @@ static void WriteFunction(const Function &F, ValueEnumerator &VE,
   for (Function::const_iterator BB = F.begin(), E = F.end(); BB != E; ++BB)
     for (BasicBlock::const_iterator I = BB->begin(), E = BB->end();
          I != E; ++I) {
-      WriteInstruction(*I, InstID, VE, Stream, Vals);
+      WriteInstruction(*I, InstID, VE, Stream, Vals,
+                       IsDxilModule); // HLSL Change - DXIL abbrevs
 
       if (!I->getType()->isVoidTy())
         ++InstID;
@@ -2192,7 +2237,8 @@ static void WriteFunction(const Function &F, ValueEnumerator &VE,
 }
 
 // Emit blockinfo, which defines the standard abbreviations etc.
-static void WriteBlockInfo(const ValueEnumerator &VE, BitstreamWriter &Stream) {
+static void WriteBlockInfo(const ValueEnumerator &VE, BitstreamWriter &Stream,
+                           bool IsDxilModule) { // HLSL Change - DXIL abbrevs
   // We only want to emit block info records for blocks that have multiple
   // instances: CONSTANTS_BLOCK, FUNCTION_BLOCK and VALUE_SYMTAB_BLOCK.
   // Other blocks can define their abbrevs inline.
@@ -2363,6 +2409,37 @@ static void WriteBlockInfo(const ValueEnumerator &VE, BitstreamWriter &Stream) {
       llvm_unreachable("Unexpected abbrev ordering!");
   }
 
+  // HLSL Change Begin - DXIL-tuned abbreviations.
+  if (IsDxilModule) {
+    { // INST_CALL abbrev for FUNCTION_BLOCK.
+      // Shaped for the dx.op.* intrinsic calls that dominate DXIL: a small
+      // attribute-set id, the calling-conv/flags word, a function type id,
+      // then the callee and argument value ids.
+      IntrusiveRefCntPtr<BitCodeAbbrev> Abbv = new BitCodeAbbrev();
+      Abbv->Add(BitCodeAbbrevOp(bitc::FUNC_CODE_INST_CALL));
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6));   // paramattrs
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 16)); // cc + flags
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed,       // fnty
+                                VE.computeBitsRequiredForTypeIndicies()));
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Array));     // callee + args
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6));
+      if (Stream.EmitBlockInfoAbbrev(bitc::FUNCTION_BLOCK_ID, Abbv.get()) !=
+          FUNCTION_INST_CALL_ABBREV)
+        llvm_unreachable("Unexpected abbrev ordering!");
+    }
+    { // INST_EXTRACTVAL abbrev for FUNCTION_BLOCK.
+      // The aggregate operand id plus small member indices.
+      IntrusiveRefCntPtr<BitCodeAbbrev> Abbv = new BitCodeAbbrev();
+      Abbv->Add(BitCodeAbbrevOp(bitc::FUNC_CODE_INST_EXTRACTVAL));
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Array));
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6));
+      if (Stream.EmitBlockInfoAbbrev(bitc::FUNCTION_BLOCK_ID, Abbv.get()) !=
+          FUNCTION_INST_EXTRACTVAL_ABBREV)
+        llvm_unreachable("Unexpected abbrev ordering!");
+    }
+  }
+  // HLSL Change End
+
   Stream.ExitBlock();
 }
 
@@ -2379,8 +2456,10 @@ static void WriteModule(const Module *M, BitstreamWriter &Stream,
   // Analyze the module, enumerating globals, functions, etc.
   ValueEnumerator VE(*M, ShouldPreserveUseListOrder);
 
+  const bool IsDxilModule = HasDxilMetadata(M); // HLSL Change - DXIL abbrevs
+
   // Emit blockinfo, which defines the standard abbreviations etc.
-  WriteBlockInfo(VE, Stream);
+  WriteBlockInfo(VE, Stream, IsDxilModule); // HLSL Change - DXIL abbrevs
 
   // Emit information about attribute groups.
   WriteAttributeGroupTable(VE, Stream);
@@ -2416,7 +2495,7 @@ static void WriteModule(const Module *M, BitstreamWriter &Stream,
   // Emit function bodies.
   for (Module::const_iterator F = M->begin(), E = M->end(); F != E; ++F)
     if (!F->isDeclaration())
-      WriteFunction(*F, VE, Stream);
+      WriteFunction(*F, VE, Stream, IsDxilModule); // HLSL Change - DXIL abbrevs
 
   Stream.ExitBlock();
 }
@@ -67,6 +67,7 @@ const char DxilMDHelper::kDxilSourceContentsMDName[]                  = "dx.sour
 const char DxilMDHelper::kDxilSourceDefinesMDName[]                   = "dx.source.defines";
 const char DxilMDHelper::kDxilSourceMainFileNameMDName[]              = "dx.source.mainFileName";
 const char DxilMDHelper::kDxilSourceArgsMDName[]                      = "dx.source.args";
+const char DxilMDHelper::kDxilSourceContentHashPrefix[]               = "dxc-source-hash:md5:";
 
 // This is reflection-only metadata
 const char DxilMDHelper::kDxilCountersMDName[]                        = "dx.counters";
@@ -409,7 +410,7 @@ MDTuple *DxilMDHelper::EmitSignatureMetadata(const DxilSignature &Sig) {
   if (Elements.empty())
     return nullptr;
 
-  vector<Metadata *> MDVals;
+  SmallVector<Metadata *, 16> MDVals;
   for (size_t i = 0; i < Elements.size(); i++) {
     MDVals.emplace_back(EmitSignatureElement(*Elements[i]));
   }
@@ -482,7 +483,7 @@ MDTuple *DxilMDHelper::EmitSignatureElement(const DxilSignatureElement &SE) {
 
   // Name-value list of extended properties.
   MDVals[kDxilSignatureElementNameValueList] = nullptr;
-  vector<Metadata *> MDExtraVals;
+  SmallVector<Metadata *, 16> MDExtraVals;
   m_ExtraPropertyHelper->EmitSignatureElementProperties(SE, MDExtraVals);
   if (!MDExtraVals.empty()) {
     MDVals[kDxilSignatureElementNameValueList] = MDNode::get(m_Ctx, MDExtraVals);
@@ -621,7 +622,7 @@ MDTuple *DxilMDHelper::EmitDxilSRV(const DxilResource &SRV) {
 
   // Name-value list of extended properties.
   MDVals[kDxilSRVNameValueList] = nullptr;
-  vector<Metadata *> MDExtraVals;
+  SmallVector<Metadata *, 16> MDExtraVals;
   m_ExtraPropertyHelper->EmitSRVProperties(SRV, MDExtraVals);
   if (!MDExtraVals.empty()) {
     MDVals[kDxilSRVNameValueList] = MDNode::get(m_Ctx, MDExtraVals);
@@ -663,7 +664,7 @@ MDTuple *DxilMDHelper::EmitDxilUAV(const DxilResource &UAV) {
 
   // Name-value list of extended properties.
   MDVals[kDxilUAVNameValueList        ] = nullptr;
-  vector<Metadata *> MDExtraVals;
+  SmallVector<Metadata *, 16> MDExtraVals;
   m_ExtraPropertyHelper->EmitUAVProperties(UAV, MDExtraVals);
   if (!MDExtraVals.empty()) {
     MDVals[kDxilUAVNameValueList] = MDNode::get(m_Ctx, MDExtraVals);
@@ -705,7 +706,7 @@ MDTuple *DxilMDHelper::EmitDxilCBuffer(const DxilCBuffer &CB) {
 
   // Name-value list of extended properties.
   MDVals[kDxilCBufferNameValueList] = nullptr;
-  vector<Metadata *> MDExtraVals;
+  SmallVector<Metadata *, 16> MDExtraVals;
   m_ExtraPropertyHelper->EmitCBufferProperties(CB, MDExtraVals);
   if (!MDExtraVals.empty()) {
     MDVals[kDxilCBufferNameValueList] = MDNode::get(m_Ctx, MDExtraVals);
@@ -733,7 +734,7 @@ void DxilMDHelper::LoadDxilCBuffer(const MDOperand &MDO, DxilCBuffer &CB) {
 
 void DxilMDHelper::EmitDxilTypeSystem(DxilTypeSystem &TypeSystem, vector<GlobalVariable*> &LLVMUsed) {
   auto &TypeMap = TypeSystem.GetStructAnnotationMap();
-  vector<Metadata *> MDVals;
+  SmallVector<Metadata *, 16> MDVals;
   MDVals.emplace_back(Uint32ToConstMD(kDxilTypeSystemStructTag)); // Tag
   unsigned GVIdx = 0;
   for (auto it = TypeMap.begin(); it != TypeMap.end(); ++it, GVIdx++) {
@@ -750,7 +751,7 @@ void DxilMDHelper::EmitDxilTypeSystem(DxilTypeSystem &TypeSystem, vector<GlobalV
   }
 
   auto &FuncMap = TypeSystem.GetFunctionAnnotationMap();
-  vector<Metadata *> MDFuncVals;
+  SmallVector<Metadata *, 16> MDFuncVals;
   MDFuncVals.emplace_back(Uint32ToConstMD(kDxilTypeSystemFunctionTag)); // Tag
   for (auto it = FuncMap.begin(); it != FuncMap.end(); ++it) {
     DxilFunctionAnnotation *pA = it->second.get();
@@ -860,7 +861,7 @@ void DxilMDHelper::LoadDxilTemplateArgAnnotation(const llvm::MDOperand &MDO, Dxi
 Metadata *DxilMDHelper::EmitDxilStructAnnotation(const DxilStructAnnotation &SA) {
   bool bSupportExtended = DXIL::CompareVersions(m_MinValMajor, m_MinValMinor, 1, 5) >= 0;
 
-  vector<Metadata *> MDVals;
+  SmallVector<Metadata *, 16> MDVals;
   MDVals.reserve(SA.GetNumFields() + 2);  // In case of extended 1.5 property list
   MDVals.resize(SA.GetNumFields() + 1);
 
@@ -871,7 +872,7 @@ Metadata *DxilMDHelper::EmitDxilStructAnnotation(const DxilStructAnnotation &SA)
 
   // Only add template args if shader target requires validator version that supports them.
   if (bSupportExtended && SA.GetNumTemplateArgs()) {
-    vector<Metadata *> MDTemplateArgs(SA.GetNumTemplateArgs());
+    SmallVector<Metadata *, 8> MDTemplateArgs(SA.GetNumTemplateArgs());
     for (unsigned i = 0; i < SA.GetNumTemplateArgs(); ++i) {
       MDTemplateArgs[i] = EmitDxilTemplateArgAnnotation(SA.GetTemplateArgAnnotation(i));
     }
@@ -943,7 +944,7 @@ void DxilMDHelper::LoadDxilFunctionAnnotation(const MDOperand &MDO,
 
 llvm::Metadata *
 DxilMDHelper::EmitDxilParamAnnotations(const DxilFunctionAnnotation &FA) {
-  vector<Metadata *> MDParamAnnotations(FA.GetNumParameters() + 1);
+  SmallVector<Metadata *, 8> MDParamAnnotations(FA.GetNumParameters() + 1);
   MDParamAnnotations[0] = EmitDxilParamAnnotation(FA.GetRetTypeAnnotation());
   for (unsigned i = 0; i < FA.GetNumParameters(); i++) {
     MDParamAnnotations[i + 1] =
@@ -969,7 +970,7 @@ void DxilMDHelper::LoadDxilParamAnnotations(const llvm::MDOperand &MDO,
 
 Metadata *
 DxilMDHelper::EmitDxilParamAnnotation(const DxilParameterAnnotation &PA) {
-  vector<Metadata *> MDVals(3);
+  SmallVector<Metadata *, 4> MDVals(3);
   MDVals[0] = Uint32ToConstMD(static_cast<unsigned>(PA.GetParamInputQual()));
   MDVals[1] = EmitDxilFieldAnnotation(PA);
   MDVals[2] = Uint32VectorToConstMDTuple(PA.GetSemanticIndexVec());
@@ -992,7 +993,7 @@ void DxilMDHelper::LoadDxilParamAnnotation(const MDOperand &MDO,
 }
 
 Metadata *DxilMDHelper::EmitDxilFieldAnnotation(const DxilFieldAnnotation &FA) {
-  vector<Metadata *> MDVals;  // Tag-Value list.
+  SmallVector<Metadata *, 16> MDVals;  // Tag-Value list.
 
   if (FA.HasFieldName()) {
     MDVals.emplace_back(Uint32ToConstMD(kDxilFieldAnnotationFieldNameTag));
@@ -1194,7 +1195,7 @@ const Function *DxilMDHelper::LoadDxilFunctionProps(const MDTuple *pProps,
 MDTuple *DxilMDHelper::EmitDxilEntryProperties(uint64_t rawShaderFlag,
                                                 const DxilFunctionProps &props,
                                                 unsigned autoBindingSpace) {
-  vector<Metadata *> MDVals;
+  SmallVector<Metadata *, 16> MDVals;
 
   // DXIL shader flags.
   if (props.IsPS()) {
@@ -1222,7 +1223,7 @@ MDTuple *DxilMDHelper::EmitDxilEntryProperties(uint64_t rawShaderFlag,
   case DXIL::ShaderKind::Compute: {
     auto &CS = props.ShaderProps.CS;
     MDVals.emplace_back(Uint32ToConstMD(DxilMDHelper::kDxilNumThreadsTag));
-    vector<Metadata *> NumThreadVals;
+    SmallVector<Metadata *, 3> NumThreadVals;
     NumThreadVals.emplace_back(Uint32ToConstMD(CS.numThreads[0]));
     NumThreadVals.emplace_back(Uint32ToConstMD(CS.numThreads[1]));
     NumThreadVals.emplace_back(Uint32ToConstMD(CS.numThreads[2]));
@@ -1799,7 +1800,7 @@ MDTuple *DxilMDHelper::EmitDxilSampler(const DxilSampler &S) {
 
   // Name-value list of extended properties.
   MDVals[kDxilSamplerNameValueList] = nullptr;
-  vector<Metadata *> MDExtraVals;
+  SmallVector<Metadata *, 16> MDExtraVals;
   m_ExtraPropertyHelper->EmitSamplerProperties(S, MDExtraVals);
   if (!MDExtraVals.empty()) {
     MDVals[kDxilSamplerNameValueList] = MDNode::get(m_Ctx, MDExtraVals);
@@ -2002,7 +2003,7 @@ MDTuple *DxilMDHelper::EmitDxilMSState(const unsigned *NumThreads,
                                        DXIL::MeshOutputTopology OutputTopology,
                                        unsigned payloadSizeInBytes) {
   Metadata *MDVals[kDxilMSStateNumFields];
-  vector<Metadata *> NumThreadVals;
+  SmallVector<Metadata *, 3> NumThreadVals;
 
   NumThreadVals.emplace_back(Uint32ToConstMD(NumThreads[0]));
   NumThreadVals.emplace_back(Uint32ToConstMD(NumThreads[1]));
@@ -2039,7 +2040,7 @@ void DxilMDHelper::LoadDxilMSState(const MDOperand &MDO,
 
 MDTuple *DxilMDHelper::EmitDxilASState(const unsigned *NumThreads, unsigned payloadSizeInBytes) {
   Metadata *MDVals[kDxilASStateNumFields];
-  vector<Metadata *> NumThreadVals;
+  SmallVector<Metadata *, 3> NumThreadVals;
 
   NumThreadVals.emplace_back(Uint32ToConstMD(NumThreads[0]));
   NumThreadVals.emplace_back(Uint32ToConstMD(NumThreads[1]));
@@ -2063,7 +2064,7 @@ void DxilMDHelper::LoadDxilASState(const MDOperand &MDO, unsigned *NumThreads, u
   payloadSizeInBytes = ConstMDToUint32(pTupleMD->getOperand(kDxilASStatePayloadSizeInBytes));
 }
 
-void DxilMDHelper::AddCounterIfNonZero(uint32_t value, StringRef name, vector<Metadata*> &MDVals) {
+void DxilMDHelper::AddCounterIfNonZero(uint32_t value, StringRef name, SmallVectorImpl<Metadata *> &MDVals) {
   if (value) {
     MDVals.emplace_back(MDString::get(m_Ctx, name));
     MDVals.emplace_back(Uint32ToConstMD(value));
@@ -2075,7 +2076,7 @@ void DxilMDHelper::EmitDxilCounters(const DxilCounters &counters) {
   if (pDxilCountersMD)
     m_pModule->eraseNamedMetadata(pDxilCountersMD);
 
-  vector<Metadata*> MDVals;
+  SmallVector<Metadata *, 32> MDVals;
   // <py::lines('OPCODE-COUNTERS')>['AddCounterIfNonZero(counters.%s, "%s", MDVals);' % (c,c) for c in hctdb_instrhelp.get_counters()]</py>
   // OPCODE-COUNTERS:BEGIN
   AddCounterIfNonZero(counters.array_local_bytes, "array_local_bytes", MDVals);
@@ -2142,7 +2143,7 @@ DxilExtraPropertyHelper::DxilExtraPropertyHelper(Module *pModule)
 : ExtraPropertyHelper(pModule) {
 }
 
-void DxilExtraPropertyHelper::EmitSRVProperties(const DxilResource &SRV, std::vector<Metadata *> &MDVals) {
+void DxilExtraPropertyHelper::EmitSRVProperties(const DxilResource &SRV, SmallVectorImpl<Metadata *> &MDVals) {
   // Element type for typed resource.
   if (!SRV.IsStructuredBuffer() && !SRV.IsRawBuffer()) {
     MDVals.emplace_back(DxilMDHelper::Uint32ToConstMD(DxilMDHelper::kDxilTypedBufferElementTypeTag, m_Ctx));
@@ -2188,7 +2189,7 @@ void DxilExtraPropertyHelper::LoadSRVProperties(const MDOperand &MDO, DxilResour
   }
 }
 
-void DxilExtraPropertyHelper::EmitUAVProperties(const DxilResource &UAV, std::vector<Metadata *> &MDVals) {
+void DxilExtraPropertyHelper::EmitUAVProperties(const DxilResource &UAV, SmallVectorImpl<Metadata *> &MDVals) {
   // Element type for typed RW resource.
   if (!UAV.IsStructuredBuffer() && !UAV.IsRawBuffer() && !UAV.GetCompType().IsInvalid()) {
     MDVals.emplace_back(DxilMDHelper::Uint32ToConstMD(DxilMDHelper::kDxilTypedBufferElementTypeTag, m_Ctx));
@@ -2243,7 +2244,7 @@ void DxilExtraPropertyHelper::LoadUAVProperties(const MDOperand &MDO, DxilResour
   }
 }
 
-void DxilExtraPropertyHelper::EmitCBufferProperties(const DxilCBuffer &CB, vector<Metadata *> &MDVals) {
+void DxilExtraPropertyHelper::EmitCBufferProperties(const DxilCBuffer &CB, SmallVectorImpl<Metadata *> &MDVals) {
   // Emit property to preserve tbuffer kind
   if (CB.GetKind() == DXIL::ResourceKind::TBuffer) {
     MDVals.emplace_back(DxilMDHelper::Uint32ToConstMD(DxilMDHelper::kHLCBufferIsTBufferTag, m_Ctx));
@@ -2279,7 +2280,7 @@ void DxilExtraPropertyHelper::LoadCBufferProperties(const MDOperand &MDO, DxilCB
   }
 }
 
-void DxilExtraPropertyHelper::EmitSamplerProperties(const DxilSampler &S, std::vector<Metadata *> &MDVals) {
+void DxilExtraPropertyHelper::EmitSamplerProperties(const DxilSampler &S, SmallVectorImpl<Metadata *> &MDVals) {
   // Nothing yet.
 }
 
@@ -2288,7 +2289,7 @@ void DxilExtraPropertyHelper::LoadSamplerProperties(const MDOperand &MDO, DxilSa
 }
 
 void DxilExtraPropertyHelper::EmitSignatureElementProperties(const DxilSignatureElement &SE, 
-                                                             vector<Metadata *> &MDVals) {
+                                                             SmallVectorImpl<Metadata *> &MDVals) {
   // Output stream, if non-zero.
   if (SE.GetOutputStream() != 0) {
     MDVals.emplace_back(DxilMDHelper::Uint32ToConstMD(DxilMDHelper::kDxilSignatureElementOutputStreamTag, m_Ctx));
@@ -2468,7 +2469,7 @@ Value *DxilMDHelper::ValueMDToValue(const MDOperand &MDO) {
 }
 
 MDTuple *DxilMDHelper::Uint32VectorToConstMDTuple(const std::vector<unsigned> &Vec) {
-  vector<Metadata *> MDVals;
+  SmallVector<Metadata *, 16> MDVals;
 
   MDVals.resize(Vec.size());
   for (size_t i = 0; i < Vec.size(); i++) {
@@ -2545,7 +2546,7 @@ void DxilMDHelper::SetVariableDebugLayout(llvm::DbgDeclareInst *inst,
     unsigned StartOffsetInBits, const std::vector<DxilDIArrayDim> &ArrayDims) {
   LLVMContext &Ctx = inst->getContext();
 
-  std::vector<Metadata*> MDVals;
+  SmallVector<Metadata *, 8> MDVals;
   MDVals.reserve(ArrayDims.size() + 1);
   MDVals.emplace_back(Uint32ToConstMD(StartOffsetInBits, Ctx));
   for (const DxilDIArrayDim &ArrayDim : ArrayDims) {
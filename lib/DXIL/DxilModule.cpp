@@ -96,7 +96,8 @@ void DxilModule_ResetModule(llvm::Module* M) {
 //  DxilModule methods.
 //
 DxilModule::DxilModule(Module *pModule)
-: m_StreamPrimitiveTopology(DXIL::PrimitiveTopology::Undefined)
+: m_bResourceIndexesValid(false)
+, m_StreamPrimitiveTopology(DXIL::PrimitiveTopology::Undefined)
 , m_ActiveStreamMask(0)
 , m_Ctx(pModule->getContext())
 , m_pModule(pModule)
@@ -118,6 +119,7 @@ DxilModule::DxilModule(Module *pModule)
 , m_AutoBindingSpace(UINT_MAX)
 , m_pSubobjects(nullptr)
 , m_bMetadataErrors(false)
+, m_bTypeSystemPending(false)
 {
 
   DXASSERT_NOMSG(m_pModule != nullptr);
@@ -295,8 +297,14 @@ unsigned DxilModule::GetGlobalFlags() const {
 }
 
 void DxilModule::CollectShaderFlagsForModule(ShaderFlags &Flags) {
+  // Record the per-function flags as they are derived so later consumers
+  // (container assembly in particular) can look them up instead of walking
+  // each function body again. Cleared first so repeated collections stay
+  // consistent with the walk that produced them.
+  m_FunctionShaderFlags.clear();
   for (Function &F : GetModule()->functions()) {
     ShaderFlags funcFlags = ShaderFlags::CollectShaderFlags(&F, this);
+    m_FunctionShaderFlags.emplace(&F, funcFlags);
     Flags.CombineShaderFlags(funcFlags);
   };
 
@@ -344,6 +352,12 @@ void DxilModule::CollectShaderFlagsForModule(ShaderFlags &Flags) {
   Flags.SetCSRawAndStructuredViaShader4X(hasCSRawAndStructuredViaShader4X);
 }
 
+const ShaderFlags *
+DxilModule::GetCachedFunctionShaderFlags(const llvm::Function *F) const {
+  auto it = m_FunctionShaderFlags.find(F);
+  return it != m_FunctionShaderFlags.end() ? &it->second : nullptr;
+}
+
 void DxilModule::CollectShaderFlagsForModule() {
   CollectShaderFlagsForModule(m_ShaderFlags);
 
@@ -807,11 +821,12 @@ void DxilModule::SetShaderProperties(DxilFunctionProps *props) {
   }
 }
 
-template<typename T> unsigned 
+template<typename T> unsigned
 DxilModule::AddResource(vector<unique_ptr<T> > &Vec, unique_ptr<T> pRes) {
   DXASSERT_NOMSG((unsigned)Vec.size() < UINT_MAX);
   unsigned Id = (unsigned)Vec.size();
   Vec.emplace_back(std::move(pRes));
+  InvalidateResourceIndexes();
   return Id;
 }
 
@@ -879,6 +894,91 @@ const vector<unique_ptr<DxilResource> > &DxilModule::GetUAVs() const {
   return m_UAVs;
 }
 
+static uint64_t ResourceBindingKey(unsigned SpaceID, unsigned LowerBound) {
+  return ((uint64_t)SpaceID << 32) | LowerBound;
+}
+
+template <typename TResource>
+static void IndexResources(
+    const std::vector<std::unique_ptr<TResource>> &Vec,
+    std::unordered_map<const Constant *, DxilResourceBase *> &SymbolIndex,
+    std::unordered_map<uint64_t, DxilResourceBase *> &BindingIndex) {
+  for (auto &Res : Vec) {
+    // Stripped resources share one undef symbol per type; leave those out so
+    // a symbol maps to at most one resource.
+    Constant *pSymbol = Res->GetGlobalSymbol();
+    if (pSymbol != nullptr && !isa<UndefValue>(pSymbol))
+      SymbolIndex[pSymbol] = Res.get();
+    if (Res->IsAllocated())
+      BindingIndex[ResourceBindingKey(Res->GetSpaceID(), Res->GetLowerBound())] =
+          Res.get();
+  }
+}
+
+void DxilModule::BuildResourceIndexes() const {
+  IndexResources(m_SRVs, m_ResourceSymbolIndex,
+                 m_ResourceBindingIndex[(unsigned)DXIL::ResourceClass::SRV]);
+  IndexResources(m_UAVs, m_ResourceSymbolIndex,
+                 m_ResourceBindingIndex[(unsigned)DXIL::ResourceClass::UAV]);
+  IndexResources(m_CBuffers, m_ResourceSymbolIndex,
+                 m_ResourceBindingIndex[(unsigned)DXIL::ResourceClass::CBuffer]);
+  IndexResources(m_Samplers, m_ResourceSymbolIndex,
+                 m_ResourceBindingIndex[(unsigned)DXIL::ResourceClass::Sampler]);
+  m_bResourceIndexesValid = true;
+}
+
+DxilResourceBase *
+DxilModule::LookupResourceBySymbol(const llvm::Constant *pSymbol) const {
+  if (!m_bResourceIndexesValid)
+    BuildResourceIndexes();
+  auto it = m_ResourceSymbolIndex.find(pSymbol);
+  return it != m_ResourceSymbolIndex.end() ? it->second : nullptr;
+}
+
+DxilResourceBase *DxilModule::LookupResourceByBinding(DXIL::ResourceClass RC,
+                                                      unsigned SpaceID,
+                                                      unsigned LowerBound) const {
+  if (RC >= DXIL::ResourceClass::Invalid)
+    return nullptr;
+  if (!m_bResourceIndexesValid)
+    BuildResourceIndexes();
+  auto &BindingIndex = m_ResourceBindingIndex[(unsigned)RC];
+  auto it = BindingIndex.find(ResourceBindingKey(SpaceID, LowerBound));
+  return it != BindingIndex.end() ? it->second : nullptr;
+}
+
+void DxilModule::InvalidateResourceIndexes() const {
+  m_bResourceIndexesValid = false;
+  m_ResourceSymbolIndex.clear();
+  for (auto &BindingIndex : m_ResourceBindingIndex)
+    BindingIndex.clear();
+}
+
+DxilResourceProperties DxilModule::GetCachedResourceProperties(
+    DxilInst_AnnotateHandle &annotateHandle) const {
+  const Constant *Props = cast<Constant>(annotateHandle.get_props());
+  DXIL::ResourceClass RC =
+      (DXIL::ResourceClass)annotateHandle.get_resourceClass_val();
+  DXIL::ResourceKind RK =
+      (DXIL::ResourceKind)annotateHandle.get_resourceKind_val();
+
+  auto it = m_DecodedResourceProps.find(Props);
+  if (it == m_DecodedResourceProps.end())
+    it = m_DecodedResourceProps
+             .emplace(Props, resource_helper::loadFromConstant(*Props, RC, RK))
+             .first;
+
+  DxilResourceProperties RP = it->second;
+  // The uniqued constant pins down the packed dwords, but the same constant -
+  // the all-zero struct in particular - can annotate handles of different
+  // class or kind, so those two fields always come from the instruction.
+  if (RP.Class != DXIL::ResourceClass::Invalid) {
+    RP.Class = RC;
+    RP.Kind = RK;
+  }
+  return RP;
+}
+
 void DxilModule::LoadDxilResourceBaseFromMDNode(MDNode *MD, DxilResourceBase &R) {
   return m_pMDHelper->LoadDxilResourceBaseFromMDNode(MD, R);
 }
@@ -939,6 +1039,7 @@ static void ConvertUsedResource(std::unordered_set<unsigned> &immResID,
 void DxilModule::RemoveFunction(llvm::Function *F) {
   DXASSERT_NOMSG(F != nullptr);
   m_DxilEntryPropsMap.erase(F);
+  MaterializeTypeSystem();
   if (m_pTypeSystem.get()->GetFunctionAnnotation(F))
     m_pTypeSystem.get()->EraseFunctionAnnotation(F);
   m_pOP->RemoveFunction(F);
@@ -953,6 +1054,7 @@ void DxilModule::RemoveUnusedResources() {
     m_UAVs.clear();
     m_SRVs.clear();
     m_Samplers.clear();
+    InvalidateResourceIndexes();
     createHandleFunc->eraseFromParent();
     return;
   }
@@ -1007,6 +1109,7 @@ void DxilModule::RemoveUnusedResources() {
   RemoveResources(m_SRVs, immSRVID);
   RemoveResources(m_Samplers, immSamplerID);
   RemoveResources(m_CBuffers, immCBufID);
+  InvalidateResourceIndexes();
 }
 
 namespace {
@@ -1040,6 +1143,7 @@ void DxilModule::RemoveResourcesWithUnusedSymbols() {
   RemoveResourcesWithUnusedSymbolsHelper(m_UAVs);
   RemoveResourcesWithUnusedSymbolsHelper(m_CBuffers);
   RemoveResourcesWithUnusedSymbolsHelper(m_Samplers);
+  InvalidateResourceIndexes();
 }
 
 DxilSignature &DxilModule::GetInputSignature() {
@@ -1209,7 +1313,31 @@ void DxilModule::ResetSerializedRootSignature(std::vector<uint8_t> &Value) {
   m_SerializedRootSignature.assign(Value.begin(), Value.end());
 }
 
+void DxilModule::MaterializeTypeSystem() {
+  if (!m_bTypeSystemPending)
+    return;
+  m_bTypeSystemPending = false;
+  try {
+    IFTBOOL(m_PendingTypeAnnotations.size() <= 2,
+            DXC_E_INCORRECT_DXIL_METADATA);
+    for (const MDTuple *pTupleMD : m_PendingTypeAnnotations) {
+      IFTBOOL(pTupleMD != nullptr, DXC_E_INCORRECT_DXIL_METADATA);
+      m_pMDHelper->LoadDxilTypeSystemNode(*pTupleMD, *m_pTypeSystem.get());
+    }
+  } catch (hlsl::Exception &) {
+    m_bMetadataErrors = true;
+#ifdef DBG
+    throw;
+#endif
+    m_pTypeSystem->GetStructAnnotationMap().clear();
+    m_pTypeSystem->GetFunctionAnnotationMap().clear();
+  }
+  m_PendingTypeAnnotations.clear();
+  m_bMetadataErrors |= m_pMDHelper->HasExtraMetadata();
+}
+
 DxilTypeSystem &DxilModule::GetTypeSystem() {
+  MaterializeTypeSystem();
   return *m_pTypeSystem;
 }
 
@@ -1221,6 +1349,7 @@ const std::vector<unsigned> &DxilModule::GetSerializedViewIdState() const {
 }
 
 void DxilModule::ResetTypeSystem(DxilTypeSystem *pValue) {
+  m_bTypeSystemPending = false;
   m_pTypeSystem.reset(pValue);
 }
 
@@ -1395,6 +1524,9 @@ bool DxilModule::IsKnownNamedMetaData(llvm::NamedMDNode &Node) {
 }
 
 bool DxilModule::HasMetadataErrors() {
+  // Type annotation errors only surface during the deferred decode, so an
+  // accurate answer requires materializing it first.
+  MaterializeTypeSystem();
   return m_bMetadataErrors;
 }
 
@@ -1490,17 +1622,20 @@ void DxilModule::LoadDxilMetadata() {
 
   LoadDxilResources(*pEntryResources);
 
-  // Type system is not required for consumption of dxil.
-  try {
-    m_pMDHelper->LoadDxilTypeSystem(*m_pTypeSystem.get());
-  } catch (hlsl::Exception &) {
-    m_bMetadataErrors = true;
-#ifdef DBG
-    throw;
-#endif
-    m_pTypeSystem->GetStructAnnotationMap().clear();
-    m_pTypeSystem->GetFunctionAnnotationMap().clear();
-  }
+  // Type system is not required for consumption of dxil, and with
+  // per-function annotations it dwarfs the rest of the metadata for large
+  // libraries. Defer the decode until the first GetTypeSystem touch;
+  // consumers that only read entry properties or resources never pay it.
+  // Snapshot the annotation tuples now so the decode still works if the
+  // named metadata is cleared before then.
+  m_PendingTypeAnnotations.clear();
+  if (const llvm::NamedMDNode *pTypeAnnotations = m_pModule->getNamedMetadata(
+          DxilMDHelper::kDxilTypeSystemMDName)) {
+    for (unsigned i = 0; i < pTypeAnnotations->getNumOperands(); i++)
+      m_PendingTypeAnnotations.emplace_back(
+          dyn_cast<MDTuple>(pTypeAnnotations->getOperand(i)));
+  }
+  m_bTypeSystemPending = true;
 
   m_pMDHelper->LoadRootSignature(m_SerializedRootSignature);
 
@@ -1612,6 +1747,7 @@ static bool ResourceTypeRequiresTranslation(const StructType * Ty, SmallStructSe
 bool DxilModule::StripReflection() {
   bool bChanged = false;
   bool bIsLib = GetShaderModel()->IsLib();
+  MaterializeTypeSystem();
 
   // Remove names.
   for (Function &F : m_pModule->functions()) {
@@ -916,7 +916,11 @@ void OP::RefreshCache() {
 }
 
 void OP::UpdateCache(OpCodeClass opClass, Type * Ty, llvm::Function *F) {
-  m_OpCodeClassCache[(unsigned)opClass].pOverloads[Ty] = F;
+  OpCodeCacheItem &CacheItem = m_OpCodeClassCache[(unsigned)opClass];
+  CacheItem.pOverloads[Ty] = F;
+  unsigned TypeSlot = GetTypeSlot(Ty);
+  if (TypeSlot < kUserDefineTypeSlot)
+    CacheItem.pSlotFuncs[TypeSlot] = F;
   m_FunctionToOpClass[F] = opClass;
 }
 
@@ -925,9 +929,19 @@ Function *OP::GetOpFunc(OpCode opCode, Type *pOverloadType) {
   _Analysis_assume_(0 <= (unsigned)opCode && opCode < OpCode::NumOpCodes);
   DXASSERT(IsOverloadLegal(opCode, pOverloadType), "otherwise the caller requested illegal operation overload (eg HLSL function with unsupported types for mapped intrinsic function)");
   OpCodeClass opClass = m_OpCodeProps[(unsigned)opCode].opCodeClass;
-  Function *&F = m_OpCodeClassCache[(unsigned)opClass].pOverloads[pOverloadType];
+  OpCodeCacheItem &CacheItem = m_OpCodeClassCache[(unsigned)opClass];
+  // Scalar overload slots are singleton types, so a filled slot is a direct
+  // array-indexed hit with no map lookup and no name mangling; this is the
+  // hot path during lowering.
+  unsigned TypeSlot = GetTypeSlot(pOverloadType);
+  if (TypeSlot < kUserDefineTypeSlot) {
+    if (Function *SlotF = CacheItem.pSlotFuncs[TypeSlot])
+      return SlotF;
+  }
+  Function *&F = CacheItem.pOverloads[pOverloadType];
   if (F != nullptr) {
-    UpdateCache(opClass, pOverloadType, F);
+    // Every path that fills an overload slot goes through UpdateCache, so a
+    // hit needs no map maintenance.
     return F;
   }
 
@@ -1354,9 +1368,13 @@ OP::GetOpFuncList(OpCode opCode) const {
 void OP::RemoveFunction(Function *F) {
   if (OP::IsDxilOpFunc(F)) {
     OpCodeClass opClass = m_FunctionToOpClass[F];
-    for (auto it : m_OpCodeClassCache[(unsigned)opClass].pOverloads) {
+    OpCodeCacheItem &CacheItem = m_OpCodeClassCache[(unsigned)opClass];
+    for (auto it : CacheItem.pOverloads) {
       if (it.second == F) {
-        m_OpCodeClassCache[(unsigned)opClass].pOverloads.erase(it.first);
+        CacheItem.pOverloads.erase(it.first);
+        unsigned TypeSlot = GetTypeSlot(it.first);
+        if (TypeSlot < kUserDefineTypeSlot)
+          CacheItem.pSlotFuncs[TypeSlot] = nullptr;
         m_FunctionToOpClass.erase(F);
         break;
       }
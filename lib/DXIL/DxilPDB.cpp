@@ -333,6 +333,17 @@ struct PDBReader {
   MSF_SuperBlock m_SB = {};
   HRESULT m_Status = S_OK;
 
+  // When the stream is memory backed (it also implements IDxcBlob), streams
+  // whose blocks are laid out consecutively can be returned as views over the
+  // original memory instead of copies.
+  CComPtr<IDxcBlob> m_pFileBlob;
+
+  // The block-map parse is cached so reading multiple streams from the same
+  // file only walks the directory once.
+  bool m_bDirectoryParsed = false;
+  llvm::SmallVector<uint32_t, 32> m_DirectoryBlocks;
+  llvm::SmallVector<uint32_t, 6> m_StreamSizes;
+
   HRESULT SetPosition(INT32 sOffset) {
     LARGE_INTEGER Distance = {};
     Distance.QuadPart = m_uOriginalOffset + sOffset;
@@ -342,6 +353,9 @@ struct PDBReader {
 
   PDBReader(IMalloc *pMalloc, IStream *pStream) : m_pStream(pStream), m_pMalloc(pMalloc) {
     m_Status = ReadSuperblock(&m_SB);
+    // Failure just means the stream is not memory backed; every read then
+    // goes through the copying path.
+    pStream->QueryInterface(&m_pFileBlob);
   }
 
   // Reset the stream back to its original position, regardless of
@@ -379,60 +393,98 @@ struct PDBReader {
     return m_pStream->Seek(Offset, STREAM_SEEK_CUR, &BytesMoved);
   }
 
-  HRESULT ReadWholeStream(uint32_t StreamIndex, IDxcBlob **ppData) {
-    if (FAILED(m_Status)) return m_Status;
+  HRESULT ParseDirectory() {
+    if (m_bDirectoryParsed)
+      return S_OK;
 
     UINT32 uNumDirectoryBlocks =
       CalculateNumBlocks(m_SB.BlockSize, m_SB.NumDirectoryBytes);
 
     // Load in the directory blocks
-    llvm::SmallVector<uint32_t, 32> DirectoryBlocks;
+    m_DirectoryBlocks.clear();
     IFR(GoToBeginningOfBlock(m_SB.BlockMapAddr))
     for (unsigned i = 0; i < uNumDirectoryBlocks; i++) {
       UINT32 uBlock = 0;
       IFR(ReadU32(&uBlock));
-      DirectoryBlocks.push_back(uBlock);
+      m_DirectoryBlocks.push_back(uBlock);
     }
 
+    if (m_DirectoryBlocks.size() == 0)
+      return E_FAIL;
+
     // Load Num streams
     UINT32 uNumStreams = 0;
-    IFR(GoToBeginningOfBlock(DirectoryBlocks[0]));
+    IFR(GoToBeginningOfBlock(m_DirectoryBlocks[0]));
     IFR(ReadU32(&uNumStreams));
 
+    IFR(ReadU32ListFromBlocks(m_DirectoryBlocks, 1, uNumStreams,
+      m_StreamSizes));
+
+    m_bDirectoryParsed = true;
+    return S_OK;
+  }
+
+  HRESULT ReadWholeStream(uint32_t StreamIndex, IDxcBlob **ppData) {
+    if (FAILED(m_Status)) return m_Status;
+
+    IFR(ParseDirectory());
+
     // If we don't have enough streams, then give up.
-    if (uNumStreams <= StreamIndex)
+    if (m_StreamSizes.size() <= StreamIndex)
       return E_FAIL;
 
-    llvm::SmallVector<uint32_t, 6> StreamSizes;
-    IFR(ReadU32ListFromBlocks(DirectoryBlocks, 1, uNumStreams, StreamSizes));
-
     UINT32 uOffsets = 0;
     for (unsigned i = 0; i < StreamIndex; i++) {
-      UINT32 uNumBlocks = CalculateNumBlocks(m_SB.BlockSize, StreamSizes[i]);
+      UINT32 uNumBlocks = CalculateNumBlocks(m_SB.BlockSize, m_StreamSizes[i]);
       uOffsets += uNumBlocks;
     }
 
+    const UINT32 uStreamSize = m_StreamSizes[StreamIndex];
+
     llvm::SmallVector<uint32_t, 12> DataBlocks;
-    IFR(ReadU32ListFromBlocks(DirectoryBlocks, 1 + uNumStreams + uOffsets, 
-      CalculateNumBlocks(m_SB.BlockSize, StreamSizes[StreamIndex]), DataBlocks));
+    IFR(ReadU32ListFromBlocks(m_DirectoryBlocks,
+      1 + (UINT32)m_StreamSizes.size() + uOffsets,
+      CalculateNumBlocks(m_SB.BlockSize, uStreamSize), DataBlocks));
 
     if (DataBlocks.size() == 0)
       return E_FAIL;
 
-    IFR(GoToBeginningOfBlock(DataBlocks[0]));
+    // If the stream is memory backed and the stream's blocks are laid out
+    // consecutively (always the case for PDBs produced by MSFWriter), return
+    // a view over the original memory instead of copying. The view holds a
+    // reference on the underlying blob.
+    if (m_pFileBlob) {
+      bool bConsecutive = true;
+      for (unsigned i = 1; i < DataBlocks.size(); i++) {
+        if (DataBlocks[i] != DataBlocks[0] + i) {
+          bConsecutive = false;
+          break;
+        }
+      }
+      const UINT64 uByteOffset = (UINT64)DataBlocks[0] * m_SB.BlockSize;
+      if (bConsecutive && uByteOffset <= UINT32_MAX &&
+          uByteOffset + uStreamSize <= m_pFileBlob->GetBufferSize()) {
+        return hlsl::DxcCreateBlobFromBlob(m_pFileBlob, (UINT32)uByteOffset,
+          uStreamSize, ppData);
+      }
+    }
 
+    // Otherwise coalesce the block chain into a fresh blob.
     CComPtr<hlsl::AbstractMemoryStream> pResult;
     IFR(CreateMemoryStream(m_pMalloc, &pResult));
 
+    UINT32 uRemaining = uStreamSize;
     std::vector<char> CopyBuffer;
     CopyBuffer.resize(m_SB.BlockSize);
     for (unsigned i = 0; i < DataBlocks.size(); i++) {
+      const UINT32 uChunk = std::min<UINT32>(uRemaining, m_SB.BlockSize);
       IFR(GoToBeginningOfBlock(DataBlocks[i]));
-      IFR(ReadAllBytes(m_pStream, CopyBuffer.data(), m_SB.BlockSize));
+      IFR(ReadAllBytes(m_pStream, CopyBuffer.data(), uChunk));
       ULONG uSizeWritten = 0;
-      IFR(pResult->Write(CopyBuffer.data(), m_SB.BlockSize, &uSizeWritten));
-      if (uSizeWritten != m_SB.BlockSize)
+      IFR(pResult->Write(CopyBuffer.data(), uChunk, &uSizeWritten));
+      if (uSizeWritten != uChunk)
         return E_FAIL;
+      uRemaining -= uChunk;
     }
 
     IFR(pResult.QueryInterface(ppData));
@@ -19,6 +19,7 @@
 #include "dxc/DXIL/DxilOperations.h"
 #include "dxc/DXIL/DxilInstructions.h"
 #include "dxc/DXIL/DxilUtil.h"
+#include "llvm/Support/MathExtras.h"
 
 using namespace llvm;
 
@@ -135,32 +136,16 @@ DxilResourceProperties loadFromResourceBase(DxilResourceBase *Res) {
       RP.ElementStride = Res.GetElementStride();
       break;
     case DXIL::ResourceKind::Texture2DMS:
-    case DXIL::ResourceKind::Texture2DMSArray:
-      switch (Res.GetSampleCount()) {
-      default:
-        RP.Typed.SampleCountPow2 =
-            DxilResourceProperties::kSampleCountUndefined;
-        break;
-      case 1:
-        RP.Typed.SampleCountPow2 = 0;
-        break;
-      case 2:
-        RP.Typed.SampleCountPow2 = 1;
-        break;
-      case 4:
-        RP.Typed.SampleCountPow2 = 2;
-        break;
-      case 8:
-        RP.Typed.SampleCountPow2 = 3;
-        break;
-      case 16:
-        RP.Typed.SampleCountPow2 = 4;
-        break;
-      case 32:
-        RP.Typed.SampleCountPow2 = 5;
-        break;
-      }
-      break;
+    case DXIL::ResourceKind::Texture2DMSArray: {
+      // Valid sample counts are the powers of two in [1, 32]; everything
+      // else encodes as undefined.
+      unsigned SampleCount = Res.GetSampleCount();
+      RP.Typed.SampleCountPow2 =
+          (SampleCount != 0 && SampleCount <= 32 &&
+           llvm::isPowerOf2_32(SampleCount))
+              ? llvm::Log2_32(SampleCount)
+              : DxilResourceProperties::kSampleCountUndefined;
+    } break;
     case DXIL::ResourceKind::TypedBuffer:
     case DXIL::ResourceKind::Texture1D:
     case DXIL::ResourceKind::Texture2D:
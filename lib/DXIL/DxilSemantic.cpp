@@ -12,6 +12,7 @@
 #include "dxc/DXIL/DxilSignature.h"
 #include "dxc/DXIL/DxilShaderModel.h"
 #include "dxc/Support/Global.h"
+#include "llvm/ADT/StringMap.h"
 
 #include <string>
 
@@ -34,12 +35,20 @@ const Semantic *Semantic::GetByName(llvm::StringRef name) {
   if (!HasSVPrefix(name))
     return GetArbitrary();
 
-  // The search is a simple linear scan as it is fairly infrequent operation and the list is short.
-  // The search can be improved if linear traversal has inadequate performance.
-  for (unsigned i = (unsigned)Kind::Arbitrary + 1; i < (unsigned)Kind::Invalid; i++) {
-    if (name.compare_lower(ms_SemanticTable[i].m_pszName) == 0)
-      return &ms_SemanticTable[i];
-  }
+  // Resolution runs per signature element per compile plus per validation, so
+  // instead of scanning the table with case-insensitive compares each time,
+  // probe a case-folded name map built once on first use.
+  static const llvm::StringMap<unsigned> *pNameMap = []() {
+    auto *pMap = new llvm::StringMap<unsigned>();
+    for (unsigned i = (unsigned)Kind::Arbitrary + 1;
+         i < (unsigned)Kind::Invalid; i++)
+      (*pMap)[llvm::StringRef(ms_SemanticTable[i].m_pszName).lower()] = i;
+    return pMap;
+  }();
+
+  auto it = pNameMap->find(name.lower());
+  if (it != pNameMap->end())
+    return &ms_SemanticTable[it->second];
 
   return GetInvalid();
 }
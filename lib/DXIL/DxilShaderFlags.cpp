@@ -360,11 +360,9 @@ ShaderFlags ShaderFlags::CollectShaderFlags(const Function *F,
               }
             } else if (handleOp == DXIL::OpCode::AnnotateHandle) {
               DxilInst_AnnotateHandle annotateHandle(handleCall);
-              Type *ResPropTy = M->GetOP()->GetResourcePropertiesType();
 
               DxilResourceProperties RP =
-                  resource_helper::loadFromAnnotateHandle(
-                      annotateHandle, ResPropTy, *M->GetShaderModel());
+                  M->GetCachedResourceProperties(annotateHandle);
               if (RP.Class == DXIL::ResourceClass::UAV) {
                 // Validator 1.0 assumes that all uav load is multi component
                 // load.
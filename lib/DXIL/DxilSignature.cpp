@@ -74,6 +74,13 @@ unsigned DxilSignature::AppendElement(std::unique_ptr<DxilSignatureElement> pSE,
   return Id;
 }
 
+std::unique_ptr<DxilSignatureElement> DxilSignature::RemoveElement(unsigned idx) {
+  DXASSERT_NOMSG(idx < (unsigned)m_Elements.size());
+  std::unique_ptr<DxilSignatureElement> pSE = std::move(m_Elements[idx]);
+  m_Elements.erase(m_Elements.begin() + idx);
+  return pSE;
+}
+
 DxilSignatureElement &DxilSignature::GetElement(unsigned idx) {
   return *m_Elements[idx];
 }
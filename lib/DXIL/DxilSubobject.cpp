@@ -207,29 +207,14 @@ DxilSubobjects::~DxilSubobjects() {}
 
 
 llvm::StringRef DxilSubobjects::InternString(llvm::StringRef value) {
-  auto it = m_BytesStorage.find(value);
-  if (it != m_BytesStorage.end())
-    return it->first;
-
-  size_t size = value.size();
-  StoredBytes stored(std::make_pair(std::unique_ptr<char[]>(new char[size + 1]), size + 1));
-  memcpy(stored.first.get(), value.data(), size);
-  stored.first[size] = 0;
-  llvm::StringRef key(stored.first.get(), size);
-  m_BytesStorage[key] = std::move(stored);
-  return key;
+  return m_BytesStorage.insert(std::make_pair(value, '\0')).first->getKey();
 }
 
 const void *DxilSubobjects::InternRawBytes(const void *ptr, size_t size) {
-  auto it = m_BytesStorage.find(llvm::StringRef((const char *)ptr, size));
-  if (it != m_BytesStorage.end())
-    return it->first.data();
-
-  StoredBytes stored(std::make_pair(std::unique_ptr<char[]>(new char[size]), size));
-  memcpy(stored.first.get(), ptr, size);
-  llvm::StringRef key(stored.first.get(), size);
-  m_BytesStorage[key] = std::move(stored);
-  return key.data();
+  return m_BytesStorage
+      .insert(std::make_pair(llvm::StringRef((const char *)ptr, size), '\0'))
+      .first->getKey()
+      .data();
 }
 
 DxilSubobject *DxilSubobjects::FindSubobject(llvm::StringRef name) {
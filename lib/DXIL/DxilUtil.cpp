@@ -116,21 +116,54 @@ bool IsSharedMemoryGlobal(llvm::GlobalVariable *GV) {
 
 bool RemoveUnusedFunctions(Module &M, Function *EntryFunc,
                            Function *PatchConstantFunc, bool IsLib) {
-  std::vector<Function *> deadList;
-  for (auto &F : M.functions()) {
-    if (&F == EntryFunc || &F == PatchConstantFunc)
-      continue;
-    if (F.isDeclaration() || !IsLib) {
-      if (F.user_empty())
-        deadList.emplace_back(&F);
+  bool bUpdated = false;
+  // Iterate to a fixpoint: erasing an unused function can leave its callees
+  // without users, so a single sweep would keep whole dead call trees alive.
+  bool bChanged;
+  do {
+    std::vector<Function *> deadList;
+    for (auto &F : M.functions()) {
+      if (&F == EntryFunc || &F == PatchConstantFunc)
+        continue;
+      if (F.isDeclaration() || !IsLib) {
+        if (F.user_empty())
+          deadList.emplace_back(&F);
+      }
     }
-  }
-  bool bUpdated = deadList.size();
-  for (Function *F : deadList)
-    F->eraseFromParent();
+    bChanged = !deadList.empty();
+    for (Function *F : deadList)
+      F->eraseFromParent();
+    bUpdated |= bChanged;
+  } while (bChanged);
   return bUpdated;
 }
 
+void MinimizeModuleForRuntime(Module &M) {
+  // Local value names only aid debugging and disassembly, but the runtime
+  // still parses past every byte of them. Keep global names: entry points,
+  // exported functions and dx.* globals are referenced by name from metadata
+  // or the validator.
+  for (Function &F : M.functions()) {
+    for (Argument &Arg : F.args())
+      if (Arg.hasName())
+        Arg.setName("");
+    for (BasicBlock &BB : F) {
+      if (BB.hasName())
+        BB.setName("");
+      for (Instruction &I : BB)
+        if (I.hasName())
+          I.setName("");
+    }
+  }
+  for (GlobalVariable &GV : M.globals())
+    if (GV.hasLocalLinkage() && GV.hasName() && !GV.getName().startswith("dx."))
+      GV.setName("");
+
+  // Compiler identification is dead weight in a shipped container.
+  if (NamedMDNode *IdentMD = M.getNamedMetadata("llvm.ident"))
+    M.eraseNamedMetadata(IdentMD);
+}
+
 void PrintDiagnosticHandler(const llvm::DiagnosticInfo &DI, void *Context) {
   DiagnosticPrinter *printer = reinterpret_cast<DiagnosticPrinter *>(Context);
   DI.print(*printer);
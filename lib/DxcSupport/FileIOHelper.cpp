@@ -22,6 +22,9 @@
 
 #ifdef _WIN32
 #include <intsafe.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 #define CP_UTF16 1200
@@ -258,8 +261,9 @@ public:
   DXC_MICROCOM_ADDREF_IMPL(m_dwRef)
   ULONG STDMETHODCALLTYPE Release() override {
     // Because blobs are also used by tests and utilities, we avoid using TLS.
-    ULONG result = (ULONG)--m_dwRef;
+    ULONG result = (ULONG)m_dwRef.fetch_sub(1, std::memory_order_release) - 1;
     if (result == 0) {
+      std::atomic_thread_fence(std::memory_order_acquire);
       CComPtr<IMalloc> pTmp(m_pMalloc);
       this->~InternalDxcBlobEncoding_Impl();
       pTmp->Free(this);
@@ -757,6 +761,152 @@ HRESULT DxcCreateBlobFromFile(LPCWSTR pFileName, UINT32 *pCodePage,
   return DxcCreateBlobFromFile(DxcGetThreadMallocNoRef(), pFileName, pCodePage, ppBlobEncoding);
 }
 
+namespace {
+
+// Blob over a read-only memory-mapped view of a file; the view (and on
+// Windows the mapping object) is released when the last reference goes away.
+class MappedFileBlob : public IDxcBlob {
+private:
+  DXC_MICROCOM_TM_REF_FIELDS()
+  LPVOID m_Buffer = nullptr;
+  SIZE_T m_BufferSize = 0;
+#ifdef _WIN32
+  HANDLE m_FileMapping = nullptr;
+#endif
+public:
+  DXC_MICROCOM_ADDREF_IMPL(m_dwRef)
+  ULONG STDMETHODCALLTYPE Release() override {
+    // Like the blob encodings above, avoid TLS; tests and utilities use blobs.
+    ULONG result = (ULONG)m_dwRef.fetch_sub(1, std::memory_order_release) - 1;
+    if (result == 0) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      CComPtr<IMalloc> pTmp(m_pMalloc);
+      this->~MappedFileBlob();
+      pTmp->Free(this);
+    }
+    return result;
+  }
+  DXC_MICROCOM_TM_CTOR(MappedFileBlob)
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
+    return DoBasicQueryInterface<IDxcBlob>(this, iid, ppvObject);
+  }
+
+  ~MappedFileBlob() {
+#ifdef _WIN32
+    if (m_Buffer != nullptr)
+      UnmapViewOfFile(m_Buffer);
+    if (m_FileMapping != nullptr)
+      CloseHandle(m_FileMapping);
+#else
+    if (m_Buffer != nullptr)
+      munmap(m_Buffer, m_BufferSize);
+#endif
+  }
+
+#ifdef _WIN32
+  void Init(LPVOID pBuffer, SIZE_T size, HANDLE hFileMapping) {
+    m_Buffer = pBuffer;
+    m_BufferSize = size;
+    m_FileMapping = hFileMapping;
+  }
+#else
+  void Init(LPVOID pBuffer, SIZE_T size) {
+    m_Buffer = pBuffer;
+    m_BufferSize = size;
+  }
+#endif
+
+  virtual LPVOID STDMETHODCALLTYPE GetBufferPointer(void) override {
+    return m_Buffer;
+  }
+  virtual SIZE_T STDMETHODCALLTYPE GetBufferSize(void) override {
+    return m_BufferSize;
+  }
+};
+
+} // namespace
+
+_Use_decl_annotations_
+HRESULT
+DxcCreateBlobFromFileMapped(IMalloc *pMalloc, LPCWSTR pFileName,
+                            IDxcBlobEncoding **ppBlobEncoding) throw() {
+  if (pFileName == nullptr || ppBlobEncoding == nullptr) {
+    return E_POINTER;
+  }
+  *ppBlobEncoding = nullptr;
+  if (pMalloc == nullptr) {
+    pMalloc = DxcGetThreadMallocNoRef();
+  }
+
+  HANDLE hFile = CreateFileW(pFileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (hFile == INVALID_HANDLE_VALUE) {
+    return HRESULT_FROM_WIN32(GetLastError());
+  }
+  CHandle h(hFile);
+
+  LARGE_INTEGER FileSize;
+  if (!GetFileSizeEx(hFile, &FileSize)) {
+    return HRESULT_FROM_WIN32(GetLastError());
+  }
+  if (FileSize.u.HighPart != 0) {
+    return DXC_E_INPUT_FILE_TOO_LARGE;
+  }
+  // A zero-length mapping cannot be created; the regular reader handles it.
+  if (FileSize.u.LowPart == 0) {
+    return E_FAIL;
+  }
+
+#ifdef _WIN32
+  HANDLE hMapping =
+      CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (hMapping == nullptr) {
+    return HRESULT_FROM_WIN32(GetLastError());
+  }
+  LPVOID pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+  if (pData == nullptr) {
+    HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+    CloseHandle(hMapping);
+    return hr;
+  }
+#else
+  // On POSIX platforms the HANDLE from the emulated CreateFileW is the fd.
+  LPVOID pData = mmap(nullptr, FileSize.u.LowPart, PROT_READ, MAP_PRIVATE,
+                      (int)(size_t)hFile, 0);
+  if (pData == MAP_FAILED) {
+    return E_FAIL;
+  }
+#endif
+
+  MappedFileBlob *pBlob = MappedFileBlob::Alloc(pMalloc);
+  if (pBlob == nullptr) {
+#ifdef _WIN32
+    UnmapViewOfFile(pData);
+    CloseHandle(hMapping);
+#else
+    munmap(pData, FileSize.u.LowPart);
+#endif
+    return E_OUTOFMEMORY;
+  }
+#ifdef _WIN32
+  pBlob->Init(pData, FileSize.u.LowPart, hMapping);
+#else
+  pBlob->Init(pData, FileSize.u.LowPart);
+#endif
+  CComPtr<IDxcBlob> pBlobPtr(pBlob); // owns the mapping from here on
+
+  // Leave the encoding unknown; detection and any conversion are deferred
+  // until a consumer actually asks for the text.
+  InternalDxcBlobEncoding *internalEncoding;
+  HRESULT hr = InternalDxcBlobEncoding::CreateFromBlob(pBlobPtr, pMalloc,
+                                                       false, 0,
+                                                       &internalEncoding);
+  if (SUCCEEDED(hr)) {
+    *ppBlobEncoding = internalEncoding;
+  }
+  return hr;
+}
+
 _Use_decl_annotations_
 HRESULT
 DxcCreateBlobWithEncodingSet(IMalloc *pMalloc, IDxcBlob *pBlob, UINT32 codePage,
@@ -996,6 +1146,11 @@ bool IsBlobNullOrEmpty(_In_opt_ IDxcBlob *pBlob) throw() {
 ///////////////////////////////////////////////////////////////////////////////
 // Stream implementations.
 
+// Per-thread high-water marks for pooled stream sizing. Plain constant-
+// initialized PODs so there is no dynamic TLS construction or teardown to
+// sequence against DllMain; a fresh thread simply starts without a hint.
+static thread_local ULONG g_StreamHighWaterMark[(unsigned)MemoryStreamPool::Count];
+
 class MemoryStream : public AbstractMemoryStream, public IDxcBlob {
 private:
   DXC_MICROCOM_TM_REF_FIELDS()
@@ -1003,13 +1158,15 @@ private:
   ULONG m_offset = 0;
   ULONG m_size = 0;
   ULONG m_allocSize = 0;
+  MemoryStreamPool m_pool = MemoryStreamPool::Count; // Count == untracked.
 public:
   DXC_MICROCOM_ADDREF_IMPL(m_dwRef)
   ULONG STDMETHODCALLTYPE Release() override {
     // Because memory streams are also used by tests and utilities,
     // we avoid using TLS.
-    ULONG result = (ULONG)--m_dwRef;
+    ULONG result = (ULONG)m_dwRef.fetch_sub(1, std::memory_order_release) - 1;
     if (result == 0) {
+      std::atomic_thread_fence(std::memory_order_acquire);
       CComPtr<IMalloc> pTmp(m_pMalloc);
       this->~MemoryStream();
       pTmp->Free(this);
@@ -1036,6 +1193,12 @@ public:
   }
 
   void Reset() {
+    if (m_pool != MemoryStreamPool::Count) {
+      // Record the buffer size reached so the next stream created against
+      // this pool on this thread can reserve it in a single allocation.
+      ULONG &hwm = g_StreamHighWaterMark[(unsigned)m_pool];
+      hwm = std::max(hwm, m_allocSize);
+    }
     if (m_pMemory != nullptr) {
       m_pMalloc->Free(m_pMemory);
     }
@@ -1045,6 +1208,10 @@ public:
     m_allocSize = 0;
   }
 
+  void SetPool(MemoryStreamPool pool) {
+    m_pool = pool;
+  }
+
   // AbstractMemoryStream implementation.
   LPBYTE GetPtr() throw() override {
     return m_pMemory;
@@ -1212,7 +1379,7 @@ public:
   }
 };
 
-class ReadOnlyBlobStream : public IStream {
+class ReadOnlyBlobStream : public IStream, public IDxcBlob {
 private:
   DXC_MICROCOM_TM_REF_FIELDS()
   CComPtr<IDxcBlob> m_pSource;
@@ -1224,9 +1391,16 @@ public:
   DXC_MICROCOM_TM_CTOR(ReadOnlyBlobStream)
 
   HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
-    return DoBasicQueryInterface<IStream, ISequentialStream>(this, iid, ppvObject);
+    return DoBasicQueryInterface<IStream, ISequentialStream, IDxcBlob>(
+        this, iid, ppvObject);
   }
 
+  // IDxcBlob implementation, exposing the wrapped blob's memory so consumers
+  // that can operate zero-copy (e.g. the DXIL PDB reader) can reach it
+  // without going through Read.
+  LPVOID STDMETHODCALLTYPE GetBufferPointer(void) override { return m_pMemory; }
+  SIZE_T STDMETHODCALLTYPE GetBufferSize(void) override { return m_size; }
+
   void Init(IDxcBlob *pSource) {
     m_pSource = pSource;
     m_offset = 0;
@@ -1450,6 +1624,26 @@ HRESULT CreateMemoryStream(_In_ IMalloc *pMalloc, _COM_Outptr_ AbstractMemoryStr
   return (*ppResult == nullptr) ? E_OUTOFMEMORY : S_OK;
 }
 
+HRESULT CreateMemoryStream(_In_ IMalloc *pMalloc, MemoryStreamPool pool, _COM_Outptr_ AbstractMemoryStream** ppResult) throw() {
+  if (pMalloc == nullptr || ppResult == nullptr) {
+    return E_POINTER;
+  }
+  if (pool >= MemoryStreamPool::Count) {
+    return E_INVALIDARG;
+  }
+
+  CComPtr<MemoryStream> stream = MemoryStream::Alloc(pMalloc);
+  if (stream.p != nullptr) {
+    stream->SetPool(pool);
+    ULONG hint = g_StreamHighWaterMark[(unsigned)pool];
+    if (hint != 0) {
+      IFR(stream->Reserve(hint));
+    }
+  }
+  *ppResult = stream.Detach();
+  return (*ppResult == nullptr) ? E_OUTOFMEMORY : S_OK;
+}
+
 HRESULT CreateReadOnlyBlobStream(_In_ IDxcBlob *pSource, _COM_Outptr_ IStream** ppResult) throw() {
   if (pSource == nullptr || ppResult == nullptr) {
     return E_POINTER;
@@ -20,6 +20,7 @@
 #include "dxc/Support/Unicode.h"
 #include "dxc/Support/dxcapi.use.h"
 #include "dxc/DXIL/DxilShaderModel.h"
+#include <atomic>
 
 using namespace llvm::opt;
 using namespace dxc;
@@ -49,23 +50,34 @@ namespace {
 
 }
 
-static HlslOptTable *g_HlslOptTable;
+// The option table is immutable once constructed. Initialization may be
+// requested from multiple threads when the compiler is hosted in-process
+// (one instance serving concurrent Compile calls), so publication is done
+// with an atomic exchange: the first initializer wins and later ones
+// observe the already-published table.
+static std::atomic<HlslOptTable *> g_HlslOptTable;
 
 std::error_code hlsl::options::initHlslOptTable() {
-  DXASSERT(g_HlslOptTable == nullptr, "else double-init");
-  g_HlslOptTable = new (std::nothrow) HlslOptTable();
-  if (g_HlslOptTable == nullptr)
+  if (g_HlslOptTable.load(std::memory_order_acquire) != nullptr)
+    return std::error_code();
+  HlslOptTable *pTable = new (std::nothrow) HlslOptTable();
+  if (pTable == nullptr)
     return std::error_code(E_OUTOFMEMORY, std::system_category());
+  HlslOptTable *pExpected = nullptr;
+  if (!g_HlslOptTable.compare_exchange_strong(pExpected, pTable,
+                                              std::memory_order_acq_rel)) {
+    // Another thread won the race; keep the published table.
+    delete pTable;
+  }
   return std::error_code();
 }
 
 void hlsl::options::cleanupHlslOptTable() {
-  delete g_HlslOptTable;
-  g_HlslOptTable = nullptr;
+  delete g_HlslOptTable.exchange(nullptr, std::memory_order_acq_rel);
 }
 
 const OptTable * hlsl::options::getHlslOptTable() {
-  return g_HlslOptTable;
+  return g_HlslOptTable.load(std::memory_order_acquire);
 }
 
 void DxcDefines::push_back(llvm::StringRef value) {
@@ -473,7 +485,39 @@ int ReadDxcOpts(const OptTable *optionTable, unsigned flagsToInclude,
   opts.UseHexLiterals = Args.hasFlag(OPT_Lx, OPT_INVALID, false);
   opts.Preprocess = Args.getLastArgValue(OPT_P);
   opts.AstDump = Args.hasFlag(OPT_ast_dump, OPT_INVALID, false);
+  opts.EmitPCH = Args.hasFlag(OPT_emit_pch, OPT_INVALID, false);
+  opts.IncludePCH = Args.getLastArgValue(OPT_include_pch);
   opts.CodeGenHighLevel = Args.hasFlag(OPT_fcgl, OPT_INVALID, false);
+  opts.ParallelCodeGen = Args.hasFlag(OPT_fparallel_codegen, OPT_INVALID, false);
+  if (opts.ParallelCodeGen) {
+    // Function-level parallel emission requires per-thread CodeGenModules
+    // over a shared ASTContext, which clang's CodeGen does not support yet;
+    // accept the flag so build systems can opt in once it lands.
+    errors << "Warning: -fparallel-codegen is accepted but function bodies "
+              "are currently emitted serially.";
+  }
+  opts.Deterministic = Args.hasFlag(OPT_fdeterministic, OPT_INVALID, false);
+  opts.VerifyDeterministic =
+      Args.hasFlag(OPT_verify_deterministic, OPT_INVALID, false);
+  if (opts.VerifyDeterministic)
+    opts.Deterministic = true;
+  if (opts.Deterministic) {
+    // Overlapped part serialization trades ordering guarantees for speed.
+    opts.ParallelCodeGen = false;
+  }
+  opts.ContextPool = Args.hasFlag(OPT_fcontext_pool, OPT_INVALID, false);
+  opts.CacheIncludes = Args.hasFlag(OPT_fcache_includes, OPT_INVALID, false);
+  opts.TimeTrace = Args.hasFlag(OPT_ftime_trace, OPT_INVALID, false);
+  opts.CompressDebug = Args.hasFlag(OPT_fcompress_debug, OPT_INVALID, false);
+  llvm::StringRef diagRenderLimit =
+      Args.getLastArgValue(OPT_fdiagnostics_render_limit_EQ);
+  if (!diagRenderLimit.empty() &&
+      diagRenderLimit.getAsInteger(10, opts.DiagRenderLimit)) {
+    errors << "Invalid value for -fdiagnostics-render-limit=: "
+           << diagRenderLimit;
+    return 1;
+  }
+  opts.EmbedSourceHash = Args.hasFlag(OPT_fembed_source_hash, OPT_INVALID, false);
   opts.AllowPreserveValues = Args.hasFlag(OPT_preserve_intermediate_values, OPT_INVALID, false);
   opts.DebugInfo = Args.hasFlag(OPT__SLASH_Zi, OPT_INVALID, false);
   opts.DebugNameForBinary = Args.hasFlag(OPT_Zsb, OPT_INVALID, false);
@@ -492,6 +536,28 @@ int ReadDxcOpts(const OptTable *optionTable, unsigned flagsToInclude,
   if (!limit.empty())
     opts.ScanLimit = std::stoul(std::string(limit));
 
+  opts.ProfileUnrollUse = Args.getLastArgValue(OPT_fprofile_unroll_use_EQ);
+  if (!opts.ProfileUnrollUse.empty()) {
+    llvm::SmallVector<llvm::StringRef, 4> entries;
+    opts.ProfileUnrollUse.split(entries, ';', /*MaxSplit*/ -1,
+                                /*KeepEmpty*/ false);
+    for (llvm::StringRef entry : entries) {
+      llvm::StringRef file, lineStr, countStr;
+      std::tie(file, countStr) = entry.rsplit(':');
+      std::tie(file, lineStr) = file.rsplit(':');
+      unsigned value;
+      if (file.empty() || lineStr.getAsInteger(10, value) ||
+          countStr.getAsInteger(10, value)) {
+        errors << "Invalid profile unroll entry '" << entry
+               << "'; expected <file>:<line>:<count>.";
+        return 1;
+      }
+    }
+  }
+
+  opts.PressureSchedule =
+      Args.hasFlag(OPT_fpressure_schedule, OPT_INVALID, false);
+
   if (!opts.ForceRootSigVer.empty() && opts.ForceRootSigVer != "rootsig_1_0" &&
       opts.ForceRootSigVer != "rootsig_1_1") {
     errors << "Unsupported value '" << opts.ForceRootSigVer
@@ -588,6 +654,8 @@ int ReadDxcOpts(const OptTable *optionTable, unsigned flagsToInclude,
   opts.DefaultRowMajor = Args.hasFlag(OPT_Zpr, OPT_INVALID, false);
   opts.DefaultColMajor = Args.hasFlag(OPT_Zpc, OPT_INVALID, false);
   opts.DumpBin = Args.hasFlag(OPT_dumpbin, OPT_INVALID, false);
+  opts.ScanDeps = Args.hasFlag(OPT_scan_deps, OPT_INVALID, false);
+  opts.ScanDepsJson = Args.hasFlag(OPT_scan_deps_json, OPT_INVALID, false);
   opts.NotUseLegacyCBufLoad = Args.hasFlag(OPT_no_legacy_cbuf_layout, OPT_INVALID, false);
   opts.NotUseLegacyCBufLoad = Args.hasFlag(OPT_not_use_legacy_cbuf_load_, OPT_INVALID, opts.NotUseLegacyCBufLoad);
   opts.PackPrefixStable = Args.hasFlag(OPT_pack_prefix_stable, OPT_INVALID, false);
@@ -606,6 +674,11 @@ int ReadDxcOpts(const OptTable *optionTable, unsigned flagsToInclude,
   opts.StripReflection = Args.hasFlag(OPT_Qstrip_reflect, OPT_INVALID, false);
   opts.KeepReflectionInDxil = Args.hasFlag(OPT_Qkeep_reflect_in_dxil, OPT_INVALID, false);
   opts.StripReflectionFromDxil = Args.hasFlag(OPT_Qstrip_reflect_from_dxil, OPT_INVALID, false);
+  opts.MinimizeContainer = Args.hasFlag(OPT_Qminimize, OPT_INVALID, false);
+  if (opts.MinimizeContainer) {
+    opts.StripDebug = true;
+    opts.StripReflection = true;
+  }
   opts.ExtractRootSignature = Args.hasFlag(OPT_extractrootsignature, OPT_INVALID, false);
   opts.DisassembleColorCoded = Args.hasFlag(OPT_Cc, OPT_INVALID, false);
   opts.DisassembleInstNumbers = Args.hasFlag(OPT_Ni, OPT_INVALID, false);
@@ -684,7 +757,8 @@ int ReadDxcOpts(const OptTable *optionTable, unsigned flagsToInclude,
   // XXX TODO: Sort this out, since it's required for new API, but a separate argument for old APIs.
   if ((flagsToInclude & hlsl::options::DriverOption) &&
       !(flagsToInclude & hlsl::options::RewriteOption) &&
-      opts.TargetProfile.empty() && !opts.DumpBin && opts.Preprocess.empty() && !opts.RecompileFromBinary
+      opts.TargetProfile.empty() && !opts.DumpBin && opts.Preprocess.empty() &&
+      !opts.RecompileFromBinary && !opts.ScanDeps
       ) {
     // Target profile is required in arguments only for drivers when compiling;
     // APIs take this through an argument.
@@ -873,6 +947,11 @@ int ReadDxcOpts(const OptTable *optionTable, unsigned flagsToInclude,
     return 1;
   }
 
+  if (opts.MinimizeContainer && opts.EmbedDebug) {
+    errors << "Cannot use /Qembed_debug with /Qminimize";
+    return 1;
+  }
+
   if (opts.DebugInfo && !opts.DebugNameForBinary && !opts.DebugNameForSource) {
     opts.DebugNameForBinary = true;
   } else if (opts.DebugNameForBinary && opts.DebugNameForSource) {
@@ -20,10 +20,144 @@
 #include "dxc/Support/WinIncludes.h"
 
 #ifndef _WIN32
+// Direct UTF-8 <-> wide character conversion, used for CP_UTF8 so those calls
+// do not have to go through mbstowcs/wcstombs below, which switch the
+// process-global locale around every conversion. UTF-8 is the only code page
+// dxc actually exercises on non-Windows platforms, so in practice all
+// conversions take this path.
+
+// Decodes cbSrc bytes of UTF-8 into pDst (pass nullptr to only count).
+// Returns the number of wchar_t elements required/written, or -1 for invalid
+// UTF-8 when strict, or -2 for an insufficient output buffer.
+static int Utf8ToWide(const char *pSrc, int cbSrc, wchar_t *pDst, int cchDst,
+                      bool strict) {
+  static const uint32_t MinCodePointForLength[] = {0, 0, 0x80, 0x800, 0x10000};
+  int cch = 0;
+  int i = 0;
+  while (i < cbSrc) {
+    unsigned char lead = (unsigned char)pSrc[i];
+    uint32_t codePoint;
+    int len;
+    if (lead < 0x80) {
+      codePoint = lead;
+      len = 1;
+    } else if ((lead & 0xE0) == 0xC0) {
+      codePoint = lead & 0x1F;
+      len = 2;
+    } else if ((lead & 0xF0) == 0xE0) {
+      codePoint = lead & 0x0F;
+      len = 3;
+    } else if ((lead & 0xF8) == 0xF0) {
+      codePoint = lead & 0x07;
+      len = 4;
+    } else {
+      len = 1;
+      codePoint = 0xFFFFFFFF;
+    }
+    if (codePoint != 0xFFFFFFFF) {
+      if (i + len > cbSrc) {
+        codePoint = 0xFFFFFFFF;
+        len = cbSrc - i;
+      } else {
+        for (int j = 1; j < len; ++j) {
+          unsigned char trail = (unsigned char)pSrc[i + j];
+          if ((trail & 0xC0) != 0x80) {
+            codePoint = 0xFFFFFFFF;
+            len = j;
+            break;
+          }
+          codePoint = (codePoint << 6) | (trail & 0x3F);
+        }
+      }
+    }
+    if (codePoint != 0xFFFFFFFF &&
+        (codePoint < MinCodePointForLength[len] || codePoint > 0x10FFFF ||
+         (codePoint >= 0xD800 && codePoint <= 0xDFFF)))
+      codePoint = 0xFFFFFFFF;
+    if (codePoint == 0xFFFFFFFF) {
+      if (strict)
+        return -1;
+      codePoint = 0xFFFD; // replacement character
+    }
+    i += len;
+    if (sizeof(wchar_t) == 2 && codePoint >= 0x10000) {
+      // Encode as a surrogate pair.
+      if (pDst != nullptr) {
+        if (cch + 2 > cchDst)
+          return -2;
+        codePoint -= 0x10000;
+        pDst[cch] = (wchar_t)(0xD800 + (codePoint >> 10));
+        pDst[cch + 1] = (wchar_t)(0xDC00 + (codePoint & 0x3FF));
+      }
+      cch += 2;
+    } else {
+      if (pDst != nullptr) {
+        if (cch + 1 > cchDst)
+          return -2;
+        pDst[cch] = (wchar_t)codePoint;
+      }
+      ++cch;
+    }
+  }
+  return cch;
+}
+
+// Encodes cchSrc wide characters into UTF-8 (pass nullptr pDst to only
+// count). Returns the number of bytes required/written, or -2 for an
+// insufficient output buffer. Invalid scalars become the replacement
+// character, matching WideCharToMultiByte's lenient default.
+static int WideToUtf8(const wchar_t *pSrc, int cchSrc, char *pDst,
+                      int cbDst) {
+  int cb = 0;
+  for (int i = 0; i < cchSrc; ++i) {
+    uint32_t codePoint = (uint32_t)pSrc[i];
+    if (codePoint >= 0xD800 && codePoint <= 0xDBFF && sizeof(wchar_t) == 2 &&
+        i + 1 < cchSrc && (uint32_t)pSrc[i + 1] >= 0xDC00 &&
+        (uint32_t)pSrc[i + 1] <= 0xDFFF) {
+      codePoint = 0x10000 + ((codePoint - 0xD800) << 10) +
+                  ((uint32_t)pSrc[i + 1] - 0xDC00);
+      ++i;
+    } else if ((codePoint >= 0xD800 && codePoint <= 0xDFFF) ||
+               codePoint > 0x10FFFF) {
+      codePoint = 0xFFFD; // replacement character
+    }
+    char encoded[4];
+    int len;
+    if (codePoint < 0x80) {
+      encoded[0] = (char)codePoint;
+      len = 1;
+    } else if (codePoint < 0x800) {
+      encoded[0] = (char)(0xC0 | (codePoint >> 6));
+      encoded[1] = (char)(0x80 | (codePoint & 0x3F));
+      len = 2;
+    } else if (codePoint < 0x10000) {
+      encoded[0] = (char)(0xE0 | (codePoint >> 12));
+      encoded[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+      encoded[2] = (char)(0x80 | (codePoint & 0x3F));
+      len = 3;
+    } else {
+      encoded[0] = (char)(0xF0 | (codePoint >> 18));
+      encoded[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+      encoded[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+      encoded[3] = (char)(0x80 | (codePoint & 0x3F));
+      len = 4;
+    }
+    if (pDst != nullptr) {
+      if (cb + len > cbDst)
+        return -2;
+      memcpy(pDst + cb, encoded, len);
+    }
+    cb += len;
+  }
+  return cb;
+}
+
 // MultiByteToWideChar which is a Windows-specific method.
 // This is a very simplistic implementation for non-Windows platforms. This
-// implementation completely ignores CodePage and dwFlags.
-int MultiByteToWideChar(uint32_t CodePage, uint32_t /*dwFlags*/,
+// implementation completely ignores dwFlags (except MB_ERR_INVALID_CHARS for
+// UTF-8) and all code pages other than CP_UTF8 fall back to the locale-based
+// conversion.
+int MultiByteToWideChar(uint32_t CodePage, uint32_t dwFlags,
                         const char *lpMultiByteStr, int cbMultiByte,
                         wchar_t *lpWideCharStr, int cchWideChar) {
 
@@ -40,6 +174,21 @@ int MultiByteToWideChar(uint32_t CodePage, uint32_t /*dwFlags*/,
     // Add 1 for the null-terminating character.
     ++cbMultiByte;
   }
+
+  if (CodePage == CP_UTF8) {
+    int rv = Utf8ToWide(lpMultiByteStr, cbMultiByte,
+                        cchWideChar == 0 ? nullptr : lpWideCharStr,
+                        cchWideChar, (dwFlags & MB_ERR_INVALID_CHARS) != 0);
+    if (rv == -1) {
+      SetLastError(ERROR_NO_UNICODE_TRANSLATION);
+      return 0;
+    }
+    if (rv == -2) {
+      SetLastError(ERROR_INSUFFICIENT_BUFFER);
+      return 0;
+    }
+    return rv;
+  }
   // If zero is given as the destination size, this function should
   // return the required size (including the null-terminating character).
   // This is the behavior of mbstowcs when the target is null.
@@ -69,7 +218,8 @@ int MultiByteToWideChar(uint32_t CodePage, uint32_t /*dwFlags*/,
 
 // WideCharToMultiByte is a Windows-specific method.
 // This is a very simplistic implementation for non-Windows platforms. This
-// implementation completely ignores CodePage and dwFlags.
+// implementation completely ignores dwFlags and all code pages other than
+// CP_UTF8 fall back to the locale-based conversion.
 int WideCharToMultiByte(uint32_t CodePage, uint32_t /*dwFlags*/,
                         const wchar_t *lpWideCharStr, int cchWideChar,
                         char *lpMultiByteStr, int cbMultiByte,
@@ -89,6 +239,17 @@ int WideCharToMultiByte(uint32_t CodePage, uint32_t /*dwFlags*/,
     // Add 1 for the null-terminating character.
     ++cchWideChar;
   }
+
+  if (CodePage == CP_UTF8) {
+    int rv = WideToUtf8(lpWideCharStr, cchWideChar,
+                        cbMultiByte == 0 ? nullptr : lpMultiByteStr,
+                        cbMultiByte);
+    if (rv == -2) {
+      SetLastError(ERROR_INSUFFICIENT_BUFFER);
+      return 0;
+    }
+    return rv;
+  }
   // If zero is given as the destination size, this function should
   // return the required size (including the null-terminating character).
   // This is the behavior of wcstombs when the target is null.
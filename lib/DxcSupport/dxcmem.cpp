@@ -16,18 +16,43 @@
 
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/Support/WinFunctions.h"
+#include "dxc/Support/microcom.h"
 #include "llvm/Support/ThreadLocal.h"
+#include <atomic>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <new>
 
 static llvm::sys::ThreadLocal<IMalloc> *g_ThreadMallocTls;
 static IMalloc *g_pDefaultMalloc;
+// Installed via DxcSetDefaultMalloc before DxcInitThreadMalloc captures it.
+static IMalloc *g_pCustomDefaultMalloc;
+
+HRESULT DxcSetDefaultMalloc(IMalloc *pMalloc) throw() {
+  if (g_pDefaultMalloc != nullptr) {
+    // Too late: DxcInitThreadMalloc already captured the default.
+    return E_FAIL;
+  }
+  if (g_pCustomDefaultMalloc != nullptr)
+    g_pCustomDefaultMalloc->Release();
+  g_pCustomDefaultMalloc = pMalloc;
+  if (g_pCustomDefaultMalloc != nullptr)
+    g_pCustomDefaultMalloc->AddRef();
+  return S_OK;
+}
 
 HRESULT DxcInitThreadMalloc() throw() {
   DXASSERT(g_pDefaultMalloc == nullptr, "else InitThreadMalloc already called");
 
   // We capture the default malloc early to avoid potential failures later on.
-  HRESULT hrMalloc = CoGetMalloc(1, &g_pDefaultMalloc);
-  if (FAILED(hrMalloc)) return hrMalloc;
+  if (g_pCustomDefaultMalloc != nullptr) {
+    g_pDefaultMalloc = g_pCustomDefaultMalloc;
+    g_pDefaultMalloc->AddRef();
+  } else {
+    HRESULT hrMalloc = CoGetMalloc(1, &g_pDefaultMalloc);
+    if (FAILED(hrMalloc)) return hrMalloc;
+  }
 
   g_ThreadMallocTls = (llvm::sys::ThreadLocal<IMalloc>*)g_pDefaultMalloc->Alloc(sizeof(llvm::sys::ThreadLocal<IMalloc>));
   if (g_ThreadMallocTls == nullptr) {
@@ -88,3 +113,253 @@ DxcThreadMalloc::DxcThreadMalloc(IMalloc *pMallocOrNull) throw() {
 DxcThreadMalloc::~DxcThreadMalloc() {
     DxcSwapThreadMalloc(pPrior, nullptr);
 }
+
+namespace {
+
+// A thread-caching IMalloc for heavy in-process parallel compilation.
+//
+// Small blocks are served from per-thread size-class freelists carved out of
+// chunks obtained from the backing allocator, so the steady state takes no
+// lock at all. A block freed on a different thread than the one that
+// allocated it is pushed onto the owning cache's remote list with a single
+// compare-and-swap and recycled the next time that thread's freelist runs
+// dry. Requests above the cached size range pass through to the backing
+// allocator with a small header so Free can tell the cases apart.
+//
+// Thread caches are never torn down before the allocator itself is
+// destroyed, so blocks may safely outlive the thread that allocated them.
+// The usual allocator contract applies: destroy the allocator only after
+// all blocks served by it have been freed.
+class ScalableMalloc : public IMalloc {
+private:
+  static const SIZE_T kBlockAlign = 16;      // granularity; also header size
+  static const SIZE_T kMaxCachedSize = 1024; // larger blocks pass through
+  static const SIZE_T kClassCount = kMaxCachedSize / kBlockAlign;
+  static const SIZE_T kChunkSize = 64 * 1024;
+
+  struct ThreadCache;
+
+  // Precedes every block. For cached blocks pOwner designates the thread
+  // cache the block returns to on free; pass-through blocks use nullptr.
+  struct BlockHeader {
+    ThreadCache *pOwner;
+    SIZE_T size;
+  };
+
+  // Overlays BlockHeader while a block sits on a freelist; pNext aliases
+  // pOwner, and size stays valid so remote drains can classify the block.
+  struct FreeBlock {
+    FreeBlock *pNext;
+    SIZE_T size;
+  };
+
+  struct Chunk {
+    Chunk *pNext;
+  };
+
+  struct ThreadCache {
+    ThreadCache *pNextCache = nullptr; // global list used during teardown
+    FreeBlock *freeLists[kClassCount] = {};
+    std::atomic<FreeBlock *> remoteFrees{nullptr};
+    BYTE *pBump = nullptr;
+    BYTE *pBumpEnd = nullptr;
+    Chunk *pChunks = nullptr;
+  };
+
+  std::atomic<ULONG> m_dwRef;
+  CComPtr<IMalloc> m_pBacking;
+  llvm::sys::ThreadLocal<ThreadCache> m_tls;
+  std::mutex m_cacheListLock;
+  ThreadCache *m_pCaches;
+
+  ThreadCache *GetCache() {
+    ThreadCache *pCache = m_tls.get();
+    if (pCache != nullptr)
+      return pCache;
+    void *pMem = m_pBacking->Alloc(sizeof(ThreadCache));
+    if (pMem == nullptr)
+      return nullptr;
+    pCache = new (pMem) ThreadCache();
+    {
+      std::lock_guard<std::mutex> lock(m_cacheListLock);
+      pCache->pNextCache = m_pCaches;
+      m_pCaches = pCache;
+    }
+    m_tls.set(pCache);
+    return pCache;
+  }
+
+  void DrainRemoteFrees(ThreadCache *pCache) {
+    FreeBlock *pList =
+        pCache->remoteFrees.exchange(nullptr, std::memory_order_acquire);
+    while (pList != nullptr) {
+      FreeBlock *pNext = pList->pNext;
+      SIZE_T cls = pList->size / kBlockAlign - 1;
+      pList->pNext = pCache->freeLists[cls];
+      pCache->freeLists[cls] = pList;
+      pList = pNext;
+    }
+  }
+
+  void *AllocPassThrough(SIZE_T size) {
+    BlockHeader *pHeader =
+        (BlockHeader *)m_pBacking->Alloc(sizeof(BlockHeader) + size);
+    if (pHeader == nullptr)
+      return nullptr;
+    pHeader->pOwner = nullptr;
+    pHeader->size = size;
+    return pHeader + 1;
+  }
+
+public:
+  explicit ScalableMalloc(IMalloc *pBacking)
+      : m_dwRef(1), m_pBacking(pBacking), m_pCaches(nullptr) {}
+
+  ~ScalableMalloc() {
+    ThreadCache *pCache = m_pCaches;
+    while (pCache != nullptr) {
+      ThreadCache *pNext = pCache->pNextCache;
+      Chunk *pChunk = pCache->pChunks;
+      while (pChunk != nullptr) {
+        Chunk *pNextChunk = pChunk->pNext;
+        m_pBacking->Free(pChunk);
+        pChunk = pNextChunk;
+      }
+      pCache->~ThreadCache();
+      m_pBacking->Free(pCache);
+      pCache = pNext;
+    }
+  }
+
+  ULONG STDMETHODCALLTYPE AddRef() override { return ++m_dwRef; }
+  ULONG STDMETHODCALLTYPE Release() override {
+    ULONG result = --m_dwRef;
+    if (result == 0) {
+      // Keep the backing allocator alive until this object's memory is gone.
+      CComPtr<IMalloc> pBacking(m_pBacking);
+      this->~ScalableMalloc();
+      pBacking->Free(this);
+    }
+    return result;
+  }
+  STDMETHODIMP QueryInterface(REFIID iid, void **ppvObject) override {
+    return DoBasicQueryInterface<IMalloc>(this, iid, ppvObject);
+  }
+
+  virtual void *STDMETHODCALLTYPE Alloc(_In_ SIZE_T cb) override {
+    SIZE_T size = (cb + kBlockAlign - 1) & ~(kBlockAlign - 1);
+    if (size == 0)
+      size = kBlockAlign;
+    if (size > kMaxCachedSize)
+      return AllocPassThrough(size);
+
+    ThreadCache *pCache = GetCache();
+    if (pCache == nullptr)
+      return AllocPassThrough(size);
+
+    SIZE_T cls = size / kBlockAlign - 1;
+    FreeBlock *pBlock = pCache->freeLists[cls];
+    if (pBlock == nullptr) {
+      DrainRemoteFrees(pCache);
+      pBlock = pCache->freeLists[cls];
+    }
+    BlockHeader *pHeader;
+    if (pBlock != nullptr) {
+      pCache->freeLists[cls] = pBlock->pNext;
+      pHeader = (BlockHeader *)pBlock;
+    } else {
+      SIZE_T blockBytes = sizeof(BlockHeader) + size;
+      if (pCache->pBump + blockBytes > pCache->pBumpEnd) {
+        Chunk *pChunk = (Chunk *)m_pBacking->Alloc(kChunkSize);
+        if (pChunk == nullptr)
+          return AllocPassThrough(size);
+        pChunk->pNext = pCache->pChunks;
+        pCache->pChunks = pChunk;
+        // Skip a full alignment unit past the chunk link so user pointers
+        // stay kBlockAlign-aligned.
+        pCache->pBump = (BYTE *)pChunk + kBlockAlign;
+        pCache->pBumpEnd = (BYTE *)pChunk + kChunkSize;
+      }
+      pHeader = (BlockHeader *)pCache->pBump;
+      pCache->pBump += blockBytes;
+    }
+    pHeader->pOwner = pCache;
+    pHeader->size = size;
+    return pHeader + 1;
+  }
+
+  virtual void *STDMETHODCALLTYPE Realloc(_In_opt_ void *pv,
+                                          _In_ SIZE_T cb) override {
+    if (pv == nullptr)
+      return Alloc(cb);
+    if (cb == 0) {
+      Free(pv);
+      return nullptr;
+    }
+    BlockHeader *pHeader = (BlockHeader *)pv - 1;
+    if (cb <= pHeader->size)
+      return pv;
+    void *pNew = Alloc(cb);
+    if (pNew == nullptr)
+      return nullptr;
+    memcpy(pNew, pv, pHeader->size);
+    Free(pv);
+    return pNew;
+  }
+
+  virtual void STDMETHODCALLTYPE Free(_In_opt_ void *pv) override {
+    if (pv == nullptr)
+      return;
+    BlockHeader *pHeader = (BlockHeader *)pv - 1;
+    ThreadCache *pOwner = pHeader->pOwner;
+    if (pOwner == nullptr) {
+      m_pBacking->Free(pHeader);
+      return;
+    }
+    FreeBlock *pBlock = (FreeBlock *)pHeader;
+    if (pOwner == m_tls.get()) {
+      SIZE_T cls = pBlock->size / kBlockAlign - 1;
+      pBlock->pNext = pOwner->freeLists[cls];
+      pOwner->freeLists[cls] = pBlock;
+    } else {
+      // Lock-free push onto the owning thread's remote list.
+      FreeBlock *pHead = pOwner->remoteFrees.load(std::memory_order_relaxed);
+      do {
+        pBlock->pNext = pHead;
+      } while (!pOwner->remoteFrees.compare_exchange_weak(
+          pHead, pBlock, std::memory_order_release,
+          std::memory_order_relaxed));
+    }
+  }
+
+  virtual SIZE_T STDMETHODCALLTYPE GetSize(_In_opt_ void *pv) {
+    if (pv == nullptr)
+      return (SIZE_T)-1;
+    return ((BlockHeader *)pv - 1)->size;
+  }
+
+  virtual int STDMETHODCALLTYPE DidAlloc(_In_opt_ void *pv) {
+    return -1; // don't know
+  }
+
+  virtual void STDMETHODCALLTYPE HeapMinimize(void) {}
+};
+
+} // namespace
+
+HRESULT DxcCreateScalableMalloc(IMalloc **ppMalloc) throw() {
+  if (ppMalloc == nullptr)
+    return E_POINTER;
+  *ppMalloc = nullptr;
+  CComPtr<IMalloc> pBacking;
+  HRESULT hr = CoGetMalloc(1, &pBacking);
+  if (FAILED(hr))
+    return hr;
+  // Allocate from the backing allocator rather than operator new: this can
+  // run before the thread malloc machinery is initialized.
+  void *pMem = pBacking->Alloc(sizeof(ScalableMalloc));
+  if (pMem == nullptr)
+    return E_OUTOFMEMORY;
+  *ppMalloc = new (pMem) ScalableMalloc(pBacking);
+  return S_OK;
+}
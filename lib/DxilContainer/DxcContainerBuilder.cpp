@@ -102,22 +102,28 @@ HRESULT STDMETHODCALLTYPE DxcContainerBuilder::RemovePart(_In_ UINT32 fourCC) {
 HRESULT STDMETHODCALLTYPE DxcContainerBuilder::SerializeContainer(_Out_ IDxcOperationResult **ppResult) {
   DxcThreadMalloc TM(m_pMalloc);
   try {
-    // Allocate memory for new dxil container.
-    uint32_t ContainerSize = ComputeContainerSize();
-    CComPtr<AbstractMemoryStream> pMemoryStream;
+    // Patch the loaded container when the part layout is unchanged, and only
+    // fall back to a full reassembly when parts moved or changed size.
     CComPtr<IDxcBlob> pResult;
-    IFT(CreateMemoryStream(m_pMalloc, &pMemoryStream));
-    IFT(pMemoryStream->QueryInterface(&pResult));
-    IFT(pMemoryStream->Reserve(ContainerSize))
-    
-    // Update Dxil Container
-    IFT(UpdateContainerHeader(pMemoryStream, ContainerSize));
-
-    // Update offset Table
-    IFT(UpdateOffsetTable(pMemoryStream));
-    
-    // Update Parts
-    IFT(UpdateParts(pMemoryStream));
+    HRESULT patchHR = PatchOriginalContainer(&pResult);
+    IFT(patchHR);
+    if (patchHR == S_FALSE) {
+      // Allocate memory for new dxil container.
+      uint32_t ContainerSize = ComputeContainerSize();
+      CComPtr<AbstractMemoryStream> pMemoryStream;
+      IFT(CreateMemoryStream(m_pMalloc, &pMemoryStream));
+      IFT(pMemoryStream->QueryInterface(&pResult));
+      IFT(pMemoryStream->Reserve(ContainerSize))
+
+      // Update Dxil Container
+      IFT(UpdateContainerHeader(pMemoryStream, ContainerSize));
+
+      // Update offset Table
+      IFT(UpdateOffsetTable(pMemoryStream));
+
+      // Update Parts
+      IFT(UpdateParts(pMemoryStream));
+    }
 
     CComPtr<IDxcBlobUtf8> pValErrorUtf8;
     HRESULT valHR = S_OK;
@@ -165,6 +171,76 @@ HRESULT STDMETHODCALLTYPE DxcContainerBuilder::SerializeContainer(_Out_ IDxcOper
   CATCH_CPP_RETURN_HRESULT();
 }
 
+// Serializing rewrites every part, but the dominant use of the builder is to
+// swap a single part - typically the root signature - in an existing
+// container. When every part keeps its fourCC, position and size, the header,
+// offset table and part headers are bit-identical to the loaded bytes, so the
+// original container can be cloned with one block copy and just the replaced
+// payloads patched over it. If no payload was replaced at all, the loaded
+// blob is returned directly without copying. Returns S_FALSE when the layout
+// differs and the caller must reassemble the container from scratch.
+HRESULT DxcContainerBuilder::PatchOriginalContainer(_COM_Outptr_result_maybenull_ IDxcBlob **ppResult) {
+  *ppResult = nullptr;
+  if (m_pContainer == nullptr)
+    return S_FALSE;
+  const DxilContainerHeader *pHeader =
+      (const DxilContainerHeader *)m_pContainer->GetBufferPointer();
+  if (pHeader->PartCount != m_parts.size())
+    return S_FALSE;
+  if (pHeader->ContainerSizeInBytes > m_pContainer->GetBufferSize())
+    return S_FALSE;
+
+  // Pair each part with its original header; any mismatch in fourCC or size
+  // means offsets shift and the fast path does not apply.
+  llvm::SmallVector<const DxilPartHeader *, 8> originalParts;
+  size_t partIdx = 0;
+  for (DxilPartIterator it = begin(pHeader), itEnd = end(pHeader); it != itEnd; ++it, ++partIdx) {
+    const DxilPartHeader *pPartHeader = *it;
+    if (m_parts[partIdx].m_fourCC != pPartHeader->PartFourCC ||
+        m_parts[partIdx].m_Blob->GetBufferSize() != pPartHeader->PartSize)
+      return S_FALSE;
+    originalParts.push_back(pPartHeader);
+  }
+
+  // Parts captured by Load are pinned views of the original bytes, so a
+  // differing payload pointer identifies a replaced part.
+  bool bAnyReplaced = false;
+  for (partIdx = 0; partIdx < m_parts.size(); ++partIdx) {
+    if (m_parts[partIdx].m_Blob->GetBufferPointer() !=
+        (const void *)(originalParts[partIdx] + 1)) {
+      bAnyReplaced = true;
+      break;
+    }
+  }
+  if (!bAnyReplaced) {
+    return m_pContainer->QueryInterface(IID_PPV_ARGS(ppResult));
+  }
+
+  CComPtr<AbstractMemoryStream> pMemoryStream;
+  CComPtr<IDxcBlob> pResult;
+  IFR(CreateMemoryStream(m_pMalloc, &pMemoryStream));
+  IFR(pMemoryStream->QueryInterface(&pResult));
+  UINT32 containerSize = pHeader->ContainerSizeInBytes;
+  IFR(pMemoryStream->Reserve(containerSize));
+  ULONG cbWritten;
+  IFR(pMemoryStream->Write(pHeader, containerSize, &cbWritten));
+  if (cbWritten != containerSize) {
+    return E_FAIL;
+  }
+  LPBYTE pContainerBytes = pMemoryStream->GetPtr();
+  for (partIdx = 0; partIdx < m_parts.size(); ++partIdx) {
+    const void *pOriginalPayload = (const void *)(originalParts[partIdx] + 1);
+    IDxcBlob *pBlob = m_parts[partIdx].m_Blob;
+    if (pBlob->GetBufferPointer() == pOriginalPayload)
+      continue;
+    SIZE_T payloadOffset = (const BYTE *)pOriginalPayload - (const BYTE *)pHeader;
+    memcpy(pContainerBytes + payloadOffset, pBlob->GetBufferPointer(),
+           pBlob->GetBufferSize());
+  }
+  *ppResult = pResult.Detach();
+  return S_OK;
+}
+
 UINT32 DxcContainerBuilder::ComputeContainerSize() {
   UINT32 partsSize = 0;
   for (DxilPart part : m_parts) {
@@ -10,6 +10,9 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "dxc/DxilContainer/DxilContainer.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Compression.h"
 #include <algorithm>
 
 namespace hlsl {
@@ -127,4 +130,29 @@ DxilProgramHeader *GetDxilProgramHeader(DxilContainerHeader *pHeader, DxilFourCC
       GetDxilProgramHeader(static_cast<const DxilContainerHeader *>(pHeader), fourCC));
 }
 
+HRESULT DecompressDxilCompressedPart(const DxilPartHeader *pPart,
+                                     llvm::SmallVectorImpl<char> &Output) {
+  if (pPart == nullptr ||
+      pPart->PartFourCC != DFCC_CompressedShaderDebugInfoDXIL ||
+      pPart->PartSize < sizeof(DxilCompressedPartHeader))
+    return E_INVALIDARG;
+  const DxilCompressedPartHeader *pCompressedHeader =
+      reinterpret_cast<const DxilCompressedPartHeader *>(
+          GetDxilPartData(pPart));
+  if (pCompressedHeader->CompressedSizeInBytes >
+      pPart->PartSize - sizeof(DxilCompressedPartHeader))
+    return E_INVALIDARG;
+  if (!llvm::zlib::isAvailable())
+    return E_NOTIMPL;
+  llvm::StringRef compressed(
+      reinterpret_cast<const char *>(pCompressedHeader + 1),
+      pCompressedHeader->CompressedSizeInBytes);
+  if (llvm::zlib::uncompress(compressed, Output,
+                             pCompressedHeader->UncompressedSizeInBytes) !=
+          llvm::zlib::StatusOK ||
+      Output.size() != pCompressedHeader->UncompressedSizeInBytes)
+    return E_FAIL;
+  return S_OK;
+}
+
 } // namespace hlsl
@@ -9,6 +9,7 @@
 //                                                                           //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/IR/Module.h"
@@ -16,6 +17,7 @@
 #include "llvm/IR/Instructions.h"
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/Support/MD5.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "dxc/DxilContainer/DxilContainer.h"
@@ -31,17 +33,26 @@
 #include "dxc/Support/Unicode.h"
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/Support/FileIOHelper.h"
+#include "llvm/Support/ThreadPool.h"
 #include "dxc/Support/dxcapi.impl.h"
 #include "dxc/DxilContainer/DxilPipelineStateValidation.h"
 #include "dxc/DxilContainer/DxilRuntimeReflection.h"
 #include "dxc/DXIL/DxilCounters.h"
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <unordered_set>
 
 using namespace llvm;
 using namespace hlsl;
 using namespace hlsl::RDAT;
 
+static std::atomic<bool> g_ParallelContainerSerialization(false);
+
+void hlsl::SetDxilContainerParallelSerialization(bool Enabled) {
+  g_ParallelContainerSerialization = Enabled;
+}
+
 static_assert((unsigned)PSVShaderKind::Invalid == (unsigned)DXIL::ShaderKind::Invalid,
               "otherwise, PSVShaderKind enum out of sync.");
 
@@ -892,6 +903,10 @@ public:
     m_rows.push_back(data);
   }
 
+  void Reserve(size_t count) {
+    m_rows.reserve(count);
+  }
+
   void Write(void *ptr) {
     char *pCur = (char*)ptr;
     RuntimeDataTableHeader &header = *reinterpret_cast<RuntimeDataTableHeader*>(pCur);
@@ -955,28 +970,35 @@ struct IndexArraysPart : public RDATPart {
 private:
   std::vector<uint32_t> m_IndexBuffer;
 
-  // Use m_IndexSet with CmpIndices to avoid duplicate index arrays
-  struct CmpIndices {
+  // Use m_IndexSet to avoid duplicate index arrays. Entries are offsets into
+  // m_IndexBuffer where each array is stored as its count followed by its
+  // elements; arrays are hashed and compared by content, so a duplicate
+  // costs one probe instead of a tree walk of full-array comparisons.
+  struct HashIndices {
+    const IndexArraysPart &Table;
+    HashIndices(const IndexArraysPart &table) : Table(table) {}
+    size_t operator()(uint32_t offset) const {
+      const uint32_t *p = Table.m_IndexBuffer.data() + offset;
+      return (size_t)llvm::hash_combine_range(p, p + *p + 1);
+    }
+  };
+  struct EqualIndices {
     const IndexArraysPart &Table;
-    CmpIndices(const IndexArraysPart &table) : Table(table) {}
+    EqualIndices(const IndexArraysPart &table) : Table(table) {}
     bool operator()(uint32_t left, uint32_t right) const {
       const uint32_t *pLeft = Table.m_IndexBuffer.data() + left;
       const uint32_t *pRight = Table.m_IndexBuffer.data() + right;
       if (*pLeft != *pRight)
-        return (*pLeft < *pRight);
-      uint32_t count = *pLeft;
-      for (unsigned i = 0; i < count; i++) {
-        ++pLeft; ++pRight;
-        if (*pLeft != *pRight)
-          return (*pLeft < *pRight);
-      }
-      return false;
+        return false;
+      return std::equal(pLeft + 1, pLeft + 1 + *pLeft, pRight + 1);
     }
   };
-  std::set<uint32_t, CmpIndices> m_IndexSet;
+  std::unordered_set<uint32_t, HashIndices, EqualIndices> m_IndexSet;
 
 public:
-  IndexArraysPart() : m_IndexBuffer(), m_IndexSet(*this) {}
+  IndexArraysPart()
+      : m_IndexBuffer(),
+        m_IndexSet(16, HashIndices(*this), EqualIndices(*this)) {}
   template <class iterator>
   uint32_t AddIndex(iterator begin, iterator end) {
     uint32_t newOffset = m_IndexBuffer.size();
@@ -1101,9 +1123,6 @@ private:
         const llvm::Function *F = FindUsingFunction(user);
         if (!F)
           continue;
-        if (m_FuncToResNameOffset.find(F) == m_FuncToResNameOffset.end()) {
-          m_FuncToResNameOffset[F] = Indices();
-        }
         m_FuncToResNameOffset[F].insert(offset);
       }
     }
@@ -1139,6 +1158,9 @@ private:
   void UpdateResourceInfo(const DxilModule &DM) {
     // Try to allocate string table for resources. String table is a sequence
     // of strings delimited by \0
+    m_pResourceTable->Reserve(DM.GetCBuffers().size() +
+                              DM.GetSamplers().size() + DM.GetSRVs().size() +
+                              DM.GetUAVs().size());
     uint32_t resourceIndex = 0;
     for (auto &resource : DM.GetCBuffers()) {
       InsertToResourceTable(*resource.get(), ResourceClass::CBuffer, resourceIndex);
@@ -1156,14 +1178,11 @@ private:
   }
 
   void UpdateFunctionDependency(llvm::Function *F) {
+    if (F->user_empty())
+      return;
+    uint32_t index = m_pStringBufferPart->Insert(F->getName());
     for (const auto &user : F->users()) {
       const llvm::Function *userFunction = FindUsingFunction(user);
-      uint32_t index = m_pStringBufferPart->Insert(F->getName());
-      if (m_FuncToDependencies.find(userFunction) ==
-          m_FuncToDependencies.end()) {
-        m_FuncToDependencies[userFunction] =
-            Indices();
-      }
       m_FuncToDependencies[userFunction].insert(index);
     }
   }
@@ -1186,6 +1205,12 @@ private:
         }
       }
     }
+    size_t definedFunctionCount = 0;
+    for (auto &function : DM.GetModule()->getFunctionList()) {
+      if (!function.isDeclaration())
+        ++definedFunctionCount;
+    }
+    m_pFunctionTable->Reserve(definedFunctionCount);
     for (auto &function : DM.GetModule()->getFunctionList()) {
       if (!function.isDeclaration()) {
         StringRef mangled = function.getName();
@@ -1199,14 +1224,14 @@ private:
         uint32_t attrSizeInBytes = 0;
         uint32_t shaderKind = static_cast<uint32_t>(DXIL::ShaderKind::Library);
 
-        if (m_FuncToResNameOffset.find(&function) != m_FuncToResNameOffset.end())
-          resourceIndex =
-          m_pIndexArraysPart->AddIndex(m_FuncToResNameOffset[&function].begin(),
-                                  m_FuncToResNameOffset[&function].end());
-        if (m_FuncToDependencies.find(&function) != m_FuncToDependencies.end())
-          functionDependencies =
-              m_pIndexArraysPart->AddIndex(m_FuncToDependencies[&function].begin(),
-                                  m_FuncToDependencies[&function].end());
+        auto resIt = m_FuncToResNameOffset.find(&function);
+        if (resIt != m_FuncToResNameOffset.end())
+          resourceIndex = m_pIndexArraysPart->AddIndex(resIt->second.begin(),
+                                                       resIt->second.end());
+        auto depIt = m_FuncToDependencies.find(&function);
+        if (depIt != m_FuncToDependencies.end())
+          functionDependencies = m_pIndexArraysPart->AddIndex(
+              depIt->second.begin(), depIt->second.end());
         if (DM.HasDxilFunctionProps(&function)) {
           auto props = DM.GetDxilFunctionProps(&function);
           if (props.IsClosestHit() || props.IsAnyHit()) {
@@ -1221,7 +1246,15 @@ private:
           }
           shaderKind = (uint32_t)props.shaderKind;
         }
-        ShaderFlags flags = ShaderFlags::CollectShaderFlags(&function, &DM);
+        // Reuse the per-function flags recorded during module flag
+        // collection; only walk the function body again if this module
+        // never ran collection (e.g. hand-constructed containers).
+        ShaderFlags flags;
+        if (const ShaderFlags *cached =
+                DM.GetCachedFunctionShaderFlags(&function))
+          flags = *cached;
+        else
+          flags = ShaderFlags::CollectShaderFlags(&function, &DM);
         RuntimeDataFunctionInfo info = {};
         info.Name = mangledIndex;
         info.UnmangledName = unmangledIndex;
@@ -1268,6 +1301,7 @@ private:
   void UpdateSubobjectInfo(const DxilModule &DM) {
     if (!DM.GetSubobjects())
       return;
+    m_pSubobjectTable->Reserve(DM.GetSubobjects()->GetSubobjects().size());
     for (auto &it : DM.GetSubobjects()->GetSubobjects()) {
       auto &obj = *it.second;
       RuntimeDataSubobjectInfo info = {};
@@ -1665,21 +1699,69 @@ void hlsl::SerializeDxilContainerForModule(DxilModule *pModule,
   if (bMetadataStripped) {
     pInputProgramStream.Release();
     IFT(CreateMemoryStream(DxcGetThreadMallocNoRef(), &pInputProgramStream));
+    // The stripped module serializes no larger than the input bitcode;
+    // reserving up front avoids growth reallocations during serialization.
+    IFT(pInputProgramStream->Reserve(pModuleBitcode->GetPtrSize()));
     raw_stream_ostream outStream(pInputProgramStream.p);
     WriteBitcodeToFile(pModule->GetModule(), outStream, true);
   }
 
   // If we have debug information present, serialize it to a debug part, then use the stripped version as the canonical program version.
   CComPtr<AbstractMemoryStream> pProgramStream = pInputProgramStream;
+  // Storage for a zlib-compressed debug part; referenced by the part writer
+  // lambda, so it must stay alive until writer.write below.
+  SmallVector<char, 0> compressedDebugPart;
+  DxilCompressedPartHeader compressedDebugHeader = {};
   bool bModuleStripped = false;
   bool bHasDebugInfo = HasDebugInfo(*pModule->GetModule());
   if (bHasDebugInfo) {
     uint32_t debugInUInt32, debugPaddingBytes;
     GetPaddedProgramPartSize(pInputProgramStream, debugInUInt32, debugPaddingBytes);
     if (Flags & SerializeDxilFlags::IncludeDebugInfoPart) {
-      writer.AddPart(DFCC_ShaderDebugInfoDXIL, debugInUInt32 * sizeof(uint32_t) + sizeof(DxilProgramHeader), [&](AbstractMemoryStream *pStream) {
-        WriteProgramPart(pModule->GetShaderModel(), pInputProgramStream, pStream);
-      });
+      bool bCompressedDebugPart = false;
+      if ((Flags & SerializeDxilFlags::CompressDebugInfoPart) != 0 &&
+          llvm::zlib::isAvailable()) {
+        // Serialize the part payload to memory and compress it; fall back to
+        // the raw part when compression fails or does not shrink it.
+        CComPtr<AbstractMemoryStream> pDebugPartStream;
+        IFT(CreateMemoryStream(DxcGetThreadMallocNoRef(), &pDebugPartStream));
+        WriteProgramPart(pModule->GetShaderModel(), pInputProgramStream,
+                         pDebugPartStream);
+        llvm::StringRef uncompressed(
+            (const char *)pDebugPartStream->GetPtr(),
+            pDebugPartStream->GetPtrSize());
+        if (llvm::zlib::compress(uncompressed, compressedDebugPart) ==
+                llvm::zlib::StatusOK &&
+            sizeof(compressedDebugHeader) + compressedDebugPart.size() <
+                uncompressed.size()) {
+          compressedDebugHeader.UncompressedSizeInBytes =
+              (uint32_t)uncompressed.size();
+          compressedDebugHeader.CompressedSizeInBytes =
+              (uint32_t)compressedDebugPart.size();
+          // Keep the part size uint32-aligned like every other part.
+          while (compressedDebugPart.size() % sizeof(uint32_t) != 0)
+            compressedDebugPart.push_back(0);
+          writer.AddPart(
+              DFCC_CompressedShaderDebugInfoDXIL,
+              (uint32_t)(sizeof(compressedDebugHeader) +
+                         compressedDebugPart.size()),
+              [&](AbstractMemoryStream *pStream) {
+                ULONG cbWritten;
+                IFT(WriteStreamValue(pStream, compressedDebugHeader));
+                IFT(pStream->Write(compressedDebugPart.data(),
+                                   (ULONG)compressedDebugPart.size(),
+                                   &cbWritten));
+              });
+          bCompressedDebugPart = true;
+        } else {
+          compressedDebugPart.clear();
+        }
+      }
+      if (!bCompressedDebugPart) {
+        writer.AddPart(DFCC_ShaderDebugInfoDXIL, debugInUInt32 * sizeof(uint32_t) + sizeof(DxilProgramHeader), [&](AbstractMemoryStream *pStream) {
+          WriteProgramPart(pModule->GetShaderModel(), pInputProgramStream, pStream);
+        });
+      }
     }
 
     llvm::StripDebugInfo(*pModule->GetModule());
@@ -1691,6 +1773,36 @@ void hlsl::SerializeDxilContainerForModule(DxilModule *pModule,
     Flags &= ~SerializeDxilFlags::DebugNameDependOnSource;
   }
 
+  // When parallel serialization is enabled, overlap the source-based shader
+  // hash with the clone/strip/re-serialize stages below by queuing it on
+  // the shared thread pool. Hashing reads only the immutable input bitcode
+  // stream, so it is safe beside work that mutates the module; the bitcode
+  // writers themselves stay on this thread because every module here shares
+  // one LLVMContext.
+  DxilShaderHash HashContent;
+  SmallString<32> HashStr;
+  bool bHashNeeded = bSupportsShaderHash || pShaderHashOut ||
+                     ((Flags & SerializeDxilFlags::IncludeDebugNamePart) != 0 &&
+                      DebugName.empty());
+  bool bHashFromSource =
+      (Flags & SerializeDxilFlags::DebugNameDependOnSource) != 0;
+  // The group's destructor waits for the task, covering every exit from
+  // this function including the IFT throws below.
+  ThreadPoolTaskGroup HashTaskGroup;
+  bool bHashComputedAsync = false;
+  if (bHashNeeded && bHashFromSource &&
+      g_ParallelContainerSerialization.load(std::memory_order_relaxed)) {
+    bHashComputedAsync = true;
+    ThreadPool::Get().Async([&]() {
+      llvm::MD5 md5;
+      md5.update(ArrayRef<uint8_t>(pModuleBitcode->GetPtr(),
+                                   pModuleBitcode->GetPtrSize()));
+      HashContent.Flags = (uint32_t)DxilShaderHashFlags::IncludesSource;
+      md5.final(HashContent.Digest);
+      md5.stringifyResult(HashContent.Digest, HashStr);
+    }, ThreadPoolPriority::High, &HashTaskGroup);
+  }
+
   // Clone module for reflection, strip function defs
   std::unique_ptr<Module> reflectionModule;
   if (bEmitReflection) {
@@ -1701,17 +1813,19 @@ void hlsl::SerializeDxilContainerForModule(DxilModule *pModule,
     pModule->ReEmitDxilResources();
     pModule->EmitDxilCounters();
 
-    reflectionModule.reset(llvm::CloneModule(pModule->GetModule()));
+    // Reflection only consumes metadata and global resource symbols, and the
+    // function bodies were previously deleted from the clone anyway. Cloning
+    // functions as declarations up front skips copying every instruction,
+    // which dominates the cost of this clone on large (especially -Zi)
+    // compiles.
+    llvm::ValueToValueMapTy reflectionVMap;
+    reflectionModule.reset(llvm::CloneModule(
+        pModule->GetModule(), reflectionVMap,
+        [](const GlobalValue *GV) { return !isa<Function>(GV); }));
 
     // Now restore validator version on main module and re-emit metadata.
     pModule->SetValidatorVersion(ValMajor, ValMinor);
     pModule->ReEmitDxilResources();
-
-    for (Function &F : reflectionModule->functions()) {
-      if (!F.isDeclaration()) {
-        F.deleteBody();
-      }
-    }
     // Just make sure this doesn't crash/assert on debug build:
     DXASSERT_NOMSG(&reflectionModule->GetOrCreateDxilModule());
   }
@@ -1722,6 +1836,9 @@ void hlsl::SerializeDxilContainerForModule(DxilModule *pModule,
   if (bEmitReflection)
   {
     IFT(CreateMemoryStream(DxcGetThreadMallocNoRef(), &pReflectionBitcodeStream));
+    // The reflection module has function bodies stripped, so the input
+    // bitcode size is a safe upper bound for a single up-front reservation.
+    IFT(pReflectionBitcodeStream->Reserve(pModuleBitcode->GetPtrSize()));
     raw_stream_ostream outStream(pReflectionBitcodeStream.p);
     WriteBitcodeToFile(reflectionModule.get(), outStream, false);
     outStream.flush();
@@ -1762,30 +1879,51 @@ void hlsl::SerializeDxilContainerForModule(DxilModule *pModule,
   if (bModuleStripped) {
     pProgramStream.Release();
     IFT(CreateMemoryStream(DxcGetThreadMallocNoRef(), &pProgramStream));
+    IFT(pProgramStream->Reserve(pInputProgramStream->GetPtrSize()));
     raw_stream_ostream outStream(pProgramStream.p);
     WriteBitcodeToFile(pModule->GetModule(), outStream, false);
   }
 
-  // Compute hash if needed.
-  DxilShaderHash HashContent;
-  SmallString<32> HashStr;
-  if (bSupportsShaderHash || pShaderHashOut ||
-      (Flags & SerializeDxilFlags::IncludeDebugNamePart &&
-        DebugName.empty()))
-  {
-    // If the debug name should be specific to the sources, base the name on the debug
-    // bitcode, which will include the source references, line numbers, etc. Otherwise,
-    // do it exclusively on the target shader bitcode.
-    llvm::MD5 md5;
-    if (Flags & SerializeDxilFlags::DebugNameDependOnSource) {
-      md5.update(ArrayRef<uint8_t>(pModuleBitcode->GetPtr(), pModuleBitcode->GetPtrSize()));
-      HashContent.Flags = (uint32_t)DxilShaderHashFlags::IncludesSource;
+  // Compute the hash if needed. If the debug name should be specific to the
+  // sources, base the name on the debug bitcode, which will include the
+  // source references, line numbers, etc. Otherwise, do it exclusively on
+  // the target shader bitcode. The non-source hash input - the final program
+  // stream - is only complete here, so its task is queued now; the MD5 then
+  // overlaps the container part writes below, since the digest is not
+  // consumed until the DFCC_ShaderHash part is streamed out.
+  auto WaitForHashTask = [&HashTaskGroup]() { HashTaskGroup.Wait(); };
+  if (!bHashComputedAsync && bHashNeeded) {
+    if (!bHashFromSource &&
+        g_ParallelContainerSerialization.load(std::memory_order_relaxed)) {
+      bHashComputedAsync = true;
+      ThreadPool::Get().Async([&]() {
+        llvm::MD5 md5;
+        md5.update(ArrayRef<uint8_t>(pProgramStream->GetPtr(),
+                                     pProgramStream->GetPtrSize()));
+        HashContent.Flags = (uint32_t)DxilShaderHashFlags::None;
+        md5.final(HashContent.Digest);
+        md5.stringifyResult(HashContent.Digest, HashStr);
+      }, ThreadPoolPriority::High, &HashTaskGroup);
     } else {
-      md5.update(ArrayRef<uint8_t>(pProgramStream->GetPtr(), pProgramStream->GetPtrSize()));
-      HashContent.Flags = (uint32_t)DxilShaderHashFlags::None;
+      llvm::MD5 md5;
+      if (bHashFromSource) {
+        md5.update(ArrayRef<uint8_t>(pModuleBitcode->GetPtr(), pModuleBitcode->GetPtrSize()));
+        HashContent.Flags = (uint32_t)DxilShaderHashFlags::IncludesSource;
+      } else {
+        md5.update(ArrayRef<uint8_t>(pProgramStream->GetPtr(), pProgramStream->GetPtrSize()));
+        HashContent.Flags = (uint32_t)DxilShaderHashFlags::None;
+      }
+      md5.final(HashContent.Digest);
+      md5.stringifyResult(HashContent.Digest, HashStr);
     }
-    md5.final(HashContent.Digest);
-    md5.stringifyResult(HashContent.Digest, HashStr);
+  }
+  // The debug name is derived from the hash string, and sizing its part
+  // requires the name, so this is the one consumer that cannot wait for the
+  // part write.
+  if (bHashComputedAsync &&
+      (Flags & SerializeDxilFlags::IncludeDebugNamePart) != 0 &&
+      DebugName.empty()) {
+    WaitForHashTask();
   }
 
   // Serialize debug name if requested.
@@ -1819,21 +1957,20 @@ void hlsl::SerializeDxilContainerForModule(DxilModule *pModule,
     });
   }
 
-  // Add hash to container if supported by validator version.
+  // Add hash to container if supported by validator version. Joining here,
+  // when the part content is actually streamed out, lets an in-flight hash
+  // run beside the feature, signature, PSV and reflection part writes that
+  // precede this part in the container.
   if (bSupportsShaderHash) {
     writer.AddPart(DFCC_ShaderHash, sizeof(HashContent),
-      [HashContent]
+      [&HashContent, &WaitForHashTask]
       (AbstractMemoryStream *pStream)
     {
+      WaitForHashTask();
       IFT(WriteStreamValue(pStream, HashContent));
     });
   }
 
-  // Write hash to separate output if requested.
-  if (pShaderHashOut) {
-    memcpy(pShaderHashOut, &HashContent, sizeof(DxilShaderHash));
-  }
-
   // Compute padded bitcode size.
   uint32_t programInUInt32, programPaddingBytes;
   GetPaddedProgramPartSize(pProgramStream, programInUInt32, programPaddingBytes);
@@ -1844,6 +1981,12 @@ void hlsl::SerializeDxilContainerForModule(DxilModule *pModule,
   });
 
   writer.write(pFinalStream);
+
+  // Write hash to separate output if requested.
+  if (pShaderHashOut) {
+    WaitForHashTask();
+    memcpy(pShaderHashOut, &HashContent, sizeof(DxilShaderHash));
+  }
 }
 
 void hlsl::SerializeDxilContainerForRootSignature(hlsl::RootSignatureHandle *pRootSigHandle,
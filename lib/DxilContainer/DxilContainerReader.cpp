@@ -34,10 +34,29 @@ HRESULT DxilContainerReader::Load(_In_ const void* pContainer, _In_ uint32_t con
   m_pContainer = pContainer;
   m_uContainerSize = containerSizeInBytes;
   m_pHeader = pHeader;
-  
+
+  // Build the part index in one pass over the (now validated) part table.
+  m_partIndex.clear();
+  m_partIndex.reserve(pHeader->PartCount);
+  uint32_t idx = 0;
+  for (DxilPartIterator it = begin(pHeader), itEnd = end(pHeader);
+       it != itEnd; ++it, ++idx) {
+    m_partIndex.push_back(PartEntry{(*it)->PartFourCC, idx});
+  }
+  std::sort(m_partIndex.begin(), m_partIndex.end());
+
   return S_OK;
 }
 
+const DxilContainerReader::PartEntry *
+DxilContainerReader::FindPartEntry(uint32_t kind) const {
+  PartEntry key = {kind, 0};
+  auto it = std::lower_bound(m_partIndex.begin(), m_partIndex.end(), key);
+  if (it == m_partIndex.end() || it->FourCC != kind)
+    return nullptr;
+  return it;
+}
+
 HRESULT DxilContainerReader::GetVersion(_Out_ DxilContainerVersion *pResult) {
   if (pResult == nullptr) return E_POINTER;
   if (!IsLoaded()) return E_NOT_VALID_STATE;
@@ -78,9 +97,32 @@ HRESULT DxilContainerReader::FindFirstPartKind(uint32_t kind, _Out_ uint32_t *pR
   if (pResult == nullptr) return E_POINTER;
   *pResult = 0;
   if (!IsLoaded()) return E_NOT_VALID_STATE;
-  DxilPartIterator it = std::find_if(begin(m_pHeader), end(m_pHeader), DxilPartIsType(kind));
-  *pResult = (it == end(m_pHeader)) ? DXIL_CONTAINER_BLOB_NOT_FOUND : it.index;
+  const PartEntry *pEntry = FindPartEntry(kind);
+  *pResult = pEntry ? pEntry->Index : DXIL_CONTAINER_BLOB_NOT_FOUND;
+  return S_OK;
+}
+
+HRESULT DxilContainerReader::FindFirstPartKinds(llvm::ArrayRef<uint32_t> kinds,
+                                                llvm::MutableArrayRef<uint32_t> results) {
+  if (kinds.size() != results.size()) return E_INVALIDARG;
+  if (!IsLoaded()) return E_NOT_VALID_STATE;
+  for (size_t i = 0; i < kinds.size(); ++i) {
+    const PartEntry *pEntry = FindPartEntry(kinds[i]);
+    results[i] = pEntry ? pEntry->Index : DXIL_CONTAINER_BLOB_NOT_FOUND;
+  }
   return S_OK;
 }
-  
+
+HRESULT DxilContainerReader::GetPartView(uint32_t idx, _Out_ llvm::ArrayRef<uint8_t> *pResult) {
+  if (pResult == nullptr) return E_POINTER;
+  *pResult = llvm::ArrayRef<uint8_t>();
+  if (!IsLoaded()) return E_NOT_VALID_STATE;
+  if (idx >= m_pHeader->PartCount) return E_BOUNDS;
+  const DxilPartHeader *pPart = GetDxilContainerPart(m_pHeader, idx);
+  *pResult = llvm::ArrayRef<uint8_t>(
+      reinterpret_cast<const uint8_t *>(GetDxilPartData(pPart)),
+      pPart->PartSize);
+  return S_OK;
+}
+
 } // namespace hlsl
@@ -0,0 +1,591 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// DxilShaderArchive.cpp                                                     //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Provides support for the dxarc packed shader-archive format.              //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/DxilContainer/DxilShaderArchive.h"
+#include "dxc/Support/FileIOHelper.h"
+#include "dxc/Support/Global.h"
+#include "dxc/Support/WinIncludes.h"
+#include "dxc/dxcapi.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+#include <cstring>
+
+using namespace hlsl;
+
+namespace {
+
+// Part data offsets and verbatim containers are aligned so mapped consumers
+// can read part headers and bitcode without unaligned loads.
+const uint64_t kPartAlignment = 4;
+
+uint64_t AlignTo4(uint64_t value) {
+  return (value + (kPartAlignment - 1)) & ~(kPartAlignment - 1);
+}
+
+// Byte size of the header-plus-offset-table prelude of a container.
+uint32_t ContainerPreludeSize(uint32_t partCount) {
+  return (uint32_t)(sizeof(DxilContainerHeader) +
+                    sizeof(uint32_t) * partCount);
+}
+
+void WriteZeroPad(llvm::raw_ostream &OS, uint64_t from, uint64_t to) {
+  for (uint64_t i = from; i < to; ++i)
+    OS.write('\0');
+}
+
+} // namespace
+
+namespace hlsl {
+
+const DxilArchiveHeader *IsDxilArchiveLike(const void *ptr, uint64_t length) {
+  if (ptr == nullptr || length < sizeof(DxilArchiveHeader))
+    return nullptr;
+  if (DxilArchiveFourCC != *reinterpret_cast<const uint32_t *>(ptr))
+    return nullptr;
+  return reinterpret_cast<const DxilArchiveHeader *>(ptr);
+}
+
+bool IsValidDxilArchive(const DxilArchiveHeader *pHeader, uint64_t length) {
+  if (pHeader == nullptr)
+    return false;
+  if (length < sizeof(DxilArchiveHeader))
+    return false;
+  if (pHeader->HeaderFourCC != DxilArchiveFourCC)
+    return false;
+  if (pHeader->VersionMajor != DxilArchiveVersionMajor)
+    return false;
+  if (pHeader->ArchiveSizeInBytes > length)
+    return false;
+  uint64_t size = pHeader->ArchiveSizeInBytes;
+
+  // Each table must lie within the archive.
+  auto fitsTable = [size](uint64_t offset, uint64_t count,
+                          uint64_t stride) -> bool {
+    uint64_t bytes = count * stride;
+    return offset <= size && bytes <= size - offset;
+  };
+  if (!fitsTable(pHeader->PartTableOffset, pHeader->PartCount,
+                 sizeof(DxilArchivePartEntry)))
+    return false;
+  if (!fitsTable(pHeader->ShaderTableOffset, pHeader->ShaderCount,
+                 sizeof(DxilArchiveShaderEntry)))
+    return false;
+  if (!fitsTable(pHeader->PartRefTableOffset, pHeader->PartRefCount,
+                 sizeof(uint32_t)))
+    return false;
+  if (!fitsTable(pHeader->BucketTableOffset, pHeader->BucketCount,
+                 sizeof(uint32_t)))
+    return false;
+  if (!fitsTable(pHeader->StringTableOffset, pHeader->StringTableSize, 1))
+    return false;
+
+  // The bucket table must be a non-empty power of two when shaders exist,
+  // and the string table must end in a terminator so names are safe to
+  // read as C strings.
+  if (pHeader->ShaderCount != 0) {
+    if (pHeader->BucketCount < pHeader->ShaderCount)
+      return false;
+    if ((pHeader->BucketCount & (pHeader->BucketCount - 1)) != 0)
+      return false;
+    if (pHeader->StringTableSize == 0)
+      return false;
+    const char *pStrings = reinterpret_cast<const char *>(pHeader) +
+                           pHeader->StringTableOffset;
+    if (pStrings[pHeader->StringTableSize - 1] != '\0')
+      return false;
+  }
+
+  // Each part's stored bytes must lie within the archive.
+  const DxilArchivePartEntry *pParts =
+      reinterpret_cast<const DxilArchivePartEntry *>(
+          reinterpret_cast<const uint8_t *>(pHeader) +
+          pHeader->PartTableOffset);
+  for (uint32_t i = 0; i < pHeader->PartCount; ++i) {
+    uint64_t storedSize = sizeof(DxilPartHeader) + (uint64_t)pParts[i].PartSize;
+    if (pParts[i].DataOffset > size || storedSize > size - pParts[i].DataOffset)
+      return false;
+  }
+
+  // Each shader's references and name must lie within their tables, and a
+  // contiguous shader's verbatim container run must lie within the archive:
+  // GetShaderContainer serves a zero-copy view of those bytes, so an
+  // unchecked ContainerOffset would be an out-of-bounds read on a crafted
+  // archive.
+  const DxilArchiveShaderEntry *pShaders =
+      reinterpret_cast<const DxilArchiveShaderEntry *>(
+          reinterpret_cast<const uint8_t *>(pHeader) +
+          pHeader->ShaderTableOffset);
+  const uint32_t *pPartRefs = reinterpret_cast<const uint32_t *>(
+      reinterpret_cast<const uint8_t *>(pHeader) +
+      pHeader->PartRefTableOffset);
+  for (uint32_t i = 0; i < pHeader->ShaderCount; ++i) {
+    const DxilArchiveShaderEntry &shader = pShaders[i];
+    if (shader.FirstPartRef > pHeader->PartRefCount ||
+        shader.NumParts > pHeader->PartRefCount - shader.FirstPartRef)
+      return false;
+    if (shader.NameOffset >= pHeader->StringTableSize)
+      return false;
+    if (shader.Flags & DxilArchiveShaderFlag_Contiguous) {
+      uint64_t containerSize = ContainerPreludeSize(shader.NumParts);
+      for (uint32_t p = 0; p < shader.NumParts; ++p) {
+        uint32_t partIdx = pPartRefs[shader.FirstPartRef + p];
+        if (partIdx >= pHeader->PartCount)
+          return false;
+        containerSize +=
+            sizeof(DxilPartHeader) + (uint64_t)pParts[partIdx].PartSize;
+        // Capping each step keeps the sum far from uint64 overflow.
+        if (containerSize > DxilContainerMaxSize)
+          return false;
+      }
+      if (shader.ContainerOffset > size ||
+          containerSize > size - shader.ContainerOffset)
+        return false;
+    }
+  }
+  return true;
+}
+
+//=============================================================================
+// DxilShaderArchiveWriter.
+
+bool DxilShaderArchiveWriter::PartKey::operator<(const PartKey &other) const {
+  if (FourCC != other.FourCC)
+    return FourCC < other.FourCC;
+  if (Size != other.Size)
+    return Size < other.Size;
+  return memcmp(Hash, other.Hash, DxilContainerHashSize) < 0;
+}
+
+HRESULT DxilShaderArchiveWriter::AddShader(llvm::StringRef name,
+                                           const void *pContainer,
+                                           uint32_t containerSize) {
+  const DxilContainerHeader *pHeader =
+      IsDxilContainerLike(pContainer, containerSize);
+  if (pHeader == nullptr || !IsValidDxilContainer(pHeader, containerSize))
+    return E_INVALIDARG;
+  if (name.empty() || m_shaderIndex.count(name.str()) != 0)
+    return E_INVALIDARG;
+
+  ShaderRecord shader;
+  shader.Name = name.str();
+  shader.Version = pHeader->Version;
+  shader.Hash = pHeader->Hash;
+  shader.PartIndices.reserve(pHeader->PartCount);
+
+  // A container whose parts sit tightly packed right after the offset table,
+  // in table order, reproduces byte for byte when its parts are emitted back
+  // to back behind a recomputed prelude; that is what makes the zero-copy
+  // layout possible, and it is the layout the container assembler produces.
+  const uint32_t *pPartOffsets =
+      reinterpret_cast<const uint32_t *>(pHeader + 1);
+  uint32_t canonicalOffset = ContainerPreludeSize(pHeader->PartCount);
+  bool canonicalLayout = true;
+  shader.OwnsAllParts = true;
+
+  for (uint32_t i = 0; i < pHeader->PartCount; ++i) {
+    const DxilPartHeader *pPart = GetDxilContainerPart(pHeader, i);
+    const uint8_t *pStored = reinterpret_cast<const uint8_t *>(pPart);
+    uint64_t storedSize = sizeof(DxilPartHeader) + pPart->PartSize;
+
+    if (pPartOffsets[i] != canonicalOffset)
+      canonicalLayout = false;
+    canonicalOffset += (uint32_t)storedSize;
+
+    PartKey key;
+    key.FourCC = pPart->PartFourCC;
+    key.Size = pPart->PartSize;
+    llvm::MD5 md5;
+    llvm::MD5::MD5Result digest;
+    md5.update(llvm::ArrayRef<uint8_t>(pStored, storedSize));
+    md5.final(digest);
+    memcpy(key.Hash, digest, DxilContainerHashSize);
+
+    auto inserted = m_partIndex.insert(
+        std::make_pair(key, (uint32_t)m_parts.size()));
+    if (inserted.second) {
+      PartRecord record;
+      record.FourCC = key.FourCC;
+      record.Size = key.Size;
+      memcpy(record.Hash, key.Hash, DxilContainerHashSize);
+      record.Bytes.assign(pStored, pStored + storedSize);
+      m_uniquePartBytes += storedSize;
+      m_parts.push_back(std::move(record));
+    } else {
+      // The part is shared with an earlier shader, so neither container
+      // owns a private run of bytes to serve verbatim.
+      shader.OwnsAllParts = false;
+    }
+    shader.PartIndices.push_back(inserted.first->second);
+  }
+
+  if (!canonicalLayout)
+    shader.OwnsAllParts = false;
+  m_inputBytes += pHeader->ContainerSizeInBytes;
+  m_shaderIndex[shader.Name] = (uint32_t)m_shaders.size();
+  m_shaders.push_back(std::move(shader));
+  return S_OK;
+}
+
+void DxilShaderArchiveWriter::Write(llvm::raw_ostream &OS) const {
+  DxilArchiveHeader header;
+  memset(&header, 0, sizeof(header));
+  header.HeaderFourCC = DxilArchiveFourCC;
+  header.VersionMajor = DxilArchiveVersionMajor;
+  header.VersionMinor = DxilArchiveVersionMinor;
+  header.PartCount = (uint32_t)m_parts.size();
+  header.ShaderCount = (uint32_t)m_shaders.size();
+
+  // Lay out the data region. Shaders that own all of their parts are
+  // emitted as verbatim containers - recomputed prelude, then their parts
+  // back to back - so a mapped reader serves them zero-copy and shaders
+  // that share those parts keep them hot in the page cache. Parts first
+  // introduced by non-verbatim shaders follow in a shared pool.
+  std::vector<uint64_t> partDataOffset(m_parts.size(), 0);
+  std::vector<bool> partPlaced(m_parts.size(), false);
+  std::vector<uint64_t> shaderContainerOffset(m_shaders.size(), 0);
+  std::vector<bool> shaderContiguous(m_shaders.size(), false);
+
+  uint64_t dataOffset = AlignTo4(sizeof(DxilArchiveHeader));
+  const uint64_t dataStart = dataOffset;
+  for (size_t s = 0; s < m_shaders.size(); ++s) {
+    const ShaderRecord &shader = m_shaders[s];
+    if (!shader.OwnsAllParts)
+      continue;
+    dataOffset = AlignTo4(dataOffset);
+    shaderContainerOffset[s] = dataOffset;
+    shaderContiguous[s] = true;
+    uint64_t partOffset =
+        dataOffset + ContainerPreludeSize((uint32_t)shader.PartIndices.size());
+    for (uint32_t partIdx : shader.PartIndices) {
+      partDataOffset[partIdx] = partOffset;
+      partPlaced[partIdx] = true;
+      partOffset += m_parts[partIdx].Bytes.size();
+    }
+    dataOffset = partOffset;
+  }
+  for (size_t p = 0; p < m_parts.size(); ++p) {
+    if (partPlaced[p])
+      continue;
+    dataOffset = AlignTo4(dataOffset);
+    partDataOffset[p] = dataOffset;
+    dataOffset += m_parts[p].Bytes.size();
+  }
+
+  // Build the string table and shader entries.
+  std::string stringTable;
+  std::vector<DxilArchiveShaderEntry> shaderEntries;
+  std::vector<uint32_t> partRefs;
+  shaderEntries.reserve(m_shaders.size());
+  for (size_t s = 0; s < m_shaders.size(); ++s) {
+    const ShaderRecord &shader = m_shaders[s];
+    DxilArchiveShaderEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.NameHash = DxilArchiveHashName(shader.Name);
+    entry.NameOffset = (uint32_t)stringTable.size();
+    entry.FirstPartRef = (uint32_t)partRefs.size();
+    entry.NumParts = (uint32_t)shader.PartIndices.size();
+    if (shaderContiguous[s]) {
+      entry.Flags |= DxilArchiveShaderFlag_Contiguous;
+      entry.ContainerOffset = shaderContainerOffset[s];
+    }
+    entry.ContainerVersion = shader.Version;
+    entry.ContainerHash = shader.Hash;
+    shaderEntries.push_back(entry);
+    stringTable.append(shader.Name);
+    stringTable.push_back('\0');
+    partRefs.insert(partRefs.end(), shader.PartIndices.begin(),
+                    shader.PartIndices.end());
+  }
+
+  // Open-addressed bucket table: power of two with load factor <= 1/2 so
+  // probe sequences stay short; zero marks empty, entries are index + 1.
+  uint32_t bucketCount = 0;
+  std::vector<uint32_t> buckets;
+  if (!m_shaders.empty()) {
+    bucketCount = (uint32_t)llvm::NextPowerOf2(m_shaders.size() * 2 - 1);
+    buckets.assign(bucketCount, 0);
+    for (size_t s = 0; s < shaderEntries.size(); ++s) {
+      uint32_t slot = (uint32_t)(shaderEntries[s].NameHash & (bucketCount - 1));
+      while (buckets[slot] != 0)
+        slot = (slot + 1) & (bucketCount - 1);
+      buckets[slot] = (uint32_t)s + 1;
+    }
+  }
+
+  // Tables follow the data region.
+  uint64_t offset = AlignTo4(dataOffset);
+  header.PartTableOffset = offset;
+  offset += sizeof(DxilArchivePartEntry) * m_parts.size();
+  header.ShaderTableOffset = offset;
+  offset += sizeof(DxilArchiveShaderEntry) * shaderEntries.size();
+  header.PartRefTableOffset = offset;
+  header.PartRefCount = (uint32_t)partRefs.size();
+  offset += sizeof(uint32_t) * partRefs.size();
+  header.BucketTableOffset = offset;
+  header.BucketCount = bucketCount;
+  offset += sizeof(uint32_t) * bucketCount;
+  header.StringTableOffset = offset;
+  header.StringTableSize = stringTable.size();
+  offset += stringTable.size();
+  header.ArchiveSizeInBytes = offset;
+
+  OS.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  uint64_t written = sizeof(header);
+
+  // Data region, in layout order.
+  WriteZeroPad(OS, written, dataStart);
+  written = dataStart;
+  for (size_t s = 0; s < m_shaders.size(); ++s) {
+    if (!shaderContiguous[s])
+      continue;
+    const ShaderRecord &shader = m_shaders[s];
+    WriteZeroPad(OS, written, shaderContainerOffset[s]);
+    written = shaderContainerOffset[s];
+
+    uint32_t partCount = (uint32_t)shader.PartIndices.size();
+    uint32_t containerSize = ContainerPreludeSize(partCount);
+    for (uint32_t partIdx : shader.PartIndices)
+      containerSize += (uint32_t)m_parts[partIdx].Bytes.size();
+
+    DxilContainerHeader containerHeader;
+    memset(&containerHeader, 0, sizeof(containerHeader));
+    containerHeader.HeaderFourCC = DFCC_Container;
+    containerHeader.Hash = shader.Hash;
+    containerHeader.Version = shader.Version;
+    containerHeader.ContainerSizeInBytes = containerSize;
+    containerHeader.PartCount = partCount;
+    OS.write(reinterpret_cast<const char *>(&containerHeader),
+             sizeof(containerHeader));
+
+    uint32_t partOffset = ContainerPreludeSize(partCount);
+    for (uint32_t partIdx : shader.PartIndices) {
+      OS.write(reinterpret_cast<const char *>(&partOffset), sizeof(partOffset));
+      partOffset += (uint32_t)m_parts[partIdx].Bytes.size();
+    }
+    for (uint32_t partIdx : shader.PartIndices) {
+      const PartRecord &part = m_parts[partIdx];
+      OS.write(reinterpret_cast<const char *>(part.Bytes.data()),
+               part.Bytes.size());
+    }
+    written += containerSize;
+  }
+  for (size_t p = 0; p < m_parts.size(); ++p) {
+    if (partPlaced[p])
+      continue;
+    WriteZeroPad(OS, written, partDataOffset[p]);
+    OS.write(reinterpret_cast<const char *>(m_parts[p].Bytes.data()),
+             m_parts[p].Bytes.size());
+    written = partDataOffset[p] + m_parts[p].Bytes.size();
+  }
+
+  // Tables.
+  WriteZeroPad(OS, written, header.PartTableOffset);
+  for (size_t p = 0; p < m_parts.size(); ++p) {
+    DxilArchivePartEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.PartFourCC = m_parts[p].FourCC;
+    entry.PartSize = m_parts[p].Size;
+    entry.DataOffset = partDataOffset[p];
+    memcpy(entry.Hash, m_parts[p].Hash, DxilContainerHashSize);
+    OS.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+  }
+  OS.write(reinterpret_cast<const char *>(shaderEntries.data()),
+           sizeof(DxilArchiveShaderEntry) * shaderEntries.size());
+  OS.write(reinterpret_cast<const char *>(partRefs.data()),
+           sizeof(uint32_t) * partRefs.size());
+  OS.write(reinterpret_cast<const char *>(buckets.data()),
+           sizeof(uint32_t) * buckets.size());
+  OS.write(stringTable.data(), stringTable.size());
+}
+
+//=============================================================================
+// DxilShaderArchiveReader.
+
+HRESULT DxilShaderArchiveReader::Load(const void *pArchive,
+                                      uint64_t archiveSize) {
+  const DxilArchiveHeader *pHeader = IsDxilArchiveLike(pArchive, archiveSize);
+  if (pHeader == nullptr || !IsValidDxilArchive(pHeader, archiveSize))
+    return E_INVALIDARG;
+  m_pArchive = reinterpret_cast<const uint8_t *>(pArchive);
+  m_pHeader = pHeader;
+  m_pParts = reinterpret_cast<const DxilArchivePartEntry *>(
+      m_pArchive + pHeader->PartTableOffset);
+  m_pShaders = reinterpret_cast<const DxilArchiveShaderEntry *>(
+      m_pArchive + pHeader->ShaderTableOffset);
+  m_pPartRefs = reinterpret_cast<const uint32_t *>(
+      m_pArchive + pHeader->PartRefTableOffset);
+  m_pBuckets = reinterpret_cast<const uint32_t *>(
+      m_pArchive + pHeader->BucketTableOffset);
+  m_pStrings = reinterpret_cast<const char *>(
+      m_pArchive + pHeader->StringTableOffset);
+  return S_OK;
+}
+
+uint32_t DxilShaderArchiveReader::GetShaderCount() const {
+  return IsLoaded() ? m_pHeader->ShaderCount : 0;
+}
+
+uint32_t DxilShaderArchiveReader::GetPartCount() const {
+  return IsLoaded() ? m_pHeader->PartCount : 0;
+}
+
+const DxilArchivePartEntry *DxilShaderArchiveReader::GetShaderPart(
+    const DxilArchiveShaderEntry &shader, uint32_t partOrdinal) const {
+  uint32_t partIdx = m_pPartRefs[shader.FirstPartRef + partOrdinal];
+  if (partIdx >= m_pHeader->PartCount)
+    return nullptr;
+  return &m_pParts[partIdx];
+}
+
+HRESULT DxilShaderArchiveReader::FindShader(llvm::StringRef name,
+                                            uint32_t *pIndex) const {
+  if (pIndex == nullptr)
+    return E_INVALIDARG;
+  if (!IsLoaded())
+    return E_NOT_VALID_STATE;
+  if (m_pHeader->ShaderCount == 0)
+    return HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
+
+  uint64_t hash = DxilArchiveHashName(name);
+  uint32_t mask = m_pHeader->BucketCount - 1;
+  uint32_t slot = (uint32_t)(hash & mask);
+  // The writer keeps the table at most half full, so an empty bucket
+  // terminates every probe sequence.
+  for (uint32_t probes = 0; probes <= mask; ++probes) {
+    uint32_t bucket = m_pBuckets[slot];
+    if (bucket == 0)
+      break;
+    const DxilArchiveShaderEntry &shader = m_pShaders[bucket - 1];
+    if (shader.NameHash == hash &&
+        name == llvm::StringRef(m_pStrings + shader.NameOffset)) {
+      *pIndex = bucket - 1;
+      return S_OK;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
+}
+
+HRESULT DxilShaderArchiveReader::GetShaderName(uint32_t shaderIndex,
+                                               const char **ppName) const {
+  if (ppName == nullptr)
+    return E_INVALIDARG;
+  if (!IsLoaded())
+    return E_NOT_VALID_STATE;
+  if (shaderIndex >= m_pHeader->ShaderCount)
+    return E_BOUNDS;
+  *ppName = m_pStrings + m_pShaders[shaderIndex].NameOffset;
+  return S_OK;
+}
+
+HRESULT
+DxilShaderArchiveReader::GetShaderContainerSize(uint32_t shaderIndex,
+                                                uint32_t *pSize) const {
+  if (pSize == nullptr)
+    return E_INVALIDARG;
+  if (!IsLoaded())
+    return E_NOT_VALID_STATE;
+  if (shaderIndex >= m_pHeader->ShaderCount)
+    return E_BOUNDS;
+  const DxilArchiveShaderEntry &shader = m_pShaders[shaderIndex];
+  uint64_t size = ContainerPreludeSize(shader.NumParts);
+  for (uint32_t i = 0; i < shader.NumParts; ++i) {
+    const DxilArchivePartEntry *pPart = GetShaderPart(shader, i);
+    if (pPart == nullptr)
+      return E_FAIL;
+    size += sizeof(DxilPartHeader) + pPart->PartSize;
+  }
+  if (size > DxilContainerMaxSize)
+    return E_FAIL;
+  *pSize = (uint32_t)size;
+  return S_OK;
+}
+
+HRESULT DxilShaderArchiveReader::GetShaderContainer(
+    uint32_t shaderIndex, IMalloc *pMalloc, IDxcBlob **ppContainer) const {
+  if (ppContainer == nullptr)
+    return E_INVALIDARG;
+  *ppContainer = nullptr;
+  uint32_t containerSize;
+  IFR(GetShaderContainerSize(shaderIndex, &containerSize));
+  const DxilArchiveShaderEntry &shader = m_pShaders[shaderIndex];
+  if (pMalloc == nullptr)
+    pMalloc = GetGlobalHeapMalloc();
+
+  if (shader.Flags & DxilArchiveShaderFlag_Contiguous) {
+    // The container bytes exist verbatim in the archive; serve a view.
+    // The caller keeps the archive memory alive for the blob's lifetime,
+    // per the reader contract.
+    CComPtr<IDxcBlobEncoding> pView;
+    IFR(DxcCreateBlob(m_pArchive + shader.ContainerOffset, containerSize,
+                      true /*bPinned*/, false /*bCopy*/,
+                      false /*encodingKnown*/, 0, pMalloc, &pView));
+    return pView.QueryInterface(ppContainer);
+  }
+
+  // Assemble the container from the part store into one allocation.
+  uint8_t *pData = (uint8_t *)pMalloc->Alloc(containerSize);
+  IFROOM(pData);
+
+  DxilContainerHeader *pContainerHeader =
+      reinterpret_cast<DxilContainerHeader *>(pData);
+  memset(pContainerHeader, 0, sizeof(*pContainerHeader));
+  pContainerHeader->HeaderFourCC = DFCC_Container;
+  pContainerHeader->Hash = shader.ContainerHash;
+  pContainerHeader->Version = shader.ContainerVersion;
+  pContainerHeader->ContainerSizeInBytes = containerSize;
+  pContainerHeader->PartCount = shader.NumParts;
+
+  uint32_t *pPartOffsets = reinterpret_cast<uint32_t *>(pContainerHeader + 1);
+  uint32_t partOffset = ContainerPreludeSize(shader.NumParts);
+  for (uint32_t i = 0; i < shader.NumParts; ++i) {
+    const DxilArchivePartEntry *pPart = GetShaderPart(shader, i);
+    uint32_t storedSize = sizeof(DxilPartHeader) + pPart->PartSize;
+    pPartOffsets[i] = partOffset;
+    memcpy(pData + partOffset, m_pArchive + pPart->DataOffset, storedSize);
+    partOffset += storedSize;
+  }
+
+  HRESULT hr = DxcCreateBlobOnMalloc(pData, pMalloc, containerSize, ppContainer);
+  if (FAILED(hr))
+    pMalloc->Free(pData);
+  return hr;
+}
+
+HRESULT DxilShaderArchiveReader::GetShaderPartContent(
+    uint32_t shaderIndex, uint32_t fourCC, IDxcBlob **ppContent) const {
+  if (ppContent == nullptr)
+    return E_INVALIDARG;
+  *ppContent = nullptr;
+  if (!IsLoaded())
+    return E_NOT_VALID_STATE;
+  if (shaderIndex >= m_pHeader->ShaderCount)
+    return E_BOUNDS;
+  const DxilArchiveShaderEntry &shader = m_pShaders[shaderIndex];
+  for (uint32_t i = 0; i < shader.NumParts; ++i) {
+    const DxilArchivePartEntry *pPart = GetShaderPart(shader, i);
+    if (pPart == nullptr)
+      return E_FAIL;
+    if (pPart->PartFourCC != fourCC)
+      continue;
+    CComPtr<IDxcBlobEncoding> pView;
+    IFR(DxcCreateBlob(m_pArchive + pPart->DataOffset + sizeof(DxilPartHeader),
+                      pPart->PartSize, true /*bPinned*/, false /*bCopy*/,
+                      false /*encodingKnown*/, 0, GetGlobalHeapMalloc(),
+                      &pView));
+    return pView.QueryInterface(ppContent);
+  }
+  return HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
+}
+
+} // namespace hlsl
@@ -27,6 +27,9 @@
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Module.h"
 
+#include <algorithm>
+#include <map>
+#include <set>
 #include <unordered_map>
 
 // ValidateDbgDeclare ensures that all of the bits in
@@ -63,11 +66,24 @@ struct dxil_debug_info::LiveVariables::Impl
   using LiveVarsMap =
       std::unordered_map<llvm::DIScope*, VariableInfoMap>;
 
+  // Per-scope variables sorted by declaration line, so that the set of
+  // variables declared at or before a given line is a prefix found with
+  // one binary search.
+  using SortedScopeVars =
+      std::vector<std::pair<unsigned /*Line*/, VariableInfo *>>;
+
   IMalloc *m_pMalloc;
   DxcPixDxilDebugInfo *m_pDxilDebugInfo;
   llvm::Module *m_pModule;
   LiveVarsMap m_LiveVarsDbgDeclare;
 
+  // Lazily built query acceleration state. PIX issues a live-variable
+  // query for every step, and instructions sharing (scope, line) share
+  // the answer, so memoize the full resolved sets.
+  mutable std::unordered_map<llvm::DIScope *, SortedScopeVars> m_SortedVars;
+  mutable std::map<std::pair<llvm::DIScope *, unsigned>,
+                   std::vector<const VariableInfo *>> m_LiveSetCache;
+
   void Init(
       IMalloc *pMalloc,
       DxcPixDxilDebugInfo *pDxilDebugInfo,
@@ -81,6 +97,12 @@ struct dxil_debug_info::LiveVariables::Impl
       llvm::Value *Address,
       unsigned FragmentIndex,
       unsigned FragmentOffsetInBits);
+
+  const SortedScopeVars &SortedVarsForScope(llvm::DIScope *S) const;
+
+  const std::vector<const VariableInfo *> &LiveSetForScopeAndLine(
+      llvm::DIScope *S,
+      unsigned Line) const;
 };
 
 void dxil_debug_info::LiveVariables::Impl::Init(
@@ -199,6 +221,88 @@ dxil_debug_info::VariableInfo* dxil_debug_info::LiveVariables::Impl::AssignValue
   return VarInfo;
 }
 
+const dxil_debug_info::LiveVariables::Impl::SortedScopeVars &
+dxil_debug_info::LiveVariables::Impl::SortedVarsForScope(
+    llvm::DIScope *S) const
+{
+  auto it = m_SortedVars.find(S);
+  if (it != m_SortedVars.end())
+  {
+    return it->second;
+  }
+
+  SortedScopeVars &Sorted = m_SortedVars[S];
+  auto VarsIt = m_LiveVarsDbgDeclare.find(S);
+  if (VarsIt != m_LiveVarsDbgDeclare.end())
+  {
+    Sorted.reserve(VarsIt->second.size());
+    for (const auto &VarAndInfo : VarsIt->second)
+    {
+      Sorted.emplace_back(VarAndInfo.first->getLine(),
+                          VarAndInfo.second.get());
+    }
+    std::stable_sort(
+        Sorted.begin(), Sorted.end(),
+        [](const SortedScopeVars::value_type &LHS,
+           const SortedScopeVars::value_type &RHS) {
+          return LHS.first < RHS.first;
+        });
+  }
+  return Sorted;
+}
+
+const std::vector<const dxil_debug_info::VariableInfo *> &
+dxil_debug_info::LiveVariables::Impl::LiveSetForScopeAndLine(
+    llvm::DIScope *S,
+    unsigned Line) const
+{
+  auto CacheIt = m_LiveSetCache.find(std::make_pair(S, Line));
+  if (CacheIt != m_LiveSetCache.end())
+  {
+    return CacheIt->second;
+  }
+
+  std::vector<const VariableInfo *> LiveVars;
+  std::set<std::string> LiveVarsName;
+
+  const llvm::DITypeIdentifierMap EmptyMap;
+  for (llvm::DIScope *Scope = S; Scope != nullptr;
+       Scope = Scope->getScope().resolve(EmptyMap))
+  {
+    const SortedScopeVars &Sorted = SortedVarsForScope(Scope);
+
+    // Variables declared after Line are defined later in the HLSL
+    // source; binary-search the prefix that is already in scope.
+    auto End = std::upper_bound(
+        Sorted.begin(), Sorted.end(), Line,
+        [](unsigned L, const SortedScopeVars::value_type &Entry) {
+          return L < Entry.first;
+        });
+
+    for (auto VarIt = Sorted.begin(); VarIt != End; ++VarIt)
+    {
+      llvm::StringRef VarName = VarIt->second->m_Variable->getName();
+      if (VarName.empty())
+      {
+        // No name?...
+        continue;
+      }
+      if (!LiveVarsName.insert(VarName).second)
+      {
+        // There's a variable with the same name; use the
+        // previous one instead.
+        continue;
+      }
+
+      LiveVars.emplace_back(VarIt->second);
+    }
+  }
+
+  return m_LiveSetCache
+      .emplace(std::make_pair(S, Line), std::move(LiveVars))
+      .first->second;
+}
+
 dxil_debug_info::LiveVariables::LiveVariables() = default;
 
 dxil_debug_info::LiveVariables::~LiveVariables() = default;
@@ -219,9 +323,6 @@ HRESULT dxil_debug_info::LiveVariables::GetLiveVariablesAtInstruction(
   DXASSERT(IP != nullptr, "else IP should not be nullptr");
   DXASSERT(ppResult != nullptr, "else Result should not be nullptr");
 
-  std::vector<const VariableInfo *> LiveVars;
-  std::set<std::string> LiveVarsName;
-
   const llvm::DebugLoc &DL = IP->getDebugLoc();
 
   if (!DL)
@@ -235,38 +336,11 @@ HRESULT dxil_debug_info::LiveVariables::GetLiveVariablesAtInstruction(
     return E_FAIL;
   }
 
-  const llvm::DITypeIdentifierMap EmptyMap;
-  while (S != nullptr)
-  {
-    auto it = m_pImpl->m_LiveVarsDbgDeclare.find(S);
-    if (it != m_pImpl->m_LiveVarsDbgDeclare.end())
-    {
-      for (const auto &VarAndInfo :  it->second)
-      {
-        auto *Var = VarAndInfo.first;
-        llvm::StringRef VarName = Var->getName();
-        if (Var->getLine() > DL.getLine())
-        {
-          // Defined later in the HLSL source.
-          continue;
-        }
-        if (VarName.empty())
-        {
-          // No name?...
-          continue;
-        }
-        if (!LiveVarsName.insert(VarName).second)
-        {
-          // There's a variable with the same name; use the
-          // previous one instead.
-          continue;
-        }
-
-        LiveVars.emplace_back(VarAndInfo.second.get());
-      }
-    }
-    S = S->getScope().resolve(EmptyMap);
-  }
+  // The live set only depends on the instruction's scope and line, so
+  // resolve it through the memoized per-(scope, line) cache and hand
+  // CreateDxilLiveVariables its own copy.
+  std::vector<const VariableInfo *> LiveVars =
+      m_pImpl->LiveSetForScopeAndLine(S, DL.getLine());
 
   return CreateDxilLiveVariables(
       m_pImpl->m_pDxilDebugInfo,
@@ -93,12 +93,26 @@ STDMETHODIMP dxil_dia::DataSource::loadDataFromIStream(_In_ IStream *pInputIStre
         return E_FAIL;
       const hlsl::DxilPartHeader *PartHeader =
         hlsl::GetDxilPartByType(pContainerHeader, hlsl::DFCC_ShaderDebugInfoDXIL);
-      if (!PartHeader)
-        return E_FAIL;
-      CComPtr<IDxcBlobEncoding> pPinnedBlob;
-      IFR(hlsl::DxcCreateBlobWithEncodingFromPinned(PartHeader+1, PartHeader->PartSize, CP_ACP, &pPinnedBlob));
-      pIStream.Release();
-      IFR(hlsl::CreateReadOnlyBlobStream(pPinnedBlob, &pIStream));
+      if (PartHeader) {
+        CComPtr<IDxcBlobEncoding> pPinnedBlob;
+        IFR(hlsl::DxcCreateBlobWithEncodingFromPinned(PartHeader+1, PartHeader->PartSize, CP_ACP, &pPinnedBlob));
+        pIStream.Release();
+        IFR(hlsl::CreateReadOnlyBlobStream(pPinnedBlob, &pIStream));
+      } else {
+        // The debug part may have been emitted zlib-compressed.
+        const hlsl::DxilPartHeader *pCompressedPart = hlsl::GetDxilPartByType(
+            pContainerHeader, hlsl::DFCC_CompressedShaderDebugInfoDXIL);
+        if (!pCompressedPart)
+          return E_FAIL;
+        llvm::SmallVector<char, 1024> decompressed;
+        IFR(hlsl::DecompressDxilCompressedPart(pCompressedPart, decompressed));
+        CComPtr<IDxcBlobEncoding> pDecompressedBlob;
+        IFR(hlsl::DxcCreateBlobWithEncodingOnHeapCopy(
+            decompressed.data(), (UINT32)decompressed.size(), CP_ACP,
+            &pDecompressedBlob));
+        pIStream.Release();
+        IFR(hlsl::CreateReadOnlyBlobStream(pDecompressedBlob, &pIStream));
+      }
     }
 
     m_context.reset();
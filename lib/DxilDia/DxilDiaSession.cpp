@@ -100,12 +100,10 @@ void dxil_dia::Session::Init(
     DXASSERT(m_rvaMap[It->second] == It->first, "instruction mapped to wrong rva");
   }
 
-  // Initialize symbols
-  try {
-      m_symsMgr.Init(this);
-  } catch (const hlsl::Exception &) {
-      m_symsMgr = std::move(dxil_dia::SymbolManager());
-  }
+  // Initialize symbols. The manager only records the session here; the
+  // debug metadata walk happens on the first symbol query, and a failed walk
+  // surfaces as E_FAIL from that query.
+  m_symsMgr.Init(this);
 }
 
 HRESULT dxil_dia::Session::getSourceFileIdByName(
@@ -126,6 +124,34 @@ HRESULT dxil_dia::Session::getSourceFileIdByName(
   return S_FALSE;
 }
 
+HRESULT dxil_dia::Session::findInstructionsByRVA(
+    DWORD rva,
+    DWORD length,
+    std::vector<const llvm::Instruction *> &instructions) {
+  auto cacheKey = std::make_pair(rva, length);
+  auto cached = m_rvaQueryCache.find(cacheKey);
+  if (cached != m_rvaQueryCache.end()) {
+    instructions = cached->second;
+    return S_OK;
+  }
+
+  // m_instructions is keyed on RVA, so a single lower_bound positions the
+  // walk at the start of the range instead of one lookup per RVA.
+  auto It = m_instructions.lower_bound(rva);
+  for (DWORD i = rva; i < rva + length; ++i, ++It) {
+    if (It == m_instructions.end() || It->first != i)
+      return E_INVALIDARG;
+
+    // Only include the instruction if it has debug info for line mappings.
+    const llvm::Instruction *inst = It->second;
+    if (inst->getDebugLoc())
+      instructions.push_back(inst);
+  }
+
+  m_rvaQueryCache.emplace(cacheKey, instructions);
+  return S_OK;
+}
+
 STDMETHODIMP dxil_dia::Session::get_loadAddress(
     /* [retval][out] */ ULONGLONG *pRetVal) {
   *pRetVal = 0;
@@ -235,20 +261,9 @@ static HRESULT DxcDiaFindLineNumbersByRVA(
   if (!ppResult)
     return E_POINTER;
 
+  // Gather the list of instructions that map to the given rva range.
   std::vector<const llvm::Instruction*> instructions;
-  auto &allInstructions = pSession->InstructionsRef();
-
-  // Gather the list of insructions that map to the given rva range.
-  for (DWORD i = rva; i < rva + length; ++i) {
-    auto It = allInstructions.find(i);
-    if (It == allInstructions.end())
-      return E_INVALIDARG;
-
-    // Only include the instruction if it has debug info for line mappings.
-    const llvm::Instruction *inst = It->second;
-    if (inst->getDebugLoc())
-      instructions.push_back(inst);
-  }
+  IFR(pSession->findInstructionsByRVA(rva, length, instructions));
 
   // Create line number table from explicit instruction list.
   IMalloc *pMalloc = pSession->GetMallocNoRef();
@@ -16,6 +16,7 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "dia2.h"
@@ -71,6 +72,12 @@ public:
 
   HRESULT getSourceFileIdByName(llvm::StringRef fileName, DWORD *pRetVal);
 
+  // Gathers the instructions with line info in [rva, rva + length), memoizing
+  // the result per range - stepping in a debugger replays the same ranges
+  // many times. The module is immutable after Init, so entries never go stale.
+  HRESULT findInstructionsByRVA(DWORD rva, DWORD length,
+                                std::vector<const llvm::Instruction *> &instructions);
+
   HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) {
     return DoBasicQueryInterface<IDiaSession, IDxcPixDxilDebugInfoFactory>(this, iid, ppvObject);
   }
@@ -396,6 +403,8 @@ private:
   std::vector<const llvm::Instruction *> m_instructionLines; // Instructions with line info.
   std::unordered_map<const llvm::Instruction *, RVA> m_rvaMap; // Map instruction to its RVA.
   LineToInfoMap m_lineToInfoMap;
+  // Successful findInstructionsByRVA gathers, keyed by (rva, length).
+  std::map<std::pair<DWORD, DWORD>, std::vector<const llvm::Instruction *>> m_rvaQueryCache;
   SymbolManager m_symsMgr;
 
 private:
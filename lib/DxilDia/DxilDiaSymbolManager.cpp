@@ -2063,6 +2063,34 @@ dxil_dia::SymbolManager::~SymbolManager() {
 void dxil_dia::SymbolManager::Init(Session *pSes) {
   DXASSERT(m_pSession == nullptr, "SymbolManager already initialized");
   m_pSession = pSes;
+  // The debug metadata walk is deferred to EnsureSymbolsBuilt so that
+  // sessions which never query symbols do not pay for it.
+}
+
+HRESULT dxil_dia::SymbolManager::EnsureSymbolsBuilt() const {
+  if (m_symbolsBuilt) {
+    return m_symbolsBuildFailed ? E_FAIL : S_OK;
+  }
+
+  // The build populates the factory vector and index maps but does not change
+  // the manager's observable state, so it is safe to run behind const queries.
+  auto *self = const_cast<SymbolManager *>(this);
+  self->m_symbolsBuilt = true;
+  try {
+    self->BuildSymbols();
+  } catch (const hlsl::Exception &) {
+    self->m_symbolCtors.clear();
+    self->m_scopeToID.clear();
+    self->m_symbolToLiveRange.clear();
+    self->m_parentToChildren.clear();
+    self->m_symbolsBuildFailed = true;
+    return E_FAIL;
+  }
+  return S_OK;
+}
+
+void dxil_dia::SymbolManager::BuildSymbols() {
+  Session *pSes = m_pSession;
   m_symbolCtors.clear();
   m_parentToChildren.clear();
 
@@ -2146,6 +2174,13 @@ void dxil_dia::SymbolManager::Init(Session *pSes) {
   IFT(SMI.PopulateParentToChildrenIDMap(&m_parentToChildren));
 }
 
+size_t dxil_dia::SymbolManager::NumSymbols() const {
+  if (FAILED(EnsureSymbolsBuilt())) {
+    return 0;
+  }
+  return m_symbolCtors.size();
+}
+
 HRESULT dxil_dia::SymbolManager::GetSymbolByID(size_t id, Symbol **ppSym) const {
   if (ppSym == nullptr) {
     return E_INVALIDARG;
@@ -2155,6 +2190,7 @@ HRESULT dxil_dia::SymbolManager::GetSymbolByID(size_t id, Symbol **ppSym) const
   if (m_pSession == nullptr) {
     return E_FAIL;
   }
+  IFR(EnsureSymbolsBuilt());
 
   if (id <= 0) {
     return E_INVALIDARG;
@@ -2169,6 +2205,7 @@ HRESULT dxil_dia::SymbolManager::GetSymbolByID(size_t id, Symbol **ppSym) const
 }
 
 HRESULT dxil_dia::SymbolManager::GetLiveRangeOf(Symbol *pSym, LiveRange *LR) const {
+  IFR(EnsureSymbolsBuilt());
   const DWORD dwSymID = pSym->GetID();
   if (dwSymID <= 0 || dwSymID > m_symbolCtors.size()) {
     return E_INVALIDARG;
@@ -2187,6 +2224,7 @@ HRESULT dxil_dia::SymbolManager::GetGlobalScope(Symbol **ppSym) const {
 }
 
 HRESULT dxil_dia::SymbolManager::ChildrenOf(DWORD ID, std::vector<CComPtr<Symbol>> *pChildren) const {
+  IFR(EnsureSymbolsBuilt());
   pChildren->clear();
   auto childrenList = m_parentToChildren.equal_range(ID);
   for (auto it = childrenList.first; it != childrenList.second; ++it) {
@@ -2205,6 +2243,7 @@ HRESULT dxil_dia::SymbolManager::ChildrenOf(Symbol *pSym, std::vector<CComPtr<Sy
 
 HRESULT dxil_dia::SymbolManager::DbgScopeOf(const llvm::Instruction *instr, SymbolChildrenEnumerator **ppRet) const {
   *ppRet = nullptr;
+  IFR(EnsureSymbolsBuilt());
 
   const llvm::DebugLoc &DL = instr->getDebugLoc();
   if (!DL) {
@@ -66,7 +66,7 @@ public:
 
   void Init(Session *pSes);
 
-  size_t NumSymbols() const { return m_symbolCtors.size(); }
+  size_t NumSymbols() const;
   HRESULT GetSymbolByID(size_t id, Symbol **ppSym) const;
   HRESULT GetLiveRangeOf(Symbol *pSym, LiveRange *LR) const;
   HRESULT GetGlobalScope(Symbol **ppSym) const;
@@ -76,9 +76,21 @@ public:
 private:
   HRESULT ChildrenOf(DWORD ID, std::vector<CComPtr<Symbol>> *pChildren) const;
 
+  // Builds the symbol factories and index maps by walking the module's debug
+  // metadata. This is expensive, so it is deferred until the first query that
+  // needs a symbol; sessions opened only for line tables or source never pay
+  // for it.
+  HRESULT EnsureSymbolsBuilt() const;
+  void BuildSymbols();
+
   // Not a CComPtr, and not AddRef'd - m_pSession is the owner of this.
   Session *m_pSession = nullptr;
 
+  // Whether BuildSymbols has run, and whether it failed; queries against a
+  // failed build keep returning E_FAIL rather than retrying the walk.
+  bool m_symbolsBuilt = false;
+  bool m_symbolsBuildFailed = false;
+
   // Vector of factories for all symbols in the DXIL module.
   std::vector<std::unique_ptr<SymbolFactory>> m_symbolCtors;
 
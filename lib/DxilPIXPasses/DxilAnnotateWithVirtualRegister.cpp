@@ -79,15 +79,24 @@ private:
   void PrintSingleRegister(llvm::Instruction* pI, uint32_t Register);
   void AssignNewAllocaRegister(llvm::AllocaInst* pAlloca, std::uint32_t C);
   void PrintAllocaMember(llvm::AllocaInst* pAlloca, uint32_t Base, uint32_t Offset);
+  std::uint32_t CountMembersCached(llvm::Type const *pType);
+  uint32_t GetStructOffset(llvm::GetElementPtrInst *pGEP,
+                           uint32_t &GEPOperandIndex,
+                           llvm::Type *pElementType);
 
   hlsl::DxilModule* m_DM;
   std::uint32_t m_uVReg;
   std::unique_ptr<llvm::ModuleSlotTracker> m_MST;
+  // Flattened-member counts per type. Every store through a GEP sums the
+  // counts of all preceding members, so without memoization large payload
+  // structs are recounted once per member per store.
+  llvm::DenseMap<llvm::Type const *, std::uint32_t> m_MemberCounts;
   void Init(llvm::Module &M) {
     m_DM = &M.GetOrCreateDxilModule();
     m_uVReg = 0;
     m_MST.reset(new llvm::ModuleSlotTracker(&M));
     m_MST->incorporateFunction(*m_DM->GetEntryFunction());
+    m_MemberCounts.clear();
   }
 };
 
@@ -170,7 +179,18 @@ void DxilAnnotateWithVirtualRegister::AnnotateStore(llvm::Instruction *pI) {
   PixAllocaRegWrite::AddMD(m_DM->GetCtx(), pSt, AllocaReg, Index);
 }
 
-static uint32_t GetStructOffset(
+std::uint32_t DxilAnnotateWithVirtualRegister::CountMembersCached(
+    llvm::Type const *pType) {
+  auto it = m_MemberCounts.find(pType);
+  if (it != m_MemberCounts.end()) {
+    return it->second;
+  }
+  uint32_t Count = CountStructMembers(pType);
+  m_MemberCounts[pType] = Count;
+  return Count;
+}
+
+uint32_t DxilAnnotateWithVirtualRegister::GetStructOffset(
   llvm::GetElementPtrInst* pGEP,
   uint32_t& GEPOperandIndex,
   llvm::Type* pElementType)
@@ -201,7 +221,7 @@ static uint32_t GetStructOffset(
 
     uint32_t ArrayIndex = pArrayIndex->getLimitedValue();
     auto pArrayElementType = pArray->getArrayElementType();
-    uint32_t MemberIndex = ArrayIndex * CountStructMembers(pArrayElementType);
+    uint32_t MemberIndex = ArrayIndex * CountMembersCached(pArrayElementType);
     return MemberIndex + GetStructOffset(pGEP, GEPOperandIndex, pArrayElementType);
   }
   else if (auto* pStruct = llvm::dyn_cast<llvm::StructType>(pElementType))
@@ -220,7 +240,7 @@ static uint32_t GetStructOffset(
     uint32_t MemberOffset = 0;
     for (uint32_t i = 0; i < MemberIndex; ++i)
     {
-      MemberOffset += CountStructMembers(pStruct->getElementType(i));
+      MemberOffset += CountMembersCached(pStruct->getElementType(i));
     }
 
     return MemberOffset +
@@ -259,7 +279,7 @@ bool DxilAnnotateWithVirtualRegister::IsAllocaRegisterWrite(
         uint64_t memberIndex = pStructMember->getLimitedValue();
         for(uint64_t i = 0; i < memberIndex; ++i)
         {
-          precedingMemberCount += CountStructMembers(pStructType->getStructElementType(i));
+          precedingMemberCount += CountMembersCached(pStructType->getStructElementType(i));
         }
       }
       else
@@ -229,6 +229,12 @@ private:
       llvm::Module &M,
       llvm::DbgValueInst *DbgValue);
 
+  // One VariableRegisters per variable, built on the first dbg.value that
+  // mentions it and reused for every later one, so each variable's DIType is
+  // decomposed into allocas exactly once per run. The cache cannot be keyed
+  // by DIType instead: building a VariableRegisters emits the allocas and
+  // dbg.declare for that specific variable, so two variables of the same
+  // type share nothing reusable.
   std::unordered_map<llvm::DIVariable *, std::unique_ptr<VariableRegisters>> m_Registers;
 };
 }  // namespace
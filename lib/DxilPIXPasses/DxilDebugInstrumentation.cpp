@@ -236,6 +236,13 @@ private:
     IRBuilder<> &Builder;
   };
 
+  // Instruction-number range selected for instrumentation. Instructions
+  // outside [first, last) receive no step instrumentation at all, so the
+  // debugger can restrict tracing to the source region of interest rather
+  // than paying a UAV write for every instruction in the shader.
+  unsigned m_FirstInstruction = 0;
+  unsigned m_LastInstruction = static_cast<unsigned>(-1);
+
   uint32_t m_RemainingReservedSpaceInBytes = 0;
   Value *m_CurrentIndex = nullptr;
 
@@ -262,6 +269,7 @@ private:
   void addDebugEntryValue(BuilderContext &BC, Value *TheValue);
   void addInvocationStartMarker(BuilderContext &BC);
   void reserveDebugEntrySpace(BuilderContext &BC, uint32_t SpaceInDwords);
+  bool InstructionIsOfInterest(std::uint32_t InstNum);
   void addStoreStepDebugEntry(BuilderContext &BC, StoreInst *Inst);
   void addStepDebugEntry(BuilderContext &BC, Instruction *Inst);
   void addStepDebugEntryValue(BuilderContext &BC, std::uint32_t InstNum,
@@ -280,6 +288,13 @@ void DxilDebugInstrumentation::applyOptions(PassOptions O) {
   GetPassOptionUnsigned(O, "parameter1", &m_Parameters.Parameters[1], 0);
   GetPassOptionUnsigned(O, "parameter2", &m_Parameters.Parameters[2], 0);
   GetPassOptionUInt64(O, "UAVSize", &m_UAVSize, 1024 * 1024);
+  GetPassOptionUnsigned(O, "FirstInstruction", &m_FirstInstruction, 0);
+  GetPassOptionUnsigned(O, "LastInstruction", &m_LastInstruction,
+                        static_cast<unsigned>(-1));
+}
+
+bool DxilDebugInstrumentation::InstructionIsOfInterest(std::uint32_t InstNum) {
+  return InstNum >= m_FirstInstruction && InstNum < m_LastInstruction;
 }
 
 uint32_t DxilDebugInstrumentation::UAVDumpingGroundOffset() {
@@ -854,6 +869,10 @@ void DxilDebugInstrumentation::addStepDebugEntry(BuilderContext &BC,
 void DxilDebugInstrumentation::addStepDebugEntryValue(
     BuilderContext &BC, std::uint32_t InstNum, Value *V,
     std::uint32_t ValueOrdinal, Value *ValueOrdinalIndex) {
+  if (!InstructionIsOfInterest(InstNum)) {
+    return;
+  }
+
   const Type::TypeID ID = V->getType()->getTypeID();
 
   switch (ID) {
@@ -975,6 +994,14 @@ bool DxilDebugInstrumentation::runOnModule(Module &M) {
         break;
       }
       PHINode &PN = llvm::cast<PHINode>(Inst);
+
+      // Don't split edges for phis that won't be instrumented anyway:
+      std::uint32_t InstNum;
+      if (!pix_dxil::PixDxilInstNum::FromInst(&PN, &InstNum) ||
+          !InstructionIsOfInterest(InstNum)) {
+        continue;
+      }
+
       for (unsigned i = 0, e = PN.getNumIncomingValues(); i != e; ++i) {
         BasicBlock *PhiBB = PN.getIncomingBlock(i);
         Value *PhiVal = PN.getIncomingValue(i);
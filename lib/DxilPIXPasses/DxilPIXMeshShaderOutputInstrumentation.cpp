@@ -19,10 +19,15 @@
 #include "dxc/HLSL/DxilGenerationPass.h"
 #include "dxc/HLSL/DxilSpanAllocator.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/Transforms/Utils/Local.h"
 #include <deque>
+#include <map>
+#include <tuple>
+#include <vector>
 
 #ifdef _WIN32
 #include <winerror.h>
@@ -63,6 +68,10 @@ private:
   Constant *m_OffsetMask = nullptr;
 
   uint64_t m_UAVSize = 1024 * 1024;
+  // Compacted mode: dedup repeated writes to the same attribute within a
+  // basic block and reserve UAV space once per block instead of once per
+  // record, so dense meshlets don't flood the capture buffer with atomics.
+  bool m_CompactRecords = false;
 
   struct BuilderContext {
     Module &M;
@@ -72,6 +81,11 @@ private:
     IRBuilder<> &Builder;
   };
 
+  struct RecordSite {
+    CallInst *Call;
+    uint32_t Tag;
+  };
+
   CallInst *addUAV(BuilderContext &BC);
   Value *insertInstructionsToCalculateFlattenedGroupIdXandY(BuilderContext &BC);
   Value *insertInstructionsToCalculateGroupIdZ(BuilderContext &BC);
@@ -79,12 +93,18 @@ private:
   uint32_t UAVDumpingGroundOffset();
   Value *writeDwordAndReturnNewOffset(BuilderContext &BC, Value *TheOffset,
                                       Value *TheValue);
-  template <typename... T> void Instrument(BuilderContext &BC, T... values);
+  SmallVector<Value *, 10> buildRecordValues(BuilderContext &BC, CallInst *Call,
+                                             uint32_t Tag, Value *GroupIdXandY,
+                                             Value *GroupIdZ);
+  void Instrument(BuilderContext &BC, ArrayRef<Value *> Values);
+  void emitCompactedRecords(BuilderContext &BC, ArrayRef<RecordSite> Block,
+                            Value *GroupIdXandY, Value *GroupIdZ);
 };
 
-void DxilPIXMeshShaderOutputInstrumentation::applyOptions(PassOptions O) 
+void DxilPIXMeshShaderOutputInstrumentation::applyOptions(PassOptions O)
 {
   GetPassOptionUInt64(O, "UAVSize", &m_UAVSize, 1024 * 1024);
+  GetPassOptionBool(O, "compact-records", &m_CompactRecords, false);
 }
 
 uint32_t DxilPIXMeshShaderOutputInstrumentation::UAVDumpingGroundOffset() 
@@ -246,12 +266,64 @@ Value *DxilPIXMeshShaderOutputInstrumentation::writeDwordAndReturnNewOffset(
       BC.HlslOP->GetU32Const(static_cast<unsigned int>(sizeof(uint32_t))));
 }
 
-template <typename... T>
+// Build the dword list for one record, inserting any coercion casts at the
+// builder's insertion point (the instrumented call).
+SmallVector<Value *, 10> DxilPIXMeshShaderOutputInstrumentation::buildRecordValues(
+    BuilderContext &BC, CallInst *Call, uint32_t Tag, Value *GroupIdXandY,
+    Value *GroupIdZ)
+{
+  if (Tag == triangleIndexIndicator)
+  {
+    return SmallVector<Value *, 10>{
+        BC.HlslOP->GetI32Const(triangleIndexIndicator), GroupIdXandY, GroupIdZ,
+        Call->getOperand(1), Call->getOperand(2), Call->getOperand(3),
+        Call->getOperand(4)};
+  }
+
+  // Expand column index to 32 bits:
+  auto ColumnIndex = BC.Builder.CreateCast(
+    Instruction::ZExt,
+    Call->getOperand(3),
+    Type::getInt32Ty(BC.Ctx));
+
+  // Coerce actual value to int32
+  Value *CoercedValue = Call->getOperand(4);
+
+  if (Tag == floatValueIndicator)
+  {
+    CoercedValue = BC.Builder.CreateCast(
+      Instruction::BitCast,
+      CoercedValue,
+      Type::getInt32Ty(BC.Ctx));
+  }
+  else if (Tag == float16ValueIndicator)
+  {
+    auto * HalfInt = BC.Builder.CreateCast(
+      Instruction::BitCast,
+      CoercedValue,
+      Type::getInt16Ty(BC.Ctx));
+
+    CoercedValue = BC.Builder.CreateCast(
+      Instruction::ZExt,
+      HalfInt,
+      Type::getInt32Ty(BC.Ctx));
+  }
+  else if (Tag == int16ValueIndicator)
+  {
+    CoercedValue = BC.Builder.CreateCast(
+      Instruction::ZExt,
+      CoercedValue,
+      Type::getInt32Ty(BC.Ctx));
+  }
+
+  return SmallVector<Value *, 10>{
+      BC.HlslOP->GetI32Const(Tag), GroupIdXandY, GroupIdZ, Call->getOperand(1),
+      Call->getOperand(2), ColumnIndex, CoercedValue, Call->getOperand(5)};
+}
+
 void DxilPIXMeshShaderOutputInstrumentation::Instrument(BuilderContext &BC,
-                                                        T... values)
+                                                        ArrayRef<Value *> Values)
 {
-  llvm::SmallVector<llvm::Value *, 10> Values(
-      {static_cast<llvm::Value *>(values)...});
   const uint32_t DwordCount = Values.size();
   llvm::Value *byteOffset =
       reserveDebugEntrySpace(BC, DwordCount * sizeof(uint32_t));
@@ -261,6 +333,65 @@ void DxilPIXMeshShaderOutputInstrumentation::Instrument(BuilderContext &BC,
   }
 }
 
+// Compacted emission for the record sites of one basic block: repeated
+// writes to the same attribute keep only the last record (the value the
+// output actually ends up with), and the block's survivors share a single
+// atomic reservation placed at the first surviving site. Within a basic
+// block the first site executing implies the rest do too, so the batched
+// reservation is always fully consumed.
+void DxilPIXMeshShaderOutputInstrumentation::emitCompactedRecords(
+    BuilderContext &BC, ArrayRef<RecordSite> Block, Value *GroupIdXandY,
+    Value *GroupIdZ)
+{
+  // Key identifying the written attribute: indicator plus, for vertex
+  // output, signature id/row/column/vertex; for indices, the primitive
+  // index. Unused slots stay null.
+  typedef std::tuple<uint32_t, Value *, Value *, Value *, Value *> AttributeKey;
+  auto keyForSite = [](const RecordSite &Site) -> AttributeKey {
+    CallInst *Call = Site.Call;
+    if (Site.Tag == triangleIndexIndicator)
+      return AttributeKey(triangleIndexIndicator, Call->getOperand(1), nullptr,
+                          nullptr, nullptr);
+    return AttributeKey(Site.Tag, Call->getOperand(1), Call->getOperand(2),
+                        Call->getOperand(3), Call->getOperand(5));
+  };
+
+  std::map<AttributeKey, size_t> lastWrite;
+  for (size_t i = 0; i < Block.size(); ++i)
+    lastWrite[keyForSite(Block[i])] = i;
+
+  uint32_t TotalBytes = 0;
+  SmallVector<const RecordSite *, 8> Survivors;
+  for (size_t i = 0; i < Block.size(); ++i)
+  {
+    const RecordSite &Site = Block[i];
+    if (lastWrite[keyForSite(Site)] != i)
+      continue;
+    Survivors.push_back(&Site);
+    const uint32_t DwordCount = Site.Tag == triangleIndexIndicator ? 7 : 8;
+    TotalBytes += DwordCount * sizeof(uint32_t);
+  }
+
+  if (Survivors.empty())
+    return;
+
+  IRBuilder<> ReserveBuilder(Survivors.front()->Call);
+  BuilderContext ReserveBC{BC.M, BC.DM, BC.Ctx, BC.HlslOP, ReserveBuilder};
+  Value *byteOffset = reserveDebugEntrySpace(ReserveBC, TotalBytes);
+
+  for (const RecordSite *Site : Survivors)
+  {
+    IRBuilder<> Builder2(Site->Call);
+    BuilderContext BC2{BC.M, BC.DM, BC.Ctx, BC.HlslOP, Builder2};
+    auto Values =
+        buildRecordValues(BC2, Site->Call, Site->Tag, GroupIdXandY, GroupIdZ);
+    for (Value *V : Values)
+    {
+      byteOffset = writeDwordAndReturnNewOffset(BC2, byteOffset, V);
+    }
+  }
+}
+
 bool DxilPIXMeshShaderOutputInstrumentation::runOnModule(Module &M)
 {
   DxilModule &DM = M.GetOrCreateDxilModule();
@@ -280,22 +411,11 @@ bool DxilPIXMeshShaderOutputInstrumentation::runOnModule(Module &M)
   auto GroupIdXandY = insertInstructionsToCalculateFlattenedGroupIdXandY(BC);
   auto GroupIdZ = insertInstructionsToCalculateGroupIdZ(BC);
 
-  auto F = HlslOP->GetOpFunc(DXIL::OpCode::EmitIndices, Type::getVoidTy(Ctx));
-  auto FunctionUses = F->uses();
-  for (auto FI = FunctionUses.begin(); FI != FunctionUses.end();)
-  {
-    auto &FunctionUse = *FI++;
-    auto FunctionUser = FunctionUse.getUser();
-
-    auto Call = cast<CallInst>(FunctionUser);
-
-    IRBuilder<> Builder2(Call);
-    BuilderContext BC2{M, DM, Ctx, HlslOP, Builder2};
-
-    Instrument(BC2, BC2.HlslOP->GetI32Const(triangleIndexIndicator),
-               GroupIdXandY, GroupIdZ, Call->getOperand(1),
-               Call->getOperand(2), Call->getOperand(3), Call->getOperand(4));
-  }
+  // Map each instrumented dxil op to its record indicator.
+  DenseMap<Function *, uint32_t> InstrumentedFunctions;
+  InstrumentedFunctions[HlslOP->GetOpFunc(DXIL::OpCode::EmitIndices,
+                                          Type::getVoidTy(Ctx))] =
+      triangleIndexIndicator;
 
   struct OutputType
   {
@@ -305,72 +425,62 @@ bool DxilPIXMeshShaderOutputInstrumentation::runOnModule(Module &M)
   SmallVector<OutputType, 4> StoreVertexOutputOverloads
   {
     {Type::getInt32Ty(Ctx), int32ValueIndicator},
-    {Type::getInt16Ty(Ctx), int16ValueIndicator}, 
+    {Type::getInt16Ty(Ctx), int16ValueIndicator},
     {Type::getFloatTy(Ctx), floatValueIndicator},
     {Type::getHalfTy(Ctx), float16ValueIndicator}
   };
 
   for (auto const &Overload : StoreVertexOutputOverloads)
   {
-    F = HlslOP->GetOpFunc(DXIL::OpCode::StoreVertexOutput, Overload.type);
-    FunctionUses = F->uses();
-    for (auto FI = FunctionUses.begin(); FI != FunctionUses.end();)
-    {
-      auto &FunctionUse = *FI++;
-      auto FunctionUser = FunctionUse.getUser();
-
-      auto Call = cast<CallInst>(FunctionUser);
-
-      IRBuilder<> Builder2(Call);
-      BuilderContext BC2{M, DM, Ctx, HlslOP, Builder2};
-
-      // Expand column index to 32 bits:
-      auto ColumnIndex = BC2.Builder.CreateCast(
-       Instruction::ZExt, 
-        Call->getOperand(3), 
-        Type::getInt32Ty(Ctx));
-
-      // Coerce actual value to int32 
-      Value *CoercedValue = Call->getOperand(4);
+    InstrumentedFunctions[HlslOP->GetOpFunc(DXIL::OpCode::StoreVertexOutput,
+                                            Overload.type)] = Overload.tag;
+  }
 
-      if (Overload.tag == floatValueIndicator) 
-      {
-        CoercedValue = BC2.Builder.CreateCast(
-          Instruction::BitCast,
-          CoercedValue, 
-          Type::getInt32Ty(Ctx));
-      }
-      else if (Overload.tag == float16ValueIndicator) 
-      {
-        auto * HalfInt = BC2.Builder.CreateCast(
-          Instruction::BitCast, 
-          CoercedValue, 
-          Type::getInt16Ty(Ctx));
-
-        CoercedValue = BC2.Builder.CreateCast(
-          Instruction::ZExt, 
-          HalfInt, 
-          Type::getInt32Ty(Ctx));
-      }
-      else if (Overload.tag == int16ValueIndicator) 
+  // Gather call sites in program order. Scanning basic blocks (rather than
+  // the ops' use lists) keeps the sites of one block contiguous, which the
+  // compacted emission relies on.
+  std::vector<RecordSite> Sites;
+  for (Function &F : M)
+  {
+    if (F.isDeclaration())
+      continue;
+    for (BasicBlock &BB : F)
+    {
+      for (Instruction &I : BB)
       {
-        CoercedValue = BC2.Builder.CreateCast(
-          Instruction::ZExt,
-          CoercedValue,
-          Type::getInt32Ty(Ctx));
+        CallInst *Call = dyn_cast<CallInst>(&I);
+        if (!Call)
+          continue;
+        auto match = InstrumentedFunctions.find(Call->getCalledFunction());
+        if (match == InstrumentedFunctions.end())
+          continue;
+        RecordSite Site = {Call, match->second};
+        Sites.push_back(Site);
       }
+    }
+  }
 
-      Instrument(
-        BC2, 
-        BC2.HlslOP->GetI32Const(Overload.tag),
-        GroupIdXandY,
-        GroupIdZ, 
-        Call->getOperand(1),
-        Call->getOperand(2),
-        ColumnIndex,
-        CoercedValue,
-        Call->getOperand(5));
+  for (size_t i = 0; i < Sites.size();)
+  {
+    if (!m_CompactRecords)
+    {
+      RecordSite &Site = Sites[i++];
+      IRBuilder<> Builder2(Site.Call);
+      BuilderContext BC2{M, DM, Ctx, HlslOP, Builder2};
+      Instrument(BC2, buildRecordValues(BC2, Site.Call, Site.Tag, GroupIdXandY,
+                                        GroupIdZ));
+      continue;
     }
+
+    // Batch the contiguous run of sites sharing this basic block.
+    size_t blockEnd = i + 1;
+    while (blockEnd < Sites.size() &&
+           Sites[blockEnd].Call->getParent() == Sites[i].Call->getParent())
+      ++blockEnd;
+    emitCompactedRecords(
+        BC, ArrayRef<RecordSite>(&Sites[i], blockEnd - i), GroupIdXandY,
+        GroupIdZ);
+    i = blockEnd;
   }
 
   DM.ReEmitDxilResources();
@@ -19,6 +19,8 @@
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
 
+#include <mutex>
+
 using namespace llvm;
 using namespace hlsl;
 
@@ -45,4 +47,13 @@ HRESULT SetupRegistryPassForPIX() {
   return S_OK;
 }
 
+// Runs SetupRegistryPassForPIX exactly once, on first use, so DLL load does
+// not pay for registering passes that most compile sessions never touch.
+HRESULT EnsureRegistryPassesForPIX() {
+  static std::once_flag initOnce;
+  static HRESULT initResult = S_OK;
+  std::call_once(initOnce, []() { initResult = SetupRegistryPassForPIX(); });
+  return initResult;
+}
+
 } // namespace hlsl
@@ -18,10 +18,12 @@
 #include "dxc/HLSL/DxilGenerationPass.h"
 #include "dxc/HLSL/DxilSpanAllocator.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/Transforms/Utils/Local.h"
 #include <deque>
+#include <tuple>
 
 #ifdef _WIN32
 #include <winerror.h>
@@ -165,12 +167,23 @@ private:
   bool EmitResourceAccess(DxilResourceAndClass &res, Instruction *instruction,
                           OP *HlslOP, LLVMContext &Ctx,
                           ShaderAccessFlags readWrite);
+  DxilResourceAndClass &GetResourceFromHandleCached(llvm::Value *resHandle,
+                                                    DxilModule &DM);
 
 private:
   bool m_CheckForDynamicIndexing = false;
   std::map<RegisterTypeAndSpace, SlotRange> m_slotAssignments;
   std::map<llvm::Function *, CallInst *> m_FunctionToUAVHandle;
   std::set<RSRegisterIdentifier> m_DynamicallyIndexedBindPoints;
+  // Resources already derived from a given handle value, so repeated uses of
+  // one handle don't rescan the resource tables.
+  llvm::DenseMap<llvm::Value *, DxilResourceAndClass> m_HandleResources;
+  // Statically-indexed accesses already instrumented, keyed by basic block,
+  // slot byte offset, and access flag. The instrumentation stores a constant
+  // flag, so within one basic block - where if one access executes they all
+  // do - repeat stores add no information and are skipped.
+  std::set<std::tuple<llvm::BasicBlock *, unsigned, unsigned>>
+      m_EmittedBlockAccesses;
 };
 
 static unsigned DeserializeInt(std::deque<char> &q) {
@@ -319,13 +332,21 @@ bool DxilShaderAccessTracking::EmitResourceAccess(DxilResourceAndClass &res,
 
     if (isa<ConstantInt>(res.index)) {
       unsigned index = cast<ConstantInt>(res.index)->getLimitedValue();
-      if (index > slot->second.numSlots) {
-        // out-of-range accesses are written to slot zero:
-        slotIndex = HlslOP->GetU32Const(0);
-      } else {
-        slotIndex = HlslOP->GetU32Const((slot->second.startSlot + index) *
-                                        DWORDsPerResource * BytesPerDWORD);
+      unsigned slotByteOffset = 0; // out-of-range accesses are written to slot zero
+      if (index <= slot->second.numSlots) {
+        slotByteOffset = (slot->second.startSlot + index) * DWORDsPerResource *
+                         BytesPerDWORD;
       }
+      // The access is recorded by storing a constant flag to a fixed offset,
+      // so a second store for the same slot and access type in the same basic
+      // block is redundant: if one executes, they all do.
+      if (!m_EmittedBlockAccesses
+               .insert(std::make_tuple(instruction->getParent(), slotByteOffset,
+                                       (unsigned)readWrite))
+               .second) {
+        return false; // did not modify
+      }
+      slotIndex = HlslOP->GetU32Const(slotByteOffset);
     } else {
       RSRegisterIdentifier id{typeAndSpace.Type, typeAndSpace.Space,
                               res.resource->GetID()};
@@ -406,6 +427,20 @@ DxilResourceAndClass GetResourceFromHandle(Value *resHandle, DxilModule &DM) {
   return ret;
 }
 
+DxilResourceAndClass &
+DxilShaderAccessTracking::GetResourceFromHandleCached(Value *resHandle,
+                                                      DxilModule &DM) {
+  // A handle is typically used many times; derive the resource once.
+  auto cached = m_HandleResources.find(resHandle);
+  if (cached == m_HandleResources.end()) {
+    cached = m_HandleResources
+                 .insert(std::make_pair(resHandle,
+                                        GetResourceFromHandle(resHandle, DM)))
+                 .first;
+  }
+  return cached->second;
+}
+
 bool DxilShaderAccessTracking::runOnModule(Module &M) {
   // This pass adds instrumentation for shader access to resources
 
@@ -413,6 +448,11 @@ bool DxilShaderAccessTracking::runOnModule(Module &M) {
   LLVMContext &Ctx = M.getContext();
   OP *HlslOP = DM.GetOP();
 
+  // These caches are keyed on instruction pointers, which are only meaningful
+  // within one module.
+  m_HandleResources.clear();
+  m_EmittedBlockAccesses.clear();
+
   bool Modified = false;
 
   if (m_CheckForDynamicIndexing) {
@@ -558,7 +598,7 @@ bool DxilShaderAccessTracking::runOnModule(Module &M) {
           continue;
         case DXIL::OpCode::RayQuery_TraceRayInline: {
           // Read of AccelerationStructure; doesn't match function attribute
-          auto res = GetResourceFromHandle(Call->getArgOperand(2), DM);
+          auto &res = GetResourceFromHandleCached(Call->getArgOperand(2), DM);
           if (EmitResourceAccess(
             res, 
             Call, 
@@ -575,7 +615,7 @@ bool DxilShaderAccessTracking::runOnModule(Module &M) {
         }
 
         for (unsigned iParam : handleParams) {
-          auto res = GetResourceFromHandle(Call->getArgOperand(iParam), DM);
+          auto &res = GetResourceFromHandleCached(Call->getArgOperand(iParam), DM);
           // Don't instrument the accesses to the UAV that we just added
           if (res.resClass == DXIL::ResourceClass::UAV &&
               res.resource->GetSpaceID() == (unsigned)-2) {
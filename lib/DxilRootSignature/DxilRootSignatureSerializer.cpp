@@ -36,150 +36,6 @@ namespace hlsl {
 
 using namespace root_sig_helper;
 
-//////////////////////////////////////////////////////////////////////////////
-// Simple serializer.
-
-class SimpleSerializer {
-  struct Segment {
-    void *pData;
-    unsigned cbSize;
-    bool bOwner;
-    unsigned Offset;
-    Segment *pNext;
-  };
-
-public:
-  SimpleSerializer();
-  ~SimpleSerializer();
-
-  HRESULT AddBlock(void *pData, unsigned cbSize, unsigned *pOffset);
-  HRESULT ReserveBlock(void **ppData, unsigned cbSize, unsigned *pOffset);
-
-  HRESULT Compact(_Out_writes_bytes_(cbSize) char *pData, unsigned cbSize);
-  unsigned GetSize();
-
-protected:
-  unsigned m_cbSegments;
-  Segment *m_pSegment;
-  Segment **m_ppSegment;
-};
-
-SimpleSerializer::SimpleSerializer() {
-  m_cbSegments = 0;
-  m_pSegment = nullptr;
-  m_ppSegment = &m_pSegment;
-}
-
-SimpleSerializer::~SimpleSerializer() {
-  while (m_pSegment) {
-    Segment *pSegment = m_pSegment;
-    m_pSegment = pSegment->pNext;
-
-    if (pSegment->bOwner) {
-      delete[] (char*)pSegment->pData;
-    }
-
-    delete pSegment;
-  }
-}
-
-HRESULT SimpleSerializer::AddBlock(void *pData, unsigned cbSize,
-                                   unsigned *pOffset) {
-  Segment *pSegment = nullptr;
-  IFRBOOL(!(cbSize != 0 && pData == nullptr), E_FAIL);
-
-  IFROOM(pSegment = new (std::nothrow) Segment);
-  pSegment->pData = pData;
-
-  m_cbSegments = (m_cbSegments + 3) & ~3;
-  pSegment->Offset = m_cbSegments;
-  pSegment->cbSize = cbSize;
-  pSegment->bOwner = false;
-  pSegment->pNext = nullptr;
-
-  m_cbSegments += pSegment->cbSize;
-  *m_ppSegment = pSegment;
-  m_ppSegment = &pSegment->pNext;
-
-  if (pOffset != nullptr) {
-    *pOffset = pSegment->Offset;
-  }
-
-  return S_OK;
-}
-
-HRESULT SimpleSerializer::ReserveBlock(void **ppData, unsigned cbSize,
-                                       unsigned *pOffset) {
-  HRESULT hr = S_OK;
-  Segment *pSegment = nullptr;
-  void *pClonedData = nullptr;
-
-  IFCOOM(pSegment = new (std::nothrow) Segment);
-  pSegment->pData = nullptr;
-
-  IFCOOM(pClonedData = new (std::nothrow) char[cbSize]);
-  pSegment->pData = pClonedData;
-
-  m_cbSegments = (m_cbSegments + 3) & ~3;
-  pSegment->Offset = m_cbSegments;
-  pSegment->cbSize = cbSize;
-  pSegment->bOwner = true;
-  pSegment->pNext = nullptr;
-
-  m_cbSegments += pSegment->cbSize;
-  *m_ppSegment = pSegment;
-  m_ppSegment = &pSegment->pNext;
-
-  *ppData = pClonedData;
-  if (pOffset) {
-    *pOffset = pSegment->Offset;
-  }
-
-Cleanup:
-  if (FAILED(hr)) {
-    delete[] (char*)pClonedData;
-    delete pSegment;
-  }
-  return hr;
-}
-
-HRESULT SimpleSerializer::Compact(_Out_writes_bytes_(cbSize) char *pData,
-                                  unsigned cbSize) {
-  unsigned cb = GetSize();
-  IFRBOOL(cb <= cbSize, E_FAIL);
-  DXASSERT_NOMSG(cb <= UINT32_MAX / 2);
-
-  char *p = (char *)pData;
-  cb = 0;
-
-  for (Segment *pSegment = m_pSegment; pSegment; pSegment = pSegment->pNext) {
-    unsigned cbAlign = ((cb + 3) & ~3) - cb;
-
-    _Analysis_assume_(p + cbAlign <= pData + cbSize);
-    memset(p, 0xab, cbAlign);
-
-    p += cbAlign;
-    cb += cbAlign;
-
-    _Analysis_assume_(p + pSegment->cbSize <= pData + cbSize);
-    memcpy(p, pSegment->pData, pSegment->cbSize);
-
-    p += pSegment->cbSize;
-    cb += pSegment->cbSize;
-  }
-
-  // Trailing zeros
-  _Analysis_assume_(p + cbSize - cb <= pData + cbSize);
-  memset(p, 0xab, cbSize - cb);
-
-  return S_OK;
-}
-
-unsigned SimpleSerializer::GetSize() {
-  // Round up to 4==sizeof(unsigned).
-  return ((m_cbSegments + 3) >> 2) * 4;
-}
-
 template<typename T_ROOT_SIGNATURE_DESC,
   typename T_ROOT_PARAMETER,
   typename T_ROOT_DESCRIPTOR_INTERNAL,
@@ -189,39 +45,77 @@ void SerializeRootSignatureTemplate(_In_ const T_ROOT_SIGNATURE_DESC* pRootSigna
                                     _COM_Outptr_ IDxcBlob** ppBlob,
                                     DiagnosticPrinter &DiagPrinter,
                                     _In_ bool bAllowReservedRegisterSpace) {
-  DxilContainerRootSignatureDesc RS;
-  uint32_t Offset;
-  SimpleSerializer Serializer;
-  IFT(Serializer.AddBlock(&RS, sizeof(RS), &Offset));
-  IFTBOOL(Offset == 0, E_FAIL);
-
   const T_ROOT_SIGNATURE_DESC *pRS = pRootSignature;
-  RS.Version = (uint32_t)DescVersion;
-  RS.Flags = (uint32_t)pRS->Flags;
-  RS.NumParameters = pRS->NumParameters;
-  RS.NumStaticSamplers = pRS->NumStaticSamplers;
 
-  DxilContainerRootParameter *pRP;
-  IFT(Serializer.ReserveBlock((void**)&pRP,
-    sizeof(DxilContainerRootParameter)*RS.NumParameters, &RS.RootParametersOffset));
+  // Serialization is two-phase: first compute the exact output size from the
+  // parameter and range counts, then allocate the blob once and write each
+  // struct directly at its final offset. Every serialized struct is a
+  // multiple of four bytes, so blocks line up without alignment padding.
+  unsigned cb = sizeof(DxilContainerRootSignatureDesc);
+  cb += sizeof(DxilContainerRootParameter) * pRS->NumParameters;
+  for (uint32_t iRP = 0; iRP < pRS->NumParameters; iRP++) {
+    const T_ROOT_PARAMETER *pInRP = &pRS->pParameters[iRP];
+    switch (pInRP->ParameterType) {
+    case DxilRootParameterType::DescriptorTable:
+      cb += sizeof(DxilContainerRootDescriptorTable) +
+            sizeof(T_DESCRIPTOR_RANGE_INTERNAL) *
+                pInRP->DescriptorTable.NumDescriptorRanges;
+      break;
+    case DxilRootParameterType::Constants32Bit:
+      cb += sizeof(DxilRootConstants);
+      break;
+    case DxilRootParameterType::CBV:
+    case DxilRootParameterType::SRV:
+    case DxilRootParameterType::UAV:
+      cb += sizeof(T_ROOT_DESCRIPTOR_INTERNAL);
+      break;
+    default:
+      EAT(DiagPrinter << "D3DSerializeRootSignature: unknown root parameter type ("
+                      << (uint32_t)pInRP->ParameterType << ")\n");
+    }
+  }
+  cb += sizeof(DxilStaticSamplerDesc) * pRS->NumStaticSamplers;
+  DXASSERT_NOMSG((cb & 0x3) == 0);
+
+  CDxcMallocHeapPtr<char> bytes(DxcGetThreadMallocNoRef());
+  IFTBOOL(bytes.Allocate(cb), E_OUTOFMEMORY);
+  char *pData = bytes.m_pData;
+  unsigned Offset = 0;
+  auto ReserveBlock = [&](unsigned cbSize, uint32_t *pOffset) -> void * {
+    DXASSERT_NOMSG(Offset + cbSize <= cb);
+    void *p = pData + Offset;
+    if (pOffset != nullptr)
+      *pOffset = Offset;
+    Offset += cbSize;
+    return p;
+  };
 
-  for (uint32_t iRP = 0; iRP < RS.NumParameters; iRP++) {
+  DxilContainerRootSignatureDesc *pOutRS = (DxilContainerRootSignatureDesc *)
+    ReserveBlock(sizeof(DxilContainerRootSignatureDesc), nullptr);
+  pOutRS->Version = (uint32_t)DescVersion;
+  pOutRS->Flags = (uint32_t)pRS->Flags;
+  pOutRS->NumParameters = pRS->NumParameters;
+  pOutRS->NumStaticSamplers = pRS->NumStaticSamplers;
+
+  DxilContainerRootParameter *pRP = (DxilContainerRootParameter *)
+    ReserveBlock(sizeof(DxilContainerRootParameter)*pOutRS->NumParameters,
+                 &pOutRS->RootParametersOffset);
+
+  for (uint32_t iRP = 0; iRP < pOutRS->NumParameters; iRP++) {
     const T_ROOT_PARAMETER *pInRP = &pRS->pParameters[iRP];
     DxilContainerRootParameter *pOutRP = &pRP[iRP];
     pOutRP->ParameterType = (uint32_t)pInRP->ParameterType;
     pOutRP->ShaderVisibility = (uint32_t)pInRP->ShaderVisibility;
     switch (pInRP->ParameterType) {
     case DxilRootParameterType::DescriptorTable: {
-      DxilContainerRootDescriptorTable *p1;
-      IFT(Serializer.ReserveBlock((void**)&p1,
-                                  sizeof(DxilContainerRootDescriptorTable),
-                                  &pOutRP->PayloadOffset));
+      DxilContainerRootDescriptorTable *p1 = (DxilContainerRootDescriptorTable *)
+        ReserveBlock(sizeof(DxilContainerRootDescriptorTable),
+                     &pOutRP->PayloadOffset);
       p1->NumDescriptorRanges = pInRP->DescriptorTable.NumDescriptorRanges;
 
-      T_DESCRIPTOR_RANGE_INTERNAL *p2;
-      IFT(Serializer.ReserveBlock((void**)&p2,
-                                  sizeof(T_DESCRIPTOR_RANGE_INTERNAL)*p1->NumDescriptorRanges,
-                                  &p1->DescriptorRangesOffset));
+      T_DESCRIPTOR_RANGE_INTERNAL *p2 = (T_DESCRIPTOR_RANGE_INTERNAL *)
+        ReserveBlock(sizeof(T_DESCRIPTOR_RANGE_INTERNAL)*p1->NumDescriptorRanges,
+                     &p1->DescriptorRangesOffset);
 
       for (uint32_t i = 0; i < p1->NumDescriptorRanges; i++) {
         p2[i].RangeType = (uint32_t)pInRP->DescriptorTable.pDescriptorRanges[i].RangeType;
@@ -235,8 +129,8 @@ void SerializeRootSignatureTemplate(_In_ const T_ROOT_SIGNATURE_DESC* pRootSigna
       break;
     }
     case DxilRootParameterType::Constants32Bit: {
-      DxilRootConstants *p;
-      IFT(Serializer.ReserveBlock((void**)&p, sizeof(DxilRootConstants), &pOutRP->PayloadOffset));
+      DxilRootConstants *p = (DxilRootConstants *)
+        ReserveBlock(sizeof(DxilRootConstants), &pOutRP->PayloadOffset);
       p->Num32BitValues = pInRP->Constants.Num32BitValues;
       p->ShaderRegister = pInRP->Constants.ShaderRegister;
       p->RegisterSpace = pInRP->Constants.RegisterSpace;
@@ -245,8 +139,8 @@ void SerializeRootSignatureTemplate(_In_ const T_ROOT_SIGNATURE_DESC* pRootSigna
     case DxilRootParameterType::CBV:
     case DxilRootParameterType::SRV:
     case DxilRootParameterType::UAV: {
-      T_ROOT_DESCRIPTOR_INTERNAL *p;
-      IFT(Serializer.ReserveBlock((void**)&p, sizeof(T_ROOT_DESCRIPTOR_INTERNAL), &pOutRP->PayloadOffset));
+      T_ROOT_DESCRIPTOR_INTERNAL *p = (T_ROOT_DESCRIPTOR_INTERNAL *)
+        ReserveBlock(sizeof(T_ROOT_DESCRIPTOR_INTERNAL), &pOutRP->PayloadOffset);
       p->ShaderRegister = pInRP->Descriptor.ShaderRegister;
       p->RegisterSpace = pInRP->Descriptor.RegisterSpace;
       DxilRootDescriptorFlags Flags = GetFlags(pInRP->Descriptor);
@@ -254,23 +148,17 @@ void SerializeRootSignatureTemplate(_In_ const T_ROOT_SIGNATURE_DESC* pRootSigna
       break;
     }
     default:
-      EAT(DiagPrinter << "D3DSerializeRootSignature: unknown root parameter type ("
-                      << (uint32_t)pInRP->ParameterType << ")\n");
+      DXASSERT(false, "else the size pass accepted an unknown parameter type");
+      break;
     }
   }
 
-  DxilStaticSamplerDesc *pSS;
-  unsigned StaticSamplerSize = sizeof(DxilStaticSamplerDesc)*RS.NumStaticSamplers;
-  IFT(Serializer.ReserveBlock((void**)&pSS, StaticSamplerSize, &RS.StaticSamplersOffset));
+  unsigned StaticSamplerSize = sizeof(DxilStaticSamplerDesc)*pOutRS->NumStaticSamplers;
+  DxilStaticSamplerDesc *pSS = (DxilStaticSamplerDesc *)
+    ReserveBlock(StaticSamplerSize, &pOutRS->StaticSamplersOffset);
   memcpy(pSS, pRS->pStaticSamplers, StaticSamplerSize);
 
-  // Create the result blob.
-  CDxcMallocHeapPtr<char> bytes(DxcGetThreadMallocNoRef());
-  CComPtr<IDxcBlob> pBlob;
-  unsigned cb = Serializer.GetSize();
-  DXASSERT_NOMSG((cb & 0x3) == 0);
-  IFTBOOL(bytes.Allocate(cb), E_OUTOFMEMORY);
-  IFT(Serializer.Compact(bytes.m_pData, cb));
+  DXASSERT_NOMSG(Offset == cb);
   IFT(DxcCreateBlobOnMalloc(bytes.m_pData, bytes.GetMallocNoRef(), cb, ppBlob));
   bytes.Detach(); // Ownership transfered to ppBlob.
 }
@@ -466,19 +354,16 @@ void DeserializeRootSignatureTemplate(_In_reads_bytes_(SrcDataSizeInBytes) const
       pOutRTS->DescriptorTable.NumDescriptorRanges = p1->NumDescriptorRanges;
       pOutRTS->DescriptorTable.pDescriptorRanges = nullptr;
       const T_DESCRIPTOR_RANGE_INTERNAL *p2 = (const T_DESCRIPTOR_RANGE_INTERNAL*)(pData + p1->DescriptorRangesOffset);
-      IFTBOOL((const char*)p2 + sizeof(T_DESCRIPTOR_RANGE_INTERNAL) <= pMaxPtr, E_FAIL);
+      // The serialized range layout matches the in-memory layout field for
+      // field in both versions, and the flag helpers round-trip the bits
+      // unchanged, so the ranges are copied in bulk like static samplers.
+      static_assert(sizeof(T_DESCRIPTOR_RANGE) == sizeof(T_DESCRIPTOR_RANGE_INTERNAL),
+                    "otherwise ranges cannot be copied in bulk");
+      size_t s2 = sizeof(T_DESCRIPTOR_RANGE_INTERNAL)*p1->NumDescriptorRanges;
+      IFTBOOL(((const char*)p2) + s2 <= pMaxPtr, E_FAIL);
       if (p1->NumDescriptorRanges) {
         pOutRTS->DescriptorTable.pDescriptorRanges = new T_DESCRIPTOR_RANGE[p1->NumDescriptorRanges];
-      }
-      for (unsigned i = 0; i < p1->NumDescriptorRanges; i++) {
-        T_DESCRIPTOR_RANGE *p3 = (T_DESCRIPTOR_RANGE *)&pOutRTS->DescriptorTable.pDescriptorRanges[i];
-        p3->RangeType                         = (DxilDescriptorRangeType)p2[i].RangeType;
-        p3->NumDescriptors                    = p2[i].NumDescriptors;
-        p3->BaseShaderRegister                = p2[i].BaseShaderRegister;
-        p3->RegisterSpace                     = p2[i].RegisterSpace;
-        p3->OffsetInDescriptorsFromTableStart = p2[i].OffsetInDescriptorsFromTableStart;
-        DxilDescriptorRangeFlags Flags = GetFlags(p2[i]);
-        SetFlags(*p3, Flags);
+        memcpy((void *)pOutRTS->DescriptorTable.pDescriptorRanges, p2, s2);
       }
       break;
     }
@@ -51,12 +51,15 @@ public:
       return &*it;
     return nullptr;
   }
-  void Insert(const T& value) {
+  // Insert the interval, or return the existing interval that blocks it.
+  // A failed std::set insertion hands back the "equal" - that is,
+  // intersecting - element, so probing and inserting costs one tree walk
+  // instead of a find followed by an insert.
+  const T* InsertOrFindIntersecting(const T& value) {
     auto result = m_set.insert(value);
-    UNREFERENCED_PARAMETER(result);
-#if DBG
-    DXASSERT(result.second, "otherwise interval collides with existing in collection");
-#endif
+    if (!result.second)
+      return &*result.first;
+    return nullptr;
   }
 };
 
@@ -301,21 +304,25 @@ void RootSignatureVerifier::AddRegisterRange(unsigned iRP,
     }
   }
 
-  const RegisterRange *pNode = nullptr;
+  // Claim the range in this visibility's collection first; a blocked
+  // insertion hands back the intersecting interval in the same tree walk
+  // the insertion performs. Inserting before the cross-visibility checks is
+  // fine because an overlap diagnostic aborts the whole verification.
+  const RegisterRange *pNode =
+      GetRanges(VisType, DescType).InsertOrFindIntersecting(interval);
   DxilShaderVisibility NodeVis = VisType;
-  if (VisType == DxilShaderVisibility::All) {
-    // Check for overlap with each visibility type.
-    for (unsigned iVT = kMinVisType; iVT <= kMaxVisType; iVT++) {
-      pNode = GetRanges((DxilShaderVisibility)iVT, DescType).FindIntersectingInterval(interval);
-      if (pNode != nullptr)
-        break;
-    }
-  } else {
-    // Check for overlap with the same visibility.
-    pNode = GetRanges(VisType, DescType).FindIntersectingInterval(interval);
-
-    // Check for overlap with ALL visibility.
-    if (pNode == nullptr) {
+  if (pNode == nullptr) {
+    if (VisType == DxilShaderVisibility::All) {
+      // Check for overlap with each other visibility type.
+      for (unsigned iVT = kMinVisType; iVT <= kMaxVisType; iVT++) {
+        if ((DxilShaderVisibility)iVT == DxilShaderVisibility::All)
+          continue;
+        pNode = GetRanges((DxilShaderVisibility)iVT, DescType).FindIntersectingInterval(interval);
+        if (pNode != nullptr)
+          break;
+      }
+    } else {
+      // Check for overlap with ALL visibility.
       pNode = GetRanges(DxilShaderVisibility::All, DescType).FindIntersectingInterval(interval);
       NodeVis = DxilShaderVisibility::All;
     }
@@ -367,9 +374,6 @@ void RootSignatureVerifier::AddRegisterRange(unsigned iRP,
                     << " " << testString << " overlaps with another "
                     << "shader register range " << nodeString << ".\n");
   }
-
-  // Insert node.
-  GetRanges(VisType, DescType).Insert(interval);
 }
 
 const RootSignatureVerifier::RegisterRange *
@@ -286,6 +286,12 @@ const vector<unsigned> &DxilViewIdState::GetSerialized() const {
   return m_SerializedState;
 }
 
+vector<unsigned> DxilViewIdState::TakeSerialized() {
+  if (m_SerializedState.empty())
+    Serialize();
+  return std::move(m_SerializedState);
+}
+
 namespace {
 unsigned DeserializeOutputsDependentOnViewId(
     unsigned NumOutputs,
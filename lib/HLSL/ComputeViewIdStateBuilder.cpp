@@ -15,6 +15,7 @@
 #include "dxc/DXIL/DxilOperations.h"
 #include "dxc/DXIL/DxilInstructions.h"
 
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Function.h"
@@ -119,6 +120,8 @@ private:
     FunctionReturnSet Returns;
     ControlDependence CtrlDep;
     std::unique_ptr<llvm::DominatorTreeBase<llvm::BasicBlock>> pDomTree;
+    // Kept alive for CtrlDep's lazy queries.
+    std::unique_ptr<llvm::DominatorTreeBase<llvm::BasicBlock>> pPostDomTree;
     void Clear();
   };
 
@@ -143,8 +146,7 @@ private:
       EntryInfo &Entry, llvm::Value *pContributingValue,
       InstructionSetType &ContributingInstructions);
   void CollectPhiCFValuesContributingToOutputRec(
-      llvm::PHINode *pPhi, EntryInfo &Entry,
-      InstructionSetType &ContributingInstructions);
+      llvm::PHINode *pPhi, llvm::SmallVectorImpl<llvm::Value *> &WorkList);
   const ValueSetType &CollectReachingDecls(llvm::Value *pValue);
   void CollectReachingDeclsRec(llvm::Value *pValue, ValueSetType &ReachingDecls,
                                ValueSetType &Visited);
@@ -260,6 +262,7 @@ void DxilViewIdStateBuilder::FuncInfo::Clear() {
   Returns.clear();
   CtrlDep.Clear();
   pDomTree.reset();
+  pPostDomTree.reset();
 }
 
 void DxilViewIdStateBuilder::DetermineMaxPackedLocation(DxilSignature &DxilSig,
@@ -399,14 +402,16 @@ void DxilViewIdStateBuilder::AnalyzeFunctions(EntryInfo &Entry) {
     pFuncInfo->pDomTree->print(dbgs());
 #endif
 
-    // Compute postdominator relation.
-    DominatorTreeBase<BasicBlock> PDR(true);
-    PDR.recalculate(*F);
+    // Compute postdominator relation. It must outlive this loop because the
+    // sparse control-dependence queries below borrow it.
+    pFuncInfo->pPostDomTree = make_unique<DominatorTreeBase<BasicBlock> >(true);
+    pFuncInfo->pPostDomTree->recalculate(*F);
 #if DXILVIEWID_DBG
-    PDR.print(dbgs());
+    pFuncInfo->pPostDomTree->print(dbgs());
 #endif
-    // Compute control dependence.
-    pFuncInfo->CtrlDep.Compute(F, PDR);
+    // Record control dependence sources; the per-block sets are computed on
+    // the first query, so straight-line functions never pay for them.
+    pFuncInfo->CtrlDep.ComputeSparse(F, *pFuncInfo->pPostDomTree);
 #if DXILVIEWID_DBG
     pFuncInfo->CtrlDep.print(dbgs());
 #endif
@@ -495,69 +500,79 @@ void DxilViewIdStateBuilder::CollectValuesContributingToOutputs(EntryInfo &Entry
 void DxilViewIdStateBuilder::CollectValuesContributingToOutputRec(EntryInfo &Entry,
                                                            Value *pContributingValue,
                                                            InstructionSetType &ContributingInstructions) {
-  if (dyn_cast<Argument>(pContributingValue)) {
-    // This must be a leftover signature argument of an entry function.
-    DXASSERT_NOMSG(Entry.pEntryFunc == m_pModule->GetEntryFunction() ||
-                   Entry.pEntryFunc == m_pModule->GetPatchConstantFunction());
-    return;
-  }
+  // The closure is computed with an explicit worklist rather than per-operand
+  // recursion: contributing-value chains can be as long as the program, and
+  // the recursive form both risked stack overflow and dominated analysis time
+  // on large shaders.
+  SmallVector<Value *, 32> WorkList;
+  WorkList.push_back(pContributingValue);
+
+  while (!WorkList.empty()) {
+    Value *pValue = WorkList.pop_back_val();
+
+    if (dyn_cast<Argument>(pValue)) {
+      // This must be a leftover signature argument of an entry function.
+      DXASSERT_NOMSG(Entry.pEntryFunc == m_pModule->GetEntryFunction() ||
+                     Entry.pEntryFunc == m_pModule->GetPatchConstantFunction());
+      continue;
+    }
 
-  Instruction *pContributingInst = dyn_cast<Instruction>(pContributingValue);
-  if (pContributingInst == nullptr) {
-    // Can be literal constant, global decl, branch target.
-    DXASSERT_NOMSG(isa<Constant>(pContributingValue) || isa<BasicBlock>(pContributingValue));
-    return;
-  }
+    Instruction *pContributingInst = dyn_cast<Instruction>(pValue);
+    if (pContributingInst == nullptr) {
+      // Can be literal constant, global decl, branch target.
+      DXASSERT_NOMSG(isa<Constant>(pValue) || isa<BasicBlock>(pValue));
+      continue;
+    }
 
-  auto itInst = ContributingInstructions.emplace(pContributingInst);
-  // Already visited instruction.
-  if (!itInst.second) return;
-
-  // Handle special cases.
-  if (PHINode *phi = dyn_cast<PHINode>(pContributingInst)) {
-    CollectPhiCFValuesContributingToOutputRec(phi, Entry, ContributingInstructions);
-  } else if (isa<LoadInst>(pContributingInst) || 
-             isa<AtomicCmpXchgInst>(pContributingInst) ||
-             isa<AtomicRMWInst>(pContributingInst)) {
-    Value *pPtrValue = pContributingInst->getOperand(0);
-    DXASSERT_NOMSG(pPtrValue->getType()->isPointerTy());
-    const ValueSetType &ReachingDecls = CollectReachingDecls(pPtrValue);
-    DXASSERT_NOMSG(ReachingDecls.size() > 0);
-    for (Value *pDeclValue : ReachingDecls) {
-      const ValueSetType &Stores = CollectStores(pDeclValue);
-      for (Value *V : Stores) {
-        CollectValuesContributingToOutputRec(Entry, V, ContributingInstructions);
+    auto itInst = ContributingInstructions.emplace(pContributingInst);
+    // Already visited instruction.
+    if (!itInst.second) continue;
+
+    // Handle special cases.
+    if (PHINode *phi = dyn_cast<PHINode>(pContributingInst)) {
+      CollectPhiCFValuesContributingToOutputRec(phi, WorkList);
+    } else if (isa<LoadInst>(pContributingInst) ||
+               isa<AtomicCmpXchgInst>(pContributingInst) ||
+               isa<AtomicRMWInst>(pContributingInst)) {
+      Value *pPtrValue = pContributingInst->getOperand(0);
+      DXASSERT_NOMSG(pPtrValue->getType()->isPointerTy());
+      const ValueSetType &ReachingDecls = CollectReachingDecls(pPtrValue);
+      DXASSERT_NOMSG(ReachingDecls.size() > 0);
+      for (Value *pDeclValue : ReachingDecls) {
+        const ValueSetType &Stores = CollectStores(pDeclValue);
+        for (Value *V : Stores) {
+          WorkList.push_back(V);
+        }
       }
-    }
-  } else if (CallInst *CI = dyn_cast<CallInst>(pContributingInst)) {
-    if (!hlsl::OP::IsDxilOpFuncCallInst(CI)) {
-      Function *F = CI->getCalledFunction();
-      if (!F->empty()) {
-        // Return value of a user function.
-        if (Entry.Functions.find(F) != Entry.Functions.end()) {
-          const FuncInfo &FI = *m_FuncInfo[F];
-          for (ReturnInst *pRetInst : FI.Returns) {
-            CollectValuesContributingToOutputRec(Entry, pRetInst, ContributingInstructions);
+    } else if (CallInst *CI = dyn_cast<CallInst>(pContributingInst)) {
+      if (!hlsl::OP::IsDxilOpFuncCallInst(CI)) {
+        Function *F = CI->getCalledFunction();
+        if (!F->empty()) {
+          // Return value of a user function.
+          if (Entry.Functions.find(F) != Entry.Functions.end()) {
+            const FuncInfo &FI = *m_FuncInfo[F];
+            for (ReturnInst *pRetInst : FI.Returns) {
+              WorkList.push_back(pRetInst);
+            }
           }
         }
       }
     }
-  }
 
-  // Handle instruction inputs.
-  unsigned NumOps = pContributingInst->getNumOperands();
-  for (unsigned i = 0; i < NumOps; i++) {
-    Value *O = pContributingInst->getOperand(i);
-    CollectValuesContributingToOutputRec(Entry, O, ContributingInstructions);
-  }
+    // Handle instruction inputs.
+    unsigned NumOps = pContributingInst->getNumOperands();
+    for (unsigned i = 0; i < NumOps; i++) {
+      WorkList.push_back(pContributingInst->getOperand(i));
+    }
 
-  // Handle control dependence of this instruction BB.
-  BasicBlock *pBB = pContributingInst->getParent();
-  Function *F = pBB->getParent();
-  FuncInfo *pFuncInfo = m_FuncInfo[F].get();
-  const BasicBlockSet &CtrlDepSet = pFuncInfo->CtrlDep.GetCDBlocks(pBB);
-  for (BasicBlock *B : CtrlDepSet) {
-    CollectValuesContributingToOutputRec(Entry, B->getTerminator(), ContributingInstructions);
+    // Handle control dependence of this instruction BB.
+    BasicBlock *pBB = pContributingInst->getParent();
+    Function *F = pBB->getParent();
+    FuncInfo *pFuncInfo = m_FuncInfo[F].get();
+    const BasicBlockSet &CtrlDepSet = pFuncInfo->CtrlDep.GetCDBlocks(pBB);
+    for (BasicBlock *B : CtrlDepSet) {
+      WorkList.push_back(B->getTerminator());
+    }
   }
 }
 
@@ -567,8 +582,7 @@ void DxilViewIdStateBuilder::CollectValuesContributingToOutputRec(EntryInfo &Ent
 // A better "definition" point is the highest dominator where it is still legal to "insert" constant assignment.
 // In this context, "legal" means that only one value "leaves" the dominator and reaches Phi.
 void DxilViewIdStateBuilder::CollectPhiCFValuesContributingToOutputRec(PHINode *pPhi,
-                                                                EntryInfo &Entry,
-                                                                InstructionSetType &ContributingInstructions) {
+                                                                SmallVectorImpl<Value *> &WorkList) {
   Function *F = pPhi->getParent()->getParent();
   FuncInfo *pFuncInfo = m_FuncInfo[F].get();
   unordered_map<DomTreeNodeBase<BasicBlock> *, Value *> DomTreeMarkers;
@@ -643,7 +657,7 @@ void DxilViewIdStateBuilder::CollectPhiCFValuesContributingToOutputRec(PHINode *
     pBB = pDefDomNode->getBlock();
     const BasicBlockSet &CtrlDepSet = pFuncInfo->CtrlDep.GetCDBlocks(pBB);
     for (BasicBlock *B : CtrlDepSet) {
-      CollectValuesContributingToOutputRec(Entry, B->getTerminator(), ContributingInstructions);
+      WorkList.push_back(B->getTerminator());
     }
   }
 }
@@ -756,11 +770,14 @@ void DxilViewIdStateBuilder::CreateViewIdSets(const std::unordered_map<unsigned,
   for (auto &itOut : ContributingInstructions) {
     unsigned outIdx = itOut.first;
     for (Instruction *pInst : itOut.second) {
-      // Set output dependence on ViewId.
-      if (DxilInst_ViewID VID = DxilInst_ViewID(pInst)) {
-        DXASSERT(m_bUsesViewId, "otherwise, DxilModule flag not set properly");
-        OutputsDependentOnViewId[outIdx] = true;
-        continue;
+      // Set output dependence on ViewId. When the module-level flag is clear
+      // no ViewID instruction can exist, so skip the per-instruction probe
+      // in that common case.
+      if (m_bUsesViewId) {
+        if (DxilInst_ViewID VID = DxilInst_ViewID(pInst)) {
+          OutputsDependentOnViewId[outIdx] = true;
+          continue;
+        }
       }
 
       // Start setting output dependence on inputs.
@@ -892,14 +909,9 @@ bool ComputeViewIdState::runOnModule(Module &M) {
     DxilViewIdState ViewIdState(&DxilModule);
     DxilViewIdStateBuilder Builder(ViewIdState, &DxilModule);
     Builder.Compute();
-    // Serialize viewidstate.
-    ViewIdState.Serialize();
-    auto &TmpSerialized = ViewIdState.GetSerialized();
-    // Copy serilized viewidstate.
-    auto &SerializedViewIdState = DxilModule.GetSerializedViewIdState();
-    SerializedViewIdState.clear();
-    SerializedViewIdState.resize(TmpSerialized.size());
-    SerializedViewIdState.assign(TmpSerialized.begin(), TmpSerialized.end());
+    // Serialize viewidstate and move it into the module; the state object is
+    // discarded right after, so there is no need to copy.
+    DxilModule.GetSerializedViewIdState() = ViewIdState.TakeSerialized();
     return true;
   }
   return false;
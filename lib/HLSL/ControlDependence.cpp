@@ -9,6 +9,8 @@
 //                                                                           //
 // References                                                                //
 // [AK] Optimizing Compilers for Modern Architectures by Allen and Kennedy.  //
+// [FOW] The Program Dependence Graph and Its Use in Optimization by         //
+//       Ferrante, Ottenstein, and Warren.                                   //
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "dxc/HLSL/ControlDependence.h"
@@ -23,8 +25,9 @@ const BasicBlockSet &ControlDependence::GetCDBlocks(BasicBlock *pBB) const {
   auto it = m_ControlDependence.find(pBB);
   if (it != m_ControlDependence.end())
     return it->second;
-  else
-    return m_EmptyBBSet;
+  if (m_pPostDomRel != nullptr && !m_CondEdges.empty())
+    return ComputeForBlock(pBB);
+  return m_EmptyBBSet;
 }
 
 void ControlDependence::print(raw_ostream &OS) {
@@ -91,8 +94,49 @@ void ControlDependence::Compute(Function *F, PostDomRelationType &PostDomRel) {
   }
 }
 
+void ControlDependence::ComputeSparse(Function *F, PostDomRelationType &PostDomRel) {
+  m_pFunc = F;
+  m_pPostDomRel = &PostDomRel;
+
+  // Only multi-successor terminators can be control-dependence sources: a
+  // single successor always post-dominates its predecessor's terminator.
+  for (BasicBlock &BB : *F) {
+    TerminatorInst *pTI = BB.getTerminator();
+    if (pTI == nullptr || pTI->getNumSuccessors() < 2)
+      continue;
+    for (unsigned i = 0; i < pTI->getNumSuccessors(); i++)
+      m_CondEdges.emplace_back(&BB, pTI->getSuccessor(i));
+  }
+}
+
+// Lazily compute the dependence set for one queried block: x is control
+// dependent on y iff some CFG edge y->s has x post-dominating s without x
+// strictly post-dominating y [FOW]. Scanning just the conditional edges is
+// cheap against the analysis' mostly-empty results, and the answer is cached
+// so repeated queries for the same block pay once.
+const BasicBlockSet &ControlDependence::ComputeForBlock(BasicBlock *pBB) const {
+  BasicBlockSet &CDSet = m_ControlDependence[pBB];
+  auto *pXNode = m_pPostDomRel->getNode(pBB);
+  if (pXNode == nullptr)
+    return CDSet;
+
+  for (const BasicBlockEdge &Edge : m_CondEdges) {
+    auto *pYNode = m_pPostDomRel->getNode(Edge.first);
+    auto *pSNode = m_pPostDomRel->getNode(Edge.second);
+    if (pYNode == nullptr || pSNode == nullptr)
+      continue;
+    if (m_pPostDomRel->dominates(pXNode, pSNode) &&
+        !(pXNode != pYNode && m_pPostDomRel->dominates(pXNode, pYNode))) {
+      CDSet.insert(Edge.first);
+    }
+  }
+  return CDSet;
+}
+
 void ControlDependence::Clear() {
   m_pFunc = nullptr;
+  m_pPostDomRel = nullptr;
+  m_CondEdges.clear();
   m_ControlDependence.clear();
   m_EmptyBBSet.clear();
 }
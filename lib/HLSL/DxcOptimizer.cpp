@@ -39,7 +39,10 @@
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
 
 #include <algorithm>
+#include <chrono>
 #include <list>   // should change this for string_table
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "llvm/PassPrinters/PassPrinters.h"
@@ -105,6 +108,8 @@ HRESULT SetupRegistryPassForHLSL() {
     initializeDxilLegalizeEvalOperationsPass(Registry);
     initializeDxilLegalizeResourcesPass(Registry);
     initializeDxilLegalizeSampleOffsetPassPass(Registry);
+    initializeDxilScheduleForPressurePass(Registry);
+    initializeDxilSpecializeConstantsPass(Registry);
     initializeDxilLoadMetadataPass(Registry);
     initializeDxilLoopDeletionPass(Registry);
     initializeDxilLoopUnrollPass(Registry);
@@ -118,6 +123,7 @@ HRESULT SetupRegistryPassForHLSL() {
     initializeDxilRewriteOutputArgDebugInfoPass(Registry);
     initializeDxilSimpleGVNHoistPass(Registry);
     initializeDxilTranslateRawBufferPass(Registry);
+    initializeDxilTrimUnusedOutputsPass(Registry);
     initializeDxilValidateWaveSensitivityPass(Registry);
     initializeDxilValueCachePass(Registry);
     initializeDynamicIndexingVectorToArrayPass(Registry);
@@ -193,6 +199,16 @@ HRESULT SetupRegistryPassForHLSL() {
   return S_OK;
 }
 
+// Runs SetupRegistryPassForHLSL exactly once, on first use. Registration is
+// deferred out of DllMain so that loading dxcompiler.dll stays cheap for
+// clients that load it eagerly (e.g. on a UI thread) but compile later.
+HRESULT EnsureRegistryPassesForHLSL() {
+  static std::once_flag initOnce;
+  static HRESULT initResult = S_OK;
+  std::call_once(initOnce, []() { initResult = SetupRegistryPassForHLSL(); });
+  return initResult;
+}
+
 }
 
 static ArrayRef<LPCSTR> GetPassArgNames(LPCSTR passName) {
@@ -510,7 +526,96 @@ public:
   }
 };
 
-class DxcOptimizer : public IDxcOptimizer {
+// A pass description parsed and validated once. Option values are stored
+// as owned strings so the parsed form outlives the caller's argument
+// buffers; per-run PassOption views are rebuilt over them when the pass
+// objects are constructed.
+struct ParsedPipelineAction {
+  enum class Kind { AddPass, PrintModule, UseFunctionPasses, UseModulePasses };
+  Kind ActionKind = Kind::AddPass;
+  const PassInfo *PassInf = nullptr;
+  std::vector<std::pair<std::string, std::string>> Options; // sorted by name
+  std::string Banner; // for PrintModule
+};
+
+struct ParsedPipeline {
+  std::vector<ParsedPipelineAction> Actions;
+  bool OutputAssembly = false;
+  bool AnalyzeOnly = false;
+  UINT32 PassCount = 0;
+};
+
+static HRESULT ParsePassPipeline(_In_count_(optionCount) LPCWSTR *ppOptions,
+                                 UINT32 optionCount, ParsedPipeline &Result);
+static HRESULT RunParsedPipeline(IMalloc *pMalloc,
+                                 const ParsedPipeline &Pipeline,
+                                 IDxcBlob *pBlob,
+                                 _COM_Outptr_ IDxcBlob **ppOutputModule,
+                                 _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText);
+
+class DxcOptimizerPipeline : public IDxcOptimizerPipeline {
+private:
+  DXC_MICROCOM_TM_REF_FIELDS()
+  ParsedPipeline m_pipeline;
+  UINT32 m_runCount = 0;
+  UINT64 m_totalMicroseconds = 0;
+public:
+  DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
+  DXC_MICROCOM_TM_CTOR(DxcOptimizerPipeline)
+
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
+    return DoBasicQueryInterface<IDxcOptimizerPipeline>(this, iid, ppvObject);
+  }
+
+  HRESULT Initialize(ParsedPipeline &&pipeline) {
+    m_pipeline = std::move(pipeline);
+    return S_OK;
+  }
+  static HRESULT Create(IMalloc *pMalloc, ParsedPipeline &&pipeline,
+                        IDxcOptimizerPipeline **ppResult) {
+    CComPtr<DxcOptimizerPipeline> result;
+    *ppResult = nullptr;
+    result = DxcOptimizerPipeline::Alloc(pMalloc);
+    IFROOM(result);
+    IFR(result->Initialize(std::move(pipeline)));
+    *ppResult = result.Detach();
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE GetPassCount(_Out_ UINT32 *pCount) override {
+    return AssignToOut<UINT32>(m_pipeline.PassCount, pCount);
+  }
+
+  HRESULT STDMETHODCALLTYPE RunOptimizer(IDxcBlob *pBlob,
+      _COM_Outptr_ IDxcBlob **ppOutputModule,
+      _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) override {
+    AssignToOutOpt(nullptr, ppOutputModule);
+    AssignToOutOpt(nullptr, ppOutputText);
+    if (pBlob == nullptr)
+      return E_POINTER;
+    DxcThreadMalloc TM(m_pMalloc);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    HRESULT hr = RunParsedPipeline(m_pMalloc, m_pipeline, pBlob,
+                                   ppOutputModule, ppOutputText);
+    m_runCount += 1;
+    m_totalMicroseconds +=
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    return hr;
+  }
+
+  HRESULT STDMETHODCALLTYPE GetRunStatistics(
+      _Out_ UINT32 *pRunCount, _Out_ UINT64 *pTotalMicroseconds) override {
+    if (!pRunCount || !pTotalMicroseconds)
+      return E_INVALIDARG;
+    *pRunCount = m_runCount;
+    *pTotalMicroseconds = m_totalMicroseconds;
+    return S_OK;
+  }
+};
+
+class DxcOptimizer : public IDxcOptimizer2 {
 private:
   DXC_MICROCOM_TM_REF_FIELDS()
   PassRegistry *m_registry;
@@ -520,7 +625,7 @@ public:
   DXC_MICROCOM_TM_CTOR(DxcOptimizer)
 
   HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
-    return DoBasicQueryInterface<IDxcOptimizer>(this, iid, ppvObject);
+    return DoBasicQueryInterface<IDxcOptimizer, IDxcOptimizer2>(this, iid, ppvObject);
   }
 
   HRESULT Initialize();
@@ -534,6 +639,9 @@ public:
     _In_count_(optionCount) LPCWSTR *ppOptions, UINT32 optionCount,
     _COM_Outptr_ IDxcBlob **ppOutputModule,
     _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) override;
+  HRESULT STDMETHODCALLTYPE CompilePipeline(
+    _In_count_(optionCount) LPCWSTR *ppOptions, UINT32 optionCount,
+    _COM_Outptr_ IDxcOptimizerPipeline **ppPipeline) override;
 };
 
 class CapturePassManager : public llvm::legacy::PassManagerBase {
@@ -596,99 +704,24 @@ HRESULT STDMETHODCALLTYPE DxcOptimizer::GetAvailablePass(
       GetPassArgDescriptions(m_passes[index]->getPassArgument()), ppResult);
 }
 
-HRESULT STDMETHODCALLTYPE DxcOptimizer::RunOptimizer(
-    IDxcBlob *pBlob, _In_count_(optionCount) LPCWSTR *ppOptions,
-    UINT32 optionCount, _COM_Outptr_ IDxcBlob **ppOutputModule,
-    _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) {
-  AssignToOutOpt(nullptr, ppOutputModule);
-  AssignToOutOpt(nullptr, ppOutputText);
-  if (pBlob == nullptr)
-    return E_POINTER;
-  if (optionCount > 0 && ppOptions == nullptr)
-    return E_POINTER;
-
-  DxcThreadMalloc TM(m_pMalloc);
-
-  // Setup input buffer.
-  //
-  // The ir parsing requires the buffer to be null terminated. We deal with
-  // both source and bitcode input, so the input buffer may not be null
-  // terminated; we create a new membuf that copies and appends for this.
-  //
-  // If we have the beginning of a DXIL program header, skip to the bitcode.
-  //
-  LLVMContext Context;
-  SMDiagnostic Err;
-  std::unique_ptr<MemoryBuffer> memBuf;
-  std::unique_ptr<Module> M;
-  const char * pBlobContent = reinterpret_cast<const char *>(pBlob->GetBufferPointer());
-  unsigned blobSize = pBlob->GetBufferSize();
-  const DxilProgramHeader *pProgramHeader =
-    reinterpret_cast<const DxilProgramHeader *>(pBlobContent);
-  if (IsValidDxilProgramHeader(pProgramHeader, blobSize)) {
-    std::string DiagStr;
-    GetDxilProgramBitcode(pProgramHeader, &pBlobContent, &blobSize);
-    M = hlsl::dxilutil::LoadModuleFromBitcode(
-      llvm::StringRef(pBlobContent, blobSize), Context, DiagStr);
-  }
-  else {
-    StringRef bufStrRef(pBlobContent, blobSize);
-    memBuf = MemoryBuffer::getMemBufferCopy(bufStrRef);
-    M = parseIR(memBuf->getMemBufferRef(), Err, Context);
-  }
-
-  if (M == nullptr) {
-    return DXC_E_IR_VERIFICATION_FAILED;
-  }
-
-  legacy::PassManager ModulePasses;
-  legacy::FunctionPassManager FunctionPasses(M.get());
-  legacy::PassManagerBase *pPassManager = &ModulePasses;
-
+static HRESULT ParsePassPipeline(_In_count_(optionCount) LPCWSTR *ppOptions,
+                                 UINT32 optionCount, ParsedPipeline &Result) {
   try {
-    CComPtr<AbstractMemoryStream> pOutputStream;
-    CComPtr<IDxcBlob> pOutputBlob;
-
-    IFT(CreateMemoryStream(m_pMalloc, &pOutputStream));
-    IFT(pOutputStream.QueryInterface(&pOutputBlob));
-
-    raw_stream_ostream outStream(pOutputStream.p);
-
-    //
-    // Consider some differences from opt.exe:
-    //
-    // Create a new optimization pass for each one specified on the command line
-    // as in StandardLinkOpts, OptLevelO1, etc.
-    // No target machine, and so no passes get their target machine ctor called.
-    // No print-after-each-pass option.
-    // No printing of the pass options.
-    // No StripDebug support.
-    // No verifyModule before starting.
-    // Use of PassPipeline for new manager.
-    // No TargetInfo.
-    // No DataLayout.
-    //
-    bool OutputAssembly = false;
-    bool AnalyzeOnly = false;
-
     // First gather flags, wherever they may be.
     SmallVector<UINT32, 2> handled;
     for (UINT32 i = 0; i < optionCount; ++i) {
       if (wcseq(L"-S", ppOptions[i])) {
-        OutputAssembly = true;
+        Result.OutputAssembly = true;
         handled.push_back(i);
         continue;
       }
       if (wcseq(L"-analyze", ppOptions[i])) {
-        AnalyzeOnly = true;
+        Result.AnalyzeOnly = true;
         handled.push_back(i);
         continue;
       }
     }
 
-    // TODO: should really use string_table for this once that's available
-    std::list<std::string> optionsAnsi;
-    SmallVector<PassOption, 2> options;
     for (UINT32 i = 0; i < optionCount; ++i) {
       if (std::find(handled.begin(), handled.end(), i) != handled.end()) {
         continue;
@@ -697,27 +730,31 @@ HRESULT STDMETHODCALLTYPE DxcOptimizer::RunOptimizer(
       // Handle some special cases where we can inject a redirected output stream.
       if (wcsstartswith(ppOptions[i], L"-print-module")) {
         LPCWSTR pName = ppOptions[i] + _countof(L"-print-module") - 1;
-        std::string Banner;
+        ParsedPipelineAction action;
+        action.ActionKind = ParsedPipelineAction::Kind::PrintModule;
         if (*pName) {
           IFTARG(*pName != L':' || *pName != L'=');
           ++pName;
           CW2A name8(pName);
-          Banner = "MODULE-PRINT ";
-          Banner += name8.m_psz;
-          Banner += "\n";
+          action.Banner = "MODULE-PRINT ";
+          action.Banner += name8.m_psz;
+          action.Banner += "\n";
         }
-        if (pPassManager == &ModulePasses)
-          pPassManager->add(llvm::createPrintModulePass(outStream, Banner));
+        Result.Actions.push_back(std::move(action));
         continue;
       }
 
       // Handle special switches to toggle per-function prepasses vs. module passes.
       if (wcseq(ppOptions[i], L"-opt-fn-passes")) {
-        pPassManager = &FunctionPasses;
+        ParsedPipelineAction action;
+        action.ActionKind = ParsedPipelineAction::Kind::UseFunctionPasses;
+        Result.Actions.push_back(std::move(action));
         continue;
       }
       if (wcseq(ppOptions[i], L"-opt-mod-passes")) {
-        pPassManager = &ModulePasses;
+        ParsedPipelineAction action;
+        action.ActionKind = ParsedPipelineAction::Kind::UseModulePasses;
+        Result.Actions.push_back(std::move(action));
         continue;
       }
 
@@ -736,10 +773,12 @@ HRESULT STDMETHODCALLTYPE DxcOptimizer::RunOptimizer(
         ++pCursor;
       }
       *pCursor = '\0';
-      const llvm::PassInfo *PassInf = getPassByName(pOptionNameStart);
+      const llvm::PassInfo *PassInf =
+          PassRegistry::getPassRegistry()->getPassInfo(StringRef(pOptionNameStart));
       if (!PassInf) {
         return E_INVALIDARG;
       }
+      SmallVector<PassOption, 2> options;
       while (pCursor < pEnd) {
         // *pCursor is '\0' when we overwrite ',' to get a null-terminated string
         if (*pCursor && *pCursor != ArgDelim) {
@@ -774,40 +813,142 @@ HRESULT STDMETHODCALLTYPE DxcOptimizer::RunOptimizer(
       }
 
       DXASSERT(PassInf->getNormalCtor(), "else pass with no default .ctor was added");
-      Pass *pass = PassInf->getNormalCtor()();
-      pass->setOSOverride(&outStream);
-      pass->applyOptions(options);
-      options.clear();
-      pPassManager->add(pass);
-      if (AnalyzeOnly) {
-        const bool Quiet = false;
-        PassKind Kind = pass->getPassKind();
-        switch (Kind) {
-        case PT_BasicBlock:
-          pPassManager->add(createBasicBlockPassPrinter(PassInf, outStream, Quiet));
-          break;
-        case PT_Region:
-          pPassManager->add(createRegionPassPrinter(PassInf, outStream, Quiet));
-          break;
-        case PT_Loop:
-          pPassManager->add(createLoopPassPrinter(PassInf, outStream, Quiet));
-          break;
-        case PT_Function:
-          pPassManager->add(createFunctionPassPrinter(PassInf, outStream, Quiet));
-          break;
-        case PT_CallGraphSCC:
-          pPassManager->add(createCallGraphPassPrinter(PassInf, outStream, Quiet));
-          break;
-        default:
-          pPassManager->add(createModulePassPrinter(PassInf, outStream, Quiet));
-          break;
+      ParsedPipelineAction action;
+      action.ActionKind = ParsedPipelineAction::Kind::AddPass;
+      action.PassInf = PassInf;
+      action.Options.reserve(options.size());
+      for (const PassOption &option : options) {
+        action.Options.emplace_back(option.first.str(), option.second.str());
+      }
+      Result.Actions.push_back(std::move(action));
+      Result.PassCount += 1;
+    }
+  }
+  CATCH_CPP_RETURN_HRESULT();
+
+  return S_OK;
+}
+
+static HRESULT RunParsedPipeline(IMalloc *pMalloc,
+                                 const ParsedPipeline &Pipeline,
+                                 IDxcBlob *pBlob,
+                                 _COM_Outptr_ IDxcBlob **ppOutputModule,
+                                 _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) {
+  // Setup input buffer.
+  //
+  // The ir parsing requires the buffer to be null terminated. We deal with
+  // both source and bitcode input, so the input buffer may not be null
+  // terminated; we create a new membuf that copies and appends for this.
+  //
+  // If we have the beginning of a DXIL program header, skip to the bitcode.
+  //
+  LLVMContext Context;
+  SMDiagnostic Err;
+  std::unique_ptr<MemoryBuffer> memBuf;
+  std::unique_ptr<Module> M;
+  const char * pBlobContent = reinterpret_cast<const char *>(pBlob->GetBufferPointer());
+  unsigned blobSize = pBlob->GetBufferSize();
+  const DxilProgramHeader *pProgramHeader =
+    reinterpret_cast<const DxilProgramHeader *>(pBlobContent);
+  if (IsValidDxilProgramHeader(pProgramHeader, blobSize)) {
+    std::string DiagStr;
+    GetDxilProgramBitcode(pProgramHeader, &pBlobContent, &blobSize);
+    M = hlsl::dxilutil::LoadModuleFromBitcode(
+      llvm::StringRef(pBlobContent, blobSize), Context, DiagStr);
+  }
+  else {
+    StringRef bufStrRef(pBlobContent, blobSize);
+    memBuf = MemoryBuffer::getMemBufferCopy(bufStrRef);
+    M = parseIR(memBuf->getMemBufferRef(), Err, Context);
+  }
+
+  if (M == nullptr) {
+    return DXC_E_IR_VERIFICATION_FAILED;
+  }
+
+  legacy::PassManager ModulePasses;
+  legacy::FunctionPassManager FunctionPasses(M.get());
+  legacy::PassManagerBase *pPassManager = &ModulePasses;
+
+  try {
+    CComPtr<AbstractMemoryStream> pOutputStream;
+    CComPtr<IDxcBlob> pOutputBlob;
+
+    IFT(CreateMemoryStream(pMalloc, &pOutputStream));
+    IFT(pOutputStream.QueryInterface(&pOutputBlob));
+
+    raw_stream_ostream outStream(pOutputStream.p);
+
+    //
+    // Consider some differences from opt.exe:
+    //
+    // Create a new optimization pass for each one specified on the command line
+    // as in StandardLinkOpts, OptLevelO1, etc.
+    // No target machine, and so no passes get their target machine ctor called.
+    // No print-after-each-pass option.
+    // No printing of the pass options.
+    // No StripDebug support.
+    // No verifyModule before starting.
+    // Use of PassPipeline for new manager.
+    // No TargetInfo.
+    // No DataLayout.
+    //
+    SmallVector<PassOption, 2> options;
+    for (const ParsedPipelineAction &action : Pipeline.Actions) {
+      switch (action.ActionKind) {
+      case ParsedPipelineAction::Kind::PrintModule:
+        if (pPassManager == &ModulePasses)
+          pPassManager->add(llvm::createPrintModulePass(outStream, action.Banner));
+        break;
+      case ParsedPipelineAction::Kind::UseFunctionPasses:
+        pPassManager = &FunctionPasses;
+        break;
+      case ParsedPipelineAction::Kind::UseModulePasses:
+        pPassManager = &ModulePasses;
+        break;
+      case ParsedPipelineAction::Kind::AddPass: {
+        const PassInfo *PassInf = action.PassInf;
+        options.clear();
+        for (const std::pair<std::string, std::string> &option : action.Options) {
+          options.push_back(PassOption(StringRef(option.first),
+                                       StringRef(option.second)));
         }
+        DXASSERT(PassInf->getNormalCtor(), "else pass with no default .ctor was added");
+        Pass *pass = PassInf->getNormalCtor()();
+        pass->setOSOverride(&outStream);
+        pass->applyOptions(options);
+        pPassManager->add(pass);
+        if (Pipeline.AnalyzeOnly) {
+          const bool Quiet = false;
+          PassKind Kind = pass->getPassKind();
+          switch (Kind) {
+          case PT_BasicBlock:
+            pPassManager->add(createBasicBlockPassPrinter(PassInf, outStream, Quiet));
+            break;
+          case PT_Region:
+            pPassManager->add(createRegionPassPrinter(PassInf, outStream, Quiet));
+            break;
+          case PT_Loop:
+            pPassManager->add(createLoopPassPrinter(PassInf, outStream, Quiet));
+            break;
+          case PT_Function:
+            pPassManager->add(createFunctionPassPrinter(PassInf, outStream, Quiet));
+            break;
+          case PT_CallGraphSCC:
+            pPassManager->add(createCallGraphPassPrinter(PassInf, outStream, Quiet));
+            break;
+          default:
+            pPassManager->add(createModulePassPrinter(PassInf, outStream, Quiet));
+            break;
+          }
+        }
+      } break;
       }
     }
 
     ModulePasses.add(createVerifierPass());
 
-    if (OutputAssembly) {
+    if (Pipeline.OutputAssembly) {
       ModulePasses.add(llvm::createPrintModulePass(outStream));
     }
 
@@ -830,7 +971,7 @@ HRESULT STDMETHODCALLTYPE DxcOptimizer::RunOptimizer(
     }
     if (ppOutputModule != nullptr) {
       CComPtr<AbstractMemoryStream> pProgramStream;
-      IFT(CreateMemoryStream(m_pMalloc, &pProgramStream));
+      IFT(CreateMemoryStream(pMalloc, &pProgramStream));
       {
         raw_stream_ostream outStream(pProgramStream.p);
         WriteBitcodeToFile(M.get(), outStream, true);
@@ -843,6 +984,40 @@ HRESULT STDMETHODCALLTYPE DxcOptimizer::RunOptimizer(
   return S_OK;
 }
 
+HRESULT STDMETHODCALLTYPE DxcOptimizer::RunOptimizer(
+    IDxcBlob *pBlob, _In_count_(optionCount) LPCWSTR *ppOptions,
+    UINT32 optionCount, _COM_Outptr_ IDxcBlob **ppOutputModule,
+    _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) {
+  AssignToOutOpt(nullptr, ppOutputModule);
+  AssignToOutOpt(nullptr, ppOutputText);
+  if (pBlob == nullptr)
+    return E_POINTER;
+  if (optionCount > 0 && ppOptions == nullptr)
+    return E_POINTER;
+
+  DxcThreadMalloc TM(m_pMalloc);
+
+  ParsedPipeline pipeline;
+  IFR(ParsePassPipeline(ppOptions, optionCount, pipeline));
+  return RunParsedPipeline(m_pMalloc, pipeline, pBlob, ppOutputModule,
+                           ppOutputText);
+}
+
+HRESULT STDMETHODCALLTYPE DxcOptimizer::CompilePipeline(
+    _In_count_(optionCount) LPCWSTR *ppOptions, UINT32 optionCount,
+    _COM_Outptr_ IDxcOptimizerPipeline **ppPipeline) {
+  IFR(AssignToOut(nullptr, ppPipeline));
+  if (optionCount > 0 && ppOptions == nullptr)
+    return E_POINTER;
+
+  DxcThreadMalloc TM(m_pMalloc);
+
+  ParsedPipeline pipeline;
+  IFR(ParsePassPipeline(ppOptions, optionCount, pipeline));
+  return DxcOptimizerPipeline::Create(m_pMalloc, std::move(pipeline),
+                                      ppPipeline);
+}
+
 HRESULT CreateDxcOptimizer(_In_ REFIID riid, _Out_ LPVOID *ppv) {
   CComPtr<DxcOptimizer> result = DxcOptimizer::Alloc(DxcGetThreadMallocNoRef());
   if (result == nullptr) {
@@ -316,31 +316,28 @@ private:
 };
 
 void DxilCondenseResources::ApplyRewriteMap(DxilModule &DM) {
-  for (Function &F : DM.GetModule()->functions()) {
-    if (F.isDeclaration()) {
+  // Handle-creation sites are exactly the users of the dx.op.createHandle
+  // declaration, so walk its use list directly instead of scanning every
+  // instruction in the module.
+  Function *createHandle = DM.GetOP()->GetOpFunc(DXIL::OpCode::CreateHandle,
+                                                 Type::getVoidTy(DM.GetCtx()));
+
+  for (User *U : createHandle->users()) {
+    CallInst *CI = cast<CallInst>(U);
+    DxilInst_CreateHandle CH(CI);
+
+    ResourceID RId;
+    RId.Class = (DXIL::ResourceClass)CH.get_resourceClass_val();
+    RId.ID = (unsigned)llvm::dyn_cast<llvm::ConstantInt>(CH.get_rangeId())
+                 ->getZExtValue();
+    RemapEntryCollection::iterator it = m_rewrites.find(RId);
+    if (it == m_rewrites.end()) {
       continue;
     }
 
-    for (inst_iterator iter = inst_begin(F), E = inst_end(F); iter != E; ++iter) {
-      llvm::Instruction &I = *iter;
-      DxilInst_CreateHandle CH(&I);
-      if (!CH)
-        continue;
-
-      ResourceID RId;
-      RId.Class = (DXIL::ResourceClass)CH.get_resourceClass_val();
-      RId.ID = (unsigned)llvm::dyn_cast<llvm::ConstantInt>(CH.get_rangeId())
-                   ->getZExtValue();
-      RemapEntryCollection::iterator it = m_rewrites.find(RId);
-      if (it == m_rewrites.end()) {
-        continue;
-      }
-
-      CallInst *CI = cast<CallInst>(&I);
-      Value *newRangeID = DM.GetOP()->GetU32Const(it->second.Index);
-      CI->setArgOperand(DXIL::OperandIndex::kCreateHandleResIDOpIdx,
-                        newRangeID);
-    }
+    Value *newRangeID = DM.GetOP()->GetU32Const(it->second.Index);
+    CI->setArgOperand(DXIL::OperandIndex::kCreateHandleResIDOpIdx,
+                      newRangeID);
   }
 
   ApplyRewriteMapOnResTable(m_rewrites, DM);
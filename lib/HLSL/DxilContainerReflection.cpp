@@ -87,6 +87,21 @@ public:
 class CShaderReflectionConstantBuffer;
 class CShaderReflectionType;
 
+// Memoized member expansion for a struct type. The same layout is typically
+// reflected many times over - once per cbuffer variable and once per nested
+// field that uses it - and the expansion depends only on the llvm type and
+// the buffer kind, so repeated uses share one reflected subtree instead of
+// rebuilding it field by field. The cache lives on the reflection object, so
+// every cached subtree is owned by (and dies with) its m_Types vector.
+struct StructMemberExpansion {
+  std::vector<StringRef> MemberNames;
+  std::vector<CShaderReflectionType *> MemberTypes;
+  UINT Columns;
+  UINT SizeInCBuffer; // Size of a single element, before array replication.
+};
+typedef std::map<std::pair<llvm::StructType *, bool>, StructMemberExpansion>
+    StructMemberCache;
+
 enum class PublicAPI { D3D12 = 0, D3D11_47 = 1, D3D11_43 = 2 };
 
 #ifdef ADD_16_64_BIT_TYPES
@@ -99,14 +114,17 @@ enum class PublicAPI { D3D12 = 0, D3D11_47 = 1, D3D11_43 = 2 };
 
 class DxilModuleReflection {
 public:
+  CComPtr<IDxcBlob> m_pContainer; // Pins part bytes when the module is loaded zero-copy.
   hlsl::RDAT::DxilRuntimeData m_RDAT;
   LLVMContext Context;
   std::unique_ptr<Module> m_pModule; // Must come after LLVMContext, otherwise unique_ptr will over-delete.
   DxilModule *m_pDxilModule = nullptr;
   bool m_bUsageInMetadata = false;
+  DxilCounters m_Counters = {};
   std::vector<std::unique_ptr<CShaderReflectionConstantBuffer>>    m_CBs;
   std::vector<D3D12_SHADER_INPUT_BIND_DESC>       m_Resources;
   std::vector<std::unique_ptr<CShaderReflectionType>> m_Types;
+  StructMemberCache m_StructCache;
   std::map<std::string, UINT> m_CBsByName;
   // Due to the possibility of overlapping names between CB and other resources,
   // m_StructuredBufferCBsByName is the index into m_CBs corresponding to
@@ -132,9 +150,13 @@ public:
   HRESULT _GetResourceBindingDescByName(LPCSTR Name,
                                         D3D12_SHADER_INPUT_BIND_DESC *pDesc,
                                         PublicAPI api = PublicAPI::D3D12);
+
+  HRESULT _GetCounterValue(LPCSTR pCounterName, UINT32 *pValue);
 };
 
-class DxilShaderReflection : public DxilModuleReflection, public ID3D12ShaderReflection {
+class DxilShaderReflection : public DxilModuleReflection,
+                             public ID3D12ShaderReflection,
+                             public IDxcShaderStatistics {
 private:
   DXC_MICROCOM_TM_REF_FIELDS()
   std::vector<D3D12_SIGNATURE_PARAMETER_DESC>     m_InputSignature;
@@ -164,7 +186,8 @@ public:
   DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
   DXC_MICROCOM_TM_CTOR(DxilShaderReflection)
   HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) {
-    HRESULT hr = DoBasicQueryInterface<ID3D12ShaderReflection>(this, iid, ppvObject);
+    HRESULT hr = DoBasicQueryInterface<ID3D12ShaderReflection,
+                                       IDxcShaderStatistics>(this, iid, ppvObject);
     if (hr == E_NOINTERFACE) {
       // ID3D11ShaderReflection is identical to ID3D12ShaderReflection, except
       // for some shorter data structures in some out parameters.
@@ -218,10 +241,17 @@ public:
     _Out_opt_ UINT* pSizeZ);
 
   STDMETHODIMP_(UINT64) GetRequiresFlags(THIS);
+
+  // IDxcShaderStatistics
+  STDMETHODIMP GetCounterValue(_In_z_ LPCSTR pCounterName, _Out_ UINT32 *pValue) {
+    return _GetCounterValue(pCounterName, pValue);
+  }
 };
 
 class CFunctionReflection;
-class DxilLibraryReflection : public DxilModuleReflection, public ID3D12LibraryReflection {
+class DxilLibraryReflection : public DxilModuleReflection,
+                              public ID3D12LibraryReflection,
+                              public IDxcShaderStatistics {
 private:
   DXC_MICROCOM_TM_REF_FIELDS()
 
@@ -240,7 +270,8 @@ public:
   DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
   DXC_MICROCOM_TM_CTOR(DxilLibraryReflection)
   HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) {
-    return DoBasicQueryInterface<ID3D12LibraryReflection>(this, iid, ppvObject);
+    return DoBasicQueryInterface<ID3D12LibraryReflection,
+                                 IDxcShaderStatistics>(this, iid, ppvObject);
   }
 
   HRESULT Load(const DxilPartHeader *pModulePart, const DxilPartHeader *pDXILPart);
@@ -249,14 +280,23 @@ public:
   STDMETHOD(GetDesc)(THIS_ _Out_ D3D12_LIBRARY_DESC * pDesc);
 
   STDMETHOD_(ID3D12FunctionReflection *, GetFunctionByIndex)(THIS_ _In_ INT FunctionIndex);
+
+  // IDxcShaderStatistics
+  STDMETHODIMP GetCounterValue(_In_z_ LPCSTR pCounterName, _Out_ UINT32 *pValue) {
+    return _GetCounterValue(pCounterName, pValue);
+  }
 };
 
 namespace hlsl {
-HRESULT CreateDxilShaderReflection(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject) {
+// pContainer, when provided, is the blob the part headers point into; the
+// reflection object retains it so the module can reference the bitcode bytes
+// in place instead of copying them.
+HRESULT CreateDxilShaderReflection(IDxcBlob *pContainer, const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject) {
   if (!ppvObject)
     return E_INVALIDARG;
   CComPtr<DxilShaderReflection> pReflection = DxilShaderReflection::Alloc(DxcGetThreadMallocNoRef());
   IFROOM(pReflection.p);
+  pReflection->m_pContainer = pContainer;
   PublicAPI api = DxilShaderReflection::IIDToAPI(iid);
   pReflection->SetPublicAPI(api);
   // pRDATPart to be used for transition.
@@ -264,11 +304,12 @@ HRESULT CreateDxilShaderReflection(const DxilPartHeader *pModulePart, const Dxil
   IFR(pReflection.p->QueryInterface(iid, ppvObject));
   return S_OK;
 }
-HRESULT CreateDxilLibraryReflection(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject) {
+HRESULT CreateDxilLibraryReflection(IDxcBlob *pContainer, const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject) {
   if (!ppvObject)
     return E_INVALIDARG;
   CComPtr<DxilLibraryReflection> pReflection = DxilLibraryReflection::Alloc(DxcGetThreadMallocNoRef());
   IFROOM(pReflection.p);
+  pReflection->m_pContainer = pContainer;
   // pRDATPart used for resource usage per-function.
   IFR(pReflection->Load(pModulePart, pRDATPart));
   IFR(pReflection.p->QueryInterface(iid, ppvObject));
@@ -399,9 +440,9 @@ HRESULT DxilContainerReflection::GetPartReflection(UINT32 idx, REFIID iid, void
 
   DXIL::ShaderKind SK = GetVersionShaderType(pProgramHeader->ProgramVersion);
   if (SK == DXIL::ShaderKind::Library) {
-    IFC(hlsl::CreateDxilLibraryReflection(pPart, pRDATPart, iid, ppvObject));
+    IFC(hlsl::CreateDxilLibraryReflection(m_container, pPart, pRDATPart, iid, ppvObject));
   } else {
-    IFC(hlsl::CreateDxilShaderReflection(pPart, pRDATPart, iid, ppvObject));
+    IFC(hlsl::CreateDxilShaderReflection(m_container, pPart, pRDATPart, iid, ppvObject));
   }
 
 Cleanup:
@@ -445,6 +486,7 @@ public:
     DxilFieldAnnotation     &typeAnnotation,
     unsigned int            baseOffset,
     std::vector<std::unique_ptr<CShaderReflectionType>>& allTypes,
+    StructMemberCache       &structCache,
     bool                    isCBuffer);
 
   // ID3D12ShaderReflectionType
@@ -511,13 +553,16 @@ public:
   void Initialize(DxilModule &M,
                   DxilCBuffer &CB,
                   std::vector<std::unique_ptr<CShaderReflectionType>>& allTypes,
+                  StructMemberCache &structCache,
                   bool bUsageInMetadata);
   void InitializeStructuredBuffer(DxilModule &M,
                                   DxilResource &R,
-                                  std::vector<std::unique_ptr<CShaderReflectionType>>& allTypes);
+                                  std::vector<std::unique_ptr<CShaderReflectionType>>& allTypes,
+                                  StructMemberCache &structCache);
   void InitializeTBuffer(DxilModule &M,
                          DxilResource &R,
                          std::vector<std::unique_ptr<CShaderReflectionType>>& allTypes,
+                         StructMemberCache &structCache,
                          bool bUsageInMetadata);
   LPCSTR GetName() { return m_Desc.Name; }
 
@@ -837,6 +882,7 @@ HRESULT CShaderReflectionType::Initialize(
   DxilFieldAnnotation     &typeAnnotation,
   unsigned int            baseOffset,
   std::vector<std::unique_ptr<CShaderReflectionType>>& allTypes,
+  StructMemberCache       &structCache,
   bool                    isCBuffer)
 {
   DXASSERT_NOMSG(inType);
@@ -1091,59 +1137,81 @@ HRESULT CShaderReflectionType::Initialize(
       DxilTypeSystem &typeSys = M.GetTypeSystem();
       DxilStructAnnotation *structAnnotation = typeSys.GetStructAnnotation(structType);
 
-      // There is no annotation for empty structs
-      unsigned int fieldCount = 0;
-      if (structAnnotation)
-        fieldCount = type->getStructNumElements();
-
-      // The DXBC reflection info computes `Columns` for a
-      // `struct` type from the fields (see below)
-      UINT columnCounter = 0;
+      // If we have already expanded this struct's fields - for another
+      // variable, field, or array of the same layout - reuse that subtree
+      // rather than rebuilding it. Per-use state (offset, element count,
+      // name) stays on this object, so sharing the members is safe.
+      std::pair<llvm::StructType *, bool> cacheKey(structType, isCBuffer);
+      auto cachedExpansion = structCache.find(cacheKey);
+      if (cachedExpansion != structCache.end()) {
+        const StructMemberExpansion &expansion = cachedExpansion->second;
+        m_MemberTypes = expansion.MemberTypes;
+        m_MemberNames = expansion.MemberNames;
+        m_Desc.Columns = expansion.Columns;
+        m_SizeInCBuffer = expansion.SizeInCBuffer;
+      } else {
+        // There is no annotation for empty structs
+        unsigned int fieldCount = 0;
+        if (structAnnotation)
+          fieldCount = type->getStructNumElements();
+
+        // The DXBC reflection info computes `Columns` for a
+        // `struct` type from the fields (see below)
+        UINT columnCounter = 0;
+
+        CShaderReflectionType *fieldReflectionType = nullptr;
+
+        for(unsigned int ff = 0; ff < fieldCount; ++ff)
+        {
+          DxilFieldAnnotation& fieldAnnotation = structAnnotation->GetFieldAnnotation(ff);
+          llvm::Type* fieldType = structType->getStructElementType(ff);
+
+          // Skip fields with object types, since these are not part of constant buffers,
+          // and are not allowed in other buffer types.
+          if( IsObjectType(fieldType) )
+          {
+            continue;
+          }
 
-      CShaderReflectionType *fieldReflectionType = nullptr;
+          fieldReflectionType = new CShaderReflectionType();
+          allTypes.push_back(std::unique_ptr<CShaderReflectionType>(fieldReflectionType));
 
-      for(unsigned int ff = 0; ff < fieldCount; ++ff)
-      {
-        DxilFieldAnnotation& fieldAnnotation = structAnnotation->GetFieldAnnotation(ff);
-        llvm::Type* fieldType = structType->getStructElementType(ff);
+          unsigned int elementOffset = structLayout ? (unsigned int)structLayout->getElementOffset(ff) : 0;
 
-        // Skip fields with object types, since these are not part of constant buffers,
-        // and are not allowed in other buffer types.
-        if( IsObjectType(fieldType) )
-        {
-          continue;
-        }
+          fieldReflectionType->Initialize(M, fieldType, fieldAnnotation, elementOffset, allTypes, structCache, isCBuffer);
 
-        fieldReflectionType = new CShaderReflectionType();
-        allTypes.push_back(std::unique_ptr<CShaderReflectionType>(fieldReflectionType));
+          m_MemberTypes.push_back(fieldReflectionType);
+          m_MemberNames.push_back(fieldAnnotation.GetFieldName().c_str());
 
-        unsigned int elementOffset = structLayout ? (unsigned int)structLayout->getElementOffset(ff) : 0;
+          // Effectively, we want to add one to `Columns` for every scalar nested recursively
+          // inside this `struct` type (ignoring objects, which we filtered above). We should
+          // be able to compute this as the product of the `Columns`, `Rows` and `Elements`
+          // of each field, with the caveat that some of these may be zero, but shoud be
+          // treated as one.
+          columnCounter +=
+              (fieldReflectionType->m_Desc.Columns  ? fieldReflectionType->m_Desc.Columns  : 1)
+            * (fieldReflectionType->m_Desc.Rows     ? fieldReflectionType->m_Desc.Rows     : 1)
+            * (fieldReflectionType->m_Desc.Elements ? fieldReflectionType->m_Desc.Elements : 1);
+        }
 
-        fieldReflectionType->Initialize(M, fieldType, fieldAnnotation, elementOffset, allTypes, isCBuffer);
+        m_Desc.Columns = columnCounter;
 
-        m_MemberTypes.push_back(fieldReflectionType);
-        m_MemberNames.push_back(fieldAnnotation.GetFieldName().c_str());
+        if (fieldReflectionType) {
+          // Set our size based on the last fields offset + size:
+          m_SizeInCBuffer = fieldReflectionType->m_Desc.Offset + fieldReflectionType->m_SizeInCBuffer;
+        }
 
-        // Effectively, we want to add one to `Columns` for every scalar nested recursively
-        // inside this `struct` type (ignoring objects, which we filtered above). We should
-        // be able to compute this as the product of the `Columns`, `Rows` and `Elements`
-        // of each field, with the caveat that some of these may be zero, but shoud be
-        // treated as one.
-        columnCounter +=
-            (fieldReflectionType->m_Desc.Columns  ? fieldReflectionType->m_Desc.Columns  : 1)
-          * (fieldReflectionType->m_Desc.Rows     ? fieldReflectionType->m_Desc.Rows     : 1)
-          * (fieldReflectionType->m_Desc.Elements ? fieldReflectionType->m_Desc.Elements : 1);
+        // Remember the single-element expansion for later uses of this type.
+        StructMemberExpansion &expansion = structCache[cacheKey];
+        expansion.MemberTypes = m_MemberTypes;
+        expansion.MemberNames = m_MemberNames;
+        expansion.Columns = m_Desc.Columns;
+        expansion.SizeInCBuffer = m_SizeInCBuffer;
       }
 
-      m_Desc.Columns = columnCounter;
-
-      if (fieldReflectionType) {
-        // Set our size based on the last fields offset + size:
-        m_SizeInCBuffer = fieldReflectionType->m_Desc.Offset + fieldReflectionType->m_SizeInCBuffer;
-        if (m_Desc.Elements > 1) {
-          unsigned alignedSize = ((m_SizeInCBuffer + 15) & ~0xF);
-          m_SizeInCBuffer += (m_Desc.Elements - 1) * alignedSize;
-        }
+      if (m_SizeInCBuffer && m_Desc.Elements > 1) {
+        unsigned alignedSize = ((m_SizeInCBuffer + 15) & ~0xF);
+        m_SizeInCBuffer += (m_Desc.Elements - 1) * alignedSize;
       }
 
       // Because we might have skipped fields during enumeration,
@@ -1214,6 +1282,7 @@ void CShaderReflectionConstantBuffer::Initialize(
   DxilModule &M,
   DxilCBuffer &CB,
   std::vector<std::unique_ptr<CShaderReflectionType>>& allTypes,
+  StructMemberCache &structCache,
   bool bUsageInMetadata) {
   ZeroMemory(&m_Desc, sizeof(m_Desc));
   m_Desc.Name = CB.GetGlobalName().c_str();
@@ -1254,7 +1323,7 @@ void CShaderReflectionConstantBuffer::Initialize(
     //Create reflection type.
     CShaderReflectionType *pVarType = new CShaderReflectionType();
     allTypes.push_back(std::unique_ptr<CShaderReflectionType>(pVarType));
-    pVarType->Initialize(M, ST->getContainedType(i), fieldAnnotation, fieldAnnotation.GetCBufferOffset(), allTypes, true);
+    pVarType->Initialize(M, ST->getContainedType(i), fieldAnnotation, fieldAnnotation.GetCBufferOffset(), allTypes, structCache, true);
 
     // Replicate fxc bug, where Elements == 1 for inner struct of CB array, instead of 0.
     if (CB.GetRangeSize() > 1) {
@@ -1317,7 +1386,8 @@ static unsigned CalcResTypeSize(DxilModule &M, DxilResource &R) {
 void CShaderReflectionConstantBuffer::InitializeStructuredBuffer(
   DxilModule &M,
   DxilResource &R,
-  std::vector<std::unique_ptr<CShaderReflectionType>>& allTypes) {
+  std::vector<std::unique_ptr<CShaderReflectionType>>& allTypes,
+  StructMemberCache &structCache) {
   ZeroMemory(&m_Desc, sizeof(m_Desc));
   m_ReflectionName = R.GetGlobalName();
   m_Desc.Type = D3D11_CT_RESOURCE_BIND_INFO;
@@ -1364,7 +1434,7 @@ void CShaderReflectionConstantBuffer::InitializeStructuredBuffer(
     Type *fieldType = ST->getElementType(0);
     DxilFieldAnnotation &fieldAnnotation = annotation->GetFieldAnnotation(0);
 
-    pVarType->Initialize(M, fieldType, fieldAnnotation, 0, allTypes, false);
+    pVarType->Initialize(M, fieldType, fieldAnnotation, 0, allTypes, structCache, false);
   }
 
   BYTE *pDefaultValue = nullptr;
@@ -1378,6 +1448,7 @@ void CShaderReflectionConstantBuffer::InitializeTBuffer(
     DxilModule &M,
     DxilResource &R,
     std::vector<std::unique_ptr<CShaderReflectionType>>& allTypes,
+    StructMemberCache &structCache,
     bool bUsageInMetadata) {
   ZeroMemory(&m_Desc, sizeof(m_Desc));
   m_ReflectionName = R.GetGlobalName();
@@ -1411,7 +1482,7 @@ void CShaderReflectionConstantBuffer::InitializeTBuffer(
     //Create reflection type.
     CShaderReflectionType *pVarType = new CShaderReflectionType();
     allTypes.push_back(std::unique_ptr<CShaderReflectionType>(pVarType));
-    pVarType->Initialize(M, ST->getContainedType(i), fieldAnnotation, fieldAnnotation.GetCBufferOffset(), allTypes, true);
+    pVarType->Initialize(M, ST->getContainedType(i), fieldAnnotation, fieldAnnotation.GetCBufferOffset(), allTypes, structCache, true);
 
     BYTE *pDefaultValue = nullptr;
 
@@ -1810,7 +1881,7 @@ void DxilModuleReflection::CreateReflectionObjects() {
   // Create constant buffers, resources and signatures.
   for (auto && cb : m_pDxilModule->GetCBuffers()) {
     std::unique_ptr<CShaderReflectionConstantBuffer> rcb(new CShaderReflectionConstantBuffer());
-    rcb->Initialize(*m_pDxilModule, *(cb.get()), m_Types, m_bUsageInMetadata);
+    rcb->Initialize(*m_pDxilModule, *(cb.get()), m_Types, m_StructCache, m_bUsageInMetadata);
     m_CBsByName[rcb->GetName()] = (UINT)m_CBs.size();
     m_CBs.emplace_back(std::move(rcb));
   }
@@ -1821,7 +1892,7 @@ void DxilModuleReflection::CreateReflectionObjects() {
       continue;
     }
     std::unique_ptr<CShaderReflectionConstantBuffer> rcb(new CShaderReflectionConstantBuffer());
-    rcb->InitializeStructuredBuffer(*m_pDxilModule, *(uav.get()), m_Types);
+    rcb->InitializeStructuredBuffer(*m_pDxilModule, *(uav.get()), m_Types, m_StructCache);
     m_StructuredBufferCBsByName[rcb->GetName()] = (UINT)m_CBs.size();
     m_CBs.emplace_back(std::move(rcb));
   }
@@ -1832,10 +1903,10 @@ void DxilModuleReflection::CreateReflectionObjects() {
     }
     std::unique_ptr<CShaderReflectionConstantBuffer> rcb(new CShaderReflectionConstantBuffer());
     if (srv->GetKind() == DxilResource::Kind::TBuffer) {
-      rcb->InitializeTBuffer(*m_pDxilModule, *(srv.get()), m_Types, m_bUsageInMetadata);
+      rcb->InitializeTBuffer(*m_pDxilModule, *(srv.get()), m_Types, m_StructCache, m_bUsageInMetadata);
       m_CBsByName[rcb->GetName()] = (UINT)m_CBs.size();
     } else {
-      rcb->InitializeStructuredBuffer(*m_pDxilModule, *(srv.get()), m_Types);
+      rcb->InitializeStructuredBuffer(*m_pDxilModule, *(srv.get()), m_Types, m_StructCache);
       m_StructuredBufferCBsByName[rcb->GetName()] = (UINT)m_CBs.size();
     }
     m_CBs.emplace_back(std::move(rcb));
@@ -2046,19 +2117,28 @@ HRESULT DxilModuleReflection::LoadModule(const DxilPartHeader *pShaderPart) {
     const char *pBitcode;
     uint32_t bitcodeLength;
     GetDxilProgramBitcode((DxilProgramHeader *)pData, &pBitcode, &bitcodeLength);
-    std::unique_ptr<MemoryBuffer> pMemBuffer =
-        MemoryBuffer::getMemBufferCopy(StringRef(pBitcode, bitcodeLength));
+    // When the container blob is retained on this object, hand the bitcode
+    // bytes to the reader in place instead of copying them; the blob reference
+    // keeps them alive for the lifetime of m_pModule. Without a retained blob
+    // (e.g. reflection created from a raw buffer), copy as before.
+    std::unique_ptr<MemoryBuffer> pMemBuffer;
+    if (m_pContainer != nullptr) {
+      pMemBuffer = MemoryBuffer::getMemBuffer(StringRef(pBitcode, bitcodeLength),
+                                              "", /*RequiresNullTerminator=*/false);
+    } else {
+      pMemBuffer = MemoryBuffer::getMemBufferCopy(StringRef(pBitcode, bitcodeLength));
+    }
     bool bBitcodeLoadError = false;
     auto errorHandler = [&bBitcodeLoadError](const DiagnosticInfo &diagInfo) {
         bBitcodeLoadError |= diagInfo.getSeverity() == DS_Error;
       };
-#if 0 // We materialize eagerly, because we'll need to walk instructions to look for usage information.
+    // Reflection is served from metadata (resources, signatures, type
+    // annotations, counters), so load the module lazily and skip parsing
+    // function bodies. Only when usage is not recorded in metadata do the
+    // usage walks below need instructions, in which case everything is
+    // materialized up front.
     ErrorOr<std::unique_ptr<Module>> mod =
         getLazyBitcodeModule(std::move(pMemBuffer), Context, errorHandler);
-#else
-    ErrorOr<std::unique_ptr<Module>> mod =
-      parseBitcodeFile(pMemBuffer->getMemBufferRef(), Context, errorHandler);
-#endif
     if (!mod || bBitcodeLoadError) {
       return E_INVALIDARG;
     }
@@ -2068,6 +2148,13 @@ HRESULT DxilModuleReflection::LoadModule(const DxilPartHeader *pShaderPart) {
     unsigned ValMajor, ValMinor;
     m_pDxilModule->GetValidatorVersion(ValMajor, ValMinor);
     m_bUsageInMetadata = hlsl::DXIL::CompareVersions(ValMajor, ValMinor, 1, 5) >= 0;
+    if (!m_bUsageInMetadata) {
+      if (std::error_code ec = m_pModule->materializeAll()) {
+        return E_INVALIDARG;
+      }
+    }
+
+    m_pDxilModule->LoadDxilCounters(m_Counters);
 
     CreateReflectionObjects();
     return S_OK;
@@ -2075,6 +2162,17 @@ HRESULT DxilModuleReflection::LoadModule(const DxilPartHeader *pShaderPart) {
   CATCH_CPP_RETURN_HRESULT();
 };
 
+HRESULT DxilModuleReflection::_GetCounterValue(LPCSTR pCounterName,
+                                               UINT32 *pValue) {
+  if (pCounterName == nullptr || pValue == nullptr)
+    return E_POINTER;
+  uint32_t *pCounter = LookupByName(pCounterName, m_Counters);
+  if (pCounter == nullptr)
+    return E_INVALIDARG;
+  *pValue = *pCounter;
+  return S_OK;
+}
+
 HRESULT DxilShaderReflection::Load(const DxilPartHeader *pModulePart,
                                    const DxilPartHeader *pRDATPart) {
   IFR(LoadRDAT(pRDATPart));
@@ -2241,8 +2339,7 @@ void DxilShaderReflection::InitDesc() {
   pDesc->TessellatorDomain = (D3D_TESSELLATOR_DOMAIN)M.GetTessellatorDomain();
 
   // Instruction counts only roughly track some fxc counters
-  DxilCounters counters = {};
-  m_pDxilModule->LoadDxilCounters(counters);
+  DxilCounters &counters = m_Counters;
 
   // UINT InstructionCount;               // Num llvm instructions in all functions
   // UINT TempArrayCount;                 // Number of bytes used in arrays (alloca + static global)
@@ -2751,6 +2848,7 @@ void hlsl::CreateDxcContainerReflection(IDxcContainerReflection **ppResult) {
 }
 
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcContainerReflection)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcShaderStatistics)
 
 #endif // LLVM_ON_WIN32
 
@@ -102,7 +102,15 @@ bool DxilEliminateOutputDynamicIndexing::EliminateDynamicOutput(
   auto &storeOutputs =
       hlslOP->GetOpFuncList(opcode);
 
-  MapVector<Value *, Type *> dynamicSigSet;
+  bool bUpdated = false;
+  // For each dynamically indexed sigID, remember the element type and which
+  // columns actually have a dynamic store. Columns that are only ever stored
+  // with constant rows don't need a temporary array or a copy-out.
+  struct DynamicSigInfo {
+    Type *EltTy;
+    unsigned ColMask;
+  };
+  MapVector<Value *, DynamicSigInfo> dynamicSigSet;
   for (auto it : storeOutputs) {
     Function *F = it.second;
     // Skip overload not used.
@@ -114,13 +122,24 @@ bool DxilEliminateOutputDynamicIndexing::EliminateDynamicOutput(
       // Save dynamic indeed sigID.
       if (!isa<ConstantInt>(store.get_rowIndex())) {
         Value *sigID = store.get_outputSigId();
-        dynamicSigSet[sigID] = store.get_value()->getType();
+        unsigned ID = cast<ConstantInt>(sigID)->getLimitedValue();
+        if (outputSig.GetElement(ID).GetRows() == 1) {
+          // A single-row element can only be indexed in-bounds at row 0, so
+          // the store doesn't need expansion at all.
+          CI->setArgOperand(DXIL::OperandIndex::kStoreOutputRowOpIdx,
+                            ConstantInt::get(store.get_rowIndex()->getType(), 0));
+          bUpdated = true;
+          continue;
+        }
+        auto &info = dynamicSigSet[sigID];
+        info.EltTy = store.get_value()->getType();
+        info.ColMask |= 1u << store.get_colIndex();
       }
     }
   }
 
   if (dynamicSigSet.empty())
-    return false;
+    return bUpdated;
 
   IRBuilder<> AllocaBuilder(dxilutil::FindAllocaInsertionPt(Entry));
 
@@ -129,17 +148,21 @@ bool DxilEliminateOutputDynamicIndexing::EliminateDynamicOutput(
 
   for (auto sig : dynamicSigSet) {
     Value *sigID = sig.first;
-    Type *EltTy = sig.second;
+    Type *EltTy = sig.second.EltTy;
     unsigned ID = cast<ConstantInt>(sigID)->getLimitedValue();
     DxilSignatureElement &sigElt = outputSig.GetElement(ID);
     unsigned row = sigElt.GetRows();
     unsigned col = sigElt.GetCols();
     Type *AT = ArrayType::get(EltTy, row);
 
+    // Only expand the columns which have a dynamic store; stores to the other
+    // columns all use constant rows and can stay where they are.
     std::vector<Value *> tmpSigElts(col);
     for (unsigned c = 0; c < col; c++) {
-      Value *newCol = AllocaBuilder.CreateAlloca(AT);
-      tmpSigElts[c] = newCol;
+      if (sig.second.ColMask & (1u << c)) {
+        Value *newCol = AllocaBuilder.CreateAlloca(AT);
+        tmpSigElts[c] = newCol;
+      }
     }
 
     Function *F = hlslOP->GetOpFunc(opcode, EltTy);
@@ -159,6 +182,9 @@ void DxilEliminateOutputDynamicIndexing::ReplaceDynamicOutput(
     if (sigID == store.get_outputSigId()) {
       uint64_t col = store.get_colIndex();
       Value *tmpSigElt = tmpSigElts[col];
+      // Columns without dynamic stores were not given a temporary array.
+      if (!tmpSigElt)
+        continue;
       IRBuilder<> Builder(CI);
       Value *r = store.get_rowIndex();
       // Store to tmpSigElt.
@@ -182,6 +208,8 @@ void DxilEliminateOutputDynamicIndexing::StoreTmpSigToOutput(
       Value *zero = Builder.getInt32(0);
       for (unsigned c = 0; c<tmpSigElts.size(); c++) {
         Value *col = tmpSigElts[c];
+        if (!col)
+          continue;
         args[DXIL::OperandIndex::kStoreOutputColOpIdx] = Builder.getInt8(c);
         for (unsigned r = 0; r < row; r++) {
           Value *GEP =
@@ -62,6 +62,9 @@ using namespace hlsl;
 namespace {
 class DxilExpandTrigIntrinsics : public FunctionPass {
 private:
+  // Use shorter, lower-precision polynomial approximations where we have
+  // them. Off by default; opt in with the fast-trig pass option.
+  bool m_FastTrig = false;
 
 public:
   static char ID; // Pass identification, replacement for typeid
@@ -70,9 +73,13 @@ public:
   const char *getPassName() const override {
     return "DXIL expand trig intrinsics";
   }
-  
+
+  void applyOptions(PassOptions O) override {
+    GetPassOptionBool(O, "fast-trig", &m_FastTrig, false);
+  }
+
   bool runOnFunction(Function &F) override;
-  
+
 
 private:
   typedef std::vector<CallInst *> IntrinsicList;
@@ -150,6 +157,87 @@ static void setPreciseBuilder(IRBuilder<> &builder, bool precise) {
   builder.SetFastMathFlags(flags);
 }
 
+// Range analysis helpers
+// ----------------------------------------------------------------------------
+// The expansions below pay for range reduction (reciprocals, compares and
+// selects) that is wasted work when the input range is already known. We
+// prove small ranges locally from the values that commonly feed trig
+// intrinsics: constants, saturate, abs, sin/cos results, and products of
+// values that are themselves bounded. The proofs are exact, so skipping the
+// reduction never changes the computed result.
+
+static bool isConstantInRange(Value *V, double lo, double hi) {
+  ConstantFP *C = dyn_cast<ConstantFP>(V);
+  if (!C)
+    return false;
+  APFloat val = C->getValueAPF();
+  bool losesInfo = false;
+  val.convert(APFloat::IEEEdouble, APFloat::rmNearestTiesToEven, &losesInfo);
+  const double x = val.convertToDouble();
+  return lo <= x && x <= hi;
+}
+
+// Return true if we can prove |V| <= 1.
+static bool isKnownUnitRange(Value *V, unsigned depth = 0) {
+  if (isConstantInRange(V, -1.0, 1.0))
+    return true;
+  if (depth > 2)
+    return false;
+  Instruction *I = dyn_cast<Instruction>(V);
+  if (!I)
+    return false;
+
+  if (OP::IsDxilOpFuncCallInst(I)) {
+    switch (OP::GetDxilOpFuncCallInst(I)) {
+    case OP::OpCode::Saturate:
+    case OP::OpCode::Sin:
+    case OP::OpCode::Cos:
+      return true;
+    case OP::OpCode::FAbs:
+      return isKnownUnitRange(cast<CallInst>(I)->getArgOperand(1), depth + 1);
+    default:
+      return false;
+    }
+  }
+
+  // A product of unit-range values stays in the unit range.
+  if (BinaryOperator *BO = dyn_cast<BinaryOperator>(I))
+    if (BO->getOpcode() == Instruction::FMul)
+      return isKnownUnitRange(BO->getOperand(0), depth + 1) &&
+             isKnownUnitRange(BO->getOperand(1), depth + 1);
+
+  return false;
+}
+
+// Return true if we can prove V >= 0.
+static bool isKnownNonNegative(Value *V, unsigned depth = 0) {
+  if (ConstantFP *C = dyn_cast<ConstantFP>(V))
+    return !C->getValueAPF().isNegative();
+  if (depth > 2)
+    return false;
+  Instruction *I = dyn_cast<Instruction>(V);
+  if (!I)
+    return false;
+
+  if (OP::IsDxilOpFuncCallInst(I)) {
+    switch (OP::GetDxilOpFuncCallInst(I)) {
+    case OP::OpCode::Saturate:
+    case OP::OpCode::FAbs:
+    case OP::OpCode::Sqrt:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  if (BinaryOperator *BO = dyn_cast<BinaryOperator>(I))
+    if (BO->getOpcode() == Instruction::FMul)
+      return isKnownNonNegative(BO->getOperand(0), depth + 1) &&
+             isKnownNonNegative(BO->getOperand(1), depth + 1);
+
+  return false;
+}
+
 void DxilExpandTrigIntrinsics::prepareBuilderToExpandIntrinsic(IRBuilder<> &builder, CallInst *intrinsic) {
   DxilModule &DM = intrinsic->getModule()->GetOrCreateDxilModule();
   builder.SetInsertPoint(intrinsic);
@@ -301,13 +389,17 @@ Value *DxilExpandTrigIntrinsics::expandASin(IRBuilder<> &builder, DxilInst_Asin
   Value *X = asin.get_value();
   Value *PI_2 = ConstantFP::get(X->getType(), math::PI_2);
   Value *Zero = ConstantFP::get(X->getType(), 0.0);
-  
-  // Range reduction to [0, 1]
-  Value *absX = emitFAbs(builder, X, DM.GetOP(), name);
+
+  // Range reduction to [0, 1]. Skipped entirely when the input is provably
+  // non-negative (e.g. fed by saturate).
+  const bool nonNegative = isKnownNonNegative(X);
+  Value *absX = nonNegative ? X : emitFAbs(builder, X, DM.GetOP(), name);
 
   // Approximation
   Value *psiX = emitSqrt1mXtimesPsiX(builder, absX, DM.GetOP(), name);
   Value *asinX = builder.CreateFSub(PI_2, psiX, name);
+  if (nonNegative)
+    return asinX;
   Value *asinmX = builder.CreateFSub(Zero, asinX, name);
 
   // Range expansion to [-1, 1]
@@ -345,12 +437,16 @@ Value *DxilExpandTrigIntrinsics::expandACos(IRBuilder<> &builder, DxilInst_Acos
   Value *X = acos.get_value();
   Value *PI = ConstantFP::get(X->getType(), math::PI);
   Value *Zero = ConstantFP::get(X->getType(), 0.0);
-  
-  // Range reduction to [0, 1]
-  Value *absX = emitFAbs(builder, X, DM.GetOP(), name);
+
+  // Range reduction to [0, 1]. Skipped entirely when the input is provably
+  // non-negative (e.g. fed by saturate).
+  const bool nonNegative = isKnownNonNegative(X);
+  Value *absX = nonNegative ? X : emitFAbs(builder, X, DM.GetOP(), name);
 
   // Approximation
   Value *acosX = emitSqrt1mXtimesPsiX(builder, absX, DM.GetOP(), name);
+  if (nonNegative)
+    return acosX;
   Value *acosmX = builder.CreateFSub(PI, acosX, name);
 
   // Range expansion to [-1, 1]
@@ -400,6 +496,21 @@ Value *DxilExpandTrigIntrinsics::expandACos(IRBuilder<> &builder, DxilInst_Acos
 // To expand the range we check if x > 1 then subtracted the computed value from
 // pi/2 and if x is negative then negate the final value.
 //
+// When the input is provably inside the domain of the approximation (for
+// example saturated or the product of saturated values), the reciprocal
+// reduction and its selects are skipped; likewise the sign fixup when the
+// input is provably non-negative. These proofs are exact.
+//
+// With fast-trig we use a shorter fit from the same source [ADC]
+//
+//    arctan*(x) = b1x + b3x^3 + b5x^5
+//      b1 =  0.995354
+//      b3 = -0.288679
+//      b5 =  0.079331
+//
+// with |e| <= 6.2e-4, which drops two multiply-add pairs from the Horner
+// chain. Calls marked precise always get the full polynomial.
+//
 Value *DxilExpandTrigIntrinsics::expandATan(IRBuilder<> &builder, DxilInst_Atan atan, DxilModule &DM) {
   assert(atan);
   StringRef name  = "atan.x";
@@ -407,35 +518,60 @@ Value *DxilExpandTrigIntrinsics::expandATan(IRBuilder<> &builder, DxilInst_Atan
   Value *PI_2 = ConstantFP::get(X->getType(), math::PI_2);
   Value *One  = ConstantFP::get(X->getType(), 1.0);
   Value *Zero = ConstantFP::get(X->getType(), 0.0);
-  Value *c1 = ConstantFP::get(X->getType(),  0.9998660);
-  Value *c3 = ConstantFP::get(X->getType(), -0.3302995);
-  Value *c5 = ConstantFP::get(X->getType(),  0.1801410);
-  Value *c7 = ConstantFP::get(X->getType(), -0.0851330);
-  Value *c9 = ConstantFP::get(X->getType(),  0.0208351);
+
+  const bool nonNegative = isKnownNonNegative(X);
+  const bool unitRange = isKnownUnitRange(X);
+  const bool shortPolynomial = m_FastTrig && !isPreciseBuilder(builder);
 
   // Range reduction to [0, inf]
-  Value *absX = emitFAbs(builder, X, DM.GetOP(), name);
+  Value *absX = nonNegative ? X : emitFAbs(builder, X, DM.GetOP(), name);
 
   // Range reduction to [0, 1]
-  Value *gt1 = builder.CreateFCmp(CmpInst::FCMP_UGT, absX, One, name);
-  Value *r1 = builder.CreateFDiv(One, absX, name);
-  Value *r2 = builder.CreateSelect(gt1, r1, absX, name);
+  Value *gt1 = nullptr;
+  Value *r2 = absX;
+  if (!unitRange) {
+    gt1 = builder.CreateFCmp(CmpInst::FCMP_UGT, absX, One, name);
+    Value *r1 = builder.CreateFDiv(One, absX, name);
+    r2 = builder.CreateSelect(gt1, r1, absX, name);
+  }
 
   // Approximate
   Value *r3 = builder.CreateFMul(r2, r2, name);
-  Value *r4 = builder.CreateFMul(r3, c9, name);
-         r4 = builder.CreateFAdd(r4, c7, name);
-         r4 = builder.CreateFMul(r4, r3, name);
-         r4 = builder.CreateFAdd(r4, c5, name);
-         r4 = builder.CreateFMul(r4, r3, name);
-         r4 = builder.CreateFAdd(r4, c3, name);
-         r4 = builder.CreateFMul(r4, r3, name);
-         r4 = builder.CreateFAdd(r4, c1, name);
-         r4 = builder.CreateFMul(r2, r4, name);
+  Value *r4 = nullptr;
+  if (shortPolynomial) {
+    Value *b1 = ConstantFP::get(X->getType(),  0.995354);
+    Value *b3 = ConstantFP::get(X->getType(), -0.288679);
+    Value *b5 = ConstantFP::get(X->getType(),  0.079331);
+    r4 = builder.CreateFMul(r3, b5, name);
+    r4 = builder.CreateFAdd(r4, b3, name);
+    r4 = builder.CreateFMul(r4, r3, name);
+    r4 = builder.CreateFAdd(r4, b1, name);
+    r4 = builder.CreateFMul(r2, r4, name);
+  } else {
+    Value *c1 = ConstantFP::get(X->getType(),  0.9998660);
+    Value *c3 = ConstantFP::get(X->getType(), -0.3302995);
+    Value *c5 = ConstantFP::get(X->getType(),  0.1801410);
+    Value *c7 = ConstantFP::get(X->getType(), -0.0851330);
+    Value *c9 = ConstantFP::get(X->getType(),  0.0208351);
+    r4 = builder.CreateFMul(r3, c9, name);
+    r4 = builder.CreateFAdd(r4, c7, name);
+    r4 = builder.CreateFMul(r4, r3, name);
+    r4 = builder.CreateFAdd(r4, c5, name);
+    r4 = builder.CreateFMul(r4, r3, name);
+    r4 = builder.CreateFAdd(r4, c3, name);
+    r4 = builder.CreateFMul(r4, r3, name);
+    r4 = builder.CreateFAdd(r4, c1, name);
+    r4 = builder.CreateFMul(r2, r4, name);
+  }
 
   // Range Expansion to [0, inf]
-  Value *r5 = builder.CreateFSub(PI_2, r4, name);
-  Value *r6 = builder.CreateSelect(gt1, r5, r4, name);
+  Value *r6 = r4;
+  if (!unitRange) {
+    Value *r5 = builder.CreateFSub(PI_2, r4, name);
+    r6 = builder.CreateSelect(gt1, r5, r4, name);
+  }
+  if (nonNegative)
+    return r6;
 
   // Range Expansion to [-inf, inf]
   Value *r7 = builder.CreateFSub(Zero, r6, name);
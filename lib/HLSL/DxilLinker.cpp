@@ -103,6 +103,10 @@ namespace {
 struct DxilFunctionLinkInfo {
   DxilFunctionLinkInfo(llvm::Function *F);
   llvm::Function *func;
+  // Whether func has been materialized and its used functions collected.
+  // Set once; the source library is never mutated by a link, so the
+  // collected usage stays valid across Link calls.
+  bool bLoaded;
   // SetVectors for deterministic iteration
   llvm::SetVector<llvm::Function *> usedFunctions;
   llvm::SetVector<llvm::GlobalVariable *> usedGVs;
@@ -137,6 +141,15 @@ private:
   llvm::MapVector<const llvm::Constant *, DxilResourceBase *> m_resourceMap;
   // Set of initialize functions for global variable. SetVector for deterministic iteration.
   llvm::SetVector<llvm::Function *> m_initFuncSet;
+  // Whether BuildGlobalUsage has run. The init-function set and resource
+  // index only depend on eagerly parsed parts of the library module, which
+  // links never mutate, so they are built once and reused by every Link
+  // call that attaches this lib.
+  bool m_bGlobalUsageBuilt;
+  // Whether a function body was materialized since the last used-global
+  // scan. Uses of a global can only appear from materialized bodies, so the
+  // scan over global users reruns only when this is set.
+  bool m_bUsedGVScanDirty;
 };
 
 struct DxilLinkJob;
@@ -148,6 +161,7 @@ public:
   bool HasLibNameRegistered(StringRef name) override;
   bool RegisterLib(StringRef name, std::unique_ptr<llvm::Module> pModule,
                    std::unique_ptr<llvm::Module> pDebugModule) override;
+  bool UnregisterLib(StringRef name) override;
   bool AttachLib(StringRef name) override;
   bool DetachLib(StringRef name) override;
   void DetachAll() override;
@@ -176,7 +190,8 @@ private:
 //
 // DxilFunctionLinkInfo methods.
 //
-DxilFunctionLinkInfo::DxilFunctionLinkInfo(Function *F) : func(F) {
+DxilFunctionLinkInfo::DxilFunctionLinkInfo(Function *F)
+    : func(F), bLoaded(false) {
   DXASSERT_NOMSG(F);
 }
 
@@ -186,7 +201,8 @@ DxilFunctionLinkInfo::DxilFunctionLinkInfo(Function *F) : func(F) {
 //
 
 DxilLib::DxilLib(std::unique_ptr<llvm::Module> pModule)
-    : m_pModule(std::move(pModule)), m_DM(m_pModule->GetOrCreateDxilModule()) {
+    : m_pModule(std::move(pModule)), m_DM(m_pModule->GetOrCreateDxilModule()),
+      m_bGlobalUsageBuilt(false), m_bUsedGVScanDirty(true) {
   Module &M = *m_pModule;
   const std::string &MID = M.getModuleIdentifier();
 
@@ -214,6 +230,11 @@ DxilLib::DxilLib(std::unique_ptr<llvm::Module> pModule)
 void DxilLib::LazyLoadFunction(Function *F) {
   DXASSERT(m_functionNameMap.count(F->getName()), "else invalid Function");
   DxilFunctionLinkInfo *linkInfo = m_functionNameMap[F->getName()].get();
+  // Materialization and usage collection only need to happen once per
+  // library, not once per Link call that pulls this function in.
+  if (linkInfo->bLoaded)
+    return;
+  m_bUsedGVScanDirty = true;
   std::error_code EC = F->materialize();
   DXASSERT_LOCALVAR(EC, !EC, "else fail to materialize");
 
@@ -235,53 +256,66 @@ void DxilLib::LazyLoadFunction(Function *F) {
     }
   }
   // Used globals will be build before link.
+  linkInfo->bLoaded = true;
 }
 
 void DxilLib::BuildGlobalUsage() {
   Module &M = *m_pModule;
 
-  // Collect init functions for static globals.
-  if (GlobalVariable *Ctors = M.getGlobalVariable("llvm.global_ctors")) {
-    if (ConstantArray *CA = dyn_cast<ConstantArray>(Ctors->getInitializer())) {
-      for (User::op_iterator i = CA->op_begin(), e = CA->op_end(); i != e;
-           ++i) {
-        if (isa<ConstantAggregateZero>(*i))
-          continue;
-        ConstantStruct *CS = cast<ConstantStruct>(*i);
-        if (isa<ConstantPointerNull>(CS->getOperand(1)))
-          continue;
+  if (!m_bGlobalUsageBuilt) {
+    m_bGlobalUsageBuilt = true;
 
-        // Must have a function or null ptr.
-        if (!isa<Function>(CS->getOperand(1)))
-          continue;
-        Function *Ctor = cast<Function>(CS->getOperand(1));
-        assert(Ctor->getReturnType()->isVoidTy() && Ctor->arg_size() == 0 &&
-               "function type must be void (void)");
-        // Add Ctor.
-        m_initFuncSet.insert(Ctor);
-        LazyLoadFunction(Ctor);
+    // Collect init functions for static globals.
+    if (GlobalVariable *Ctors = M.getGlobalVariable("llvm.global_ctors")) {
+      if (ConstantArray *CA =
+              dyn_cast<ConstantArray>(Ctors->getInitializer())) {
+        for (User::op_iterator i = CA->op_begin(), e = CA->op_end(); i != e;
+             ++i) {
+          if (isa<ConstantAggregateZero>(*i))
+            continue;
+          ConstantStruct *CS = cast<ConstantStruct>(*i);
+          if (isa<ConstantPointerNull>(CS->getOperand(1)))
+            continue;
+
+          // Must have a function or null ptr.
+          if (!isa<Function>(CS->getOperand(1)))
+            continue;
+          Function *Ctor = cast<Function>(CS->getOperand(1));
+          assert(Ctor->getReturnType()->isVoidTy() && Ctor->arg_size() == 0 &&
+                 "function type must be void (void)");
+          // Add Ctor.
+          m_initFuncSet.insert(Ctor);
+          LazyLoadFunction(Ctor);
+        }
       }
     }
+
+    // Build resource map.
+    AddResourceMap(m_DM.GetUAVs(), DXIL::ResourceClass::UAV, m_resourceMap,
+                   m_DM);
+    AddResourceMap(m_DM.GetSRVs(), DXIL::ResourceClass::SRV, m_resourceMap,
+                   m_DM);
+    AddResourceMap(m_DM.GetCBuffers(), DXIL::ResourceClass::CBuffer,
+                   m_resourceMap, m_DM);
+    AddResourceMap(m_DM.GetSamplers(), DXIL::ResourceClass::Sampler,
+                   m_resourceMap, m_DM);
   }
 
-  // Build used globals.
-  for (GlobalVariable &GV : M.globals()) {
-    llvm::SetVector<Function *> funcSet;
-    CollectUsedFunctions(&GV, funcSet);
-    for (Function *F : funcSet) {
-      DXASSERT(m_functionNameMap.count(F->getName()), "must exist in table");
-      DxilFunctionLinkInfo *linkInfo = m_functionNameMap[F->getName()].get();
-      linkInfo->usedGVs.insert(&GV);
+  // Build used globals. Uses only exist in materialized bodies, so this
+  // rescans when a Link call materialized new functions since the last scan;
+  // the SetVectors make re-insertion of already-known uses a no-op.
+  if (m_bUsedGVScanDirty) {
+    m_bUsedGVScanDirty = false;
+    for (GlobalVariable &GV : M.globals()) {
+      llvm::SetVector<Function *> funcSet;
+      CollectUsedFunctions(&GV, funcSet);
+      for (Function *F : funcSet) {
+        DXASSERT(m_functionNameMap.count(F->getName()), "must exist in table");
+        DxilFunctionLinkInfo *linkInfo = m_functionNameMap[F->getName()].get();
+        linkInfo->usedGVs.insert(&GV);
+      }
     }
   }
-
-  // Build resource map.
-  AddResourceMap(m_DM.GetUAVs(), DXIL::ResourceClass::UAV, m_resourceMap, m_DM);
-  AddResourceMap(m_DM.GetSRVs(), DXIL::ResourceClass::SRV, m_resourceMap, m_DM);
-  AddResourceMap(m_DM.GetCBuffers(), DXIL::ResourceClass::CBuffer,
-                 m_resourceMap, m_DM);
-  AddResourceMap(m_DM.GetSamplers(), DXIL::ResourceClass::Sampler,
-                 m_resourceMap, m_DM);
 }
 
 void DxilLib::CollectUsedInitFunctions(SetVector<StringRef> &addedFunctionSet,
@@ -1084,6 +1118,18 @@ bool DxilLinkerImpl::RegisterLib(StringRef name,
   return true;
 }
 
+bool DxilLinkerImpl::UnregisterLib(StringRef name) {
+  auto iter = m_LibMap.find(name);
+  if (iter == m_LibMap.end())
+    return false;
+
+  // Drop any attachment state first so the function name map holds no
+  // entries pointing into the library being destroyed.
+  DetachLib(iter->second.get());
+  m_LibMap.erase(iter);
+  return true;
+}
+
 bool DxilLinkerImpl::AttachLib(StringRef name) {
   auto iter = m_LibMap.find(name);
   if (iter == m_LibMap.end()) {
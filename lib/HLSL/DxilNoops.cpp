@@ -93,6 +93,8 @@
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/Transforms/Scalar.h"
 #include "llvm/Transforms/Utils/Local.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/DebugInfo.h"
 #include "llvm/IR/DIBuilder.h"
 #include "llvm/Support/raw_os_ostream.h"
 #include "dxc/DXIL/DxilMetadataHelper.h"
@@ -267,14 +269,13 @@ static Instruction *CreatePreserve(Value *V, Value *LastV, Instruction *InsertPt
   return CallInst::Create(PreserveF, ArrayRef<Value *> { V, LastV }, "", InsertPt);
 }
 
-static void LowerPreserveToSelect(CallInst *CI) {
+static void LowerPreserveToSelect(CallInst *CI, Value *Cond) {
   Value *V = CI->getArgOperand(0);
   Value *LastV = CI->getArgOperand(1);
 
   if (LastV == V)
     LastV = UndefValue::get(V->getType());
 
-  Value *Cond = GetOrCreatePreserveCond(CI->getParent()->getParent());
   SelectInst *Select = SelectInst::Create(Cond, LastV, V, "", CI);
   Select->setDebugLoc(CI->getDebugLoc());
   CI->replaceAllUsesWith(Select);
@@ -352,6 +353,13 @@ struct DxilInsertPreserves : public ModulePass {
       FindAllStores(&GV, &Stores, WorklistStorage, SeenStorage);
     }
 
+    // When real debug info is present, an alloca that never got a debug
+    // variable is a compiler temporary; noops and preserves on its stores
+    // could never be mapped back to source, so don't generate them at all.
+    // Without debug info there is nothing to key off of, so keep inserting
+    // everywhere - PIX still uses the noops for its own instrumentation.
+    bool HasDbgInfo = getDebugMetadataVersionFromModule(M) != 0;
+
     bool Changed = false;
     for (Function &F : M) {
       if (F.isDeclaration())
@@ -364,8 +372,11 @@ struct DxilInsertPreserves : public ModulePass {
         if (!AI)
           continue;
         // Skip temp allocas
-        if (!AI->getMetadata(hlsl::DxilMDHelper::kDxilTempAllocaMDName))
-          FindAllStores(AI, &Stores, WorklistStorage, SeenStorage);
+        if (AI->getMetadata(hlsl::DxilMDHelper::kDxilTempAllocaMDName))
+          continue;
+        if (HasDbgInfo && !llvm::FindAllocaDbgDeclare(AI))
+          continue;
+        FindAllStores(AI, &Stores, WorklistStorage, SeenStorage);
       }
 
       // Collect Stores on pointer Arguments in function
@@ -448,27 +459,38 @@ public:
   }
 
   bool runOnModule(Module &M) override {
-    bool Changed = false;
-    for (auto fit = M.getFunctionList().begin(), end = M.getFunctionList().end();
-      fit != end;)
-    {
-      Function *F = &*(fit++);
-      if (!F->isDeclaration())
+    // Collect the preserve intrinsics and all of their call sites in one
+    // walk up front, so lowering below never iterates a use list it is
+    // mutating.
+    SmallVector<Function *, 8> PreserveFs;
+    std::vector<CallInst *> Calls;
+    for (Function &F : M) {
+      if (!F.isDeclaration() || !F.getName().startswith(kPreservePrefix))
         continue;
+      PreserveFs.push_back(&F);
+      for (User *U : F.users())
+        Calls.push_back(cast<CallInst>(U));
+    }
 
-      if (F->getName().startswith(kPreservePrefix)) {
-        for (auto uit = F->user_begin(), end = F->user_end(); uit != end;) {
-          User *U = *(uit++);
-          CallInst *CI = cast<CallInst>(U);
-          LowerPreserveToSelect(CI);
-        }
-
-        F->eraseFromParent();
-        Changed = true;
-      }
+    if (PreserveFs.empty())
+      return false;
+
+    // Every preserve in a function selects on the same load of
+    // @dx.preserve.value; create it once per function instead of
+    // rediscovering it through the global's use list for every call.
+    DenseMap<Function *, Value *> CondForFunc;
+    for (CallInst *CI : Calls) {
+      Function *F = CI->getParent()->getParent();
+      Value *&Cond = CondForFunc[F];
+      if (!Cond)
+        Cond = GetOrCreatePreserveCond(F);
+      LowerPreserveToSelect(CI, Cond);
     }
 
-    return Changed;
+    for (Function *F : PreserveFs)
+      F->eraseFromParent();
+
+    return true;
   }
   const char *getPassName() const override { return "Dxil Lower Preserves to Selects"; }
 };
@@ -563,6 +585,7 @@ class DxilFinalizePreserves : public ModulePass {
 public:
   static char ID;
   GlobalVariable *NothingGV = nullptr;
+  Constant *NothingGep = nullptr;
 
   DxilFinalizePreserves() : ModulePass(ID) {
     initializeDxilFinalizePreservesPass(*PassRegistry::getPassRegistry());
@@ -583,10 +606,10 @@ public:
           llvm::GlobalValue::InternalLinkage,
           InitialValue, kNothingName);
       }
+      NothingGep = GetConstGep(NothingGV, 0, 0);
     }
 
-    Constant *Gep = GetConstGep(NothingGV, 0, 0);
-    return new llvm::LoadInst(Gep, nullptr, InsertBefore);
+    return new llvm::LoadInst(NothingGep, nullptr, InsertBefore);
   }
 
   bool LowerPreserves(Module &M);
@@ -644,10 +667,13 @@ bool DxilFinalizePreserves::LowerNoops(Module &M) {
   }
 
   if (NoopF) {
-    for (auto It = NoopF->user_begin(), E = NoopF->user_end(); It != E;) {
-      User *U = *(It++);
-      CallInst *CI = cast<CallInst>(U);
+    // Gather the call sites first so the rewrite loop below does not walk
+    // a use list it is erasing from.
+    std::vector<CallInst *> Noops;
+    for (User *U : NoopF->users())
+      Noops.push_back(cast<CallInst>(U));
 
+    for (CallInst *CI : Noops) {
       Instruction *Nop = GetFinalNoopInst(M, CI);
       Nop->setDebugLoc(CI->getDebugLoc());
 
@@ -34,6 +34,7 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Pass.h"
 #include "llvm/Transforms/Utils/Local.h"
 #include "llvm/Transforms/Scalar.h"
@@ -109,6 +110,7 @@ private:
   void AddInputBinding(Module &M);
   void PatchShaderBindings(Module &M);
   void InitializeViewTable();
+  void BuildResourceSymbolMap(DxilModule &DM);
 
   unsigned int AddSRVRawBuffer(Module &M, unsigned int registerIndex, unsigned int registerSpace, const std::string &bufferName);
   unsigned int AddHandle(Module &M, unsigned int baseRegisterIndex, unsigned int rangeSize, unsigned int registerSpace, DXIL::ResourceClass resClass, DXIL::ResourceKind resKind, const std::string &bufferName, llvm::Type *type = nullptr, unsigned int constantBufferSize = 0);
@@ -175,6 +177,11 @@ private:
 
   llvm::Function *EntryPointFunction;
 
+  // Global symbol to resource table built once per run so that each patch
+  // site resolves its handle with a single lookup instead of a scan over
+  // every resource list in the module.
+  llvm::DenseMap<llvm::Value *, hlsl::DxilResourceBase *> ResourceBySymbol;
+
   ShaderInfo *pInputShaderInfo;
   const DxilVersionedRootSignatureDesc *pRootSignatureDesc;
   DXIL::ShaderKind ShaderKind;
@@ -393,6 +400,7 @@ bool DxilPatchShaderRecordBindings::runOnModule(Module &M) {
 
   ValidateParameters();
   InitializeViewTable();
+  BuildResourceSymbolMap(DM);
 
   PatchShaderBindings(M);
   DM.ReEmitDxilResources();
@@ -702,7 +710,27 @@ unsigned int GetResolvedRangeID(DXIL::ResourceClass resClass, Value *rangeIdVal)
   }
 }
 
-// TODO: This code is quite inefficient
+void DxilPatchShaderRecordBindings::BuildResourceSymbolMap(DxilModule &DM)
+{
+  ResourceBySymbol.clear();
+  for (auto &cbuffer : DM.GetCBuffers())
+  {
+    ResourceBySymbol[cbuffer->GetGlobalSymbol()] = cbuffer.get();
+  }
+  for (auto &srv : DM.GetSRVs())
+  {
+    ResourceBySymbol[srv->GetGlobalSymbol()] = srv.get();
+  }
+  for (auto &uav : DM.GetUAVs())
+  {
+    ResourceBySymbol[uav->GetGlobalSymbol()] = uav.get();
+  }
+  for (auto &sampler : DM.GetSamplers())
+  {
+    ResourceBySymbol[sampler->GetGlobalSymbol()] = sampler.get();
+  }
+}
+
 bool DxilPatchShaderRecordBindings::GetHandleInfo(
   Module &M,
   DxilInst_CreateHandleForLib &createHandleStructForLib,
@@ -712,64 +740,14 @@ bool DxilPatchShaderRecordBindings::GetHandleInfo(
   _Out_ DXIL::ResourceClass &resClass,
   _Out_ llvm::Type *&resType)
 {
-  DxilModule &DM = M.GetOrCreateDxilModule();
   LoadInst *loadRangeId = cast<LoadInst>(createHandleStructForLib.get_Resource());
   Value *ResourceSymbol = loadRangeId->getPointerOperand();
 
-  DXIL::ResourceClass resourceClasses[] = {
-    DXIL::ResourceClass::CBuffer,
-    DXIL::ResourceClass::SRV,
-    DXIL::ResourceClass::UAV,
-    DXIL::ResourceClass::Sampler
-  };
-
-  hlsl::DxilResourceBase *Resource = nullptr;
-  for (auto &resourceClass : resourceClasses) {
-    
-    switch (resourceClass)
-    {
-    case DXIL::ResourceClass::CBuffer:
-    {
-      auto &cbuffers = DM.GetCBuffers();
-      for (auto &cbuffer : cbuffers)
-      {
-        if (cbuffer->GetGlobalSymbol() == ResourceSymbol)
-        {
-          Resource = cbuffer.get();
-          break;
-        }
-      }
-      break;
-    }
-    case DXIL::ResourceClass::SRV:
-    case DXIL::ResourceClass::UAV:
-    {
-      auto &viewList = resourceClass == DXIL::ResourceClass::SRV ? DM.GetSRVs() : DM.GetUAVs();
-      for (auto &view : viewList)
-      {
-        if (view->GetGlobalSymbol() == ResourceSymbol)
-        {
-          Resource = view.get();
-          break;
-        }
-      }
-      break;
-    }
-    case DXIL::ResourceClass::Sampler:
-    {
-      auto &samplers = DM.GetSamplers();
-      for (auto &sampler : samplers)
-      {
-        if (sampler->GetGlobalSymbol() == ResourceSymbol)
-        {
-          Resource = sampler.get();
-          break;
-        }
-      }
-      break;
-    }
-    }
-  }
+  // Resolve against the table built at the start of the run. Resources added
+  // while patching (the input bindings and aliased heap handles) are absent
+  // on purpose: their handle loads are inserted behind the iteration point
+  // and are never patch sites themselves.
+  hlsl::DxilResourceBase *Resource = ResourceBySymbol.lookup(ResourceSymbol);
 
   if (Resource)
   {
@@ -11,6 +11,7 @@
 #include "dxc/HLSL/DxilGenerationPass.h"
 #include "dxc/HLSL/HLModule.h"
 #include "dxc/HLSL/HLOperations.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/Pass.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instruction.h"
@@ -18,67 +19,48 @@
 #include "llvm/IR/Operator.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Casting.h"
-#include <unordered_set>
 #include <vector>
 
 using namespace llvm;
 using namespace hlsl;
 
 namespace {
-class DxilPrecisePropagatePass : public ModulePass {
+
+// Iterative precise propagation state. Precise marking walks the def chains
+// of wide expression DAGs; the processed set makes sure shared
+// subexpressions are visited once, and an explicit worklist replaces
+// recursion so deep DAGs do not grow the stack with one frame per operand.
+class PrecisePropagator {
 public:
-  static char ID; // Pass identification, replacement for typeid
-  explicit DxilPrecisePropagatePass() : ModulePass(ID) {}
+  explicit PrecisePropagator(DxilTypeSystem &typeSys) : m_TypeSys(typeSys) {}
 
-  const char *getPassName() const override { return "DXIL Precise Propagate"; }
-
-  bool runOnModule(Module &M) override {
-    DxilModule &dxilModule = M.GetOrCreateDxilModule();
-    DxilTypeSystem &typeSys = dxilModule.GetTypeSystem();
-    std::unordered_set<Instruction*> processedSet;
-    std::vector<Function*> deadList;
-    for (Function &F : M.functions()) {
-      if (HLModule::HasPreciseAttribute(&F)) {
-        PropagatePreciseOnFunctionUser(F, typeSys, processedSet);
-        deadList.emplace_back(&F);
-      }
-    }
-    for (Function *F : deadList)
-      F->eraseFromParent();
-    return true;
-  }
+  void MarkOperand(Value *V);
+  void Process();
 
 private:
-  void PropagatePreciseOnFunctionUser(
-      Function &F, DxilTypeSystem &typeSys,
-      std::unordered_set<Instruction *> &processedSet);
-};
-
-char DxilPrecisePropagatePass::ID = 0;
+  void PropagateOnPointer(Value *Ptr);
 
-}
-
-static void PropagatePreciseAttribute(Instruction *I, DxilTypeSystem &typeSys,
-    std::unordered_set<Instruction *> &processedSet);
+  DxilTypeSystem &m_TypeSys;
+  std::vector<Instruction *> m_Worklist;
+  DenseSet<Instruction *> m_ProcessedSet;
+};
 
-static void PropagatePreciseAttributeOnOperand(
-    Value *V, DxilTypeSystem &typeSys, LLVMContext &Context,
-    std::unordered_set<Instruction *> &processedSet) {
+// Mark one operand precise and queue it for operand propagation.
+void PrecisePropagator::MarkOperand(Value *V) {
   Instruction *I = dyn_cast<Instruction>(V);
   // Skip none inst.
   if (!I)
     return;
 
-  FPMathOperator *FPMath = dyn_cast<FPMathOperator>(I);
   // Skip none FPMath
-  if (!FPMath)
+  if (!isa<FPMathOperator>(I))
     return;
 
   // Skip inst already marked.
-  if (processedSet.count(I) > 0)
-    return;
   // TODO: skip precise on integer type, sample instruction...
-  processedSet.insert(I);
+  if (!m_ProcessedSet.insert(I).second)
+    return;
+
   // Set precise fast math on those instructions that support it.
   if (DxilModule::PreservesFastMathFlags(I))
     DxilModule::SetPreciseFastMathFlags(I);
@@ -86,25 +68,23 @@ static void PropagatePreciseAttributeOnOperand(
   // Fast math not work on call, use metadata.
   if (CallInst *CI = dyn_cast<CallInst>(I))
     HLModule::MarkPreciseAttributeWithMetadata(CI);
-  PropagatePreciseAttribute(I, typeSys, processedSet);
+
+  m_Worklist.emplace_back(I);
 }
 
-static void PropagatePreciseAttributeOnPointer(
-    Value *Ptr, DxilTypeSystem &typeSys, LLVMContext &Context,
-    std::unordered_set<Instruction *> &processedSet) {
+void PrecisePropagator::PropagateOnPointer(Value *Ptr) {
   // Find all store and propagate on the val operand of store.
   // For CallInst, if Ptr is used as out parameter, mark it.
   for (User *U : Ptr->users()) {
     Instruction *user = cast<Instruction>(U);
     if (StoreInst *stInst = dyn_cast<StoreInst>(user)) {
-      Value *val = stInst->getValueOperand();
-      PropagatePreciseAttributeOnOperand(val, typeSys, Context, processedSet);
+      MarkOperand(stInst->getValueOperand());
     } else if (CallInst *CI = dyn_cast<CallInst>(user)) {
       bool bReadOnly = true;
 
       Function *F = CI->getCalledFunction();
       const DxilFunctionAnnotation *funcAnnotation =
-          typeSys.GetFunctionAnnotation(F);
+          m_TypeSys.GetFunctionAnnotation(F);
       for (unsigned i = 0; i < CI->getNumArgOperands(); ++i) {
         if (Ptr != CI->getArgOperand(i))
           continue;
@@ -121,44 +101,69 @@ static void PropagatePreciseAttributeOnPointer(
       }
 
       if (!bReadOnly)
-        PropagatePreciseAttributeOnOperand(CI, typeSys, Context, processedSet);
+        MarkOperand(CI);
     }
   }
 }
 
-static void
-PropagatePreciseAttribute(Instruction *I, DxilTypeSystem &typeSys,
-                          std::unordered_set<Instruction *> &processedSet) {
-  LLVMContext &Context = I->getContext();
-  if (AllocaInst *AI = dyn_cast<AllocaInst>(I)) {
-    PropagatePreciseAttributeOnPointer(AI, typeSys, Context, processedSet);
-  } else if (dyn_cast<CallInst>(I)) {
-    // Propagate every argument.
-    // TODO: only propagate precise argument.
-    for (Value *src : I->operands())
-      PropagatePreciseAttributeOnOperand(src, typeSys, Context, processedSet);
-  } else if (dyn_cast<FPMathOperator>(I)) {
-    // TODO: only propagate precise argument.
-    for (Value *src : I->operands())
-      PropagatePreciseAttributeOnOperand(src, typeSys, Context, processedSet);
-  } else if (LoadInst *ldInst = dyn_cast<LoadInst>(I)) {
-    Value *Ptr = ldInst->getPointerOperand();
-    PropagatePreciseAttributeOnPointer(Ptr, typeSys, Context, processedSet);
-  } else if (GetElementPtrInst *GEP = dyn_cast<GetElementPtrInst>(I))
-    PropagatePreciseAttributeOnPointer(GEP, typeSys, Context, processedSet);
-  // TODO: support more case which need
+// Drain the worklist, propagating the precise requirement from each marked
+// instruction to the values that feed it.
+void PrecisePropagator::Process() {
+  while (!m_Worklist.empty()) {
+    Instruction *I = m_Worklist.back();
+    m_Worklist.pop_back();
+    if (AllocaInst *AI = dyn_cast<AllocaInst>(I)) {
+      PropagateOnPointer(AI);
+    } else if (isa<CallInst>(I) || isa<FPMathOperator>(I)) {
+      // Propagate every argument.
+      // TODO: only propagate precise argument.
+      for (Value *src : I->operands())
+        MarkOperand(src);
+    } else if (LoadInst *ldInst = dyn_cast<LoadInst>(I)) {
+      PropagateOnPointer(ldInst->getPointerOperand());
+    } else if (GetElementPtrInst *GEP = dyn_cast<GetElementPtrInst>(I)) {
+      PropagateOnPointer(GEP);
+    }
+    // TODO: support more case which need
+  }
 }
 
-void DxilPrecisePropagatePass::PropagatePreciseOnFunctionUser(
-    Function &F, DxilTypeSystem &typeSys,
-    std::unordered_set<Instruction *> &processedSet) {
-  LLVMContext &Context = F.getContext();
-  for (auto U = F.user_begin(), E = F.user_end(); U != E;) {
-    CallInst *CI = cast<CallInst>(*(U++));
-    Value *V = CI->getArgOperand(0);
-    PropagatePreciseAttributeOnOperand(V, typeSys, Context, processedSet);
-    CI->eraseFromParent();
+class DxilPrecisePropagatePass : public ModulePass {
+public:
+  static char ID; // Pass identification, replacement for typeid
+  explicit DxilPrecisePropagatePass() : ModulePass(ID) {}
+
+  const char *getPassName() const override { return "DXIL Precise Propagate"; }
+
+  bool runOnModule(Module &M) override {
+    // Collect the precise marker functions first; modules without any
+    // precise annotation skip both the walk and DxilModule creation.
+    std::vector<Function *> deadList;
+    for (Function &F : M.functions()) {
+      if (HLModule::HasPreciseAttribute(&F))
+        deadList.emplace_back(&F);
+    }
+    if (deadList.empty())
+      return false;
+
+    DxilModule &dxilModule = M.GetOrCreateDxilModule();
+    PrecisePropagator propagator(dxilModule.GetTypeSystem());
+    for (Function *F : deadList) {
+      for (auto U = F->user_begin(), E = F->user_end(); U != E;) {
+        CallInst *CI = cast<CallInst>(*(U++));
+        propagator.MarkOperand(CI->getArgOperand(0));
+        propagator.Process();
+        CI->eraseFromParent();
+      }
+    }
+    for (Function *F : deadList)
+      F->eraseFromParent();
+    return true;
   }
+};
+
+char DxilPrecisePropagatePass::ID = 0;
+
 }
 
 ModulePass *llvm::createDxilPrecisePropagatePass() {
@@ -88,39 +88,47 @@ void DxilPromoteLocalResources::getAnalysisUsage(AnalysisUsage &AU) const {
 }
 
 bool DxilPromoteLocalResources::PromoteLocalResource(Function &F) {
+  // Collect the resource allocas once; most shaders have none, and nothing
+  // below creates new ones.
+  std::vector<AllocaInst *> Candidates;
+  BasicBlock &BB = F.getEntryBlock();
+  for (BasicBlock::iterator I = BB.begin(), E = --BB.end(); I != E; ++I)
+    if (AllocaInst *AI = dyn_cast<AllocaInst>(I)) { // Is it an alloca?
+      if (dxilutil::IsHLSLObjectType(dxilutil::GetArrayEltTy(AI->getAllocatedType())))
+        Candidates.push_back(AI);
+    }
+  if (Candidates.empty())
+    return false;
+
   bool bModified = false;
-  std::vector<AllocaInst *> Allocas;
   DominatorTree *DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
   AssumptionCache &AC =
       getAnalysis<AssumptionCacheTracker>().getAssumptionCache(F);
 
-  BasicBlock &BB = F.getEntryBlock();
-  unsigned allocaSize = 0;
-  while (1) {
+  std::vector<AllocaInst *> Allocas;
+  while (!Candidates.empty()) {
+    // Promote whichever candidates are currently safe; promotion can unblock
+    // the rest (e.g. copies between resource locals), so only the leftovers
+    // are re-tested rather than the whole entry block.
     Allocas.clear();
-
-    // Find allocas that are safe to promote, by looking at all instructions in
-    // the entry node
-    for (BasicBlock::iterator I = BB.begin(), E = --BB.end(); I != E; ++I)
-      if (AllocaInst *AI = dyn_cast<AllocaInst>(I)) { // Is it an alloca?
-        if (dxilutil::IsHLSLObjectType(dxilutil::GetArrayEltTy(AI->getAllocatedType()))) {
-          if (isAllocaPromotable(AI))
-            Allocas.push_back(AI);
-        }
-      }
-    if (Allocas.empty())
-      break;
+    std::vector<AllocaInst *> Remaining;
+    for (AllocaInst *AI : Candidates) {
+      if (isAllocaPromotable(AI))
+        Allocas.push_back(AI);
+      else
+        Remaining.push_back(AI);
+    }
 
     // No update.
     // Report error and break.
-    if (allocaSize == Allocas.size()) {
+    if (Allocas.empty()) {
       F.getContext().emitError(dxilutil::kResourceMapErrorMsg);
       break;
     }
-    allocaSize = Allocas.size();
 
     PromoteMemToReg(Allocas, *DT, nullptr, &AC);
     bModified = true;
+    Candidates = std::move(Remaining);
   }
 
   return bModified;
@@ -169,49 +177,61 @@ bool DxilPromoteStaticResources::PromoteStaticGlobalResources(
   }
 
   bool bModified = false;
-  std::set<GlobalVariable *> staticResources;
+  std::vector<GlobalVariable *> staticResources;
   for (auto &GV : M.globals()) {
     if (GV.getLinkage() == GlobalVariable::LinkageTypes::InternalLinkage &&
         dxilutil::IsHLSLObjectType(dxilutil::GetArrayEltTy(GV.getType()))) {
-      staticResources.insert(&GV);
+      staticResources.emplace_back(&GV);
     }
   }
+  if (staticResources.empty())
+    return false;
+
   SSAUpdater SSA;
   SmallVector<Instruction *, 4> Insts;
   // Make sure every resource load has mapped to global variable.
-  while (!staticResources.empty()) {
-    bool bUpdated = false;
-    for (auto it = staticResources.begin(); it != staticResources.end();) {
-      GlobalVariable *GV = *(it++);
-      // Build list of instructions to promote.
-      for (User *U : GV->users()) {
-        if (isa<LoadInst>(U) || isa<StoreInst>(U)) {
-          Insts.emplace_back(cast<Instruction>(U));
-        } else if (GEPOperator *GEP = dyn_cast<GEPOperator>(U)) {
-          for (User *gepU : GEP->users()) {
-            DXASSERT_NOMSG(isa<LoadInst>(gepU) || isa<StoreInst>(gepU));
-            if (isa<LoadInst>(gepU) || isa<StoreInst>(gepU))
-              Insts.emplace_back(cast<Instruction>(gepU));
-          }
-        } else {
-          DXASSERT(false, "Unhandled user of resource static global");
+  // One SSA-construction pass per global is enough: a load feeding a copy
+  // into another static resource is rewritten in place when its own global
+  // is visited, so visiting order does not matter and nothing has to be
+  // rescanned to a fixed point.
+  for (GlobalVariable *GV : staticResources) {
+    // Build list of instructions to promote.
+    for (User *U : GV->users()) {
+      if (isa<LoadInst>(U) || isa<StoreInst>(U)) {
+        Insts.emplace_back(cast<Instruction>(U));
+      } else if (GEPOperator *GEP = dyn_cast<GEPOperator>(U)) {
+        for (User *gepU : GEP->users()) {
+          DXASSERT_NOMSG(isa<LoadInst>(gepU) || isa<StoreInst>(gepU));
+          if (isa<LoadInst>(gepU) || isa<StoreInst>(gepU))
+            Insts.emplace_back(cast<Instruction>(gepU));
         }
+      } else {
+        DXASSERT(false, "Unhandled user of resource static global");
       }
+    }
 
-      LoadAndStorePromoter(Insts, SSA).run(Insts);
-      GV->removeDeadConstantUsers();
-      if (GV->user_empty()) {
-        bUpdated = true;
-        staticResources.erase(GV);
-      }
+    if (Insts.empty())
+      continue;
+    LoadAndStorePromoter(Insts, SSA).run(Insts);
+    bModified = true;
+    Insts.clear();
+  }
 
-      Insts.clear();
+  // Anything still alive after promotion - promotion leaves dead GEP
+  // instructions behind, so sweep those first - cannot be mapped to a single
+  // global resource.
+  for (GlobalVariable *GV : staticResources) {
+    GV->removeDeadConstantUsers();
+    for (auto it = GV->user_begin(); it != GV->user_end();) {
+      User *U = *(it++);
+      if (GetElementPtrInst *GEP = dyn_cast<GetElementPtrInst>(U))
+        if (GEP->use_empty())
+          GEP->eraseFromParent();
     }
-    if (!bUpdated) {
+    if (!GV->user_empty()) {
       M.getContext().emitError(dxilutil::kResourceMapErrorMsg);
       break;
     }
-    bModified = true;
   }
   return bModified;
 }
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// DxilScheduleForPressure.cpp                                               //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Late scheduling pass that sinks instructions toward their uses to        //
+// shorten live ranges before container assembly.                            //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/HLSL/DxilGenerationPass.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Pass.h"
+
+using namespace llvm;
+
+///////////////////////////////////////////////////////////////////////////////
+// Schedule for register pressure.
+
+namespace {
+
+// A value we may reposition: no side effects, not control flow, and not an
+// alloca (those must stay in the entry block).
+bool IsMovable(Instruction *I) {
+  if (isa<PHINode>(I) || isa<AllocaInst>(I) || isa<DbgInfoIntrinsic>(I))
+    return false;
+  if (I->isTerminator() || I->mayWriteToMemory())
+    return false;
+  return !I->use_empty();
+}
+
+// Move each movable instruction down to just before its first user in the
+// same block, so a value defined early but consumed late stops spanning the
+// instructions in between. Readers (loads and read-only dx.op calls such as
+// resource loads and samples) only move when no may-write instruction sits
+// between the old and new positions.
+bool SinkWithinBlock(BasicBlock &BB) {
+  SmallVector<Instruction *, 64> Insts;
+  DenseMap<Instruction *, unsigned> Pos;
+  // Number of may-write instructions above each original position. Writers
+  // never move, so these prefix counts stay valid while we reorder readers.
+  SmallVector<unsigned, 64> WritesAbove;
+  unsigned writes = 0;
+  for (Instruction &I : BB) {
+    Pos[&I] = Insts.size();
+    Insts.emplace_back(&I);
+    WritesAbove.emplace_back(writes);
+    if (I.mayWriteToMemory())
+      writes++;
+  }
+
+  bool bUpdated = false;
+  // Walk bottom-up so a chain of single-use producers sinks as a group: once
+  // a consumer has moved down, its producer follows it on a later iteration.
+  for (unsigned i = Insts.size(); i-- > 0;) {
+    Instruction *I = Insts[i];
+    if (!IsMovable(I))
+      continue;
+
+    // Find the earliest user. Bail out on users in other blocks or in phis;
+    // those cases belong to the cross-block sink.
+    Instruction *FirstUser = nullptr;
+    for (User *U : I->users()) {
+      Instruction *UI = dyn_cast<Instruction>(U);
+      if (!UI || UI->getParent() != &BB || isa<PHINode>(UI)) {
+        FirstUser = nullptr;
+        break;
+      }
+      if (!FirstUser || Pos[UI] < Pos[FirstUser])
+        FirstUser = UI;
+    }
+    if (!FirstUser || I->getNextNode() == FirstUser)
+      continue;
+
+    if (I->mayReadFromMemory() && WritesAbove[Pos[FirstUser]] != WritesAbove[i])
+      continue;
+
+    I->moveBefore(FirstUser);
+    // The instruction now sits just above its user; track that so producers
+    // visited later land above it, not at its old slot.
+    Pos[I] = Pos[FirstUser];
+    bUpdated = true;
+  }
+  return bUpdated;
+}
+
+// Sink a pure, speculatable instruction into the single block holding all of
+// its uses when that block is dominated by the current one and is not in a
+// deeper loop. This keeps values computed on one side of a branch from being
+// live across the whole diamond.
+bool TrySinkToUseBlock(Instruction *I, DominatorTree &DT, LoopInfo &LI) {
+  if (!IsMovable(I))
+    return false;
+  // Only reorder memory reads within a block, where the write scan above
+  // proves safety; across blocks require a fully pure instruction.
+  if (I->mayReadFromMemory() || !isSafeToSpeculativelyExecute(I))
+    return false;
+
+  BasicBlock *UseBlock = nullptr;
+  for (Use &U : I->uses()) {
+    Instruction *UI = cast<Instruction>(U.getUser());
+    BasicBlock *BB = UI->getParent();
+    // A phi consumes the value at the end of the incoming block.
+    if (PHINode *PN = dyn_cast<PHINode>(UI))
+      BB = PN->getIncomingBlock(U);
+    if (UseBlock && UseBlock != BB)
+      return false;
+    UseBlock = BB;
+  }
+  if (!UseBlock || UseBlock == I->getParent())
+    return false;
+  if (!DT.dominates(I->getParent(), UseBlock))
+    return false;
+  if (LI.getLoopDepth(UseBlock) > LI.getLoopDepth(I->getParent()))
+    return false;
+
+  I->moveBefore(UseBlock->getFirstInsertionPt());
+  return true;
+}
+
+// Sink instructions toward their uses to shorten live ranges ahead of the
+// driver's register allocator. Runs only under -fpressure-schedule.
+class DxilScheduleForPressure : public FunctionPass {
+public:
+  static char ID; // Pass identification, replacement for typeid
+  explicit DxilScheduleForPressure() : FunctionPass(ID) {}
+
+  const char *getPassName() const override {
+    return "DXIL schedule for register pressure";
+  }
+
+  bool runOnFunction(Function &F) override {
+    DominatorTreeAnalysis DTA;
+    DominatorTree DT = DTA.run(F);
+    LoopInfo LI;
+    LI.Analyze(DT);
+
+    // Cross-block first, so a freshly sunk instruction is then placed next
+    // to its user by the within-block pass. Each round only moves values
+    // down the dominator tree, so the fixpoint terminates.
+    bool bUpdated = false;
+    bool bLocalUpdate;
+    do {
+      bLocalUpdate = false;
+      for (BasicBlock &BB : F) {
+        // Snapshot the block: sinking splices instructions into other
+        // blocks, which would invalidate a live block iterator.
+        SmallVector<Instruction *, 64> Worklist;
+        for (Instruction &I : BB)
+          Worklist.emplace_back(&I);
+        for (auto it = Worklist.rbegin(); it != Worklist.rend(); ++it)
+          bLocalUpdate |= TrySinkToUseBlock(*it, DT, LI);
+      }
+      bUpdated |= bLocalUpdate;
+    } while (bLocalUpdate);
+
+    for (BasicBlock &BB : F)
+      bUpdated |= SinkWithinBlock(BB);
+
+    return bUpdated;
+  }
+};
+
+char DxilScheduleForPressure::ID = 0;
+
+} // namespace
+
+FunctionPass *llvm::createDxilScheduleForPressurePass() {
+  return new DxilScheduleForPressure();
+}
+
+INITIALIZE_PASS(DxilScheduleForPressure, "dxil-schedule-for-pressure",
+                "DXIL schedule for register pressure", false, false)
@@ -453,7 +453,8 @@ public:
   bool runOnFunction(Function &F) override;
 
 private:
-  bool tryToHoist(BasicBlock *BB, BasicBlock *Succ0, BasicBlock *Succ1);
+  bool tryToHoist(ValueTable &VT, BasicBlock *BB, BasicBlock *Succ0,
+                  BasicBlock *Succ1);
 };
 
 char DxilSimpleGVNHoist::ID = 0;
@@ -469,10 +470,12 @@ bool HasOnePred(BasicBlock *BB) {
   return true;
 }
 
-bool DxilSimpleGVNHoist::tryToHoist(BasicBlock *BB, BasicBlock *Succ0,
-                                    BasicBlock *Succ1) {
-  // ValueNumber Succ0 and Succ1.
-  ValueTable VT;
+bool DxilSimpleGVNHoist::tryToHoist(ValueTable &VT, BasicBlock *BB,
+                                    BasicBlock *Succ0, BasicBlock *Succ1) {
+  // ValueNumber Succ0 and Succ1. The table is shared across the whole
+  // function, so operand chains already numbered for an earlier candidate
+  // are not walked again; VNtoInsts below scopes candidates to this pair of
+  // successors.
   DenseMap<uint32_t, SmallVector<Instruction *, 2>> VNtoInsts;
   for (Instruction &I : *Succ0) {
     uint32_t V = VT.lookupOrAdd(&I);
@@ -545,6 +548,7 @@ bool DxilSimpleGVNHoist::tryToHoist(BasicBlock *BB, BasicBlock *Succ0,
     for (; it != Insts.end(); it++) {
       Instruction *I = *it;
       I->replaceAllUsesWith(FirstI);
+      VT.erase(I);
       I->eraseFromParent();
     }
     Insts.clear();
@@ -555,6 +559,13 @@ bool DxilSimpleGVNHoist::tryToHoist(BasicBlock *BB, BasicBlock *Succ0,
 bool DxilSimpleGVNHoist::runOnFunction(Function &F) {
   BasicBlock &Entry = F.getEntryBlock();
   bool bUpdated = false;
+  // One value table for the whole function. Numbering recurses through
+  // operands, so a per-candidate table re-walks the same chains once per
+  // two-way branch; sharing it makes each instruction get numbered once.
+  // This is safe because unsafe instructions (loads, unknown calls, phis)
+  // always receive unique numbers, and erased instructions are dropped from
+  // the table before their memory is freed.
+  ValueTable VT;
   for (auto it = po_begin(&Entry); it != po_end(&Entry); it++) {
     BasicBlock *BB = *it;
     TerminatorInst *TI = BB->getTerminator();
@@ -571,7 +582,7 @@ bool DxilSimpleGVNHoist::runOnFunction(Function &F) {
       continue;
     if (!HasOnePred(Succ1))
       continue;
-    bUpdated |= tryToHoist(BB, Succ0, Succ1);
+    bUpdated |= tryToHoist(VT, BB, Succ0, Succ1);
   }
   return bUpdated;
 }
@@ -0,0 +1,185 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// DxilSpecializeConstants.cpp                                               //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Folds loads from a designated spec-constant cbuffer into literals so a    //
+// single compiled shader can be instantiated into concrete permutations     //
+// without re-running the front end.                                         //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/DXIL/DxilModule.h"
+#include "dxc/DXIL/DxilOperations.h"
+#include "dxc/HLSL/DxilGenerationPass.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Pass.h"
+
+#include <map>
+#include <string>
+
+using namespace llvm;
+using namespace hlsl;
+
+///////////////////////////////////////////////////////////////////////////////
+// Specialize late-bound constants.
+
+namespace {
+
+// Replaces 32-bit scalars loaded from one cbuffer with pipeline-creation-time
+// values, keyed by byte offset into the buffer. Run it over a compiled DXIL
+// module followed by simplification and DCE, then reassemble and validate:
+//
+//   -hlsl-dxil-spec-constants,cbuffer=SpecConstants,values=0:1;4:0x3f800000
+//
+// Branches and selects on the folded values collapse in the follow-up
+// passes, which is what turns one shader into a concrete permutation.
+class DxilSpecializeConstants : public ModulePass {
+
+  std::string CBufferName = "SpecConstants";
+  // Byte offset into the cbuffer -> 32-bit value to substitute.
+  std::map<unsigned, uint32_t> SpecValues;
+
+public:
+  static char ID; // Pass identification, replacement for typeid
+  explicit DxilSpecializeConstants() : ModulePass(ID) {}
+
+  const char *getPassName() const override {
+    return "DXIL specialize late-bound constants";
+  }
+
+  void applyOptions(PassOptions O) override;
+  bool runOnModule(Module &M) override;
+
+private:
+  bool SpecializeLoad(CallInst *Load);
+};
+
+void DxilSpecializeConstants::applyOptions(PassOptions O) {
+  StringRef name;
+  if (GetPassOption(O, "cbuffer", &name))
+    CBufferName = name;
+
+  StringRef values;
+  if (GetPassOption(O, "values", &values)) {
+    SmallVector<StringRef, 8> entries;
+    values.split(entries, ';', /*MaxSplit*/ -1, /*KeepEmpty*/ false);
+    for (StringRef entry : entries) {
+      StringRef offsetStr, valueStr;
+      std::tie(offsetStr, valueStr) = entry.split(':');
+      unsigned offset;
+      uint32_t value;
+      if (offsetStr.getAsInteger(0, offset) ||
+          valueStr.getAsInteger(0, value))
+        continue;
+      SpecValues[offset] = value;
+    }
+  }
+}
+
+bool DxilSpecializeConstants::SpecializeLoad(CallInst *Load) {
+  ConstantInt *Row = dyn_cast<ConstantInt>(Load->getArgOperand(2));
+  if (!Row)
+    return false;
+  const unsigned rowBase = Row->getLimitedValue() * 16;
+
+  bool bUpdated = false;
+  SmallVector<ExtractValueInst *, 4> deadExtracts;
+  for (User *U : Load->users()) {
+    ExtractValueInst *EV = dyn_cast<ExtractValueInst>(U);
+    if (!EV || EV->getNumIndices() != 1)
+      continue;
+    // The legacy layout packs four 32-bit lanes per row; other widths are
+    // left alone rather than guessed at.
+    Type *Ty = EV->getType();
+    if (!Ty->isFloatTy() && !Ty->isIntegerTy(32))
+      continue;
+    auto found = SpecValues.find(rowBase + EV->getIndices()[0] * 4);
+    if (found == SpecValues.end())
+      continue;
+
+    Constant *C;
+    if (Ty->isFloatTy())
+      C = ConstantFP::get(
+          EV->getContext(),
+          APFloat(APFloat::IEEEsingle, APInt(32, found->second)));
+    else
+      C = ConstantInt::get(Ty, found->second);
+    EV->replaceAllUsesWith(C);
+    deadExtracts.emplace_back(EV);
+    bUpdated = true;
+  }
+  // Only the extracts are erased here; the loads and handles they leave
+  // behind belong to the DCE that instantiation runs anyway.
+  for (ExtractValueInst *EV : deadExtracts)
+    EV->eraseFromParent();
+  return bUpdated;
+}
+
+bool DxilSpecializeConstants::runOnModule(Module &M) {
+  if (SpecValues.empty())
+    return false;
+
+  DxilModule &DM = M.GetOrCreateDxilModule();
+  OP *hlslOP = DM.GetOP();
+
+  int rangeID = -1;
+  for (auto &CB : DM.GetCBuffers()) {
+    if (CB->GetGlobalName() == CBufferName) {
+      rangeID = (int)CB->GetID();
+      break;
+    }
+  }
+  if (rangeID < 0)
+    return false;
+
+  // Collect the handles bound to that range, then the legacy loads through
+  // them. Library-style createHandleForLib chains are out of scope.
+  SmallVector<CallInst *, 8> loads;
+  for (auto it : hlslOP->GetOpFuncList(DXIL::OpCode::CreateHandle)) {
+    Function *F = it.second;
+    if (!F)
+      continue;
+    for (User *U : F->users()) {
+      CallInst *Handle = cast<CallInst>(U);
+      ConstantInt *ResClass = dyn_cast<ConstantInt>(
+          Handle->getArgOperand(DXIL::OperandIndex::kCreateHandleResClassOpIdx));
+      ConstantInt *ResID = dyn_cast<ConstantInt>(
+          Handle->getArgOperand(DXIL::OperandIndex::kCreateHandleResIDOpIdx));
+      if (!ResClass || !ResID)
+        continue;
+      if (ResClass->getLimitedValue() != (unsigned)DXIL::ResourceClass::CBuffer ||
+          ResID->getLimitedValue() != (unsigned)rangeID)
+        continue;
+      for (User *HU : Handle->users()) {
+        CallInst *Load = dyn_cast<CallInst>(HU);
+        if (Load &&
+            OP::IsDxilOpFuncCallInst(Load, DXIL::OpCode::CBufferLoadLegacy) &&
+            Load->getArgOperand(1) == Handle)
+          loads.emplace_back(Load);
+      }
+    }
+  }
+
+  bool bUpdated = false;
+  for (CallInst *Load : loads)
+    bUpdated |= SpecializeLoad(Load);
+  return bUpdated;
+}
+
+char DxilSpecializeConstants::ID = 0;
+
+} // namespace
+
+ModulePass *llvm::createDxilSpecializeConstantsPass() {
+  return new DxilSpecializeConstants();
+}
+
+INITIALIZE_PASS(DxilSpecializeConstants, "hlsl-dxil-spec-constants",
+                "DXIL specialize late-bound constants", false, false)
@@ -21,8 +21,13 @@
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/PatternMatch.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/MathExtras.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
 #include <vector>
 
 using namespace llvm;
@@ -32,6 +37,8 @@ using namespace hlsl;
 // This pass is to make sure that we generate correct buffer load for DXIL
 // For DXIL < 1.2, rawBufferLoad will be translated to BufferLoad instruction
 // without mask.
+// For DXIL >= 1.2, adjacent scalar rawBufferLoads from the same address are
+// coalesced into one wide load.
 
 namespace {
 
@@ -88,6 +95,9 @@ public:
         }
       }
     }
+    if (major == 1 && minor >= 2) {
+      CoalesceRawBufferLoads(M, hlslOP);
+    }
     return true;
   }
 
@@ -97,7 +107,90 @@ private:
   void ReplaceRawBufferStore(Function *F, Module &M);
   void ReplaceRawBufferLoad64Bit(Function *F, Type *EltTy, Module &M);
   void ReplaceRawBufferStore64Bit(Function *F, Type *EltTy, Module &M);
+  // Merge adjacent scalar rawBufferLoads into wide loads for DXIL >= 1.2
+  bool CoalesceRawBufferLoads(Module &M, hlsl::OP *hlslOP);
+};
+
+// One coalescing candidate: a rawBufferLoad whose address is a common SSA
+// base plus a known constant byte offset.
+struct RawBufLoadCandidate {
+  CallInst *CI;
+  uint64_t Offset;    // constant byte offset of component 0
+  unsigned Mask;      // i8 component mask of the original load
+  unsigned Align;     // declared address alignment
+  unsigned ScanOrder; // program order within the window, for insertion point
 };
+
+// Key identifying loads that can only differ by a constant byte offset:
+// (handle, SSA address base, overload function). The overload function also
+// separates structured-buffer loads (constant in elementOffset, base is the
+// element index) from raw-buffer loads (constant in the byte index, base is
+// the remaining add operand or null when fully constant).
+typedef std::tuple<Value *, Value *, Function *> RawBufLoadKey;
+
+// Extracts the (base, constant offset) form of a load's address.
+// Returns false when there is no constant component to combine on.
+static bool DecomposeRawBufAddress(CallInst *CI, Value *&base,
+                                   uint64_t &constOff) {
+  Value *idx =
+      CI->getArgOperand(DXIL::OperandIndex::kRawBufferLoadIndexOpIdx);
+  Value *off =
+      CI->getArgOperand(DXIL::OperandIndex::kRawBufferLoadElementOffsetOpIdx);
+  if (ConstantInt *offC = dyn_cast<ConstantInt>(off)) {
+    // Structured buffer: element index stays, offset within the element
+    // carries the constant.
+    base = idx;
+    constOff = offC->getLimitedValue();
+    return true;
+  }
+  if (isa<UndefValue>(off)) {
+    // Raw buffer: the byte index is the whole address.
+    if (ConstantInt *idxC = dyn_cast<ConstantInt>(idx)) {
+      base = nullptr;
+      constOff = idxC->getLimitedValue();
+      return true;
+    }
+    using namespace llvm::PatternMatch;
+    Value *addBase;
+    ConstantInt *addOff;
+    if (match(idx, m_Add(m_Value(addBase), m_ConstantInt(addOff)))) {
+      base = addBase;
+      constOff = addOff->getLimitedValue();
+      return true;
+    }
+    // Plain dynamic byte index: treat as base + 0 so it can pair with
+    // base + constant neighbors.
+    base = idx;
+    constOff = 0;
+    return true;
+  }
+  return false;
+}
+
+static bool GetRawBufLoadMaskAndAlign(CallInst *CI, unsigned &mask,
+                                      unsigned &align) {
+  ConstantInt *maskC = dyn_cast<ConstantInt>(
+      CI->getArgOperand(DXIL::OperandIndex::kRawBufferLoadMaskOpIdx));
+  ConstantInt *alignC = dyn_cast<ConstantInt>(
+      CI->getArgOperand(DXIL::OperandIndex::kRawBufferLoadAlignmentOpIdx));
+  if (!maskC || !alignC)
+    return false;
+  mask = (unsigned)maskC->getLimitedValue();
+  align = (unsigned)alignC->getLimitedValue();
+  return mask != 0 && mask <= 0xF;
+}
+
+// Loads feeding CheckAccessFullyMapped (status, index 4) or used as a whole
+// aggregate cannot be rewritten component-wise.
+static bool OnlyComponentExtractUsers(CallInst *CI) {
+  for (User *U : CI->users()) {
+    ExtractValueInst *EV = dyn_cast<ExtractValueInst>(U);
+    if (!EV || EV->getNumIndices() != 1 || *EV->idx_begin() > 3)
+      return false;
+  }
+  return true;
+}
+
 } // namespace
 
 void DxilTranslateRawBuffer::ReplaceRawBufferLoad(Function *F,
@@ -119,6 +212,160 @@ void DxilTranslateRawBuffer::ReplaceRawBufferStore64Bit(Function *F, Type *ETy,
   dxilutil::ReplaceRawBufferStore64Bit(F, ETy, M.GetDxilModule().GetOP());
 }
 
+// Merges provably-adjacent scalar rawBufferLoads into a single wide load.
+// Candidates share a handle and an SSA address base within one basic block
+// with no intervening instruction that may write memory, and their constant
+// byte offsets land on distinct components of one up-to-four-component load.
+// The merged load uses a contiguous mask covering the full span; each
+// original result component becomes an extractvalue of the wide result.
+bool DxilTranslateRawBuffer::CoalesceRawBufferLoads(Module &M,
+                                                    hlsl::OP *hlslOP) {
+  bool bUpdated = false;
+  typedef std::map<RawBufLoadKey, std::vector<RawBufLoadCandidate>> WindowMap;
+
+  for (Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    for (BasicBlock &BB : F) {
+      WindowMap window;
+      unsigned scanOrder = 0;
+
+      auto flushWindow = [&]() {
+        for (auto &kv : window) {
+          std::vector<RawBufLoadCandidate> &loads = kv.second;
+          if (loads.size() < 2)
+            continue;
+          Function *loadF = std::get<2>(kv.first);
+          Type *ETy = hlslOP->GetOverloadType(DXIL::OpCode::RawBufferLoad, loadF);
+          unsigned compSize = ETy->getScalarSizeInBits() / 8;
+          // 64-bit overloads carry at most two components with their own
+          // mask translation rules; leave them alone.
+          if (compSize == 0 || compSize > 4)
+            continue;
+          std::sort(loads.begin(), loads.end(),
+                    [](const RawBufLoadCandidate &a,
+                       const RawBufLoadCandidate &b) {
+                      return a.Offset < b.Offset;
+                    });
+          // Greedily take runs that fit in one four-component load.
+          for (size_t i = 0; i < loads.size();) {
+            uint64_t baseOff = loads[i].Offset;
+            std::vector<size_t> members;
+            unsigned mergedMask = 0;
+            for (size_t j = i; j < loads.size(); ++j) {
+              uint64_t delta = loads[j].Offset - baseOff;
+              if (delta % compSize != 0)
+                break;
+              uint64_t comp = delta / compSize;
+              // Highest component this member touches must stay in range.
+              unsigned hi = 31 - countLeadingZeros(loads[j].Mask);
+              if (comp + hi > 3)
+                break;
+              mergedMask |= loads[j].Mask << comp;
+              members.push_back(j);
+            }
+            if (members.size() < 2) {
+              ++i;
+              continue;
+            }
+            // Insert the wide load where the earliest member was, so its
+            // result dominates every member's extracts.
+            size_t firstIdx = members[0];
+            for (size_t m : members)
+              if (loads[m].ScanOrder < loads[firstIdx].ScanOrder)
+                firstIdx = m;
+            CallInst *firstCI = loads[firstIdx].CI;
+            IRBuilder<> Builder(firstCI);
+
+            // Widen the mask into a contiguous prefix covering the span.
+            unsigned hiComp = 31 - countLeadingZeros(mergedMask);
+            unsigned prefixMask = (1u << (hiComp + 1)) - 1;
+            unsigned minAlign = loads[members[0]].Align;
+            for (size_t m : members)
+              minAlign = std::min(minAlign, loads[m].Align);
+
+            // Build the wide call from the earliest member so every operand
+            // already dominates the insertion point, rewriting only the
+            // constant part of the address to the lowest member offset.
+            SmallVector<Value *, 6> args(firstCI->arg_operands().begin(),
+                                         firstCI->arg_operands().end());
+            Value *base = std::get<1>(kv.first);
+            if (isa<ConstantInt>(
+                    args[DXIL::OperandIndex::kRawBufferLoadElementOffsetOpIdx])) {
+              // Structured buffer: shared element index, constant offset.
+              args[DXIL::OperandIndex::kRawBufferLoadElementOffsetOpIdx] =
+                  hlslOP->GetU32Const((unsigned)baseOff);
+            } else if (base == nullptr) {
+              // Raw buffer with fully constant byte address.
+              args[DXIL::OperandIndex::kRawBufferLoadIndexOpIdx] =
+                  hlslOP->GetU32Const((unsigned)baseOff);
+            } else if (loads[firstIdx].Offset != baseOff) {
+              // Raw buffer: rebuild base + lowest constant byte offset.
+              args[DXIL::OperandIndex::kRawBufferLoadIndexOpIdx] =
+                  baseOff == 0
+                      ? base
+                      : Builder.CreateAdd(base,
+                                          hlslOP->GetU32Const((unsigned)baseOff));
+            }
+            args[DXIL::OperandIndex::kRawBufferLoadMaskOpIdx] =
+                hlslOP->GetI8Const(prefixMask);
+            args[DXIL::OperandIndex::kRawBufferLoadAlignmentOpIdx] =
+                hlslOP->GetU32Const(minAlign);
+            CallInst *wideCI = Builder.CreateCall(loadF, args);
+
+            for (size_t m : members) {
+              RawBufLoadCandidate &cand = loads[m];
+              unsigned comp = (unsigned)((cand.Offset - baseOff) / compSize);
+              for (auto UI = cand.CI->user_begin(),
+                        UE = cand.CI->user_end();
+                   UI != UE;) {
+                ExtractValueInst *EV = cast<ExtractValueInst>(*(UI++));
+                ExtractValueInst *wideEV = ExtractValueInst::Create(
+                    wideCI, {comp + *EV->idx_begin()}, EV->getName(), EV);
+                wideEV->setDebugLoc(EV->getDebugLoc());
+                EV->replaceAllUsesWith(wideEV);
+                EV->eraseFromParent();
+              }
+              cand.CI->eraseFromParent();
+            }
+            bUpdated = true;
+            i = members.back() + 1;
+          }
+        }
+        window.clear();
+      };
+
+      for (auto II = BB.begin(), IE = BB.end(); II != IE;) {
+        Instruction *I = &*(II++);
+        if (CallInst *CI = dyn_cast<CallInst>(I)) {
+          DXIL::OpCodeClass opClass;
+          Function *called = CI->getCalledFunction();
+          if (called && hlslOP->GetOpCodeClass(called, opClass) &&
+              opClass == DXIL::OpCodeClass::RawBufferLoad) {
+            Value *base;
+            uint64_t constOff;
+            unsigned mask, align;
+            if (DecomposeRawBufAddress(CI, base, constOff) &&
+                GetRawBufLoadMaskAndAlign(CI, mask, align) &&
+                OnlyComponentExtractUsers(CI)) {
+              Value *handle = CI->getArgOperand(
+                  DXIL::OperandIndex::kRawBufferLoadHandleOpIdx);
+              RawBufLoadCandidate cand = {CI, constOff, mask, align,
+                                          scanOrder++};
+              window[RawBufLoadKey(handle, base, called)].push_back(cand);
+            }
+            continue; // read-only op, does not clobber the window
+          }
+        }
+        if (I->mayWriteToMemory())
+          flushWindow();
+      }
+      flushWindow();
+    }
+  }
+  return bUpdated;
+}
+
 char DxilTranslateRawBuffer::ID = 0;
 ModulePass *llvm::createDxilTranslateRawBuffer() {
   return new DxilTranslateRawBuffer();
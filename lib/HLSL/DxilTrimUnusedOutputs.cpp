@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// DxilTrimUnusedOutputs.cpp                                                 //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Remove output signature elements the downstream stage never reads.        //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/HLSL/DxilGenerationPass.h"
+#include "dxc/DXIL/DxilOperations.h"
+#include "dxc/DXIL/DxilSignatureElement.h"
+#include "dxc/DXIL/DxilModule.h"
+#include "dxc/Support/Global.h"
+
+#include "llvm/IR/Module.h"
+#include "llvm/Pass.h"
+#include "llvm/ADT/StringExtras.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+using namespace llvm;
+using namespace hlsl;
+
+// The pass takes the set of semantics the paired downstream shader actually
+// reads (e.g. collected from its input signature) and dead-codes every
+// arbitrary output element outside that set: the stores are erased and the
+// element is dropped from the output signature, freeing its packed rows.
+// System values and any element not explicitly trimmable are always kept, so
+// an empty or missing option list makes the pass a no-op.
+//
+// Usage through IDxcOptimizer / dxopt:
+//   -hlsl-dxil-trim-unused-outputs,consumed-outputs=TEXCOORD0;COLOR1
+namespace {
+
+class DxilTrimUnusedOutputs : public ModulePass {
+public:
+  static char ID; // Pass identification, replacement for typeid
+  explicit DxilTrimUnusedOutputs() : ModulePass(ID) {}
+
+  const char *getPassName() const override {
+    return "DXIL trim unused outputs";
+  }
+
+  void applyOptions(PassOptions O) override {
+    StringRef consumedList;
+    if (GetPassOption(O, "consumed-outputs", &consumedList)) {
+      m_bHasConsumedList = true;
+      SmallVector<StringRef, 8> semantics;
+      consumedList.split(semantics, ";", /*MaxSplit*/ -1, /*KeepEmpty*/ false);
+      for (StringRef semantic : semantics) {
+        StringRef name;
+        unsigned index = 0;
+        Semantic::DecomposeNameAndIndex(semantic, &name, &index);
+        m_ConsumedSemantics[name.upper()].push_back(index);
+      }
+    }
+  }
+
+  bool runOnModule(Module &M) override {
+    if (!m_bHasConsumedList)
+      return false;
+
+    DxilModule &DM = M.GetOrCreateDxilModule();
+    const ShaderModel *pSM = DM.GetShaderModel();
+    // Libraries have no single downstream consumer; GS stream assignment and
+    // HS/DS signature pairing make trimming unsafe there.
+    if (pSM->IsLib() || pSM->IsGS() || pSM->IsHS())
+      return false;
+    if (!DM.GetEntryFunction())
+      return false;
+
+    DxilSignature &outputSig = DM.GetOutputSignature();
+
+    // Decide which elements can go. Only arbitrary (user) semantics are
+    // candidates; system values carry meaning beyond the next stage's reads.
+    std::vector<unsigned> deadIndices;
+    for (unsigned i = 0; i < outputSig.GetElements().size(); i++) {
+      const DxilSignatureElement &SE = outputSig.GetElement(i);
+      if (!SE.GetSemantic()->IsArbitrary())
+        continue;
+      if (!IsConsumed(SE))
+        deadIndices.push_back(i);
+    }
+    if (deadIndices.empty())
+      return false;
+
+    // Compute the ID remap before mutating anything: each surviving element
+    // gets its rank among survivors, matching how IDs are assigned on append.
+    std::unordered_map<unsigned, unsigned> idRemap;
+    std::vector<bool> isDead(outputSig.GetElements().size(), false);
+    for (unsigned deadIdx : deadIndices)
+      isDead[deadIdx] = true;
+    unsigned nextId = 0;
+    for (unsigned i = 0; i < outputSig.GetElements().size(); i++) {
+      if (!isDead[i])
+        idRemap[outputSig.GetElement(i).GetID()] = nextId++;
+    }
+
+    // Erase stores to dead elements and rewrite IDs on the rest.
+    hlsl::OP *hlslOP = DM.GetOP();
+    DXIL::OpCode opcode = pSM->IsMS() ? DXIL::OpCode::StoreVertexOutput
+                                      : DXIL::OpCode::StoreOutput;
+    std::vector<CallInst *> deadStores;
+    for (auto it : hlslOP->GetOpFuncList(opcode)) {
+      Function *F = it.second;
+      if (!F)
+        continue;
+      for (User *U : F->users()) {
+        CallInst *CI = cast<CallInst>(U);
+        Value *sigID =
+            CI->getArgOperand(DXIL::OperandIndex::kStoreOutputIDOpIdx);
+        unsigned id = cast<ConstantInt>(sigID)->getLimitedValue();
+        auto remapIt = idRemap.find(id);
+        if (remapIt == idRemap.end())
+          deadStores.push_back(CI);
+        else if (remapIt->second != id)
+          CI->setArgOperand(DXIL::OperandIndex::kStoreOutputIDOpIdx,
+                            hlslOP->GetU32Const(remapIt->second));
+      }
+    }
+    for (CallInst *CI : deadStores)
+      CI->eraseFromParent();
+
+    // Drop the elements back to front so indices stay valid, then renumber.
+    for (auto it = deadIndices.rbegin(); it != deadIndices.rend(); ++it)
+      outputSig.RemoveElement(*it);
+    for (unsigned i = 0; i < outputSig.GetElements().size(); i++)
+      outputSig.GetElement(i).SetID(i);
+
+    // Any previously computed ViewId state refers to the old output layout;
+    // clear it so it is recomputed rather than serialized stale.
+    DM.GetSerializedViewIdState().clear();
+
+    DM.ReEmitDxilResources();
+    return true;
+  }
+
+private:
+  bool IsConsumed(const DxilSignatureElement &SE) const {
+    auto it = m_ConsumedSemantics.find(StringRef(SE.GetSemanticName()).upper());
+    if (it == m_ConsumedSemantics.end())
+      return false;
+    // An element covering several rows (semantic index range) stays if any
+    // of its indices are read downstream.
+    for (unsigned semIdx : SE.GetSemanticIndexVec()) {
+      for (unsigned consumedIdx : it->second) {
+        if (semIdx == consumedIdx)
+          return true;
+      }
+    }
+    return false;
+  }
+
+  // Upper-cased semantic name -> consumed semantic indices.
+  std::map<std::string, std::vector<unsigned>> m_ConsumedSemantics;
+  bool m_bHasConsumedList = false;
+};
+
+} // namespace
+
+char DxilTrimUnusedOutputs::ID = 0;
+
+ModulePass *llvm::createDxilTrimUnusedOutputsPass() {
+  return new DxilTrimUnusedOutputs();
+}
+
+INITIALIZE_PASS(DxilTrimUnusedOutputs, "hlsl-dxil-trim-unused-outputs",
+                "DXIL trim unused outputs", false, false)
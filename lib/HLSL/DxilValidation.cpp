@@ -12,6 +12,7 @@
 #include "dxc/Support/Global.h"
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/Support/FileIOHelper.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include "dxc/HLSL/DxilValidation.h"
 #include "dxc/DxilContainer/DxilContainerAssembler.h"
@@ -43,8 +44,10 @@
 #include "llvm/IR/ModuleSlotTracker.h"
 #include "llvm/ADT/BitVector.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Bitcode/ReaderWriter.h"
+#include <unordered_map>
 #include <unordered_set>
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/IR/Dominators.h"
@@ -54,7 +57,9 @@
 #include "dxc/HLSL/DxilPackSignatureElement.h"
 #include "dxc/DxilRootSignature/DxilRootSignature.h"
 #include <algorithm>
+#include <atomic>
 #include <deque>
+#include <mutex>
 
 using namespace llvm;
 using namespace std;
@@ -324,6 +329,44 @@ static void emitDxilDiag(LLVMContext &Ctx, const char *str) {
   hlsl::dxilutil::EmitErrorOnContext(Ctx, str);
 }
 
+// One diagnostic captured while a validation worker runs, recorded with
+// enough of the original DiagnosticInfoDxil to be replayed unchanged.
+struct CapturedDiag {
+  const Function *Func;
+  const DILocation *DLoc;
+  DiagnosticSeverity Severity;
+  std::string Msg;
+};
+
+// Diagnostics captured for a single function; workers fill these in any
+// order and the main thread replays them in module order, so parallel
+// validation reports exactly what the serial walk would.
+struct FunctionDiagRecord {
+  std::vector<CapturedDiag> Diags;
+};
+
+thread_local FunctionDiagRecord *tlDiagRecord = nullptr;
+
+void CaptureDiagHandler(const DiagnosticInfo &DI, void *Context) {
+  if (!tlDiagRecord)
+    return;
+  CapturedDiag D;
+  D.Severity = DI.getSeverity();
+  if (const DiagnosticInfoDxil *DxilDI = dyn_cast<DiagnosticInfoDxil>(&DI)) {
+    D.Func = DxilDI->getFunction();
+    D.DLoc = DxilDI->getLocation();
+    D.Msg = DxilDI->getMsgStr().str();
+  } else {
+    D.Func = nullptr;
+    D.DLoc = nullptr;
+    raw_string_ostream OS(D.Msg);
+    DiagnosticPrinterRawOStream P(OS);
+    DI.print(P);
+    OS.flush();
+  }
+  tlDiagRecord->Diags.push_back(std::move(D));
+}
+
 } // anon namespace
 
 namespace hlsl {
@@ -381,7 +424,10 @@ struct EntryStatus {
 };
 
 struct ValidationContext {
-  bool Failed = false;
+  // Failed is atomic and EmitInstrErrorMsg takes DiagMutex so per-function
+  // validation may be sharded across worker threads; see ValidateAllFunctions.
+  std::atomic<bool> Failed{false};
+  std::mutex DiagMutex;
   Module &M;
   Module *pDebugModule;
   DxilModule &DxilMod;
@@ -396,6 +442,13 @@ struct ValidationContext {
   std::unordered_map<Value *, DxilResourceProperties> ResPropMap;
   std::unordered_map<Function *, std::vector<Function*>> PatchConstantFuncMap;
   std::unordered_map<Function *, std::unique_ptr<EntryStatus>> entryStatusMap;
+  // Rule IDs recorded in quiet mode instead of formatted diagnostics;
+  // guarded by DiagMutex.
+  std::vector<ValidationRule> FailedRuleIds;
+  // Per-call settings for this validation; copied so the context never
+  // refers back to caller-owned storage.
+  const DxilValidationOptions Opts;
+  const bool bQuietMode;
   bool isLibProfile;
   const unsigned kDxilControlFlowHintMDKind;
   const unsigned kDxilPreciseMDKind;
@@ -405,10 +458,13 @@ struct ValidationContext {
   ModuleSlotTracker slotTracker;
 
   ValidationContext(Module &llvmModule, Module *DebugModule,
-                    DxilModule &dxilModule)
+                    DxilModule &dxilModule,
+                    const DxilValidationOptions &Opts = DxilValidationOptions())
       : M(llvmModule), pDebugModule(DebugModule), DxilMod(dxilModule),
         DL(llvmModule.getDataLayout()),
         LastRuleEmit((ValidationRule)-1),
+        Opts(Opts),
+        bQuietMode(Opts.bQuietMode),
         kDxilControlFlowHintMDKind(llvmModule.getContext().getMDKindID(
             DxilMDHelper::kDxilControlFlowHintMDName)),
         kDxilPreciseMDKind(llvmModule.getContext().getMDKindID(
@@ -591,9 +647,6 @@ struct ValidationContext {
         }
       }
     }
-    Type *ResPropTy = hlslOP->GetResourcePropertiesType();
-    const ShaderModel &SM = *DxilMod.GetShaderModel();
-
     for (auto &it : hlslOP->GetOpFuncList(DXIL::OpCode::AnnotateHandle)) {
       Function *F = it.second;
       if (!F)
@@ -615,8 +668,7 @@ struct ValidationContext {
           continue;
         }
 
-        DxilResourceProperties RP =
-            resource_helper::loadFromAnnotateHandle(hdl, ResPropTy, SM);
+        DxilResourceProperties RP = DxilMod.GetCachedResourceProperties(hdl);
         ResPropMap[CI] = RP;
       }
     }
@@ -630,8 +682,21 @@ struct ValidationContext {
 
   DxilResourceProperties GetResourceFromVal(Value *resVal);
 
+  // In quiet mode record the failing rule and skip all message formatting;
+  // returns true when the caller should emit nothing.
+  bool RecordQuietFailure(ValidationRule rule) {
+    if (!bQuietMode)
+      return false;
+    std::lock_guard<std::mutex> Guard(DiagMutex);
+    FailedRuleIds.push_back(rule);
+    Failed = true;
+    return true;
+  }
+
   void EmitGlobalVariableFormatError(GlobalVariable *GV, ValidationRule rule,
                                      ArrayRef<StringRef> args) {
+    if (RecordQuietFailure(rule))
+      return;
     std::string ruleText = GetValidationRuleText(rule);
     FormatRuleText(ruleText, args);
     if (pDebugModule)
@@ -642,6 +707,8 @@ struct ValidationContext {
 
   // This is the least desirable mechanism, as it has no context.
   void EmitError(ValidationRule rule) {
+    if (RecordQuietFailure(rule))
+      return;
     dxilutil::EmitErrorOnContext(M.getContext(), GetValidationRuleText(rule));
     Failed = true;
   }
@@ -672,6 +739,8 @@ struct ValidationContext {
   }
 
   void EmitFormatError(ValidationRule rule, ArrayRef<StringRef> args) {
+    if (RecordQuietFailure(rule))
+      return;
     std::string ruleText = GetValidationRuleText(rule);
     FormatRuleText(ruleText, args);
     dxilutil::EmitErrorOnContext(M.getContext(), ruleText);
@@ -679,6 +748,8 @@ struct ValidationContext {
   }
 
   void EmitMetaError(Metadata *Meta, ValidationRule rule) {
+    if (RecordQuietFailure(rule))
+      return;
     std::string O;
     raw_string_ostream OSS(O);
     Meta->print(OSS, &M);
@@ -687,6 +758,8 @@ struct ValidationContext {
   }
 
   void EmitResourceError(const hlsl::DxilResourceBase *Res, ValidationRule rule) {
+    if (RecordQuietFailure(rule))
+      return;
     std::string QuotedRes = " '" + Res->GetGlobalName() + "'";
     dxilutil::EmitErrorOnContext(M.getContext(), GetValidationRuleText(rule) + QuotedRes);
     Failed = true;
@@ -695,6 +768,8 @@ struct ValidationContext {
   void EmitResourceFormatError(const hlsl::DxilResourceBase *Res,
                                ValidationRule rule,
                                ArrayRef<StringRef> args) {
+    if (RecordQuietFailure(rule))
+      return;
     std::string QuotedRes = " '" + Res->GetGlobalName() + "'";
     std::string ruleText = GetValidationRuleText(rule);
     FormatRuleText(ruleText, args);
@@ -730,6 +805,11 @@ struct ValidationContext {
   }
 
   void EmitInstrErrorMsg(Instruction *I, ValidationRule Rule, std::string Msg) {
+    if (RecordQuietFailure(Rule))
+      return;
+    // Serialize access to the slot tracker and duplicate-suppression state;
+    // workers capture the emitted diagnostics thread-locally.
+    std::lock_guard<std::mutex> Guard(DiagMutex);
     Instruction *DbgI = GetDebugInstr(I);
     const DebugLoc L = DbgI->getDebugLoc();
     if (L) {
@@ -787,6 +867,8 @@ struct ValidationContext {
   }
 
   void EmitInstrFormatError(Instruction *I, ValidationRule rule, ArrayRef<StringRef> args) {
+    if (RecordQuietFailure(rule))
+      return;
     std::string ruleText = GetValidationRuleText(rule);
     FormatRuleText(ruleText, args);
     EmitInstrErrorMsg(I, rule, ruleText);
@@ -797,6 +879,8 @@ struct ValidationContext {
   }
 
   void EmitTypeError(Type *Ty, ValidationRule rule) {
+    if (RecordQuietFailure(rule))
+      return;
     std::string O;
     raw_string_ostream OSS(O);
     Ty->print(OSS);
@@ -804,6 +888,8 @@ struct ValidationContext {
   }
 
   void EmitFnError(Function *F, ValidationRule rule) {
+    if (RecordQuietFailure(rule))
+      return;
     if (pDebugModule)
       F = pDebugModule->getFunction(F->getName());
     dxilutil::EmitErrorOnFunction(F, GetValidationRuleText(rule));
@@ -811,6 +897,8 @@ struct ValidationContext {
   }
 
   void EmitFnFormatError(Function *F, ValidationRule rule, ArrayRef<StringRef> args) {
+    if (RecordQuietFailure(rule))
+      return;
     std::string ruleText = GetValidationRuleText(rule);
     FormatRuleText(ruleText, args);
     if (pDebugModule)
@@ -2436,13 +2524,19 @@ static void ValidateDxilOperationCallInProfile(CallInst *CI,
         auto it = ValCtx.HandleResIndexMap.find(handle);
         if (it != ValCtx.HandleResIndexMap.end()) {
           unsigned resIndex = it->second;
-          if (ValCtx.UavCounterIncMap.count(resIndex)) {
-            if (isInc != ValCtx.UavCounterIncMap[resIndex]) {
-              ValCtx.EmitInstrError(CI,
-                                    ValidationRule::InstrOnlyOneAllocConsume);
-            }
-          } else {
-            ValCtx.UavCounterIncMap[resIndex] = isInc;
+          bool conflictingInc = false;
+          {
+            // UavCounterIncMap is shared across validation workers.
+            std::lock_guard<std::mutex> Guard(ValCtx.DiagMutex);
+            auto incIt = ValCtx.UavCounterIncMap.find(resIndex);
+            if (incIt != ValCtx.UavCounterIncMap.end())
+              conflictingInc = isInc != incIt->second;
+            else
+              ValCtx.UavCounterIncMap[resIndex] = isInc;
+          }
+          if (conflictingInc) {
+            ValCtx.EmitInstrError(CI,
+                                  ValidationRule::InstrOnlyOneAllocConsume);
           }
         }
 
@@ -3598,30 +3692,7 @@ static void ValidateGlobalVariable(GlobalVariable &GV,
       dxilutil::IsStaticGlobal(&GV) || dxilutil::IsSharedMemoryGlobal(&GV);
 
   if (ValCtx.isLibProfile) {
-    auto isCBufferGlobal = [&](const std::vector<std::unique_ptr<DxilCBuffer>> &ResTab) -> bool {
-      for (auto &Res : ResTab)
-        if (Res->GetGlobalSymbol() == &GV)
-          return true;
-      return false;
-    };
-    auto isResourceGlobal = [&](const std::vector<std::unique_ptr<DxilResource>> &ResTab) -> bool {
-      for (auto &Res : ResTab)
-        if (Res->GetGlobalSymbol() == &GV)
-          return true;
-      return false;
-    };
-    auto isSamplerGlobal = [&](const std::vector<std::unique_ptr<DxilSampler>> &ResTab) -> bool {
-      for (auto &Res : ResTab)
-        if (Res->GetGlobalSymbol() == &GV)
-          return true;
-      return false;
-    };
-
-    bool isRes = isCBufferGlobal(ValCtx.DxilMod.GetCBuffers());
-    isRes |= isResourceGlobal(ValCtx.DxilMod.GetUAVs());
-    isRes |= isResourceGlobal(ValCtx.DxilMod.GetSRVs());
-    isRes |= isSamplerGlobal(ValCtx.DxilMod.GetSamplers());
-    isInternalGV |= isRes;
+    isInternalGV |= ValCtx.DxilMod.LookupResourceBySymbol(&GV) != nullptr;
   }
 
   if (!isInternalGV) {
@@ -3671,6 +3742,13 @@ static void CollectFixAddressAccess(Value *V,
 
 static bool IsDivergent(Value *V) {
   // TODO: return correct result.
+  // The machinery for a real answer already exists: DivergenceAnalysis in
+  // lib/Analysis with the DXIL divergence sources modeled by
+  // DxilTTIImpl::isSourceOfDivergence (lib/HLSL/DxilTargetTransformInfo.cpp).
+  // It is deliberately not wired up here - answering precisely would make
+  // InstrTGSMRaceCond start failing containers that today's validators
+  // accept, and which shaders validate is versioned behavior, so enabling
+  // this is a validator-version decision rather than an implementation gap.
   return false;
 }
 
@@ -5579,43 +5657,110 @@ void GetValidationVersion(_Out_ unsigned *pMajor, _Out_ unsigned *pMinor) {
   // VALRULE-TEXT:END
 }
 
-_Use_decl_annotations_ HRESULT
-ValidateDxilModule(llvm::Module *pModule, llvm::Module *pDebugModule) {
-  DxilModule *pDxilModule = DxilModule::TryGetDxilModule(pModule);
-  if (!pDxilModule) {
-    return DXC_E_IR_VERIFICATION_FAILED;
-  }
-  if (pDxilModule->HasMetadataErrors()) {
-    dxilutil::EmitErrorOnContext(pModule->getContext(), "Metadata error encountered in non-critical metadata (such as Type Annotations).");
-    return DXC_E_IR_VERIFICATION_FAILED;
+// Validates every function in the module. With parallelism enabled the
+// functions are sharded across worker threads; each worker captures its
+// diagnostics per function through a thread-local redirection of the
+// context's diagnostic handler, and the main thread replays them in module
+// order afterwards so output is deterministic.
+static void ValidateAllFunctions(ValidationContext &ValCtx) {
+  Module *pModule = ValCtx.DxilMod.GetModule();
+  unsigned ThreadCount = ValCtx.Opts.ThreadCount;
+  if (ThreadCount < 2 || pModule->size() < 2) {
+    for (Function &F : pModule->functions()) {
+      ValidateFunction(F, ValCtx);
+    }
+    return;
   }
 
-  ValidationContext ValCtx(*pModule, pDebugModule, *pDxilModule);
+  std::vector<Function *> functions;
+  for (Function &F : pModule->functions())
+    functions.push_back(&F);
+  std::vector<FunctionDiagRecord> records(functions.size());
 
-  ValidateBitcode(ValCtx);
+  LLVMContext &Ctx = pModule->getContext();
+  LLVMContext::DiagnosticHandlerTy OrigHandler = Ctx.getDiagnosticHandler();
+  void *OrigDiagContext = Ctx.getDiagnosticContext();
+  Ctx.setDiagnosticHandler(CaptureDiagHandler, nullptr);
 
-  ValidateMetadata(ValCtx);
+  std::atomic<size_t> nextFunction(0);
+  auto worker = [&]() {
+    for (;;) {
+      size_t i = nextFunction++;
+      if (i >= functions.size())
+        break;
+      tlDiagRecord = &records[i];
+      ValidateFunction(*functions[i], ValCtx);
+    }
+    tlDiagRecord = nullptr;
+  };
 
-  ValidateShaderState(ValCtx);
+  // Shard across the process-wide pool rather than spawning threads per
+  // validation; the waiting thread drains shards too, hence the +1.
+  ThreadPool &pool = ThreadPool::Get();
+  ThreadCount = std::min(ThreadCount, pool.GetWorkerCount() + 1);
+  {
+    ThreadPoolTaskGroup group;
+    for (unsigned i = 0; i < ThreadCount; i++)
+      pool.Async(worker, ThreadPoolPriority::High, &group);
+    group.Wait();
+  }
+
+  Ctx.setDiagnosticHandler(OrigHandler, OrigDiagContext);
 
-  ValidateGlobalVariables(ValCtx);
+  // Replay captured diagnostics in module order.
+  for (FunctionDiagRecord &record : records) {
+    for (CapturedDiag &D : record.Diags) {
+      Ctx.diagnose(DiagnosticInfoDxil(D.Func, D.DLoc, D.Msg, D.Severity));
+    }
+  }
+}
 
-  ValidateResources(ValCtx);
+// Module-level validation phases in dispatch order, with the profiles each
+// one runs under. Order matters: control-flow validation collects function
+// call info (recursion makes the collection bail), and the per-function
+// walk fills in the entry status that the uninitialized-output check reads.
+// The fast profile keeps the structural and resource phases and drops the
+// dominator-tree/reachability analysis, the per-instruction function walk,
+// and the uninitialized-output check that depends on that walk.
+struct ValidationPhase {
+  void (*Run)(ValidationContext &);
+  bool bInFastProfile;
+};
 
-  // Validate control flow and collect function call info.
-  // If has recursive call, call info collection will not finish.
-  ValidateFlowControl(ValCtx);
+static const ValidationPhase g_ModuleValidationPhases[] = {
+    {ValidateBitcode, true},
+    {ValidateMetadata, true},
+    {ValidateShaderState, true},
+    {ValidateGlobalVariables, true},
+    {ValidateResources, true},
+    {ValidateFlowControl, false},
+    {ValidateAllFunctions, false},
+    {ValidateShaderFlags, true},
+    {ValidateEntrySignatures, true},
+    {ValidateUninitializedOutput, false},
+};
 
-  // Validate functions.
-  for (Function &F : pModule->functions()) {
-    ValidateFunction(F, ValCtx);
+_Use_decl_annotations_ HRESULT
+ValidateDxilModule(llvm::Module *pModule, llvm::Module *pDebugModule,
+                   const DxilValidationOptions &Opts) {
+  DxilModule *pDxilModule = DxilModule::TryGetDxilModule(pModule);
+  if (!pDxilModule) {
+    return DXC_E_IR_VERIFICATION_FAILED;
+  }
+  if (pDxilModule->HasMetadataErrors()) {
+    dxilutil::EmitErrorOnContext(pModule->getContext(), "Metadata error encountered in non-critical metadata (such as Type Annotations).");
+    return DXC_E_IR_VERIFICATION_FAILED;
   }
 
-  ValidateShaderFlags(ValCtx);
+  ValidationContext ValCtx(*pModule, pDebugModule, *pDxilModule, Opts);
 
-  ValidateEntrySignatures(ValCtx);
+  const DxilValidationProfile Profile = Opts.Profile;
+  for (const ValidationPhase &Phase : g_ModuleValidationPhases) {
+    if (Profile == DxilValidationProfile::Fast && !Phase.bInFastProfile)
+      continue;
+    Phase.Run(ValCtx);
+  }
 
-  ValidateUninitializedOutput(ValCtx);
   // Ensure error messages are flushed out on error.
   if (ValCtx.Failed) {
     return DXC_E_IR_VERIFICATION_FAILED;
@@ -5754,7 +5899,8 @@ static void VerifyRDATMatches(_In_ ValidationContext &ValCtx,
   VerifyBlobPartMatches(ValCtx, PartName, pWriter.get(), pRDATData, RDATSize);
 
   // Verify no errors when runtime reflection from RDAT:
-  RDAT::DxilRuntimeReflection *pReflection = RDAT::CreateDxilRuntimeReflection();
+  unique_ptr<RDAT::DxilRuntimeReflection> pReflection(
+      RDAT::CreateDxilRuntimeReflection());
   if (!pReflection->InitFromRDAT(pRDATData, RDATSize)) {
     ValCtx.EmitFormatError(ValidationRule::ContainerPartMatches, { PartName });
     return;
@@ -5869,6 +6015,7 @@ HRESULT ValidateDxilContainerParts(llvm::Module *pModule,
     case DFCC_PrivateData:
     case DFCC_DXIL:
     case DFCC_ShaderDebugInfoDXIL:
+    case DFCC_CompressedShaderDebugInfoDXIL:
     case DFCC_ShaderDebugName:
       continue;
 
@@ -6010,7 +6157,8 @@ HRESULT ValidateLoadModule(const char *pIL,
 HRESULT ValidateDxilBitcode(
   _In_reads_bytes_(ILLength) const char *pIL,
   _In_ uint32_t ILLength,
-  _In_ llvm::raw_ostream &DiagStream) {
+  _In_ llvm::raw_ostream &DiagStream,
+  const DxilValidationOptions &Opts) {
 
   LLVMContext Ctx;
   std::unique_ptr<llvm::Module> pModule;
@@ -6025,7 +6173,7 @@ HRESULT ValidateDxilBitcode(
                                      /*bLazyLoad*/ false)))
     return hr;
 
-  if (FAILED(hr = ValidateDxilModule(pModule.get(), nullptr)))
+  if (FAILED(hr = ValidateDxilModule(pModule.get(), nullptr, Opts)))
     return hr;
 
   DxilModule &dxilModule = pModule->GetDxilModule();
@@ -6124,13 +6272,129 @@ _Use_decl_annotations_ HRESULT ValidateLoadModuleFromContainerLazy(
                                          /*bLazyLoad*/ true);
 }
 
+// Incremental re-validation support. Containers on hot patching paths (e.g.
+// root signature replacement through DxcContainerBuilder) carry a DXIL part
+// identical to one validated moments before, so module-level validation can
+// be skipped when the part bytes match a part that already passed.
+// Container-level checks always run since the other parts did change.
+//
+// The MD5 digest is only a lookup key: a hit must replay an exact byte
+// comparison against the remembered part, because MD5 collisions are
+// constructible and a cache hit stands in for module validation at the
+// signing boundary. The map therefore retains the full part bytes, bounded
+// below; a part too large to retain is simply validated every time.
+static std::mutex g_ValidatedDxilPartsMutex;
+static std::unordered_map<std::string, std::string> g_ValidatedDxilParts;
+static size_t g_ValidatedDxilPartsBytes = 0;
+static const size_t kValidatedDxilPartsMax = 1024;
+static const size_t kValidatedDxilPartsMaxBytes = 64 * 1024 * 1024;
+
+static bool GetDxilPartBytes(const void *pContainer, uint32_t ContainerSize,
+                             llvm::StringRef &partBytes) {
+  const DxilPartHeader *pPart = nullptr;
+  if (FAILED(FindDxilPart(pContainer, ContainerSize, DFCC_DXIL, &pPart)))
+    return false;
+  partBytes = llvm::StringRef(GetDxilPartData(pPart), pPart->PartSize);
+  return true;
+}
+
+static std::string GetDxilPartDigest(llvm::StringRef partBytes) {
+  llvm::MD5 md5;
+  llvm::MD5::MD5Result result;
+  md5.update(llvm::ArrayRef<uint8_t>(
+      reinterpret_cast<const uint8_t *>(partBytes.data()), partBytes.size()));
+  md5.final(result);
+  return std::string(reinterpret_cast<const char *>(result), sizeof(result));
+}
+
+static bool IsDxilPartAlreadyValidated(const std::string &digest,
+                                       llvm::StringRef partBytes) {
+  std::lock_guard<std::mutex> Guard(g_ValidatedDxilPartsMutex);
+  auto it = g_ValidatedDxilParts.find(digest);
+  if (it == g_ValidatedDxilParts.end())
+    return false;
+  return partBytes.size() == it->second.size() &&
+         memcmp(partBytes.data(), it->second.data(), partBytes.size()) == 0;
+}
+
+static void RememberValidatedDxilPart(const std::string &digest,
+                                      llvm::StringRef partBytes) {
+  if (partBytes.size() > kValidatedDxilPartsMaxBytes)
+    return;
+  std::lock_guard<std::mutex> Guard(g_ValidatedDxilPartsMutex);
+  if (g_ValidatedDxilParts.size() >= kValidatedDxilPartsMax ||
+      g_ValidatedDxilPartsBytes + partBytes.size() >
+          kValidatedDxilPartsMaxBytes) {
+    g_ValidatedDxilParts.clear();
+    g_ValidatedDxilPartsBytes = 0;
+  }
+  if (g_ValidatedDxilParts.emplace(digest, partBytes.str()).second)
+    g_ValidatedDxilPartsBytes += partBytes.size();
+}
+
+// Module-independent structural checks over the container part table. These
+// run before any bitcode is parsed, so structurally malformed containers are
+// rejected without paying IR deserialization cost. Checks that need the
+// module (part contents matching the program, profile-dependent part
+// legality) remain in ValidateDxilContainerParts.
+static HRESULT ValidateContainerStructure(const DxilContainerHeader *pContainer,
+                                          uint32_t ContainerSize) {
+  if (!pContainer || !IsValidDxilContainer(pContainer, ContainerSize)) {
+    return DXC_E_CONTAINER_INVALID;
+  }
+
+  std::unordered_set<uint32_t> FourCCFound;
+  for (auto it = begin(pContainer), itEnd = end(pContainer); it != itEnd;
+       ++it) {
+    const DxilPartHeader *pPart = *it;
+    if (!FourCCFound.insert(pPart->PartFourCC).second) {
+      // Two parts with same FourCC found.
+      return DXC_E_MALFORMED_CONTAINER;
+    }
+    switch (pPart->PartFourCC) {
+    case DFCC_DXIL:
+    case DFCC_ShaderDebugInfoDXIL:
+      if (!IsValidDxilProgramHeader(
+              reinterpret_cast<const DxilProgramHeader *>(
+                  GetDxilPartData(pPart)),
+              pPart->PartSize)) {
+        return DXC_E_CONTAINER_INVALID;
+      }
+      break;
+    case DFCC_ShaderHash:
+      if (pPart->PartSize != sizeof(DxilShaderHash)) {
+        return DXC_E_MALFORMED_CONTAINER;
+      }
+      break;
+    case DFCC_CompressedShaderDebugInfoDXIL:
+      if (pPart->PartSize < sizeof(DxilCompressedPartHeader)) {
+        return DXC_E_MALFORMED_CONTAINER;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  if (FourCCFound.find(DFCC_DXIL) == FourCCFound.end()) {
+    return DXC_E_CONTAINER_MISSING_DXIL;
+  }
+  return S_OK;
+}
+
 _Use_decl_annotations_
 HRESULT ValidateDxilContainer(const void *pContainer,
                               uint32_t ContainerSize,
-                              llvm::raw_ostream &DiagStream) {
+                              llvm::raw_ostream &DiagStream,
+                              const DxilValidationOptions &Opts) {
   LLVMContext Ctx, DbgCtx;
   std::unique_ptr<llvm::Module> pModule, pDebugModule;
 
+  // Fail fast on structural container problems before paying for the
+  // bitcode parse below.
+  IFR(ValidateContainerStructure(IsDxilContainerLike(pContainer, ContainerSize),
+                                 ContainerSize));
+
   llvm::DiagnosticPrinterRawOStream DiagPrinter(DiagStream);
   PrintDiagnosticContext DiagContext(DiagPrinter);
   Ctx.setDiagnosticHandler(PrintDiagnosticContext::PrintDiagnosticHandler,
@@ -6141,11 +6405,27 @@ HRESULT ValidateDxilContainer(const void *pContainer,
   IFR(ValidateLoadModuleFromContainer(pContainer, ContainerSize, pModule, pDebugModule,
       Ctx, DbgCtx, DiagStream));
 
-  // Validate DXIL Module
-  IFR(ValidateDxilModule(pModule.get(), pDebugModule.get()));
-
-  if (DiagContext.HasErrors() || DiagContext.HasWarnings()) {
-    return DXC_E_IR_VERIFICATION_FAILED;
+  // Validate DXIL Module, unless an identical DXIL part already passed
+  // module-level validation; the container-level checks below always run.
+  llvm::StringRef partBytes;
+  std::string partDigest;
+  bool hasPart = GetDxilPartBytes(pContainer, ContainerSize, partBytes);
+  if (hasPart)
+    partDigest = GetDxilPartDigest(partBytes);
+  if (!hasPart || !IsDxilPartAlreadyValidated(partDigest, partBytes)) {
+    IFR(ValidateDxilModule(pModule.get(), pDebugModule.get(), Opts));
+
+    if (DiagContext.HasErrors() || DiagContext.HasWarnings()) {
+      return DXC_E_IR_VERIFICATION_FAILED;
+    }
+
+    // Only a Full-profile pass may seed the cache: Fast drops whole
+    // validation phases, and a Fast-recorded digest consulted by a later
+    // Full validation would sign a container that never passed the Full
+    // checks. A Full entry satisfying a later Fast run is fine - Full is a
+    // superset.
+    if (hasPart && Opts.Profile == DxilValidationProfile::Full)
+      RememberValidatedDxilPart(partDigest, partBytes);
   }
 
   return ValidateDxilContainerParts(pModule.get(), pDebugModule.get(),
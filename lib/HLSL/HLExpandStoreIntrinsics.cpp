@@ -25,8 +25,18 @@ using namespace llvm;
 
 namespace {
 
+// Scalars eligible for grouping into a vector store. i1 is excluded so the
+// later bool memory-representation lowering still sees individual elements.
+static bool isVectorizableScalarTy(Type *Ty) {
+  if (Ty->isFloatingPointTy())
+    return true;
+  if (IntegerType *IntTy = dyn_cast<IntegerType>(Ty))
+    return IntTy->getBitWidth() >= 16;
+  return false;
+}
+
 // Expands buffer stores of aggregate value types
-// into stores of its individual elements, 
+// into stores of its individual elements,
 // before SROA happens and we lose the layout information.
 class HLExpandStoreIntrinsics : public FunctionPass {
 public:
@@ -44,6 +54,11 @@ private:
   void emitElementStores(CallInst &OriginalCall,
     SmallVectorImpl<Value*>& GEPIndicesStack, Type *StackTopTy,
     unsigned OffsetFromBase);
+  void emitScalarRunStore(CallInst &OriginalCall,
+    SmallVectorImpl<Value*>& GEPIndicesStack, Type *ScalarTy,
+    unsigned OffsetFromBase, unsigned FirstIndex, unsigned RunLength);
+  void emitStoreCall(CallInst &OriginalCall, IRBuilder<> &Builder,
+    unsigned OffsetFromBase, Value *Val);
 };
 
 char HLExpandStoreIntrinsics::ID = 0;
@@ -92,41 +107,106 @@ void HLExpandStoreIntrinsics::emitElementStores(CallInst &OriginalCall,
     for (unsigned i = 0; i < StructTy->getNumElements(); ++i) {
       Type *ElemTy = StructTy->getElementType(i);
       unsigned ElemOffsetFromBase = OffsetFromBase + Layout->getElementOffset(i);
+
+      // Coalesce a run of identical, contiguously laid out scalar fields
+      // into a single vector store. Padding between fields breaks the run.
+      if (isVectorizableScalarTy(ElemTy)) {
+        unsigned ElemSize = (unsigned)Module.getDataLayout().getTypeAllocSize(ElemTy);
+        unsigned RunLength = 1;
+        while (RunLength < 4 && i + RunLength < StructTy->getNumElements()
+          && StructTy->getElementType(i + RunLength) == ElemTy
+          && Layout->getElementOffset(i + RunLength) ==
+            Layout->getElementOffset(i) + ElemSize * RunLength) {
+          ++RunLength;
+        }
+        if (RunLength > 1) {
+          emitScalarRunStore(OriginalCall, GEPIndicesStack, ElemTy,
+            ElemOffsetFromBase, i, RunLength);
+          i += RunLength - 1;
+          continue;
+        }
+      }
+
       GEPIndicesStack.emplace_back(Builder.getInt32(i));
       emitElementStores(OriginalCall, GEPIndicesStack, ElemTy, ElemOffsetFromBase);
       GEPIndicesStack.pop_back();
     }
   }
   else if (ArrayType *ArrayTy = dyn_cast<ArrayType>(StackTopTy)) {
-    unsigned ElemSize = (unsigned)Module.getDataLayout().getTypeAllocSize(ArrayTy->getElementType());
+    Type *ElemTy = ArrayTy->getElementType();
+    unsigned ElemSize = (unsigned)Module.getDataLayout().getTypeAllocSize(ElemTy);
+
+    // Scalar array elements are contiguous by construction, so store them
+    // in vector-sized groups with a scalar tail.
+    if (isVectorizableScalarTy(ElemTy) && ArrayTy->getNumElements() > 1) {
+      unsigned NumElems = (unsigned)ArrayTy->getNumElements();
+      for (unsigned i = 0; i < NumElems;) {
+        unsigned RunLength = std::min(4u, NumElems - i);
+        unsigned ElemOffsetFromBase = OffsetFromBase + ElemSize * i;
+        if (RunLength > 1) {
+          emitScalarRunStore(OriginalCall, GEPIndicesStack, ElemTy,
+            ElemOffsetFromBase, i, RunLength);
+        }
+        else {
+          GEPIndicesStack.emplace_back(Builder.getInt32(i));
+          emitElementStores(OriginalCall, GEPIndicesStack, ElemTy, ElemOffsetFromBase);
+          GEPIndicesStack.pop_back();
+        }
+        i += RunLength;
+      }
+      return;
+    }
+
     for (int i = 0; i < (int)ArrayTy->getNumElements(); ++i) {
       unsigned ElemOffsetFromBase = OffsetFromBase + ElemSize * i;
       GEPIndicesStack.emplace_back(Builder.getInt32(i));
-      emitElementStores(OriginalCall, GEPIndicesStack, ArrayTy->getElementType(), ElemOffsetFromBase);
+      emitElementStores(OriginalCall, GEPIndicesStack, ElemTy, ElemOffsetFromBase);
       GEPIndicesStack.pop_back();
     }
   }
   else {
     // Scalar or vector
-    Value* OpcodeVal = OriginalCall.getArgOperand(HLOperandIndex::kOpcodeIdx);
-
-    Value* BufHandle = OriginalCall.getArgOperand(HLOperandIndex::kHandleOpIdx);
-
-    Value* OffsetVal = OriginalCall.getArgOperand(HLOperandIndex::kStoreOffsetOpIdx);
-    if (OffsetFromBase > 0)
-      OffsetVal = Builder.CreateAdd(OffsetVal, Builder.getInt32(OffsetFromBase));
-
     Value* AggPtr = OriginalCall.getArgOperand(HLOperandIndex::kStoreValOpIdx);
     Value *ElemPtr = Builder.CreateGEP(AggPtr, GEPIndicesStack);
     Value *ElemVal = Builder.CreateLoad(ElemPtr); // We go from memory to memory so no special bool handling needed
-    
-    FunctionType *NewCalleeType = FunctionType::get(Builder.getVoidTy(),
-      { OpcodeVal->getType(), BufHandle->getType(), OffsetVal->getType(), ElemVal->getType() },
-      /* isVarArg */ false);
-    Function *NewCallee = GetOrCreateHLFunction(Module, NewCalleeType,
-      HLOpcodeGroup::HLIntrinsic, (unsigned)IntrinsicOp::MOP_Store);
-    Builder.CreateCall(NewCallee, { OpcodeVal, BufHandle, OffsetVal, ElemVal });
+    emitStoreCall(OriginalCall, Builder, OffsetFromBase, ElemVal);
+  }
+}
+
+void HLExpandStoreIntrinsics::emitScalarRunStore(CallInst &OriginalCall,
+    SmallVectorImpl<Value*>& GEPIndicesStack, Type *ScalarTy,
+    unsigned OffsetFromBase, unsigned FirstIndex, unsigned RunLength) {
+  IRBuilder<> Builder(&OriginalCall);
+  Value* AggPtr = OriginalCall.getArgOperand(HLOperandIndex::kStoreValOpIdx);
+  Value *RunVal = UndefValue::get(VectorType::get(ScalarTy, RunLength));
+  for (unsigned i = 0; i < RunLength; ++i) {
+    GEPIndicesStack.emplace_back(Builder.getInt32(FirstIndex + i));
+    Value *ElemPtr = Builder.CreateGEP(AggPtr, GEPIndicesStack);
+    GEPIndicesStack.pop_back();
+    Value *ElemVal = Builder.CreateLoad(ElemPtr);
+    RunVal = Builder.CreateInsertElement(RunVal, ElemVal, i);
   }
+  emitStoreCall(OriginalCall, Builder, OffsetFromBase, RunVal);
+}
+
+void HLExpandStoreIntrinsics::emitStoreCall(CallInst &OriginalCall,
+    IRBuilder<> &Builder, unsigned OffsetFromBase, Value *Val) {
+  llvm::Module &Module = *OriginalCall.getModule();
+
+  Value* OpcodeVal = OriginalCall.getArgOperand(HLOperandIndex::kOpcodeIdx);
+
+  Value* BufHandle = OriginalCall.getArgOperand(HLOperandIndex::kHandleOpIdx);
+
+  Value* OffsetVal = OriginalCall.getArgOperand(HLOperandIndex::kStoreOffsetOpIdx);
+  if (OffsetFromBase > 0)
+    OffsetVal = Builder.CreateAdd(OffsetVal, Builder.getInt32(OffsetFromBase));
+
+  FunctionType *NewCalleeType = FunctionType::get(Builder.getVoidTy(),
+    { OpcodeVal->getType(), BufHandle->getType(), OffsetVal->getType(), Val->getType() },
+    /* isVarArg */ false);
+  Function *NewCallee = GetOrCreateHLFunction(Module, NewCalleeType,
+    HLOpcodeGroup::HLIntrinsic, (unsigned)IntrinsicOp::MOP_Store);
+  Builder.CreateCall(NewCallee, { OpcodeVal, BufHandle, OffsetVal, Val });
 }
 
 } // namespace
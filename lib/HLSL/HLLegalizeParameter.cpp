@@ -21,6 +21,7 @@
 #include "dxc/Support/Global.h"
 #include "llvm/Pass.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/Constant.h"
 #include "llvm/IR/Constants.h"
@@ -136,10 +137,58 @@ struct CopyData {
   bool bCopyOut;
 };
 
+// Summary of which pointer parameters a callee actually reads and writes.
+// The qualifiers alone force copy-in and copy-out conservatively; the
+// summary lets call sites drop the memcpy for a direction the callee never
+// exercises. Computed lazily per callee with hlutil::PointerStatus, which
+// already folds in the qualifiers of calls the parameter is forwarded to.
+class ParamAccessSummary {
+public:
+  struct ParamAccess {
+    bool bRead;
+    bool bWritten;
+  };
+
+  explicit ParamAccessSummary(DxilTypeSystem &typeSys) : m_typeSys(typeSys) {}
+
+  ParamAccess getAccess(Function &F, unsigned ArgIdx) {
+    // No body to analyze, assume both directions.
+    if (F.isDeclaration())
+      return ParamAccess{true, true};
+
+    auto it = m_summaries.find(&F);
+    if (it == m_summaries.end()) {
+      it = m_summaries.insert(std::make_pair(&F, analyze(F))).first;
+    }
+    return it->second[ArgIdx];
+  }
+
+private:
+  SmallVector<ParamAccess, 8> analyze(Function &F) {
+    SmallVector<ParamAccess, 8> summary(F.arg_size());
+    for (Argument &Arg : F.args()) {
+      ParamAccess &access = summary[Arg.getArgNo()];
+      if (!Arg.getType()->isPointerTy()) {
+        access.bRead = access.bWritten = true;
+        continue;
+      }
+      hlutil::PointerStatus PS(&Arg, 0, /*bLdStOnly*/ true);
+      PS.analyze(m_typeSys, /*bStructElt*/ false);
+      access.bRead = PS.HasLoaded();
+      access.bWritten = PS.HasStored();
+    }
+    return summary;
+  }
+
+  DxilTypeSystem &m_typeSys;
+  DenseMap<Function *, SmallVector<ParamAccess, 8>> m_summaries;
+};
+
 void ParameterCopyInCopyOut(hlsl::HLModule &HLM) {
   Module &M = *HLM.GetModule();
   Type *HandleTy = HLM.GetOP()->GetHandleType();
   const DataLayout &DL = M.getDataLayout();
+  ParamAccessSummary Summary(HLM.GetTypeSystem());
 
   std::vector<GlobalVariable *> staticGVs;
   for (GlobalVariable &GV : M.globals()) {
@@ -200,6 +249,13 @@ void ParameterCopyInCopyOut(hlsl::HLModule &HLM) {
         if (!bNeedCopy)
           continue;
 
+        // Refine with the callee access summary: no reads means no copy-in,
+        // no writes means no copy-out. The temp still replaces the pointer
+        // so the callee never sees a pointer that needs lowering.
+        ParamAccessSummary::ParamAccess access = Summary.getAccess(F, i);
+        bCopyIn &= access.bRead;
+        bCopyOut &= access.bWritten;
+
         CopyData data = {CI, arg, bCopyIn, bCopyOut};
         WorkList.emplace_back(data);
       }
@@ -1512,6 +1512,24 @@ Value *HLMatrixLowerPass::lowerHLInit(CallInst *Call) {
   DXASSERT(LoweredTy->getNumElements() == Call->getNumArgOperands() - HLOperandIndex::kInitFirstArgOpIdx,
     "Invalid matrix init argument count.");
 
+  // Fold fully-constant initializers into a single constant vector up front,
+  // rather than emitting an insertelement chain that the constant folder
+  // collapses one element at a time. Large constant matrices (skinning
+  // palettes, LUT setup) make the chain costly for later passes.
+  {
+    SmallVector<Constant *, 16> ConstElems;
+    ConstElems.reserve(LoweredTy->getNumElements());
+    for (unsigned VecElemIdx = 0; VecElemIdx < LoweredTy->getNumElements(); ++VecElemIdx) {
+      Constant *ArgVal = dyn_cast<Constant>(
+          Call->getArgOperand(HLOperandIndex::kInitFirstArgOpIdx + VecElemIdx));
+      if (ArgVal == nullptr)
+        break;
+      ConstElems.emplace_back(ArgVal);
+    }
+    if (ConstElems.size() == LoweredTy->getNumElements())
+      return ConstantVector::get(ConstElems);
+  }
+
   // Build the result vector from the init args.
   // Both the args and the result vector are in row-major order, so no shuffling is necessary.
   IRBuilder<> Builder(Call);
@@ -1550,19 +1568,10 @@ Value *HLMatrixLowerPass::lowerHLSelect(CallInst *Call) {
   Value *LoweredCond = getLoweredByValOperand(Cond, Builder);
   Value *LoweredTrueVec = getLoweredByValOperand(TrueMat, Builder);
   Value *LoweredFalseVec = getLoweredByValOperand(FalseMat, Builder);
-  Value *Result = UndefValue::get(LoweredTrueVec->getType());
-
-  bool IsScalarCond = !LoweredCond->getType()->isVectorTy();
-
-  unsigned NumElems = Result->getType()->getVectorNumElements();
-  for (uint64_t ElemIdx = 0; ElemIdx < NumElems; ++ElemIdx) {
-    Value *ElemCond = IsScalarCond ? LoweredCond
-      : Builder.CreateExtractElement(LoweredCond, ElemIdx);
-    Value *ElemTrueVal = Builder.CreateExtractElement(LoweredTrueVec, ElemIdx);
-    Value *ElemFalseVal = Builder.CreateExtractElement(LoweredFalseVec, ElemIdx);
-    Value *ResultElem = Builder.CreateSelect(ElemCond, ElemTrueVal, ElemFalseVal);
-    Result = Builder.CreateInsertElement(Result, ResultElem, ElemIdx);
-  }
 
-  return Result;
+  // A select instruction takes either a scalar i1 condition, which selects
+  // between the vectors wholesale, or a vector of i1s matching the value
+  // vectors, which selects per-element. Both match our semantics exactly,
+  // so there is no need to scalarize into per-element select chains.
+  return Builder.CreateSelect(LoweredCond, LoweredTrueVec, LoweredFalseVec);
 }
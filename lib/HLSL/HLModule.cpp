@@ -56,7 +56,8 @@ void HLModule_ResetModule(llvm::Module* M) {
 //  HLModule methods.
 //
 HLModule::HLModule(Module *pModule)
-    : m_Ctx(pModule->getContext())
+    : m_bResourceIndexesValid(false)
+    , m_Ctx(pModule->getContext())
     , m_pModule(pModule)
     , m_pEntryFunc(nullptr)
     , m_EntryName("")
@@ -176,11 +177,12 @@ void HLModule::SetEntryFunction(Function *pEntryFunc) {
 const string &HLModule::GetEntryFunctionName() const { return m_EntryName; }
 void HLModule::SetEntryFunctionName(const string &name) { m_EntryName = name; }
 
-template<typename T> unsigned 
+template<typename T> unsigned
 HLModule::AddResource(vector<unique_ptr<T> > &Vec, unique_ptr<T> pRes) {
   DXASSERT_NOMSG((unsigned)Vec.size() < UINT_MAX);
   unsigned Id = (unsigned)Vec.size();
   Vec.emplace_back(std::move(pRes));
+  InvalidateResourceIndexes();
   return Id;
 }
 
@@ -248,6 +250,40 @@ const vector<unique_ptr<HLResource> > &HLModule::GetUAVs() const {
   return m_UAVs;
 }
 
+template <typename TResource>
+static void IndexResourceSymbols(
+    const std::vector<std::unique_ptr<TResource>> &Vec,
+    std::unordered_map<const Constant *, DxilResourceBase *> &SymbolIndex) {
+  for (auto &Res : Vec) {
+    // Resources stripped of their symbol share one undef value per type;
+    // leave those out so a symbol maps to at most one resource.
+    Constant *pSymbol = Res->GetGlobalSymbol();
+    if (pSymbol != nullptr && !isa<UndefValue>(pSymbol))
+      SymbolIndex[pSymbol] = Res.get();
+  }
+}
+
+void HLModule::BuildResourceIndexes() const {
+  IndexResourceSymbols(m_SRVs, m_ResourceSymbolIndex);
+  IndexResourceSymbols(m_UAVs, m_ResourceSymbolIndex);
+  IndexResourceSymbols(m_CBuffers, m_ResourceSymbolIndex);
+  IndexResourceSymbols(m_Samplers, m_ResourceSymbolIndex);
+  m_bResourceIndexesValid = true;
+}
+
+DxilResourceBase *
+HLModule::LookupResourceBySymbol(const llvm::Constant *pSymbol) const {
+  if (!m_bResourceIndexesValid)
+    BuildResourceIndexes();
+  auto it = m_ResourceSymbolIndex.find(pSymbol);
+  return it != m_ResourceSymbolIndex.end() ? it->second : nullptr;
+}
+
+void HLModule::InvalidateResourceIndexes() const {
+  m_bResourceIndexesValid = false;
+  m_ResourceSymbolIndex.clear();
+}
+
 void HLModule::RemoveFunction(llvm::Function *F) {
   DXASSERT_NOMSG(F != nullptr);
   m_DxilFunctionPropsMap.erase(F);
@@ -290,17 +326,33 @@ void HLModule::RemoveGlobal(llvm::GlobalVariable *GV) {
   // register range from being allocated to other resources.
   bool keepAllocated = GetHLOptions().bLegacyResourceReservation;
 
-  // This could be considerably faster - check variable type to see which
-  // resource type this is rather than scanning all lists, and look for
-  // usage and removal patterns.
-  if (RemoveResource(m_CBuffers, GV, keepAllocated))
-    return;
-  if (RemoveResource(m_SRVs, GV, keepAllocated))
-    return;
-  if (RemoveResource(m_UAVs, GV, keepAllocated))
-    return;
-  if (RemoveResource(m_Samplers, GV, keepAllocated))
+  // The symbol index narrows the removal to the one list that holds the
+  // resource instead of scanning all four.
+  DxilResourceBase *pRes = LookupResourceBySymbol(GV);
+  if (pRes == nullptr)
     return;
+  bool bRemoved = false;
+  switch (pRes->GetClass()) {
+  case DXIL::ResourceClass::CBuffer:
+    bRemoved = RemoveResource(m_CBuffers, GV, keepAllocated);
+    break;
+  case DXIL::ResourceClass::SRV:
+    bRemoved = RemoveResource(m_SRVs, GV, keepAllocated);
+    break;
+  case DXIL::ResourceClass::UAV:
+    bRemoved = RemoveResource(m_UAVs, GV, keepAllocated);
+    break;
+  case DXIL::ResourceClass::Sampler:
+    bRemoved = RemoveResource(m_Samplers, GV, keepAllocated);
+    break;
+  default:
+    break;
+  }
+  // The lookup above (re)built the index, so it can be maintained in place:
+  // whether the resource was erased or kept with an undef symbol, GV no
+  // longer names a resource.
+  if (bRemoved)
+    m_ResourceSymbolIndex.erase(GV);
   // TODO: do m_TGSMVariables and m_StreamOutputs need maintenance?
 }
 
@@ -1033,41 +1085,44 @@ static Value *MergeGEP(GEPOperator *SrcGEP, GetElementPtrInst *GEP) {
 }
 
 void HLModule::MergeGepUse(Value *V) {
-  for (auto U = V->user_begin(); U != V->user_end();) {
-    auto Use = U++;
-
-    if (GetElementPtrInst *GEP = dyn_cast<GetElementPtrInst>(*Use)) {
-      if (GEPOperator *prevGEP = dyn_cast<GEPOperator>(V)) {
-        // merge the 2 GEPs
-        Value *newGEP = MergeGEP(prevGEP, GEP);
-        // Don't need to replace when GEP is updated in place
-        if (newGEP != GEP) {
-          GEP->replaceAllUsesWith(newGEP);
-          GEP->eraseFromParent();
+  // Each value is visited once: either its gep users are merged into it when
+  // it is itself a gep, or they are queued to be roots of their own merges.
+  // The explicit worklist keeps deep gep chains from rescanning user lists
+  // once per nesting level like the old recursive version did.
+  SmallVector<Value *, 16> worklist;
+  worklist.emplace_back(V);
+  while (!worklist.empty()) {
+    V = worklist.pop_back_val();
+    for (auto U = V->user_begin(); U != V->user_end();) {
+      auto Use = U++;
+
+      if (GetElementPtrInst *GEP = dyn_cast<GetElementPtrInst>(*Use)) {
+        if (GEPOperator *prevGEP = dyn_cast<GEPOperator>(V)) {
+          // merge the 2 GEPs
+          if (Value *newGEP = MergeGEP(prevGEP, GEP)) {
+            // Don't need to replace when GEP is updated in place
+            if (newGEP != GEP) {
+              GEP->replaceAllUsesWith(newGEP);
+              GEP->eraseFromParent();
+            }
+            worklist.emplace_back(newGEP);
+          }
+        } else {
+          worklist.emplace_back(GEP);
         }
-        MergeGepUse(newGEP);
-      } else {
-        MergeGepUse(*Use);
-      }
-    } else if (dyn_cast<GEPOperator>(*Use)) {
-      if (GEPOperator *prevGEP = dyn_cast<GEPOperator>(V)) {
-        // merge the 2 GEPs
-        Value *newGEP = MergeGEP(prevGEP, GEP);
-        // Don't need to replace when GEP is updated in place
-        if (newGEP != GEP) {
-          GEP->replaceAllUsesWith(newGEP);
-          GEP->eraseFromParent();
+      } else if (isa<GEPOperator>(*Use)) {
+        if (!isa<GEPOperator>(V)) {
+          worklist.emplace_back(*Use);
         }
-        MergeGepUse(newGEP);
-      } else {
-        MergeGepUse(*Use);
+        // A constant gep rooted on another gep cannot use an instruction, so
+        // when V is itself a gep there is nothing to merge here.
       }
     }
-  }
-  if (V->user_empty()) {
-    // Only remove GEP here, root ptr will be removed by DCE.
-    if (GetElementPtrInst *I = dyn_cast<GetElementPtrInst>(V))
-      I->eraseFromParent();
+    if (V->user_empty()) {
+      // Only remove GEP here, root ptr will be removed by DCE.
+      if (GetElementPtrInst *I = dyn_cast<GetElementPtrInst>(V))
+        I->eraseFromParent();
+    }
   }
 }
 
@@ -1361,7 +1416,7 @@ HLExtraPropertyHelper::HLExtraPropertyHelper(llvm::Module *pModule)
 }
 
 void HLExtraPropertyHelper::EmitSignatureElementProperties(const DxilSignatureElement &SE, 
-                                                              vector<Metadata *> &MDVals) {
+                                                              SmallVectorImpl<Metadata *> &MDVals) {
 }
 
 void HLExtraPropertyHelper::LoadSignatureElementProperties(const MDOperand &MDO, 
@@ -185,8 +185,11 @@ public:
 
 private:
   ResAttribute &FindCreateHandleResourceBase(Value *Handle) {
-    if (HandleMetaMap.count(Handle))
-      return HandleMetaMap[Handle];
+    // Hot during lowering: every resource intrinsic queries its handle's
+    // kind/class/type, so resolve cache hits with a single lookup.
+    auto it = HandleMetaMap.find(Handle);
+    if (it != HandleMetaMap.end())
+      return it->second;
 
     // Add invalid first to avoid dead loop.
     HandleMetaMap[Handle] = {DXIL::ResourceClass::Invalid,
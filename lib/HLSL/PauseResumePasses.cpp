@@ -11,7 +11,9 @@
 
 #include "dxc/HLSL/DxilGenerationPass.h"
 
+#include "llvm/ADT/Twine.h"
 #include "llvm/Pass.h"
+#include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Metadata.h"
 #include "llvm/IR/Module.h"
 
@@ -38,8 +40,19 @@ void GetPauseResumePasses(Module &M, StringRef &pause, StringRef &resume) {
   NamedMDNode *N = M.getNamedMetadata(kPauseResumeMDName);
   if (N && N->getNumOperands() > 0) {
     MDNode *MD = N->getOperand(0);
-    pause = dyn_cast<MDString>(MD->getOperand(kPauseResumePassNameToPause).get())->getString();
-    resume = dyn_cast<MDString>(MD->getOperand(kPauseResumePassNameToResume).get())->getString();
+    // Checkpointed modules may come from a different producer; treat
+    // malformed metadata as no pause/resume information rather than
+    // crashing on it.
+    if (MD->getNumOperands() != kPauseResumeNumFields)
+      return;
+    auto *PauseMD =
+        dyn_cast_or_null<MDString>(MD->getOperand(kPauseResumePassNameToPause).get());
+    auto *ResumeMD =
+        dyn_cast_or_null<MDString>(MD->getOperand(kPauseResumePassNameToResume).get());
+    if (PauseMD == nullptr || ResumeMD == nullptr)
+      return;
+    pause = PauseMD->getString();
+    resume = ResumeMD->getString();
   }
 }
 
@@ -59,6 +72,23 @@ void SetPauseResumePasses(Module &M, StringRef pause, StringRef resume) {
 
 namespace {
 
+// RunRecordedPass looks up and runs the pass the checkpoint metadata
+// recorded. The module may have been serialized on one machine and resumed
+// on another, so an unregistered pass name means a producer/consumer
+// mismatch and is reported as a module error instead of dereferencing a
+// null PassInfo.
+bool RunRecordedPass(Module &M, StringRef PassName, raw_ostream *OSOverride) {
+  const PassInfo *PI = PassRegistry::getPassRegistry()->getPassInfo(PassName);
+  if (PI == nullptr) {
+    M.getContext().emitError(Twine("pause/resume metadata names unknown pass '") +
+                             PassName + "'");
+    return false;
+  }
+  std::unique_ptr<ModulePass> pass((ModulePass *)PI->createPass());
+  pass->setOSOverride(OSOverride);
+  return pass->runOnModule(M);
+}
+
 class NoPausePasses : public ModulePass {
 public:
   static char ID; // Pass identification, replacement for typeid
@@ -82,10 +112,7 @@ public:
     StringRef pause, resume;
     hlsl::GetPauseResumePasses(M, pause, resume);
     if (!pause.empty()) {
-      const PassInfo *PI = PassRegistry::getPassRegistry()->getPassInfo(pause);
-      std::unique_ptr<ModulePass> pass((ModulePass *)PI->createPass());
-      pass->setOSOverride(OSOverride);
-      return pass->runOnModule(M);
+      return RunRecordedPass(M, pause, OSOverride);
     }
     return false;
   }
@@ -102,10 +129,7 @@ public:
     StringRef pause, resume;
     hlsl::GetPauseResumePasses(M, pause, resume);
     if (!resume.empty()) {
-      const PassInfo *PI = PassRegistry::getPassRegistry()->getPassInfo(resume);
-      std::unique_ptr<ModulePass> pass((ModulePass *)PI->createPass());
-      pass->setOSOverride(OSOverride);
-      return pass->runOnModule(M);
+      return RunRecordedPass(M, resume, OSOverride);
     }
     return false;
   }
@@ -44,6 +44,12 @@
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cctype>
+// HLSL Change begin - parallel disassembly.
+#include "llvm/Support/ThreadPool.h"
+#include <string>
+#include <thread>
+#include <vector>
+// HLSL Change end
 using namespace llvm;
 
 // Make virtual table appear in this compilation unit.
@@ -612,6 +618,19 @@ public:
 
   const Function *getFunction() const { return TheFunction; }
 
+  // HLSL Change begin - parallel disassembly.
+  /// Copy another tracker's module-level numbering (global values, metadata
+  /// and attribute groups) into this tracker so functions can be
+  /// incorporated independently on several threads. \c Other must be fully
+  /// initialized with no function incorporated.
+  void copyModuleSlots(const SlotTracker &Other);
+
+  /// Assign attribute-group slots for call-site attributes of every function
+  /// in \c M, visiting them in the same order lazy per-function
+  /// incorporation would, so the resulting numbering matches serial printing.
+  void processAllCallSiteAttributes(const Module *M);
+  // HLSL Change end
+
   /// After calling incorporateFunction, use this method to remove the
   /// most recently incorporated function from the SlotTracker. This
   /// will reset the state of the machine back to just the module contents.
@@ -865,6 +884,40 @@ void SlotTracker::processInstructionMetadata(const Instruction &I) {
     CreateMetadataSlot(MD.second);
 }
 
+// HLSL Change begin - parallel disassembly.
+void SlotTracker::copyModuleSlots(const SlotTracker &Other) {
+  assert(!TheFunction && !Other.TheFunction &&
+         "cannot copy module slots while a function is incorporated");
+  assert(!Other.TheModule && "source tracker must be initialized");
+  TheModule = nullptr; // Module-level slots arrive by copy; skip processModule.
+  mMap = Other.mMap;
+  mNext = Other.mNext;
+  mdnMap = Other.mdnMap;
+  mdnNext = Other.mdnNext;
+  asMap = Other.asMap;
+  asNext = Other.asNext;
+}
+
+void SlotTracker::processAllCallSiteAttributes(const Module *M) {
+  for (const Function &F : *M) {
+    for (const BasicBlock &BB : F) {
+      for (const Instruction &I : BB) {
+        // Mirror the CallInst/InvokeInst handling in processFunction().
+        if (const CallInst *CI = dyn_cast<CallInst>(&I)) {
+          AttributeSet Attrs = CI->getAttributes().getFnAttributes();
+          if (Attrs.hasAttributes(AttributeSet::FunctionIndex))
+            CreateAttributeSetSlot(Attrs);
+        } else if (const InvokeInst *II = dyn_cast<InvokeInst>(&I)) {
+          AttributeSet Attrs = II->getAttributes().getFnAttributes();
+          if (Attrs.hasAttributes(AttributeSet::FunctionIndex))
+            CreateAttributeSetSlot(Attrs);
+        }
+      }
+    }
+  }
+}
+// HLSL Change end
+
 /// Clean up after incorporating a function. This is the only way to get out of
 /// the function incorporation state that affects get*Slot/Create*Slot. Function
 /// incorporation state is indicated by TheFunction != 0.
@@ -2018,6 +2071,14 @@ public:
 
   void printModule(const Module *M);
 
+  // HLSL Change begin - parallel disassembly.
+  // printModule is split so Module::printParallel can emit the pieces
+  // surrounding the function bodies on the main thread while the bodies
+  // themselves are formatted by workers.
+  void printModuleHeader(const Module *M);
+  void printModuleTrailer(const Module *M);
+  // HLSL Change end
+
   void writeOperand(const Value *Op, bool PrintType);
   void writeParamOperand(const Value *Operand, AttributeSet Attrs,unsigned Idx);
   void writeAtomic(AtomicOrdering Ordering, SynchronizationScope SynchScope);
@@ -2178,6 +2239,18 @@ void AssemblyWriter::printModule(const Module *M) {
   if (ShouldPreserveUseListOrder)
     UseListOrders = predictUseListOrder(M);
 
+  // HLSL Change: body split into header / functions / trailer.
+  printModuleHeader(M);
+
+  // Output all of the functions.
+  for (const Function &F : *M)
+    printFunction(&F);
+  assert(UseListOrders.empty() && "All use-lists should have been consumed");
+
+  printModuleTrailer(M);
+}
+
+void AssemblyWriter::printModuleHeader(const Module *M) { // HLSL Change
   if (!M->getModuleIdentifier().empty() &&
       // Don't print the ID if it will start a new line (which would
       // require a comment char before it).
@@ -2231,12 +2304,9 @@ void AssemblyWriter::printModule(const Module *M) {
 
   // Output global use-lists.
   printUseLists(nullptr);
+}
 
-  // Output all of the functions.
-  for (const Function &F : *M)
-    printFunction(&F);
-  assert(UseListOrders.empty() && "All use-lists should have been consumed");
-
+void AssemblyWriter::printModuleTrailer(const Module *M) { // HLSL Change
   // Output all attribute groups.
   if (!Machine.as_empty()) {
     Out << '\n';
@@ -3155,6 +3225,97 @@ void Module::print(raw_ostream &ROS, AssemblyAnnotationWriter *AAW,
   W.printModule(this);
 }
 
+// HLSL Change begin - parallel disassembly.
+void Module::printParallel(raw_ostream &ROS, AssemblyAnnotationWriter *AAW,
+                           unsigned NumThreads) const {
+  if (NumThreads == 0)
+    NumThreads = std::max(1u, std::thread::hardware_concurrency());
+
+  // Weigh each function by instruction count so chunks format in roughly
+  // equal time; a declaration still costs one line.
+  std::vector<const Function *> Funcs;
+  std::vector<size_t> Weights;
+  size_t TotalWeight = 0;
+  for (const Function &F : *this) {
+    size_t W = 1;
+    for (const BasicBlock &BB : F)
+      W += BB.size();
+    Funcs.push_back(&F);
+    Weights.push_back(W);
+    TotalWeight += W;
+  }
+
+  // Threading only pays for itself on large modules.
+  const size_t MinInstructionsForParallel = 4096;
+  NumThreads = static_cast<unsigned>(std::min<size_t>(NumThreads, Funcs.size()));
+  if (NumThreads < 2 || TotalWeight < MinInstructionsForParallel) {
+    print(ROS, AAW);
+    return;
+  }
+
+  // Number every slot up front - including metadata from function bodies and
+  // call-site attribute groups, which the serial printer discovers lazily in
+  // function order - so worker-local copies of the tracker agree on all
+  // module-level numbering and the output matches print() byte for byte.
+  SlotTracker SlotTable(this, /*ShouldInitializeAllMetadata*/ true);
+  SlotTable.initialize();
+  SlotTable.processAllCallSiteAttributes(this);
+
+  // Chunks run on the process-wide pool so disassembly respects the
+  // host-configured worker cap; the waiting thread drains chunks too,
+  // hence the +1. The pool is only touched past the serial early-out
+  // above, so small modules never spin up workers.
+  hlsl::ThreadPool &Pool = hlsl::ThreadPool::Get();
+  NumThreads = static_cast<unsigned>(
+      std::min<size_t>(NumThreads, Pool.GetWorkerCount() + 1));
+
+  // Partition the functions into one contiguous chunk per worker.
+  struct Chunk {
+    size_t Begin;
+    size_t End;
+    std::string Text;
+  };
+  std::vector<Chunk> Chunks;
+  const size_t TargetWeight = (TotalWeight + NumThreads - 1) / NumThreads;
+  size_t Begin = 0, Accum = 0;
+  for (size_t i = 0, e = Funcs.size(); i != e; ++i) {
+    Accum += Weights[i];
+    if (Accum >= TargetWeight || i + 1 == e) {
+      Chunks.push_back({Begin, i + 1, std::string()});
+      Begin = i + 1;
+      Accum = 0;
+    }
+  }
+
+  {
+    hlsl::ThreadPoolTaskGroup Group;
+    for (Chunk &C : Chunks) {
+      Pool.Async(
+          [this, AAW, &SlotTable, &Funcs, &C] {
+            SlotTracker Local(this);
+            Local.copyModuleSlots(SlotTable);
+            raw_string_ostream SOS(C.Text);
+            formatted_raw_ostream FOS(SOS);
+            AssemblyWriter CW(FOS, Local, this, AAW);
+            for (size_t f = C.Begin; f != C.End; ++f)
+              CW.printFunction(Funcs[f]);
+            FOS.flush();
+            SOS.flush();
+          },
+          hlsl::ThreadPoolPriority::High, &Group);
+    }
+    Group.Wait();
+  }
+
+  formatted_raw_ostream OS(ROS);
+  AssemblyWriter W(OS, SlotTable, this, AAW);
+  W.printModuleHeader(this);
+  for (Chunk &C : Chunks)
+    OS << C.Text;
+  W.printModuleTrailer(this);
+}
+// HLSL Change end
+
 void NamedMDNode::print(raw_ostream &ROS) const {
   SlotTracker SlotTable(getParent());
   formatted_raw_ostream OS(ROS);
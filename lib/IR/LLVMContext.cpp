@@ -273,6 +273,20 @@ unsigned LLVMContext::getMDKindID(StringRef Name) const {
       .first->second;
 }
 
+// HLSL Change - Begin
+void LLVMContext::anonymizeStructTypeNames() {
+  // setName("") removes the entry from NamedStructTypes, so gather the types
+  // first instead of mutating the map mid-iteration.
+  SmallVector<StructType *, 64> NamedTypes;
+  NamedTypes.reserve(pImpl->NamedStructTypes.size());
+  for (auto &Entry : pImpl->NamedStructTypes)
+    NamedTypes.push_back(Entry.second);
+  for (StructType *ST : NamedTypes)
+    ST->setName("");
+  pImpl->NamedStructTypesUniqueID = 0;
+}
+// HLSL Change - End
+
 /// getHandlerNames - Populate client supplied smallvector using custome
 /// metadata name and ID.
 void LLVMContext::getMDKindNames(SmallVectorImpl<StringRef> &Names) const {
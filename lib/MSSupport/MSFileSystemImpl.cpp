@@ -99,7 +99,16 @@ public:
 MSFileSystemForDisk::MSFileSystemForDisk()
 {
   #ifdef _WIN32
-  _defaultAttributes = GetConsoleOutputTextAttributes();
+  // The baseline console attributes are a process-lifetime constant; probe
+  // the console once rather than per instance, since hosts doing batch
+  // compiles construct one of these per compile.
+  static const unsigned s_startupAttributes = []() {
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (::GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi))
+      return (unsigned)csbi.wAttributes;
+    return 0u;
+  }();
+  _defaultAttributes = s_startupAttributes;
   #endif
 }
 
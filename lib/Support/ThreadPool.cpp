@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// ThreadPool.cpp                                                            //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source    //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Implements the process-wide work-stealing thread pool.                    //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/Support/WinIncludes.h"
+#include "llvm/Support/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace hlsl;
+
+namespace {
+
+// Cap requested before the pool exists; zero selects the hardware thread
+// count.
+std::atomic<unsigned> g_WorkerCountCap(0);
+std::atomic<bool> g_PoolStarted(false);
+
+// Index of the owning worker on pool threads, -1 elsewhere. Submissions
+// from a worker land on its own queue, so nested tasks stay cache-warm and
+// are popped LIFO by their producer before anyone steals them.
+thread_local int tls_WorkerIndex = -1;
+
+#ifdef _WIN32
+// Spread workers round-robin over the NUMA nodes of the machine so the pool
+// does not pile every thread onto node zero. Best effort: on single-node or
+// older systems the worker keeps the default affinity.
+void BindWorkerToNumaNode(unsigned workerIndex) {
+  ULONG highestNode = 0;
+  if (!GetNumaHighestNodeNumber(&highestNode) || highestNode == 0)
+    return;
+  GROUP_AFFINITY affinity;
+  USHORT node = (USHORT)(workerIndex % (highestNode + 1));
+  if (GetNumaNodeProcessorMaskEx(node, &affinity) && affinity.Mask != 0)
+    SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr);
+}
+#else
+void BindWorkerToNumaNode(unsigned) {}
+#endif
+
+} // namespace
+
+ThreadPool &ThreadPool::Get() {
+  // Created on first use and deliberately never destroyed: dxcompiler.dll
+  // may be unloaded from DllMain, where joining threads deadlocks on the
+  // loader lock. Workers sleep whenever the queues are empty and every
+  // client waits for its own tasks, so nothing is in flight at unload.
+  static ThreadPool *g_pPool = [] {
+    unsigned cap = g_WorkerCountCap.load();
+    unsigned count =
+        cap != 0 ? cap : std::max(1u, std::thread::hardware_concurrency());
+    g_PoolStarted = true;
+    return new ThreadPool(count);
+  }();
+  return *g_pPool;
+}
+
+bool ThreadPool::SetWorkerCountCap(unsigned maxWorkers) {
+  if (g_PoolStarted)
+    return false;
+  g_WorkerCountCap = maxWorkers;
+  // Re-check: Get() may have started the pool while the cap was written.
+  return !g_PoolStarted;
+}
+
+ThreadPool::ThreadPool(unsigned workerCount)
+    : m_workerCount(workerCount), m_nextQueue(0), m_pendingTasks(0) {
+  m_queues.reserve(workerCount);
+  for (unsigned i = 0; i < workerCount; ++i)
+    m_queues.emplace_back(new WorkerQueue());
+  // Detached: the pool lives for the remainder of the process (see Get).
+  for (unsigned i = 0; i < workerCount; ++i)
+    std::thread([this, i] { WorkerLoop(i); }).detach();
+}
+
+void ThreadPool::Async(std::function<void()> fn, ThreadPoolPriority priority,
+                       ThreadPoolTaskGroup *pGroup) {
+  if (pGroup) {
+    std::lock_guard<std::mutex> L(pGroup->m_mutex);
+    ++pGroup->m_outstanding;
+  }
+  unsigned queueIndex = tls_WorkerIndex >= 0 ? (unsigned)tls_WorkerIndex
+                                             : m_nextQueue++ % m_workerCount;
+  // Publish the pending count before the task itself so it can never be
+  // claimed while the counter still reads zero; a woken worker may spin
+  // once until the push below lands, which is harmless.
+  ++m_pendingTasks;
+  {
+    WorkerQueue &queue = *m_queues[queueIndex];
+    std::lock_guard<std::mutex> L(queue.Mutex);
+    queue.Tasks[(unsigned)priority].push_back(Task{std::move(fn), pGroup});
+  }
+  {
+    // Empty critical section: a worker that saw no pending work either
+    // waits already or still holds the sleep lock; either way it cannot
+    // miss the notify below.
+    std::lock_guard<std::mutex> L(m_sleepMutex);
+  }
+  m_sleepCv.notify_one();
+}
+
+bool ThreadPool::PopTask(unsigned workerIndex, Task &task) {
+  // Full High pass - own queue, then steal - before any Normal work, so
+  // priorities are strict across the whole pool, not per queue.
+  for (unsigned p = 0; p < 2; ++p) {
+    {
+      WorkerQueue &own = *m_queues[workerIndex];
+      std::lock_guard<std::mutex> L(own.Mutex);
+      if (!own.Tasks[p].empty()) {
+        task = std::move(own.Tasks[p].back());
+        own.Tasks[p].pop_back();
+        --m_pendingTasks;
+        return true;
+      }
+    }
+    for (unsigned offset = 1; offset < m_workerCount; ++offset) {
+      WorkerQueue &victim = *m_queues[(workerIndex + offset) % m_workerCount];
+      std::lock_guard<std::mutex> L(victim.Mutex);
+      if (!victim.Tasks[p].empty()) {
+        task = std::move(victim.Tasks[p].front());
+        victim.Tasks[p].pop_front();
+        --m_pendingTasks;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::TryExecuteOneTask() {
+  Task task;
+  bool claimed = false;
+  for (unsigned p = 0; p < 2 && !claimed; ++p) {
+    for (unsigned i = 0; i < m_workerCount && !claimed; ++i) {
+      WorkerQueue &queue = *m_queues[i];
+      std::lock_guard<std::mutex> L(queue.Mutex);
+      if (!queue.Tasks[p].empty()) {
+        task = std::move(queue.Tasks[p].front());
+        queue.Tasks[p].pop_front();
+        --m_pendingTasks;
+        claimed = true;
+      }
+    }
+  }
+  if (!claimed)
+    return false;
+  RunTask(task);
+  return true;
+}
+
+void ThreadPool::RunTask(Task &task) {
+  task.Fn();
+  // Destroy the closure before signaling completion: a waiter may tear down
+  // captured state the moment the group drains.
+  task.Fn = nullptr;
+  if (task.Group) {
+    std::lock_guard<std::mutex> L(task.Group->m_mutex);
+    if (--task.Group->m_outstanding == 0)
+      task.Group->m_cv.notify_all();
+  }
+}
+
+void ThreadPool::WorkerLoop(unsigned workerIndex) {
+  tls_WorkerIndex = (int)workerIndex;
+  BindWorkerToNumaNode(workerIndex);
+  for (;;) {
+    Task task;
+    if (PopTask(workerIndex, task)) {
+      RunTask(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> L(m_sleepMutex);
+    m_sleepCv.wait(L, [this] { return m_pendingTasks.load() != 0; });
+  }
+}
+
+void ThreadPoolTaskGroup::Wait() {
+  ThreadPool &pool = ThreadPool::Get();
+  std::unique_lock<std::mutex> L(m_mutex);
+  while (m_outstanding != 0) {
+    L.unlock();
+    if (pool.TryExecuteOneTask()) {
+      L.lock();
+      continue;
+    }
+    L.lock();
+    // The remaining tasks are running elsewhere, or queued but momentarily
+    // unclaimable; the timed wait re-checks for stealable work instead of
+    // sleeping indefinitely on the completion signal alone.
+    m_cv.wait_for(L, std::chrono::milliseconds(1),
+                  [this] { return m_outstanding == 0; });
+  }
+}
@@ -207,7 +207,7 @@ void PassManagerBuilder::populateFunctionPassManager(
 }
 
 // HLSL Change Starts
-static void addHLSLPasses(bool HLSLHighLevel, unsigned OptLevel, hlsl::HLSLExtensionsCodegenHelper *ExtHelper, legacy::PassManagerBase &MPM) {
+static void addHLSLPasses(bool HLSLHighLevel, unsigned OptLevel, hlsl::HLSLExtensionsCodegenHelper *ExtHelper, StringRef ProfileUnrollUse, legacy::PassManagerBase &MPM) {
 
   // Don't do any lowering if we're targeting high-level.
   if (HLSLHighLevel) {
@@ -219,9 +219,11 @@ static void addHLSLPasses(bool HLSLHighLevel, unsigned OptLevel, hlsl::HLSLExten
 
   MPM.add(createHLPreprocessPass());
   bool NoOpt = OptLevel == 0;
-  if (!NoOpt) {
-    MPM.add(createHLDeadFunctionEliminationPass());
-  }
+  // Run this even without optimizations: when compiling one entry from a
+  // multi-entry source, functions reachable only from the other entries are
+  // dropped from the final DXIL regardless, so there is no reason to carry
+  // them through the whole lowering pipeline.
+  MPM.add(createHLDeadFunctionEliminationPass());
 
   // Expand buffer store intrinsics before we SROA
   MPM.add(createHLExpandStoreIntrinsicsPass());
@@ -277,7 +279,7 @@ static void addHLSLPasses(bool HLSLHighLevel, unsigned OptLevel, hlsl::HLSLExten
   // struct members.
   // Needs to happen before resources are lowered and before HL
   // module is gone.
-  MPM.add(createDxilLoopUnrollPass(1024));
+  MPM.add(createDxilLoopUnrollPass(1024, ProfileUnrollUse));
 
   // Default unroll pass. This is purely for optimizing loops without
   // attributes.
@@ -322,6 +324,12 @@ void PassManagerBuilder::populateModulePassManager(
     legacy::PassManagerBase &MPM) {
   // If all optimizations are disabled, just run the always-inline pass and,
   // if enabled, the function merging pass.
+  // HLSL Change - this block is the dedicated -Od pipeline: it carries only
+  // the passes DXIL legalization requires (SROA/matrix/vector lowering,
+  // mem2reg for validator-mandated promotion, [unroll] handling, resource
+  // lowering and finalization). Optimization passes are not added and then
+  // self-disabled; they are simply absent, so -Od compile time is the
+  // legalization floor.
   if (OptLevel == 0) {
     if (!HLSLHighLevel) {
       MPM.add(createHLEnsureMetadataPass()); // HLSL Change - rehydrate metadata from high-level codegen
@@ -355,9 +363,10 @@ void PassManagerBuilder::populateModulePassManager(
     addExtensionsToPM(EP_EnabledOnOptLevel0, MPM);
 
     // HLSL Change Begins.
-    addHLSLPasses(HLSLHighLevel, OptLevel, HLSLExtensionsCodeGen, MPM);
+    addHLSLPasses(HLSLHighLevel, OptLevel, HLSLExtensionsCodeGen, HLSLProfileUnrollUse, MPM);
     if (!HLSLHighLevel) {
-      MPM.add(createDxilConvergentClearPass());
+      // No convergent-clear pass here: DxilConvergentMark only runs when
+      // optimizing, so at -Od there are never markers to strip.
       MPM.add(createMultiDimArrayToOneDimArrayPass());
       MPM.add(createDxilRemoveDeadBlocksPass());
       MPM.add(createDeadCodeEliminationPass());
@@ -390,7 +399,7 @@ void PassManagerBuilder::populateModulePassManager(
     delete Inliner;
     Inliner = nullptr;
   }
-  addHLSLPasses(HLSLHighLevel, OptLevel, HLSLExtensionsCodeGen, MPM); // HLSL Change
+  addHLSLPasses(HLSLHighLevel, OptLevel, HLSLExtensionsCodeGen, HLSLProfileUnrollUse, MPM); // HLSL Change
   // HLSL Change Ends
 
   // Add LibraryInfo if we have some.
@@ -663,6 +672,10 @@ void PassManagerBuilder::populateModulePassManager(
     // Always try to legalize sample offsets as loop unrolling
     // is not guaranteed for higher opt levels.
     MPM.add(createDxilLegalizeSampleOffsetPass());
+    // Shorten live ranges once the DXIL is in near-final shape; earlier
+    // passes would just hoist the values back out.
+    if (HLSLPressureSchedule)
+      MPM.add(createDxilScheduleForPressurePass());
     MPM.add(createDxilFinalizeModulePass());
     MPM.add(createComputeViewIdStatePass());
     MPM.add(createDxilDeadFunctionEliminationPass());
@@ -18,6 +18,7 @@
 //
 
 #include "llvm/Pass.h"
+#include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/Analysis/CFG.h"
 #include "llvm/Analysis/PostDominators.h"
 #include "llvm/Transforms/Scalar.h"
@@ -40,6 +41,29 @@ struct DxilEraseDeadRegion : public FunctionPass {
 
   std::unordered_map<BasicBlock *, bool> m_HasSideEffect;
 
+  // Memoized failure verdicts. For each block, m_Dependents lists the failed
+  // candidates whose analysis examined it; a verdict is only re-derived when
+  // a region containing one of its examined blocks is actually erased.
+  std::unordered_set<BasicBlock *> m_FailedSet;
+  std::unordered_map<BasicBlock *, std::vector<BasicBlock *>> m_Dependents;
+
+  void RecordFailure(BasicBlock *Candidate,
+                     const std::vector<BasicBlock *> &Footprint) {
+    m_FailedSet.insert(Candidate);
+    for (BasicBlock *BB : Footprint)
+      m_Dependents[BB].push_back(Candidate);
+  }
+
+  void InvalidateBlock(BasicBlock *BB) {
+    m_HasSideEffect.erase(BB);
+    auto FindIt = m_Dependents.find(BB);
+    if (FindIt == m_Dependents.end())
+      return;
+    for (BasicBlock *Candidate : FindIt->second)
+      m_FailedSet.erase(Candidate);
+    m_Dependents.erase(FindIt);
+  }
+
   bool HasSideEffects(BasicBlock *BB) {
     auto FindIt = m_HasSideEffect.find(BB);
     if (FindIt != m_HasSideEffect.end()) {
@@ -84,13 +108,18 @@ struct DxilEraseDeadRegion : public FunctionPass {
     return Region.size() != 0;
   }
 
-  bool TrySimplify(DominatorTree *DT, PostDominatorTree *PDT, BasicBlock *BB) {
+  bool TrySimplify(DominatorTree *DT, PostDominatorTree *PDT, BasicBlock *BB,
+                   std::vector<BasicBlock *> &Footprint,
+                   std::unordered_set<BasicBlock *> &Erased) {
+    Footprint.push_back(BB);
+
     // Give up if BB has any Phis
     if (BB->begin() != BB->end() && isa<PHINode>(BB->begin()))
       return false;
 
     std::vector<BasicBlock *> Predecessors(pred_begin(BB), pred_end(BB));
     if (Predecessors.size() < 2) return false;
+    Footprint.insert(Footprint.end(), Predecessors.begin(), Predecessors.end());
 
     // Give up if BB is a self loop
     for (BasicBlock *PredBB : Predecessors)
@@ -104,6 +133,7 @@ struct DxilEraseDeadRegion : public FunctionPass {
       Common = DT->findNearestCommonDominator(Common, Predecessors[i]);
       if (!Common) return false;
     }
+    Footprint.push_back(Common);
 
    // If there are any metadata on Common block's branch, give up.
     if (Common->getTerminator()->hasMetadataOtherThanDebugLoc())
@@ -115,7 +145,11 @@ struct DxilEraseDeadRegion : public FunctionPass {
       return false;
 
     std::set<BasicBlock *> Region;
-    if (!this->FindDeadRegion(Common, BB, Region))
+    bool FoundRegion = this->FindDeadRegion(Common, BB, Region);
+    // Even a partially discovered region belongs to the footprint; erasing
+    // any of it may change the verdict.
+    Footprint.insert(Footprint.end(), Region.begin(), Region.end());
+    if (!FoundRegion)
       return false;
 
     // If BB branches INTO the region, forming a loop give up.
@@ -123,6 +157,14 @@ struct DxilEraseDeadRegion : public FunctionPass {
       if (Region.count(Succ))
         return false;
 
+    // Re-open any memoized verdicts that examined the blocks this erasure
+    // touches: the region itself, the rewritten Common, and BB whose
+    // predecessors change.
+    for (BasicBlock *RegionBB : Region)
+      InvalidateBlock(RegionBB);
+    InvalidateBlock(Common);
+    InvalidateBlock(BB);
+
     // Replace Common's branch with an unconditional branch to BB
     Common->getTerminator()->eraseFromParent();
     BranchInst::Create(BB, Common);
@@ -134,6 +176,7 @@ struct DxilEraseDeadRegion : public FunctionPass {
       BB->dropAllReferences();
     }
     for (BasicBlock *BB : Region) {
+      Erased.insert(BB);
       while (BB->begin() != BB->end())
         BB->begin()->eraseFromParent();
       BB->eraseFromParent();
@@ -151,21 +194,34 @@ struct DxilEraseDeadRegion : public FunctionPass {
     auto *DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
     auto *PDT = &getAnalysis<PostDominatorTree>();
 
-    std::unordered_set<BasicBlock *> FailedSet;
+    // The caches key on block pointers; drop anything left from a previously
+    // processed function.
+    m_HasSideEffect.clear();
+    m_FailedSet.clear();
+    m_Dependents.clear();
+
     bool Changed = false;
     while (1) {
       bool LocalChanged = false;
-      for (Function::iterator It = F.begin(), E = F.end(); It != E; It++) {
-        BasicBlock &BB = *It;
-        if (FailedSet.count(&BB))
+
+      // Visit candidates in post-order so inner regions resolve and erase
+      // before the outer regions that contain them are analyzed, and erase
+      // as many regions per walk as possible instead of restarting the scan
+      // after every success.
+      std::vector<BasicBlock *> PostOrder(po_begin(&F), po_end(&F));
+      std::unordered_set<BasicBlock *> ErasedBlocks;
+      for (BasicBlock *BB : PostOrder) {
+        if (ErasedBlocks.count(BB) || m_FailedSet.count(BB))
           continue;
 
-        if (this->TrySimplify(DT, PDT, &BB)) {
+        std::vector<BasicBlock *> Footprint;
+        if (this->TrySimplify(DT, PDT, BB, Footprint, ErasedBlocks)) {
           LocalChanged = true;
-          break;
-        }
-        else {
-          FailedSet.insert(&BB);
+          // The trees only go stale when a region is actually erased.
+          DT->recalculate(F);
+          PDT->DT->recalculate(F);
+        } else {
+          RecordFailure(BB, Footprint);
         }
       }
 
@@ -83,6 +83,9 @@
 #include "dxc/DXIL/DxilUtil.h"
 #include "dxc/HLSL/HLModule.h"
 #include "llvm/Analysis/DxilValueCache.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+
+#include <map>
 
 using namespace llvm;
 using namespace hlsl;
@@ -115,15 +118,34 @@ public:
 
   std::unordered_set<Function *> CleanedUpAlloca;
   const unsigned MaxIterationAttempt;
+  // Profile-derived unroll factors keyed by the loop's source file and line,
+  // parsed from -fprofile-unroll-use. A factor of 0 keeps the loop rolled.
+  std::map<std::pair<std::string, unsigned>, unsigned> ProfileUnrollCounts;
 
-  DxilLoopUnroll(unsigned MaxIterationAttempt = 1024) :
+  DxilLoopUnroll(unsigned MaxIterationAttempt = 1024,
+                 StringRef ProfileUnrollHints = StringRef()) :
     LoopPass(ID),
     MaxIterationAttempt(MaxIterationAttempt)
   {
     initializeDxilLoopUnrollPass(*PassRegistry::getPassRegistry());
+    // Malformed entries are rejected when the option is parsed, so they are
+    // simply skipped here.
+    SmallVector<StringRef, 4> Entries;
+    ProfileUnrollHints.split(Entries, ';', /*MaxSplit*/ -1, /*KeepEmpty*/ false);
+    for (StringRef Entry : Entries) {
+      StringRef File, LineStr, CountStr;
+      std::tie(File, CountStr) = Entry.rsplit(':');
+      std::tie(File, LineStr) = File.rsplit(':');
+      unsigned Line = 0, Count = 0;
+      if (File.empty() || LineStr.getAsInteger(10, Line) ||
+          CountStr.getAsInteger(10, Count))
+        continue;
+      ProfileUnrollCounts[std::make_pair(File.str(), Line)] = Count;
+    }
   }
   const char *getPassName() const override { return "Dxil Loop Unroll"; }
   bool runOnLoop(Loop *L, LPPassManager &LPM) override;
+  bool FindProfileUnrollCount(const DebugLoc &LoopLoc, unsigned *OutCount) const;
   void getAnalysisUsage(AnalysisUsage &AU) const override {
     AU.addRequired<LoopInfoWrapperPass>();
     AU.addRequired<AssumptionCacheTracker>();
@@ -617,6 +639,19 @@ static void RecursivelyRemoveLoopFromQueue(LPPassManager &LPM, Loop *L) {
   LPM.deleteLoopFromQueue(L);
 }
 
+bool DxilLoopUnroll::FindProfileUnrollCount(const DebugLoc &LoopLoc,
+                                            unsigned *OutCount) const {
+  if (ProfileUnrollCounts.empty() || !LoopLoc)
+    return false;
+  DILocation *DIL = LoopLoc.get();
+  auto It = ProfileUnrollCounts.find(
+      std::make_pair(DIL->getFilename().str(), DIL->getLine()));
+  if (It == ProfileUnrollCounts.end())
+    return false;
+  *OutCount = It->second;
+  return true;
+}
+
 bool DxilLoopUnroll::runOnLoop(Loop *L, LPPassManager &LPM) {
 
   DebugLoc LoopLoc = L->getStartLoc(); // Debug location for the start of the loop.
@@ -627,8 +662,17 @@ bool DxilLoopUnroll::runOnLoop(Loop *L, LPPassManager &LPM) {
   bool HasExplicitLoopCount = false;
   int ExplicitUnrollCountSigned = 0;
 
+  // A profile-supplied unroll factor for this loop's source location takes
+  // precedence over the [unroll] attribute.
+  unsigned ProfileUnrollCount = 0;
+  if (FindProfileUnrollCount(LoopLoc, &ProfileUnrollCount)) {
+    if (ProfileUnrollCount == 0)
+      return false; // The profile wants this loop left rolled.
+    HasExplicitLoopCount = true;
+    ExplicitUnrollCountSigned = (int)ProfileUnrollCount;
+  }
   // If the loop is not marked as [unroll], don't do anything.
-  if (IsMarkedUnrollCount(L, &ExplicitUnrollCountSigned)) {
+  else if (IsMarkedUnrollCount(L, &ExplicitUnrollCountSigned)) {
     HasExplicitLoopCount = true;
   }
   else if (!IsMarkedFullUnroll(L)) {
@@ -1049,8 +1093,9 @@ bool DxilLoopUnroll::runOnLoop(Loop *L, LPPassManager &LPM) {
 
 }
 
-Pass *llvm::createDxilLoopUnrollPass(unsigned MaxIterationAttempt) {
-  return new DxilLoopUnroll(MaxIterationAttempt);
+Pass *llvm::createDxilLoopUnrollPass(unsigned MaxIterationAttempt,
+                                     StringRef ProfileUnrollHints) {
+  return new DxilLoopUnroll(MaxIterationAttempt, ProfileUnrollHints);
 }
 
 INITIALIZE_PASS_BEGIN(DxilLoopUnroll, "dxil-loop-unroll", "Dxil Unroll loops", false, false)
@@ -26,11 +26,12 @@
 // non-constant values are written. The uninitialized values will be hoisted 
 // as undef values.
 //
-// Improvements:
-// Currently we do not merge arrays that have the same constant values. We
-// create the global variables with `unnamed_addr` set which means they
-// can be merged with other constants. We should probably use a separate
-// pass to merge all the unnamed_addr constants.
+// Arrays that hoist to the same constant initializer share a single global.
+// Constants are uniqued by the LLVM context, so two arrays have identical
+// contents exactly when they produce the same initializer Constant; we key
+// the hoisted globals on that. The globals are also created with
+// `unnamed_addr` set so any remaining duplicates can be merged with other
+// constants by later passes.
 //
 // Example:
 //
@@ -82,6 +83,7 @@
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Operator.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/ADT/DenseMap.h"
 using namespace llvm;
 
 namespace {
@@ -107,6 +109,10 @@ namespace {
     std::vector<AllocaInst *> findCandidateAllocas(Function &F);
     void hoistArray(const CandidateArray &candidate);
     void removeLocalArrayStores(const CandidateArray &candidate);
+
+    // Globals already created for hoisted arrays, keyed on their (uniqued)
+    // constant initializer so identical arrays share one global.
+    DenseMap<Constant *, GlobalVariable *> m_HoistedArrays;
  };
 
   // Represents an array we are considering for hoisting.
@@ -117,6 +123,7 @@ namespace {
     explicit CandidateArray(AllocaInst *);
     bool IsConstArray() const { return m_IsConstArray; }
     void AnalyzeUses();
+    Constant *GetInitializer() const;
     GlobalVariable *GetGlobalArray() const;
     AllocaInst *GetLocalArray() const { return m_Alloca; }
     std::vector<StoreInst*> GetArrayStores() const;
@@ -175,11 +182,17 @@ CandidateArray::CandidateArray(AllocaInst *AI)
   m_ArrayType = getAllocaArrayType(AI);
 }
 
+// Get the constant initializer for the array.
+// Only valid to call if the array has been analyzed as a constant array.
+Constant *CandidateArray::GetInitializer() const {
+  assert(IsConstArray());
+  return ConstantArray::get(m_ArrayType, m_Values);
+}
+
 // Get the global variable with a constant initializer for the array.
 // Only valid to call if the array has been analyzed as a constant array.
 GlobalVariable *CandidateArray::GetGlobalArray() const {
-  assert(IsConstArray());
-  Constant *initializer = ConstantArray::get(m_ArrayType, m_Values);
+  Constant *initializer = GetInitializer();
   Module *M = m_Alloca->getModule();
   GlobalVariable *GV = new GlobalVariable(*M, m_ArrayType, true, GlobalVariable::LinkageTypes::InternalLinkage, initializer, Twine(m_Alloca->getName()) + ".hca");
   GV->setUnnamedAddr(true);
@@ -363,7 +376,11 @@ void HoistConstantArray::hoistArray(const CandidateArray &candidate) {
 
   removeLocalArrayStores(candidate);
   AllocaInst *local = candidate.GetLocalArray();
-  GlobalVariable *global = candidate.GetGlobalArray();
+  // Initializers are uniqued constants, so arrays with identical contents
+  // produce the same Constant and can share a single global.
+  GlobalVariable *&global = m_HoistedArrays[candidate.GetInitializer()];
+  if (!global)
+    global = candidate.GetGlobalArray();
   local->replaceAllUsesWith(global);
   local->eraseFromParent();
 }
@@ -389,6 +406,7 @@ char HoistConstantArray::ID = 0;
 INITIALIZE_PASS(HoistConstantArray, "hlsl-hca", "Hoist constant arrays", false, false)
 
 bool HoistConstantArray::runOnModule(Module &M) {
+  m_HoistedArrays.clear();
   bool changed = false;
   for (Function &F : M) {
     if (F.isDeclaration())
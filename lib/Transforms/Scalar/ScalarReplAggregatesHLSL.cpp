@@ -72,6 +72,7 @@ using namespace hlsl;
 STATISTIC(NumReplaced, "Number of allocas broken up");
 STATISTIC(NumPromoted, "Number of allocas promoted");
 STATISTIC(NumAdjusted, "Number of scalar allocas adjusted to allow promotion");
+STATISTIC(NumElements, "Number of element allocas created by flattening");
 
 namespace {
 
@@ -1177,6 +1178,7 @@ bool SROA_HLSL::performScalarRepl(Function &F, DxilTypeSystem &typeSys) {
           AllocaInst *EltAlloca = cast<AllocaInst>(Elts[EltIdx]);
           WorkList.push(EltAlloca);
         }
+        NumElements += Elts.size();
 
         // Now erase any instructions that were made dead while rewriting the
         // alloca.
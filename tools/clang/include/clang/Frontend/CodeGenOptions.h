@@ -185,6 +185,8 @@ public:
   bool HLSLNotUseLegacyCBufLoad = false;
   /// Whether use legacy resource reservation.
   bool HLSLLegacyResourceReservation = false;
+  /// Embed a content hash instead of full source text in debug metadata.
+  bool HLSLEmbedSourceHashOnly = false;
   /// Set [branch] on every if.
   bool HLSLPreferControlFlow = false;
   /// Set [flatten] on every if.
@@ -220,6 +222,11 @@ public:
   bool HLSLResMayAlias = false;
   /// Lookback scan limit for memory dependencies
   unsigned ScanLimit = 0;
+  /// Profile-derived per-loop unroll factors, keyed by source location.
+  std::string HLSLProfileUnrollUse;
+  /// Run the late sink-toward-uses scheduling pass to reduce register
+  /// pressure.
+  bool HLSLPressureSchedule = false;
   // HLSL Change Ends
 
   // SPIRV Change Starts
@@ -291,6 +291,11 @@ QualType getComponentVectorType(const ASTContext &, QualType matrixType);
 QualType getHLSLMatrixType(ASTContext &, Sema &, ClassTemplateDecl *,
                            QualType elemType, int rows, int columns);
 
+/// \brief Clears the memoization caches behind the recursive type probes.
+/// Must be called at the start of each compile: the caches key on canonical
+/// Type pointers, which a fresh ASTContext may reuse.
+void clearTypeProbeCaches();
+
 } // namespace spirv
 } // namespace clang
 
@@ -70,10 +70,14 @@ public:
   /// OpLoopMerge instruction. Returns nullptr otherwise.
   SpirvBasicBlock *getContinueTarget() const { return continueTarget; }
 
-  /// Adds an instruction to the vector of instructions belonging to this basic
-  /// block.
+  /// Appends an instruction to this basic block. The body is kept as a
+  /// linked list, so appending is O(1) regardless of block size and the
+  /// list can be spliced without shifting existing instructions.
   void addInstruction(SpirvInstruction *inst) { instructions.push_back(inst); }
 
+  /// Returns the number of instructions in this basic block.
+  size_t getInstructionCount() const { return instructions.size(); }
+
   /// Returns true if the last instruction in this basic block is a termination
   /// instruction.
   bool hasTerminator() const;
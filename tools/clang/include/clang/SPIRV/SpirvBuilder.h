@@ -14,6 +14,8 @@
 #include "clang/SPIRV/SpirvFunction.h"
 #include "clang/SPIRV/SpirvInstruction.h"
 #include "clang/SPIRV/SpirvModule.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringSet.h"
 
 #include "spirv/unified1/NonSemanticDebugPrintf.h"
 
@@ -632,14 +634,37 @@ private:
   // To avoid generating multiple OpStrings for the same string literal
   // the SpirvBuilder will generate and reuse them.
   llvm::DenseMap<std::string, SpirvString *, StringMapInfo> stringLiterals;
+
+  // Fast filters for requireCapability/requireExtension. The module-level
+  // sets already deduplicate by value, but only after allocating an
+  // instruction for the query, and the capability visitor queries per
+  // instruction; repeats are filtered here without allocating anything.
+  llvm::DenseSet<uint32_t> requiredCapabilities;
+  llvm::StringSet<> requiredExtensions;
+
+  // Caches for reusing scalar constants, keyed by AST type and bit pattern.
+  // EmitVisitor already deduplicates constants at binary-emission time, so
+  // sharing the instruction objects does not change the output; it avoids
+  // allocating and walking thousands of duplicates in large shaders.
+  // Literal-typed constants are excluded because LiteralTypeVisitor rewrites
+  // their QualType in place per use, and spec constants are excluded because
+  // each one carries its own SpecId decoration.
+  llvm::DenseMap<std::pair<const void *, uint64_t>, SpirvConstant *>
+      integerConstants;
+  llvm::DenseMap<std::pair<const void *, uint64_t>, SpirvConstant *>
+      floatConstants;
+  SpirvConstant *boolConstants[2] = {nullptr, nullptr};
+  llvm::DenseMap<const void *, SpirvConstant *> nullConstants;
 };
 
 void SpirvBuilder::requireCapability(spv::Capability cap, SourceLocation loc) {
-  mod->addCapability(new (context) SpirvCapability(loc, cap));
+  if (requiredCapabilities.insert(static_cast<uint32_t>(cap)).second)
+    mod->addCapability(new (context) SpirvCapability(loc, cap));
 }
 
 void SpirvBuilder::requireExtension(llvm::StringRef ext, SourceLocation loc) {
-  mod->addExtension(new (context) SpirvExtension(loc, ext));
+  if (requiredExtensions.insert(ext).second)
+    mod->addExtension(new (context) SpirvExtension(loc, ext));
 }
 
 void SpirvBuilder::setMemoryModel(spv::AddressingModel addrModel,
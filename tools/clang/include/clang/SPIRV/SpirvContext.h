@@ -91,6 +91,30 @@ struct ImageTypeMapInfo {
   }
 };
 
+// Provides DenseMapInfo for StructType so we can create a DenseSet of
+// struct types.
+struct StructTypeMapInfo {
+  static inline const StructType *getEmptyKey() { return nullptr; }
+  static inline const StructType *getTombstoneKey() { return nullptr; }
+  static unsigned getHashValue(const StructType *Val) {
+    // Names participate in unification (see the comment on StructType's
+    // fields), so they participate in the hash as well. Hashing the field
+    // types and names is enough to discriminate; the remaining layout bits
+    // are only checked by isEqual.
+    auto hashCode =
+        llvm::hash_combine(Val->getStructName(), Val->isReadOnly(),
+                           static_cast<uint32_t>(Val->getInterfaceType()),
+                           Val->getFields().size());
+    for (const StructType::FieldInfo &field : Val->getFields())
+      hashCode = llvm::hash_combine(hashCode, field.type, field.name);
+    return hashCode;
+  }
+  static bool isEqual(const StructType *LHS, const StructType *RHS) {
+    // Either both are null, or both should have the same underlying type.
+    return (LHS == RHS) || (LHS && RHS && *LHS == *RHS);
+  }
+};
+
 // Provides DenseMapInfo for FunctionType so we can create a DenseSet of
 // function types.
 struct FunctionTypeMapInfo {
@@ -209,6 +233,13 @@ public:
   /// Generates (or reuses an existing) OpString for the given string literal.
   SpirvString *getSpirvString(llvm::StringRef str);
 
+  /// Releases all memory held by the context's allocator in one shot and
+  /// re-creates the singleton types, so that a long-lived process can recycle
+  /// the arena across compiles instead of paying per-object teardown. All
+  /// SPIR-V entity objects previously created from this context become
+  /// invalid.
+  void reset();
+
   /// Functions to get/set current entry point ShaderModelKind.
   ShaderModelKind getCurrentShaderModelKind() { return curShaderModelKind; }
   void setCurrentShaderModelKind(ShaderModelKind smk) {
@@ -260,7 +291,7 @@ private:
   std::array<const FloatType *, 7> floatTypes;
 
   using VectorTypeArray = std::array<const VectorType *, 5>;
-  using MatrixTypeVector = std::vector<const MatrixType *>;
+  using MatrixTypeArray = std::array<const MatrixType *, 5>;
   using SCToPtrTyMap =
       llvm::DenseMap<spv::StorageClass, const SpirvPointerType *,
                      StorageClassDenseMapInfo>;
@@ -269,14 +300,14 @@ private:
   // Type at index is for vector of index components. Index 0/1 is unused.
 
   llvm::DenseMap<const ScalarType *, VectorTypeArray> vecTypes;
-  llvm::DenseMap<const VectorType *, MatrixTypeVector> matTypes;
+  llvm::DenseMap<const VectorType *, MatrixTypeArray> matTypes;
   llvm::DenseSet<const ImageType *, ImageTypeMapInfo> imageTypes;
   const SamplerType *samplerType;
   llvm::DenseMap<const ImageType *, const SampledImageType *> sampledImageTypes;
   llvm::DenseSet<const ArrayType *, ArrayTypeMapInfo> arrayTypes;
   llvm::DenseSet<const RuntimeArrayType *, RuntimeArrayTypeMapInfo>
       runtimeArrayTypes;
-  llvm::SmallVector<const StructType *, 8> structTypes;
+  llvm::DenseSet<const StructType *, StructTypeMapInfo> structTypes;
   llvm::DenseMap<const SpirvType *, SCToPtrTyMap> pointerTypes;
   llvm::DenseSet<FunctionType *, FunctionTypeMapInfo> functionTypes;
   const AccelerationStructureTypeNV *accelerationStructureTypeNV;
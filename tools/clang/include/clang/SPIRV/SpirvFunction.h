@@ -78,6 +78,10 @@ public:
   void setFunctionName(llvm::StringRef name) { functionName = name; }
   llvm::StringRef getFunctionName() const { return functionName; }
 
+  // Returns the number of instructions this function will emit, counting
+  // OpFunction/OpFunctionEnd, parameters, labels and basic block contents.
+  size_t getInstructionCount() const;
+
   void addParameter(SpirvFunctionParameter *);
   void addVariable(SpirvVariable *);
   void addBasicBlock(SpirvBasicBlock *);
@@ -126,6 +130,10 @@ private:
 
   /// Basic blocks inside this function.
   std::vector<SpirvBasicBlock *> basicBlocks;
+
+  /// Basic blocks in human-readable order, computed on first visitor
+  /// invocation and reused by later ones. Cleared when a block is added.
+  std::vector<SpirvBasicBlock *> readableOrderBlocks;
 };
 
 } // end namespace spirv
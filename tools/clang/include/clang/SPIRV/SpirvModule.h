@@ -134,6 +134,12 @@ public:
 
   llvm::ArrayRef<SpirvVariable *> getVariables() const { return variables; }
 
+  llvm::ArrayRef<SpirvFunction *> getFunctions() const { return functions; }
+
+  // Entity counts used to pre-size emission buffers.
+  size_t getConstantCount() const { return constants.size(); }
+  size_t getDecorationCount() const { return decorations.size(); }
+
 private:
   // Use a set for storing capabilities. This will ensure there are no duplicate
   // capabilities. Although the set stores pointers, the provided
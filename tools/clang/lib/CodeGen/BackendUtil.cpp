@@ -301,6 +301,13 @@ static void addSymbolRewriterPass(const CodeGenOptions &Opts,
   MPM->add(createRewriteSymbolsPass(DL));
 }
 
+// HLSL Change - note on pipeline reuse: this rebuilds the pass pipeline on
+// every compile even though only a handful of distinct configurations occur
+// in practice. Caching prebuilt pipelines is not possible with the legacy
+// PassManager: it owns and deletes its passes, passes carry per-run state,
+// and there is no way to clone one. A process-global template cache would
+// also violate the no-global-state rule this file follows (see
+// CreateTargetMachine). The construction cost is per compile by design.
 void EmitAssemblyHelper::CreatePasses() {
   unsigned OptLevel = CodeGenOpts.OptimizationLevel;
   CodeGenOptions::InliningMethod Inlining = CodeGenOpts.getInlining();
@@ -327,6 +334,8 @@ void EmitAssemblyHelper::CreatePasses() {
   PMBuilder.HLSLExtensionsCodeGen = CodeGenOpts.HLSLExtensionsCodegen.get(); // HLSL Change
   PMBuilder.HLSLResMayAlias = CodeGenOpts.HLSLResMayAlias; // HLSL Change
   PMBuilder.ScanLimit = CodeGenOpts.ScanLimit; // HLSL Change
+  PMBuilder.HLSLProfileUnrollUse = CodeGenOpts.HLSLProfileUnrollUse; // HLSL Change
+  PMBuilder.HLSLPressureSchedule = CodeGenOpts.HLSLPressureSchedule; // HLSL Change
 
   PMBuilder.DisableUnitAtATime = !CodeGenOpts.UnitAtATime;
   PMBuilder.DisableUnrollLoops = !CodeGenOpts.UnrollLoops;
@@ -712,6 +721,12 @@ void EmitAssemblyHelper::EmitAssembly(BackendAction Action,
   if (PerFunctionPasses) {
     PrettyStackTraceString CrashInfo("Per-function optimization");
 
+    // HLSL Change: this loop stays single-threaded by design. Function
+    // passes mutate IR that shares uniqued constants, types, and global
+    // use-lists through the one LLVMContext, so running them concurrently
+    // is unsound; -fparallel-codegen therefore reports that bodies are
+    // emitted serially. Parallelism across compiles (one context each) is
+    // the supported route.
     PerFunctionPasses->doInitialization();
     for (Function &F : *TheModule)
       if (!F.isDeclaration())
@@ -202,6 +202,12 @@ private:
                                      DxilTypeSystem &dxilTypeSys);
   unsigned AddTypeAnnotation(QualType Ty, DxilTypeSystem &dxilTypeSys,
                              unsigned &arrayEltSize);
+  unsigned AddTypeAnnotationImpl(QualType Ty, DxilTypeSystem &dxilTypeSys,
+                                 unsigned &arrayEltSize);
+  // Memoized AddTypeAnnotation results per canonical type: cbuffer size and
+  // the array element size the call reports when none was seen yet.
+  llvm::DenseMap<const clang::Type *, std::pair<unsigned, unsigned>>
+      m_typeAnnotationSizeMap;
   MDNode *GetOrAddResTypeMD(QualType resTy, bool bCreate);
   DxilResourceProperties BuildResourceProperty(QualType resTy);
   void ConstructFieldAttributedAnnotation(DxilFieldAnnotation &fieldAnnotation,
@@ -1008,6 +1014,41 @@ static unsigned GetNumTemplateArgsForRecordDecl(const RecordDecl *RD) {
 unsigned CGMSHLSLRuntime::AddTypeAnnotation(QualType Ty,
                                             DxilTypeSystem &dxilTypeSys,
                                             unsigned &arrayEltSize) {
+  // Annotation building walks the whole type tree, and the same struct is
+  // reached once per cbuffer, parameter and field that uses it. Memoize the
+  // computed sizes per canonical type; the struct annotations themselves are
+  // created in dxilTypeSys on the first visit and reused afterwards.
+  // Matrix orientation is carried in type sugar that canonicalization
+  // strips, and it changes the cbuffer size, so matrix and array-of-matrix
+  // types are always computed directly.
+  QualType elementTy = Ty;
+  while (const clang::ArrayType *AT = CGM.getContext().getAsArrayType(elementTy))
+    elementTy = AT->getElementType();
+  if (IsHLSLMatType(elementTy))
+    return AddTypeAnnotationImpl(Ty, dxilTypeSys, arrayEltSize);
+
+  const clang::Type *cacheKey = Ty.getCanonicalType().getTypePtr();
+  auto cached = m_typeAnnotationSizeMap.find(cacheKey);
+  if (cached != m_typeAnnotationSizeMap.end()) {
+    if (arrayEltSize == 0)
+      arrayEltSize = cached->second.second;
+    return cached->second.first;
+  }
+
+  // Compute with a fresh element size so the cache records what this type
+  // reports on its own; the caller's value is only filled in when unset,
+  // matching the uncached behavior.
+  unsigned localEltSize = 0;
+  unsigned size = AddTypeAnnotationImpl(Ty, dxilTypeSys, localEltSize);
+  m_typeAnnotationSizeMap[cacheKey] = std::make_pair(size, localEltSize);
+  if (arrayEltSize == 0)
+    arrayEltSize = localEltSize;
+  return size;
+}
+
+unsigned CGMSHLSLRuntime::AddTypeAnnotationImpl(QualType Ty,
+                                                DxilTypeSystem &dxilTypeSys,
+                                                unsigned &arrayEltSize) {
   QualType paramTy = Ty.getCanonicalType();
   if (const ReferenceType *RefType = dyn_cast<ReferenceType>(paramTy))
     paramTy = RefType->getPointeeType();
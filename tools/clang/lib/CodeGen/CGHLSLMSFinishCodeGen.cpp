@@ -785,6 +785,16 @@ Function *CloneFunction(Function *Orig, const llvm::Twine &Name,
 // Clone shader entry function to be called by other functions.
 // The original function will be used as shader entry.
 void CloneShaderEntry(Function *ShaderF, StringRef EntryName, HLModule &HLM) {
+  // The clone only exists to serve calls to the entry from other functions.
+  // When nothing in the module calls this entry - the common case in large
+  // libraries - the internal clone could never be reached (the linker only
+  // resolves internal symbols through this module's own call graph), so
+  // skip the body copy and just give the entry its unmangled name.
+  if (ShaderF->user_empty()) {
+    ShaderF->setName(EntryName);
+    return;
+  }
+
   Function *F = CloneFunction(ShaderF, "", HLM.GetModule(), HLM.GetTypeSystem(),
                               HLM.GetTypeSystem());
 
@@ -2035,6 +2045,9 @@ void ConstructCBuffer(
     // Clear the constants which useless now.
     CB.GetConstants().clear();
   }
+  // The cbuffers were registered with placeholder symbols and just received
+  // their real globals, so any resource lookup index built earlier is stale.
+  HLM.InvalidateResourceIndexes();
 }
 }
 
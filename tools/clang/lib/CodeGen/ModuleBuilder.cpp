@@ -26,6 +26,7 @@
 #include "llvm/IR/Module.h"
 #include <memory>
 #include "dxc/DXIL/DxilMetadataHelper.h" // HLSL Change - dx source info
+#include "llvm/Support/MD5.h" // HLSL Change - source hash embedding
 #include "llvm/Support/Path.h"
 using namespace clang;
 
@@ -223,6 +224,21 @@ namespace {
             pContents = M->getOrInsertNamedMetadata(
               hlsl::DxilMDHelper::kDxilSourceContentsMDName);
           }
+          // With hash-only embedding, store a content hash instead of the
+          // text; identical sources across a batch of permutations then
+          // share one entry in an external content-addressed store.
+          std::string hashStub;
+          if (CodeGenOpts.HLSLEmbedSourceHashOnly) {
+            llvm::MD5 md5;
+            llvm::MD5::MD5Result hash;
+            md5.update(content);
+            md5.final(hash);
+            llvm::SmallString<32> hex;
+            llvm::MD5::stringifyResult(hash, hex);
+            hashStub = hlsl::DxilMDHelper::kDxilSourceContentHashPrefix;
+            hashStub += hex.str();
+            content = hashStub;
+          }
           llvm::MDTuple *pFileInfo = llvm::MDNode::get(
             LLVMCtx,
             { llvm::MDString::get(LLVMCtx, name),
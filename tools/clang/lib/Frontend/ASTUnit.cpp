@@ -1373,6 +1373,10 @@ ASTUnit::getMainBufferWithPrecompiledPreamble(
     const CompilerInvocation &PreambleInvocationIn, bool AllowRebuild,
     unsigned MaxLines) {
 #if 1 // HLSL Change Starts - no support for PCH
+  // Preamble reuse depends on serializing the preamble's AST to a PCH and
+  // reading it back, and AST serialization is disabled throughout this
+  // compiler (the HLSL AST extensions have no ASTWriter/ASTReader support).
+  // Until that exists, reparses always process the full translation unit.
   return std::unique_ptr<llvm::MemoryBuffer>();
 #else
   IntrusiveRefCntPtr<CompilerInvocation>
@@ -421,7 +421,7 @@ void CompilerInstance::createASTContext() {
 void CompilerInstance::createPCHExternalASTSource(
     StringRef Path, bool DisablePCHValidation, bool AllowPCHWithCompilerErrors,
     void *DeserializationListener, bool OwnDeserializationListener) {
-#if 0 // HLSL Change Starts - no support for PCH
+  // HLSL Change: re-enabled to support precompiled HLSL prefix headers.
   bool Preamble = getPreprocessorOpts().PrecompiledPreambleBytes.first != 0;
   ModuleManager = createPCHExternalASTSource(
       Path, getHeaderSearchOpts().Sysroot, DisablePCHValidation,
@@ -429,7 +429,6 @@ void CompilerInstance::createPCHExternalASTSource(
       getPCHContainerReader(), DeserializationListener,
       OwnDeserializationListener, Preamble,
       getFrontendOpts().UseGlobalModuleIndex);
-#endif // HLSL Change Ends - no support for PCH
 }
 
 IntrusiveRefCntPtr<ASTReader> CompilerInstance::createPCHExternalASTSource(
@@ -438,7 +437,7 @@ IntrusiveRefCntPtr<ASTReader> CompilerInstance::createPCHExternalASTSource(
     const PCHContainerReader &PCHContainerRdr,
     void *DeserializationListener, bool OwnDeserializationListener,
     bool Preamble, bool UseGlobalModuleIndex) {
-#if 0 // HLSL Change Starts - no support for PCH
+  // HLSL Change: re-enabled to support precompiled HLSL prefix headers.
   HeaderSearchOptions &HSOpts = PP.getHeaderSearchInfo().getHeaderSearchOpts();
 
   IntrusiveRefCntPtr<ASTReader> Reader(new ASTReader(
@@ -479,7 +478,6 @@ IntrusiveRefCntPtr<ASTReader> CompilerInstance::createPCHExternalASTSource(
   }
 
   Context.setExternalSource(nullptr);
-#endif // HLSL Change Starts - no support for PCH
   return nullptr;
 }
 
@@ -334,42 +334,22 @@ bool FrontendAction::BeginSourceFile(CompilerInstance &CI,
     if (!isModelParsingAction())
       CI.getASTContext().setASTMutationListener(Consumer->GetASTMutationListener());
 
-#if 0 // HLSL Change Starts - no support for AST serialization
-    if (!CI.getPreprocessorOpts().ChainedIncludes.empty()) {
-      // Convert headers to PCH and chain them.
-      IntrusiveRefCntPtr<ExternalSemaSource> source, FinalReader;
-      source = createChainedIncludesSource(CI, FinalReader);
-      if (!source)
-        goto failure;
-      CI.setModuleManager(static_cast<ASTReader *>(FinalReader.get()));
-      CI.getASTContext().setExternalSource(source);
-    } else if (!CI.getPreprocessorOpts().ImplicitPCHInclude.empty()) {
+    // HLSL Change Starts - PCH use is supported for precompiled HLSL prefix
+    // headers; chained includes and deserialization debugging stay disabled.
+    if (!CI.getPreprocessorOpts().ImplicitPCHInclude.empty()) {
       // Use PCH.
       assert(hasPCHSupport() && "This action does not have PCH support!");
       ASTDeserializationListener *DeserialListener =
           Consumer->GetASTDeserializationListener();
-      bool DeleteDeserialListener = false;
-      if (CI.getPreprocessorOpts().DumpDeserializedPCHDecls) {
-        DeserialListener = new DeserializedDeclsDumper(DeserialListener,
-                                                       DeleteDeserialListener);
-        DeleteDeserialListener = true;
-      }
-      if (!CI.getPreprocessorOpts().DeserializedPCHDeclsToErrorOn.empty()) {
-        DeserialListener = new DeserializedDeclsChecker(
-            CI.getASTContext(),
-            CI.getPreprocessorOpts().DeserializedPCHDeclsToErrorOn,
-            DeserialListener, DeleteDeserialListener);
-        DeleteDeserialListener = true;
-      }
       CI.createPCHExternalASTSource(
           CI.getPreprocessorOpts().ImplicitPCHInclude,
           CI.getPreprocessorOpts().DisablePCHValidation,
           CI.getPreprocessorOpts().AllowPCHWithCompilerErrors, DeserialListener,
-          DeleteDeserialListener);
+          /*OwnDeserializationListener*/ false);
       if (!CI.getASTContext().getExternalSource())
         goto failure;
     }
-#endif // HLSL Change Ends - no support for AST serialization
+    // HLSL Change Ends
 
     CI.setASTConsumer(std::move(Consumer));
     if (!CI.hasASTConsumer())
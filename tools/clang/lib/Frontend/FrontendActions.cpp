@@ -81,8 +81,8 @@ DeclContextPrintAction::CreateASTConsumer(CompilerInstance &CI,
   return CreateDeclContextPrinter();
 }
 
-#if 0 // HLSL Change Starts - no support for modules or PCH
-
+// HLSL Change: GeneratePCHAction is enabled to support precompiled HLSL
+// prefix headers; module actions below remain disabled.
 std::unique_ptr<ASTConsumer>
 GeneratePCHAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
   std::string Sysroot;
@@ -131,6 +131,8 @@ raw_pwrite_stream *GeneratePCHAction::ComputeASTConsumerArguments(
   return OS;
 }
 
+#if 0 // HLSL Change Starts - no support for modules
+
 std::unique_ptr<ASTConsumer>
 GenerateModuleAction::CreateASTConsumer(CompilerInstance &CI,
                                         StringRef InFile) {
@@ -1468,10 +1468,177 @@ bool Lexer::tryConsumeIdentifierUTF8Char(const char *&CurPtr) {
   return true;
 }
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// HLSL Change Begin - vectorize the hot skip loops.
+// HLSL sources, and generated ones in particular, are dominated by
+// whitespace, comments and identifiers, so these three loops set the floor
+// under every compile mode, including raw-mode lexing for preprocessing.
+// Each helper classifies sixteen bytes at a time and stops on the first byte
+// the scalar loop it feeds has to look at; the <16-byte tail is always left
+// to the scalar loop, which relies on the NUL terminator.
+#if defined(__SSE2__) || defined(__ARM_NEON)
+
+#ifdef __ARM_NEON
+/// Return the index of the first lane of \p Keep that is zero, or 16 if
+/// every lane is set.
+static inline unsigned firstClearedLane(uint8x16_t Keep) {
+  // Narrowing each 16-bit pair by four bits yields a 64-bit mask with four
+  // bits per input lane; NEON has no movemask.
+  uint64_t Mask = vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Keep), 4)), 0);
+  return llvm::countTrailingZeros(~Mask) / 4;
+}
+#endif
+
+/// Advance over a run of spaces and tabs. Form feed and vertical tab are
+/// rare enough to leave to the caller's per-byte loop.
+static const char *scanSpacesAndTabs(const char *CurPtr,
+                                     const char *BufferEnd) {
+#ifdef __SSE2__
+  const __m128i Spaces = _mm_set1_epi8(' ');
+  const __m128i Tabs = _mm_set1_epi8('\t');
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i Chunk = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Keep = _mm_or_si128(_mm_cmpeq_epi8(Chunk, Spaces),
+                                _mm_cmpeq_epi8(Chunk, Tabs));
+    int Mask = _mm_movemask_epi8(Keep);
+    if (Mask != 0xFFFF) {
+      CurPtr += llvm::countTrailingZeros<unsigned>(~Mask & 0xFFFF);
+      break;
+    }
+    CurPtr += 16;
+  }
+#else
+  const uint8x16_t Spaces = vdupq_n_u8(' ');
+  const uint8x16_t Tabs = vdupq_n_u8('\t');
+  while (CurPtr + 16 <= BufferEnd) {
+    uint8x16_t Chunk = vld1q_u8((const uint8_t *)CurPtr);
+    uint8x16_t Keep =
+        vorrq_u8(vceqq_u8(Chunk, Spaces), vceqq_u8(Chunk, Tabs));
+    unsigned Lane = firstClearedLane(Keep);
+    CurPtr += Lane;
+    if (Lane != 16)
+      break;
+  }
+#endif
+  return CurPtr;
+}
+
+/// Advance to the first NUL, '\n' or '\r' - the only bytes that can end the
+/// fast scan over a line comment's body.
+static const char *scanLineCommentBody(const char *CurPtr,
+                                       const char *BufferEnd) {
+#ifdef __SSE2__
+  const __m128i Nuls = _mm_setzero_si128();
+  const __m128i LFs = _mm_set1_epi8('\n');
+  const __m128i CRs = _mm_set1_epi8('\r');
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i Chunk = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Stop = _mm_or_si128(_mm_cmpeq_epi8(Chunk, Nuls),
+                                _mm_or_si128(_mm_cmpeq_epi8(Chunk, LFs),
+                                             _mm_cmpeq_epi8(Chunk, CRs)));
+    int Mask = _mm_movemask_epi8(Stop);
+    if (Mask != 0) {
+      CurPtr += llvm::countTrailingZeros<unsigned>(Mask);
+      break;
+    }
+    CurPtr += 16;
+  }
+#else
+  const uint8x16_t Nuls = vdupq_n_u8(0);
+  const uint8x16_t LFs = vdupq_n_u8('\n');
+  const uint8x16_t CRs = vdupq_n_u8('\r');
+  while (CurPtr + 16 <= BufferEnd) {
+    uint8x16_t Chunk = vld1q_u8((const uint8_t *)CurPtr);
+    uint8x16_t Keep = vmvnq_u8(vorrq_u8(
+        vceqq_u8(Chunk, Nuls),
+        vorrq_u8(vceqq_u8(Chunk, LFs), vceqq_u8(Chunk, CRs))));
+    unsigned Lane = firstClearedLane(Keep);
+    CurPtr += Lane;
+    if (Lane != 16)
+      break;
+  }
+#endif
+  return CurPtr;
+}
+
+/// Advance over a run of [_A-Za-z0-9]. Bytes with the high bit set compare
+/// as non-members, handing UTF-8 (and '$', '\\', '?') to the slow path.
+static const char *scanIdentifierBody(const char *CurPtr,
+                                      const char *BufferEnd) {
+#ifdef __SSE2__
+  const __m128i LowerBit = _mm_set1_epi8(0x20);
+  const __m128i BelowA = _mm_set1_epi8('a' - 1);
+  const __m128i AboveZ = _mm_set1_epi8('z' + 1);
+  const __m128i Below0 = _mm_set1_epi8('0' - 1);
+  const __m128i Above9 = _mm_set1_epi8('9' + 1);
+  const __m128i Unders = _mm_set1_epi8('_');
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i Chunk = _mm_loadu_si128((const __m128i *)CurPtr);
+    // Folding to lowercase makes one range check cover both alphabet cases;
+    // the signed compares reject bytes >= 0x80 on their own.
+    __m128i Lowered = _mm_or_si128(Chunk, LowerBit);
+    __m128i Alpha = _mm_and_si128(_mm_cmpgt_epi8(Lowered, BelowA),
+                                  _mm_cmpgt_epi8(AboveZ, Lowered));
+    __m128i Digit = _mm_and_si128(_mm_cmpgt_epi8(Chunk, Below0),
+                                  _mm_cmpgt_epi8(Above9, Chunk));
+    __m128i Keep = _mm_or_si128(_mm_or_si128(Alpha, Digit),
+                                _mm_cmpeq_epi8(Chunk, Unders));
+    int Mask = _mm_movemask_epi8(Keep);
+    if (Mask != 0xFFFF) {
+      CurPtr += llvm::countTrailingZeros<unsigned>(~Mask & 0xFFFF);
+      break;
+    }
+    CurPtr += 16;
+  }
+#else
+  const uint8x16_t LowerBit = vdupq_n_u8(0x20);
+  const uint8x16_t CharA = vdupq_n_u8('a');
+  const uint8x16_t CharZ = vdupq_n_u8('z');
+  const uint8x16_t Char0 = vdupq_n_u8('0');
+  const uint8x16_t Char9 = vdupq_n_u8('9');
+  const uint8x16_t Unders = vdupq_n_u8('_');
+  while (CurPtr + 16 <= BufferEnd) {
+    uint8x16_t Chunk = vld1q_u8((const uint8_t *)CurPtr);
+    uint8x16_t Lowered = vorrq_u8(Chunk, LowerBit);
+    uint8x16_t Alpha =
+        vandq_u8(vcgeq_u8(Lowered, CharA), vcleq_u8(Lowered, CharZ));
+    uint8x16_t Digit =
+        vandq_u8(vcgeq_u8(Chunk, Char0), vcleq_u8(Chunk, Char9));
+    uint8x16_t Keep =
+        vorrq_u8(vorrq_u8(Alpha, Digit), vceqq_u8(Chunk, Unders));
+    unsigned Lane = firstClearedLane(Keep);
+    CurPtr += Lane;
+    if (Lane != 16)
+      break;
+  }
+#endif
+  return CurPtr;
+}
+
+#endif // __SSE2__ || __ARM_NEON
+// HLSL Change End - vectorize the hot skip loops.
+
 bool Lexer::LexIdentifier(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched [_A-Za-z$]
   unsigned Size;
   unsigned char C = *CurPtr++;
+  // HLSL Change Begin - bulk-scan the identifier body before the per-byte loop.
+#if defined(__SSE2__) || defined(__ARM_NEON)
+  if (isIdentifierBody(C)) {
+    CurPtr = scanIdentifierBody(CurPtr, BufferEnd);
+    C = *CurPtr++;
+  }
+#endif
+  // HLSL Change End
   while (isIdentifierBody(C))
     C = *CurPtr++;
 
@@ -1975,6 +2142,14 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
 
   // Skip consecutive spaces efficiently.
   while (1) {
+    // HLSL Change Begin - chew through long space/tab runs a chunk at a time.
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    if (Char == ' ' || Char == '\t') {
+      CurPtr = scanSpacesAndTabs(CurPtr, BufferEnd);
+      Char = *CurPtr;
+    }
+#endif
+    // HLSL Change End
     // Skip horizontal whitespace very aggressively.
     while (isHorizontalWhitespace(Char))
       Char = *++CurPtr;
@@ -2051,6 +2226,14 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
   char C;
   do {
     C = *CurPtr;
+    // HLSL Change Begin - scan the comment body a chunk at a time.
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    if (C != 0 && C != '\n' && C != '\r') {
+      CurPtr = scanLineCommentBody(CurPtr, BufferEnd);
+      C = *CurPtr;
+    }
+#endif
+    // HLSL Change End
     // Skip over characters in the fast loop.
     while (C != 0 &&                // Potentially EOF.
            C != '\n' && C != '\r')  // Newline or DOS-style newline.
@@ -2255,12 +2438,8 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
+// HLSL Change - the SSE2/AltiVec includes that used to sit here moved next
+// to the vectorized skip helpers above LexIdentifier.
 
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
@@ -66,6 +66,35 @@ void AlignmentSizeCalculator::alignUsingHLSLRelaxedLayout(
 std::pair<uint32_t, uint32_t> AlignmentSizeCalculator::getAlignmentAndSize(
     QualType type, SpirvLayoutRule rule, llvm::Optional<bool> isRowMajor,
     uint32_t *stride) {
+  // Pack the layout rule and the row-majorness tristate next to the type to
+  // form the cache key.
+  const unsigned majorness =
+      isRowMajor.hasValue() ? (isRowMajor.getValue() ? 2u : 1u) : 0u;
+  const auto key = std::make_pair(
+      type.getAsOpaquePtr(), (static_cast<unsigned>(rule) << 2) | majorness);
+
+  auto found = cache.find(key);
+  if (found != cache.end()) {
+    if (stride)
+      *stride = found->second.stride;
+    return {found->second.alignment, found->second.size};
+  }
+
+  // Compute through a local stride so the value can be replayed on cache hits.
+  // Callers initialize their stride variable to zero before calling, so
+  // writing zero back for types that have no stride is harmless.
+  uint32_t strideValue = 0;
+  const auto result = computeAlignmentAndSize(type, rule, isRowMajor,
+                                              &strideValue);
+  cache[key] = {result.first, result.second, strideValue};
+  if (stride)
+    *stride = strideValue;
+  return result;
+}
+
+std::pair<uint32_t, uint32_t> AlignmentSizeCalculator::computeAlignmentAndSize(
+    QualType type, SpirvLayoutRule rule, llvm::Optional<bool> isRowMajor,
+    uint32_t *stride) {
   // std140 layout rules:
 
   // 1. If the member is a scalar consuming N basic machine units, the base
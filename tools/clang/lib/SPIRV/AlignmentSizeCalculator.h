@@ -12,6 +12,7 @@
 
 #include "dxc/Support/SPIRVOptions.h"
 #include "clang/AST/ASTContext.h"
+#include "llvm/ADT/DenseMap.h"
 
 namespace clang {
 namespace spirv {
@@ -49,6 +50,12 @@ public:
                                    uint32_t *currentOffset);
 
 private:
+  /// Performs the actual recursive layout computation behind
+  /// getAlignmentAndSize, which memoizes the results.
+  std::pair<uint32_t, uint32_t>
+  computeAlignmentAndSize(QualType type, SpirvLayoutRule rule,
+                          llvm::Optional<bool> isRowMajor, uint32_t *stride);
+
   /// Emits error to the diagnostic engine associated with this visitor.
   template <unsigned N>
   DiagnosticBuilder emitError(const char (&message)[N],
@@ -59,8 +66,23 @@ private:
   }
 
 private:
+  /// A memoized layout result, including the stride written through the out
+  /// parameter so cache hits can replay it.
+  struct AlignmentSizeStride {
+    uint32_t alignment;
+    uint32_t size;
+    uint32_t stride;
+  };
+
   ASTContext &astContext;                /// AST context
   const SpirvCodeGenOptions &spvOptions; /// SPIR-V options
+
+  /// Memoized getAlignmentAndSize results, keyed by the type's opaque pointer
+  /// combined with the layout rule and the row-majorness tristate. The same
+  /// types recur for every enclosing struct field, cbuffer member, and raw
+  /// buffer access; since types are immutable for the duration of a compile,
+  /// entries never need invalidation.
+  llvm::DenseMap<std::pair<const void *, unsigned>, AlignmentSizeStride> cache;
 };
 
 } // end namespace spirv
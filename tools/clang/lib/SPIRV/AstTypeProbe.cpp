@@ -13,6 +13,7 @@
 #include "clang/AST/Decl.h"
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/HlslTypes.h"
+#include "llvm/ADT/DenseMap.h"
 
 namespace {
 template <unsigned N>
@@ -860,7 +861,27 @@ bool isAKindOfStructuredOrByteBuffer(QualType type) {
   return false;
 }
 
-bool isOrContainsAKindOfStructuredOrByteBuffer(QualType type) {
+// Memoization for the recursive record-walking predicates below. Structs used
+// for materials and the like can have dozens of fields and get probed
+// thousands of times per compile, so results are cached per canonical Type.
+// The recursive calls go through the public entry points, which populates the
+// caches bottom-up: every nested record gets its own entry on the first walk.
+// The caches must be cleared at the start of each compile (see
+// clearTypeProbeCaches) since a fresh ASTContext may reuse Type addresses;
+// this also keeps isRelaxedPrecisionType's dependency on the 16-bit-types
+// option from leaking across compiles.
+static thread_local llvm::DenseMap<const Type *, bool>
+    containsStructuredOrByteBufferCache;
+static thread_local llvm::DenseMap<const Type *, bool> opaqueStructTypeCache;
+static thread_local llvm::DenseMap<const Type *, bool> relaxedPrecisionCache;
+
+void clearTypeProbeCaches() {
+  containsStructuredOrByteBufferCache.clear();
+  opaqueStructTypeCache.clear();
+  relaxedPrecisionCache.clear();
+}
+
+static bool isOrContainsAKindOfStructuredOrByteBufferImpl(QualType type) {
   if (const RecordType *recordType = type->getAs<RecordType>()) {
     StringRef name = recordType->getDecl()->getName();
     if (name == "StructuredBuffer" || name == "RWStructuredBuffer" ||
@@ -876,6 +897,17 @@ bool isOrContainsAKindOfStructuredOrByteBuffer(QualType type) {
   return false;
 }
 
+bool isOrContainsAKindOfStructuredOrByteBuffer(QualType type) {
+  const Type *canonicalType = type.getCanonicalType().getTypePtr();
+  auto found = containsStructuredOrByteBufferCache.find(canonicalType);
+  if (found != containsStructuredOrByteBufferCache.end())
+    return found->second;
+
+  const bool result = isOrContainsAKindOfStructuredOrByteBufferImpl(type);
+  containsStructuredOrByteBufferCache[canonicalType] = result;
+  return result;
+}
+
 bool isOpaqueType(QualType type) {
   if (const auto *recordType = type->getAs<RecordType>()) {
     const auto name = recordType->getDecl()->getName();
@@ -944,7 +976,7 @@ std::string getHlslResourceTypeName(QualType type) {
   return "";
 }
 
-bool isOpaqueStructType(QualType type) {
+static bool isOpaqueStructTypeImpl(QualType type) {
   if (isOpaqueType(type))
     return false;
 
@@ -958,15 +990,25 @@ bool isOpaqueStructType(QualType type) {
   return false;
 }
 
+bool isOpaqueStructType(QualType type) {
+  const Type *canonicalType = type.getCanonicalType().getTypePtr();
+  auto found = opaqueStructTypeCache.find(canonicalType);
+  if (found != opaqueStructTypeCache.end())
+    return found->second;
+
+  const bool result = isOpaqueStructTypeImpl(type);
+  opaqueStructTypeCache[canonicalType] = result;
+  return result;
+}
+
 bool isOpaqueArrayType(QualType type) {
   if (const auto *arrayType = type->getAsArrayTypeUnsafe())
     return isOpaqueType(arrayType->getElementType());
   return false;
 }
 
-bool isRelaxedPrecisionType(QualType type, const SpirvCodeGenOptions &opts) {
-  if (type.isNull())
-    return false;
+static bool isRelaxedPrecisionTypeImpl(QualType type,
+                                       const SpirvCodeGenOptions &opts) {
 
   // Primitive types
   {
@@ -1019,6 +1061,20 @@ bool isRelaxedPrecisionType(QualType type, const SpirvCodeGenOptions &opts) {
   return false;
 }
 
+bool isRelaxedPrecisionType(QualType type, const SpirvCodeGenOptions &opts) {
+  if (type.isNull())
+    return false;
+
+  const Type *canonicalType = type.getCanonicalType().getTypePtr();
+  auto found = relaxedPrecisionCache.find(canonicalType);
+  if (found != relaxedPrecisionCache.end())
+    return found->second;
+
+  const bool result = isRelaxedPrecisionTypeImpl(type, opts);
+  relaxedPrecisionCache[canonicalType] = result;
+  return result;
+}
+
 /// Returns true if the given type is a bool or vector of bool type.
 bool isBoolOrVecOfBoolType(QualType type) {
   QualType elemType = {};
@@ -9,6 +9,7 @@
 
 #include "DeclResultIdMapper.h"
 
+#include <map>
 #include <sstream>
 
 #include "dxc/DXIL/DxilConstants.h"
@@ -1255,14 +1256,22 @@ private:
 
 /// A class for managing resource bindings to avoid duplicate uses of the same
 /// set and binding number.
+///
+/// Used bindings are kept per set as coalesced [start, one-past-end)
+/// intervals, so a run of implicitly assigned resources collapses into a
+/// single interval instead of one entry per binding number, and finding the
+/// next free chunk only walks the gaps between the explicit bindings rather
+/// than every used number.
 class BindingSet {
 public:
   /// Uses the given set and binding number. Returns false if the binding number
   /// was already occupied in the set, and returns true otherwise.
   bool useBinding(uint32_t binding, uint32_t set) {
-    bool inserted = false;
-    std::tie(std::ignore, inserted) = usedBindings[set].insert(binding);
-    return inserted;
+    auto &intervals = usedBindings[set];
+    if (isUsed(intervals, binding))
+      return false;
+    insertRange(intervals, binding, binding + 1);
+    return true;
   }
 
   /// Uses the next avaiable binding number in |set|. If more than one binding
@@ -1270,50 +1279,62 @@ public:
   /// |numBindingsToUse| in the |set|.
   uint32_t useNextBinding(uint32_t set, uint32_t numBindingsToUse = 1) {
     uint32_t bindingNoStart = getNextBindingChunk(set, numBindingsToUse);
-    auto &binding = usedBindings[set];
-    for (uint32_t i = 0; i < numBindingsToUse; ++i)
-      binding.insert(bindingNoStart + i);
+    insertRange(usedBindings[set], bindingNoStart,
+                bindingNoStart + numBindingsToUse);
     return bindingNoStart;
   }
 
   /// Returns the first available binding number in the |set| for which |n|
   /// consecutive binding numbers are unused.
   uint32_t getNextBindingChunk(uint32_t set, uint32_t n) {
-    auto &existingBindings = usedBindings[set];
-
-    // There were no bindings in this set. Can start at binding zero.
-    if (existingBindings.empty())
-      return 0;
-
-    // Check whether the chunk of |n| binding numbers can be fitted at the
-    // very beginning of the list (start at binding 0 in the current set).
-    uint32_t curBinding = *existingBindings.begin();
-    if (curBinding >= n)
-      return 0;
-
-    auto iter = std::next(existingBindings.begin());
-    while (iter != existingBindings.end()) {
-      // There exists a next binding number that is used. Check to see if the
-      // gap between current binding number and next binding number is large
-      // enough to accommodate |n|.
-      uint32_t nextBinding = *iter;
-      if (n <= nextBinding - curBinding - 1)
-        return curBinding + 1;
+    // Scan the gaps before each used interval; the first one that can hold
+    // |n| bindings wins. Otherwise allocate past the last used binding.
+    uint32_t prevEnd = 0;
+    for (const auto &interval : usedBindings[set]) {
+      if (interval.first - prevEnd >= n)
+        break;
+      prevEnd = interval.second;
+    }
+    return prevEnd;
+  }
 
-      curBinding = nextBinding;
+private:
+  /// Used bindings in one set: interval start -> one-past-end.
+  typedef std::map<uint32_t, uint32_t> IntervalMap;
 
-      // Peek at the next binding that has already been used (if any).
-      ++iter;
+  static bool isUsed(const IntervalMap &intervals, uint32_t binding) {
+    auto iter = intervals.upper_bound(binding);
+    if (iter == intervals.begin())
+      return false;
+    --iter;
+    return binding < iter->second;
+  }
+
+  static void insertRange(IntervalMap &intervals, uint32_t start,
+                          uint32_t end) {
+    // Merge with a preceding interval that touches or overlaps [start, end).
+    auto iter = intervals.upper_bound(start);
+    if (iter != intervals.begin()) {
+      auto prev = iter;
+      --prev;
+      if (prev->second >= start) {
+        start = prev->first;
+        if (prev->second > end)
+          end = prev->second;
+        iter = intervals.erase(prev);
+      }
     }
-
-    // |curBinding| was the last binding that was used in this set. The next
-    // chunk of |n| bindings can start at |curBinding|+1.
-    return curBinding + 1;
+    // Absorb any following intervals that touch or overlap.
+    while (iter != intervals.end() && iter->first <= end) {
+      if (iter->second > end)
+        end = iter->second;
+      iter = intervals.erase(iter);
+    }
+    intervals[start] = end;
   }
 
-private:
-  ///< set number -> set of used binding number
-  llvm::DenseMap<uint32_t, std::set<uint32_t>> usedBindings;
+  ///< set number -> used binding intervals
+  llvm::DenseMap<uint32_t, IntervalMap> usedBindings;
 };
 } // namespace
 
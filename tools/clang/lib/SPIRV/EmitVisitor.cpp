@@ -156,7 +156,11 @@ void EmitVisitor::emitDebugLine(spv::Op op, const SourceLocation &loc) {
 
   auto fileId = debugMainFileId;
   const auto &sm = astContext.getSourceManager();
-  const char *fileName = sm.getPresumedLoc(loc).getFilename();
+  // Decompose the presumed location once; it provides the file name, line,
+  // and column together, and this runs for every emitted instruction.
+  const PresumedLoc presumedLoc = sm.getPresumedLoc(loc);
+  const char *fileName =
+      presumedLoc.isValid() ? presumedLoc.getFilename() : nullptr;
   if (fileName) {
     auto it = debugFileIdMap.find(fileName);
     if (it == debugFileIdMap.end()) {
@@ -174,16 +178,17 @@ void EmitVisitor::emitDebugLine(spv::Op op, const SourceLocation &loc) {
     return;
   }
 
-  uint32_t line = sm.getPresumedLineNumber(loc);
-  uint32_t column = sm.getPresumedColumnNumber(loc);
+  uint32_t line = presumedLoc.isValid() ? presumedLoc.getLine() : 0;
+  uint32_t column = presumedLoc.isValid() ? presumedLoc.getColumn() : 0;
 
   if (!line || !column)
     return;
 
-  if (line == debugLine && column == debugColumn)
+  if (fileId == debugFileId && line == debugLine && column == debugColumn)
     return;
 
-  // We must update these two values to emit the next Opline.
+  // We must update these values to emit the next OpLine.
+  debugFileId = fileId;
   debugLine = line;
   debugColumn = column;
 
@@ -292,6 +297,11 @@ std::vector<uint32_t> EmitVisitor::takeBinary() {
   std::vector<uint32_t> result;
   Header header(takeNextId(), getHeaderVersion(spvOptions.targetEnv));
   auto headerBinary = header.takeBinary();
+  // Concatenate the sections with a single exactly-sized allocation.
+  result.reserve(headerBinary.size() + preambleBinary.size() +
+                 debugFileBinary.size() + debugVariableBinary.size() +
+                 annotationsBinary.size() + typeConstantBinary.size() +
+                 mainBinary.size());
   result.insert(result.end(), headerBinary.begin(), headerBinary.end());
   result.insert(result.end(), preambleBinary.begin(), preambleBinary.end());
   result.insert(result.end(), debugFileBinary.begin(), debugFileBinary.end());
@@ -310,8 +320,20 @@ void EmitVisitor::encodeString(llvm::StringRef value) {
   curInst.insert(curInst.end(), words.begin(), words.end());
 }
 
-bool EmitVisitor::visit(SpirvModule *, Phase) {
-  // No pre-visit operations needed for SpirvModule.
+bool EmitVisitor::visit(SpirvModule *m, Phase phase) {
+  // Pre-size the section buffers from the module's instruction counts so
+  // emission of large modules does not repeatedly reallocate them. SPIR-V
+  // instructions average about four words; types and lazily-created
+  // decorations are not known yet, so their sections get extra headroom.
+  if (phase == Visitor::Phase::Init && m != nullptr) {
+    constexpr size_t kAvgWordsPerInst = 4;
+    size_t fnInstCount = 0;
+    for (SpirvFunction *fn : m->getFunctions())
+      fnInstCount += fn->getInstructionCount();
+    mainBinary.reserve(kAvgWordsPerInst * fnInstCount);
+    typeConstantBinary.reserve(kAvgWordsPerInst * m->getConstantCount() + 256);
+    annotationsBinary.reserve(kAvgWordsPerInst * m->getDecorationCount() + 256);
+  }
   return true;
 }
 
@@ -1222,15 +1244,15 @@ uint32_t EmitTypeHandler::getOrCreateConstantBool(SpirvConstantBoolean *inst) {
 }
 
 uint32_t EmitTypeHandler::getOrCreateConstantNull(SpirvConstantNull *inst) {
-  auto found =
-      std::find_if(emittedConstantNulls.begin(), emittedConstantNulls.end(),
-                   [inst](SpirvConstantNull *cachedConstant) {
-                     return *cachedConstant == *inst;
-                   });
+  // The result type (both the SPIR-V type and the AST type it was lowered
+  // from) fully determines an OpConstantNull, so it serves as the cache key.
+  auto key = std::pair<const SpirvType *, const void *>(
+      inst->getResultType(), inst->getAstResultType().getAsOpaquePtr());
 
+  auto found = emittedConstantNulls.find(key);
   if (found != emittedConstantNulls.end()) {
     // We have already emitted this constant. Reuse.
-    inst->setResultId((*found)->getResultId());
+    inst->setResultId(found->second->getResultId());
   } else {
     // Constant wasn't emitted in the past.
     const uint32_t typeId = emitType(inst->getResultType());
@@ -1239,7 +1261,7 @@ uint32_t EmitTypeHandler::getOrCreateConstantNull(SpirvConstantNull *inst) {
     curTypeInst.push_back(getOrAssignResultId<SpirvInstruction>(inst));
     finalizeTypeInstruction();
     // Remember this constant for the future
-    emittedConstantNulls.push_back(inst);
+    emittedConstantNulls[key] = inst;
   }
 
   return inst->getResultId();
@@ -1420,29 +1442,46 @@ EmitTypeHandler::getOrCreateConstantComposite(SpirvConstantComposite *inst) {
   // SpecConstant instructions are not unique, so we should not re-use existing
   // spec constants.
   const bool isSpecConst = inst->isSpecConstant();
-  SpirvConstantComposite **found = nullptr;
 
-  if (!isSpecConst) {
-    found = std::find_if(
-        emittedConstantComposites.begin(), emittedConstantComposites.end(),
-        [inst](SpirvConstantComposite *cachedConstant) {
-          if (inst->getopcode() != cachedConstant->getopcode())
-            return false;
-          auto instConstituents = inst->getConstituents();
-          auto cachedConstituents = cachedConstant->getConstituents();
-          if (instConstituents.size() != cachedConstituents.size())
-            return false;
-          for (size_t i = 0; i < instConstituents.size(); ++i)
-            if (instConstituents[i]->getResultId() !=
-                cachedConstituents[i]->getResultId())
-              return false;
-          return true;
-        });
+  // Bucket candidates by a hash of the opcode and the constituent result-ids
+  // (all assigned above), then compare exactly within the bucket.
+  auto computeHash = [](SpirvConstantComposite *composite) {
+    auto hashCode =
+        llvm::hash_combine(static_cast<uint32_t>(composite->getopcode()),
+                           composite->getConstituents().size());
+    for (auto constituent : composite->getConstituents())
+      hashCode = llvm::hash_combine(hashCode, constituent->getResultId());
+    return static_cast<uint64_t>(hashCode);
+  };
+  const uint64_t hash = computeHash(inst);
+
+  SpirvConstantComposite *found = nullptr;
+  auto bucket = emittedConstantComposites.find(hash);
+  if (!isSpecConst && bucket != emittedConstantComposites.end()) {
+    for (SpirvConstantComposite *cachedConstant : bucket->second) {
+      if (inst->getopcode() != cachedConstant->getopcode())
+        continue;
+      auto instConstituents = inst->getConstituents();
+      auto cachedConstituents = cachedConstant->getConstituents();
+      if (instConstituents.size() != cachedConstituents.size())
+        continue;
+      bool allMatch = true;
+      for (size_t i = 0; i < instConstituents.size(); ++i)
+        if (instConstituents[i]->getResultId() !=
+            cachedConstituents[i]->getResultId()) {
+          allMatch = false;
+          break;
+        }
+      if (allMatch) {
+        found = cachedConstant;
+        break;
+      }
+    }
   }
 
-  if (!isSpecConst && found != emittedConstantComposites.end()) {
+  if (found != nullptr) {
     // We have already emitted this constant. Reuse.
-    inst->setResultId((*found)->getResultId());
+    inst->setResultId(found->getResultId());
   } else {
     // Constant wasn't emitted in the past.
     const uint32_t typeId = emitType(inst->getResultType());
@@ -1455,7 +1494,7 @@ EmitTypeHandler::getOrCreateConstantComposite(SpirvConstantComposite *inst) {
 
     // Remember this constant for the future (if not a spec constant)
     if (!isSpecConst)
-      emittedConstantComposites.push_back(inst);
+      emittedConstantComposites[hash].push_back(inst);
   }
 
   return inst->getResultId();
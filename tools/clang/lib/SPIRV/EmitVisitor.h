@@ -160,8 +160,13 @@ private:
       emittedConstantInts;
   llvm::DenseMap<std::pair<uint64_t, const SpirvType *>, uint32_t>
       emittedConstantFloats;
-  llvm::SmallVector<SpirvConstantComposite *, 8> emittedConstantComposites;
-  llvm::SmallVector<SpirvConstantNull *, 8> emittedConstantNulls;
+  // Composite constants are bucketed by a hash of their opcode and constituent
+  // result-ids; candidates within a bucket are compared exactly before reuse.
+  llvm::DenseMap<uint64_t, llvm::SmallVector<SpirvConstantComposite *, 2>>
+      emittedConstantComposites;
+  llvm::DenseMap<std::pair<const SpirvType *, const void *>,
+                 SpirvConstantNull *>
+      emittedConstantNulls;
   SpirvConstantBoolean *emittedConstantBools[2];
 
   // emittedTypes is a map that caches the result-id of types in order to avoid
@@ -195,7 +200,7 @@ public:
         typeHandler(astCtx, spvCtx, opts, &debugVariableBinary,
                     &annotationsBinary, &typeConstantBinary,
                     [this]() -> uint32_t { return takeNextId(); }),
-        debugMainFileId(0), debugLine(0), debugColumn(0),
+        debugMainFileId(0), debugFileId(0), debugLine(0), debugColumn(0),
         lastOpWasMergeInst(false) {}
 
   // Visit different SPIR-V constructs for emitting.
@@ -267,6 +272,11 @@ public:
 
 private:
   // Returns the next available result-id.
+  //
+  // Result-ids are only ever allocated here and in EmitTypeHandler, and only
+  // at the point an instruction (or type/constant) is first emitted or
+  // referenced, so the final id space is dense and the header bound is tight
+  // without any post-emission compaction.
   uint32_t takeNextId() { return ++id; }
 
   // There is no guarantee that an instruction or a function or a basic block
@@ -344,10 +354,12 @@ private:
   // Main file information for debugging that will be used by OpLine.
   uint32_t debugMainFileId;
   // One HLSL source line may result in several SPIR-V instructions. In order to
-  // avoid emitting many OpLine instructions with identical line and column
-  // numbers, we record the last line and column number that was used by OpLine,
-  // and only emit a new OpLine when a new line/column in the source is
-  // discovered. The last debug line number information emitted by OpLine.
+  // avoid emitting many OpLine instructions with identical file, line and
+  // column numbers, we record the last file/line/column that was used by
+  // OpLine, and only emit a new OpLine when a new source position is
+  // discovered. The file id last emitted by OpLine.
+  uint32_t debugFileId;
+  // The last debug line number information emitted by OpLine.
   uint32_t debugLine;
   // The last debug column number information emitted by OpLine.
   uint32_t debugColumn;
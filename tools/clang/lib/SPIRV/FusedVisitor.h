@@ -0,0 +1,159 @@
+//===--- FusedVisitor.h - Fused SPIR-V Visitor -------------------*- C++ -*-==//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LIB_SPIRV_FUSEDVISITOR_H
+#define LLVM_CLANG_LIB_SPIRV_FUSEDVISITOR_H
+
+#include "clang/SPIRV/SpirvContext.h"
+#include "clang/SPIRV/SpirvVisitor.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+
+namespace clang {
+namespace spirv {
+
+/// Runs several visitors in a single module traversal instead of one full
+/// walk per visitor.
+///
+/// Every visit is forwarded to the sub-visitors in the order they were given,
+/// so for each instruction the sub-visitors run back to back. Fusing a group
+/// of visitors is therefore only valid when each sub-visitor depends at most
+/// on state that sub-visitors earlier in the list have already established for
+/// the instruction being visited, or that any sub-visitor has established for
+/// instructions earlier in the traversal; a sub-visitor that needs the whole
+/// module processed by a previous pass before it can start must keep its own
+/// traversal. All fused visitors share one traversal direction.
+///
+/// A sub-visitor returning false stops receiving visits for the remainder of
+/// the traversal, matching how a false return aborts a standalone walk. The
+/// fused traversal itself only aborts once every sub-visitor has done so.
+class FusedVisitor : public Visitor {
+public:
+  FusedVisitor(SpirvContext &spvCtx, const SpirvCodeGenOptions &opts,
+               llvm::ArrayRef<Visitor *> subVisitors)
+      : Visitor(opts, spvCtx) {
+    for (auto *subVisitor : subVisitors)
+      visitors.push_back({subVisitor, /*active*/ true});
+  }
+
+  bool visit(SpirvModule *m, Phase phase) override {
+    return forwardPhase(m, phase);
+  }
+  bool visit(SpirvFunction *fn, Phase phase) override {
+    return forwardPhase(fn, phase);
+  }
+  bool visit(SpirvBasicBlock *bb, Phase phase) override {
+    return forwardPhase(bb, phase);
+  }
+
+#define DEFINE_FUSED_VISIT_METHOD(cls)                                         \
+  bool visit(cls *i) override { return forward(i); }
+
+  DEFINE_FUSED_VISIT_METHOD(SpirvCapability)
+  DEFINE_FUSED_VISIT_METHOD(SpirvExtension)
+  DEFINE_FUSED_VISIT_METHOD(SpirvExtInstImport)
+  DEFINE_FUSED_VISIT_METHOD(SpirvMemoryModel)
+  DEFINE_FUSED_VISIT_METHOD(SpirvEntryPoint)
+  DEFINE_FUSED_VISIT_METHOD(SpirvExecutionMode)
+  DEFINE_FUSED_VISIT_METHOD(SpirvString)
+  DEFINE_FUSED_VISIT_METHOD(SpirvSource)
+  DEFINE_FUSED_VISIT_METHOD(SpirvModuleProcessed)
+  DEFINE_FUSED_VISIT_METHOD(SpirvDecoration)
+  DEFINE_FUSED_VISIT_METHOD(SpirvVariable)
+
+  DEFINE_FUSED_VISIT_METHOD(SpirvFunctionParameter)
+  DEFINE_FUSED_VISIT_METHOD(SpirvLoopMerge)
+  DEFINE_FUSED_VISIT_METHOD(SpirvSelectionMerge)
+  DEFINE_FUSED_VISIT_METHOD(SpirvBranching)
+  DEFINE_FUSED_VISIT_METHOD(SpirvBranch)
+  DEFINE_FUSED_VISIT_METHOD(SpirvBranchConditional)
+  DEFINE_FUSED_VISIT_METHOD(SpirvKill)
+  DEFINE_FUSED_VISIT_METHOD(SpirvReturn)
+  DEFINE_FUSED_VISIT_METHOD(SpirvSwitch)
+  DEFINE_FUSED_VISIT_METHOD(SpirvUnreachable)
+
+  DEFINE_FUSED_VISIT_METHOD(SpirvAccessChain)
+  DEFINE_FUSED_VISIT_METHOD(SpirvAtomic)
+  DEFINE_FUSED_VISIT_METHOD(SpirvBarrier)
+  DEFINE_FUSED_VISIT_METHOD(SpirvBinaryOp)
+  DEFINE_FUSED_VISIT_METHOD(SpirvBitFieldExtract)
+  DEFINE_FUSED_VISIT_METHOD(SpirvBitFieldInsert)
+  DEFINE_FUSED_VISIT_METHOD(SpirvConstantBoolean)
+  DEFINE_FUSED_VISIT_METHOD(SpirvConstantInteger)
+  DEFINE_FUSED_VISIT_METHOD(SpirvConstantFloat)
+  DEFINE_FUSED_VISIT_METHOD(SpirvConstantComposite)
+  DEFINE_FUSED_VISIT_METHOD(SpirvConstantNull)
+  DEFINE_FUSED_VISIT_METHOD(SpirvCompositeConstruct)
+  DEFINE_FUSED_VISIT_METHOD(SpirvCompositeExtract)
+  DEFINE_FUSED_VISIT_METHOD(SpirvCompositeInsert)
+  DEFINE_FUSED_VISIT_METHOD(SpirvEmitVertex)
+  DEFINE_FUSED_VISIT_METHOD(SpirvEndPrimitive)
+  DEFINE_FUSED_VISIT_METHOD(SpirvExtInst)
+  DEFINE_FUSED_VISIT_METHOD(SpirvFunctionCall)
+  DEFINE_FUSED_VISIT_METHOD(SpirvNonUniformBinaryOp)
+  DEFINE_FUSED_VISIT_METHOD(SpirvNonUniformElect)
+  DEFINE_FUSED_VISIT_METHOD(SpirvNonUniformUnaryOp)
+  DEFINE_FUSED_VISIT_METHOD(SpirvImageOp)
+  DEFINE_FUSED_VISIT_METHOD(SpirvImageQuery)
+  DEFINE_FUSED_VISIT_METHOD(SpirvImageSparseTexelsResident)
+  DEFINE_FUSED_VISIT_METHOD(SpirvImageTexelPointer)
+  DEFINE_FUSED_VISIT_METHOD(SpirvLoad)
+  DEFINE_FUSED_VISIT_METHOD(SpirvCopyObject)
+  DEFINE_FUSED_VISIT_METHOD(SpirvSampledImage)
+  DEFINE_FUSED_VISIT_METHOD(SpirvSelect)
+  DEFINE_FUSED_VISIT_METHOD(SpirvSpecConstantBinaryOp)
+  DEFINE_FUSED_VISIT_METHOD(SpirvSpecConstantUnaryOp)
+  DEFINE_FUSED_VISIT_METHOD(SpirvStore)
+  DEFINE_FUSED_VISIT_METHOD(SpirvUnaryOp)
+  DEFINE_FUSED_VISIT_METHOD(SpirvVectorShuffle)
+  DEFINE_FUSED_VISIT_METHOD(SpirvArrayLength)
+  DEFINE_FUSED_VISIT_METHOD(SpirvRayTracingOpNV)
+  DEFINE_FUSED_VISIT_METHOD(SpirvDemoteToHelperInvocationEXT)
+  DEFINE_FUSED_VISIT_METHOD(SpirvRayQueryOpKHR)
+#undef DEFINE_FUSED_VISIT_METHOD
+
+private:
+  struct SubVisitor {
+    Visitor *visitor;
+    bool active;
+  };
+
+  template <typename T> bool forward(T *i) {
+    bool anyActive = false;
+    for (auto &sub : visitors) {
+      if (!sub.active)
+        continue;
+      if (sub.visitor->visit(i))
+        anyActive = true;
+      else
+        sub.active = false;
+    }
+    return anyActive;
+  }
+
+  template <typename T> bool forwardPhase(T *construct, Phase phase) {
+    bool anyActive = false;
+    for (auto &sub : visitors) {
+      if (!sub.active)
+        continue;
+      if (sub.visitor->visit(construct, phase))
+        anyActive = true;
+      else
+        sub.active = false;
+    }
+    return anyActive;
+  }
+
+  llvm::SmallVector<SubVisitor, 8> visitors;
+};
+
+} // end namespace spirv
+} // end namespace clang
+
+#endif // LLVM_CLANG_LIB_SPIRV_FUSEDVISITOR_H
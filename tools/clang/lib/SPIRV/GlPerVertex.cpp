@@ -123,7 +123,70 @@ bool GlPerVertex::recordGlPerVertexDeclFacts(const DeclaratorDecl *decl,
     return true;
   }
 
-  return doGlPerVertexFacts(decl, type, asInput);
+  // The analysis is deferred to calculateClipCullDistanceArraySize(), which
+  // skips it for the common case of signatures without clip/cull usage.
+  recordedDecls.push_back(std::make_pair(decl, asInput));
+  return true;
+}
+
+GlPerVertex::ClipCullScan
+GlPerVertex::scanForClipCullSemantic(const DeclaratorDecl *decl,
+                                     QualType baseType) {
+  llvm::StringRef semanticStr;
+  const hlsl::Semantic *semantic = {};
+  uint32_t semanticIndex = {};
+
+  // Mirrors the traversal in doGlPerVertexFacts(), but only answers whether
+  // the declaration can involve SV_ClipDistance/SV_CullDistance at all; all
+  // validation (and its diagnostics) stays in the full analysis.
+  if (getStageVarSemantic(decl, &semanticStr, &semantic, &semanticIndex)) {
+    switch (semantic->GetKind()) {
+    case hlsl::Semantic::Kind::ClipDistance:
+    case hlsl::Semantic::Kind::CullDistance:
+      return ClipCullScan::Found;
+    default:
+      return ClipCullScan::None;
+    }
+  }
+
+  if (baseType->isStructureType()) {
+    const Type *structType = baseType->getAs<RecordType>();
+    auto cached = scanCache.find(structType);
+    if (cached != scanCache.end())
+      return cached->second;
+
+    ClipCullScan result = ClipCullScan::None;
+    for (const auto *field :
+         baseType->getAs<RecordType>()->getDecl()->fields()) {
+      const ClipCullScan fieldScan =
+          scanForClipCullSemantic(field, field->getType());
+      if (fieldScan == ClipCullScan::Found) {
+        result = fieldScan;
+        break;
+      }
+      if (fieldScan == ClipCullScan::Unknown)
+        result = fieldScan;
+    }
+    scanCache[structType] = result;
+    return result;
+  }
+
+  if (hlsl::IsHLSLInputPatchType(baseType))
+    return scanForClipCullSemantic(decl,
+                                   hlsl::GetHLSLInputPatchElementType(baseType));
+  if (hlsl::IsHLSLOutputPatchType(baseType) ||
+      hlsl::IsHLSLStreamOutputType(baseType))
+    return scanForClipCullSemantic(
+        decl, hlsl::GetHLSLOutputPatchElementType(baseType));
+  if (hasGSPrimitiveTypeQualifier(decl) || decl->hasAttr<HLSLVerticesAttr>() ||
+      decl->hasAttr<HLSLPrimitivesAttr>()) {
+    if (const auto *arrayType = astContext.getAsConstantArrayType(baseType))
+      return scanForClipCullSemantic(decl, arrayType->getElementType());
+  }
+
+  // No semantic attached and not a shape the scan understands. The full
+  // analysis diagnoses this case, so it must run.
+  return ClipCullScan::Unknown;
 }
 
 bool GlPerVertex::doGlPerVertexFacts(const DeclaratorDecl *decl,
@@ -284,7 +347,35 @@ bool GlPerVertex::doGlPerVertexFacts(const DeclaratorDecl *decl,
   return false;
 }
 
-void GlPerVertex::calculateClipCullDistanceArraySize() {
+bool GlPerVertex::calculateClipCullDistanceArraySize() {
+  // Cheap pre-scan: the vast majority of shaders declare no
+  // SV_ClipDistance/SV_CullDistance, and for them the recorded declarations
+  // need no analysis at all. The scan is conservative: any declaration it
+  // cannot classify forces the full walk so diagnostics are unchanged.
+  bool needsAnalysis = false;
+  for (const auto &recorded : recordedDecls) {
+    if (scanForClipCullSemantic(recorded.first,
+                                getTypeOrFnRetType(recorded.first)) !=
+        ClipCullScan::None) {
+      needsAnalysis = true;
+      break;
+    }
+  }
+
+  if (needsAnalysis) {
+    // Walk the declarations in recording order: the precise flags and
+    // semantic strings depend on it.
+    for (const auto &recorded : recordedDecls) {
+      if (!doGlPerVertexFacts(recorded.first,
+                              getTypeOrFnRetType(recorded.first),
+                              recorded.second)) {
+        recordedDecls.clear();
+        return false;
+      }
+    }
+  }
+  recordedDecls.clear();
+
   // Updates the offset map and array size for the given input/output
   // SV_ClipDistance/SV_CullDistance.
   const auto updateSizeAndOffset = [](const SemanticIndexToTypeMap &typeMap,
@@ -324,6 +415,7 @@ void GlPerVertex::calculateClipCullDistanceArraySize() {
   updateSizeAndOffset(inCullType, &inCullOffset, &inCullArraySize);
   updateSizeAndOffset(outClipType, &outClipOffset, &outClipArraySize);
   updateSizeAndOffset(outCullType, &outCullOffset, &outCullArraySize);
+  return true;
 }
 
 SpirvVariable *GlPerVertex::createClipCullDistanceVar(bool asInput, bool isClip,
@@ -44,13 +44,19 @@ public:
   GlPerVertex(ASTContext &context, SpirvContext &spvContext,
               SpirvBuilder &spvBuilder);
 
-  /// Records a declaration of SV_ClipDistance/SV_CullDistance so later
-  /// we can caculate the ClipDistance/CullDistance array layout.
-  /// Also records the semantic strings provided for them.
+  /// Records a declaration that may contain SV_ClipDistance/SV_CullDistance
+  /// so later we can caculate the ClipDistance/CullDistance array layout.
+  /// The recorded declarations are only analyzed in
+  /// calculateClipCullDistanceArraySize(), so this is cheap to call for
+  /// every entry point parameter.
   bool recordGlPerVertexDeclFacts(const DeclaratorDecl *decl, bool asInput);
 
-  /// Calculates the layout for ClipDistance/CullDistance arrays.
-  void calculateClipCullDistanceArraySize();
+  /// Calculates the layout for ClipDistance/CullDistance arrays from the
+  /// declarations recorded by recordGlPerVertexDeclFacts(). The analysis is
+  /// skipped entirely when a cheap cached scan over the recorded signature
+  /// finds no SV_ClipDistance/SV_CullDistance usage. Returns false if the
+  /// recorded declarations use those semantics incorrectly.
+  bool calculateClipCullDistanceArraySize();
 
   /// Emits SPIR-V code for the input and/or ouput ClipDistance/CullDistance
   /// builtin variables. If inputArrayLength is not zero, the input variable
@@ -127,6 +133,17 @@ private:
   bool doGlPerVertexFacts(const DeclaratorDecl *decl, QualType type,
                           bool asInput);
 
+  /// Result of the cheap pre-scan over a recorded declaration: whether it
+  /// declares SV_ClipDistance/SV_CullDistance (Found), provably does not
+  /// (None), or has a shape the scan does not understand (Unknown), in which
+  /// case the full analysis must run so its diagnostics are preserved.
+  enum class ClipCullScan { None, Found, Unknown };
+
+  /// Cheaply scans the given declaration for SV_ClipDistance/SV_CullDistance
+  /// usage, caching the verdict for struct types.
+  ClipCullScan scanForClipCullSemantic(const DeclaratorDecl *decl,
+                                       QualType baseType);
+
 private:
   using SemanticIndexToTypeMap = llvm::DenseMap<uint32_t, QualType>;
   using SemanticIndexToArrayOffsetMap = llvm::DenseMap<uint32_t, uint32_t>;
@@ -170,6 +187,12 @@ private:
   /// builtins in gl_PerVertex.
   llvm::SmallVector<std::string, kSemanticStrCount> inSemanticStrs;
   llvm::SmallVector<std::string, kSemanticStrCount> outSemanticStrs;
+
+  /// Declarations recorded by recordGlPerVertexDeclFacts(), analyzed
+  /// lazily in calculateClipCullDistanceArraySize(). The bool is asInput.
+  llvm::SmallVector<std::pair<const DeclaratorDecl *, bool>, 4> recordedDecls;
+  /// Pre-scan verdicts per struct type, see scanForClipCullSemantic().
+  llvm::DenseMap<const Type *, ClipCullScan> scanCache;
 };
 
 } // end namespace spirv
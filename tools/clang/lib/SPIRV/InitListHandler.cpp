@@ -31,6 +31,7 @@ SpirvInstruction *InitListHandler::processInit(const InitListExpr *expr) {
   initializers.clear();
   scalars.clear();
 
+  initializers.reserve(countFlattenedInits(expr));
   flatten(expr);
   // Reverse the whole initializer list so we can manipulate the list at the
   // tail of the vector. This is more efficient than using a deque.
@@ -81,6 +82,25 @@ void InitListHandler::flatten(const InitListExpr *expr) {
   }
 }
 
+uint32_t InitListHandler::countFlattenedInits(const InitListExpr *expr) const {
+  const auto numInits = expr->getNumInits();
+  uint32_t count = 0;
+
+  for (uint32_t i = 0; i < numInits; ++i) {
+    const Expr *init = expr->getInit(i);
+    if (const auto *subInitList = dyn_cast<InitListExpr>(init)) {
+      count += countFlattenedInits(subInitList);
+    } else if (const auto *subInitList = dyn_cast<InitListExpr>(
+                   init->IgnoreParenNoopCasts(theEmitter.getASTContext()))) {
+      count += countFlattenedInits(subInitList);
+    } else {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
 // Note that we cannot use inst->getSourceLocation() for OpCompositeExtract.
 // For example, float3(sign(v4f.xyz - 2 * v4f.xyz)) is InitListExpr and the
 // result of "sign(v4f.xyz - 2 * v4f.xyz)" has its location as the start
@@ -139,19 +159,22 @@ bool InitListHandler::tryToSplitStruct() {
 
   const auto *structDecl = initType->getAsStructureType()->getDecl();
 
-  // Create MemberExpr for each field of the struct
-  llvm::SmallVector<SpirvInstruction *, 4> fields;
+  // Extract each field and push them in the reverse order, so that the first
+  // field ends up at the tail of |initializers|. The extracts are created in
+  // declaration order but written directly into pre-grown slots; this avoids
+  // staging them in a temporary vector and copying it for every nesting level.
+  const size_t base = initializers.size();
+  const size_t numFields =
+      std::distance(structDecl->field_begin(), structDecl->field_end());
+  initializers.resize(base + numFields);
   uint32_t i = 0;
   for (auto *field : structDecl->fields()) {
     auto *extract =
         spvBuilder.createCompositeExtract(field->getType(), init, {i}, loc);
-    fields.push_back(extract);
+    initializers[base + numFields - 1 - i] = extract;
     ++i;
   }
 
-  // Push in the reverse order
-  initializers.insert(initializers.end(), fields.rbegin(), fields.rend());
-
   return true;
 }
 
@@ -175,18 +198,19 @@ bool InitListHandler::tryToSplitConstantArray() {
   // TODO: handle (unlikely) extra large array size?
   const auto size = static_cast<uint32_t>(arrayType->getSize().getZExtValue());
 
-  // Create ArraySubscriptExpr for each element of the array
+  // Extract each element and push them in the reverse order. As with
+  // tryToSplitStruct(), the extracts are created in index order but written
+  // directly into pre-grown slots; for large arrays this removes a full copy
+  // of the element list per nesting level.
   // TODO: It will generate lots of elements if the array size is very large.
   // But do we have a better solution?
-  llvm::SmallVector<SpirvInstruction *, 4> elements;
+  const size_t base = initializers.size();
+  initializers.resize(base + size);
   for (uint32_t i = 0; i < size; ++i) {
     auto *extract = spvBuilder.createCompositeExtract(elemType, init, {i}, loc);
-    elements.push_back(extract);
+    initializers[base + size - 1 - i] = extract;
   }
 
-  // Push in the reverse order
-  initializers.insert(initializers.end(), elements.rbegin(), elements.rend());
-
   return true;
 }
 
@@ -109,6 +109,11 @@ private:
   /// into |initializers|.
   void flatten(const InitListExpr *expr);
 
+  /// Returns the number of SPIR-V instructions flatten() will put into
+  /// |initializers| for the given InitListExpr, so that the vector can be
+  /// sized up front instead of grown by repeated reallocation.
+  uint32_t countFlattenedInits(const InitListExpr *expr) const;
+
   /// Decomposes the given SpirvInstruction and puts all elements into the end
   /// of the scalars queue.
   void decompose(SpirvInstruction *inst, const SourceLocation &loc);
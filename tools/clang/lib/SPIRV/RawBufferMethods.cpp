@@ -185,6 +185,48 @@ SpirvInstruction *RawBufferHandler::load16BitsAtBitOffset16(
   return result;
 }
 
+void RawBufferHandler::load16BitsPairAtBitOffset0(SpirvInstruction *buffer,
+                                                  SpirvInstruction *&index,
+                                                  QualType target16BitType,
+                                                  SpirvInstruction *&lsbResult,
+                                                  SpirvInstruction *&msbResult) {
+  const auto loc = buffer->getSourceLocation();
+  auto *constUint0 =
+      spvBuilder.getConstantInt(astContext.UnsignedIntTy, llvm::APInt(32, 0));
+  auto *constUint1 =
+      spvBuilder.getConstantInt(astContext.UnsignedIntTy, llvm::APInt(32, 1));
+  auto *constUint16 =
+      spvBuilder.getConstantInt(astContext.UnsignedIntTy, llvm::APInt(32, 16));
+
+  // Load the underlying 32-bit word once; both 16-bit halves come out of it.
+  auto *ptr = spvBuilder.createAccessChain(astContext.UnsignedIntTy, buffer,
+                                           {constUint0, index}, loc);
+  auto *word = spvBuilder.createLoad(astContext.UnsignedIntTy, ptr, loc);
+
+  // The lower 16 bits. OpUConvert performs the truncation.
+  lsbResult = spvBuilder.createUnaryOp(spv::Op::OpUConvert,
+                                       astContext.UnsignedShortTy, word, loc);
+  lsbResult = bitCastToNumericalOrBool(lsbResult, astContext.UnsignedShortTy,
+                                       target16BitType, loc);
+  lsbResult->setRValue();
+
+  // The upper 16 bits.
+  msbResult = spvBuilder.createBinaryOp(spv::Op::OpShiftRightLogical,
+                                        astContext.UnsignedIntTy, word,
+                                        constUint16, loc);
+  msbResult = spvBuilder.createUnaryOp(spv::Op::OpUConvert,
+                                       astContext.UnsignedShortTy, msbResult,
+                                       loc);
+  msbResult = bitCastToNumericalOrBool(msbResult, astContext.UnsignedShortTy,
+                                       target16BitType, loc);
+  msbResult->setRValue();
+
+  // A full word has been consumed. The next load should be done at *the next
+  // base index* at bit-offset 0.
+  index = spvBuilder.createBinaryOp(spv::Op::OpIAdd, astContext.UnsignedIntTy,
+                                    index, constUint1, loc);
+}
+
 SpirvInstruction *RawBufferHandler::processTemplatedLoadFromBuffer(
     SpirvInstruction *buffer, SpirvInstruction *&index,
     const QualType targetType, uint32_t &bitOffset) {
@@ -260,9 +302,35 @@ SpirvInstruction *RawBufferHandler::processTemplatedLoadFromBuffer(
     uint32_t elemCount = 0;
     if (isVectorType(targetType, &elemType, &elemCount)) {
       llvm::SmallVector<SpirvInstruction *, 4> loadedElems;
-      for (uint32_t i = 0; i < elemCount; ++i) {
-        loadedElems.push_back(
-            processTemplatedLoadFromBuffer(buffer, index, elemType, bitOffset));
+      const auto elemWidth = getElementSpirvBitwidth(
+          astContext, elemType,
+          theEmitter.getSpirvOptions().enable16BitTypes);
+      if (elemWidth == 16) {
+        // Consecutive 16-bit elements are contiguous in the underlying uint
+        // words, so load each fully-covered word once and extract both halves
+        // instead of re-loading the word for the element at bit-offset 16.
+        // A misaligned head or a dangling tail element still takes the
+        // scalar path.
+        uint32_t i = 0;
+        if (bitOffset == 16) {
+          loadedElems.push_back(
+              load16BitsAtBitOffset16(buffer, index, elemType, bitOffset));
+          ++i;
+        }
+        for (; i + 1 < elemCount; i += 2) {
+          SpirvInstruction *lsb = nullptr, *msb = nullptr;
+          load16BitsPairAtBitOffset0(buffer, index, elemType, lsb, msb);
+          loadedElems.push_back(lsb);
+          loadedElems.push_back(msb);
+        }
+        if (i < elemCount)
+          loadedElems.push_back(
+              load16BitsAtBitOffset0(buffer, index, elemType, bitOffset));
+      } else {
+        for (uint32_t i = 0; i < elemCount; ++i) {
+          loadedElems.push_back(processTemplatedLoadFromBuffer(
+              buffer, index, elemType, bitOffset));
+        }
       }
       result =
           spvBuilder.createCompositeConstruct(targetType, loadedElems, loc);
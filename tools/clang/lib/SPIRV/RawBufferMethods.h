@@ -80,6 +80,17 @@ private:
                                             QualType target16BitType,
                                             uint32_t &bitOffset);
 
+  /// \brief Loads two consecutive 16-bit values that share the 32-bit word
+  /// at the given index. The underlying word is loaded only once and both
+  /// halves are extracted from it, rather than re-loading the word for the
+  /// half at bit-offset 16. On return, |index| has been advanced past the
+  /// consumed word.
+  void load16BitsPairAtBitOffset0(SpirvInstruction *buffer,
+                                  SpirvInstruction *&index,
+                                  QualType target16BitType,
+                                  SpirvInstruction *&lsbResult,
+                                  SpirvInstruction *&msbResult);
+
 private:
   void store16BitsAtBitOffset0(SpirvInstruction *value,
                                SpirvInstruction *buffer,
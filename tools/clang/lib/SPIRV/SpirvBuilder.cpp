@@ -10,6 +10,7 @@
 #include "clang/SPIRV/SpirvBuilder.h"
 #include "CapabilityVisitor.h"
 #include "EmitVisitor.h"
+#include "FusedVisitor.h"
 #include "LiteralTypeVisitor.h"
 #include "LowerTypeVisitor.h"
 #include "NonUniformVisitor.h"
@@ -1039,26 +1040,58 @@ void SpirvBuilder::decoratePerTaskNV(SpirvInstruction *target, uint32_t offset,
 
 SpirvConstant *SpirvBuilder::getConstantInt(QualType type, llvm::APInt value,
                                             bool specConst) {
-  // We do not reuse existing constant integers. Just create a new one.
+  // Literal-typed constants stay unshared: LiteralTypeVisitor deduces their
+  // real type from each use and rewrites the instruction in place. Spec
+  // constants stay unshared because each carries its own SpecId decoration.
+  const bool bCacheable = !specConst && !isLitTypeOrVecOfLitType(type);
+  const auto cacheKey = std::make_pair(type.getAsOpaquePtr(),
+                                       value.getZExtValue());
+  if (bCacheable) {
+    auto it = integerConstants.find(cacheKey);
+    if (it != integerConstants.end())
+      return it->second;
+  }
   auto *intConst = new (context) SpirvConstantInteger(type, value, specConst);
   mod->addConstant(intConst);
+  if (bCacheable) {
+    // A shared constant must look the same to every call site, including the
+    // ones that mark their copy as an rvalue; constants always are.
+    intConst->setRValue();
+    integerConstants[cacheKey] = intConst;
+  }
   return intConst;
 }
 
 SpirvConstant *SpirvBuilder::getConstantFloat(QualType type,
                                               llvm::APFloat value,
                                               bool specConst) {
-  // We do not reuse existing constant floats. Just create a new one.
+  const bool bCacheable = !specConst && !isLitTypeOrVecOfLitType(type);
+  const auto cacheKey = std::make_pair(
+      type.getAsOpaquePtr(), value.bitcastToAPInt().getZExtValue());
+  if (bCacheable) {
+    auto it = floatConstants.find(cacheKey);
+    if (it != floatConstants.end())
+      return it->second;
+  }
   auto *floatConst = new (context) SpirvConstantFloat(type, value, specConst);
   mod->addConstant(floatConst);
+  if (bCacheable) {
+    floatConst->setRValue();
+    floatConstants[cacheKey] = floatConst;
+  }
   return floatConst;
 }
 
 SpirvConstant *SpirvBuilder::getConstantBool(bool value, bool specConst) {
-  // We do not care about making unique constants at this point.
+  if (!specConst && boolConstants[value ? 1 : 0] != nullptr)
+    return boolConstants[value ? 1 : 0];
   auto *boolConst =
       new (context) SpirvConstantBoolean(astContext.BoolTy, value, specConst);
   mod->addConstant(boolConst);
+  if (!specConst) {
+    boolConst->setRValue();
+    boolConstants[value ? 1 : 0] = boolConst;
+  }
   return boolConst;
 }
 
@@ -1074,9 +1107,13 @@ SpirvBuilder::getConstantComposite(QualType compositeType,
 }
 
 SpirvConstant *SpirvBuilder::getConstantNull(QualType type) {
-  // We do not care about making unique constants at this point.
+  auto it = nullConstants.find(type.getAsOpaquePtr());
+  if (it != nullConstants.end())
+    return it->second;
   auto *nullConst = new (context) SpirvConstantNull(type);
   mod->addConstant(nullConst);
+  nullConst->setRValue();
+  nullConstants[type.getAsOpaquePtr()] = nullConst;
   return nullConst;
 }
 
@@ -1107,25 +1144,28 @@ std::vector<uint32_t> SpirvBuilder::takeModule() {
 
   mod->invokeVisitor(&literalTypeVisitor, true);
 
-  // Propagate NonUniform decorations
-  mod->invokeVisitor(&nonUniformVisitor);
-
-  // Lower types
-  mod->invokeVisitor(&lowerTypeVisitor);
-
-  // Add necessary capabilities and extensions
-  mod->invokeVisitor(&capabilityVisitor);
-
-  // Propagate RelaxedPrecision decorations
-  mod->invokeVisitor(&relaxedPrecisionVisitor);
+  // Run the forward per-instruction passes fused into a single module
+  // traversal:
+  // - Propagate NonUniform decorations
+  // - Lower types
+  // - Add necessary capabilities and extensions
+  // - Propagate RelaxedPrecision decorations
+  // - Remove BufferBlock decoration if necessary (this decoration is
+  //   deprecated after SPIR-V 1.3)
+  // The list order preserves the relative order of the previously separate
+  // walks: each of these passes only depends on what the passes before it in
+  // the list have already done for the instruction being visited (e.g. the
+  // capability visitor inspects lowered result types and NonUniform flags) or
+  // for instructions earlier in the traversal.
+  Visitor *fusedPasses[] = {&nonUniformVisitor, &lowerTypeVisitor,
+                            &capabilityVisitor, &relaxedPrecisionVisitor,
+                            &removeBufferBlockVisitor};
+  FusedVisitor fusedVisitor(context, spirvOptions, fusedPasses);
+  mod->invokeVisitor(&fusedVisitor);
 
   // Propagate NoContraction decorations
   mod->invokeVisitor(&preciseVisitor, true);
 
-  // Remove BufferBlock decoration if necessary (this decoration is deprecated
-  // after SPIR-V 1.3).
-  mod->invokeVisitor(&removeBufferBlockVisitor);
-
   // Emit SPIR-V
   mod->invokeVisitor(&emitVisitor);
 
@@ -27,6 +27,32 @@ SpirvContext::SpirvContext()
   rayQueryProvisionalTypeKHR = new (this) RayQueryProvisionalTypeKHR;
 }
 
+void SpirvContext::reset() {
+  // Drop every cached pointer before releasing the memory backing it.
+  sintTypes.fill(nullptr);
+  uintTypes.fill(nullptr);
+  floatTypes.fill(nullptr);
+  vecTypes.clear();
+  matTypes.clear();
+  imageTypes.clear();
+  sampledImageTypes.clear();
+  arrayTypes.clear();
+  runtimeArrayTypes.clear();
+  structTypes.clear();
+  pointerTypes.clear();
+  functionTypes.clear();
+
+  // Return all slabs to the allocator in bulk; SPIR-V entity objects are
+  // never destructed individually (see the allocator field comment).
+  allocator.Reset();
+
+  voidType = new (this) VoidType;
+  boolType = new (this) BoolType;
+  samplerType = new (this) SamplerType;
+  accelerationStructureTypeNV = new (this) AccelerationStructureTypeNV;
+  rayQueryProvisionalTypeKHR = new (this) RayQueryProvisionalTypeKHR;
+}
+
 inline uint32_t log2ForBitwidth(uint32_t bitwidth) {
   assert(bitwidth >= 16 && bitwidth <= 64 && llvm::isPowerOf2_32(bitwidth));
 
@@ -98,20 +124,16 @@ const SpirvType *SpirvContext::getMatrixType(const SpirvType *elemType,
   auto foundVec = matTypes.find(vecType);
 
   if (foundVec != matTypes.end()) {
-    const auto &matVector = foundVec->second;
-    // Create a temporary object for finding in the vector.
-    MatrixType type(vecType, count);
-
-    for (const auto *cachedType : matVector)
-      if (type == *cachedType)
-        return cachedType;
+    auto &type = foundVec->second[count];
+    if (type != nullptr)
+      return type;
+  } else {
+    // Make sure to initialize since std::array is "an aggregate type with the
+    // same semantics as a struct holding a C-style array T[N]".
+    matTypes[vecType] = {};
   }
 
-  const auto *ptr = new (this) MatrixType(vecType, count);
-
-  matTypes[vecType].push_back(ptr);
-
-  return ptr;
+  return matTypes[vecType][count] = new (this) MatrixType(vecType, count);
 }
 
 const ImageType *SpirvContext::getImageType(const SpirvType *sampledType,
@@ -191,17 +213,14 @@ SpirvContext::getStructType(llvm::ArrayRef<StructType::FieldInfo> fields,
 
   StructType type(fields, name, isReadOnly, interfaceType);
 
-  auto found = std::find_if(
-      structTypes.begin(), structTypes.end(),
-      [&type](const StructType *cachedType) { return type == *cachedType; });
-
+  auto found = structTypes.find(&type);
   if (found != structTypes.end())
     return *found;
 
-  structTypes.push_back(
+  auto inserted = structTypes.insert(
       new (this) StructType(fields, name, isReadOnly, interfaceType));
 
-  return structTypes.back();
+  return *(inserted.first);
 }
 
 const HybridStructType *SpirvContext::getHybridStructType(
@@ -24,6 +24,10 @@
 #include "InitListHandler.h"
 #include "dxc/DXIL/DxilConstants.h"
 
+#include <map>
+#include <memory>
+#include <mutex>
+
 #ifdef SUPPORT_QUERY_GIT_COMMIT_INFO
 #include "clang/Basic/Version.h"
 #else
@@ -143,9 +147,93 @@ bool isReferencingNonAliasStructuredOrByteBuffer(const Expr *expr) {
   return false;
 }
 
+/// Process-lifetime cache of constructed SPIRV-Tools entry points.
+///
+/// Creating a spvtools::Optimizer (or spvtools::SpirvTools) builds a fresh
+/// SPIRV-Tools context and, for optimizers, re-registers every pass and its
+/// analysis setup. None of that depends on the module being compiled -- only
+/// on the target environment and the options that select the pass list -- so
+/// repeating it per compile is pure overhead in a long-lived process. The
+/// cache keeps one instance per distinct configuration and reuses it.
+///
+/// All access goes through the cache mutex. This also serializes Run() and
+/// Validate() calls on a cached instance, which is required anyway because
+/// the message consumer is rebound to the caller's message buffer each call.
+///
+/// Reset point: reset() drops every cached context. It must only be called
+/// when no compile is in flight; the intended use is immediately before the
+/// compiler library is unloaded from a host process.
+class SpirvToolsCache {
+public:
+  static SpirvToolsCache &get() {
+    static SpirvToolsCache instance;
+    return instance;
+  }
+
+  std::mutex &getMutex() { return mutex; }
+
+  /// Returns the legalization optimizer for the given target environment,
+  /// constructing and registering its passes on first use.
+  /// The cache mutex must be held.
+  spvtools::Optimizer &getLegalizer(spv_target_env env) {
+    std::unique_ptr<spvtools::Optimizer> &optimizer = legalizers[env];
+    if (!optimizer) {
+      optimizer.reset(new spvtools::Optimizer(env));
+      optimizer->RegisterLegalizationPasses();
+      optimizer->RegisterPass(spvtools::CreateReplaceInvalidOpcodePass());
+      optimizer->RegisterPass(spvtools::CreateCompactIdsPass());
+    }
+    return *optimizer;
+  }
+
+  /// Returns the optimizer registered for the given key, or nullptr if none
+  /// has been cached yet. The key must encode everything that influenced pass
+  /// registration. The cache mutex must be held.
+  spvtools::Optimizer *findOptimizer(const std::string &key) {
+    auto it = optimizers.find(key);
+    return it == optimizers.end() ? nullptr : it->second.get();
+  }
+
+  /// Takes ownership of a freshly registered optimizer and returns the cached
+  /// instance. The cache mutex must be held.
+  spvtools::Optimizer &
+  addOptimizer(const std::string &key,
+               std::unique_ptr<spvtools::Optimizer> optimizer) {
+    return *(optimizers[key] = std::move(optimizer));
+  }
+
+  /// Returns the validation context for the given target environment,
+  /// constructing it on first use. The cache mutex must be held.
+  spvtools::SpirvTools &getValidator(spv_target_env env) {
+    std::unique_ptr<spvtools::SpirvTools> &tools = validators[env];
+    if (!tools)
+      tools.reset(new spvtools::SpirvTools(env));
+    return *tools;
+  }
+
+  /// Drops all cached contexts. See the class comment for when this is safe.
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    legalizers.clear();
+    optimizers.clear();
+    validators.clear();
+  }
+
+private:
+  SpirvToolsCache() = default;
+
+  std::mutex mutex;
+  std::map<spv_target_env, std::unique_ptr<spvtools::Optimizer>> legalizers;
+  std::map<std::string, std::unique_ptr<spvtools::Optimizer>> optimizers;
+  std::map<spv_target_env, std::unique_ptr<spvtools::SpirvTools>> validators;
+};
+
 bool spirvToolsLegalize(spv_target_env env, std::vector<uint32_t> *mod,
                         std::string *messages) {
-  spvtools::Optimizer optimizer(env);
+  SpirvToolsCache &cache = SpirvToolsCache::get();
+  std::lock_guard<std::mutex> lock(cache.getMutex());
+
+  spvtools::Optimizer &optimizer = cache.getLegalizer(env);
 
   optimizer.SetMessageConsumer(
       [messages](spv_message_level_t /*level*/, const char * /*source*/,
@@ -155,19 +243,52 @@ bool spirvToolsLegalize(spv_target_env env, std::vector<uint32_t> *mod,
   spvtools::OptimizerOptions options;
   options.set_run_validator(false);
 
-  optimizer.RegisterLegalizationPasses();
-
-  optimizer.RegisterPass(spvtools::CreateReplaceInvalidOpcodePass());
-
-  optimizer.RegisterPass(spvtools::CreateCompactIdsPass());
-
   return optimizer.Run(mod->data(), mod->size(), mod, options);
 }
 
 bool spirvToolsOptimize(spv_target_env env, std::vector<uint32_t> *mod,
                         clang::spirv::SpirvCodeGenOptions &spirvOptions,
                         std::string *messages) {
-  spvtools::Optimizer optimizer(env);
+  // The registered pass list depends on the target environment and on the
+  // options consulted below, so all of them participate in the cache key.
+  std::string key = std::to_string(static_cast<int>(env));
+  if (spirvOptions.optConfig.empty()) {
+    if (spirvOptions.flattenResourceArrays)
+      key += "|fra";
+  } else {
+    for (const auto &f : spirvOptions.optConfig) {
+      key += '|';
+      key += f.str();
+    }
+  }
+
+  SpirvToolsCache &cache = SpirvToolsCache::get();
+  std::lock_guard<std::mutex> lock(cache.getMutex());
+
+  spvtools::Optimizer *cached = cache.findOptimizer(key);
+  if (!cached) {
+    std::unique_ptr<spvtools::Optimizer> optimizer(
+        new spvtools::Optimizer(env));
+
+    if (spirvOptions.optConfig.empty()) {
+      optimizer->RegisterPerformancePasses();
+      if (spirvOptions.flattenResourceArrays)
+        optimizer->RegisterPass(
+            spvtools::CreateDescriptorScalarReplacementPass());
+      optimizer->RegisterPass(spvtools::CreateCompactIdsPass());
+    } else {
+      // Command line options use llvm::SmallVector and llvm::StringRef,
+      // whereas SPIR-V optimizer uses std::vector and std::string.
+      std::vector<std::string> stdFlags;
+      for (const auto &f : spirvOptions.optConfig)
+        stdFlags.push_back(f.str());
+      if (!optimizer->RegisterPassesFromFlags(stdFlags))
+        return false;
+    }
+
+    cached = &cache.addOptimizer(key, std::move(optimizer));
+  }
+  spvtools::Optimizer &optimizer = *cached;
 
   optimizer.SetMessageConsumer(
       [messages](spv_message_level_t /*level*/, const char * /*source*/,
@@ -177,28 +298,18 @@ bool spirvToolsOptimize(spv_target_env env, std::vector<uint32_t> *mod,
   spvtools::OptimizerOptions options;
   options.set_run_validator(false);
 
-  if (spirvOptions.optConfig.empty()) {
-    optimizer.RegisterPerformancePasses();
-    if (spirvOptions.flattenResourceArrays)
-      optimizer.RegisterPass(spvtools::CreateDescriptorScalarReplacementPass());
-    optimizer.RegisterPass(spvtools::CreateCompactIdsPass());
-  } else {
-    // Command line options use llvm::SmallVector and llvm::StringRef, whereas
-    // SPIR-V optimizer uses std::vector and std::string.
-    std::vector<std::string> stdFlags;
-    for (const auto &f : spirvOptions.optConfig)
-      stdFlags.push_back(f.str());
-    if (!optimizer.RegisterPassesFromFlags(stdFlags))
-      return false;
-  }
-
   return optimizer.Run(mod->data(), mod->size(), mod, options);
 }
 
 bool spirvToolsValidate(spv_target_env env, const SpirvCodeGenOptions &opts,
                         bool beforeHlslLegalization, std::vector<uint32_t> *mod,
                         std::string *messages) {
-  spvtools::SpirvTools tools(env);
+  SpirvToolsCache &cache = SpirvToolsCache::get();
+  std::lock_guard<std::mutex> lock(cache.getMutex());
+
+  // Only the context is cached; ValidatorOptions is a plain option block that
+  // varies per call (beforeHlslLegalization) and costs nothing to rebuild.
+  spvtools::SpirvTools &tools = cache.getValidator(env);
 
   tools.SetMessageConsumer(
       [messages](spv_message_level_t /*level*/, const char * /*source*/,
@@ -493,6 +604,10 @@ SpirvEmitter::SpirvEmitter(CompilerInstance &ci)
       seenPushConstantAt(), isSpecConstantMode(false), needsLegalization(false),
       beforeHlslLegalization(false), mainSourceFile(nullptr) {
 
+  // The type probe caches key on Type pointers owned by the previous compile's
+  // ASTContext; drop them before any probes run against the new one.
+  clearTypeProbeCaches();
+
   // Get ShaderModel from command line hlsl profile option.
   const hlsl::ShaderModel *shaderModel =
       hlsl::ShaderModel::GetByName(ci.getCodeGenOpts().HLSLProfile.c_str());
@@ -10804,7 +10919,10 @@ bool SpirvEmitter::emitEntryFunctionWrapper(const FunctionDecl *decl,
 
   // Calculate the total size of the ClipDistance/CullDistance array and the
   // offset of SV_ClipDistance/SV_CullDistance variables within the array.
-  declIdMapper.glPerVertex.calculateClipCullDistanceArraySize();
+  // This is also where the recorded declarations are actually analyzed;
+  // signatures without clip/cull usage skip the analysis entirely.
+  if (!declIdMapper.glPerVertex.calculateClipCullDistanceArraySize())
+    return false;
 
   if (!spvContext.isCS() && !spvContext.isAS()) {
     // Generate stand-alone builtins of Position, ClipDistance, and
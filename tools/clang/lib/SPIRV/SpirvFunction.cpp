@@ -30,32 +30,35 @@ bool SpirvFunction::invokeVisitor(Visitor *visitor, bool reverseOrder) {
     visitor->visit(param);
 
   // Collect basic blocks in a human-readable order that satisfies SPIR-V
-  // validation rules.
-  std::vector<SpirvBasicBlock *> orderedBlocks;
-  if (!basicBlocks.empty()) {
-    BlockReadableOrderVisitor([&orderedBlocks](SpirvBasicBlock *block) {
-      orderedBlocks.push_back(block);
+  // validation rules. The order only depends on the block structure, which
+  // does not change between the several visitors run over a finished module,
+  // so it is computed once and cached (addBasicBlock clears the cache).
+  if (readableOrderBlocks.empty() && !basicBlocks.empty()) {
+    BlockReadableOrderVisitor([this](SpirvBasicBlock *block) {
+      readableOrderBlocks.push_back(block);
     }).visit(basicBlocks.front());
   }
 
-  SpirvBasicBlock *firstBB = orderedBlocks.empty() ? nullptr : orderedBlocks[0];
+  SpirvBasicBlock *firstBB =
+      readableOrderBlocks.empty() ? nullptr : readableOrderBlocks[0];
 
-  if (reverseOrder)
-    std::reverse(orderedBlocks.begin(), orderedBlocks.end());
+  // The first basic block of the function should first visit the function
+  // variables; the rest of the basic blocks do not need to.
+  auto visitBlock = [&](SpirvBasicBlock *bb) {
+    if (bb == firstBB)
+      return bb->invokeVisitor(visitor, variables, reverseOrder);
+    return bb->invokeVisitor(visitor, {}, reverseOrder);
+  };
 
-  for (auto *bb : orderedBlocks) {
-    // The first basic block of the function should first visit the function
-    // variables.
-    if (bb == firstBB) {
-      if (!bb->invokeVisitor(visitor, variables, reverseOrder))
+  if (reverseOrder) {
+    for (auto iter = readableOrderBlocks.rbegin();
+         iter != readableOrderBlocks.rend(); ++iter)
+      if (!visitBlock(*iter))
         return false;
-    }
-    // The rest of the basic blocks in the function do not need to visit
-    // function variables.
-    else {
-      if (!bb->invokeVisitor(visitor, {}, reverseOrder))
+  } else {
+    for (auto *bb : readableOrderBlocks)
+      if (!visitBlock(bb))
         return false;
-    }
   }
 
   if (!visitor->visit(this, Visitor::Phase::Done))
@@ -64,6 +67,15 @@ bool SpirvFunction::invokeVisitor(Visitor *visitor, bool reverseOrder) {
   return true;
 }
 
+size_t SpirvFunction::getInstructionCount() const {
+  // OpFunction and OpFunctionEnd, one OpFunctionParameter per parameter, and
+  // one OpLabel per basic block.
+  size_t count = 2 + parameters.size() + basicBlocks.size();
+  for (SpirvBasicBlock *bb : basicBlocks)
+    count += bb->getInstructionCount();
+  return count;
+}
+
 void SpirvFunction::addParameter(SpirvFunctionParameter *param) {
   assert(param && "cannot add null function parameter");
   parameters.push_back(param);
@@ -77,6 +89,7 @@ void SpirvFunction::addVariable(SpirvVariable *var) {
 void SpirvFunction::addBasicBlock(SpirvBasicBlock *bb) {
   assert(bb && "cannot add null basic block to function");
   basicBlocks.push_back(bb);
+  readableOrderBlocks.clear();
 }
 
 } // end namespace spirv
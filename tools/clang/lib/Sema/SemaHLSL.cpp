@@ -12,6 +12,7 @@
 
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/Attr.h"
 #include "clang/AST/DeclCXX.h"
@@ -2904,13 +2905,27 @@ private:
   // Intrinsic tables available externally.
   llvm::SmallVector<CComPtr<IDxcIntrinsicTable>, 2> m_intrinsicTables;
 
+  // Lazily-built index over the built-in intrinsic tables, from intrinsic
+  // name to the indices of every entry with that name in table order. The
+  // tables are immutable static data, so each index is built at most once
+  // for the lifetime of this source.
+  llvm::DenseMap<const HLSL_INTRINSIC *,
+                 llvm::StringMap<llvm::SmallVector<unsigned, 4>>>
+      m_intrinsicNameIndices;
+
   // Scalar types indexed by HLSLScalarType.
   QualType m_scalarTypes[HLSLScalarTypeCount];
 
   // Scalar types already built.
   TypedefDecl* m_scalarTypeDefs[HLSLScalarTypeCount];
 
-  // Matrix types already built indexed by type, row-count, col-count. Should probably move to a sparse map. Instrument to figure out best initial size.
+  // Matrix types already built indexed by type, row-count, col-count. The
+  // dense array means the specialization machinery runs once per distinct
+  // type per TU; repeat uses are a pointer load here, and once the typedef
+  // name exists ordinary scope lookup finds it without consulting this
+  // external source at all. Do not pre-warm eagerly: building the
+  // specializations creates implicit decls that would show up in every
+  // compile's AST whether or not the types are used.
   QualType m_matrixTypes[HLSLScalarTypeCount][4][4];
 
   // Matrix types already built, in shorthand form.
@@ -4208,29 +4223,33 @@ public:
     StringRef nameIdentifier,
     size_t argumentCount)
   {
-    // This is implemented by a linear scan for now.
-    // We tested binary search on tables, and there was no performance gain on
-    // samples probably for the following reasons.
-    // 1. The tables are not big enough to make noticable difference
-    // 2. The user of this function assumes that it returns the first entry in
-    // the table that matches name and argument count. So even in the binary
-    // search, we have to scan backwards until the entry does not match the name
-    // or arg count. For linear search this is not a problem
-    for (unsigned int i = 0; i < tableSize; i++) {
-      const HLSL_INTRINSIC* pIntrinsic = &table[i];
-
-      const bool isVariadicFn = IsVariadicIntrinsicFunction(pIntrinsic);
-
-      // Do some quick checks to verify size and name.
-      if (!isVariadicFn && pIntrinsic->uNumArgs != 1 + argumentCount) {
-        continue;
-      }
-      if (!nameIdentifier.equals(StringRef(pIntrinsic->pArgs[0].pName))) {
-        continue;
+    // Callers expect the first entry in the table that matches name and
+    // argument count, and the iterator keeps scanning subsequent entries with
+    // the same name, so the index records all entries per name in table order
+    // and the candidate walk below preserves that contract.
+    if (table != nullptr && tableSize != 0) {
+      auto &nameIndex = m_intrinsicNameIndices[table];
+      if (nameIndex.empty()) {
+        for (unsigned i = 0; i < tableSize; i++) {
+          nameIndex[StringRef(table[i].pArgs[0].pName)].push_back(i);
+        }
       }
+      auto entries = nameIndex.find(nameIdentifier);
+      if (entries != nameIndex.end()) {
+        for (unsigned i : entries->second) {
+          const HLSL_INTRINSIC *pIntrinsic = &table[i];
+
+          const bool isVariadicFn = IsVariadicIntrinsicFunction(pIntrinsic);
 
-      return IntrinsicDefIter::CreateStart(table, tableSize, pIntrinsic,
-        IntrinsicTableDefIter::CreateStart(m_intrinsicTables, typeName, nameIdentifier, argumentCount));
+          // Check the argument count; the name already matched.
+          if (!isVariadicFn && pIntrinsic->uNumArgs != 1 + argumentCount) {
+            continue;
+          }
+
+          return IntrinsicDefIter::CreateStart(table, tableSize, pIntrinsic,
+            IntrinsicTableDefIter::CreateStart(m_intrinsicTables, typeName, nameIdentifier, argumentCount));
+        }
+      }
     }
 
     return IntrinsicDefIter::CreateStart(table, tableSize, table + tableSize,
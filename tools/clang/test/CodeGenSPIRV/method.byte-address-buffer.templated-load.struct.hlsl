@@ -71,7 +71,6 @@ void main(uint3 tid : SV_DispatchThreadId) {
 // }
 
 
-// CHECK:     [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_0:%\d+]]
 // CHECK:     [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_0:%\d+]]
 // CHECK: [[index_1:%\d+]] = OpIAdd %uint [[index_0]] %uint_1
 // CHECK:     [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_1]]
@@ -79,11 +78,9 @@ void main(uint3 tid : SV_DispatchThreadId) {
 // CHECK:     [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_1]]
 // CHECK: [[index_2:%\d+]] = OpIAdd %uint [[index_1]] %uint_1
 // CHECK:     [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_2]]
-// CHECK:     [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_2]]
 // CHECK: [[index_3:%\d+]] = OpIAdd %uint [[index_2]] %uint_1
 // CHECK:   [[aVec1:%\d+]] = OpCompositeConstruct %v3half
 // CHECK:     [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_3]]
-// CHECK:     [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_3]]
 // CHECK: [[index_4:%\d+]] = OpIAdd %uint [[index_3]] %uint_1
 // CHECK:     [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_4]]
 // CHECK:   [[aVec2:%\d+]] = OpCompositeConstruct %v3half
@@ -121,18 +118,15 @@ void main(uint3 tid : SV_DispatchThreadId) {
 // COMMENT: 40 byte offset is equivalent to 10 words offset (32-bit words).
 //
 // CHECK:      [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_10]]
-// CHECK:      [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_10]]
 // CHECK: [[index_11:%\d+]] = OpIAdd %uint [[index_10]] %uint_1
 // CHECK:      [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_11]]
 // CHECK:    [[aVec0:%\d+]] = OpCompositeConstruct %v3half
 // CHECK:      [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_11]]
 // CHECK: [[index_12:%\d+]] = OpIAdd %uint [[index_11]] %uint_1
 // CHECK:      [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_12]]
-// CHECK:      [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_12]]
 // CHECK: [[index_13:%\d+]] = OpIAdd %uint [[index_12]] %uint_1
 // CHECK:    [[aVec1:%\d+]] = OpCompositeConstruct %v3half
 // CHECK:      [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_13]]
-// CHECK:      [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_13]]
 // CHECK: [[index_14:%\d+]] = OpIAdd %uint [[index_13]] %uint_1
 // CHECK:      [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_14]]
 // CHECK:    [[aVec2:%\d+]] = OpCompositeConstruct %v3half
@@ -9,8 +9,6 @@ void main(uint3 tid : SV_DispatchThreadId)
 // CHECK:       [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_0:%\d+]]
 // CHECK:     [[word0:%\d+]] = OpLoad %uint [[ptr]]
 // CHECK:      [[val0:%\d+]] = OpUConvert %ushort [[word0]]
-// CHECK:       [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_0]]
-// CHECK:     [[word0:%\d+]] = OpLoad %uint [[ptr]]
 // CHECK: [[val1_uint:%\d+]] = OpShiftRightLogical %uint [[word0]] %uint_16
 // CHECK:      [[val1:%\d+]] = OpUConvert %ushort [[val1_uint]]
 // CHECK:   [[index_1:%\d+]] = OpIAdd %uint [[index_0]] %uint_1
@@ -78,8 +76,6 @@ void main(uint3 tid : SV_DispatchThreadId)
 // CHECK:           [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_0:%\d+]]
 // CHECK:         [[word0:%\d+]] = OpLoad %uint [[ptr]]
 // CHECK:          [[val0:%\d+]] = OpUConvert %ushort [[word0]]
-// CHECK:           [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 %117
-// CHECK:         [[word0:%\d+]] = OpLoad %uint [[ptr]]
 // CHECK: [[word0_shifted:%\d+]] = OpShiftRightLogical %uint [[word0]] %uint_16
 // CHECK:          [[val1:%\d+]] = OpUConvert %ushort [[word0_shifted]]
 // CHECK:       [[index_1:%\d+]] = OpIAdd %uint [[index_0]] %uint_1
@@ -90,13 +86,11 @@ void main(uint3 tid : SV_DispatchThreadId)
 // CHECK:           [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_1]]
 // CHECK:         [[word1:%\d+]] = OpLoad %uint [[ptr]]
 // CHECK: [[word1_shifted:%\d+]] = OpShiftRightLogical %uint [[word1]] %uint_16
-// CHECK:          [[val3:%\d+]] = OpUConvert %ushort [[word1_shifted:%\d+]]
+// CHECK:          [[val3:%\d+]] = OpUConvert %ushort [[word1_shifted]]
 // CHECK:       [[index_2:%\d+]] = OpIAdd %uint [[index_1]] %uint_1
 // CHECK:           [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_2]]
 // CHECK:         [[word2:%\d+]] = OpLoad %uint [[ptr]]
 // CHECK:          [[val4:%\d+]] = OpUConvert %ushort [[word2]]
-// CHECK:           [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_2]]
-// CHECK:         [[word2:%\d+]] = OpLoad %uint [[ptr]]
 // CHECK: [[shifted_word2:%\d+]] = OpShiftRightLogical %uint [[word2]] %uint_16
 // CHECK:          [[val5:%\d+]] = OpUConvert %ushort [[shifted_word2]]
 // CHECK:       [[index_3:%\d+]] = OpIAdd %uint [[index_2]] %uint_1
@@ -104,8 +98,6 @@ void main(uint3 tid : SV_DispatchThreadId)
 // CHECK:           [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_3]]
 // CHECK:         [[word3:%\d+]] = OpLoad %uint [[ptr]]
 // CHECK:          [[val6:%\d+]] = OpUConvert %ushort [[word3]]
-// CHECK:           [[ptr:%\d+]] = OpAccessChain %_ptr_Uniform_uint %buf %uint_0 [[index_3]]
-// CHECK:         [[word3:%\d+]] = OpLoad %uint [[ptr]]
 // CHECK: [[shifted_word3:%\d+]] = OpShiftRightLogical %uint [[word3]] %uint_16
 // CHECK:          [[val7:%\d+]] = OpUConvert %ushort [[shifted_word3]]
 // CHECK:       [[index_4:%\d+]] = OpIAdd %uint [[index_3]] %uint_1
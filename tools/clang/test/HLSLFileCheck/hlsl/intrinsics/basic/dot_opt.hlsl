@@ -0,0 +1,19 @@
+// RUN: %dxc -E main -T ps_6_0 %s | FileCheck %s
+
+// Dot lanes with constant components collapse: a zero component drops the
+// lane, a one component forwards the other side, and what remains expands
+// to scalar mul/add, so no dot intrinsic survives.
+// CHECK-NOT: dx.op.dot
+// CHECK: fmul fast float %{{.+}}, 2.000000e+00
+// CHECK: fadd fast float
+// CHECK-NOT: dx.op.dot
+
+float main(float4 a : A) : SV_Target {
+  // Every lane drops; the whole dot is 0.
+  float z = dot(a, float4(0, 0, 0, 0));
+  // Only the one-lane survives, forwarding a.y.
+  float s = dot(a.xyz, float3(0, 1, 0));
+  // Partially constant: expands to a.x * 2 + a.y.
+  float m = dot(a.xy, float2(2, 1));
+  return z + s + m;
+}
@@ -0,0 +1,13 @@
+// RUN: %dxc -E main -T ps_6_0 %s | FileCheck %s
+
+// Unlike the integer forms, float min/max with an extreme constant is not
+// an identity: fmax(x, -inf) and fmin(x, +inf) differ from x when x is
+// NaN, so both calls must survive.
+// CHECK: call float @dx.op.binary.f32(i32 35,
+// CHECK: call float @dx.op.binary.f32(i32 36,
+
+float main(float a : A) : SV_Target {
+  float lo = max(a, asfloat(0xff800000));
+  float hi = min(a, asfloat(0x7f800000));
+  return lo + hi;
+}
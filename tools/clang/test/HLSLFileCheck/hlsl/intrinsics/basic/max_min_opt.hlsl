@@ -0,0 +1,15 @@
+// RUN: %dxc -E main -T ps_6_0 %s | FileCheck %s
+
+// min(x, x) and max(x, x) fold to x for every type, and the integer
+// identity and absorbing constants fold the call away too, so no binary
+// intrinsic survives.
+// CHECK-NOT: dx.op.binary
+
+float main(float a : A, int b : B, uint c : C) : SV_Target {
+  float fr = min(a, a) + max(a, a);
+  int ir = max(b, int(0x80000000)) + min(b, int(0x7fffffff)) +
+           max(b, int(0x7fffffff)) + min(b, int(0x80000000));
+  uint ur = max(c, 0u) + min(c, 0xffffffffu) +
+            max(c, 0xffffffffu) + min(c, 0u);
+  return fr + ir + ur;
+}
@@ -0,0 +1,15 @@
+// RUN: %dxc -E main -T ps_6_0 %s | FileCheck %s
+
+// saturate(saturate(x)) and abs(abs(x)) collapse to a single call, and
+// abs of a saturated value drops the abs since [0,1] is non-negative.
+// One saturate for a, one abs for b, one saturate for c.
+// CHECK: call float @dx.op.unary.f32(i32 7,
+// CHECK-NOT: call float @dx.op.unary
+// CHECK: call float @dx.op.unary.f32(i32 6,
+// CHECK-NOT: call float @dx.op.unary
+// CHECK: call float @dx.op.unary.f32(i32 7,
+// CHECK-NOT: call float @dx.op.unary
+
+float main(float a : A, float b : B, float c : C) : SV_Target {
+  return saturate(saturate(a)) + abs(abs(b)) + abs(saturate(c));
+}
@@ -0,0 +1,12 @@
+// RUN: %dxc -E main -T ps_6_0 %s | FileCheck %s
+
+// Make sure saturate(saturate(x)) and min(x, x) are not simplified when
+// marked precise.
+// CHECK: call float @dx.op.unary.f32(i32 7,
+// CHECK: call float @dx.op.unary.f32(i32 7,
+// CHECK: call float @dx.op.binary.f32(i32 36,
+
+float main(float a : A) : SV_Target {
+  precise float t = saturate(saturate(a)) + min(a, a);
+  return t;
+}
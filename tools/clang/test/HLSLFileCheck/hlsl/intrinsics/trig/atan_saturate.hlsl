@@ -0,0 +1,18 @@
+// RUN: %dxc -Emain -Tps_6_0 %s | %opt -S -hlsl-dxil-expand-trig-intrinsics | %FileCheck %s
+
+// A saturated input is provably in [0, 1], so the expansion needs neither
+// the abs/negate sign fixup nor the reciprocal range reduction: the result
+// is the bare polynomial evaluated on the saturate result.
+
+// CHECK: [[X:%.*]] = call float @dx.op.unary.f32(i32 7
+// CHECK: fmul fast float [[X]], [[X]]
+
+// No abs (i32 6), no reciprocal, no selects.
+// CHECK-NOT: call float @dx.op.unary.f32(i32 6
+// CHECK-NOT: fdiv
+// CHECK-NOT: select
+
+[RootSignature("")]
+float main(float x : A) : SV_Target {
+    return atan(saturate(x));
+}
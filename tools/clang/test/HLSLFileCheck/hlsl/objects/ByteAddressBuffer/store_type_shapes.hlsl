@@ -25,8 +25,8 @@ void main() {
   // CHECK: call void @dx.op.rawBufferStore.i32(i32 140, {{.*}}, i32 300, i32 undef, i32 42, i32 42, i32 42, i32 42, i8 15, i32 4)
   buf.Store(300, (int2x2)42);
   
-  // CHECK: call void @dx.op.rawBufferStore.i32(i32 140, {{.*}}, i32 400, i32 undef, i32 42, i32 undef, i32 undef, i32 undef, i8 1, i32 4)
-  // CHECK: call void @dx.op.rawBufferStore.i32(i32 140, {{.*}}, i32 404, i32 undef, i32 42, i32 undef, i32 undef, i32 undef, i8 1, i32 4)
+  // Contiguous scalar array elements get grouped into a single vector store.
+  // CHECK: call void @dx.op.rawBufferStore.i32(i32 140, {{.*}}, i32 400, i32 undef, i32 42, i32 42, i32 undef, i32 undef, i8 3, i32 4)
   buf.Store(400, (int[2])42);
   
   // CHECK: call void @dx.op.rawBufferStore.i16(i32 140, {{.*}}, i32 500, i32 undef, i16 42, i16 undef, i16 undef, i16 undef, i8 1, i32 2)
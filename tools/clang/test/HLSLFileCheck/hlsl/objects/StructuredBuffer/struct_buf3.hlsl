@@ -1,8 +1,9 @@
 // RUN: %dxilver 1.2 | %dxc -E main -T ps_6_2 %s | FileCheck %s
 
+// The scalar and two-component loads of each group coalesce into one wide
+// load; the trunc per original component remains.
 // CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32
 // CHECK: trunc i32 %{{[a-zA-Z0-9]+}} to i16
-// CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32
 // CHECK: trunc i32 %{{[a-zA-Z0-9]+}} to i16
 // CHECK: trunc i32 %{{[a-zA-Z0-9]+}} to i16
 // CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32
@@ -17,7 +18,6 @@
 
 // CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32
 // CHECK: trunc i32 %{{[a-zA-Z0-9]+}} to i16
-// CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32
 // CHECK: trunc i32 %{{[a-zA-Z0-9]+}} to i16
 // CHECK: trunc i32 %{{[a-zA-Z0-9]+}} to i16
 // CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32
@@ -32,7 +32,6 @@
 
 // CHECK: call %dx.types.ResRet.f32 @dx.op.rawBufferLoad.f32
 // CHECK: fptrunc float %{{[a-zA-Z0-9]+}} to half
-// CHECK: call %dx.types.ResRet.f32 @dx.op.rawBufferLoad.f32
 // CHECK: fptrunc float %{{[a-zA-Z0-9]+}} to half
 // CHECK: fptrunc float %{{[a-zA-Z0-9]+}} to half
 // CHECK: call %dx.types.ResRet.f32 @dx.op.rawBufferLoad.f32
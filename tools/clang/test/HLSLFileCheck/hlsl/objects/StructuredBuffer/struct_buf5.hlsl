@@ -1,5 +1,6 @@
 // RUN: %dxilver 1.2 | %dxc -E main -T ps_6_2 -enable-16bit-types %s | FileCheck %s
-// CHECK: call %dx.types.ResRet.i16 @dx.op.rawBufferLoad.i16
+// The scalar and two-component loads of each group coalesce into one wide
+// load, leaving three loads per group.
 // CHECK: call %dx.types.ResRet.i16 @dx.op.rawBufferLoad.i16
 // CHECK: call %dx.types.ResRet.i16 @dx.op.rawBufferLoad.i16
 // CHECK: call %dx.types.ResRet.i16 @dx.op.rawBufferLoad.i16
@@ -7,12 +8,10 @@
 // CHECK: call %dx.types.ResRet.i16 @dx.op.rawBufferLoad.i16
 // CHECK: call %dx.types.ResRet.i16 @dx.op.rawBufferLoad.i16
 // CHECK: call %dx.types.ResRet.i16 @dx.op.rawBufferLoad.i16
-// CHECK: call %dx.types.ResRet.i16 @dx.op.rawBufferLoad.i16
 
 // CHECK: call %dx.types.ResRet.f16 @dx.op.rawBufferLoad.f16
 // CHECK: call %dx.types.ResRet.f16 @dx.op.rawBufferLoad.f16
 // CHECK: call %dx.types.ResRet.f16 @dx.op.rawBufferLoad.f16
-// CHECK: call %dx.types.ResRet.f16 @dx.op.rawBufferLoad.f16
 
 // CHECK: call void @dx.op.rawBufferStore.i16
 // CHECK: call void @dx.op.rawBufferStore.i16
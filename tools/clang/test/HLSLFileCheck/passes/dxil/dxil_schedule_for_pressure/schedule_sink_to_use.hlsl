@@ -0,0 +1,19 @@
+// RUN: %dxc -Emain -Tps_6_0 %s | %opt -S -dxil-schedule-for-pressure | %FileCheck %s
+
+// The product feeding only the last store sinks to just before that store,
+// shortening its live range.  Its input loads are readers and may not cross
+// the intervening storeOutput calls, so they stay at the top of the block.
+
+// CHECK: call float @dx.op.loadInput.f32
+// CHECK-NOT: fmul
+// CHECK: call void @dx.op.storeOutput.f32(i32 5, i32 0, i32 0, i8 0,
+// CHECK: call void @dx.op.storeOutput.f32(i32 5, i32 0, i32 0, i8 2,
+// CHECK-NEXT: fmul
+// CHECK-NEXT: call void @dx.op.storeOutput.f32(i32 5, i32 0, i32 0, i8 3,
+
+float4 main(float4 c : COLOR0) : SV_Target {
+  float early = c.x * c.y;
+  float late = c.z + c.w;
+  float r = late + 1.0;
+  return float4(r, r, r, early);
+}
@@ -0,0 +1,21 @@
+// RUN: %dxc -Emain -Tps_6_0 %s | %opt -S -hlsl-dxil-spec-constants,cbuffer=SpecConstants,values=0:2;4:0x40400000 | %FileCheck %s
+
+// mode (byte offset 0) folds to 2 and scale (byte offset 4) folds to 3.0.
+// Only the extractvalues are replaced; the loads and the now-constant
+// compare are left for later simplification and DCE.
+
+// CHECK-NOT: extractvalue %dx.types.CBufRet
+// CHECK: icmp eq i32 2, 2
+// CHECK-NOT: extractvalue %dx.types.CBufRet
+// CHECK: fmul fast float {{[^,]+}}, 3.000000e+00
+
+cbuffer SpecConstants : register(b0) {
+  int mode;
+  float scale;
+};
+
+float4 main(float4 c : COLOR0) : SV_Target {
+  if (mode == 2)
+    return c * scale;
+  return c;
+}
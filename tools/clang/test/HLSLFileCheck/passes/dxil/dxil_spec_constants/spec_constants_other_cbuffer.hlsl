@@ -0,0 +1,15 @@
+// RUN: %dxc -Emain -Tps_6_0 %s | %opt -S -hlsl-dxil-spec-constants,cbuffer=SpecConstants,values=0:0x40400000 | %FileCheck %s
+
+// The cbuffer in this shader is not named SpecConstants, so nothing is
+// specialized and the extractvalue of the load remains.
+
+// CHECK: call %dx.types.CBufRet.f32 @dx.op.cbufferLoadLegacy.f32
+// CHECK: extractvalue %dx.types.CBufRet
+
+cbuffer Tuning : register(b0) {
+  float scale;
+};
+
+float4 main(float4 c : COLOR0) : SV_Target {
+  return c * scale;
+}
@@ -0,0 +1,17 @@
+// RUN: %dxilver 1.2 | %dxc -E main -T ps_6_2 %s | FileCheck %s
+
+// Scalar and vector loads from the same dynamic base at adjacent constant
+// offsets merge into one wide load whose mask covers the combined components:
+// a lands on component 0, b on 1-2, c on 3.
+
+ByteAddressBuffer buf;
+
+float main(uint i : IDX) : SV_Target {
+  uint a = buf.Load(i);
+  uint2 b = buf.Load2(i + 4);
+  uint c = buf.Load(i + 12);
+  return a + b.x + b.y + c;
+}
+
+// CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32(i32 139, %dx.types.Handle %buf_texture_rawbuf, i32 %{{[0-9]+}}, i32 undef, i8 15, i32 4)
+// CHECK-NOT: @dx.op.rawBufferLoad
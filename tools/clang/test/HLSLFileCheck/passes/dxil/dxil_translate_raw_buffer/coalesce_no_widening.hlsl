@@ -0,0 +1,21 @@
+// RUN: %dxilver 1.2 | %dxc -E main -T ps_6_2 %s | FileCheck %s
+
+// A merge never reads past the last byte the original loads touched. Load2 at
+// i+12 would put its y component past the four-component window, so the first
+// pair stays split; the scalar at j+12 lands exactly on component 3, so the
+// second pair merges into a wide load ending at the same byte it did before.
+
+ByteAddressBuffer buf;
+
+float main(uint i : IDX, uint j : IDY) : SV_Target {
+  uint a = buf.Load(i);
+  uint2 b = buf.Load2(i + 12);
+  uint c = buf.Load(j);
+  uint d = buf.Load(j + 12);
+  return a + b.x + b.y + c + d;
+}
+
+// CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32(i32 139, %dx.types.Handle %buf_texture_rawbuf, i32 %{{[0-9]+}}, i32 undef, i8 1, i32 4)
+// CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32(i32 139, %dx.types.Handle %buf_texture_rawbuf, i32 %{{[0-9]+}}, i32 undef, i8 3, i32 4)
+// CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32(i32 139, %dx.types.Handle %buf_texture_rawbuf, i32 %{{[0-9]+}}, i32 undef, i8 15, i32 4)
+// CHECK-NOT: @dx.op.rawBufferLoad
@@ -0,0 +1,18 @@
+// RUN: %dxilver 1.2 | %dxc -E main -T ps_6_2 %s | FileCheck %s
+
+// A load whose status result (component 4) is consumed cannot be rewritten
+// component-wise, so it is excluded from coalescing and both loads survive.
+
+ByteAddressBuffer buf;
+
+float main(uint i : IDX) : SV_Target {
+  uint status;
+  uint a = buf.Load(i, status);
+  uint b = buf.Load(i + 4);
+  return a + b + status;
+}
+
+// CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32(i32 139, %dx.types.Handle %buf_texture_rawbuf, i32 %{{[0-9]+}}, i32 undef, i8 1, i32 4)
+// CHECK: extractvalue %dx.types.ResRet.i32 %{{[a-zA-Z0-9]+}}, 4
+// CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32(i32 139, %dx.types.Handle %buf_texture_rawbuf, i32 %{{[0-9]+}}, i32 undef, i8 1, i32 4)
+// CHECK-NOT: @dx.op.rawBufferLoad
@@ -0,0 +1,18 @@
+// RUN: %dxilver 1.2 | %dxc -E main -T ps_6_2 %s | FileCheck %s
+
+// An intervening instruction that may write memory ends the coalescing
+// window, so loads on either side of the store are not merged.
+
+RWByteAddressBuffer buf;
+
+float main(uint i : IDX) : SV_Target {
+  uint a = buf.Load(i);
+  buf.Store(i + 64, a);
+  uint b = buf.Load(i + 4);
+  return a + b;
+}
+
+// CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32(i32 139, %dx.types.Handle %buf_UAV_rawbuf, i32 %{{[0-9]+}}, i32 undef, i8 1, i32 4)
+// CHECK: call void @dx.op.rawBufferStore.i32
+// CHECK: call %dx.types.ResRet.i32 @dx.op.rawBufferLoad.i32(i32 139, %dx.types.Handle %buf_UAV_rawbuf, i32 %{{[0-9]+}}, i32 undef, i8 1, i32 4)
+// CHECK-NOT: @dx.op.rawBufferLoad
@@ -0,0 +1,14 @@
+// RUN: %dxc -Emain -Tvs_6_0 %s | %opt -S -hlsl-dxil-trim-unused-outputs | %FileCheck %s
+
+// Without a consumed-outputs option there is no downstream information, so
+// the pass must leave every output alone.
+
+// CHECK: float 2.000000e+00
+// CHECK: !"COLOR"
+
+void main(float4 pos : POSITION,
+          out float4 opos : SV_Position,
+          out float3 color : COLOR0) {
+  opos = pos;
+  color = float3(1, 2, 3);
+}
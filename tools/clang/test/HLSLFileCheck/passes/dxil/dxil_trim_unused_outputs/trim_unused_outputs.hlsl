@@ -0,0 +1,22 @@
+// RUN: %dxc -Emain -Tvs_6_0 %s | %opt -S -hlsl-dxil-trim-unused-outputs,consumed-outputs=TEXCOORD0 | %FileCheck %s
+
+// COLOR0 is not in the consumed list, so its stores are erased and the
+// element is removed from the output signature.  TEXCOORD0 survives and is
+// renumbered from ID 2 to ID 1.  SV_Position is a system value and keeps
+// its slot even though it is not listed.
+
+// CHECK: call void @dx.op.storeOutput.f32(i32 5, i32 0, i32 0, i8 0,
+// CHECK-NOT: float 2.000000e+00
+// CHECK: call void @dx.op.storeOutput.f32(i32 5, i32 1, i32 0, i8 0, float 7.000000e+00)
+// CHECK: call void @dx.op.storeOutput.f32(i32 5, i32 1, i32 0, i8 1, float 8.000000e+00)
+// CHECK-NOT: !"COLOR"
+// CHECK: !"TEXCOORD"
+
+void main(float4 pos : POSITION,
+          out float4 opos : SV_Position,
+          out float3 color : COLOR0,
+          out float2 uv : TEXCOORD0) {
+  opos = pos;
+  color = float3(1, 2, 3);
+  uv = float2(7, 8);
+}
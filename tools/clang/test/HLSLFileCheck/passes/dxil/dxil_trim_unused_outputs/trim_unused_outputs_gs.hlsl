@@ -0,0 +1,23 @@
+// RUN: %dxc -Emain -Tgs_6_0 %s | %opt -S -hlsl-dxil-trim-unused-outputs,consumed-outputs=TEXCOORD0 | %FileCheck %s
+
+// Geometry shaders are excluded from trimming, so COLOR0 keeps its stores
+// and its signature entry even though it is not in the consumed list.
+
+// CHECK: float 2.000000e+00
+// CHECK: !"COLOR"
+
+struct GSOut {
+  float4 pos : SV_Position;
+  float2 uv : TEXCOORD0;
+  float3 color : COLOR0;
+};
+
+[maxvertexcount(3)]
+void main(triangle float4 verts[3] : POSITION,
+          inout TriangleStream<GSOut> stream) {
+  GSOut o;
+  o.pos = verts[0];
+  o.uv = float2(7, 8);
+  o.color = float3(1, 2, 3);
+  stream.Append(o);
+}
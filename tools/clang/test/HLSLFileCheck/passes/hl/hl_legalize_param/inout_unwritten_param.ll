@@ -0,0 +1,86 @@
+; RUN: %opt %s -hl-legalize-parameter -S | FileCheck %s
+
+; UseST is noinline and only reads its inout parameter, so the call site
+; still gets a temp for the cbuffer pointer and the copy-in before the call,
+; but the callee access summary proves no write and drops the copy-out.
+
+; CHECK-LABEL: define float @main()
+; CHECK: [[TMP:%.*]] = alloca %struct.ST
+; CHECK: call void @llvm.memcpy
+; CHECK: call float @"\01?UseST@@YAMUST@@@Z"(%struct.ST* [[TMP]])
+; CHECK-NOT: call void @llvm.memcpy
+
+target datalayout = "e-m:e-p:32:32-i1:32-i8:32-i16:32-i32:32-i64:64-f16:32-f32:32-f64:64-n8:16:32:64"
+target triple = "dxil-ms-dx"
+
+%"$Globals" = type { %struct.ST }
+%struct.ST = type { <4 x float> }
+%dx.types.Handle = type { i8* }
+
+@"$Globals" = external constant %"$Globals"
+
+; Function Attrs: nounwind
+define float @main() #0 {
+entry:
+  %0 = call %dx.types.Handle @"dx.hl.createhandle..%dx.types.Handle (i32, %\22$Globals\22*, i32)"(i32 0, %"$Globals"* @"$Globals", i32 0)
+  %1 = call %"$Globals"* @"dx.hl.subscript.cb.%\22$Globals\22* (i32, %dx.types.Handle, i32)"(i32 6, %dx.types.Handle %0, i32 0)
+  %2 = getelementptr inbounds %"$Globals", %"$Globals"* %1, i32 0, i32 0
+  %call = call float @"\01?UseST@@YAMUST@@@Z"(%struct.ST* %2)
+  ret float %call
+}
+
+; Function Attrs: noinline nounwind
+define internal float @"\01?UseST@@YAMUST@@@Z"(%struct.ST* %st) #1 {
+entry:
+  %a = getelementptr inbounds %struct.ST, %struct.ST* %st, i32 0, i32 0
+  %0 = load <4 x float>, <4 x float>* %a, align 4
+  %1 = extractelement <4 x float> %0, i32 0
+  ret float %1
+}
+
+; Function Attrs: nounwind readnone
+declare %"$Globals"* @"dx.hl.subscript.cb.%\22$Globals\22* (i32, %dx.types.Handle, i32)"(i32, %dx.types.Handle, i32) #2
+
+; Function Attrs: nounwind readnone
+declare %dx.types.Handle @"dx.hl.createhandle..%dx.types.Handle (i32, %\22$Globals\22*, i32)"(i32, %"$Globals"*, i32) #2
+
+attributes #0 = { nounwind }
+attributes #1 = { noinline nounwind }
+attributes #2 = { nounwind readnone }
+
+!pauseresume = !{!0}
+!llvm.ident = !{!1}
+!dx.version = !{!2}
+!dx.valver = !{!3}
+!dx.shaderModel = !{!4}
+!dx.typeAnnotations = !{!5, !10}
+!dx.entryPoints = !{!20}
+!dx.fnprops = !{!24}
+!dx.options = !{!25, !26}
+
+!0 = !{!"hlsl-hlemit", !"hlsl-hlensure"}
+!1 = !{!"clang version 3.7 (tags/RELEASE_370/final)"}
+!2 = !{i32 1, i32 0}
+!3 = !{i32 1, i32 6}
+!4 = !{!"ps", i32 6, i32 0}
+!5 = !{i32 0, %struct.ST undef, !6, %"$Globals" undef, !8}
+!6 = !{i32 16, !7}
+!7 = !{i32 6, !"a", i32 3, i32 0, i32 7, i32 9}
+!8 = !{i32 16, !9}
+!9 = !{i32 6, !"st", i32 3, i32 0}
+!10 = !{i32 1, float ()* @main, !11, float (%struct.ST*)* @"\01?UseST@@YAMUST@@@Z", !15}
+!11 = !{!12}
+!12 = !{i32 1, !13, !14}
+!13 = !{i32 4, !"SV_Target", i32 7, i32 9}
+!14 = !{}
+!15 = !{!16, !18}
+!16 = !{i32 0, !17, !14}
+!17 = !{i32 7, i32 9}
+!18 = !{i32 2, !14, !14}
+!20 = !{float ()* @main, !"main", null, !21, null}
+!21 = !{null, null, !22, null}
+!22 = !{!23}
+!23 = !{i32 0, %"$Globals"* @"$Globals", !"$Globals", i32 0, i32 -1, i32 1, i32 16, null}
+!24 = !{float ()* @main, i32 0, i1 false}
+!25 = !{i32 144}
+!26 = !{i32 -1}
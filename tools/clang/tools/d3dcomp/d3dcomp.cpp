@@ -15,23 +15,100 @@
 #include "dxc/dxcapi.h"
 
 #include <d3dcompiler.h>
+#include <map>
 #include <vector>
 #include <string>
 
+// The legacy tools funnel thousands of compiles through this bridge, so the
+// dxcompiler objects are created once per thread and reused. Per-thread
+// rather than process-wide because the objects are cheap to keep but are not
+// specified as safe for concurrent calls on one instance.
+
 HRESULT CreateLibrary(IDxcLibrary **pLibrary) {
-  return DxcCreateInstance(CLSID_DxcLibrary, __uuidof(IDxcLibrary),
-                           (void **)pLibrary);
+  thread_local CComPtr<IDxcLibrary> s_pLibrary;
+  if (s_pLibrary == nullptr) {
+    IFR(DxcCreateInstance(CLSID_DxcLibrary, __uuidof(IDxcLibrary),
+                          (void **)&s_pLibrary));
+  }
+  s_pLibrary.p->AddRef();
+  *pLibrary = s_pLibrary.p;
+  return S_OK;
 }
 
 HRESULT CreateCompiler(IDxcCompiler **ppCompiler) {
-  return DxcCreateInstance(CLSID_DxcCompiler, __uuidof(IDxcCompiler),
-                           (void **)ppCompiler);
+  thread_local CComPtr<IDxcCompiler> s_pCompiler;
+  if (s_pCompiler == nullptr) {
+    IFR(DxcCreateInstance(CLSID_DxcCompiler, __uuidof(IDxcCompiler),
+                          (void **)&s_pCompiler));
+  }
+  s_pCompiler.p->AddRef();
+  *ppCompiler = s_pCompiler.p;
+  return S_OK;
 }
 
 HRESULT CreateContainerReflection(IDxcContainerReflection **ppReflection) {
-  return DxcCreateInstance(CLSID_DxcContainerReflection,
-                           __uuidof(IDxcContainerReflection),
-                           (void **)ppReflection);
+  thread_local CComPtr<IDxcContainerReflection> s_pReflection;
+  if (s_pReflection == nullptr) {
+    IFR(DxcCreateInstance(CLSID_DxcContainerReflection,
+                          __uuidof(IDxcContainerReflection),
+                          (void **)&s_pReflection));
+  }
+  s_pReflection.p->AddRef();
+  *ppReflection = s_pReflection.p;
+  return S_OK;
+}
+
+// Seven-bit sources mean the same bytes under every ANSI code page, so tag
+// them UTF-8 up front and spare the compiler its ACP-to-UTF-8 re-encode of
+// the whole buffer.
+static UINT32 CodePageForSource(LPCVOID pSrcData, SIZE_T SrcDataSize) {
+  const BYTE *pBytes = (const BYTE *)pSrcData;
+  for (SIZE_T i = 0; i < SrcDataSize; ++i) {
+    if (pBytes[i] & 0x80)
+      return CP_ACP;
+  }
+  return CP_UTF8;
+}
+
+// Translate FXC-style Flags1 into dxc arguments once per distinct flag
+// combination per thread; callers cycle through a handful of combinations
+// across thousands of compiles. Every string is a literal, so the cached
+// vectors can be handed out by reference.
+static const std::vector<LPCWSTR> &ArgumentsForFlags(UINT Flags1) {
+  thread_local std::map<UINT, std::vector<LPCWSTR>> s_argsCache;
+  auto cached = s_argsCache.find(Flags1);
+  if (cached != s_argsCache.end())
+    return cached->second;
+
+  std::vector<LPCWSTR> arguments;
+  if(Flags1 & D3DCOMPILE_ENABLE_BACKWARDS_COMPATIBILITY) arguments.push_back(L"/Gec");
+  // /Ges Not implemented:
+  //if(Flags1 & D3DCOMPILE_ENABLE_STRICTNESS) arguments.push_back(L"/Ges");
+  if(Flags1 & D3DCOMPILE_IEEE_STRICTNESS) arguments.push_back(L"/Gis");
+  if(Flags1 & D3DCOMPILE_OPTIMIZATION_LEVEL2)
+  {
+    switch(Flags1 & D3DCOMPILE_OPTIMIZATION_LEVEL2)
+    {
+    case D3DCOMPILE_OPTIMIZATION_LEVEL0: arguments.push_back(L"/O0"); break;
+    case D3DCOMPILE_OPTIMIZATION_LEVEL2: arguments.push_back(L"/O2"); break;
+    case D3DCOMPILE_OPTIMIZATION_LEVEL3: arguments.push_back(L"/O3"); break;
+    }
+  }
+  // Currently, /Od turns off too many optimization passes, causing incorrect DXIL to be generated.
+  // Re-enable once /Od is implemented properly:
+  //if(Flags1 & D3DCOMPILE_SKIP_OPTIMIZATION) arguments.push_back(L"/Od");
+  if(Flags1 & D3DCOMPILE_DEBUG) arguments.push_back(L"/Zi");
+  if(Flags1 & D3DCOMPILE_PACK_MATRIX_ROW_MAJOR) arguments.push_back(L"/Zpr");
+  if(Flags1 & D3DCOMPILE_PACK_MATRIX_COLUMN_MAJOR) arguments.push_back(L"/Zpc");
+  if(Flags1 & D3DCOMPILE_AVOID_FLOW_CONTROL) arguments.push_back(L"/Gfa");
+  if(Flags1 & D3DCOMPILE_PREFER_FLOW_CONTROL) arguments.push_back(L"/Gfp");
+  // We don't implement this:
+  //if(Flags1 & D3DCOMPILE_PARTIAL_PRECISION) arguments.push_back(L"/Gpp");
+  if(Flags1 & D3DCOMPILE_RESOURCES_MAY_ALIAS) arguments.push_back(L"/res_may_alias");
+  arguments.push_back(L"-HV");
+  arguments.push_back(L"2016");
+
+  return s_argsCache.emplace(Flags1, std::move(arguments)).first->second;
 }
 
 HRESULT CompileFromBlob(IDxcBlobEncoding *pSource, LPCWSTR pSourceName,
@@ -79,33 +156,7 @@ HRESULT CompileFromBlob(IDxcBlobEncoding *pSource, LPCWSTR pSourceName,
       }
     }
 
-    std::vector<LPCWSTR> arguments;
-    if(Flags1 & D3DCOMPILE_ENABLE_BACKWARDS_COMPATIBILITY) arguments.push_back(L"/Gec");
-    // /Ges Not implemented:
-    //if(Flags1 & D3DCOMPILE_ENABLE_STRICTNESS) arguments.push_back(L"/Ges");
-    if(Flags1 & D3DCOMPILE_IEEE_STRICTNESS) arguments.push_back(L"/Gis");
-    if(Flags1 & D3DCOMPILE_OPTIMIZATION_LEVEL2)
-    {
-      switch(Flags1 & D3DCOMPILE_OPTIMIZATION_LEVEL2)
-      {
-      case D3DCOMPILE_OPTIMIZATION_LEVEL0: arguments.push_back(L"/O0"); break;
-      case D3DCOMPILE_OPTIMIZATION_LEVEL2: arguments.push_back(L"/O2"); break;
-      case D3DCOMPILE_OPTIMIZATION_LEVEL3: arguments.push_back(L"/O3"); break;
-      }
-    }
-    // Currently, /Od turns off too many optimization passes, causing incorrect DXIL to be generated.
-    // Re-enable once /Od is implemented properly:
-    //if(Flags1 & D3DCOMPILE_SKIP_OPTIMIZATION) arguments.push_back(L"/Od");
-    if(Flags1 & D3DCOMPILE_DEBUG) arguments.push_back(L"/Zi");
-    if(Flags1 & D3DCOMPILE_PACK_MATRIX_ROW_MAJOR) arguments.push_back(L"/Zpr");
-    if(Flags1 & D3DCOMPILE_PACK_MATRIX_COLUMN_MAJOR) arguments.push_back(L"/Zpc");
-    if(Flags1 & D3DCOMPILE_AVOID_FLOW_CONTROL) arguments.push_back(L"/Gfa");
-    if(Flags1 & D3DCOMPILE_PREFER_FLOW_CONTROL) arguments.push_back(L"/Gfp");
-    // We don't implement this:
-    //if(Flags1 & D3DCOMPILE_PARTIAL_PRECISION) arguments.push_back(L"/Gpp");
-    if(Flags1 & D3DCOMPILE_RESOURCES_MAY_ALIAS) arguments.push_back(L"/res_may_alias");
-    arguments.push_back(L"-HV");
-    arguments.push_back(L"2016");
+    const std::vector<LPCWSTR> &arguments = ArgumentsForFlags(Flags1);
 
     IFR(CreateCompiler(&compiler));
     IFR(compiler->Compile(pSource, pSourceName, pEntrypointW, pTargetProfileW,
@@ -143,8 +194,9 @@ HRESULT WINAPI BridgeD3DCompile(LPCVOID pSrcData, SIZE_T SrcDataSize,
     *ppErrorMsgs = nullptr;
 
   IFR(CreateLibrary(&library));
-  IFR(library->CreateBlobWithEncodingFromPinned((LPBYTE)pSrcData, SrcDataSize,
-                                                CP_ACP, &source));
+  IFR(library->CreateBlobWithEncodingFromPinned(
+      (LPBYTE)pSrcData, SrcDataSize, CodePageForSource(pSrcData, SrcDataSize),
+      &source));
 
   // Until we actually wrap the include handler, fail if there's a user-supplied handler.
   if (D3D_COMPILE_STANDARD_FILE_INCLUDE == pInclude) {
@@ -345,8 +397,9 @@ HRESULT WINAPI BridgeD3DPreprocess(_In_reads_bytes_(SrcDataSize) LPCVOID pSrcDat
     *ppErrorMsgs = nullptr;
 
   IFR(CreateLibrary(&library));
-  IFR(library->CreateBlobWithEncodingFromPinned((LPBYTE)pSrcData, SrcDataSize,
-                                                CP_ACP, &source));
+  IFR(library->CreateBlobWithEncodingFromPinned(
+      (LPBYTE)pSrcData, SrcDataSize, CodePageForSource(pSrcData, SrcDataSize),
+      &source));
 
   // Until we actually wrap the include handler, fail if there's a user-supplied
   // handler.
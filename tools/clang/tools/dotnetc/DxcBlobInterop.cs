@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// DxcBlobInterop.cs                                                         //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Zero-copy blob helpers for the dxcompiler interop layer.                  //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#region Namespaces.
+
+using System;
+using System.Runtime.InteropServices;
+using System.Text;
+
+#endregion Namespaces.
+
+namespace DotNetDxc
+{
+    /// <summary>
+    /// Exposes a GCHandle-pinned managed buffer as an IDxcBlob without
+    /// copying it into native memory.
+    /// </summary>
+    /// <remarks>
+    /// The pin lives until Dispose, so the caller controls the lifetime
+    /// explicitly: keep the instance alive for the duration of the native
+    /// call (compilation calls are synchronous) and dispose it afterwards to
+    /// unpin the buffer. Only IDxcBlob is implemented - text buffers should
+    /// be UTF-8, which is what the compiler assumes for blobs without
+    /// encoding information.
+    /// </remarks>
+    public sealed class DxcPinnedBlob : IDxcBlob, IDisposable
+    {
+        private readonly byte[] buffer;
+        private GCHandle handle;
+
+        public DxcPinnedBlob(byte[] buffer)
+        {
+            if (buffer == null)
+                throw new ArgumentNullException("buffer");
+            this.buffer = buffer;
+            this.handle = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+        }
+
+        /// <summary>
+        /// Pins UTF-8 encoded text. The encode is the only per-call
+        /// allocation; no further copies are made on the way into the
+        /// compiler.
+        /// </summary>
+        public static DxcPinnedBlob CreateFromText(string text)
+        {
+            return new DxcPinnedBlob(Encoding.UTF8.GetBytes(text));
+        }
+
+        public unsafe char* GetBufferPointer()
+        {
+            if (!this.handle.IsAllocated)
+                throw new ObjectDisposedException("DxcPinnedBlob");
+            return (char*)this.handle.AddrOfPinnedObject();
+        }
+
+        public UInt32 GetBufferSize()
+        {
+            return (UInt32)this.buffer.Length;
+        }
+
+        public void Dispose()
+        {
+            if (this.handle.IsAllocated)
+                this.handle.Free();
+        }
+    }
+
+    /// <summary>
+    /// A view over an IDxcBlob's native memory with explicit lifetime,
+    /// replacing the copy into a managed byte[] for consumers that only
+    /// read the bytes.
+    /// </summary>
+    /// <remarks>
+    /// The view holds the blob's COM reference, which is what keeps the
+    /// native memory alive; Dispose releases it, after which the pointer
+    /// must not be touched. CopyToBytes remains as the escape hatch for
+    /// consumers that genuinely need a managed array.
+    /// </remarks>
+    public sealed class DxcBlobView : IDisposable
+    {
+        private IDxcBlob blob;
+        private readonly bool releaseOnDispose;
+        private readonly IntPtr pointer;
+        private readonly int length;
+
+        public DxcBlobView(IDxcBlob blob) : this(blob, true)
+        {
+        }
+
+        /// <summary>
+        /// Pass false for releaseOnDispose when the blob is owned elsewhere
+        /// and the view should not release its COM reference.
+        /// </summary>
+        public unsafe DxcBlobView(IDxcBlob blob, bool releaseOnDispose)
+        {
+            if (blob == null)
+                throw new ArgumentNullException("blob");
+            this.blob = blob;
+            this.releaseOnDispose = releaseOnDispose;
+            this.pointer = new IntPtr(blob.GetBufferPointer());
+            this.length = (int)blob.GetBufferSize();
+        }
+
+        public IntPtr Pointer
+        {
+            get
+            {
+                if (this.blob == null)
+                    throw new ObjectDisposedException("DxcBlobView");
+                return this.pointer;
+            }
+        }
+
+        public int Length
+        {
+            get { return this.length; }
+        }
+
+        /// <summary>
+        /// A read-only stream directly over the native memory; valid only
+        /// until the view is disposed.
+        /// </summary>
+        public unsafe System.IO.UnmanagedMemoryStream AsStream()
+        {
+            return new System.IO.UnmanagedMemoryStream(
+                (byte*)this.Pointer, this.length, this.length,
+                System.IO.FileAccess.Read);
+        }
+
+        /// <summary>Decodes the bytes as UTF-8 without an intermediate array.</summary>
+        public unsafe string GetUtf8Text()
+        {
+            return Encoding.UTF8.GetString((byte*)this.Pointer, this.length);
+        }
+
+        public unsafe byte[] CopyToBytes()
+        {
+            byte[] bytes = new byte[this.length];
+            Marshal.Copy(this.Pointer, bytes, 0, this.length);
+            return bytes;
+        }
+
+        public void Dispose()
+        {
+            if (this.blob != null)
+            {
+                if (this.releaseOnDispose)
+                    Marshal.ReleaseComObject(this.blob);
+                this.blob = null;
+            }
+        }
+    }
+}
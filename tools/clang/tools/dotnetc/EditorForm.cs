@@ -478,7 +478,14 @@ namespace MainNs
                 if (dialog.ShowDialog(this) != DialogResult.OK)
                     return;
 
-                System.IO.File.WriteAllBytes(dialog.FileName, GetBytesFromBlob(this.SelectedShaderBlob));
+                // Stream the blob's native memory straight to disk; the view
+                // does not own the blob, which stays selected in the UI.
+                using (var view = new DxcBlobView(this.SelectedShaderBlob, false))
+                using (var source = view.AsStream())
+                using (var target = System.IO.File.Create(dialog.FileName))
+                {
+                    source.CopyTo(target);
+                }
             }
         }
 
@@ -19,8 +19,11 @@
 #include "dxc/DxilContainer/DxilContainer.h"
 
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include <dia2.h>
 #include <intsafe.h>
+#include <atomic>
+#include <thread>
 
 using namespace llvm;
 using namespace llvm::opt;
@@ -48,6 +51,18 @@ static cl::opt<bool> ListFiles("listfiles",
 static cl::opt<std::string>
     ExtractFile("extractfile", cl::desc("Extract file from debug information (use '*' for all files)"));
 
+static cl::opt<std::string>
+    Batch("batch", cl::desc("Extract parts from many containers in one process. "
+                            "Each manifest line is <input> <part> <output>; "
+                            "empty lines and lines starting with '#' are ignored"),
+          cl::value_desc("manifest"));
+
+static cl::opt<unsigned>
+    BatchThreads("batch-threads",
+                 cl::desc("Number of worker threads for -batch "
+                          "(default: hardware concurrency)"),
+                 cl::init(0));
+
 
 class DxaContext {
 
@@ -61,6 +76,9 @@ public:
   void Assemble();
   bool ExtractFile(const char *pName);
   bool ExtractPart(const char *pName);
+  bool ExtractPart(IDxcBlob *pSource, const char *pName, bool extractModule,
+                   llvm::StringRef outputName);
+  bool RunBatch(llvm::StringRef manifestPath, unsigned threadCount);
   void ListFiles();
   void ListParts();
 };
@@ -250,23 +268,52 @@ bool DxaContext::ExtractFile(const char *pName) {
   return printedAny;
 }
 
-bool DxaContext::ExtractPart(const char *pName) {
-  CComPtr<IDxcContainerReflection> pReflection;
-  CComPtr<IDxcBlobEncoding> pSource;
-  UINT32 partCount;
-
+// Translates the 'module'/'dbgmodule' aliases to their part names and reports
+// whether the program header must be skipped when extracting.
+static const char *TranslatePartName(const char *pName, bool *pExtractModule) {
   // If the part name is 'module', don't just extract the part,
   // but also skip the appropriate header.
-  bool extractModule = strcmp("module", pName) == 0;
-  if (extractModule) {
-    pName = "DXIL";
+  *pExtractModule = strcmp("module", pName) == 0;
+  if (*pExtractModule) {
+    return "DXIL";
   }
   if (strcmp("dbgmodule", pName) == 0) {
-    pName = "ILDB";
-    extractModule = true;
+    *pExtractModule = true;
+    return "ILDB";
   }
+  return pName;
+}
 
+bool DxaContext::ExtractPart(const char *pName) {
+  bool extractModule;
+  pName = TranslatePartName(pName, &extractModule);
+
+  if (OutputFilename.empty()) {
+    if (InputFilename == "-") {
+      OutputFilename = "-";
+    }
+    else {
+      OutputFilename = InputFilename.getValue();
+      OutputFilename += ".";
+      if (extractModule) {
+        OutputFilename += "ll";
+      }
+      else {
+        OutputFilename += pName;
+      }
+    }
+  }
+
+  CComPtr<IDxcBlobEncoding> pSource;
   ReadFileIntoBlob(m_dxcSupport, StringRefUtf16(InputFilename), &pSource);
+  return ExtractPart(pSource, pName, extractModule, OutputFilename);
+}
+
+bool DxaContext::ExtractPart(IDxcBlob *pSource, const char *pName,
+                             bool extractModule, llvm::StringRef outputName) {
+  CComPtr<IDxcContainerReflection> pReflection;
+  UINT32 partCount;
+
   IFT(m_dxcSupport.CreateInstance(CLSID_DxcContainerReflection, &pReflection));
   IFT(pReflection->Load(pSource));
   IFT(pReflection->GetPartCount(&partCount));
@@ -279,21 +326,6 @@ bool DxaContext::ExtractPart(const char *pName) {
     if (partKind == matchName) {
       CComPtr<IDxcBlob> pContent;
       IFT(pReflection->GetPartContent(i, &pContent));
-      if (OutputFilename.empty()) {
-        if (InputFilename == "-") {
-          OutputFilename = "-";
-        }
-        else {
-          OutputFilename = InputFilename.getValue();
-          OutputFilename += ".";
-          if (extractModule) {
-            OutputFilename += "ll";
-          }
-          else {
-            OutputFilename += pName;
-          }
-        }
-      }
 
       if (extractModule) {
         char *pDxilPart = (char *)pContent->GetBufferPointer();
@@ -310,14 +342,84 @@ bool DxaContext::ExtractPart(const char *pName) {
         std::swap(pModuleBlob, pContent);
       }
 
-      WriteBlobToFile(pContent, StringRefUtf16(OutputFilename), DXC_CP_UTF8); // TODO: Support DefaultTextCodePage
-      printf("%Iu bytes written to %s\n", pContent->GetBufferSize(), OutputFilename.c_str());
+      WriteBlobToFile(pContent, StringRefUtf16(outputName), DXC_CP_UTF8); // TODO: Support DefaultTextCodePage
+      printf("%Iu bytes written to %s\n", pContent->GetBufferSize(), outputName.str().c_str());
       return true;
     }
   }
   return false;
 }
 
+bool DxaContext::RunBatch(llvm::StringRef manifestPath, unsigned threadCount) {
+  struct BatchItem {
+    std::string Input;
+    std::string Part;
+    std::string Output;
+  };
+
+  ErrorOr<std::unique_ptr<MemoryBuffer>> manifest =
+      MemoryBuffer::getFileOrSTDIN(manifestPath);
+  IFTARG(!manifest.getError());
+
+  std::vector<BatchItem> items;
+  SmallVector<StringRef, 32> lines;
+  (*manifest)->getBuffer().split(lines, '\n', /*MaxSplit*/ -1,
+                                 /*KeepEmpty*/ false);
+  for (StringRef line : lines) {
+    line = line.trim();
+    if (line.empty() || line.startswith("#"))
+      continue;
+    SmallVector<StringRef, 3> fields;
+    line.split(fields, ' ', /*MaxSplit*/ -1, /*KeepEmpty*/ false);
+    if (fields.size() != 3) {
+      printf("Invalid manifest line: %s\n", line.str().c_str());
+      return false;
+    }
+    items.push_back({fields[0].str(), fields[1].str(), fields[2].str()});
+  }
+
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  threadCount = std::min(threadCount, (unsigned)std::max<size_t>(1, items.size()));
+
+  // Each worker pulls the next item; the container reflection objects are
+  // created per extraction, so workers share nothing but the DLL support.
+  std::atomic<size_t> nextItem(0);
+  std::atomic<unsigned> failedCount(0);
+  std::vector<std::thread> workers;
+  workers.reserve(threadCount);
+  for (unsigned t = 0; t < threadCount; ++t) {
+    workers.emplace_back([&]() {
+      for (;;) {
+        size_t i = nextItem.fetch_add(1);
+        if (i >= items.size())
+          return;
+        const BatchItem &item = items[i];
+        try {
+          bool extractModule;
+          const char *pName = TranslatePartName(item.Part.c_str(), &extractModule);
+          CComPtr<IDxcBlobEncoding> pSource;
+          ReadFileIntoBlob(m_dxcSupport, StringRefUtf16(item.Input), &pSource);
+          if (!ExtractPart(pSource, pName, extractModule, item.Output)) {
+            printf("Part %s not found in %s\n", item.Part.c_str(),
+                   item.Input.c_str());
+            ++failedCount;
+          }
+        } catch (const ::hlsl::Exception &e) {
+          printf("Failed to extract %s from %s - error code 0x%08x.\n",
+                 item.Part.c_str(), item.Input.c_str(), e.hr);
+          ++failedCount;
+        }
+      }
+    });
+  }
+  for (std::thread &worker : workers)
+    worker.join();
+
+  printf("%Iu extractions, %u failed\n", items.size(), failedCount.load());
+  return failedCount == 0;
+}
+
 void DxaContext::ListParts() {
   CComPtr<IDxcBlobEncoding> pSource;
   ReadFileIntoBlob(m_dxcSupport, StringRefUtf16(InputFilename), &pSource);
@@ -367,6 +469,12 @@ int __cdecl main(int argc, _In_reads_z_(argc) char **argv) {
       pStage = "Listing files";
       context.ListFiles();
     }
+    else if (!Batch.empty()) {
+      pStage = "Batch processing";
+      if (!context.RunBatch(Batch, BatchThreads)) {
+        return 1;
+      }
+    }
     else if (!ExtractPart.empty()) {
       pStage = "Extracting part";
       if (!context.ExtractPart(ExtractPart.c_str())) {
@@ -0,0 +1,237 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// dxarc.cpp                                                                 //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Provides the entry point for the dxarc console program, which packs many  //
+// DXIL containers into one shader archive with cross-container part         //
+// deduplication, and extracts containers back out of an archive.            //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/Support/Global.h"
+#include "dxc/Support/Unicode.h"
+#include "dxc/Support/WinIncludes.h"
+
+#include "dxc/DxilContainer/DxilContainer.h"
+#include "dxc/DxilContainer/DxilShaderArchive.h"
+#include "dxc/dxcapi.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+using namespace hlsl;
+
+static cl::opt<std::string>
+    InputFilename(cl::Positional,
+                  cl::desc("<input archive, or manifest with -create>"),
+                  cl::init("-"));
+
+static cl::opt<std::string> OutputFilename("o",
+                                           cl::desc("Override output filename"),
+                                           cl::value_desc("filename"));
+
+static cl::opt<bool>
+    Create("create",
+           cl::desc("Create an archive. Each manifest line is "
+                    "<container-file> [shader-name]; the name defaults to "
+                    "the file path. Empty lines and lines starting with "
+                    "'#' are ignored"),
+           cl::init(false));
+
+static cl::opt<bool> List("list",
+                          cl::desc("List shaders in the input archive"),
+                          cl::init(false));
+
+static cl::opt<bool> Stats("stats",
+                           cl::desc("Print part store statistics for the "
+                                    "input archive"),
+                           cl::init(false));
+
+static cl::opt<std::string>
+    Extract("extract",
+            cl::desc("Extract one shader's container from the input archive"),
+            cl::value_desc("shader-name"));
+
+static int CreateArchive() {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> manifest =
+      MemoryBuffer::getFileOrSTDIN(InputFilename);
+  IFTARG(!manifest.getError());
+  IFTARG(!OutputFilename.empty());
+
+  DxilShaderArchiveWriter writer;
+  SmallVector<StringRef, 32> lines;
+  (*manifest)->getBuffer().split(lines, '\n', /*MaxSplit*/ -1,
+                                 /*KeepEmpty*/ false);
+  for (StringRef line : lines) {
+    line = line.trim();
+    if (line.empty() || line.startswith("#"))
+      continue;
+    std::pair<StringRef, StringRef> fields = line.split(' ');
+    StringRef file = fields.first;
+    StringRef name = fields.second.trim().empty() ? file : fields.second.trim();
+
+    ErrorOr<std::unique_ptr<MemoryBuffer>> container =
+        MemoryBuffer::getFile(file);
+    if (container.getError()) {
+      printf("Cannot read container file %s\n", file.str().c_str());
+      return 1;
+    }
+    if (FAILED(writer.AddShader(name, (*container)->getBufferStart(),
+                                (uint32_t)(*container)->getBufferSize()))) {
+      printf("Invalid container or duplicate shader name: %s\n",
+             name.str().c_str());
+      return 1;
+    }
+  }
+
+  std::error_code EC;
+  raw_fd_ostream OS(OutputFilename, EC, sys::fs::F_None);
+  if (EC) {
+    printf("Cannot write output file %s\n", OutputFilename.c_str());
+    return 1;
+  }
+  writer.Write(OS);
+  OS.flush();
+
+  printf("%u shaders, %u unique parts\n", writer.GetShaderCount(),
+         writer.GetUniquePartCount());
+  printf("%llu container bytes in, %llu unique part bytes kept\n",
+         (unsigned long long)writer.GetInputSizeInBytes(),
+         (unsigned long long)writer.GetUniquePartSizeInBytes());
+  printf("Output written to \"%s\"\n", OutputFilename.c_str());
+  return 0;
+}
+
+// Maps the archive (MemoryBuffer prefers mmap for large files, so shared
+// parts stay hot in page cache across runs) and loads the reader over it.
+static std::unique_ptr<MemoryBuffer>
+LoadArchive(DxilShaderArchiveReader &reader) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> archive =
+      MemoryBuffer::getFileOrSTDIN(InputFilename);
+  IFTARG(!archive.getError());
+  IFT(reader.Load((*archive)->getBufferStart(),
+                  (*archive)->getBufferSize()));
+  return std::move(*archive);
+}
+
+static int ListShaders() {
+  DxilShaderArchiveReader reader;
+  std::unique_ptr<MemoryBuffer> archive = LoadArchive(reader);
+
+  printf("Shader count: %u\n", reader.GetShaderCount());
+  for (uint32_t i = 0; i < reader.GetShaderCount(); ++i) {
+    const char *pName;
+    uint32_t containerSize;
+    IFT(reader.GetShaderName(i, &pName));
+    IFT(reader.GetShaderContainerSize(i, &containerSize));
+    printf("#%u - %s (%u bytes)\n", i, pName, containerSize);
+  }
+  return 0;
+}
+
+static int PrintStats() {
+  DxilShaderArchiveReader reader;
+  std::unique_ptr<MemoryBuffer> archive = LoadArchive(reader);
+
+  uint64_t containerBytes = 0;
+  for (uint32_t i = 0; i < reader.GetShaderCount(); ++i) {
+    uint32_t containerSize;
+    IFT(reader.GetShaderContainerSize(i, &containerSize));
+    containerBytes += containerSize;
+  }
+  printf("Shader count: %u\n", reader.GetShaderCount());
+  printf("Unique part count: %u\n", reader.GetPartCount());
+  printf("Archive size: %llu bytes\n",
+         (unsigned long long)archive->getBufferSize());
+  printf("Reconstituted container total: %llu bytes\n",
+         (unsigned long long)containerBytes);
+  return 0;
+}
+
+static int ExtractShader(StringRef name) {
+  DxilShaderArchiveReader reader;
+  std::unique_ptr<MemoryBuffer> archive = LoadArchive(reader);
+
+  uint32_t index;
+  if (FAILED(reader.FindShader(name, &index))) {
+    printf("Shader %s not found in archive\n", name.str().c_str());
+    return 1;
+  }
+
+  if (OutputFilename.empty()) {
+    OutputFilename = name.str();
+    OutputFilename += ".dxbc";
+  }
+
+  // The zero-copy view (for contiguous shaders) borrows the archive
+  // mapping, so the blob is written and released before it goes away.
+  CComPtr<IDxcBlob> pContainer;
+  IFT(reader.GetShaderContainer(index, nullptr, &pContainer));
+
+  std::error_code EC;
+  raw_fd_ostream OS(OutputFilename, EC, sys::fs::F_None);
+  if (EC) {
+    printf("Cannot write output file %s\n", OutputFilename.c_str());
+    return 1;
+  }
+  OS.write((const char *)pContainer->GetBufferPointer(),
+           pContainer->GetBufferSize());
+  OS.flush();
+  printf("%u bytes written to %s\n", (unsigned)pContainer->GetBufferSize(),
+         OutputFilename.c_str());
+  return 0;
+}
+
+int __cdecl main(int argc, _In_reads_z_(argc) char **argv) {
+  const char *pStage = "Operation";
+  try {
+    pStage = "Argument processing";
+    cl::ParseCommandLineOptions(argc, argv, "dxil shader archiver\n");
+
+    if (Create) {
+      pStage = "Creating archive";
+      return CreateArchive();
+    } else if (List) {
+      pStage = "Listing shaders";
+      return ListShaders();
+    } else if (Stats) {
+      pStage = "Printing statistics";
+      return PrintStats();
+    } else if (!Extract.empty()) {
+      pStage = "Extracting shader";
+      return ExtractShader(Extract);
+    } else {
+      printf("Specify one of -create, -list, -stats or -extract.\n");
+      return 1;
+    }
+  } catch (const ::hlsl::Exception &hlslException) {
+    try {
+      const char *msg = hlslException.what();
+      Unicode::acp_char printBuffer[128]; // printBuffer is safe to treat as
+                                          // UTF-8 because we use ASCII errors
+                                          // only
+      if (msg == nullptr || *msg == '\0') {
+        sprintf_s(printBuffer, _countof(printBuffer),
+                  "Operation failed - error code 0x%08x.", hlslException.hr);
+        msg = printBuffer;
+      }
+      printf("%s\n", msg);
+    } catch (...) {
+      printf("%s failed - unable to retrieve error message.\n", pStage);
+    }
+    return 1;
+  } catch (std::bad_alloc &) {
+    printf("%s failed - out of memory.\n", pStage);
+    return 1;
+  } catch (...) {
+    printf("%s failed - unknown error.\n", pStage);
+    return 1;
+  }
+}
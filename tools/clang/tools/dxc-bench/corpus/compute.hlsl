@@ -0,0 +1,24 @@
+//bench-args: -T cs_6_0 -E main
+// Reduction-style compute shader with group shared memory traffic.
+
+RWStructuredBuffer<float4> Output : register(u0);
+StructuredBuffer<float4> Input : register(t0);
+
+groupshared float4 Partial[256];
+
+[numthreads(256, 1, 1)]
+void main(uint3 gtid : SV_GroupThreadID, uint3 gid : SV_GroupID) {
+  uint index = gid.x * 256 + gtid.x;
+  Partial[gtid.x] = Input[index];
+  GroupMemoryBarrierWithGroupSync();
+
+  [unroll]
+  for (uint stride = 128; stride > 0; stride >>= 1) {
+    if (gtid.x < stride)
+      Partial[gtid.x] += Partial[gtid.x + stride];
+    GroupMemoryBarrierWithGroupSync();
+  }
+
+  if (gtid.x == 0)
+    Output[gid.x] = Partial[0];
+}
@@ -0,0 +1,40 @@
+//bench-args: -T lib_6_3
+// Minimal raytracing library: raygen, closest hit and miss shaders.
+
+RaytracingAccelerationStructure Scene : register(t0);
+RWTexture2D<float4> RenderTarget : register(u0);
+
+struct RayPayload {
+  float4 color;
+};
+
+[shader("raygeneration")]
+void RayGen() {
+  uint2 launchIndex = DispatchRaysIndex().xy;
+  uint2 launchDim = DispatchRaysDimensions().xy;
+  float2 uv = (launchIndex + 0.5f) / float2(launchDim);
+
+  RayDesc ray;
+  ray.Origin = float3(uv * 2.0f - 1.0f, -1.0f);
+  ray.Direction = float3(0, 0, 1);
+  ray.TMin = 0.001f;
+  ray.TMax = 10000.0f;
+
+  RayPayload payload = { float4(0, 0, 0, 0) };
+  TraceRay(Scene, RAY_FLAG_NONE, ~0, 0, 1, 0, ray, payload);
+  RenderTarget[launchIndex] = payload.color;
+}
+
+[shader("closesthit")]
+void ClosestHit(inout RayPayload payload,
+                BuiltInTriangleIntersectionAttributes attr) {
+  float3 bary = float3(
+      1 - attr.barycentrics.x - attr.barycentrics.y,
+      attr.barycentrics.x, attr.barycentrics.y);
+  payload.color = float4(bary, RayTCurrent() / 10000.0f);
+}
+
+[shader("miss")]
+void Miss(inout RayPayload payload) {
+  payload.color = float4(0.2f, 0.4f, 0.8f, 1.0f);
+}
@@ -0,0 +1,42 @@
+//bench-args: -T hs_6_0 -E main
+// Triangle-patch hull shader with a patch constant function.
+
+struct VSOut {
+  float3 pos : POSITION;
+  float3 normal : NORMAL;
+};
+
+struct HSOut {
+  float3 pos : POSITION;
+  float3 normal : NORMAL;
+};
+
+struct PatchConstants {
+  float edges[3] : SV_TessFactor;
+  float inside : SV_InsideTessFactor;
+};
+
+cbuffer TessParams : register(b0) {
+  float g_TessLevel;
+};
+
+PatchConstants PatchConstantFunc(InputPatch<VSOut, 3> patch) {
+  PatchConstants pc;
+  pc.edges[0] = g_TessLevel;
+  pc.edges[1] = g_TessLevel;
+  pc.edges[2] = g_TessLevel;
+  pc.inside = g_TessLevel;
+  return pc;
+}
+
+[domain("tri")]
+[partitioning("fractional_odd")]
+[outputtopology("triangle_cw")]
+[outputcontrolpoints(3)]
+[patchconstantfunc("PatchConstantFunc")]
+HSOut main(InputPatch<VSOut, 3> patch, uint i : SV_OutputControlPointID) {
+  HSOut output;
+  output.pos = patch[i].pos;
+  output.normal = patch[i].normal;
+  return output;
+}
@@ -0,0 +1,73 @@
+//bench-args: -T ps_6_0 -E main -O3
+// Uber-shader style pixel shader: many resources, branches and loops that
+// stress optimization and lowering rather than any one feature.
+
+Texture2D Albedo : register(t0);
+Texture2D Normals : register(t1);
+Texture2D Roughness : register(t2);
+Texture2D Shadow : register(t3);
+SamplerState LinearSampler : register(s0);
+SamplerComparisonState ShadowSampler : register(s1);
+
+struct Light {
+  float3 position;
+  float radius;
+  float3 color;
+  float intensity;
+};
+
+cbuffer Frame : register(b0) {
+  float4x4 g_ViewProj;
+  float3 g_CameraPos;
+  uint g_LightCount;
+  uint g_Flags;
+};
+
+StructuredBuffer<Light> Lights : register(t4);
+
+struct PSIn {
+  float4 pos : SV_Position;
+  float3 worldPos : POSITION;
+  float3 normal : NORMAL;
+  float2 uv : TEXCOORD0;
+};
+
+float3 ShadeLight(Light light, float3 worldPos, float3 n, float3 v,
+                  float3 albedo, float rough) {
+  float3 toLight = light.position - worldPos;
+  float dist = length(toLight);
+  if (dist > light.radius)
+    return 0;
+  float3 l = toLight / dist;
+  float ndl = saturate(dot(n, l));
+  float3 h = normalize(l + v);
+  float ndh = saturate(dot(n, h));
+  float spec = pow(ndh, lerp(256.0f, 4.0f, rough));
+  float atten = saturate(1.0f - dist / light.radius);
+  return (albedo * ndl + spec) * light.color * (light.intensity * atten * atten);
+}
+
+float4 main(PSIn input) : SV_Target {
+  float3 albedo = Albedo.Sample(LinearSampler, input.uv).rgb;
+  float3 n = normalize(input.normal);
+  if (g_Flags & 1) {
+    float3 tangentNormal =
+        Normals.Sample(LinearSampler, input.uv).xyz * 2.0f - 1.0f;
+    n = normalize(n + tangentNormal);
+  }
+  float rough = Roughness.Sample(LinearSampler, input.uv).r;
+  float3 v = normalize(g_CameraPos - input.worldPos);
+
+  float3 color = 0.05f * albedo;
+  for (uint i = 0; i < g_LightCount; ++i)
+    color += ShadeLight(Lights[i], input.worldPos, n, v, albedo, rough);
+
+  if (g_Flags & 2) {
+    float4 shadowPos = mul(float4(input.worldPos, 1.0f), g_ViewProj);
+    shadowPos.xyz /= shadowPos.w;
+    float2 shadowUV = shadowPos.xy * float2(0.5f, -0.5f) + 0.5f;
+    color *= Shadow.SampleCmpLevelZero(ShadowSampler, shadowUV, shadowPos.z);
+  }
+
+  return float4(color, 1.0f);
+}
@@ -42,6 +42,15 @@
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/Support/WinFunctions.h"
 #include "dxc.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 #include <string>
 
@@ -59,6 +68,7 @@
 #include "llvm/Option/ArgList.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #ifdef _WIN32
 #include <dia2.h>
 #include <comdef.h>
@@ -115,6 +125,95 @@ using namespace dxc;
 using namespace llvm::opt;
 using namespace hlsl::options;
 
+// Writes completed output blobs on a background thread so that disk latency
+// overlaps whatever work the job still has to do - further outputs,
+// disassembly, or the next compile in -batch/-server mode. Each queued job
+// holds its own blob reference; the first failed write is captured and
+// rethrown from Flush so it surfaces through the regular error path before
+// the job's exit code is decided.
+class AsyncBlobWriter {
+public:
+  ~AsyncBlobWriter() {
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Shutdown = true;
+    }
+    m_CV.notify_all();
+    // The worker drains the queue before exiting, so writes queued after the
+    // last Flush still land; only their errors are lost.
+    if (m_Worker.joinable())
+      m_Worker.join();
+  }
+
+  void Write(_In_opt_ IDxcBlob *pBlob, _In_ LPCWSTR pFileName,
+             UINT32 textCodePage) {
+    if (pBlob == nullptr)
+      return;
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    if (!m_Worker.joinable())
+      m_Worker = std::thread(&AsyncBlobWriter::WorkerLoop, this);
+    m_Queue.push_back(Job{pBlob, pFileName, textCodePage});
+    ++m_Pending;
+    m_CV.notify_one();
+  }
+
+  // Drains the queue and rethrows the first write failure, if any.
+  void Flush() {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_CV.wait(lock, [this] { return m_Pending == 0; });
+    if (m_FailedHr != S_OK) {
+      HRESULT hr = m_FailedHr;
+      m_FailedHr = S_OK;
+      throw ::hlsl::Exception(hr, m_FailedMsg);
+    }
+  }
+
+private:
+  struct Job {
+    CComPtr<IDxcBlob> Blob;
+    std::wstring FileName;
+    UINT32 CodePage = 0;
+  };
+
+  void WorkerLoop() {
+    DxcSetThreadMallocToDefault();
+    for (;;) {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_CV.wait(lock, [this] { return m_Shutdown || !m_Queue.empty(); });
+        if (m_Queue.empty())
+          return;
+        job = std::move(m_Queue.front());
+        m_Queue.pop_front();
+      }
+      try {
+        ::dxc::WriteBlobToFile(job.Blob, job.FileName.c_str(), job.CodePage);
+      } catch (const ::hlsl::Exception &e) {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        if (m_FailedHr == S_OK) {
+          m_FailedHr = e.hr;
+          m_FailedMsg = e.msg;
+        }
+      }
+      {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        --m_Pending;
+      }
+      m_CV.notify_all();
+    }
+  }
+
+  std::mutex m_Mutex;
+  std::condition_variable m_CV;
+  std::deque<Job> m_Queue;
+  std::thread m_Worker;
+  size_t m_Pending = 0; // queued plus in-flight writes
+  bool m_Shutdown = false;
+  HRESULT m_FailedHr = S_OK;
+  std::string m_FailedMsg;
+};
+
 class DxcContext {
 
 private:
@@ -139,6 +238,13 @@ private:
   void ExtractRootSignature(IDxcBlob *pBlob, IDxcBlob **ppResult);
   int VerifyRootSignature();
 
+  // File outputs funnel through the async writer; callers that need the file
+  // on disk (or the error) must go through FlushOutputWrites.
+  void WriteBlobToFile(_In_opt_ IDxcBlob *pBlob, llvm::StringRef FName, UINT32 defaultTextCodePage);
+  void WriteBlobToFile(_In_opt_ IDxcBlob *pBlob, _In_ LPCWSTR pFileName, UINT32 defaultTextCodePage);
+  void WriteDxcOutputToFile(DXC_OUT_KIND kind, IDxcResult *pResult, UINT32 textCodePage);
+  AsyncBlobWriter m_OutputWriter;
+
   template <typename TInterface>
   HRESULT CreateInstance(REFCLSID clsid, _Outptr_ TInterface** pResult) {
   return m_dxcSupport.CreateInstance(clsid, pResult);
@@ -150,6 +256,7 @@ public:
   }
 
   int  Compile();
+  int  ScanDeps();
   void Recompile(IDxcBlob *pSource, IDxcLibrary *pLibrary,
                  IDxcCompiler *pCompiler, std::vector<LPCWSTR> &args,
                  std::wstring &outputPDBPath, CComPtr<IDxcBlob> &pDebugBlob,
@@ -157,10 +264,18 @@ public:
   int DumpBinary();
   void Preprocess();
   void GetCompilerVersionInfo(llvm::raw_string_ostream &OS);
+
+  // Waits for queued output writes and rethrows the first failure; call
+  // before the job's exit code is decided.
+  void FlushOutputWrites() { m_OutputWriter.Flush(); }
 };
 
-static void WriteBlobToFile(_In_opt_ IDxcBlob *pBlob, llvm::StringRef FName, UINT32 defaultTextCodePage) {
-  ::dxc::WriteBlobToFile(pBlob, StringRefUtf16(FName), defaultTextCodePage);
+void DxcContext::WriteBlobToFile(_In_opt_ IDxcBlob *pBlob, llvm::StringRef FName, UINT32 defaultTextCodePage) {
+  m_OutputWriter.Write(pBlob, StringRefUtf16(FName), defaultTextCodePage);
+}
+
+void DxcContext::WriteBlobToFile(_In_opt_ IDxcBlob *pBlob, _In_ LPCWSTR pFileName, UINT32 defaultTextCodePage) {
+  m_OutputWriter.Write(pBlob, pFileName, defaultTextCodePage);
 }
 
 static void WritePartToFile(IDxcBlob *pBlob, hlsl::DxilFourCC CC,
@@ -191,7 +306,7 @@ static void WritePartToFile(IDxcBlob *pBlob, hlsl::DxilFourCC CC,
   }
 }
 
-static void WriteDxcOutputToFile(DXC_OUT_KIND kind, IDxcResult *pResult, UINT32 textCodePage) {
+void DxcContext::WriteDxcOutputToFile(DXC_OUT_KIND kind, IDxcResult *pResult, UINT32 textCodePage) {
   if (pResult->HasOutput(kind)) {
     CComPtr<IDxcBlob> pData;
     CComPtr<IDxcBlobUtf16> pName;
@@ -741,7 +856,42 @@ void DxcContext::Recompile(IDxcBlob *pSource, IDxcLibrary *pLibrary,
 #endif // _WIN32
 }
 
+// Fails the compile when two runs over identical inputs disagree on a single
+// output byte; content-addressed caches treat any such diff as a new shader.
+static void VerifyCompileResultsMatch(IDxcOperationResult *pFirst,
+                                      IDxcOperationResult *pSecond) {
+  HRESULT firstStatus, secondStatus;
+  IFT(pFirst->GetStatus(&firstStatus));
+  IFT(pSecond->GetStatus(&secondStatus));
+  if (FAILED(firstStatus) || FAILED(secondStatus)) {
+    // Compile errors surface through the normal reporting path.
+    if (firstStatus != secondStatus)
+      throw ::hlsl::Exception(
+          E_FAIL, "determinism check failed: two identical compiles did not "
+                  "agree on compilation status");
+    return;
+  }
+  CComPtr<IDxcBlob> pFirstBlob, pSecondBlob;
+  IFT(pFirst->GetResult(&pFirstBlob));
+  IFT(pSecond->GetResult(&pSecondBlob));
+  if (pFirstBlob == nullptr && pSecondBlob == nullptr)
+    return;
+  if (pFirstBlob == nullptr || pSecondBlob == nullptr ||
+      pFirstBlob->GetBufferSize() != pSecondBlob->GetBufferSize() ||
+      0 != memcmp(pFirstBlob->GetBufferPointer(),
+                  pSecondBlob->GetBufferPointer(),
+                  pFirstBlob->GetBufferSize()))
+    throw ::hlsl::Exception(
+        E_FAIL, "determinism check failed: two identical compiles produced "
+                "different output bytes");
+}
+
 int DxcContext::Compile() {
+  if (m_Opts.VerifyDeterministic &&
+      (m_Opts.RecompileFromBinary || !m_Opts.DebugFile.empty()))
+    throw ::hlsl::Exception(E_INVALIDARG,
+                            "-verify-deterministic is not supported with "
+                            "-recompile or -Fd");
   CComPtr<IDxcCompiler> pCompiler;
   CComPtr<IDxcOperationResult> pCompileResult;
   CComPtr<IDxcBlob> pDebugBlob;
@@ -804,6 +954,18 @@ int DxcContext::Compile() {
           StringRefUtf16(TargetProfile), args.data(),
           args.size(), m_Opts.Defines.data(),
           m_Opts.Defines.size(), pIncludeHandler, &pCompileResult));
+
+        // CI self-check: rerun the identical compile and require identical
+        // bytes before anything downstream caches the result.
+        if (m_Opts.VerifyDeterministic) {
+          CComPtr<IDxcOperationResult> pSecondResult;
+          IFT(pCompiler->Compile(pSource, StringRefUtf16(m_Opts.InputFile),
+            StringRefUtf16(m_Opts.EntryPoint),
+            StringRefUtf16(TargetProfile), args.data(),
+            args.size(), m_Opts.Defines.data(),
+            m_Opts.Defines.size(), pIncludeHandler, &pSecondResult));
+          VerifyCompileResultsMatch(pCompileResult, pSecondResult);
+        }
       }
     }
 
@@ -838,6 +1000,7 @@ int DxcContext::Compile() {
         WriteDxcOutputToFile(DXC_OUT_ROOT_SIGNATURE, pResult, m_Opts.DefaultTextCodePage);
         WriteDxcOutputToFile(DXC_OUT_SHADER_HASH, pResult, m_Opts.DefaultTextCodePage);
         WriteDxcOutputToFile(DXC_OUT_REFLECTION, pResult, m_Opts.DefaultTextCodePage);
+        WriteDxcOutputToFile(DXC_OUT_TIME_TRACE, pResult, m_Opts.DefaultTextCodePage);
       }
     }
   }
@@ -888,6 +1051,186 @@ void DxcContext::Preprocess() {
   }
 }
 
+// Shared file contents for -scan-deps. Keyed by the path the scanner resolved;
+// a null entry records a known-missing or unreadable path. Process-wide so a
+// -batch run over a shader tree reads each shared header from disk once; the
+// header tree is assumed immutable for the life of the process, as it is for
+// a build. An entry's string is never mutated after insertion, so concurrent
+// scanners can share the pointers without further locking.
+struct ScanDepsFileCache {
+  std::mutex Mutex;
+  std::unordered_map<std::string, std::shared_ptr<std::string>> Files;
+
+  static ScanDepsFileCache &Instance() {
+    static ScanDepsFileCache Cache;
+    return Cache;
+  }
+
+  // Returns true and the content if path names a readable file.
+  bool TryRead(const std::string &path, std::shared_ptr<std::string> &content) {
+    {
+      std::lock_guard<std::mutex> lock(Mutex);
+      auto it = Files.find(path);
+      if (it != Files.end()) {
+        content = it->second;
+        return content != nullptr;
+      }
+    }
+    std::shared_ptr<std::string> data;
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(path);
+    if (buffer)
+      data = std::make_shared<std::string>((*buffer)->getBuffer().str());
+    {
+      std::lock_guard<std::mutex> lock(Mutex);
+      Files.emplace(path, data);
+    }
+    content = data;
+    return data != nullptr;
+  }
+};
+
+// Collects the names referenced by #include directives in text. The scan is
+// a single pass that only looks at lines starting (after whitespace) with
+// '#', mirroring the include prefetch scan in the compiler: names inside
+// comments or inactive #if regions are acceptable over-approximations for
+// dependency purposes, and computed includes are missed.
+static void ScanIncludeDirectives(llvm::StringRef text,
+                                  std::vector<std::string> &names) {
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t eol = text.find('\n', pos);
+    llvm::StringRef line =
+        text.slice(pos, eol == llvm::StringRef::npos ? text.size() : eol);
+    pos = (eol == llvm::StringRef::npos) ? text.size() : eol + 1;
+    line = line.ltrim(" \t");
+    if (!line.startswith("#"))
+      continue;
+    line = line.drop_front(1).ltrim(" \t");
+    if (!line.startswith("include"))
+      continue;
+    line = line.drop_front(strlen("include")).ltrim(" \t");
+    if (line.empty())
+      continue;
+    char close = line[0] == '"' ? '"' : line[0] == '<' ? '>' : '\0';
+    if (close == '\0')
+      continue;
+    size_t end = line.find(close, 1);
+    if (end == llvm::StringRef::npos || end == 1)
+      continue;
+    names.push_back(line.slice(1, end).str());
+  }
+}
+
+static void AppendJsonEscaped(llvm::StringRef value, std::string &out) {
+  for (char c : value) {
+    if (c == '"' || c == '\\')
+      out.push_back('\\');
+    out.push_back(c);
+  }
+}
+
+static void AppendMakeEscaped(llvm::StringRef value, std::string &out) {
+  for (char c : value) {
+    if (c == ' ')
+      out.push_back('\\');
+    out.push_back(c);
+  }
+}
+
+// Dependency-scanning mode (-scan-deps): walks the include graph with the
+// directive-only scan above instead of running the full preprocessor, and
+// prints the transitive file list as a Make rule (or JSON with
+// -scan-deps-json) on stdout. Unresolvable names are ignored, as a dependency
+// scanner must tolerate headers provided by the consuming build step.
+int DxcContext::ScanDeps() {
+  std::vector<std::string> searchDirs;
+  for (const llvm::opt::Arg *A : m_Opts.Args.filtered(hlsl::options::OPT_I))
+    searchDirs.push_back(A->getValue());
+
+  ScanDepsFileCache &cache = ScanDepsFileCache::Instance();
+  std::string rootPath = m_Opts.InputFile.str();
+  std::shared_ptr<std::string> rootContent;
+  if (!cache.TryRead(rootPath, rootContent)) {
+    fprintf(stderr, "dxc failed : cannot open input file '%s'.\n",
+            rootPath.c_str());
+    return 1;
+  }
+
+  std::vector<std::string> deps;
+  std::unordered_set<std::string> visited;
+  std::vector<std::pair<std::string, std::shared_ptr<std::string>>> pending;
+  visited.insert(rootPath);
+  pending.emplace_back(rootPath, rootContent);
+
+  while (!pending.empty()) {
+    std::pair<std::string, std::shared_ptr<std::string>> current =
+        std::move(pending.back());
+    pending.pop_back();
+
+    std::vector<std::string> names;
+    ScanIncludeDirectives(*current.second, names);
+    for (const std::string &name : names) {
+      // Quoted and angled forms both search the including file's directory
+      // first, then the -I directories, then the name as given - matching
+      // how the compiler's include handler resolves paths.
+      llvm::SmallVector<std::string, 8> candidates;
+      llvm::SmallString<128> candidate(
+          llvm::sys::path::parent_path(current.first));
+      llvm::sys::path::append(candidate, name);
+      candidates.push_back(candidate.str().str());
+      for (const std::string &dir : searchDirs) {
+        candidate = dir;
+        llvm::sys::path::append(candidate, name);
+        candidates.push_back(candidate.str().str());
+      }
+      candidates.push_back(name);
+
+      for (const std::string &path : candidates) {
+        if (visited.count(path) != 0)
+          break; // Already recorded under this spelling.
+        std::shared_ptr<std::string> content;
+        if (!cache.TryRead(path, content))
+          continue;
+        visited.insert(path);
+        deps.push_back(path);
+        pending.emplace_back(path, content);
+        break;
+      }
+    }
+  }
+
+  std::string output;
+  if (m_Opts.ScanDepsJson) {
+    output += "{\n  \"source\": \"";
+    AppendJsonEscaped(rootPath, output);
+    output += "\",\n  \"dependencies\": [";
+    for (size_t i = 0; i < deps.size(); ++i) {
+      output += (i == 0) ? "\n    \"" : ",\n    \"";
+      AppendJsonEscaped(deps[i], output);
+      output += "\"";
+    }
+    output += deps.empty() ? "]\n}\n" : "\n  ]\n}\n";
+  } else {
+    llvm::SmallString<128> target(m_Opts.OutputObject);
+    if (target.empty()) {
+      target = rootPath;
+      llvm::sys::path::replace_extension(target, "cso");
+    }
+    AppendMakeEscaped(target, output);
+    output += ":";
+    output += " ";
+    AppendMakeEscaped(rootPath, output);
+    for (const std::string &dep : deps) {
+      output += " \\\n  ";
+      AppendMakeEscaped(dep, output);
+    }
+    output += "\n";
+  }
+  WriteUtf8ToConsoleSizeT(output.data(), output.size());
+  return 0;
+}
+
 static void WriteString(HANDLE hFile, _In_z_ LPCSTR value, LPCWSTR pFileName) {
   DWORD written;
   if (FALSE == WriteFile(hFile, value, strlen(value) * sizeof(value[0]), &written, nullptr))
@@ -956,7 +1299,9 @@ void DxcContext::WriteHeader(IDxcBlobEncoding *pDisassembly, IDxcBlob *pCode,
   // Respect user's -encoding option
   CComPtr<IDxcBlobEncoding> pOutBlob;
   pLibrary->CreateBlobWithEncodingFromPinned(s.data(), s.length(), DXC_CP_UTF8, &pOutBlob);
-  WriteBlobToFile(pOutBlob, pFileName, m_Opts.DefaultTextCodePage);
+  // The blob pins the local string above, so this write must complete before
+  // returning; bypass the async writer.
+  ::dxc::WriteBlobToFile(pOutBlob, pFileName, m_Opts.DefaultTextCodePage);
 }
 
 // Finds DXIL module from the blob assuming blob is either DxilContainer, DxilPartHeader, or DXIL module
@@ -1179,15 +1524,18 @@ void DxcContext::GetCompilerVersionInfo(llvm::raw_string_ostream &OS) {
 #define VERSION_STRING_SUFFIX ""
 #endif
 
+namespace {
+
+// Runs a single compile job. Process-wide state (thread malloc, option
+// table) must already be initialized; server mode relies on that state and
+// on any loaded compiler DLL staying warm across jobs.
 #ifdef _WIN32
-int dxc::main(int argc, const wchar_t **argv_) {
+int RunOneJob(int argc, const wchar_t **argv_) {
 #else
-int dxc::main(int argc, const char **argv_) {
+int RunOneJob(int argc, const char **argv_) {
 #endif // _WIN32
   const char *pStage = "Operation";
   int retVal = 0;
-  if (FAILED(DxcInitThreadMalloc())) return 1;
-  DxcSetThreadMallocToDefault();
   try {
     pStage = "Argument processing";
     if (initHlslOptTable()) throw std::bad_alloc();
@@ -1249,7 +1597,11 @@ int dxc::main(int argc, const char **argv_) {
     }
 
     // TODO: implement all other actions.
-    if (!dxcOpts.Preprocess.empty()) {
+    if (dxcOpts.ScanDeps) {
+      pStage = "Dependency scanning";
+      retVal = context.ScanDeps();
+    }
+    else if (!dxcOpts.Preprocess.empty()) {
       pStage = "Preprocessing";
       context.Preprocess();
     }
@@ -1261,6 +1613,9 @@ int dxc::main(int argc, const char **argv_) {
       pStage = "Compilation";
       retVal = context.Compile();
     }
+    // Surface any pending background output-write failure while the job's
+    // error handling is still in scope.
+    context.FlushOutputWrites();
   } catch (const ::hlsl::Exception &hlslException) {
     try {
       const char *msg = hlslException.what();
@@ -1314,3 +1669,220 @@ int dxc::main(int argc, const char **argv_) {
 
   return retVal;
 }
+
+// Splits one line of server input into arguments. Double quotes group
+// tokens; no other escaping is performed.
+void TokenizeJobLine(const std::string &line, std::vector<std::string> &tokens) {
+  std::string token;
+  bool inQuotes = false;
+  for (char c : line) {
+    if (c == '"') {
+      inQuotes = !inQuotes;
+    } else if (!inQuotes && (c == ' ' || c == '\t' || c == '\r')) {
+      if (!token.empty()) {
+        tokens.push_back(token);
+        token.clear();
+      }
+    } else {
+      token.push_back(c);
+    }
+  }
+  if (!token.empty())
+    tokens.push_back(token);
+}
+
+// Server mode: reads one compile job per line from stdin and runs it against
+// process-wide state initialized exactly once, so repeated jobs skip DLL
+// load, allocator setup, option table construction and pass registration.
+// After each job a line of the form "#dxc-job-done <exit-code>" is written
+// to stdout so the driving build system can delimit job output. EOF ends
+// the session. Works over anonymous pipes, named pipes or sockets bound to
+// the standard handles.
+int RunServerLoop() {
+  // Hold the default compiler DLL for the whole session so per-job
+  // DxcDllSupport instances only bump its reference count.
+  dxc::DxcDllSupport keepWarm;
+  keepWarm.Initialize(); // Jobs naming an external DLL load their own.
+
+  std::string line;
+  while (std::getline(std::cin, line)) {
+    std::vector<std::string> tokens;
+    TokenizeJobLine(line, tokens);
+    if (tokens.empty())
+      continue;
+
+#ifdef _WIN32
+    std::vector<std::wstring> wideTokens;
+    wideTokens.reserve(tokens.size() + 1);
+    wideTokens.push_back(L"dxc");
+    for (const std::string &token : tokens)
+      wideTokens.push_back(Unicode::UTF8ToUTF16StringOrThrow(token.c_str()));
+    std::vector<const wchar_t *> jobArgv;
+    for (const std::wstring &wideToken : wideTokens)
+      jobArgv.push_back(wideToken.c_str());
+#else
+    std::vector<const char *> jobArgv;
+    jobArgv.push_back("dxc");
+    for (const std::string &token : tokens)
+      jobArgv.push_back(token.c_str());
+#endif // _WIN32
+
+    int jobResult = RunOneJob(static_cast<int>(jobArgv.size()), jobArgv.data());
+    fflush(stderr);
+    printf("#dxc-job-done %d\n", jobResult);
+    fflush(stdout);
+  }
+  return 0;
+}
+
+#ifdef _WIN32
+bool IsServerModeArg(const wchar_t *arg) {
+  return wcseq(arg, L"-server") || wcseq(arg, L"--server");
+}
+bool IsBatchModeArg(const wchar_t *arg) {
+  return wcseq(arg, L"-batch") || wcseq(arg, L"--batch");
+}
+#else
+bool IsServerModeArg(const char *arg) {
+  return strcmp(arg, "-server") == 0 || strcmp(arg, "--server") == 0;
+}
+bool IsBatchModeArg(const char *arg) {
+  return strcmp(arg, "-batch") == 0 || strcmp(arg, "--batch") == 0;
+}
+#endif // _WIN32
+
+// Batch mode: compiles every job listed in a manifest file on an internal
+// pool of worker threads, amortizing process startup, DLL load and option
+// table construction across the whole set. Each manifest line is one dxc
+// command line (same tokenization as server mode); blank lines and lines
+// starting with '#' are skipped. Outputs are written per each job's own
+// -Fo/-Fe/-Fh options; diagnostics from concurrent jobs may interleave on
+// the console, as with make -j. The exit code is the first nonzero job
+// result, and a "dxc failed : batch job <n>" line names each failing job.
+//
+// Usage: dxc -batch <manifest> [-j N]   (N defaults to hardware threads)
+#ifdef _WIN32
+int RunBatch(int argc, const wchar_t **argv_) {
+#else
+int RunBatch(int argc, const char **argv_) {
+#endif // _WIN32
+  if (argc < 3) {
+    fprintf(stderr, "dxc failed : -batch requires a manifest file.\n");
+    return 1;
+  }
+
+  unsigned workerCount = std::thread::hardware_concurrency();
+  if (workerCount == 0)
+    workerCount = 1;
+#ifdef _WIN32
+  std::string manifestPath = Unicode::UTF16ToUTF8StringOrThrow(argv_[2]);
+  for (int i = 3; i + 1 < argc; ++i) {
+    if (wcseq(argv_[i], L"-j"))
+      workerCount = static_cast<unsigned>(_wtoi(argv_[i + 1]));
+  }
+#else
+  std::string manifestPath = argv_[2];
+  for (int i = 3; i + 1 < argc; ++i) {
+    if (strcmp(argv_[i], "-j") == 0)
+      workerCount = static_cast<unsigned>(atoi(argv_[i + 1]));
+  }
+#endif // _WIN32
+  if (workerCount == 0) {
+    fprintf(stderr, "dxc failed : -j requires a positive thread count.\n");
+    return 1;
+  }
+
+  std::ifstream manifest(manifestPath);
+  if (!manifest) {
+    fprintf(stderr, "dxc failed : cannot open batch manifest '%s'.\n",
+            manifestPath.c_str());
+    return 1;
+  }
+
+  std::vector<std::vector<std::string>> jobs;
+  std::string line;
+  while (std::getline(manifest, line)) {
+    std::vector<std::string> tokens;
+    TokenizeJobLine(line, tokens);
+    if (tokens.empty() || tokens.front()[0] == '#')
+      continue;
+    jobs.push_back(std::move(tokens));
+  }
+  if (jobs.empty())
+    return 0;
+
+  // Hold the default compiler DLL for the whole batch so per-job
+  // DxcDllSupport instances only bump its reference count.
+  dxc::DxcDllSupport keepWarm;
+  keepWarm.Initialize(); // Jobs naming an external DLL load their own.
+
+  if (workerCount > jobs.size())
+    workerCount = static_cast<unsigned>(jobs.size());
+
+  // Workers claim jobs from a shared atomic cursor rather than per-thread
+  // deques; jobs are coarse enough (whole compiles) that contention on the
+  // cursor is negligible and idle threads always find work while any
+  // remains.
+  std::atomic<size_t> nextJob(0);
+  std::vector<int> results(jobs.size(), 0);
+  auto worker = [&jobs, &nextJob, &results]() {
+    DxcSetThreadMallocToDefault();
+    for (;;) {
+      size_t jobIndex = nextJob.fetch_add(1, std::memory_order_relaxed);
+      if (jobIndex >= jobs.size())
+        return;
+      const std::vector<std::string> &tokens = jobs[jobIndex];
+#ifdef _WIN32
+      std::vector<std::wstring> wideTokens;
+      wideTokens.reserve(tokens.size() + 1);
+      wideTokens.push_back(L"dxc");
+      for (const std::string &token : tokens)
+        wideTokens.push_back(Unicode::UTF8ToUTF16StringOrThrow(token.c_str()));
+      std::vector<const wchar_t *> jobArgv;
+      for (const std::wstring &wideToken : wideTokens)
+        jobArgv.push_back(wideToken.c_str());
+#else
+      std::vector<const char *> jobArgv;
+      jobArgv.push_back("dxc");
+      for (const std::string &token : tokens)
+        jobArgv.push_back(token.c_str());
+#endif // _WIN32
+      results[jobIndex] =
+          RunOneJob(static_cast<int>(jobArgv.size()), jobArgv.data());
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(workerCount);
+  for (unsigned i = 0; i < workerCount; ++i)
+    workers.emplace_back(worker);
+  for (std::thread &workerThread : workers)
+    workerThread.join();
+
+  int batchResult = 0;
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (results[i] != 0) {
+      fprintf(stderr, "dxc failed : batch job %u exited with code %d.\n",
+              static_cast<unsigned>(i + 1), results[i]);
+      if (batchResult == 0)
+        batchResult = results[i];
+    }
+  }
+  return batchResult;
+}
+
+} // unnamed namespace
+
+#ifdef _WIN32
+int dxc::main(int argc, const wchar_t **argv_) {
+#else
+int dxc::main(int argc, const char **argv_) {
+#endif // _WIN32
+  if (FAILED(DxcInitThreadMalloc())) return 1;
+  DxcSetThreadMallocToDefault();
+  if (argc >= 2 && IsServerModeArg(argv_[1]))
+    return RunServerLoop();
+  if (argc >= 2 && IsBatchModeArg(argv_[1]))
+    return RunBatch(argc, argv_);
+  return RunOneJob(argc, argv_);
+}
@@ -16,14 +16,10 @@
 #include "dxc/Support/HLSLOptions.h"
 #ifdef LLVM_ON_WIN32
 #include "dxcetw.h"
+#include "dxcutil.h"
 #endif
 #include "dxillib.h"
 
-namespace hlsl {
-HRESULT SetupRegistryPassForHLSL();
-HRESULT SetupRegistryPassForPIX();
-} // namespace hlsl
-
 // C++ exception specification ignored except to indicate a function is not __declspec(nothrow)
 #pragma warning( disable : 4290 )
 
@@ -58,8 +54,9 @@ static HRESULT InitMaybeFail() throw() {
     goto Cleanup;
   }
   fsSetup = true;
-  IFC(hlsl::SetupRegistryPassForHLSL());
-  IFC(hlsl::SetupRegistryPassForPIX());
+  // Pass registration is deliberately not done here: it is deferred to the
+  // first DxcCreateInstance of an object that can run passes (see dxcapi.cpp)
+  // so that merely loading the DLL stays cheap.
   IFC(DxilLibInitialize());
   if (hlsl::options::initHlslOptTable()) {
     hr = E_FAIL;
@@ -89,6 +86,7 @@ void __attribute__ ((destructor)) DllShutdown() {
   DxcSetThreadMallocToDefault();
   ::hlsl::options::cleanupHlslOptTable();
   ::llvm::sys::fs::CleanupPerThreadFileSystem();
+  ::dxcutil::ClearContextPool();
   ::llvm::llvm_shutdown();
   DxcClearThreadMalloc();
   DxcCleanupThreadMalloc();
@@ -108,6 +106,7 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD Reason, LPVOID reserved) {
     DxcSetThreadMallocToDefault();
     ::hlsl::options::cleanupHlslOptTable();
     ::llvm::sys::fs::CleanupPerThreadFileSystem();
+    ::dxcutil::ClearContextPool();
     ::llvm::llvm_shutdown();
     if (reserved == NULL) { // FreeLibrary has been called or the DLL load failed
       DxilLibCleanup(DxilLibCleanUpType::UnloadLibrary);
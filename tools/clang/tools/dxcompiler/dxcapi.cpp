@@ -34,6 +34,7 @@ DEFINE_CROSS_PLATFORM_UUIDOF(IDxcOperationResult)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcAssembler)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcBlob)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcIncludeHandler)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcIncludePrefetchHandler)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcCompiler)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcCompiler2)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcVersionInfo)
@@ -42,6 +43,8 @@ DEFINE_CROSS_PLATFORM_UUIDOF(IDxcValidator)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcContainerBuilder)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcOptimizerPass)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcOptimizer)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcOptimizerPipeline)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcOptimizer2)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcRewriter)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcRewriter2)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcIntelliSense)
@@ -52,6 +55,12 @@ DEFINE_CROSS_PLATFORM_UUIDOF(IDxcCompilerArgs)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcUtils)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcResult)
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcCompiler3)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcCompiler4)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcCompiler5)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcCompiler6)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcAsyncCompileCallback)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcAsyncCompileOperation)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcIncrementalCompiler)
 
 HRESULT CreateDxcCompiler(_In_ REFIID riid, _Out_ LPVOID *ppv);
 HRESULT CreateDxcDiaDataSource(_In_ REFIID riid, _Out_ LPVOID *ppv);
@@ -64,10 +73,13 @@ HRESULT CreateDxcAssembler(_In_ REFIID riid, _Out_ LPVOID *ppv);
 HRESULT CreateDxcOptimizer(_In_ REFIID riid, _Out_ LPVOID *ppv);
 HRESULT CreateDxcContainerBuilder(_In_ REFIID riid, _Out_ LPVOID *ppv);
 HRESULT CreateDxcLinker(_In_ REFIID riid, _Out_ LPVOID *ppv);
+HRESULT CreateDxcIncrementalCompiler(_In_ REFIID riid, _Out_ LPVOID *ppv);
 
 namespace hlsl {
 void CreateDxcContainerReflection(IDxcContainerReflection **ppResult);
 void CreateDxcLinker(IDxcContainerReflection **ppResult);
+HRESULT EnsureRegistryPassesForHLSL();
+HRESULT EnsureRegistryPassesForPIX();
 }
 
 HRESULT CreateDxcContainerReflection(_In_ REFIID riid, _Out_ LPVOID *ppv) {
@@ -99,59 +111,91 @@ HRESULT CreateDxcContainerBuilder(_In_ REFIID riid, _Out_ LPVOID *ppv) {
   return Result->QueryInterface(riid, ppv);
 }
 
-static HRESULT ThreadMallocDxcCreateInstance(
-  _In_ REFCLSID   rclsid,
-                  _In_ REFIID     riid,
-                  _Out_ LPVOID   *ppv) {
-  HRESULT hr = S_OK;
-  *ppv = nullptr;
-  if (IsEqualCLSID(rclsid, CLSID_DxcCompiler)) {
+// Pass registration is deferred out of DllMain; these wrappers make sure the
+// categories a given object can run are registered before handing it out.
+static HRESULT CreateDxcCompilerWithPasses(_In_ REFIID riid, _Out_ LPVOID *ppv) {
+  HRESULT hr = hlsl::EnsureRegistryPassesForHLSL();
+  if (SUCCEEDED(hr))
     hr = CreateDxcCompiler(riid, ppv);
+  return hr;
+}
+
+static HRESULT CreateDxcValidatorMaybeDxil(_In_ REFIID riid, _Out_ LPVOID *ppv) {
+  if (DxilLibIsEnabled()) {
+    return DxilLibCreateInstance(CLSID_DxcValidator, riid, (IUnknown**)ppv);
   }
-  else if (IsEqualCLSID(rclsid, CLSID_DxcCompilerArgs)) {
-    hr = CreateDxcCompilerArgs(riid, ppv);
-  }
-  else if (IsEqualCLSID(rclsid, CLSID_DxcUtils)) {
-    hr = CreateDxcUtils(riid, ppv);
-  }
-  else if (IsEqualCLSID(rclsid, CLSID_DxcValidator)) {
-    if (DxilLibIsEnabled()) {
-      hr = DxilLibCreateInstance(rclsid, riid, (IUnknown**)ppv);
-    } else {
-      hr = CreateDxcValidator(riid, ppv);
-    }
-  }
-  else if (IsEqualCLSID(rclsid, CLSID_DxcAssembler)) {
-    hr = CreateDxcAssembler(riid, ppv);
-  }
-  else if (IsEqualCLSID(rclsid, CLSID_DxcOptimizer)) {
+  HRESULT hr = hlsl::EnsureRegistryPassesForHLSL();
+  if (SUCCEEDED(hr))
+    hr = CreateDxcValidator(riid, ppv);
+  return hr;
+}
+
+static HRESULT CreateDxcOptimizerWithPasses(_In_ REFIID riid, _Out_ LPVOID *ppv) {
+  // The optimizer exposes the full pass registry, including the PIX passes.
+  HRESULT hr = hlsl::EnsureRegistryPassesForHLSL();
+  if (SUCCEEDED(hr))
+    hr = hlsl::EnsureRegistryPassesForPIX();
+  if (SUCCEEDED(hr))
     hr = CreateDxcOptimizer(riid, ppv);
-  }
-  else if (IsEqualCLSID(rclsid, CLSID_DxcIntelliSense)) {
-    hr = CreateDxcIntelliSense(riid, ppv);
-  }
-// Note: The following targets are not yet enabled for non-Windows platforms.
+  return hr;
+}
+
 #ifdef _WIN32
-  else if (IsEqualCLSID(rclsid, CLSID_DxcRewriter)) {
-    hr = CreateDxcRewriter(riid, ppv);
-  }
-  else if (IsEqualCLSID(rclsid, CLSID_DxcDiaDataSource)) {
-    hr = CreateDxcDiaDataSource(riid, ppv);
-  }
-  else if (IsEqualCLSID(rclsid, CLSID_DxcContainerReflection)) {
-    hr = CreateDxcContainerReflection(riid, ppv);
-  }
-  else if (IsEqualCLSID(rclsid, CLSID_DxcLinker)) {
+static HRESULT CreateDxcLinkerWithPasses(_In_ REFIID riid, _Out_ LPVOID *ppv) {
+  HRESULT hr = hlsl::EnsureRegistryPassesForHLSL();
+  if (SUCCEEDED(hr))
     hr = CreateDxcLinker(riid, ppv);
-  }
-  else if (IsEqualCLSID(rclsid, CLSID_DxcContainerBuilder)) {
-    hr = CreateDxcContainerBuilder(riid, ppv);
-  }
+  return hr;
+}
+
+static HRESULT CreateDxcIncrementalCompilerWithPasses(_In_ REFIID riid,
+                                                      _Out_ LPVOID *ppv) {
+  // Drives the compiler, rewriter, and linker internally.
+  HRESULT hr = hlsl::EnsureRegistryPassesForHLSL();
+  if (SUCCEEDED(hr))
+    hr = CreateDxcIncrementalCompiler(riid, ppv);
+  return hr;
+}
 #endif
-  else {
-    hr = REGDB_E_CLASSNOTREG;
+
+typedef HRESULT (*DxcClassCreateFn)(_In_ REFIID riid, _Out_ LPVOID *ppv);
+
+struct DxcClassFactoryEntry {
+  const GUID *pClsid;
+  DxcClassCreateFn pCreateFn;
+};
+
+// CLSID to factory table, resolved once at load.
+// Note: The #ifdef'd targets are not yet enabled for non-Windows platforms.
+static const DxcClassFactoryEntry g_ClassFactories[] = {
+  {&CLSID_DxcCompiler, CreateDxcCompilerWithPasses},
+  {&CLSID_DxcCompilerArgs, CreateDxcCompilerArgs},
+  {&CLSID_DxcUtils, CreateDxcUtils},
+  {&CLSID_DxcValidator, CreateDxcValidatorMaybeDxil},
+  {&CLSID_DxcAssembler, CreateDxcAssembler},
+  {&CLSID_DxcOptimizer, CreateDxcOptimizerWithPasses},
+  {&CLSID_DxcIntelliSense, CreateDxcIntelliSense},
+#ifdef _WIN32
+  {&CLSID_DxcRewriter, CreateDxcRewriter},
+  {&CLSID_DxcDiaDataSource, CreateDxcDiaDataSource},
+  {&CLSID_DxcContainerReflection, CreateDxcContainerReflection},
+  {&CLSID_DxcLinker, CreateDxcLinkerWithPasses},
+  {&CLSID_DxcContainerBuilder, CreateDxcContainerBuilder},
+  {&CLSID_DxcIncrementalCompiler, CreateDxcIncrementalCompilerWithPasses},
+#endif
+};
+
+static HRESULT ThreadMallocDxcCreateInstance(
+  _In_ REFCLSID   rclsid,
+                  _In_ REFIID     riid,
+                  _Out_ LPVOID   *ppv) {
+  *ppv = nullptr;
+  for (const DxcClassFactoryEntry &entry : g_ClassFactories) {
+    if (IsEqualCLSID(rclsid, *entry.pClsid)) {
+      return entry.pCreateFn(riid, ppv);
+    }
   }
-  return hr;
+  return REGDB_E_CLASSNOTREG;
 }
 
 DXC_API_IMPORT HRESULT __stdcall
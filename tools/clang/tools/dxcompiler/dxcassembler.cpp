@@ -102,7 +102,8 @@ HRESULT STDMETHODCALLTYPE DxcAssembler::AssembleToContainer(
         parseIR(memBuf->getMemBufferRef(), Err, Context);
 
     CComPtr<AbstractMemoryStream> pOutputStream;
-    IFT(CreateMemoryStream(TM.GetInstalledAllocator(), &pOutputStream));
+    IFT(CreateMemoryStream(TM.GetInstalledAllocator(),
+                           MemoryStreamPool::ModuleBitcode, &pOutputStream));
     raw_stream_ostream outStream(pOutputStream.p);
 
     // Check for success.
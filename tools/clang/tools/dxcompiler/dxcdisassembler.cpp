@@ -54,7 +54,7 @@ bool SigElementHasStream(const DxilProgramSignatureElement &pSignature) {
 }
 
 void PrintSignature(LPCSTR pName, const DxilProgramSignature *pSignature,
-                           bool bIsInput, raw_string_ostream &OS,
+                           bool bIsInput, raw_ostream &OS,
                            StringRef comment) {
   OS << comment << "\n"
      << comment << " " << pName << " signature:\n"
@@ -268,7 +268,7 @@ void PrintSignature(LPCSTR pName, const DxilProgramSignature *pSignature,
   OS << comment << "\n";
 }
 
-void PintCompMaskNameCompact(raw_string_ostream &OS, unsigned CompMask) {
+void PintCompMaskNameCompact(raw_ostream &OS, unsigned CompMask) {
   char Mask[5];
   memset(Mask, '\0', sizeof(Mask));
   unsigned idx = 0;
@@ -284,7 +284,7 @@ void PintCompMaskNameCompact(raw_string_ostream &OS, unsigned CompMask) {
 }
 
 void PrintDxilSignature(LPCSTR pName, const DxilSignature &Signature,
-                               raw_string_ostream &OS, StringRef comment) {
+                               raw_ostream &OS, StringRef comment) {
   const std::vector<std::unique_ptr<DxilSignatureElement>> &sigElts =
       Signature.GetElements();
   if (sigElts.size() == 0)
@@ -343,7 +343,7 @@ PCSTR g_pFeatureInfoNames[] = {
 static_assert(_countof(g_pFeatureInfoNames) == ShaderFeatureInfoCount, "g_pFeatureInfoNames needs to be updated");
 
 void PrintFeatureInfo(const DxilShaderFeatureInfo *pFeatureInfo,
-                             raw_string_ostream &OS, StringRef comment) {
+                             raw_ostream &OS, StringRef comment) {
   uint64_t featureFlags = pFeatureInfo->FeatureFlags;
   if (!featureFlags)
     return;
@@ -357,7 +357,7 @@ void PrintFeatureInfo(const DxilShaderFeatureInfo *pFeatureInfo,
 }
 
 void PrintResourceFormat(DxilResourceBase &res, unsigned alignment,
-                                raw_string_ostream &OS) {
+                                raw_ostream &OS) {
   switch (res.GetClass()) {
   case DxilResourceBase::Class::CBuffer:
   case DxilResourceBase::Class::Sampler:
@@ -387,7 +387,7 @@ void PrintResourceFormat(DxilResourceBase &res, unsigned alignment,
 }
 
 void PrintResourceDim(DxilResourceBase &res, unsigned alignment,
-                             raw_string_ostream &OS) {
+                             raw_ostream &OS) {
   switch (res.GetClass()) {
   case DxilResourceBase::Class::CBuffer:
   case DxilResourceBase::Class::Sampler:
@@ -430,7 +430,7 @@ void PrintResourceDim(DxilResourceBase &res, unsigned alignment,
   }
 }
 
-void PrintResourceBinding(DxilResourceBase &res, raw_string_ostream &OS,
+void PrintResourceBinding(DxilResourceBase &res, raw_ostream &OS,
                                  StringRef comment) {
   OS << comment << " " << left_justify(res.GetGlobalName(), 31);
 
@@ -456,7 +456,7 @@ void PrintResourceBinding(DxilResourceBase &res, raw_string_ostream &OS,
     OS << right_justify("unbounded", 6) << "\n";
 }
 
-void PrintResourceBindings(DxilModule &M, raw_string_ostream &OS,
+void PrintResourceBindings(DxilModule &M, raw_ostream &OS,
                                   StringRef comment) {
   OS << comment << "\n"
      << comment << " Resource Bindings:\n"
@@ -523,7 +523,7 @@ void PrintInputsContributingToOutputs(
   }
 }
 
-void PrintViewIdState(DxilModule &M, raw_string_ostream &OS,
+void PrintViewIdState(DxilModule &M, raw_ostream &OS,
                              StringRef comment) {
   if (!M.GetModule()->getNamedMetadata("dx.viewIdState"))
     return;
@@ -651,7 +651,7 @@ static const char *HitGroupTypeToString(DXIL::HitGroupType type) {
 }
 
 template <typename _T>
-void PrintFlags(raw_string_ostream &OS, uint32_t Flags) {
+void PrintFlags(raw_ostream &OS, uint32_t Flags) {
   if (!Flags) {
     OS << "0";
     return;
@@ -667,7 +667,7 @@ void PrintFlags(raw_string_ostream &OS, uint32_t Flags) {
 }
 
 void PrintSubobjects(const DxilSubobjects &subobjects,
-                     raw_string_ostream &OS,
+                     raw_ostream &OS,
                      StringRef comment) {
   if (subobjects.GetSubobjects().empty())
     return;
@@ -784,7 +784,7 @@ void PrintSubobjects(const DxilSubobjects &subobjects,
 }
 
 void PrintStructLayout(StructType *ST, DxilTypeSystem &typeSys, const DataLayout *DL,
-                       raw_string_ostream &OS, StringRef comment,
+                       raw_ostream &OS, StringRef comment,
                        StringRef varName, unsigned offset,
                        unsigned indent, unsigned arraySize,
                        unsigned sizeOfStruct = 0);
@@ -824,7 +824,7 @@ void PrintTypeAndName(llvm::Type *Ty, DxilFieldAnnotation &annotation,
 
 void PrintFieldLayout(llvm::Type *Ty, DxilFieldAnnotation &annotation,
                       DxilTypeSystem &typeSys, const DataLayout* DL,
-                      raw_string_ostream &OS,
+                      raw_ostream &OS,
                       StringRef comment, unsigned offset,
                       unsigned indent, unsigned offsetIndent,
                       unsigned sizeToPrint = 0) {
@@ -894,7 +894,7 @@ void PrintFieldLayout(llvm::Type *Ty, DxilFieldAnnotation &annotation,
 
 // null DataLayout => assume constant buffer layout
 void PrintStructLayout(StructType *ST, DxilTypeSystem &typeSys, const DataLayout *DL,
-                       raw_string_ostream &OS, StringRef comment,
+                       raw_ostream &OS, StringRef comment,
                        StringRef varName, unsigned offset,
                        unsigned indent, unsigned offsetIndent,
                        unsigned sizeOfStruct) {
@@ -942,7 +942,7 @@ void PrintStructLayout(StructType *ST, DxilTypeSystem &typeSys, const DataLayout
 void PrintStructBufferDefinition(DxilResource *buf,
                                         DxilTypeSystem &typeSys,
                                         const DataLayout &DL,
-                                        raw_string_ostream &OS,
+                                        raw_ostream &OS,
                                         StringRef comment) {
   const unsigned offsetIndent = 50;
 
@@ -989,7 +989,7 @@ void PrintStructBufferDefinition(DxilResource *buf,
 }
 
 void PrintTBufferDefinition(DxilResource *buf, DxilTypeSystem &typeSys,
-                                   raw_string_ostream &OS, StringRef comment) {
+                                   raw_ostream &OS, StringRef comment) {
   const unsigned offsetIndent = 50;
   llvm::Type *Ty = buf->GetGlobalSymbol()->getType()->getPointerElementType();
   // For TextureBuffer<> buf[2], the array size is in Resource binding count
@@ -1015,7 +1015,7 @@ void PrintTBufferDefinition(DxilResource *buf, DxilTypeSystem &typeSys,
 }
 
 void PrintCBufferDefinition(DxilCBuffer *buf, DxilTypeSystem &typeSys,
-                                   raw_string_ostream &OS, StringRef comment) {
+                                   raw_ostream &OS, StringRef comment) {
   const unsigned offsetIndent = 50;
   llvm::Type *Ty = buf->GetGlobalSymbol()->getType()->getPointerElementType();
   // For ConstantBuffer<> buf[2], the array size is in Resource binding count
@@ -1041,7 +1041,7 @@ void PrintCBufferDefinition(DxilCBuffer *buf, DxilTypeSystem &typeSys,
   OS << comment << "\n";
 }
 
-void PrintBufferDefinitions(DxilModule &M, raw_string_ostream &OS,
+void PrintBufferDefinitions(DxilModule &M, raw_ostream &OS,
                                    StringRef comment) {
   OS << comment << "\n"
      << comment << " Buffer Definitions:\n"
@@ -1497,7 +1497,7 @@ public:
 
 void PrintPipelineStateValidationRuntimeInfo(const char *pBuffer,
                                                     DXIL::ShaderKind shaderKind,
-                                                    raw_string_ostream &OS,
+                                                    raw_ostream &OS,
                                                     StringRef comment) {
   OS << comment << "\n"
      << comment << " Pipeline Runtime Information: \n"
@@ -1732,7 +1732,15 @@ void PrintPipelineStateValidationRuntimeInfo(const char *pBuffer,
 
 namespace dxcutil {
 
-HRESULT Disassemble(IDxcBlob *pProgram, raw_string_ostream &Stream) {
+HRESULT Disassemble(IDxcBlob *pProgram, raw_ostream &Stream) {
+  llvm::LLVMContext llvmContext;
+  return Disassemble(pProgram, Stream, llvmContext,
+                     llvm::ArrayRef<llvm::StringRef>());
+}
+
+HRESULT Disassemble(IDxcBlob *pProgram, raw_ostream &Stream,
+                    llvm::LLVMContext &llvmContext,
+                    llvm::ArrayRef<llvm::StringRef> FunctionFilter) {
   CComPtr<IDxcBlob> pPdbContainerBlob;
   {
     CComPtr<IStream> pStream;
@@ -1868,7 +1876,6 @@ HRESULT Disassemble(IDxcBlob *pProgram, raw_string_ostream &Stream) {
   }
 
   std::string DiagStr;
-  llvm::LLVMContext llvmContext;
   std::unique_ptr<llvm::Module> pModule(dxilutil::LoadModuleFromBitcode(
     llvm::StringRef(pIL, pILLength), llvmContext, DiagStr));
   if (pModule.get() == nullptr) {
@@ -1927,7 +1934,19 @@ HRESULT Disassemble(IDxcBlob *pProgram, raw_string_ostream &Stream) {
     }
   }
   DxcAssemblyAnnotationWriter w;
-  pModule->print(Stream, &w);
+  if (FunctionFilter.empty()) {
+    // Large library disassembly is dominated by AssemblyWriter formatting;
+    // printParallel formats function bodies on worker threads (identical
+    // output, serial fallback for small modules).
+    pModule->printParallel(Stream, &w);
+  } else {
+    for (llvm::StringRef Name : FunctionFilter) {
+      if (llvm::Function *F = pModule->getFunction(Name))
+        F->print(Stream, &w);
+      else
+        Stream << "; function '" << Name << "' not found in module\n";
+    }
+  }
   //if (pReflectionModule) {
   //  Stream << "\n========== Reflection Module from STAT part ==========\n";
   //  pReflectionModule->print(Stream, &w);
@@ -21,6 +21,10 @@
 #include "dxc/Support/Unicode.h"
 #include "clang/Frontend/CompilerInstance.h"
 
+#include <map>
+#include <mutex>
+#include <set>
+
 #ifndef _WIN32
 #include <sys/stat.h>
 #include <unistd.h>
@@ -191,6 +195,22 @@ void MakeAbsoluteOrCurDirRelativeW(LPCWSTR &Path, std::wstring &PathStorage) {
   }
 }
 
+// Process-wide cache of include handler results, shared across compiles that
+// pass -fcache-includes. Only file contents are shared - never misses, since
+// different compiles may use handlers that resolve different sets of paths -
+// and each file system still builds its own per-compile stream over the
+// cached blob. Invalidation is explicit: hosts that change the include tree
+// call dxcutil::ClearSharedIncludeCache between compiles.
+struct SharedIncludeCache {
+  std::mutex Mutex;
+  std::map<std::wstring, CComPtr<IDxcBlobUtf8>> Contents;
+
+  static SharedIncludeCache &Instance() {
+    static SharedIncludeCache Cache;
+    return Cache;
+  }
+};
+
 }
 
 namespace dxcutil {
@@ -227,6 +247,7 @@ private:
   LPCWSTR m_pOutputStreamName;
   std::wstring m_pAbsOutputStreamName;
   CComPtr<IDxcIncludeHandler> m_includeLoader;
+  CComPtr<IDxcIncludePrefetchHandler> m_prefetchLoader;
   std::vector<std::wstring> m_searchEntries;
   bool m_bDisplayIncludeProcess;
 
@@ -240,6 +261,19 @@ private:
       : Blob(pBlob), BlobStream(pStream), Name(name) { }
   };
   llvm::SmallVector<IncludedFile, 4> m_includedFiles;
+  // Name lookup acceleration for TryFindOrOpen. Re-included headers are
+  // probed (opened or stat'ed) on every inclusion before the lexer decides
+  // whether to skip them, and each probe used to scan m_includedFiles
+  // linearly and re-invoke the include handler for known-missing paths.
+  std::map<std::wstring, size_t> m_includedFileIndex;
+  std::set<std::wstring> m_missingFiles;
+  // Directory probe memoization for TryFindDirHandle. Header search stats
+  // the same parent directories for every candidate include path; the
+  // answer only changes when a file is added, so the cache is keyed to the
+  // included-file count it was built against.
+  mutable std::map<std::wstring, HANDLE> m_dirHandleCache;
+  mutable size_t m_dirCacheFileCount = 0;
+  bool m_bSharedCacheEnabled = false;
 
   static bool IsDirOf(LPCWSTR lpDir, size_t dirLen, const std::wstring &fileName) {
     if (fileName.size() <= dirLen) return false;
@@ -261,29 +295,76 @@ private:
   }
 
   HANDLE TryFindDirHandle(LPCWSTR lpDir) const {
+    // A newly included file can turn a previous miss (or SearchDir match)
+    // into a FileDir match, so drop the memoized answers when the file set
+    // has grown since they were recorded.
+    if (m_dirCacheFileCount != m_includedFiles.size()) {
+      m_dirHandleCache.clear();
+      m_dirCacheFileCount = m_includedFiles.size();
+    }
+    auto cached = m_dirHandleCache.find(lpDir);
+    if (cached != m_dirHandleCache.end()) {
+      return cached->second;
+    }
+
+    HANDLE result = INVALID_HANDLE_VALUE;
     size_t dirLen = wcslen(lpDir);
     for (size_t i = 0; i < m_includedFiles.size(); ++i) {
       const std::wstring &fileName = m_includedFiles[i].Name;
       if (IsDirOf(lpDir, dirLen, fileName)) {
-        return DxcArgsHandle(HandleKind::FileDir, i, dirLen).Handle;
+        result = DxcArgsHandle(HandleKind::FileDir, i, dirLen).Handle;
+        break;
       }
     }
-    for (size_t i = 0; i < m_searchEntries.size(); ++i) {
-      if (IsDirPrefixOrSame(lpDir, dirLen, m_searchEntries[i])) {
-        return DxcArgsHandle(HandleKind::SearchDir, i, dirLen).Handle;
+    if (result == INVALID_HANDLE_VALUE) {
+      for (size_t i = 0; i < m_searchEntries.size(); ++i) {
+        if (IsDirPrefixOrSame(lpDir, dirLen, m_searchEntries[i])) {
+          result = DxcArgsHandle(HandleKind::SearchDir, i, dirLen).Handle;
+          break;
+        }
       }
     }
-    return INVALID_HANDLE_VALUE;
+    m_dirHandleCache.emplace(lpDir, result);
+    return result;
   }
   DWORD TryFindOrOpen(LPCWSTR lpFileName, size_t &index) {
-    for (size_t i = 0; i < m_includedFiles.size(); ++i) {
-      if (0 == wcscmp(lpFileName, m_includedFiles[i].Name.data())) {
-        index = i;
+    auto foundFile = m_includedFileIndex.find(lpFileName);
+    if (foundFile != m_includedFileIndex.end()) {
+      index = foundFile->second;
+      return ERROR_SUCCESS;
+    }
+
+    if (m_bSharedCacheEnabled) {
+      CComPtr<IDxcBlobUtf8> cachedBlob;
+      {
+        SharedIncludeCache &cache = SharedIncludeCache::Instance();
+        std::lock_guard<std::mutex> lock(cache.Mutex);
+        auto cached = cache.Contents.find(lpFileName);
+        if (cached != cache.Contents.end())
+          cachedBlob = cached->second;
+      }
+      if (cachedBlob.p != nullptr) {
+        if (m_includedFiles.size() == MaxIncludedFiles) {
+          return ERROR_OUT_OF_STRUCTURES;
+        }
+        CComPtr<IStream> fileStream;
+        if (FAILED(hlsl::CreateReadOnlyBlobStream(cachedBlob, &fileStream))) {
+          return ERROR_UNHANDLED_EXCEPTION;
+        }
+        m_includedFiles.emplace_back(std::wstring(lpFileName), cachedBlob, fileStream);
+        index = m_includedFiles.size() - 1;
+        m_includedFileIndex[m_includedFiles.back().Name] = index;
+        // Children of a cached header may not be cached yet; prefetch still
+        // gives the handler a head start on them.
+        PrefetchDirectIncludes(cachedBlob);
         return ERROR_SUCCESS;
       }
     }
 
     if (m_includeLoader.p != nullptr) {
+      if (m_missingFiles.count(lpFileName) != 0) {
+        return ERROR_NOT_FOUND;
+      }
       if (m_includedFiles.size() == MaxIncludedFiles) {
         return ERROR_OUT_OF_STRUCTURES;
       }
@@ -304,6 +385,13 @@ private:
         }
         m_includedFiles.emplace_back(std::wstring(lpFileName), fileBlobUtf8, fileStream);
         index = m_includedFiles.size() - 1;
+        m_includedFileIndex[m_includedFiles.back().Name] = index;
+        if (m_bSharedCacheEnabled) {
+          SharedIncludeCache &cache = SharedIncludeCache::Instance();
+          std::lock_guard<std::mutex> lock(cache.Mutex);
+          cache.Contents.emplace(m_includedFiles.back().Name, fileBlobUtf8);
+        }
+        PrefetchDirectIncludes(fileBlobUtf8);
 
         if (m_bDisplayIncludeProcess) {
           std::string openFileStr;
@@ -318,9 +406,68 @@ private:
         }
         return ERROR_SUCCESS;
       }
+      // Remember the miss; header search re-probes the same candidate paths
+      // on every re-inclusion and the handler's answer is stable within one
+      // compile.
+      m_missingFiles.insert(lpFileName);
     }
     return ERROR_NOT_FOUND;
   }
+  // Scan a just-opened source for #include directives and hand the referenced
+  // names to the handler's optional prefetch interface, so a handler backed by
+  // slow storage can begin loading them before the lexer reaches the
+  // directives. The scan is textual and intentionally loose: names inside
+  // comments or inactive #if regions are acceptable over-approximations, and
+  // computed includes are missed. Names already opened or known missing are
+  // filtered out; the rest are advisory only, so handler failures and
+  // malformed names are ignored.
+  void PrefetchDirectIncludes(IDxcBlobUtf8 *pBlob) throw() {
+    if (m_prefetchLoader.p == nullptr)
+      return;
+    try {
+      llvm::StringRef text(pBlob->GetStringPointer(), pBlob->GetStringLength());
+      std::vector<std::wstring> names;
+      size_t pos = 0;
+      while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        llvm::StringRef line = text.slice(
+            pos, eol == llvm::StringRef::npos ? text.size() : eol);
+        pos = (eol == llvm::StringRef::npos) ? text.size() : eol + 1;
+        line = line.ltrim(" \t");
+        if (!line.startswith("#"))
+          continue;
+        line = line.drop_front(1).ltrim(" \t");
+        if (!line.startswith("include"))
+          continue;
+        line = line.drop_front(strlen("include")).ltrim(" \t");
+        if (line.empty())
+          continue;
+        char close = line[0] == '"' ? '"' : line[0] == '<' ? '>' : '\0';
+        if (close == '\0')
+          continue;
+        size_t end = line.find(close, 1);
+        if (end == llvm::StringRef::npos || end == 1)
+          continue;
+        std::wstring name;
+        if (!Unicode::UTF8ToUTF16String(line.data() + 1, end - 1, &name))
+          continue;
+        if (m_includedFileIndex.count(name) != 0 ||
+            m_missingFiles.count(name) != 0)
+          continue;
+        names.push_back(std::move(name));
+      }
+      if (names.empty())
+        return;
+      std::vector<LPCWSTR> namePtrs;
+      namePtrs.reserve(names.size());
+      for (const std::wstring &name : names)
+        namePtrs.push_back(name.c_str());
+      m_prefetchLoader->PrefetchSources(namePtrs.data(),
+                                        (UINT32)namePtrs.size());
+    } catch (...) {
+      // Prefetch is best-effort; never fail an open because of it.
+    }
+  }
   static HANDLE IncludedFileIndexToHandle(size_t index) {
     return DxcArgsHandle(index).Handle;
   }
@@ -340,10 +487,19 @@ public:
     MakeAbsoluteOrCurDirRelativeW(m_pSourceName, m_pAbsSourceName);
     IFT(CreateReadOnlyBlobStream(m_pSource, &m_pSourceStream));
     m_includedFiles.push_back(IncludedFile(std::wstring(m_pSourceName), m_pSource, m_pSourceStream));
+    m_includedFileIndex[m_includedFiles.back().Name] = 0;
+    if (pHandler != nullptr) {
+      // The prefetch extension is optional; a plain handler leaves this null.
+      pHandler->QueryInterface(IID_PPV_ARGS(&m_prefetchLoader));
+      PrefetchDirectIncludes(m_pSource);
+    }
   }
   void EnableDisplayIncludeProcess() override {
     m_bDisplayIncludeProcess = true;
   }
+  void EnableSharedIncludeCache() override {
+    m_bSharedCacheEnabled = true;
+  }
   void WriteStdErrToStream(raw_string_ostream &s) override {
     s.write((char*)m_pStdErrStream->GetPtr(), m_pStdErrStream->GetPtrSize());
     s.flush();
@@ -385,6 +541,9 @@ public:
 
   void SetupForCompilerInstance(clang::CompilerInstance &compiler) override {
     DXASSERT(m_searchEntries.size() == 0, "else compiler instance being set twice");
+    // Search entries participate in directory probes; forget any answers
+    // recorded before they were registered.
+    m_dirHandleCache.clear();
     // Turn these into UTF-16 to avoid converting later, and ensure they
     // are fully-qualified or relative to the current directory.
     const std::vector<clang::HeaderSearchOptions::Entry> &entries =
@@ -821,4 +980,10 @@ CreateDxcArgsFileSystem(
   return new DxcArgsFileSystemImpl(pSource, pSourceName, pIncludeHandler);
 }
 
+void ClearSharedIncludeCache() {
+  SharedIncludeCache &cache = SharedIncludeCache::Instance();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.Contents.clear();
+}
+
 } // namespace dxcutil
@@ -0,0 +1,317 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// dxcincremental.cpp                                                        //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Implements the incremental compiler object, which splits a source into   //
+// per-function libraries, caches the compiled libraries by content hash,   //
+// and relinks only the functions that changed.                             //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/Support/WinIncludes.h"
+#include "dxc/Support/Global.h"
+#include "dxc/Support/Unicode.h"
+#include "dxc/Support/microcom.h"
+#include "dxc/Support/FileIOHelper.h"
+#include "dxc/dxcapi.h"
+#include "dxc/dxctools.h"
+
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <cctype>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace llvm;
+using namespace hlsl;
+
+// These declarations are used for the locally-linked objects.
+HRESULT CreateDxcCompiler(_In_ REFIID riid, _Out_ LPVOID *ppv);
+HRESULT CreateDxcRewriter(_In_ REFIID riid, _Out_ LPVOID *ppv);
+HRESULT CreateDxcLinker(_In_ REFIID riid, _Out_ LPVOID *ppv);
+
+namespace {
+
+// One compiled function library, plus the header that later functions see:
+// the compiled chunk with function bodies stripped, so a change to one body
+// cannot invalidate the hashes of the functions that follow it.
+struct CachedFunctionLib {
+  CComPtr<IDxcBlob> Lib;
+  std::string StrippedHeader;
+};
+
+// Process-wide cache of function libraries keyed by content hash. The hash
+// covers the preprocessed header and body text plus the compile arguments,
+// so a stale hit would require a hash collision; ClearCache is the escape
+// hatch for anything hashing cannot see.
+struct FunctionLibCache {
+  std::mutex Mutex;
+  std::unordered_map<size_t, CachedFunctionLib> Entries;
+
+  static FunctionLibCache &Instance() {
+    static FunctionLibCache Cache;
+    return Cache;
+  }
+};
+
+// Splits preprocessed source into chunks that each end right after one
+// top-level function body. A top-level '{' whose preceding non-whitespace
+// character is ')' opens a body; struct, cbuffer and initializer braces do
+// not match that shape. Comments and string literals are skipped so braces
+// inside them cannot unbalance the scan. Any trailing text without a body
+// is appended to the final chunk.
+static void SplitTopLevelFunctions(StringRef Text,
+                                   std::vector<std::string> &Chunks) {
+  size_t ChunkStart = 0;
+  unsigned Depth = 0;
+  bool bInBody = false;
+  char LastNonSpace = 0;
+  for (size_t i = 0, e = Text.size(); i < e; ++i) {
+    char c = Text[i];
+    if (c == '/' && i + 1 < e && Text[i + 1] == '/') {
+      i = Text.find('\n', i);
+      if (i == StringRef::npos)
+        break;
+      continue;
+    }
+    if (c == '/' && i + 1 < e && Text[i + 1] == '*') {
+      i = Text.find("*/", i + 2);
+      if (i == StringRef::npos)
+        break;
+      ++i; // loop increment skips the '/'
+      continue;
+    }
+    if (c == '"') {
+      for (++i; i < e && Text[i] != '"'; ++i) {
+        if (Text[i] == '\\')
+          ++i;
+      }
+      continue;
+    }
+    if (c == '{') {
+      if (Depth == 0 && LastNonSpace == ')')
+        bInBody = true;
+      ++Depth;
+    } else if (c == '}') {
+      if (Depth > 0)
+        --Depth;
+      if (Depth == 0 && bInBody) {
+        bInBody = false;
+        Chunks.emplace_back(Text.slice(ChunkStart, i + 1).str());
+        ChunkStart = i + 1;
+      }
+    }
+    if (!isspace(static_cast<unsigned char>(c)))
+      LastNonSpace = c;
+  }
+  if (ChunkStart < Text.size()) {
+    StringRef Tail = Text.drop_front(ChunkStart);
+    if (!Tail.trim().empty()) {
+      if (Chunks.empty())
+        Chunks.emplace_back(Tail.str());
+      else
+        Chunks.back() += Tail.str();
+    }
+  }
+}
+
+static hash_code HashChunk(StringRef Header, StringRef Chunk,
+                           LPCWSTR *pArguments, UINT32 argCount) {
+  hash_code Hash = hash_value(Header);
+  Hash = hash_combine(Hash, Chunk);
+  for (UINT32 i = 0; i < argCount; ++i) {
+    std::string Utf8Arg = Unicode::UTF16ToUTF8StringOrThrow(pArguments[i]);
+    Hash = hash_combine(Hash, StringRef(Utf8Arg));
+  }
+  return Hash;
+}
+
+// Returns the failing result through ppResult if the operation failed, so
+// diagnostics from a chunk compile surface exactly like a whole-source
+// compile. Returns true when the caller should stop and hand it back.
+static bool FailedOperation(IDxcOperationResult *pResult,
+                            IDxcOperationResult **ppResult) {
+  HRESULT status;
+  IFT(pResult->GetStatus(&status));
+  if (SUCCEEDED(status))
+    return false;
+  *ppResult = pResult;
+  pResult->AddRef();
+  return true;
+}
+
+class DxcIncrementalCompiler : public IDxcIncrementalCompiler {
+private:
+  DXC_MICROCOM_TM_REF_FIELDS()
+  UINT32 m_lastChunkCount = 0;
+  UINT32 m_lastCacheHitCount = 0;
+
+public:
+  DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
+  DXC_MICROCOM_TM_CTOR(DxcIncrementalCompiler)
+
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid,
+                                           void **ppvObject) override {
+    return DoBasicQueryInterface<IDxcIncrementalCompiler>(this, iid,
+                                                          ppvObject);
+  }
+
+  HRESULT STDMETHODCALLTYPE Compile(
+      _In_ IDxcBlob *pSource, _In_opt_z_ LPCWSTR pSourceName,
+      _In_opt_z_ LPCWSTR pEntryPoint, _In_z_ LPCWSTR pTargetProfile,
+      _In_opt_count_(argCount) LPCWSTR *pArguments, _In_ UINT32 argCount,
+      _In_count_(defineCount) const DxcDefine *pDefines,
+      _In_ UINT32 defineCount, _In_opt_ IDxcIncludeHandler *pIncludeHandler,
+      _COM_Outptr_ IDxcOperationResult **ppResult) override;
+
+  HRESULT STDMETHODCALLTYPE ClearCache() override;
+
+  HRESULT STDMETHODCALLTYPE GetLastCompileStats(
+      _Out_opt_ UINT32 *pChunkCount,
+      _Out_opt_ UINT32 *pCacheHitCount) override {
+    if (pChunkCount != nullptr)
+      *pChunkCount = m_lastChunkCount;
+    if (pCacheHitCount != nullptr)
+      *pCacheHitCount = m_lastCacheHitCount;
+    return S_OK;
+  }
+};
+
+HRESULT STDMETHODCALLTYPE DxcIncrementalCompiler::Compile(
+    IDxcBlob *pSource, LPCWSTR pSourceName, LPCWSTR pEntryPoint,
+    LPCWSTR pTargetProfile, LPCWSTR *pArguments, UINT32 argCount,
+    const DxcDefine *pDefines, UINT32 defineCount,
+    IDxcIncludeHandler *pIncludeHandler, IDxcOperationResult **ppResult) {
+  if (pSource == nullptr || pTargetProfile == nullptr || ppResult == nullptr)
+    return E_INVALIDARG;
+  *ppResult = nullptr;
+  m_lastChunkCount = 0;
+  m_lastCacheHitCount = 0;
+  DxcThreadMalloc TM(m_pMalloc);
+  try {
+    CComPtr<IDxcCompiler> pCompiler;
+    IFT(CreateDxcCompiler(IID_PPV_ARGS(&pCompiler)));
+
+    // Flatten includes and expand defines up front. Chunk hashing then sees
+    // exactly the text the compiler would, so edits to headers or define
+    // values invalidate the affected chunks without bespoke tracking.
+    CComPtr<IDxcOperationResult> pPPResult;
+    IFT(pCompiler->Preprocess(pSource, pSourceName, pArguments, argCount,
+                              pDefines, defineCount, pIncludeHandler,
+                              &pPPResult));
+    if (FailedOperation(pPPResult, ppResult))
+      return S_OK;
+    CComPtr<IDxcBlob> pPPBlob;
+    IFT(pPPResult->GetResult(&pPPBlob));
+    CComPtr<IDxcBlobUtf8> pPPUtf8;
+    IFT(hlsl::DxcGetBlobAsUtf8(pPPBlob, m_pMalloc, &pPPUtf8));
+
+    std::vector<std::string> Chunks;
+    SplitTopLevelFunctions(
+        StringRef(pPPUtf8->GetStringPointer(), pPPUtf8->GetStringLength()),
+        Chunks);
+    m_lastChunkCount = (UINT32)Chunks.size();
+
+    // A single chunk means one function (or none) - split-and-link only
+    // adds overhead, so compile the flattened source directly.
+    if (Chunks.size() < 2) {
+      return pCompiler->Compile(pPPBlob, pSourceName, pEntryPoint,
+                                pTargetProfile, pArguments, argCount, nullptr,
+                                0, nullptr, ppResult);
+    }
+
+    CComPtr<IDxcRewriter> pRewriter;
+    IFT(CreateDxcRewriter(IID_PPV_ARGS(&pRewriter)));
+    CComPtr<IDxcLinker> pLinker;
+    IFT(CreateDxcLinker(IID_PPV_ARGS(&pLinker)));
+
+    FunctionLibCache &Cache = FunctionLibCache::Instance();
+    std::string Header;
+    std::vector<std::wstring> LibNameStorage;
+    std::vector<LPCWSTR> LibNames;
+    for (const std::string &Chunk : Chunks) {
+      size_t Hash = HashChunk(Header, Chunk, pArguments, argCount);
+      CComPtr<IDxcBlob> pLib;
+      bool bHit = false;
+      {
+        std::lock_guard<std::mutex> Lock(Cache.Mutex);
+        auto It = Cache.Entries.find(Hash);
+        if (It != Cache.Entries.end()) {
+          pLib = It->second.Lib;
+          Header = It->second.StrippedHeader;
+          bHit = true;
+          ++m_lastCacheHitCount;
+        }
+      }
+      if (!bHit) {
+        std::string ChunkSource = Header + Chunk;
+        CComPtr<IDxcBlobEncoding> pChunkBlob;
+        IFT(hlsl::DxcCreateBlobWithEncodingOnMallocCopy(
+            m_pMalloc, ChunkSource.data(), (UINT32)ChunkSource.size(),
+            CP_UTF8, &pChunkBlob));
+
+        CComPtr<IDxcOperationResult> pLibResult;
+        IFT(pCompiler->Compile(pChunkBlob, pSourceName, L"", L"lib_6_x",
+                               pArguments, argCount, nullptr, 0, nullptr,
+                               &pLibResult));
+        if (FailedOperation(pLibResult, ppResult))
+          return S_OK;
+        IFT(pLibResult->GetResult(&pLib));
+
+        // Strip the bodies from what this chunk saw; that becomes the
+        // header for every following chunk.
+        CComPtr<IDxcOperationResult> pRewriteResult;
+        IFT(pRewriter->RewriteUnchangedWithInclude(
+            pChunkBlob, pSourceName, nullptr, 0, nullptr,
+            RewriterOptionMask::SkipFunctionBody |
+                RewriterOptionMask::KeepUserMacro,
+            &pRewriteResult));
+        if (FailedOperation(pRewriteResult, ppResult))
+          return S_OK;
+        CComPtr<IDxcBlob> pHeaderBlob;
+        IFT(pRewriteResult->GetResult(&pHeaderBlob));
+        Header.assign((const char *)pHeaderBlob->GetBufferPointer(),
+                      pHeaderBlob->GetBufferSize());
+
+        std::lock_guard<std::mutex> Lock(Cache.Mutex);
+        CachedFunctionLib &Entry = Cache.Entries[Hash];
+        Entry.Lib = pLib;
+        Entry.StrippedHeader = Header;
+      }
+      LibNameStorage.emplace_back(std::to_wstring(Hash));
+      LibNames.emplace_back(LibNameStorage.back().c_str());
+      IFT(pLinker->RegisterLibrary(LibNames.back(), pLib));
+    }
+
+    return pLinker->Link(pEntryPoint, pTargetProfile, LibNames.data(),
+                         (UINT32)LibNames.size(), nullptr, 0, ppResult);
+  }
+  CATCH_CPP_RETURN_HRESULT();
+}
+
+HRESULT STDMETHODCALLTYPE DxcIncrementalCompiler::ClearCache() {
+  DxcThreadMalloc TM(m_pMalloc);
+  FunctionLibCache &Cache = FunctionLibCache::Instance();
+  std::lock_guard<std::mutex> Lock(Cache.Mutex);
+  Cache.Entries.clear();
+  return S_OK;
+}
+
+} // namespace
+
+HRESULT CreateDxcIncrementalCompiler(_In_ REFIID riid, _Out_ LPVOID *ppv) {
+  *ppv = nullptr;
+  try {
+    CComPtr<DxcIncrementalCompiler> result(
+        DxcIncrementalCompiler::Alloc(DxcGetThreadMallocNoRef()));
+    IFROOM(result.p);
+    return result.p->QueryInterface(riid, ppv);
+  }
+  CATCH_CPP_RETURN_HRESULT();
+}
@@ -31,8 +31,8 @@ using namespace hlsl;
 #ifdef _WIN32
 // Temporary: Define these here until a better header location is found.
 namespace hlsl {
-HRESULT CreateDxilShaderReflection(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject);
-HRESULT CreateDxilLibraryReflection(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject);
+HRESULT CreateDxilShaderReflection(IDxcBlob *pContainer, const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject);
+HRESULT CreateDxilLibraryReflection(IDxcBlob *pContainer, const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject);
 }
 #endif
 
@@ -53,7 +53,12 @@ public:
     ) override {
     try {
       CComPtr<IDxcBlobEncoding> pEncoding;
-      HRESULT hr = ::hlsl::DxcCreateBlobFromFile(m_pMalloc, pFilename, nullptr, &pEncoding);
+      // Prefer the zero-copy memory-mapped read path; fall back to the
+      // copying reader for files that cannot be mapped (e.g. empty files).
+      HRESULT hr = ::hlsl::DxcCreateBlobFromFileMapped(m_pMalloc, pFilename, &pEncoding);
+      if (FAILED(hr)) {
+        hr = ::hlsl::DxcCreateBlobFromFile(m_pMalloc, pFilename, nullptr, &pEncoding);
+      }
       if (SUCCEEDED(hr)) {
         *ppIncludeSource = pEncoding.Detach();
       }
@@ -437,10 +442,12 @@ public:
         bIsLibrary = DXIL::ShaderKind::Library == SK;
       }
 
+      // No blob to retain here: pData is a raw caller buffer whose lifetime
+      // is not under our control, so the module load falls back to copying.
       if (bIsLibrary) {
-        IFR(hlsl::CreateDxilLibraryReflection(pModulePart, pRDATPart, iid, ppvReflection));
+        IFR(hlsl::CreateDxilLibraryReflection(nullptr, pModulePart, pRDATPart, iid, ppvReflection));
       } else {
-        IFR(hlsl::CreateDxilShaderReflection(pModulePart, pRDATPart, iid, ppvReflection));
+        IFR(hlsl::CreateDxilShaderReflection(nullptr, pModulePart, pRDATPart, iid, ppvReflection));
       }
 
       return S_OK;
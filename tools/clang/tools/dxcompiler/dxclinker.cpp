@@ -21,6 +21,7 @@
 
 #include "llvm/ADT/SmallVector.h"
 #include <algorithm>
+#include <map>
 
 #include "dxc/HLSL/DxilLinker.h"
 #include "dxc/HLSL/DxilValidation.h"
@@ -107,7 +108,9 @@ private:
   LLVMContext m_Ctx;
   std::unique_ptr<DxilLinker> m_pLinker;
   CComPtr<IDxcContainerEventsHandler> m_pDxcContainerEventsHandler;
-  std::vector<CComPtr<IDxcBlob>> m_blobs; // Keep blobs live for lazy load.
+  // Keep blobs live for lazy load, keyed by library name so a replaced
+  // library releases the bytes of the version it supersedes.
+  std::map<std::string, CComPtr<IDxcBlob>> m_blobs;
 };
 
 HRESULT
@@ -120,9 +123,6 @@ DxcLinker::RegisterLibrary(_In_opt_ LPCWSTR pLibName, // Name of the library.
   DxcThreadMalloc TM(m_pMalloc);
   // Prepare UTF8-encoded versions of API values.
   CW2A pUtf8LibName(pLibName, CP_UTF8);
-  // Already exist lib with same name.
-  if (m_pLinker->HasLibNameRegistered(pUtf8LibName.m_psz))
-    return E_INVALIDARG;
 
   try {
     std::unique_ptr<llvm::Module> pModule, pDebugModule;
@@ -139,9 +139,16 @@ DxcLinker::RegisterLibrary(_In_opt_ LPCWSTR pLibName, // Name of the library.
         pBlob->GetBufferPointer(), pBlob->GetBufferSize(), pModule,
         pDebugModule, m_Ctx, m_Ctx, DiagStream));
 
+    // Re-registering an existing name replaces that library, so an
+    // incremental session only reloads the libraries that changed while
+    // everything else stays resident. The old version is dropped only once
+    // the new one has loaded and validated above.
+    if (m_pLinker->HasLibNameRegistered(pUtf8LibName.m_psz))
+      m_pLinker->UnregisterLib(pUtf8LibName.m_psz);
+
     if (m_pLinker->RegisterLib(pUtf8LibName.m_psz, std::move(pModule),
                                std::move(pDebugModule))) {
-      m_blobs.emplace_back(pBlob);
+      m_blobs[pUtf8LibName.m_psz] = pBlob;
       return S_OK;
     } else {
       return E_INVALIDARG;
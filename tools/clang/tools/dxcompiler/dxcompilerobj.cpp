@@ -20,9 +20,13 @@
 #include "clang/Frontend/ASTUnit.h"
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Sema/SemaHLSL.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "clang/Frontend/FrontendActions.h"
+#include "clang/AST/DeclGroup.h"
 #include "clang/CodeGen/CodeGenAction.h"
+#include "clang/CodeGen/ModuleBuilder.h"
+#include "clang/CodeGen/BackendUtil.h"
 #include "llvm/IR/LLVMContext.h"
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/HLSL/HLSLExtensionsCodegenHelper.h"
@@ -33,6 +37,7 @@
 #include "dxc/DxilContainer/DxilContainerAssembler.h"
 #include "dxc/dxcapi.internal.h"
 #include "dxc/DXIL/DxilPDB.h"
+#include "dxc/DXIL/DxilUtil.h"
 
 #include "dxc/Support/dxcapi.use.h"
 #include "dxc/Support/Global.h"
@@ -42,13 +47,22 @@
 #include "dxc/Support/dxcapi.impl.h"
 #include "dxc/Support/DxcLangExtensionsHelper.h"
 #include "dxc/Support/HLSLOptions.h"
+#include "llvm/Support/ThreadPool.h"
 #ifdef _WIN32
 #include "dxcetw.h"
 #endif
 #include "dxillib.h"
 #include "dxcompileradapter.h"
+#include "llvm/Support/MD5.h"
 #include <algorithm>
 #include <cfloat>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 // SPIRV change starts
 #ifdef ENABLE_SPIRV_CODEGEN
@@ -68,6 +82,8 @@ using namespace hlsl;
 using std::string;
 
 DEFINE_CROSS_PLATFORM_UUIDOF(IDxcLangExtensions)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcCacheStorage)
+DEFINE_CROSS_PLATFORM_UUIDOF(IDxcCompileCache)
 
 // This declaration is used for the locally-linked validator.
 HRESULT CreateDxcValidator(_In_ REFIID riid, _Out_ LPVOID *ppv);
@@ -239,6 +255,76 @@ static HRESULT CreateContainerForPDB(IMalloc *pMalloc, IDxcBlob *pOldContainer,
   return S_OK;
 }
 
+namespace {
+
+// Records wall-clock durations of the major compilation phases when
+// -ftime-trace is enabled and renders them in the chrome://tracing
+// "trace event" JSON format (viewable in chrome://tracing or perfetto).
+class TimeTraceRecorder {
+public:
+  // Measures one phase. A null recorder disables the scope so call sites
+  // do not need their own -ftime-trace checks.
+  class Scope {
+  public:
+    Scope(TimeTraceRecorder *pRecorder, const char *pName)
+        : m_pRecorder(pRecorder), m_pName(pName) {
+      if (m_pRecorder)
+        m_Start = std::chrono::steady_clock::now();
+    }
+    ~Scope() {
+      if (!m_pRecorder)
+        return;
+      Event E;
+      E.Name = m_pName;
+      E.StartUS = m_pRecorder->MicrosecondsSinceOrigin(m_Start);
+      E.DurationUS =
+          m_pRecorder->MicrosecondsSinceOrigin(std::chrono::steady_clock::now()) -
+          E.StartUS;
+      m_pRecorder->m_Events.push_back(E);
+    }
+
+  private:
+    TimeTraceRecorder *m_pRecorder;
+    const char *m_pName;
+    std::chrono::steady_clock::time_point m_Start;
+  };
+
+  std::string Render() const {
+    std::string json;
+    llvm::raw_string_ostream OS(json);
+    OS << "{\"traceEvents\":[";
+    for (size_t i = 0; i < m_Events.size(); ++i) {
+      if (i)
+        OS << ",";
+      OS << "{\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << m_Events[i].StartUS
+         << ",\"dur\":" << m_Events[i].DurationUS << ",\"name\":\""
+         << m_Events[i].Name << "\"}";
+    }
+    OS << "]}";
+    OS.flush();
+    return json;
+  }
+
+private:
+  struct Event {
+    const char *Name; // string literal; never escaped when rendering
+    uint64_t StartUS;
+    uint64_t DurationUS;
+  };
+
+  uint64_t
+  MicrosecondsSinceOrigin(std::chrono::steady_clock::time_point tp) const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp - m_Origin)
+        .count();
+  }
+
+  std::vector<Event> m_Events;
+  std::chrono::steady_clock::time_point m_Origin =
+      std::chrono::steady_clock::now();
+};
+
+} // namespace
+
 #ifdef _WIN32
 
 #pragma fenv_access(on)
@@ -376,24 +462,198 @@ public:
   }
 };
 
-static void CreateDefineStrings(
-    _In_count_(defineCount) const DxcDefine *pDefines,
-    UINT defineCount,
-    std::vector<std::string> &defines) {
-  // Not very efficient but also not very important.
-  for (UINT32 i = 0; i < defineCount; i++) {
-    CW2A utf8Name(pDefines[i].Name, CP_UTF8);
-    CW2A utf8Value(pDefines[i].Value, CP_UTF8);
-    std::string val(utf8Name.m_psz);
-    val += "=";
-    val += (pDefines[i].Value) ? utf8Value.m_psz : "1";
-    defines.push_back(val);
+// Include handler wrapper that memoizes LoadSource results for the duration
+// of a CompileMany batch, so each header is read from the user's handler once
+// per batch rather than once per permutation.
+class BatchIncludeCache : public IDxcIncludeHandler {
+private:
+  DXC_MICROCOM_TM_REF_FIELDS()
+  CComPtr<IDxcIncludeHandler> m_pInner;
+  std::map<std::wstring, CComPtr<IDxcBlob>> m_blobs;
+public:
+  DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
+  DXC_MICROCOM_TM_CTOR(BatchIncludeCache)
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
+    return DoBasicQueryInterface<IDxcIncludeHandler>(this, iid, ppvObject);
   }
-}
 
-class DxcCompiler : public IDxcCompiler3,
+  void SetInner(IDxcIncludeHandler *pInner) { m_pInner = pInner; }
+
+  HRESULT STDMETHODCALLTYPE LoadSource(
+      _In_ LPCWSTR pFilename,
+      _COM_Outptr_result_maybenull_ IDxcBlob **ppIncludeSource) override {
+    if (pFilename == nullptr || ppIncludeSource == nullptr)
+      return E_POINTER;
+    *ppIncludeSource = nullptr;
+    try {
+      auto it = m_blobs.find(pFilename);
+      if (it != m_blobs.end()) {
+        return it->second.CopyTo(ppIncludeSource);
+      }
+      CComPtr<IDxcBlob> pBlob;
+      HRESULT hr = m_pInner->LoadSource(pFilename, &pBlob);
+      if (SUCCEEDED(hr) && pBlob != nullptr) {
+        m_blobs[pFilename] = pBlob;
+      }
+      *ppIncludeSource = pBlob.Detach();
+      return hr;
+    }
+    CATCH_CPP_RETURN_HRESULT();
+  }
+};
+
+// One queued CompileAsync job. Owns copies of the source and arguments so the
+// caller's buffers are free to go away once CompileAsync returns, and holds a
+// reference on the compiler so the instance outlives every outstanding job.
+class DxcAsyncCompileOperation : public IDxcAsyncCompileOperation {
+private:
+  DXC_MICROCOM_TM_REF_FIELDS()
+
+  enum class State { Queued, Running, Done };
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  State m_state = State::Queued;
+  bool m_canceled = false;
+
+public:
+  DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
+  DXC_MICROCOM_TM_CTOR(DxcAsyncCompileOperation)
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
+    return DoBasicQueryInterface<IDxcAsyncCompileOperation>(this, iid, ppvObject);
+  }
+
+  // Job inputs, filled in by CompileAsync before the operation is queued.
+  std::vector<char> m_source;
+  UINT32 m_sourceEncoding = 0;
+  std::vector<std::wstring> m_argStorage;
+  std::vector<LPCWSTR> m_args;
+  CComPtr<IDxcIncludeHandler> m_pIncludeHandler;
+  CComPtr<IDxcAsyncCompileCallback> m_pCallback;
+  CComPtr<IDxcCompiler3> m_pCompiler;
+
+  HRESULT STDMETHODCALLTYPE Cancel() override {
+    std::lock_guard<std::mutex> L(m_mutex);
+    if (m_state == State::Queued && !m_canceled) {
+      m_canceled = true;
+      return S_OK;
+    }
+    return S_FALSE;
+  }
+
+  HRESULT STDMETHODCALLTYPE WaitForCompletion() override {
+    std::unique_lock<std::mutex> L(m_mutex);
+    m_cv.wait(L, [this] { return m_state == State::Done; });
+    return S_OK;
+  }
+
+  // Runs on a pool worker. The callback fires exactly once, with E_ABORT and
+  // no result if the job was canceled before this point.
+  void Run() {
+    DxcThreadMalloc TM(m_pMalloc);
+    bool canceled;
+    {
+      std::lock_guard<std::mutex> L(m_mutex);
+      canceled = m_canceled;
+      if (!canceled)
+        m_state = State::Running;
+    }
+
+    HRESULT hr = E_ABORT;
+    CComPtr<IDxcResult> pResult;
+    if (!canceled) {
+      DxcBuffer buf = {};
+      buf.Ptr = m_source.data();
+      buf.Size = m_source.size();
+      buf.Encoding = m_sourceEncoding;
+      hr = m_pCompiler->Compile(&buf, m_args.empty() ? nullptr : m_args.data(),
+                                (UINT32)m_args.size(), m_pIncludeHandler,
+                                __uuidof(IDxcResult), (LPVOID *)&pResult);
+    }
+
+    m_pCallback->OnCompileComplete(hr, pResult);
+
+    {
+      std::lock_guard<std::mutex> L(m_mutex);
+      m_state = State::Done;
+    }
+    m_cv.notify_all();
+
+    // Drop the job's references now that the callback has run, so the
+    // compiler's lifetime is bounded by outstanding work rather than by how
+    // long the caller keeps the operation handle.
+    m_pIncludeHandler.Release();
+    m_pCallback.Release();
+    m_pCompiler.Release();
+  }
+};
+
+// Caps per-diagnostic rendering cost for warning-heavy compiles
+// (-fdiagnostics-render-limit=N). The first N warnings render in full; the
+// next 3*N render without source snippets and carets; anything beyond that
+// is only counted and reported as one trailing note. Errors always render
+// in full, and every diagnostic still updates the consumer counts, so
+// error limits and the compile status are unaffected.
+class RenderLimitedDiagnosticPrinter : public clang::DiagnosticConsumer {
+private:
+  TextDiagnosticPrinter &m_printer;
+  clang::DiagnosticOptions &m_diagOpts;
+  llvm::raw_ostream &m_os;
+  unsigned m_renderLimit;
+  unsigned m_renderedWarnings = 0;
+  unsigned m_suppressed = 0;
+
+public:
+  RenderLimitedDiagnosticPrinter(TextDiagnosticPrinter &printer,
+                                 clang::DiagnosticOptions &diagOpts,
+                                 llvm::raw_ostream &os, unsigned renderLimit)
+      : m_printer(printer), m_diagOpts(diagOpts), m_os(os),
+        m_renderLimit(renderLimit) {}
+
+  void BeginSourceFile(const clang::LangOptions &LO,
+                       const clang::Preprocessor *PP) override {
+    m_printer.BeginSourceFile(LO, PP);
+  }
+
+  void EndSourceFile() override {
+    m_printer.EndSourceFile();
+    if (m_suppressed != 0) {
+      m_os << "note: " << m_suppressed
+           << " diagnostics suppressed by -fdiagnostics-render-limit="
+           << m_renderLimit << "\n";
+    }
+  }
+
+  void HandleDiagnostic(clang::DiagnosticsEngine::Level Level,
+                        const clang::Diagnostic &Info) override {
+    // Keep this consumer's own error/warning counts accurate; they are what
+    // the engine's owner consults.
+    clang::DiagnosticConsumer::HandleDiagnostic(Level, Info);
+    if (Level >= clang::DiagnosticsEngine::Error) {
+      m_printer.HandleDiagnostic(Level, Info);
+      return;
+    }
+    if (m_renderedWarnings >= 4 * m_renderLimit) {
+      ++m_suppressed;
+      return;
+    }
+    if (m_renderedWarnings >= m_renderLimit) {
+      // Cheap mode: skip source-line extraction and caret rendering.
+      unsigned showCarets = m_diagOpts.ShowCarets;
+      m_diagOpts.ShowCarets = 0;
+      m_printer.HandleDiagnostic(Level, Info);
+      m_diagOpts.ShowCarets = showCarets;
+    } else {
+      m_printer.HandleDiagnostic(Level, Info);
+    }
+    ++m_renderedWarnings;
+  }
+};
+
+class DxcCompiler : public IDxcCompiler6,
                     public IDxcLangExtensions,
                     public IDxcContainerEvent,
+                    public IDxcCompileCache,
 #ifdef SUPPORT_QUERY_GIT_COMMIT_INFO
                     public IDxcVersionInfo2
 #else
@@ -404,8 +664,53 @@ private:
   DXC_MICROCOM_TM_REF_FIELDS()
   DxcLangExtensionsHelper m_langExtensionsHelper;
   CComPtr<IDxcContainerEventsHandler> m_pDxcContainerEventsHandler;
+  CComPtr<IDxcCacheStorage> m_pCacheStorage;
   DxcCompilerAdapter m_DxcCompilerAdapter;
 
+  // State shared between CompileAsync and its queued operations. The work
+  // itself runs on the process-wide hlsl::ThreadPool; this block only
+  // throttles how many of this instance's operations are in flight at once,
+  // so one compiler cannot monopolize the shared workers. Kept behind a
+  // shared_ptr so in-flight tasks touch only this block, never the compiler
+  // object: every queued operation holds a compiler reference, so by the
+  // time the destructor runs nothing is queued or running.
+  struct AsyncQueueState {
+    std::mutex Mutex;
+    std::deque<CComPtr<DxcAsyncCompileOperation>> Queue;
+    UINT32 MaxInFlight = 0;
+    UINT32 InFlight = 0;
+  };
+  std::mutex m_AsyncPoolMutex;
+  std::shared_ptr<AsyncQueueState> m_AsyncQueue;
+  UINT32 m_AsyncMaxConcurrency = 0; // 0 = hardware thread count
+
+  // Moves operations from the queue to the shared pool until the in-flight
+  // cap is reached; each completion pumps again, so the queue drains no
+  // matter how submissions and completions interleave.
+  static void PumpAsyncQueue(std::shared_ptr<AsyncQueueState> S) {
+    for (;;) {
+      CComPtr<DxcAsyncCompileOperation> op;
+      {
+        std::lock_guard<std::mutex> L(S->Mutex);
+        if (S->InFlight >= S->MaxInFlight || S->Queue.empty())
+          return;
+        op = S->Queue.front();
+        S->Queue.pop_front();
+        ++S->InFlight;
+      }
+      hlsl::ThreadPool::Get().Async(
+          [S, op]() {
+            op->Run();
+            {
+              std::lock_guard<std::mutex> L(S->Mutex);
+              --S->InFlight;
+            }
+            PumpAsyncQueue(S);
+          },
+          hlsl::ThreadPoolPriority::Normal);
+    }
+  }
+
 public:
   DxcCompiler(IMalloc *pMalloc) : m_dwRef(0), m_pMalloc(pMalloc), m_DxcCompilerAdapter(this, pMalloc) {}
   DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
@@ -424,11 +729,26 @@ public:
     return S_OK;
   }
 
+  HRESULT STDMETHODCALLTYPE RegisterCacheStorage(IDxcCacheStorage *pStorage) override {
+    if (pStorage == nullptr)
+      return E_INVALIDARG;
+    m_pCacheStorage = pStorage;
+    return S_OK;
+  }
+  HRESULT STDMETHODCALLTYPE UnRegisterCacheStorage() override {
+    m_pCacheStorage.Release();
+    return S_OK;
+  }
+
   HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
     HRESULT hr = DoBasicQueryInterface<
       IDxcCompiler3,
+      IDxcCompiler4,
+      IDxcCompiler5,
+      IDxcCompiler6,
       IDxcLangExtensions,
       IDxcContainerEvent,
+      IDxcCompileCache,
       IDxcVersionInfo
 #ifdef SUPPORT_QUERY_GIT_COMMIT_INFO
       ,IDxcVersionInfo2
@@ -470,7 +790,8 @@ public:
     try {
       DefaultFPEnvScope fpEnvScope;
 
-      IFT(CreateMemoryStream(m_pMalloc, &pOutputStream));
+      IFT(CreateMemoryStream(m_pMalloc, MemoryStreamPool::ModuleBitcode,
+                             &pOutputStream));
 
       // Parse command-line options into DxcOpts
       int argCountInt;
@@ -507,6 +828,14 @@ public:
       IFT(pResult->SetEncoding(opts.DefaultTextCodePage));
       DxcOutputObject primaryOutput;
 
+      TimeTraceRecorder timeTrace;
+      TimeTraceRecorder *pTimeTrace = opts.TimeTrace ? &timeTrace : nullptr;
+
+      // Pin the hash seed before any IR exists so hash-ordered containers
+      // cannot vary run to run or machine to machine.
+      if (opts.Deterministic)
+        llvm::set_fixed_execution_hash_seed(1);
+
       // Formerly API values.
       const char *pUtf8SourceName = opts.InputFile.empty() ? "hlsl.hlsl" : opts.InputFile.data();
       CA2W pUtf16SourceName(pUtf8SourceName, CP_UTF8);
@@ -528,6 +857,27 @@ public:
         true, false, pSource->Encoding != 0, pSource->Encoding,
         nullptr, &pSourceEncoding));
 
+      // Consult the compiled-result cache when a storage backend has been
+      // registered. The key hashes the preprocessed source rather than the
+      // raw source so that edits to included files invalidate entries.
+      std::string cacheKey;
+      if (m_pCacheStorage != nullptr && !isPreprocessing && !opts.GenSPIRV) {
+        cacheKey = ComputeCompileCacheKey(pSource, pArguments, argCount,
+                                          pIncludeHandler);
+        CComPtr<IDxcBlob> pCachedContainer;
+        if (!cacheKey.empty() &&
+            m_pCacheStorage->Lookup(cacheKey.c_str(), &pCachedContainer) == S_OK &&
+            pCachedContainer != nullptr) {
+          primaryOutput.kind = DXC_OUT_OBJECT;
+          IFT(primaryOutput.SetObject(pCachedContainer, opts.DefaultTextCodePage));
+          IFT(pResult->SetOutput(primaryOutput));
+          IFT(pResult->SetStatusAndPrimaryResult(S_OK, primaryOutput.kind));
+          IFT(pResult->QueryInterface(riid, ppResult));
+          hr = S_OK;
+          goto Cleanup;
+        }
+      }
+
  #ifdef ENABLE_SPIRV_CODEGEN
       // We want to embed the preprocessed source code in the final SPIR-V if
       // debug information is enabled. Therefore, we invoke Preprocess() here
@@ -574,9 +924,16 @@ public:
       IFT(pResult->SetOutputName(DXC_OUT_SHADER_HASH, opts.OutputShaderHashFile));
       IFT(pResult->SetOutputName(DXC_OUT_ERRORS, opts.OutputWarningsFile));
       IFT(pResult->SetOutputName(DXC_OUT_ROOT_SIGNATURE, opts.OutputRootSigFile));
+      std::string timeTraceName;
+      if (opts.TimeTrace && !opts.OutputObject.empty()) {
+        timeTraceName = (llvm::Twine(opts.OutputObject) + ".time-trace.json").str();
+        IFT(pResult->SetOutputName(DXC_OUT_TIME_TRACE, llvm::StringRef(timeTraceName)));
+      }
 
       if (opts.DisplayIncludeProcess)
         msfPtr->EnableDisplayIncludeProcess();
+      if (opts.CacheIncludes)
+        msfPtr->EnableSharedIncludeCache();
 
       IFT(msfPtr->RegisterOutputStream(L"output.bc", pOutputStream));
       IFT(msfPtr->CreateStdStreams(m_pMalloc));
@@ -584,17 +941,37 @@ public:
       StringRef Data(utf8Source->GetStringPointer(),
                      utf8Source->GetStringLength());
 
-      // Not very efficient but also not very important.
+      // The parsed -D values are already UTF-8 "name=value" strings; use them
+      // directly rather than round-tripping through the UTF-16 DxcDefine
+      // forms. Bare names get an explicit "=1" to match the old conversion.
       std::vector<std::string> defines;
-      CreateDefineStrings(opts.Defines.data(), opts.Defines.size(), defines);
+      defines.reserve(opts.Defines.DefineStrings.size());
+      for (llvm::StringRef define : opts.Defines.DefineStrings) {
+        std::string val = define.str();
+        if (define.find('=') == StringRef::npos)
+          val += "=1";
+        defines.push_back(std::move(val));
+      }
 
       // Setup a compiler instance.
       raw_stream_ostream outStream(pOutputStream.p);
-      llvm::LLVMContext llvmContext; // LLVMContext should outlive CompilerInstance
+      // The context must outlive CompilerInstance. With -fcontext-pool it is
+      // leased from a process-wide pool so type uniquing tables stay warm
+      // across compiles.
+      dxcutil::PooledLLVMContext llvmContextLease(opts.ContextPool);
+      llvm::LLVMContext &llvmContext = llvmContextLease.get();
       CompilerInstance compiler;
       std::unique_ptr<TextDiagnosticPrinter> diagPrinter =
           llvm::make_unique<TextDiagnosticPrinter>(w, &compiler.getDiagnosticOpts());
-      SetupCompilerForCompile(compiler, &m_langExtensionsHelper, pUtf8SourceName, diagPrinter.get(), defines, opts, pArguments, argCount);
+      std::unique_ptr<RenderLimitedDiagnosticPrinter> limitedPrinter;
+      clang::DiagnosticConsumer *pDiagConsumer = diagPrinter.get();
+      if (opts.DiagRenderLimit > 0) {
+        limitedPrinter = llvm::make_unique<RenderLimitedDiagnosticPrinter>(
+            *diagPrinter, compiler.getDiagnosticOpts(), w,
+            opts.DiagRenderLimit);
+        pDiagConsumer = limitedPrinter.get();
+      }
+      SetupCompilerForCompile(compiler, &m_langExtensionsHelper, pUtf8SourceName, pDiagConsumer, defines, opts, pArguments, argCount);
       msfPtr->SetupForCompilerInstance(compiler);
 
       // The clang entry point (cc1_main) would now create a compiler invocation
@@ -630,9 +1007,19 @@ public:
         PPOutOpts.ShowMacros = 0;         // Print macro definitions.
         PPOutOpts.RewriteIncludes = 0;    // Preprocess include directives only.
 
+        // PrintPreprocessedAction only stands up the lexer machinery
+        // (SourceManager, HeaderSearch, Preprocessor) - no ASTContext or Sema
+        // is ever created on this path. The avoidable costs are on the output
+        // side: size the stream for the source up front so token-at-a-time
+        // printing does not repeatedly regrow it. Preprocessed output is
+        // rarely smaller than the input.
+        IFT(pOutputStream->Reserve(
+            (ULONG)std::min<SIZE_T>(utf8Source->GetStringLength(), ULONG_MAX)));
+
         FrontendInputFile file(pUtf8SourceName, IK_HLSL);
         clang::PrintPreprocessedAction action;
         if (action.BeginSourceFile(compiler, file)) {
+          TimeTraceRecorder::Scope TTS(pTimeTrace, "Preprocess");
           action.Execute();
           action.EndSourceFile();
         }
@@ -659,9 +1046,16 @@ public:
 
         // NOTE: this calls the validation component from dxil.dll; the built-in
         // validator can be used as a fallback.
-        produceFullContainer = !opts.CodeGenHighLevel && !opts.AstDump && !opts.OptDump && rootSigMajor == 0;
+        produceFullContainer = !opts.CodeGenHighLevel && !opts.AstDump &&
+                               !opts.OptDump && !opts.EmitPCH &&
+                               rootSigMajor == 0;
         needsValidation = produceFullContainer && !opts.DisableValidation;
 
+        // The DXIL validator re-runs llvm::verifyModule as its bitcode phase,
+        // so when validation is queued the validator is authoritative and
+        // clang's per-function verifier pass would walk the same IR twice.
+        compiler.getCodeGenOpts().VerifyModule = !needsValidation;
+
         if (compiler.getCodeGenOpts().HLSLProfile == "lib_6_x") {
           // Currently do not support stripping reflection from offline linking target.
           opts.KeepReflectionInDxil = true;
@@ -684,7 +1078,21 @@ public:
           1, 5) >= 0;
       }
 
-      if (opts.AstDump) {
+      // Compile against a precompiled header if one was provided; the prefix
+      // headers are then deserialized instead of re-lexed and re-parsed.
+      if (!opts.IncludePCH.empty())
+        compiler.getPreprocessorOpts().ImplicitPCHInclude = opts.IncludePCH;
+
+      if (opts.EmitPCH) {
+        clang::GeneratePCHAction action;
+        FrontendInputFile file(pUtf8SourceName, IK_HLSL);
+        if (action.BeginSourceFile(compiler, file)) {
+          action.Execute();
+          action.EndSourceFile();
+        }
+        outStream.flush();
+      }
+      else if (opts.AstDump) {
         clang::ASTDumpAction dumpAction;
         // Consider - ASTDumpFilter, ASTDumpLookups
         compiler.getFrontendOpts().ASTDumpDecls = true;
@@ -750,7 +1158,10 @@ public:
         clang::EmitSpirvAction action;
         FrontendInputFile file(pUtf8SourceName, IK_HLSL);
         action.BeginSourceFile(compiler, file);
-        action.Execute();
+        {
+          TimeTraceRecorder::Scope TTS(pTimeTrace, "Frontend");
+          action.Execute();
+        }
         action.EndSourceFile();
         outStream.flush();
       }
@@ -761,7 +1172,12 @@ public:
         FrontendInputFile file(pUtf8SourceName, IK_HLSL);
         bool compileOK;
         if (action.BeginSourceFile(compiler, file)) {
-          action.Execute();
+          {
+            // Parse, sema, CGHLSLMS codegen and the HLSL optimization
+            // pipeline all run under ExecuteAction.
+            TimeTraceRecorder::Scope TTS(pTimeTrace, "Frontend");
+            action.Execute();
+          }
           action.EndSourceFile();
           compileOK = !compiler.getDiagnostics().hasErrorOccurred();
         }
@@ -780,6 +1196,9 @@ public:
         if (opts.EmbedDebugInfo()) {
           SerializeFlags |= SerializeDxilFlags::IncludeDebugInfoPart;
         }
+        if (opts.CompressDebug) {
+          SerializeFlags |= SerializeDxilFlags::CompressDebugInfoPart;
+        }
         if (opts.DebugNameForSource) {
           // Implies name part
           SerializeFlags |= SerializeDxilFlags::IncludeDebugNamePart;
@@ -807,15 +1226,29 @@ public:
           IFT(CreateMemoryStream(DxcGetThreadMallocNoRef(), &pReflectionStream));
           IFT(CreateMemoryStream(DxcGetThreadMallocNoRef(), &pRootSigStream));
 
+          // -fparallel-codegen opts into overlapped container serialization.
+          hlsl::SetDxilContainerParallelSerialization(opts.ParallelCodeGen);
+          std::unique_ptr<llvm::Module> serializeModule = action.takeModule();
+          // Shrink the runtime container: local names and ident metadata
+          // survive to this point only for debugging, which /Qminimize
+          // forgoes.
+          if (opts.MinimizeContainer)
+            hlsl::dxilutil::MinimizeModuleForRuntime(*serializeModule);
           dxcutil::AssembleInputs inputs(
-                action.takeModule(), pOutputBlob, m_pMalloc, SerializeFlags,
+                std::move(serializeModule), pOutputBlob, m_pMalloc, SerializeFlags,
                 pOutputStream, opts.IsDebugInfoEnabled(),
                 opts.GetPDBName(), &compiler.getDiagnostics(),
                 &ShaderHashContent, pReflectionStream, pRootSigStream);
-          if (needsValidation) {
-            valHR = dxcutil::ValidateAndAssembleToContainer(inputs);
-          } else {
-            dxcutil::AssembleToContainer(inputs);
+          {
+            TimeTraceRecorder::Scope TTS(pTimeTrace,
+                                         needsValidation
+                                             ? "SerializeAndValidateContainer"
+                                             : "SerializeContainer");
+            if (needsValidation) {
+              valHR = dxcutil::ValidateAndAssembleToContainer(inputs);
+            } else {
+              dxcutil::AssembleToContainer(inputs);
+            }
           }
 
           // Callback after valid DXIL is produced
@@ -874,6 +1307,12 @@ public:
         IFT(pResult->SetOutputObject(DXC_OUT_ERRORS, pErrorBlob));
       }
 
+      if (pTimeTrace) {
+        std::string trace = timeTrace.Render();
+        IFT(pResult->SetOutputString(DXC_OUT_TIME_TRACE, trace.c_str(),
+                                     trace.size()));
+      }
+
       bool hasErrorOccurred = compiler.getDiagnostics().hasErrorOccurred();
 
       bool writePDB = opts.IsDebugInfoEnabled() && produceFullContainer;
@@ -887,11 +1326,31 @@ public:
       if (!hasErrorOccurred && writePDB) {
         CComPtr<IDxcBlob> pDebugBlob;
         IFT(pOutputStream.QueryInterface(&pDebugBlob));
-        CComPtr<IDxcBlob> pStrippedContainer;
-        IFT(CreateContainerForPDB(m_pMalloc, pOutputBlob, pDebugBlob, &pStrippedContainer));
-        pDebugBlob.Release();
-        IFT(hlsl::pdb::WriteDxilPDB(m_pMalloc, pStrippedContainer, ShaderHashContent.Digest, &pDebugBlob));
-        IFT(pResult->SetOutputObject(DXC_OUT_PDB, pDebugBlob));
+        // Defer PDB production to the first GetOutput(DXC_OUT_PDB) call; the
+        // container strip and MSF write are expensive and many callers never
+        // read the PDB. The captured blobs keep the inputs alive.
+        CComPtr<IMalloc> pMalloc = m_pMalloc;
+        CComPtr<IDxcBlob> pContainerBlob = pOutputBlob;
+        DxilShaderHash PdbHashContent = ShaderHashContent;
+        IFT(pResult->SetDeferredOutput(DXC_OUT_PDB,
+          [pMalloc, pContainerBlob, pDebugBlob, PdbHashContent]
+          (IDxcBlob **ppPdb) -> HRESULT {
+            DxcThreadMalloc TM(pMalloc);
+            CComPtr<IDxcBlob> pStrippedContainer;
+            IFR(CreateContainerForPDB(pMalloc, pContainerBlob, pDebugBlob,
+                                      &pStrippedContainer));
+            return hlsl::pdb::WriteDxilPDB(pMalloc, pStrippedContainer,
+                                           PdbHashContent.Digest, ppPdb);
+          }));
+      }
+
+      // Remember clean full-container compiles; compiles with diagnostics are
+      // redone from source so that the messages are replayed. A failure to
+      // store never fails the compile.
+      if (m_pCacheStorage != nullptr && !cacheKey.empty() &&
+          produceFullContainer && !hasErrorOccurred &&
+          pOutputBlob != nullptr && w.str().empty()) {
+        m_pCacheStorage->Store(cacheKey.c_str(), pOutputBlob);
       }
 
       IFT(primaryOutput.SetObject(pOutputBlob, opts.DefaultTextCodePage));
@@ -926,6 +1385,452 @@ public:
     return hr;
   }
 
+  // Compile one source text under several argument sets. Front-end state
+  // cannot be shared soundly across sets whose defines differ (they change
+  // preprocessing), so the amortization here is the per-batch allocator and
+  // a batch-scoped include cache; combine with -include-pch for a shared
+  // prefix header. Results are produced independently: a failing set leaves
+  // its slot null and the first failing HRESULT is returned.
+  HRESULT STDMETHODCALLTYPE CompileMany(
+    _In_ const DxcBuffer *pSource,
+    _In_count_(setCount) LPCWSTR **pArgumentSets,
+    _In_count_(setCount) UINT32 *pArgCounts,
+    _In_ UINT32 setCount,
+    _In_opt_ IDxcIncludeHandler *pIncludeHandler,
+    _In_ REFIID riid, _Out_writes_(setCount) LPVOID *ppResults
+  ) override {
+    if (pSource == nullptr || pArgumentSets == nullptr ||
+        pArgCounts == nullptr || setCount == 0 || ppResults == nullptr)
+      return E_INVALIDARG;
+
+    DxcThreadMalloc TM(m_pMalloc);
+    for (UINT32 i = 0; i < setCount; ++i)
+      ppResults[i] = nullptr;
+
+    CComPtr<BatchIncludeCache> pIncludeCache;
+    IDxcIncludeHandler *pBatchHandler = pIncludeHandler;
+    if (pIncludeHandler != nullptr) {
+      pIncludeCache = BatchIncludeCache::Alloc(m_pMalloc);
+      if (pIncludeCache == nullptr)
+        return E_OUTOFMEMORY;
+      pIncludeCache->SetInner(pIncludeHandler);
+      pBatchHandler = pIncludeCache;
+    }
+
+    HRESULT hrResult = S_OK;
+    for (UINT32 i = 0; i < setCount; ++i) {
+      HRESULT hr = Compile(pSource, pArgumentSets[i], pArgCounts[i],
+                           pBatchHandler, riid, &ppResults[i]);
+      if (FAILED(hr) && SUCCEEDED(hrResult))
+        hrResult = hr;
+    }
+    return hrResult;
+  }
+
+  // Compile several entry points over one parse. The translation unit is
+  // parsed and checked once with no entry selected (deferring the
+  // entry-specific end-of-TU validation), then per entry a fresh
+  // CodeGenerator replays the shared AST - the decl replay model AST-file
+  // compilation uses - and the backend and container serialization run as
+  // they would for a single compile. Diagnostics are re-armed per entry so
+  // one entry's errors do not poison the next; each result carries the
+  // shared front-end text plus that entry's own diagnostics.
+  HRESULT STDMETHODCALLTYPE CompileEntryPoints(
+    _In_ const DxcBuffer *pSource,
+    _In_opt_count_(argCount) LPCWSTR *pArguments,
+    _In_ UINT32 argCount,
+    _In_count_(entryCount) LPCWSTR *pEntryPoints,
+    _In_ UINT32 entryCount,
+    _In_opt_ IDxcIncludeHandler *pIncludeHandler,
+    _In_ REFIID riid, _Out_writes_(entryCount) LPVOID *ppResults
+  ) override {
+    if (pSource == nullptr || pSource->Ptr == nullptr ||
+        pEntryPoints == nullptr || entryCount == 0 || ppResults == nullptr ||
+        (argCount > 0 && pArguments == nullptr))
+      return E_INVALIDARG;
+    if (!(IsEqualIID(riid, __uuidof(IDxcResult)) ||
+          IsEqualIID(riid, __uuidof(IDxcOperationResult))))
+      return E_INVALIDARG;
+    for (UINT32 i = 0; i < entryCount; ++i)
+      ppResults[i] = nullptr;
+
+    DxcThreadMalloc TM(m_pMalloc);
+    HRESULT hr = S_OK;
+    bool bCompileStarted = false;
+    try {
+      DefaultFPEnvScope fpEnvScope;
+
+      // Parse the shared command-line options once.
+      int argCountInt;
+      IFT(UIntToInt(argCount, &argCountInt));
+      hlsl::options::MainArgs mainArgs(argCountInt, pArguments, 0);
+      hlsl::options::DxcOpts opts;
+      std::string warnings;
+      raw_string_ostream w(warnings);
+      {
+        bool finished = false;
+        CComPtr<IDxcOperationResult> pOptionResult;
+        CComPtr<AbstractMemoryStream> pOptionErrorStream;
+        IFT(CreateMemoryStream(m_pMalloc, &pOptionErrorStream));
+        dxcutil::ReadOptsAndValidate(mainArgs, opts, pOptionErrorStream,
+                                     &pOptionResult, finished);
+        if (finished) {
+          // Replicate the option-parse result into every slot.
+          for (UINT32 i = 0; i < entryCount; ++i)
+            IFT(pOptionResult->QueryInterface(riid, &ppResults[i]));
+          return S_OK;
+        }
+        if (pOptionErrorStream->GetPtrSize() > 0)
+          w << StringRef((const char *)pOptionErrorStream->GetPtr(),
+                         (size_t)pOptionErrorStream->GetPtrSize());
+      }
+
+      // Only plain shader compilation can share a front-end pass;
+      // single-result modes keep going through Compile. Entry names come
+      // exclusively from pEntryPoints.
+      if (!opts.Preprocess.empty() || opts.AstDump || opts.OptDump ||
+          opts.EmitPCH || opts.CodeGenHighLevel || opts.IsLibraryProfile() ||
+          opts.TargetProfile.startswith("rootsig_") ||
+          !opts.EntryPoint.empty())
+        return E_INVALIDARG;
+#ifdef ENABLE_SPIRV_CODEGEN
+      if (opts.GenSPIRV)
+        return E_INVALIDARG;
+#endif
+
+      std::vector<std::string> entryNames(entryCount);
+      for (UINT32 i = 0; i < entryCount; ++i) {
+        IFTARG(pEntryPoints[i] != nullptr);
+        IFTARG(Unicode::UTF16ToUTF8String(pEntryPoints[i],
+                                          wcslen(pEntryPoints[i]),
+                                          &entryNames[i]));
+        IFTARG(!entryNames[i].empty());
+      }
+
+      DxcEtw_DXCompilerCompile_Start();
+      bCompileStarted = true;
+
+      // Pin the hash seed before any IR exists so hash-ordered containers
+      // cannot vary run to run or machine to machine.
+      if (opts.Deterministic)
+        llvm::set_fixed_execution_hash_seed(1);
+
+      const char *pUtf8SourceName =
+          opts.InputFile.empty() ? "hlsl.hlsl" : opts.InputFile.data();
+      CA2W pUtf16SourceName(pUtf8SourceName, CP_UTF8);
+
+      // Wrap the source in a blob and normalize to UTF-8.
+      CComPtr<IDxcBlobEncoding> pSourceEncoding;
+      IFT(hlsl::DxcCreateBlob(pSource->Ptr, pSource->Size, true, false,
+                              pSource->Encoding != 0, pSource->Encoding,
+                              nullptr, &pSourceEncoding));
+      CComPtr<IDxcBlobUtf8> utf8Source;
+      IFT(hlsl::DxcGetBlobAsUtf8(pSourceEncoding, m_pMalloc, &utf8Source));
+
+      dxcutil::DxcArgsFileSystem *msfPtr = dxcutil::CreateDxcArgsFileSystem(
+          utf8Source, pUtf16SourceName.m_psz, pIncludeHandler);
+      std::unique_ptr<::llvm::sys::fs::MSFileSystem> msf(msfPtr);
+      ::llvm::sys::fs::AutoPerThreadSystem pts(msf.get());
+      IFTLLVM(pts.error_code());
+      if (opts.DisplayIncludeProcess)
+        msfPtr->EnableDisplayIncludeProcess();
+      if (opts.CacheIncludes)
+        msfPtr->EnableSharedIncludeCache();
+      IFT(msfPtr->CreateStdStreams(m_pMalloc));
+
+      // The parsed -D values are already UTF-8 "name=value" strings; bare
+      // names get an explicit "=1" as in Compile.
+      std::vector<std::string> defines;
+      defines.reserve(opts.Defines.DefineStrings.size());
+      for (llvm::StringRef define : opts.Defines.DefineStrings) {
+        std::string val = define.str();
+        if (define.find('=') == StringRef::npos)
+          val += "=1";
+        defines.push_back(std::move(val));
+      }
+
+      // The context must outlive CompilerInstance.
+      dxcutil::PooledLLVMContext llvmContextLease(opts.ContextPool);
+      llvm::LLVMContext &llvmContext = llvmContextLease.get();
+      CompilerInstance compiler;
+      std::unique_ptr<TextDiagnosticPrinter> diagPrinter =
+          llvm::make_unique<TextDiagnosticPrinter>(
+              w, &compiler.getDiagnosticOpts());
+      SetupCompilerForCompile(compiler, &m_langExtensionsHelper,
+                              pUtf8SourceName, diagPrinter.get(), defines,
+                              opts, pArguments, argCount);
+      msfPtr->SetupForCompilerInstance(compiler);
+
+      // Parse and Sema run entry-agnostically: with no entry named,
+      // hlsl::DiagnoseTranslationUnit defers the entry-specific end-of-TU
+      // validation, which is re-run per entry below.
+      compiler.getLangOpts().HLSLEntryFunction =
+          compiler.getCodeGenOpts().HLSLEntryFunction = "";
+      compiler.getLangOpts().HLSLProfile =
+          compiler.getCodeGenOpts().HLSLProfile = opts.TargetProfile;
+
+      const bool needsValidation = !opts.DisableValidation;
+      // The DXIL validator re-runs llvm::verifyModule as its bitcode phase.
+      compiler.getCodeGenOpts().VerifyModule = !needsValidation;
+      if (opts.ValVerMajor != UINT_MAX) {
+        compiler.getCodeGenOpts().HLSLValidatorMajorVer = opts.ValVerMajor;
+        compiler.getCodeGenOpts().HLSLValidatorMinorVer = opts.ValVerMinor;
+      } else {
+        dxcutil::GetValidatorVersion(
+            &compiler.getCodeGenOpts().HLSLValidatorMajorVer,
+            &compiler.getCodeGenOpts().HLSLValidatorMinorVer);
+      }
+      if (!opts.IncludePCH.empty())
+        compiler.getPreprocessorOpts().ImplicitPCHInclude = opts.IncludePCH;
+
+      SerializeDxilFlags SerializeFlags = SerializeDxilFlags::None;
+      if (opts.EmbedPDBName())
+        SerializeFlags |= SerializeDxilFlags::IncludeDebugNamePart;
+      if (opts.EmbedDebugInfo())
+        SerializeFlags |= SerializeDxilFlags::IncludeDebugInfoPart;
+      if (opts.CompressDebug)
+        SerializeFlags |= SerializeDxilFlags::CompressDebugInfoPart;
+      if (opts.DebugNameForSource) {
+        SerializeFlags |= SerializeDxilFlags::IncludeDebugNamePart;
+        SerializeFlags |= SerializeDxilFlags::DebugNameDependOnSource;
+      } else if (opts.DebugNameForBinary) {
+        SerializeFlags |= SerializeDxilFlags::IncludeDebugNamePart;
+      }
+      if (!opts.KeepReflectionInDxil)
+        SerializeFlags |= SerializeDxilFlags::StripReflectionFromDxilPart;
+      if (!opts.StripReflection)
+        SerializeFlags |= SerializeDxilFlags::IncludeReflectionPart;
+      if (opts.StripRootSignature)
+        SerializeFlags |= SerializeDxilFlags::StripRootSignature;
+
+      // The one front-end pass.
+      clang::SyntaxOnlyAction parseAction;
+      FrontendInputFile file(pUtf8SourceName, IK_HLSL);
+      bool parseOK = parseAction.BeginSourceFile(compiler, file);
+      if (parseOK) {
+        // EndSourceFile would free the AST and Sema; it is deferred until
+        // every entry has run code generation over them.
+        parseAction.Execute();
+      }
+      bool parseErrors =
+          !parseOK || compiler.getDiagnostics().hasErrorOccurred();
+      msfPtr->WriteStdErrToStream(w);
+      w.flush();
+      const size_t parseMark = warnings.size();
+
+      for (UINT32 i = 0; i < entryCount; ++i) {
+        CComPtr<DxcResult> pResult = DxcResult::Alloc(m_pMalloc);
+        IFT(pResult->SetEncoding(opts.DefaultTextCodePage));
+
+        w.flush();
+        const size_t entryMark = warnings.size();
+        bool entryOK = !parseErrors;
+
+        CComPtr<IDxcBlob> pOutputBlob;
+        DxilShaderHash ShaderHashContent;
+        CComPtr<AbstractMemoryStream> pReflectionStream;
+        CComPtr<AbstractMemoryStream> pRootSigStream;
+
+        if (entryOK) {
+          // Re-arm the diagnostics for this entry; the sticky error state
+          // would otherwise leak one entry's failure into the next. Reset
+          // drops the command-line warning mappings, so replay them.
+          compiler.getDiagnostics().Reset();
+          clang::ProcessWarningOptions(compiler.getDiagnostics(),
+                                       compiler.getDiagnosticOpts(), false);
+          compiler.getLangOpts().HLSLEntryFunction =
+              compiler.getCodeGenOpts().HLSLEntryFunction = entryNames[i];
+
+          // Entry-specific Sema validation deferred from the shared parse.
+          hlsl::DiagnoseTranslationUnit(&compiler.getSema());
+          entryOK = !compiler.getDiagnostics().hasErrorOccurred();
+        }
+
+        std::unique_ptr<llvm::Module> M;
+        if (entryOK) {
+          std::unique_ptr<clang::CodeGenerator> CG(clang::CreateLLVMCodeGen(
+              compiler.getDiagnostics(), pUtf8SourceName,
+              compiler.getHeaderSearchOpts(), compiler.getPreprocessorOpts(),
+              compiler.getCodeGenOpts(), llvmContext));
+          ASTContext &astContext = compiler.getASTContext();
+          CG->Initialize(astContext);
+          for (Decl *D : astContext.getTranslationUnitDecl()->decls()) {
+            if (!CG->HandleTopLevelDecl(DeclGroupRef(D)))
+              break;
+          }
+          CG->HandleTranslationUnit(astContext);
+          M.reset(CG->ReleaseModule());
+          entryOK = M != nullptr &&
+                    !compiler.getDiagnostics().hasErrorOccurred();
+        }
+
+        CComPtr<AbstractMemoryStream> pEntryBitcode;
+        IFT(CreateMemoryStream(m_pMalloc, MemoryStreamPool::ModuleBitcode,
+                               &pEntryBitcode));
+        if (entryOK) {
+          llvm::SmallVector<char, 0> bitcode;
+          llvm::raw_svector_ostream bcOS(bitcode);
+          clang::EmitBackendOutput(
+              compiler.getDiagnostics(), compiler.getCodeGenOpts(),
+              compiler.getTargetOpts(), compiler.getLangOpts(),
+              compiler.getTarget().getTargetDescription(), M.get(),
+              clang::Backend_EmitBC, &bcOS);
+          bcOS.flush();
+          ULONG cbWritten;
+          IFT(pEntryBitcode->Write(bitcode.data(), (ULONG)bitcode.size(),
+                                   &cbWritten));
+          entryOK = !compiler.getDiagnostics().hasErrorOccurred();
+        }
+
+        if (entryOK) {
+          IFT(CreateMemoryStream(DxcGetThreadMallocNoRef(),
+                                 &pReflectionStream));
+          IFT(CreateMemoryStream(DxcGetThreadMallocNoRef(), &pRootSigStream));
+          hlsl::SetDxilContainerParallelSerialization(opts.ParallelCodeGen);
+          if (opts.MinimizeContainer)
+            hlsl::dxilutil::MinimizeModuleForRuntime(*M);
+          dxcutil::AssembleInputs inputs(
+              std::move(M), pOutputBlob, m_pMalloc, SerializeFlags,
+              pEntryBitcode, opts.IsDebugInfoEnabled(), opts.GetPDBName(),
+              &compiler.getDiagnostics(), &ShaderHashContent,
+              pReflectionStream, pRootSigStream);
+          HRESULT valHR = S_OK;
+          if (needsValidation)
+            valHR = dxcutil::ValidateAndAssembleToContainer(inputs);
+          else
+            dxcutil::AssembleToContainer(inputs);
+          entryOK = SUCCEEDED(valHR) &&
+                    !compiler.getDiagnostics().hasErrorOccurred();
+        }
+
+        if (entryOK) {
+          if (pReflectionStream && pReflectionStream->GetPtrSize()) {
+            CComPtr<IDxcBlob> pReflection;
+            IFT(pReflectionStream->QueryInterface(&pReflection));
+            IFT(pResult->SetOutputObject(DXC_OUT_REFLECTION, pReflection));
+          }
+          if (pRootSigStream && pRootSigStream->GetPtrSize()) {
+            CComPtr<IDxcBlob> pRootSignature;
+            IFT(pRootSigStream->QueryInterface(&pRootSignature));
+            IFT(pResult->SetOutputObject(DXC_OUT_ROOT_SIGNATURE,
+                                         pRootSignature));
+          }
+          CComPtr<IDxcBlob> pHashBlob;
+          IFT(hlsl::DxcCreateBlobOnHeapCopy(
+              &ShaderHashContent, (UINT32)sizeof(ShaderHashContent),
+              &pHashBlob));
+          IFT(pResult->SetOutputObject(DXC_OUT_SHADER_HASH, pHashBlob));
+        }
+
+        // Shared front-end text plus this entry's own diagnostics.
+        w.flush();
+        std::string entryText = warnings.substr(0, parseMark);
+        entryText += warnings.substr(entryMark);
+        IFT(pResult->SetOutputString(DXC_OUT_ERRORS, entryText.c_str(),
+                                     entryText.size()));
+
+        DxcOutputObject primaryOutput;
+        primaryOutput.kind = DXC_OUT_OBJECT;
+        if (entryOK && pOutputBlob != nullptr)
+          IFT(primaryOutput.SetObject(pOutputBlob, opts.DefaultTextCodePage));
+        IFT(pResult->SetOutput(primaryOutput));
+        IFT(pResult->SetStatusAndPrimaryResult(entryOK ? S_OK : E_FAIL,
+                                               primaryOutput.kind));
+        IFT(pResult->QueryInterface(riid, &ppResults[i]));
+      }
+
+      if (parseOK)
+        parseAction.EndSourceFile();
+      hr = S_OK;
+    } catch (std::bad_alloc &) {
+      hr = E_OUTOFMEMORY;
+    } catch (hlsl::Exception &e) {
+      _Analysis_assume_(DXC_FAILED(e.hr));
+      hr = e.hr;
+    } catch (...) {
+      hr = E_FAIL;
+    }
+    if (bCompileStarted) {
+      DxcEtw_DXCompilerCompile_Stop(hr);
+    }
+    return hr;
+  }
+
+  HRESULT STDMETHODCALLTYPE SetMaxAsyncConcurrency(
+    _In_ UINT32 maxConcurrency
+  ) override {
+    std::lock_guard<std::mutex> L(m_AsyncPoolMutex);
+    if (m_AsyncQueue != nullptr)
+      return E_FAIL; // Queue exists; the limit is fixed at first CompileAsync.
+    m_AsyncMaxConcurrency = maxConcurrency;
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE SetMaxWorkerThreads(
+    _In_ UINT32 maxWorkers
+  ) override {
+    // Process-global: configures the shared pool that parallel validation,
+    // container serialization, and CompileAsync all draw from. Fails once
+    // the first task has started the workers.
+    return hlsl::ThreadPool::SetWorkerCountCap(maxWorkers) ? S_OK : E_FAIL;
+  }
+
+  HRESULT STDMETHODCALLTYPE CompileAsync(
+    _In_ const DxcBuffer *pSource,
+    _In_opt_count_(argCount) LPCWSTR *pArguments,
+    _In_ UINT32 argCount,
+    _In_opt_ IDxcIncludeHandler *pIncludeHandler,
+    _In_ IDxcAsyncCompileCallback *pCallback,
+    _COM_Outptr_opt_ IDxcAsyncCompileOperation **ppOperation
+  ) override {
+    if (pSource == nullptr || pSource->Ptr == nullptr || pCallback == nullptr ||
+        (argCount > 0 && pArguments == nullptr))
+      return E_INVALIDARG;
+    if (ppOperation != nullptr)
+      *ppOperation = nullptr;
+
+    DxcThreadMalloc TM(m_pMalloc);
+    try {
+      CComPtr<DxcAsyncCompileOperation> op =
+          DxcAsyncCompileOperation::Alloc(m_pMalloc);
+      IFROOM(op.p);
+      const char *pBytes = (const char *)pSource->Ptr;
+      op->m_source.assign(pBytes, pBytes + pSource->Size);
+      op->m_sourceEncoding = pSource->Encoding;
+      op->m_argStorage.reserve(argCount);
+      for (UINT32 i = 0; i < argCount; ++i)
+        op->m_argStorage.emplace_back(pArguments[i]);
+      for (const std::wstring &arg : op->m_argStorage)
+        op->m_args.push_back(arg.c_str());
+      op->m_pIncludeHandler = pIncludeHandler;
+      op->m_pCallback = pCallback;
+      op->m_pCompiler = static_cast<IDxcCompiler3 *>(this);
+
+      std::shared_ptr<AsyncQueueState> queue;
+      {
+        std::lock_guard<std::mutex> L(m_AsyncPoolMutex);
+        if (m_AsyncQueue == nullptr) {
+          std::shared_ptr<AsyncQueueState> S = std::make_shared<AsyncQueueState>();
+          S->MaxInFlight = m_AsyncMaxConcurrency != 0
+                               ? m_AsyncMaxConcurrency
+                               : std::max(1u, std::thread::hardware_concurrency());
+          m_AsyncQueue = S;
+        }
+        queue = m_AsyncQueue;
+      }
+      {
+        std::lock_guard<std::mutex> L(queue->Mutex);
+        queue->Queue.push_back(op);
+      }
+      PumpAsyncQueue(queue);
+
+      if (ppOperation != nullptr)
+        *ppOperation = op.Detach();
+      return S_OK;
+    }
+    CATCH_CPP_RETURN_HRESULT();
+  }
+
   // Disassemble a program.
   virtual HRESULT STDMETHODCALLTYPE Disassemble(
     _In_ const DxcBuffer *pObject,                // Program to disassemble: dxil container or bitcode.
@@ -987,9 +1892,55 @@ public:
     return hr;
   }
 
+  // Builds the content-addressed key for the compiled-result cache: an MD5
+  // digest over the preprocessed source and the argument vector (already
+  // normalized by ReadDxcOpts). Returns an empty string if preprocessing
+  // fails; the caller then compiles without consulting the cache.
+  std::string ComputeCompileCacheKey(
+      _In_ const DxcBuffer *pSource,
+      _In_opt_count_(argCount) LPCWSTR *pArguments, _In_ UINT32 argCount,
+      _In_opt_ IDxcIncludeHandler *pIncludeHandler) {
+    try {
+      CComPtr<IDxcResult> pPreprocessResult;
+      std::vector<LPCWSTR> PreprocessArgs;
+      PreprocessArgs.reserve(argCount + 2);
+      PreprocessArgs.assign(pArguments, pArguments + argCount);
+      PreprocessArgs.push_back(L"-P");
+      PreprocessArgs.push_back(L"preprocessed.hlsl");
+      if (FAILED(Compile(pSource, PreprocessArgs.data(), PreprocessArgs.size(),
+                         pIncludeHandler, IID_PPV_ARGS(&pPreprocessResult))))
+        return std::string();
+      HRESULT status;
+      if (FAILED(pPreprocessResult->GetStatus(&status)) || FAILED(status))
+        return std::string();
+      CComPtr<IDxcBlob> pPreprocessed;
+      if (FAILED(pPreprocessResult->GetOutput(
+              DXC_OUT_HLSL, IID_PPV_ARGS(&pPreprocessed), nullptr)) ||
+          pPreprocessed == nullptr)
+        return std::string();
+
+      llvm::MD5 md5;
+      md5.update(llvm::StringRef(
+          (const char *)pPreprocessed->GetBufferPointer(),
+          pPreprocessed->GetBufferSize()));
+      for (UINT32 i = 0; i < argCount; ++i) {
+        CW2A utf8Arg(pArguments[i], CP_UTF8);
+        md5.update(llvm::StringRef(utf8Arg.m_psz));
+        md5.update(llvm::StringRef("\0", 1)); // argument separator
+      }
+      llvm::MD5::MD5Result digest;
+      md5.final(digest);
+      llvm::SmallString<32> hex;
+      llvm::MD5::stringifyResult(digest, hex);
+      return std::string(hex.str());
+    } catch (...) {
+      return std::string();
+    }
+  }
+
   void SetupCompilerForCompile(CompilerInstance &compiler,
                                _In_ DxcLangExtensionsHelper *helper,
-                               _In_ LPCSTR pMainFile, _In_ TextDiagnosticPrinter *diagPrinter,
+                               _In_ LPCSTR pMainFile, _In_ clang::DiagnosticConsumer *diagPrinter,
                                _In_ std::vector<std::string>& defines,
                                _In_ hlsl::options::DxcOpts &Opts,
                                _In_count_(argCount) LPCWSTR *pArguments,
@@ -1107,12 +2058,15 @@ public:
     compiler.getCodeGenOpts().HLSLAllowPreserveValues = Opts.AllowPreserveValues;
     compiler.getCodeGenOpts().HLSLResMayAlias = Opts.ResMayAlias;
     compiler.getCodeGenOpts().ScanLimit = Opts.ScanLimit;
+    compiler.getCodeGenOpts().HLSLProfileUnrollUse = Opts.ProfileUnrollUse;
+    compiler.getCodeGenOpts().HLSLPressureSchedule = Opts.PressureSchedule;
     compiler.getCodeGenOpts().HLSLAllResourcesBound = Opts.AllResourcesBound;
     compiler.getCodeGenOpts().HLSLDefaultRowMajor = Opts.DefaultRowMajor;
     compiler.getCodeGenOpts().HLSLPreferControlFlow = Opts.PreferFlowControl;
     compiler.getCodeGenOpts().HLSLAvoidControlFlow = Opts.AvoidFlowControl;
     compiler.getCodeGenOpts().HLSLNotUseLegacyCBufLoad = Opts.NotUseLegacyCBufLoad;
     compiler.getCodeGenOpts().HLSLLegacyResourceReservation = Opts.LegacyResourceReservation;
+    compiler.getCodeGenOpts().HLSLEmbedSourceHashOnly = Opts.EmbedSourceHash;
     compiler.getCodeGenOpts().HLSLDefines = defines;
     compiler.getCodeGenOpts().HLSLPreciseOutputs = Opts.PreciseOutputs;
     compiler.getCodeGenOpts().MainFileName = pMainFile;
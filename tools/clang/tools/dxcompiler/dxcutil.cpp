@@ -28,9 +28,14 @@
 #include "dxc/Support/dxcapi.impl.h"
 #include "dxc/Support/HLSLOptions.h"
 #include "dxc/DXIL/DxilModule.h"
+#include "dxc/HLSL/DxilValidation.h"
 
 #include "llvm/Support/Path.h"
 
+#include <mutex>
+#include <string>
+#include <vector>
+
 using namespace llvm;
 using namespace hlsl;
 
@@ -45,14 +50,47 @@ HRESULT RunInternalValidator(_In_ IDxcValidator *pValidator,
                              _In_ llvm::Module *pDebugModule,
                              _In_ IDxcBlob *pShader, UINT32 Flags,
                              _In_ IDxcOperationResult **ppResult);
+// Like RunInternalValidator, but validates the live module directly and
+// returns diagnostics as text, skipping the COM result object and blob
+// round trips entirely.
+HRESULT RunInternalValidationDirect(_In_ llvm::Module *pModule,
+                                    _In_ llvm::Module *pDebugModule,
+                                    _In_ IDxcBlob *pShader, UINT32 Flags,
+                                    std::string *pErrors);
 
 namespace {
+
+// LLVMContext pool backing dxcutil::PooledLLVMContext. Contexts are retired
+// after kContextPoolMaxLeases leases because anonymous struct types,
+// constants and metadata strings accumulate in a context until destruction;
+// the cap bounds that growth while still amortizing context construction
+// over a batch of compiles.
+const unsigned kContextPoolMaxLeases = 16;
+const size_t kContextPoolMaxSize = 4;
+
+struct PooledContextEntry {
+  std::unique_ptr<llvm::LLVMContext> Ctx;
+  unsigned LeaseCount;
+};
+
+std::mutex g_ContextPoolMutex;
+std::vector<PooledContextEntry> g_ContextPool;
+
 // AssembleToContainer helper functions.
 
-bool CreateValidator(CComPtr<IDxcValidator> &pValidator) {
+// Returns the external (dxil.dll) validator if one is available; leaves
+// pValidator null when validation should run through the locally-linked code.
+void CreateExternalValidator(CComPtr<IDxcValidator> &pValidator) {
   if (DxilLibIsEnabled()) {
-    DxilLibCreateInstance(CLSID_DxcValidator, &pValidator);
+    // The external validator is stateless across Validate calls, so every
+    // compile shares one cached instance instead of paying per-compile COM
+    // creation in dxil.dll.
+    DxilLibGetSharedInstance(CLSID_DxcValidator, &pValidator);
   }
+}
+
+bool CreateValidator(CComPtr<IDxcValidator> &pValidator) {
+  CreateExternalValidator(pValidator);
   bool bInternalValidator = false;
   if (pValidator == nullptr) {
     IFT(CreateDxcValidator(IID_PPV_ARGS(&pValidator)));
@@ -108,7 +146,8 @@ void GetValidatorVersion(unsigned *pMajor, unsigned *pMinor) {
 
 void AssembleToContainer(AssembleInputs &inputs) {
   CComPtr<AbstractMemoryStream> pContainerStream;
-  IFT(CreateMemoryStream(inputs.pMalloc, &pContainerStream));
+  IFT(CreateMemoryStream(inputs.pMalloc, MemoryStreamPool::Container,
+                         &pContainerStream));
   SerializeDxilContainerForModule(&inputs.pM->GetOrCreateDxilModule(),
                                   inputs.pModuleBitcode, pContainerStream, inputs.DebugName, inputs.SerializeFlags,
                                   inputs.pShaderHashOut, inputs.pReflectionOut, inputs.pRootSigOut);
@@ -148,7 +187,8 @@ HRESULT ValidateAndAssembleToContainer(AssembleInputs &inputs) {
   std::unique_ptr<llvm::Module> llvmModuleWithDebugInfo;
 
   CComPtr<IDxcValidator> pValidator;
-  bool bInternalValidator = CreateValidator(pValidator);
+  CreateExternalValidator(pValidator);
+  const bool bInternalValidator = pValidator == nullptr;
   // Warning on internal Validator
 
   if (bInternalValidator) {
@@ -170,10 +210,14 @@ HRESULT ValidateAndAssembleToContainer(AssembleInputs &inputs) {
   }
 
   // Verify validator version can validate this module
-  CComPtr<IDxcVersionInfo> pValidatorVersion;
-  IFT(pValidator->QueryInterface(&pValidatorVersion));
   UINT32 ValMajor, ValMinor;
-  IFT(pValidatorVersion->GetVersion(&ValMajor, &ValMinor));
+  if (bInternalValidator) {
+    hlsl::GetValidationVersion(&ValMajor, &ValMinor);
+  } else {
+    CComPtr<IDxcVersionInfo> pValidatorVersion;
+    IFT(pValidator->QueryInterface(&pValidatorVersion));
+    IFT(pValidatorVersion->GetVersion(&ValMajor, &ValMinor));
+  }
   DxilModule &DM = inputs.pM.get()->GetOrCreateDxilModule();
   unsigned ReqValMajor, ReqValMinor;
   DM.GetValidatorVersion(ReqValMajor, ReqValMinor);
@@ -191,17 +235,27 @@ HRESULT ValidateAndAssembleToContainer(AssembleInputs &inputs) {
 
   AssembleToContainer(inputs);
 
+  if (bInternalValidator) {
+    // Validate the live module directly; no COM result object, no error
+    // blob round trip, and no re-deserialization of the container.
+    std::string valErrors;
+    valHR = RunInternalValidationDirect(
+        inputs.pM.get(), llvmModuleWithDebugInfo.get(),
+        inputs.pOutputContainerBlob, DxcValidatorFlags_InPlaceEdit,
+        &valErrors);
+    if (inputs.pDiag && FAILED(valHR)) {
+      unsigned DiagID = inputs.pDiag->getCustomDiagID(
+          clang::DiagnosticsEngine::Error, "validation errors\r\n%0");
+      inputs.pDiag->Report(DiagID) << StringRef(valErrors);
+    }
+    return valHR;
+  }
+
   CComPtr<IDxcOperationResult> pValResult;
   // Important: in-place edit is required so the blob is reused and thus
   // dxil.dll can be released.
-  if (bInternalValidator) {
-    IFT(RunInternalValidator(pValidator, inputs.pM.get(),
-                             llvmModuleWithDebugInfo.get(), inputs.pOutputContainerBlob,
-                             DxcValidatorFlags_InPlaceEdit, &pValResult));
-  } else {
-    IFT(pValidator->Validate(inputs.pOutputContainerBlob, DxcValidatorFlags_InPlaceEdit,
-                             &pValResult));
-  }
+  IFT(pValidator->Validate(inputs.pOutputContainerBlob, DxcValidatorFlags_InPlaceEdit,
+                           &pValResult));
   IFT(pValResult->GetStatus(&valHR));
   if (inputs.pDiag) {
     if (FAILED(valHR)) {
@@ -294,4 +348,45 @@ bool IsAbsoluteOrCurDirRelative(const llvm::Twine &T) {
   return false;
 }
 
+PooledLLVMContext::PooledLLVMContext(bool bUsePool) : m_bUsePool(bUsePool) {
+  if (m_bUsePool) {
+    std::lock_guard<std::mutex> Guard(g_ContextPoolMutex);
+    if (!g_ContextPool.empty()) {
+      m_pContext = std::move(g_ContextPool.back().Ctx);
+      m_LeaseCount = g_ContextPool.back().LeaseCount;
+      g_ContextPool.pop_back();
+    }
+  }
+  if (m_pContext == nullptr) {
+    m_pContext.reset(new llvm::LLVMContext());
+  }
+}
+
+PooledLLVMContext::~PooledLLVMContext() {
+  if (!m_bUsePool || m_pContext == nullptr) {
+    return;
+  }
+  ++m_LeaseCount;
+  if (m_LeaseCount >= kContextPoolMaxLeases) {
+    return; // retire: destroyed with this object
+  }
+  // Strip struct type names so the next compile's naming is identical to
+  // what a fresh context would produce, and detach the diagnostic handler
+  // the last compile may have installed.
+  m_pContext->anonymizeStructTypeNames();
+  m_pContext->setDiagnosticHandler(nullptr, nullptr);
+  std::lock_guard<std::mutex> Guard(g_ContextPoolMutex);
+  if (g_ContextPool.size() < kContextPoolMaxSize) {
+    PooledContextEntry entry;
+    entry.Ctx = std::move(m_pContext);
+    entry.LeaseCount = m_LeaseCount;
+    g_ContextPool.push_back(std::move(entry));
+  }
+}
+
+void ClearContextPool() {
+  std::lock_guard<std::mutex> Guard(g_ContextPoolMutex);
+  g_ContextPool.clear();
+}
+
 } // namespace dxcutil
@@ -14,6 +14,7 @@
 #include "dxc/dxcapi.h"
 #include "dxc/Support/microcom.h"
 #include <memory>
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
 
 namespace clang {
@@ -24,7 +25,7 @@ namespace llvm {
 class LLVMContext;
 class MemoryBuffer;
 class Module;
-class raw_string_ostream;
+class raw_ostream;
 class Twine;
 } // namespace llvm
 
@@ -68,7 +69,16 @@ HRESULT ValidateRootSignatureInContainer(
     IDxcBlob *pRootSigContainer, clang::DiagnosticsEngine *pDiag = nullptr);
 void GetValidatorVersion(unsigned *pMajor, unsigned *pMinor);
 void AssembleToContainer(AssembleInputs &inputs);
-HRESULT Disassemble(IDxcBlob *pProgram, llvm::raw_string_ostream &Stream);
+// Disassembles pProgram into Stream, which may be any raw_ostream so callers
+// can stream straight into their own buffer. The three-argument form reuses a
+// caller-owned LLVMContext, which batch tools should keep alive across calls,
+// and FunctionFilter optionally restricts the printed IR to the named
+// functions (module-level parts are always printed).
+HRESULT Disassemble(IDxcBlob *pProgram, llvm::raw_ostream &Stream);
+HRESULT Disassemble(IDxcBlob *pProgram, llvm::raw_ostream &Stream,
+                    llvm::LLVMContext &llvmContext,
+                    llvm::ArrayRef<llvm::StringRef> FunctionFilter =
+                        llvm::ArrayRef<llvm::StringRef>());
 void ReadOptsAndValidate(hlsl::options::MainArgs &mainArgs,
                          hlsl::options::DxcOpts &opts,
                          hlsl::AbstractMemoryStream *pOutputStream,
@@ -86,4 +96,32 @@ void CreateOperationResultFromOutputs(
 
 bool IsAbsoluteOrCurDirRelative(const llvm::Twine &T);
 
+// Leases an LLVMContext for the duration of one compile. With pooling
+// enabled (-fcontext-pool), the context comes from a process-wide pool and
+// returns to it on destruction, so uniqued scalar, vector and function types
+// stay warm between compiles instead of being rebuilt from nothing. Before a
+// context is reused its identified struct type names are stripped and the
+// collision counter reset, keeping struct naming - and therefore emitted
+// bitcode - independent of compile history. Pooled contexts are retired
+// after a fixed number of leases to bound uniquing-table growth. With
+// pooling disabled this is just a stack-lifetime context.
+class PooledLLVMContext {
+public:
+  explicit PooledLLVMContext(bool bUsePool);
+  ~PooledLLVMContext();
+  llvm::LLVMContext &get() { return *m_pContext; }
+
+private:
+  PooledLLVMContext(const PooledLLVMContext &) = delete;
+  PooledLLVMContext &operator=(const PooledLLVMContext &) = delete;
+  std::unique_ptr<llvm::LLVMContext> m_pContext;
+  unsigned m_LeaseCount = 0;
+  bool m_bUsePool;
+};
+
+// Destroys pooled contexts. Called during DLL shutdown, before
+// llvm_shutdown, so context teardown never runs after LLVM's managed
+// statics are gone.
+void ClearContextPool();
+
 } // namespace dxcutil
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/DiagnosticPrinter.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/DxilContainer/DxilContainer.h"
@@ -25,6 +26,8 @@
 #include "dxc/Support/dxcapi.impl.h"
 #include "dxc/DxilRootSignature/DxilRootSignature.h"
 
+#include <thread>
+
 #ifdef _WIN32
 #include "dxcetw.h"
 #endif
@@ -122,6 +125,23 @@ HRESULT STDMETHODCALLTYPE DxcValidator::Validate(
   return ValidateWithOptModules(pShader, Flags, nullptr, nullptr, ppResult);
 }
 
+// Records in the container's shader hash metadata that the reduced rule
+// profile validated it, so tooling can tell such containers from fully
+// validated ones. Requires a writable container blob (in-place edit).
+static void MarkFastProfileValidated(IDxcBlob *pShader) {
+  const DxilContainerHeader *pHeader = IsDxilContainerLike(
+      pShader->GetBufferPointer(), pShader->GetBufferSize());
+  if (pHeader == nullptr ||
+      !IsValidDxilContainer(pHeader, pShader->GetBufferSize()))
+    return;
+  const DxilPartHeader *pPart = GetDxilPartByType(pHeader, DFCC_ShaderHash);
+  if (pPart == nullptr || pPart->PartSize < sizeof(DxilShaderHash))
+    return;
+  DxilShaderHash *pHash = const_cast<DxilShaderHash *>(
+      reinterpret_cast<const DxilShaderHash *>(GetDxilPartData(pPart)));
+  pHash->Flags |= (uint32_t)DxilShaderHashFlags::FastProfileValidated;
+}
+
 HRESULT DxcValidator::ValidateWithOptModules(
   _In_ IDxcBlob *pShader,                       // Shader to validate.
   _In_ UINT32 Flags,                            // Validation flags.
@@ -144,6 +164,11 @@ HRESULT DxcValidator::ValidateWithOptModules(
       validationStatus = RunRootSignatureValidation(pShader, pDiagStream);
     } else {
       validationStatus = RunValidation(pShader, Flags, pModule, pDebugModule, pDiagStream);
+      if (SUCCEEDED(validationStatus) &&
+          (Flags & DxcValidatorFlags_FastProfile) &&
+          (Flags & DxcValidatorFlags_InPlaceEdit)) {
+        MarkFastProfileValidated(pShader);
+      }
     }
     if (FAILED(validationStatus)) {
       std::string msg("Validation failed.\n");
@@ -214,6 +239,14 @@ HRESULT DxcValidator::RunValidation(
 
   raw_stream_ostream DiagStream(pDiagStream);
 
+  hlsl::DxilValidationOptions Opts;
+  if (Flags & DxcValidatorFlags_InParallel)
+    Opts.ThreadCount = std::thread::hardware_concurrency();
+  Opts.bQuietMode = (Flags & DxcValidatorFlags_QuietMode) != 0;
+  Opts.Profile = (Flags & DxcValidatorFlags_FastProfile)
+                     ? hlsl::DxilValidationProfile::Fast
+                     : hlsl::DxilValidationProfile::Full;
+
   if (Flags & DxcValidatorFlags_ModuleOnly) {
     IFRBOOL(!IsDxilContainerLike(pShader->GetBufferPointer(), pShader->GetBufferSize()), E_INVALIDARG);
   } else {
@@ -223,9 +256,9 @@ HRESULT DxcValidator::RunValidation(
   if (!pModule) {
     DXASSERT_NOMSG(pDebugModule == nullptr);
     if (Flags & DxcValidatorFlags_ModuleOnly) {
-      return ValidateDxilBitcode((const char*)pShader->GetBufferPointer(), (uint32_t)pShader->GetBufferSize(), DiagStream);
+      return ValidateDxilBitcode((const char*)pShader->GetBufferPointer(), (uint32_t)pShader->GetBufferSize(), DiagStream, Opts);
     } else {
-      return ValidateDxilContainer(pShader->GetBufferPointer(), pShader->GetBufferSize(), DiagStream);
+      return ValidateDxilContainer(pShader->GetBufferPointer(), pShader->GetBufferSize(), DiagStream, Opts);
     }
   }
 
@@ -233,7 +266,7 @@ HRESULT DxcValidator::RunValidation(
   PrintDiagnosticContext DiagContext(DiagPrinter);
   DiagRestore DR(pModule->getContext(), &DiagContext);
 
-  IFR(hlsl::ValidateDxilModule(pModule, pDebugModule));
+  IFR(hlsl::ValidateDxilModule(pModule, pDebugModule, Opts));
   if (!(Flags & DxcValidatorFlags_ModuleOnly)) {
     IFR(ValidateDxilContainerParts(pModule, pDebugModule,
                       IsDxilContainerLike(pShader->GetBufferPointer(), pShader->GetBufferSize()),
@@ -305,6 +338,63 @@ HRESULT RunInternalValidator(_In_ IDxcValidator *pValidator,
                                                     pDebugModule, ppResult);
 }
 
+// Validates the already-live module in place, returning diagnostics as plain
+// text in *pErrors instead of marshalling them through IDxcOperationResult
+// blobs. This is the path for the locally-linked validator; the COM interface
+// remains for external dxil.dll validation and signing. The returned HRESULT
+// is the validation status; machinery failures throw like the rest of the
+// internal helpers.
+HRESULT RunInternalValidationDirect(_In_ llvm::Module *pModule,
+                                    _In_ llvm::Module *pDebugModule,
+                                    _In_ IDxcBlob *pShader, UINT32 Flags,
+                                    std::string *pErrors) {
+  DXASSERT_NOMSG(pModule != nullptr);
+  DXASSERT_NOMSG(pShader != nullptr);
+  DXASSERT_NOMSG(pErrors != nullptr);
+
+  DxcEtw_DxcValidation_Start();
+
+  raw_string_ostream DiagStream(*pErrors);
+
+  hlsl::DxilValidationOptions Opts;
+  if (Flags & DxcValidatorFlags_InParallel)
+    Opts.ThreadCount = std::thread::hardware_concurrency();
+  Opts.bQuietMode = (Flags & DxcValidatorFlags_QuietMode) != 0;
+  Opts.Profile = (Flags & DxcValidatorFlags_FastProfile)
+                     ? hlsl::DxilValidationProfile::Fast
+                     : hlsl::DxilValidationProfile::Full;
+
+  llvm::DiagnosticPrinterRawOStream DiagPrinter(DiagStream);
+  PrintDiagnosticContext DiagContext(DiagPrinter);
+  DiagRestore DR(pModule->getContext(), &DiagContext);
+
+  HRESULT status = S_OK;
+  const DxilContainerHeader *pHeader = IsDxilContainerLike(
+      pShader->GetBufferPointer(), pShader->GetBufferSize());
+  if (pHeader == nullptr)
+    status = DXC_E_CONTAINER_INVALID;
+
+  if (SUCCEEDED(status))
+    status = hlsl::ValidateDxilModule(pModule, pDebugModule, Opts);
+  if (SUCCEEDED(status))
+    status = ValidateDxilContainerParts(pModule, pDebugModule, pHeader,
+                                        (uint32_t)pShader->GetBufferSize());
+  if (SUCCEEDED(status) &&
+      (DiagContext.HasErrors() || DiagContext.HasWarnings()))
+    status = DXC_E_IR_VERIFICATION_FAILED;
+
+  if (SUCCEEDED(status) && (Flags & DxcValidatorFlags_FastProfile) &&
+      (Flags & DxcValidatorFlags_InPlaceEdit))
+    MarkFastProfileValidated(pShader);
+
+  if (FAILED(status))
+    DiagStream << "Validation failed.\n";
+  DiagStream.flush();
+
+  DxcEtw_DxcValidation_Stop(status);
+  return status;
+}
+
 HRESULT CreateDxcValidator(_In_ REFIID riid, _Out_ LPVOID* ppv) {
   try {
       CComPtr<DxcValidator> result(DxcValidator::Alloc(DxcGetThreadMallocNoRef()));
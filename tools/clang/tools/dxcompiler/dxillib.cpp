@@ -21,6 +21,12 @@ static HRESULT g_DllLibResult = S_OK;
 
 static llvm::sys::Mutex *cs = nullptr;
 
+// Single-slot cache for a shared instance, created on first use through
+// DxilLibGetSharedInstance. Holding one reference here pins the instance
+// for the process lifetime so per-compile callers skip COM creation.
+static IUnknown *g_SharedInstance = nullptr;
+static CLSID g_SharedInstanceClsid = {};
+
 // Check if we can successfully get IDxcValidator from dxil.dll
 // This function is to prevent multiple attempts to load dxil.dll 
 HRESULT DxilLibInitialize() {
@@ -36,9 +42,16 @@ HRESULT DxilLibInitialize() {
 HRESULT DxilLibCleanup(DxilLibCleanUpType type) {
   HRESULT hr = S_OK;
   if (type == DxilLibCleanUpType::ProcessTermination) {
+    // Do not Release the shared instance here: that would run dxil.dll code
+    // during process termination, after the loader may have unloaded it.
+    g_SharedInstance = nullptr;
     g_DllSupport.Detach();
   }
   else if (type == DxilLibCleanUpType::UnloadLibrary) {
+    if (g_SharedInstance) {
+      g_SharedInstance->Release();
+      g_SharedInstance = nullptr;
+    }
     g_DllSupport.Cleanup();
   }
   else {
@@ -79,3 +92,29 @@ HRESULT DxilLibCreateInstance(_In_ REFCLSID rclsid, _In_ REFIID riid, _In_ IUnkn
   }
   return hr;
 }
+
+HRESULT DxilLibGetSharedInstance(_In_ REFCLSID rclsid, _In_ REFIID riid, _In_ IUnknown **ppInterface) {
+  DXASSERT_NOMSG(ppInterface != nullptr);
+  HRESULT hr = E_FAIL;
+  if (DxilLibIsEnabled()) {
+    cs->lock();
+    if (g_SharedInstance && IsEqualCLSID(rclsid, g_SharedInstanceClsid)) {
+      hr = g_SharedInstance->QueryInterface(riid, (void **)ppInterface);
+    } else {
+      IUnknown *pUnknown = nullptr;
+      hr = g_DllSupport.CreateInstance(rclsid, __uuidof(IUnknown), &pUnknown);
+      if (SUCCEEDED(hr)) {
+        hr = pUnknown->QueryInterface(riid, (void **)ppInterface);
+        if (SUCCEEDED(hr) && g_SharedInstance == nullptr) {
+          // The cache keeps the reference created above.
+          g_SharedInstance = pUnknown;
+          g_SharedInstanceClsid = rclsid;
+        } else {
+          pUnknown->Release();
+        }
+      }
+    }
+    cs->unlock();
+  }
+  return hr;
+}
@@ -39,4 +39,16 @@ HRESULT DxilLibCreateInstance(_In_ REFCLSID rclsid, _In_ TInterface **ppInterfac
   return DxilLibCreateInstance(rclsid, __uuidof(TInterface), (IUnknown**) ppInterface);
 }
 
+// Returns a process-lifetime shared instance of the given class, creating it
+// on first use. The caller receives its own reference; the cached reference
+// pins the instance (and dxil.dll) until DxilLibCleanup. Only classes whose
+// instances are safe to share across threads, such as CLSID_DxcValidator,
+// may be requested through this path.
+HRESULT DxilLibGetSharedInstance(_In_ REFCLSID rclsid, _In_ REFIID riid, _In_ IUnknown **ppInterface);
+
+template <class TInterface>
+HRESULT DxilLibGetSharedInstance(_In_ REFCLSID rclsid, _In_ TInterface **ppInterface) {
+  return DxilLibGetSharedInstance(rclsid, __uuidof(TInterface), (IUnknown**) ppInterface);
+}
+
 #endif // __DXC_DXILLIB__
\ No newline at end of file
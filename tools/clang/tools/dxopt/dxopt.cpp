@@ -26,6 +26,7 @@
 #include <comdef.h>
 #include <iostream>
 #include <limits>
+#include <map>
 
 #include "llvm/Support/FileSystem.h"
 
@@ -47,6 +48,7 @@ enum class ProgramAction {
   PrintPasses,
   PrintPassesWithDetails,
   RunOptimizer,
+  RunServer,
 };
 
 const wchar_t *STDIN_FILE_NAME = L"-";
@@ -193,6 +195,114 @@ static void ReadFileOpts(LPCWSTR pPassFileName, IDxcBlobEncoding **ppPassOpts, s
   pPassOpts->QueryInterface(ppPassOpts);
 }
 
+// Server mode: load an input at most once and share the blob across jobs.
+// RunOptimizer treats the blob as immutable input and parses a fresh module
+// from it per run, so reuse is safe and skips the per-job file read.
+static void BlobFromFileCached(LPCWSTR pFileName,
+                               std::map<std::wstring, CComPtr<IDxcBlob>> &cache,
+                               IDxcBlob **ppBlob) {
+  auto it = cache.find(pFileName);
+  if (it == cache.end()) {
+    CComPtr<IDxcBlob> pBlob;
+    BlobFromFile(pFileName, &pBlob);
+    it = cache.emplace(pFileName, pBlob).first;
+  }
+  CComPtr<IDxcBlob> pBlob(it->second);
+  *ppBlob = pBlob.Detach();
+}
+
+// Runs optimizer jobs read from stdin, one per line, until EOF or "exit".
+// Each line looks like a RunOptimizer command line:
+//   IN-FILE [-o=OUT-FILE] [-pf PASS-FILE] [OPT-ARGUMENTS ...]
+// Keeping the process alive keeps dxcompiler loaded - and with it the pass
+// registry and pass descriptions - and keeps loaded input modules cached, so
+// a bisecting loop pays the startup and file-read cost once instead of per
+// invocation. Arguments are whitespace-separated; quoting is not supported,
+// and "-" (stdin) input is unavailable because stdin carries the job stream.
+// After each job a "#DXOPT-DONE <code>" line is written so a driving script
+// can detect completion.
+static void RunServer(IDxcOptimizer *pOptimizer) {
+  std::map<std::wstring, CComPtr<IDxcBlob>> blobCache;
+  std::string line;
+  while (std::getline(std::cin, line)) {
+    std::wstring wideLine;
+    if (!Unicode::UTF8ToUTF16String(line.c_str(), line.size(), &wideLine)) {
+      wprintf(L"%s", L"Malformed UTF-8 in request line.\n");
+      wprintf(L"%s", L"#DXOPT-DONE 1\n");
+      fflush(stdout);
+      continue;
+    }
+
+    // Split the request into whitespace-separated arguments.
+    std::vector<std::wstring> tokens;
+    size_t pos = 0;
+    while (pos < wideLine.size()) {
+      size_t begin = wideLine.find_first_not_of(L" \t", pos);
+      if (begin == std::wstring::npos)
+        break;
+      size_t end = wideLine.find_first_of(L" \t", begin);
+      if (end == std::wstring::npos)
+        end = wideLine.size();
+      tokens.push_back(wideLine.substr(begin, end - begin));
+      pos = end;
+    }
+    if (tokens.empty())
+      continue;
+    if (tokens.size() == 1 && wcsieq(tokens[0].c_str(), L"exit"))
+      break;
+
+    int jobResult = 0;
+    try {
+      LPCWSTR inFileName = nullptr;
+      LPCWSTR outFileName = nullptr;
+      LPCWSTR passFileName = nullptr;
+      std::vector<LPCWSTR> jobArgs;
+      for (size_t i = 0; i < tokens.size(); ++i) {
+        LPCWSTR arg = tokens[i].c_str();
+        if (wcsistarts(arg, L"-o=")) {
+          outFileName = arg + 3;
+        } else if (wcsieqopt(arg, L"pf")) {
+          ++i;
+          IFTBOOL(i < tokens.size(), E_INVALIDARG);
+          passFileName = tokens[i].c_str();
+        } else if (inFileName == nullptr && isFileInputArg(arg) &&
+                   !isStdIn(arg)) {
+          inFileName = arg;
+        } else {
+          jobArgs.push_back(arg);
+        }
+      }
+      IFTBOOL(inFileName != nullptr, E_INVALIDARG);
+      IFTBOOL(passFileName == nullptr || jobArgs.empty(), E_INVALIDARG);
+
+      CComPtr<IDxcBlob> pBlob;
+      BlobFromFileCached(inFileName, blobCache, &pBlob);
+      CComPtr<IDxcBlobEncoding> pPassOpts;
+      std::vector<LPCWSTR> passes;
+      LPCWSTR *optArgs = jobArgs.data();
+      UINT32 optArgCount = jobArgs.size();
+      ReadFileOpts(passFileName, &pPassOpts, passes, &optArgs, &optArgCount);
+      CComPtr<IDxcBlob> pOutputModule;
+      CComPtr<IDxcBlobEncoding> pOutputText;
+      IFT(pOptimizer->RunOptimizer(pBlob, optArgs, optArgCount, &pOutputModule,
+                                   &pOutputText));
+      PrintOptOutput(outFileName, pOutputModule, pOutputText);
+    } catch (const ::hlsl::Exception &hlslException) {
+      const char *msg = hlslException.what();
+      if (msg != nullptr && *msg != '\0') {
+        dxc::WriteUtf8ToConsoleSizeT(msg, strlen(msg));
+        printf("\n");
+      } else {
+        printf("Operation failed - error code 0x%08x.\n", hlslException.hr);
+      }
+      jobResult = 1;
+    }
+
+    wprintf(L"#DXOPT-DONE %d\n", jobResult);
+    fflush(stdout);
+  }
+}
+
 static void PrintHelp() {
   wprintf(L"%s",
     L"Performs optimizations on a bitcode file by running a sequence of passes.\n\n"
@@ -203,10 +313,22 @@ static void PrintHelp() {
     L"  -pass-details  Displays a list of passes with detailed information\n"
     L"  -pf PASS-FILE  Loads passes from the specified file\n"
     L"  -o=OUT-FILE    Output file for processed module\n"
+    L"  -server        Runs jobs read from stdin, one per line, until EOF or\n"
+    L"                 'exit'; each line is 'IN-FILE [-o=OUT-FILE] [-pf PASS-FILE]\n"
+    L"                 OPT-ARGUMENTS ...'. Loaded modules and pass registration\n"
+    L"                 are reused across jobs.\n"
     L"  IN-FILE        File with with bitcode to optimize\n"
     L"  OPT-ARGUMENTS  One or more passes to run in sequence\n"
     L"\n"
     L"Text that is traced during optimization is written to the standard output.\n"
+    L"\n"
+    L"Checkpointing:\n"
+    L"  A pipeline can be split across dxopt invocations (including on\n"
+    L"  different machines). End the first pass list with -hlsl-passes-pause\n"
+    L"  to serialize the module together with its pipeline position, then\n"
+    L"  start the next invocation's pass list with -hlsl-passes-resume on the\n"
+    L"  saved output. Compiling with -fcgl produces a module that is already\n"
+    L"  in this checkpointed form, ready to be resumed here.\n"
   );
 }
 
@@ -241,6 +363,9 @@ int __cdecl wmain(int argc, const wchar_t **argv_) {
       else if (wcsieqopt(arg, L"pass-details")) {
         action = ProgramAction::PrintPassesWithDetails;
       }
+      else if (wcsieqopt(arg, L"server")) {
+        action = ProgramAction::RunServer;
+      }
       else if (wcsieqopt(arg, L"external")) {
         ++argIdx;
         if (argIdx == argc) {
@@ -329,6 +454,10 @@ int __cdecl wmain(int argc, const wchar_t **argv_) {
       IFT(pOptimizer->RunOptimizer(pBlob, optArgs, optArgCount, &pOutputModule, &pOutputText));
       PrintOptOutput(outFileName, pOutputModule, pOutputText);
       break;
+    case ProgramAction::RunServer:
+      pStage = "Optimizer server processing";
+      RunServer(pOptimizer);
+      break;
     }
   } catch (const ::hlsl::Exception &hlslException) {
     try {
@@ -207,16 +207,6 @@ static inline std::string GetUnmangledName(StringRef name) {
     return name.substr(2, pos - 2);
 }
 
-static Function* getFunctionFromName(Module &M, const std::wstring& exportName) {
-    for (auto F = M.begin(), E = M.end(); F != E; ++F) {
-        std::wstring functionName = Unicode::UTF8ToUTF16StringOrThrow(GetUnmangledName(F->getName()).c_str());
-        if (exportName == functionName) {
-            return F;
-        }
-    }
-    return nullptr;
-}
-
 DXIL::ShaderKind getRayShaderKind(Function* F);
 Function *CloneFunction(Function *Orig,
     const llvm::Twine &Name,
@@ -657,10 +647,18 @@ HRESULT STDMETHODCALLTYPE DxcDxrFallbackCompiler::Compile(
         saveModuleToAsmFile(M.get(), "combined.ll");
     }
     }
+    // Resolve all the shader names in a single pass over the linked module
+    // instead of rescanning it for each shader; large ray pipelines can have
+    // hundreds of shaders against thousands of linked functions.
+    std::map<std::string, Function*> functionsByUnmangledName;
+    for (Function &F : *M)
+        functionsByUnmangledName[GetUnmangledName(F.getName())] = &F;
+
     std::vector<ShaderType> shaderTypes;
     for (UINT32 i = 0; i < shaderCount; ++i)
     {
-        switch (getRayShaderKind(getFunctionFromName(*M, pShaderNames[i])))
+        auto nameIt = functionsByUnmangledName.find(shaderNames[i]);
+        switch (getRayShaderKind(nameIt == functionsByUnmangledName.end() ? nullptr : nameIt->second))
         {
         case DXIL::ShaderKind::RayGeneration:
             shaderTypes.push_back(ShaderType::Raygen);
@@ -19,6 +19,11 @@
 #include "dxc/Support/HLSLOptions.h"
 
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include <cstring>
+#include <map>
 
 using namespace dxc;
 using namespace llvm;
@@ -28,61 +33,144 @@ using namespace hlsl::options;
 static cl::opt<std::string>
 InputFilename(cl::Positional, cl::desc("<input dxil file>"), cl::init("-"));
 
+static cl::opt<std::string>
+BatchManifest("batch",
+              cl::desc("Validate every file listed in the manifest (one path "
+                       "per line) in a single process"),
+              cl::value_desc("manifest"), cl::init(""));
+
 class DxvContext {
 private:
   DxcDllSupport &m_dxcSupport;
+  CComPtr<IDxcAssembler> m_pAssembler;
+  CComPtr<IDxcValidator> m_pValidator;
+
+  // Containers this process has already validated clean, keyed by MD5 of
+  // their bytes. Batch manifests commonly repeat artifacts; a byte-identical
+  // container cannot validate differently, so re-running the validator
+  // (including its llvm::verifyModule walk) proves nothing new. The digest
+  // is only a lookup key: MD5 collisions are constructible, and dxv is the
+  // validation gate, so a hit must byte-compare against the remembered
+  // container before the re-validation is skipped. Containers larger than
+  // the retention budget are simply validated every time.
+  std::map<std::string, std::string> m_ValidatedContainers;
+  size_t m_ValidatedContainerBytes = 0;
+  static const size_t kValidatedContainersMaxBytes = 64 * 1024 * 1024;
+
+  HRESULT ValidateFile(llvm::StringRef path, std::string &error);
 public:
   DxvContext(DxcDllSupport &dxcSupport)
       : m_dxcSupport(dxcSupport) {}
 
   void Validate();
+  unsigned ValidateBatch();
 };
 
-void DxvContext::Validate() {
-  CComPtr<IDxcOperationResult> pCompileResult;
-
-  {
-    CComPtr<IDxcBlobEncoding> pSource;
-    ReadFileIntoBlob(m_dxcSupport, StringRefUtf16(InputFilename), &pSource);
-
-    CComPtr<IDxcAssembler> pAssembler;
-    CComPtr<IDxcOperationResult> pAsmResult;
-
-    CComPtr<IDxcBlob> pContainerBlob;
-    HRESULT resultStatus;
-
-    IFT(m_dxcSupport.CreateInstance(CLSID_DxcAssembler, &pAssembler));
-    IFT(pAssembler->AssembleToContainer(pSource, &pAsmResult));
-    IFT(pAsmResult->GetStatus(&resultStatus));
-    if (FAILED(resultStatus)) {
-      CComPtr<IDxcBlobEncoding> text;
-      IFT(pAsmResult->GetErrorBuffer(&text));
-      const char *pStart = (const char *)text->GetBufferPointer();
-      std::string msg(pStart);
-      IFTMSG(resultStatus, msg);
-      return;
-    }
-    IFT(pAsmResult->GetResult(&pContainerBlob));
-
-    CComPtr<IDxcValidator> pValidator;
-    CComPtr<IDxcOperationResult> pResult;
-
-    IFT(m_dxcSupport.CreateInstance(CLSID_DxcValidator, &pValidator));
-    IFT(pValidator->Validate(pContainerBlob, DxcValidatorFlags_InPlaceEdit, &pResult));
+// Assembles and validates a single file, reusing the assembler and validator
+// instances across calls so batch runs pay the creation cost once. Returns
+// the failing stage's status and its error text, or S_OK.
+HRESULT DxvContext::ValidateFile(llvm::StringRef path, std::string &error) {
+  if (m_pAssembler == nullptr)
+    IFT(m_dxcSupport.CreateInstance(CLSID_DxcAssembler, &m_pAssembler));
+  if (m_pValidator == nullptr)
+    IFT(m_dxcSupport.CreateInstance(CLSID_DxcValidator, &m_pValidator));
+
+  CComPtr<IDxcBlobEncoding> pSource;
+  ReadFileIntoBlob(m_dxcSupport, StringRefUtf16(path), &pSource);
+
+  CComPtr<IDxcOperationResult> pAsmResult;
+  CComPtr<IDxcBlob> pContainerBlob;
+  HRESULT resultStatus;
+
+  IFT(m_pAssembler->AssembleToContainer(pSource, &pAsmResult));
+  IFT(pAsmResult->GetStatus(&resultStatus));
+  if (FAILED(resultStatus)) {
+    CComPtr<IDxcBlobEncoding> text;
+    IFT(pAsmResult->GetErrorBuffer(&text));
+    error.assign((const char *)text->GetBufferPointer());
+    return resultStatus;
+  }
+  IFT(pAsmResult->GetResult(&pContainerBlob));
+
+  llvm::StringRef containerBytes(
+      (const char *)pContainerBlob->GetBufferPointer(),
+      pContainerBlob->GetBufferSize());
+  llvm::MD5 md5;
+  llvm::MD5::MD5Result digest;
+  md5.update(containerBytes);
+  md5.final(digest);
+  std::string digestKey((const char *)digest, sizeof(digest));
+  auto validated = m_ValidatedContainers.find(digestKey);
+  if (validated != m_ValidatedContainers.end() &&
+      containerBytes.size() == validated->second.size() &&
+      memcmp(containerBytes.data(), validated->second.data(),
+             containerBytes.size()) == 0)
+    return S_OK;
+
+  CComPtr<IDxcOperationResult> pResult;
+  IFT(m_pValidator->Validate(pContainerBlob, DxcValidatorFlags_InPlaceEdit, &pResult));
+
+  HRESULT status;
+  IFT(pResult->GetStatus(&status));
+  if (FAILED(status)) {
+    CComPtr<IDxcBlobEncoding> text;
+    IFT(pResult->GetErrorBuffer(&text));
+    error.assign((const char *)text->GetBufferPointer());
+    return status;
+  }
+  if (m_ValidatedContainerBytes + containerBytes.size() <=
+      kValidatedContainersMaxBytes &&
+      m_ValidatedContainers.emplace(digestKey, containerBytes.str()).second)
+    m_ValidatedContainerBytes += containerBytes.size();
+  return S_OK;
+}
 
-    HRESULT status;
-    IFT(pResult->GetStatus(&status));
+void DxvContext::Validate() {
+  std::string error;
+  HRESULT status = ValidateFile(InputFilename, error);
+  if (FAILED(status)) {
+    IFTMSG(status, error);
+  } else {
+    printf("Validation succeed.");
+  }
+}
 
+// Validates every file named in the batch manifest, printing each failure as
+// it is found and a pass/fail summary at the end. Returns the failure count.
+unsigned DxvContext::ValidateBatch() {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> manifest =
+      MemoryBuffer::getFile(BatchManifest);
+  IFTMSG(manifest ? S_OK : E_FAIL,
+         std::string("Unable to read manifest ") + BatchManifest);
+
+  SmallVector<StringRef, 32> lines;
+  (*manifest)->getBuffer().split(lines, '\n');
+
+  unsigned passed = 0, failed = 0;
+  for (StringRef line : lines) {
+    line = line.trim();
+    if (line.empty() || line.startswith("#"))
+      continue;
+    std::string path = line.str();
+    std::string error;
+    HRESULT status = S_OK;
+    try {
+      status = ValidateFile(path, error);
+    } catch (const ::hlsl::Exception &e) {
+      // A file that cannot be read or assembled should not end the batch.
+      status = e.hr;
+      error = e.msg;
+    }
     if (FAILED(status)) {
-      CComPtr<IDxcBlobEncoding> text;
-      IFT(pResult->GetErrorBuffer(&text));
-      const char *pStart = (const char *)text->GetBufferPointer();
-      std::string msg(pStart);
-      IFTMSG(status, msg);
+      ++failed;
+      printf("%s: failed - 0x%08x\n%s\n", path.c_str(), (unsigned)status,
+             error.c_str());
     } else {
-      printf("Validation succeed.");
+      ++passed;
     }
   }
+  printf("%u passed, %u failed.\n", passed, failed);
+  return failed;
 }
 
 int __cdecl main(int argc,  _In_reads_z_(argc) const char **argv) {
@@ -98,7 +186,12 @@ int __cdecl main(int argc,  _In_reads_z_(argc) const char **argv) {
 
     DxvContext context(dxcSupport);
     pStage = "Validation";
-    context.Validate();
+    if (!BatchManifest.empty()) {
+      if (context.ValidateBatch() != 0)
+        return 1;
+    } else {
+      context.Validate();
+    }
   } catch (const ::hlsl::Exception &hlslException) {
     try {
       const char *msg = hlslException.what();
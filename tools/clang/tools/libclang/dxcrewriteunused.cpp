@@ -780,6 +780,12 @@ HRESULT DoRewriteUnused(_In_ DxcLangExtensionsHelper *pHelper,
     StringRef contents = C.getSourceManager().getBufferData(C.getSourceManager().getMainFileID());
     o << contents;
   } else {
+    // The printed TU is on the order of the source it came from; size the
+    // result up front so large inputs do not grow it one reallocation at a
+    // time.
+    result.reserve(C.getSourceManager()
+                       .getBufferData(C.getSourceManager().getMainFileID())
+                       .size());
     PrintingPolicy p = PrintingPolicy(C.getPrintingPolicy());
     p.Indentation = 1;
     tu->print(o, p);
@@ -903,6 +909,11 @@ HRESULT DoSimpleReWrite(_In_ DxcLangExtensionsHelper *pHelper,
   PrintingPolicy p = PrintingPolicy(C.getPrintingPolicy());
   p.Indentation = 1;
 
+  // Size the result to the input up front; see DoRewriteUnused.
+  result.reserve(C.getSourceManager()
+                     .getBufferData(C.getSourceManager().getMainFileID())
+                     .size());
+
   if (entryFnDecl) {
     PrintTranslationUnitWithTranslatedUniformParams(tu, entryFnDecl, o, p);
   } else {
@@ -20,11 +20,14 @@
 #include <cassert>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
 #include <cfloat>
+#include <thread>
 #include "dxc/DxilContainer/DxilContainer.h"
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/dxcapi.h"
 #include "dxc/dxcpix.h"
+#include "dxc/dxctools.h"
 #ifdef _WIN32
 #include <atlfile.h>
 #include "dia2.h"
@@ -104,6 +107,36 @@ public:
   }
 };
 
+// Records what a CompileAsync completion callback receives. When given a
+// gate, the callback spins until the gate opens, which keeps the worker (and
+// anything queued behind this job) busy under the test's control.
+class TestAsyncCompileCallback : public IDxcAsyncCompileCallback {
+  DXC_MICROCOM_REF_FIELD(m_dwRef)
+public:
+  DXC_MICROCOM_ADDREF_RELEASE_IMPL(m_dwRef)
+  std::atomic<unsigned> m_callCount;
+  HRESULT m_hrCompile = E_FAIL;
+  CComPtr<IDxcResult> m_pResult;
+  std::atomic<bool> *m_pGate;
+  TestAsyncCompileCallback(std::atomic<bool> *pGate = nullptr)
+      : m_dwRef(0), m_callCount(0), m_pGate(pGate) {}
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
+    return DoBasicQueryInterface<IDxcAsyncCompileCallback>(this, iid, ppvObject);
+  }
+
+  void STDMETHODCALLTYPE OnCompileComplete(
+      _In_ HRESULT hrCompile, _In_opt_ IDxcResult *pResult) override {
+    if (m_pGate) {
+      while (!m_pGate->load()) {
+        std::this_thread::yield();
+      }
+    }
+    m_hrCompile = hrCompile;
+    m_pResult = pResult;
+    ++m_callCount;
+  }
+};
+
 #ifdef _WIN32
 class CompilerTest {
 #else
@@ -127,6 +160,17 @@ public:
   TEST_METHOD(CompileThenAddCustomDebugName)
   TEST_METHOD(CompileWithRootSignatureThenStripRootSignature)
 
+  TEST_METHOD(CompileAsyncWhenManyThenEachCallbackFiresOnce)
+  TEST_METHOD(CompileAsyncWhenCanceledBeforeStartThenAborted)
+  TEST_METHOD(CompileAsyncWhenCompilerReleasedThenJobsComplete)
+
+  TEST_METHOD(IncrementalCompileWhenBodyEditedThenOnlyThatChunkRecompiles)
+  TEST_METHOD(IncrementalCompileWhenDefineEditedThenAffectedChunksRecompile)
+  TEST_METHOD(IncrementalCompileWhenHeaderEditedThenAffectedChunksRecompile)
+
+  TEST_METHOD(CompileEntryPointsThenMatchesSingleEntryCompiles)
+  TEST_METHOD(CompileEntryPointsWhenInvalidModeThenFails)
+
   TEST_METHOD(CompileWhenIncludeThenLoadInvoked)
   TEST_METHOD(CompileWhenIncludeThenLoadUsed)
   TEST_METHOD(CompileWhenIncludeAbsoluteThenLoadAbsolute)
@@ -459,6 +503,26 @@ public:
     VERIFY_IS_GREATER_THAN(numTestsRun, (unsigned)0, L"No test files found in batch directory.");
   }
 
+  // Runs one incremental compile with a fixed entry and profile, verifies it
+  // succeeded, and returns the chunk and cache-hit counts it reports.
+  void IncrementalCompileWithStats(IDxcIncrementalCompiler *pIncremental,
+                                   LPCSTR pText, const DxcDefine *pDefines,
+                                   UINT32 defineCount,
+                                   IDxcIncludeHandler *pIncludeHandler,
+                                   UINT32 *pChunkCount,
+                                   UINT32 *pCacheHitCount) {
+    CComPtr<IDxcBlobEncoding> pSource;
+    CComPtr<IDxcOperationResult> pResult;
+    CreateBlobFromText(pText, &pSource);
+    VERIFY_SUCCEEDED(pIncremental->Compile(pSource, L"source.hlsl", L"main",
+                                           L"ps_6_0", nullptr, 0, pDefines,
+                                           defineCount, pIncludeHandler,
+                                           &pResult));
+    VerifyOperationSucceeded(pResult);
+    VERIFY_SUCCEEDED(
+        pIncremental->GetLastCompileStats(pChunkCount, pCacheHitCount));
+  }
+
   std::string VerifyCompileFailed(LPCSTR pText, LPCWSTR pTargetProfile, LPCSTR pErrorMsg) {
     return VerifyCompileFailed(pText, pTargetProfile, pErrorMsg, L"main");
   }
@@ -683,6 +747,355 @@ TEST_F(CompilerTest, CompileWhenDefinesManyThenApplied) {
   VERIFY_SUCCEEDED(compileStatus);
 }
 
+TEST_F(CompilerTest, CompileAsyncWhenManyThenEachCallbackFiresOnce) {
+  CComPtr<IDxcCompiler> pCompiler;
+  CComPtr<IDxcCompiler5> pCompiler5;
+  VERIFY_SUCCEEDED(CreateCompiler(&pCompiler));
+  VERIFY_SUCCEEDED(pCompiler.QueryInterface(&pCompiler5));
+
+  const char *pSourceText = "float4 main() : SV_Target { return 0; }";
+  DxcBuffer source = {};
+  source.Ptr = pSourceText;
+  source.Size = strlen(pSourceText);
+  source.Encoding = CP_UTF8;
+  LPCWSTR args[] = {L"-E", L"main", L"-T", L"ps_6_0"};
+
+  const size_t kJobCount = 8;
+  std::vector<CComPtr<TestAsyncCompileCallback>> callbacks;
+  std::vector<CComPtr<IDxcAsyncCompileOperation>> operations;
+  for (size_t i = 0; i < kJobCount; ++i) {
+    CComPtr<TestAsyncCompileCallback> pCallback = new TestAsyncCompileCallback();
+    CComPtr<IDxcAsyncCompileOperation> pOperation;
+    VERIFY_SUCCEEDED(pCompiler5->CompileAsync(&source, args, _countof(args),
+                                              nullptr, pCallback, &pOperation));
+    callbacks.push_back(pCallback);
+    operations.push_back(pOperation);
+  }
+
+  for (size_t i = 0; i < kJobCount; ++i) {
+    VERIFY_SUCCEEDED(operations[i]->WaitForCompletion());
+    VERIFY_ARE_EQUAL(1u, callbacks[i]->m_callCount.load());
+    VERIFY_SUCCEEDED(callbacks[i]->m_hrCompile);
+    VERIFY_IS_NOT_NULL(callbacks[i]->m_pResult.p);
+    HRESULT status;
+    VERIFY_SUCCEEDED(callbacks[i]->m_pResult->GetStatus(&status));
+    VERIFY_SUCCEEDED(status);
+  }
+}
+
+TEST_F(CompilerTest, CompileAsyncWhenCanceledBeforeStartThenAborted) {
+  CComPtr<IDxcCompiler> pCompiler;
+  CComPtr<IDxcCompiler5> pCompiler5;
+  VERIFY_SUCCEEDED(CreateCompiler(&pCompiler));
+  VERIFY_SUCCEEDED(pCompiler.QueryInterface(&pCompiler5));
+  // A single worker guarantees the second job is still queued while the first
+  // job's callback is blocked on the gate.
+  VERIFY_SUCCEEDED(pCompiler5->SetMaxAsyncConcurrency(1));
+
+  const char *pSourceText = "float4 main() : SV_Target { return 0; }";
+  DxcBuffer source = {};
+  source.Ptr = pSourceText;
+  source.Size = strlen(pSourceText);
+  source.Encoding = CP_UTF8;
+  LPCWSTR args[] = {L"-E", L"main", L"-T", L"ps_6_0"};
+
+  std::atomic<bool> gate(false);
+  CComPtr<TestAsyncCompileCallback> pBlockedCallback =
+      new TestAsyncCompileCallback(&gate);
+  CComPtr<IDxcAsyncCompileOperation> pBlockedOp;
+  VERIFY_SUCCEEDED(pCompiler5->CompileAsync(&source, args, _countof(args),
+                                            nullptr, pBlockedCallback,
+                                            &pBlockedOp));
+
+  CComPtr<TestAsyncCompileCallback> pCanceledCallback =
+      new TestAsyncCompileCallback();
+  CComPtr<IDxcAsyncCompileOperation> pCanceledOp;
+  VERIFY_SUCCEEDED(pCompiler5->CompileAsync(&source, args, _countof(args),
+                                            nullptr, pCanceledCallback,
+                                            &pCanceledOp));
+
+  VERIFY_ARE_EQUAL(S_OK, pCanceledOp->Cancel());
+  // A second cancel finds nothing left to cancel.
+  VERIFY_ARE_EQUAL(S_FALSE, pCanceledOp->Cancel());
+  gate = true;
+
+  VERIFY_SUCCEEDED(pBlockedOp->WaitForCompletion());
+  VERIFY_SUCCEEDED(pCanceledOp->WaitForCompletion());
+
+  VERIFY_ARE_EQUAL(1u, pBlockedCallback->m_callCount.load());
+  VERIFY_SUCCEEDED(pBlockedCallback->m_hrCompile);
+  VERIFY_IS_NOT_NULL(pBlockedCallback->m_pResult.p);
+
+  VERIFY_ARE_EQUAL(1u, pCanceledCallback->m_callCount.load());
+  VERIFY_ARE_EQUAL(E_ABORT, pCanceledCallback->m_hrCompile);
+  VERIFY_IS_NULL(pCanceledCallback->m_pResult.p);
+
+  // Canceling a completed operation is also a no-op.
+  VERIFY_ARE_EQUAL(S_FALSE, pBlockedOp->Cancel());
+}
+
+TEST_F(CompilerTest, CompileAsyncWhenCompilerReleasedThenJobsComplete) {
+  CComPtr<IDxcCompiler> pCompiler;
+  CComPtr<IDxcCompiler5> pCompiler5;
+  VERIFY_SUCCEEDED(CreateCompiler(&pCompiler));
+  VERIFY_SUCCEEDED(pCompiler.QueryInterface(&pCompiler5));
+  VERIFY_SUCCEEDED(pCompiler5->SetMaxAsyncConcurrency(1));
+
+  const char *pSourceText = "float4 main() : SV_Target { return 0; }";
+  DxcBuffer source = {};
+  source.Ptr = pSourceText;
+  source.Size = strlen(pSourceText);
+  source.Encoding = CP_UTF8;
+  LPCWSTR args[] = {L"-E", L"main", L"-T", L"ps_6_0"};
+
+  // Gate the first job so the rest are provably still in flight when the
+  // compiler references are dropped below.
+  std::atomic<bool> gate(false);
+  const size_t kJobCount = 4;
+  std::vector<CComPtr<TestAsyncCompileCallback>> callbacks;
+  std::vector<CComPtr<IDxcAsyncCompileOperation>> operations;
+  for (size_t i = 0; i < kJobCount; ++i) {
+    CComPtr<TestAsyncCompileCallback> pCallback =
+        new TestAsyncCompileCallback(i == 0 ? &gate : nullptr);
+    CComPtr<IDxcAsyncCompileOperation> pOperation;
+    VERIFY_SUCCEEDED(pCompiler5->CompileAsync(&source, args, _countof(args),
+                                              nullptr, pCallback, &pOperation));
+    callbacks.push_back(pCallback);
+    operations.push_back(pOperation);
+  }
+
+  // Each queued job holds its own reference on the compiler, so dropping
+  // every caller reference while work is outstanding must neither hang nor
+  // lose a callback.
+  pCompiler5.Release();
+  pCompiler.Release();
+  gate = true;
+
+  for (size_t i = 0; i < kJobCount; ++i) {
+    VERIFY_SUCCEEDED(operations[i]->WaitForCompletion());
+    VERIFY_ARE_EQUAL(1u, callbacks[i]->m_callCount.load());
+    VERIFY_SUCCEEDED(callbacks[i]->m_hrCompile);
+    VERIFY_IS_NOT_NULL(callbacks[i]->m_pResult.p);
+  }
+}
+
+TEST_F(CompilerTest, CompileEntryPointsThenMatchesSingleEntryCompiles) {
+  CComPtr<IDxcCompiler> pCompiler;
+  CComPtr<IDxcCompiler6> pCompiler6;
+  VERIFY_SUCCEEDED(CreateCompiler(&pCompiler));
+  VERIFY_SUCCEEDED(pCompiler.QueryInterface(&pCompiler6));
+
+  const char *pSourceText =
+      "float4 psOne(float4 pos : SV_Position) : SV_Target {\r\n"
+      "  return pos * 0.5;\r\n"
+      "}\r\n"
+      "float4 psTwo(float4 pos : SV_Position) : SV_Target {\r\n"
+      "  return pos + 1.0;\r\n"
+      "}\r\n";
+  DxcBuffer source = {};
+  source.Ptr = pSourceText;
+  source.Size = strlen(pSourceText);
+  source.Encoding = CP_UTF8;
+
+  LPCWSTR sharedArgs[] = {L"-T", L"ps_6_0"};
+  LPCWSTR entryPoints[] = {L"psOne", L"psTwo"};
+  LPVOID results[_countof(entryPoints)] = {};
+  VERIFY_SUCCEEDED(pCompiler6->CompileEntryPoints(
+      &source, sharedArgs, _countof(sharedArgs), entryPoints,
+      _countof(entryPoints), nullptr, __uuidof(IDxcResult), results));
+
+  for (size_t i = 0; i < _countof(entryPoints); ++i) {
+    CComPtr<IDxcResult> pMultiResult;
+    pMultiResult.Attach((IDxcResult *)results[i]);
+    VERIFY_IS_NOT_NULL(pMultiResult.p);
+    HRESULT status;
+    VERIFY_SUCCEEDED(pMultiResult->GetStatus(&status));
+    VERIFY_SUCCEEDED(status);
+    CComPtr<IDxcBlob> pMultiObject;
+    VERIFY_SUCCEEDED(pMultiResult->GetResult(&pMultiObject));
+
+    // The same entry compiled on its own must produce the same container.
+    LPCWSTR singleArgs[] = {L"-T", L"ps_6_0", L"-E", entryPoints[i]};
+    CComPtr<IDxcResult> pSingleResult;
+    VERIFY_SUCCEEDED(pCompiler6->Compile(&source, singleArgs,
+                                         _countof(singleArgs), nullptr,
+                                         IID_PPV_ARGS(&pSingleResult)));
+    VERIFY_SUCCEEDED(pSingleResult->GetStatus(&status));
+    VERIFY_SUCCEEDED(status);
+    CComPtr<IDxcBlob> pSingleObject;
+    VERIFY_SUCCEEDED(pSingleResult->GetResult(&pSingleObject));
+
+    VERIFY_ARE_EQUAL(pSingleObject->GetBufferSize(),
+                     pMultiObject->GetBufferSize());
+    VERIFY_ARE_EQUAL(0, memcmp(pSingleObject->GetBufferPointer(),
+                               pMultiObject->GetBufferPointer(),
+                               pSingleObject->GetBufferSize()));
+  }
+}
+
+TEST_F(CompilerTest, CompileEntryPointsWhenInvalidModeThenFails) {
+  CComPtr<IDxcCompiler> pCompiler;
+  CComPtr<IDxcCompiler6> pCompiler6;
+  VERIFY_SUCCEEDED(CreateCompiler(&pCompiler));
+  VERIFY_SUCCEEDED(pCompiler.QueryInterface(&pCompiler6));
+
+  const char *pSourceText =
+      "float4 psOne(float4 pos : SV_Position) : SV_Target {\r\n"
+      "  return pos * 0.5;\r\n"
+      "}\r\n";
+  DxcBuffer source = {};
+  source.Ptr = pSourceText;
+  source.Size = strlen(pSourceText);
+  source.Encoding = CP_UTF8;
+
+  LPCWSTR entryPoints[] = {L"psOne"};
+  LPVOID results[_countof(entryPoints)] = {};
+
+  // -E belongs to the entry point list, not the shared arguments.
+  LPCWSTR argsWithEntry[] = {L"-T", L"ps_6_0", L"-E", L"psOne"};
+  VERIFY_ARE_EQUAL(
+      E_INVALIDARG,
+      pCompiler6->CompileEntryPoints(&source, argsWithEntry,
+                                     _countof(argsWithEntry), entryPoints,
+                                     _countof(entryPoints), nullptr,
+                                     __uuidof(IDxcResult), results));
+  VERIFY_IS_NULL(results[0]);
+
+  // Library targets produce a single library, not per-entry results.
+  LPCWSTR libArgs[] = {L"-T", L"lib_6_3"};
+  VERIFY_ARE_EQUAL(
+      E_INVALIDARG,
+      pCompiler6->CompileEntryPoints(&source, libArgs, _countof(libArgs),
+                                     entryPoints, _countof(entryPoints),
+                                     nullptr, __uuidof(IDxcResult), results));
+  VERIFY_IS_NULL(results[0]);
+}
+
+TEST_F(CompilerTest, IncrementalCompileWhenBodyEditedThenOnlyThatChunkRecompiles) {
+  CComPtr<IDxcIncrementalCompiler> pIncremental;
+  VERIFY_SUCCEEDED(
+      m_dllSupport.CreateInstance(CLSID_DxcIncrementalCompiler, &pIncremental));
+  // The library cache is process-wide; start from a known-empty state.
+  VERIFY_SUCCEEDED(pIncremental->ClearCache());
+
+  // Three chunks: left, right, main. The edit changes only the body of left
+  // and keeps the line structure, so the preprocessed text the other chunks
+  // hash is untouched.
+  const char *pText =
+      "float left(float x) { return x + 1.0; }\r\n"
+      "float right(float x) { return x * 2.0; }\r\n"
+      "float4 main(float4 pos : SV_Position) : SV_Target {\r\n"
+      "  return left(pos.x) + right(pos.y);\r\n"
+      "}\r\n";
+  const char *pEditedText =
+      "float left(float x) { return x + 9.0; }\r\n"
+      "float right(float x) { return x * 2.0; }\r\n"
+      "float4 main(float4 pos : SV_Position) : SV_Target {\r\n"
+      "  return left(pos.x) + right(pos.y);\r\n"
+      "}\r\n";
+
+  UINT32 chunks, hits;
+  IncrementalCompileWithStats(pIncremental, pText, nullptr, 0, nullptr,
+                              &chunks, &hits);
+  VERIFY_ARE_EQUAL(3u, chunks);
+  VERIFY_ARE_EQUAL(0u, hits);
+
+  // Unchanged source: every chunk is a cache hit.
+  IncrementalCompileWithStats(pIncremental, pText, nullptr, 0, nullptr,
+                              &chunks, &hits);
+  VERIFY_ARE_EQUAL(3u, chunks);
+  VERIFY_ARE_EQUAL(3u, hits);
+
+  // One body edited: only that chunk recompiles. The body-stripped header
+  // the later chunks hash did not change, so they stay cached.
+  IncrementalCompileWithStats(pIncremental, pEditedText, nullptr, 0, nullptr,
+                              &chunks, &hits);
+  VERIFY_ARE_EQUAL(3u, chunks);
+  VERIFY_ARE_EQUAL(2u, hits);
+}
+
+TEST_F(CompilerTest, IncrementalCompileWhenDefineEditedThenAffectedChunksRecompile) {
+  CComPtr<IDxcIncrementalCompiler> pIncremental;
+  VERIFY_SUCCEEDED(
+      m_dllSupport.CreateInstance(CLSID_DxcIncrementalCompiler, &pIncremental));
+  VERIFY_SUCCEEDED(pIncremental->ClearCache());
+
+  // SCALE expands only inside the body of scaled; hashing happens on
+  // preprocessed text, so changing its value must invalidate that chunk and
+  // no other.
+  const char *pText =
+      "float plain(float x) { return x * 2.0; }\r\n"
+      "float scaled(float x) { return x * SCALE; }\r\n"
+      "float4 main(float4 pos : SV_Position) : SV_Target {\r\n"
+      "  return plain(pos.x) + scaled(pos.y);\r\n"
+      "}\r\n";
+  DxcDefine initialDefines[] = {{L"SCALE", L"3.0"}};
+  DxcDefine editedDefines[] = {{L"SCALE", L"5.0"}};
+
+  UINT32 chunks, hits;
+  IncrementalCompileWithStats(pIncremental, pText, initialDefines,
+                              _countof(initialDefines), nullptr, &chunks,
+                              &hits);
+  VERIFY_ARE_EQUAL(3u, chunks);
+  VERIFY_ARE_EQUAL(0u, hits);
+
+  IncrementalCompileWithStats(pIncremental, pText, editedDefines,
+                              _countof(editedDefines), nullptr, &chunks,
+                              &hits);
+  VERIFY_ARE_EQUAL(3u, chunks);
+  VERIFY_ARE_EQUAL(2u, hits);
+}
+
+TEST_F(CompilerTest, IncrementalCompileWhenHeaderEditedThenAffectedChunksRecompile) {
+  CComPtr<IDxcIncrementalCompiler> pIncremental;
+  VERIFY_SUCCEEDED(
+      m_dllSupport.CreateInstance(CLSID_DxcIncrementalCompiler, &pIncremental));
+  VERIFY_SUCCEEDED(pIncremental->ClearCache());
+
+  const char *pText =
+      "#include \"consts.h\"\r\n"
+      "float left(float x) { return x + K; }\r\n"
+      "float right(float x) { return x * 2.0; }\r\n"
+      "float4 main(float4 pos : SV_Position) : SV_Target {\r\n"
+      "  return left(pos.x) + right(pos.y);\r\n"
+      "}\r\n";
+
+  UINT32 chunks, hits;
+  {
+    CComPtr<TestIncludeHandler> pInclude =
+        new TestIncludeHandler(m_dllSupport);
+    pInclude->CallResults.emplace_back("static const float K = 1.0;\r\n");
+    IncrementalCompileWithStats(pIncremental, pText, nullptr, 0, pInclude,
+                                &chunks, &hits);
+    VERIFY_ARE_EQUAL(3u, chunks);
+    VERIFY_ARE_EQUAL(0u, hits);
+  }
+
+  // Same header content again: fully cached.
+  {
+    CComPtr<TestIncludeHandler> pInclude =
+        new TestIncludeHandler(m_dllSupport);
+    pInclude->CallResults.emplace_back("static const float K = 1.0;\r\n");
+    IncrementalCompileWithStats(pIncremental, pText, nullptr, 0, pInclude,
+                                &chunks, &hits);
+    VERIFY_ARE_EQUAL(3u, chunks);
+    VERIFY_ARE_EQUAL(3u, hits);
+  }
+
+  // Edited header content: the flattened declaration is part of the first
+  // chunk and of the header every later chunk inherits, so all three
+  // recompile.
+  {
+    CComPtr<TestIncludeHandler> pInclude =
+        new TestIncludeHandler(m_dllSupport);
+    pInclude->CallResults.emplace_back("static const float K = 2.0;\r\n");
+    IncrementalCompileWithStats(pIncremental, pText, nullptr, 0, pInclude,
+                                &chunks, &hits);
+    VERIFY_ARE_EQUAL(3u, chunks);
+    VERIFY_ARE_EQUAL(0u, hits);
+  }
+}
+
 TEST_F(CompilerTest, CompileWhenEmptyThenFails) {
   CComPtr<IDxcCompiler> pCompiler;
   CComPtr<IDxcOperationResult> pResult;
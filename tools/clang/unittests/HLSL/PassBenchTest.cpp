@@ -0,0 +1,309 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// PassBenchTest.cpp                                                         //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Microbenchmarks for individual optimizer passes. Each pass is timed in    //
+// isolation via the optimizer's pause/resume mechanism: the pipeline runs   //
+// up to the pass once (untimed), then the single pass is replayed from the  //
+// paused module with warmup and repetition. Results are written as JSON so  //
+// compile-time regressions can be pinned on a pass without bisecting.       //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef UNICODE
+#define UNICODE
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "dxc/Support/WinIncludes.h"
+#include "dxc/dxcapi.h"
+
+#include "dxc/Test/DxcTestUtils.h"
+#include "dxc/Test/HlslTestUtils.h"
+
+#include "dxc/Support/Global.h"
+#include "dxc/Support/Unicode.h"
+#include "dxc/Support/dxcapi.use.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace std;
+using namespace hlsl_test;
+
+///////////////////////////////////////////////////////////////////////////////
+// Pass microbenchmark cases.
+
+namespace {
+
+// Passes we hold to a budget. OptName matches the -Odump spelling up to the
+// first option delimiter; Name is the key reported in the JSON output.
+struct BenchPassInfo {
+  LPCWSTR OptName;
+  const char *Name;
+};
+
+const BenchPassInfo kBenchPasses[] = {
+    {L"-scalarrepl-param-hlsl", "SROA_Parameter_HLSL"},
+    {L"-hlmatrixlower", "HLMatrixLowerPass"},
+    {L"-dxilgen", "DxilGenerationPass"},
+    {L"-dxil-loop-unroll", "DxilLoopUnroll"},
+    {L"-hlsl-dxil-condense", "DxilCondenseResources"},
+};
+
+// Matrix math, resource access and a rolled loop so every benchmarked pass
+// has real work to do.
+const char kFixtureSource[] =
+    "cbuffer Constants : register(b0) {\r\n"
+    "  float4x4 g_World;\r\n"
+    "  float4x4 g_ViewProj;\r\n"
+    "  uint g_LightCount;\r\n"
+    "}\r\n"
+    "Texture2D g_Tex : register(t0);\r\n"
+    "SamplerState g_Sampler : register(s0);\r\n"
+    "StructuredBuffer<float4> g_Lights : register(t1);\r\n"
+    "struct Vertex { float4 pos; float4 uv; };\r\n"
+    "float4 shade(Vertex v) {\r\n"
+    "  float4 wpos = mul(v.pos, g_World);\r\n"
+    "  float4 acc = g_Tex.SampleLevel(g_Sampler, v.uv.xy, 0);\r\n"
+    "  for (uint i = 0; i < g_LightCount; ++i) {\r\n"
+    "    float4 l = g_Lights[i];\r\n"
+    "    acc += saturate(dot(wpos.xyz, l.xyz)) * l.w;\r\n"
+    "  }\r\n"
+    "  return mul(acc, g_ViewProj);\r\n"
+    "}\r\n"
+    "float4 main(float4 pos : POSITION, float4 uv : TEXCOORD0) : SV_Target "
+    "{\r\n"
+    "  Vertex v = { pos, uv };\r\n"
+    "  return shade(v);\r\n"
+    "}";
+
+struct BenchStats {
+  double MinMs;
+  double MedianMs;
+  double MeanMs;
+};
+
+BenchStats Summarize(std::vector<double> &samplesMs) {
+  std::sort(samplesMs.begin(), samplesMs.end());
+  BenchStats stats;
+  stats.MinMs = samplesMs.front();
+  stats.MedianMs = samplesMs[samplesMs.size() / 2];
+  double total = 0;
+  for (double sample : samplesMs)
+    total += sample;
+  stats.MeanMs = total / samplesMs.size();
+  return stats;
+}
+
+} // namespace
+
+#ifdef _WIN32
+class PassBenchTest {
+#else
+class PassBenchTest : public ::testing::Test {
+#endif
+public:
+  BEGIN_TEST_CLASS(PassBenchTest)
+    // Timing is the product here; keep other tests off the machine's cores.
+    TEST_CLASS_PROPERTY(L"Parallel", L"false")
+    TEST_METHOD_PROPERTY(L"Priority", L"1")
+  END_TEST_CLASS()
+
+  TEST_CLASS_SETUP(InitSupport);
+
+  TEST_METHOD(PassBenchTimesIndividualPasses)
+
+  dxc::DxcDllSupport m_dllSupport;
+
+  void VerifyOperationSucceeded(IDxcOperationResult *pResult) {
+    HRESULT result;
+    VERIFY_SUCCEEDED(pResult->GetStatus(&result));
+    if (FAILED(result)) {
+      CComPtr<IDxcBlobEncoding> pErrors;
+      VERIFY_SUCCEEDED(pResult->GetErrorBuffer(&pErrors));
+      CA2W errorsWide(BlobToUtf8(pErrors).c_str(), CP_UTF8);
+      WEX::Logging::Log::Comment(errorsWide);
+    }
+    VERIFY_SUCCEEDED(result);
+  }
+
+  double TimeOptimizerRun(IDxcOptimizer *pOptimizer, IDxcBlob *pInput,
+                          std::vector<LPCWSTR> &passes) {
+    CComPtr<IDxcBlob> pOutput;
+    auto start = std::chrono::steady_clock::now();
+    VERIFY_SUCCEEDED(pOptimizer->RunOptimizer(
+        pInput, passes.data(), (UINT32)passes.size(), &pOutput, nullptr));
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+  }
+
+  BenchStats RunTimed(IDxcOptimizer *pOptimizer, IDxcBlob *pInput,
+                      std::vector<LPCWSTR> &passes, unsigned warmup,
+                      unsigned iterations) {
+    for (unsigned i = 0; i < warmup; ++i)
+      TimeOptimizerRun(pOptimizer, pInput, passes);
+    std::vector<double> samplesMs;
+    for (unsigned i = 0; i < iterations; ++i)
+      samplesMs.push_back(TimeOptimizerRun(pOptimizer, pInput, passes));
+    return Summarize(samplesMs);
+  }
+};
+
+bool PassBenchTest::InitSupport() {
+  if (!m_dllSupport.IsEnabled()) {
+    VERIFY_SUCCEEDED(m_dllSupport.Initialize());
+  }
+  return true;
+}
+
+// True when a dumped pass list entry names the given pass, with or without
+// trailing ',option=value' arguments.
+static bool EntryIsPass(LPCWSTR pEntry, LPCWSTR pOptName) {
+  size_t len = wcslen(pOptName);
+  return 0 == wcsncmp(pEntry, pOptName, len) &&
+         (pEntry[len] == L'\0' || pEntry[len] == L',');
+}
+
+TEST_F(PassBenchTest, PassBenchTimesIndividualPasses) {
+  CComPtr<IDxcCompiler> pCompiler;
+  CComPtr<IDxcOptimizer> pOptimizer;
+  CComPtr<IDxcOperationResult> pResult;
+  CComPtr<IDxcBlobEncoding> pSource;
+  CComPtr<IDxcBlob> pOptDump;
+  CComPtr<IDxcBlob> pHighLevelBlob;
+
+  VERIFY_SUCCEEDED(m_dllSupport.CreateInstance(CLSID_DxcCompiler, &pCompiler));
+  VERIFY_SUCCEEDED(
+      m_dllSupport.CreateInstance(CLSID_DxcOptimizer, &pOptimizer));
+
+  unsigned warmup = 2;
+  unsigned iterations = 10;
+  if (const char *pIters = std::getenv("HLSL_PASS_BENCH_ITERS"))
+    iterations = std::max(1, atoi(pIters));
+
+  Utf8ToBlob(m_dllSupport, kFixtureSource, &pSource);
+  std::vector<LPCWSTR> compileArgs = {L"/Vd", L"/O3"};
+
+  // Get the pass list this configuration would run.
+  compileArgs.emplace_back(L"/Odump");
+  VERIFY_SUCCEEDED(pCompiler->Compile(pSource, L"bench.hlsl", L"main",
+                                      L"ps_6_0", compileArgs.data(),
+                                      (UINT32)compileArgs.size(), nullptr, 0,
+                                      nullptr, &pResult));
+  VerifyOperationSucceeded(pResult);
+  VERIFY_SUCCEEDED(pResult->GetResult(&pOptDump));
+  pResult.Release();
+  std::string passes = BlobToUtf8(pOptDump);
+  CA2W passesW(passes.c_str(), CP_UTF8);
+  compileArgs.pop_back();
+
+  // Get the high-level compile of the fixture.
+  compileArgs.emplace_back(L"/fcgl");
+  VERIFY_SUCCEEDED(pCompiler->Compile(pSource, L"bench.hlsl", L"main",
+                                      L"ps_6_0", compileArgs.data(),
+                                      (UINT32)compileArgs.size(), nullptr, 0,
+                                      nullptr, &pResult));
+  VerifyOperationSucceeded(pResult);
+  VERIFY_SUCCEEDED(pResult->GetResult(&pHighLevelBlob));
+  pResult.Release();
+
+  std::vector<LPCWSTR> passList;
+  SplitPassList(passesW.m_psz, passList);
+
+  std::string json;
+  llvm::raw_string_ostream jsonStream(json);
+  jsonStream << "{\n  \"fixture\": \"bench.hlsl\",\n  \"iterations\": "
+             << iterations << ",\n  \"passes\": [";
+  bool bFirstEntry = true;
+
+  for (const BenchPassInfo &benchPass : kBenchPasses) {
+    // Find the pass in the dumped list and whether it sits in the
+    // per-function prepass section.
+    size_t passIdx = passList.size();
+    bool bInFnSection = false;
+    bool bFnSection = false;
+    for (size_t i = 0; i < passList.size(); ++i) {
+      if (0 == wcscmp(passList[i], L"-opt-fn-passes")) {
+        bFnSection = true;
+        continue;
+      }
+      if (0 == wcscmp(passList[i], L"-opt-mod-passes")) {
+        bFnSection = false;
+        continue;
+      }
+      if (EntryIsPass(passList[i], benchPass.OptName)) {
+        passIdx = i;
+        bInFnSection = bFnSection;
+        break;
+      }
+    }
+
+    if (!bFirstEntry)
+      jsonStream << ",";
+    bFirstEntry = false;
+    jsonStream << "\n    { \"pass\": \"" << benchPass.Name << "\"";
+
+    if (passIdx == passList.size()) {
+      LogCommentFmt(L"Pass %S not in this configuration's pipeline; skipped",
+                    benchPass.Name);
+      jsonStream << ", \"in_pipeline\": false }";
+      continue;
+    }
+
+    // Run the pipeline up to the pass once and pause, so the timed runs see
+    // the module exactly as the pass would in a real compile.
+    CComPtr<IDxcBlob> pPausedModule;
+    std::vector<LPCWSTR> prefixList(passList.begin(),
+                                    passList.begin() + passIdx);
+    prefixList.push_back(L"-opt-mod-passes");
+    prefixList.push_back(L"-hlsl-passes-pause");
+    VERIFY_SUCCEEDED(pOptimizer->RunOptimizer(
+        pHighLevelBlob, prefixList.data(), (UINT32)prefixList.size(),
+        &pPausedModule, nullptr));
+
+    // Baseline measures resume plus blob round-trip; the pass run includes
+    // the same overhead, so the difference isolates the pass itself.
+    std::vector<LPCWSTR> baselineList = {L"-hlsl-passes-resume"};
+    std::vector<LPCWSTR> timedList = baselineList;
+    if (bInFnSection)
+      timedList.push_back(L"-opt-fn-passes");
+    timedList.push_back(passList[passIdx]);
+
+    BenchStats baseline =
+        RunTimed(pOptimizer, pPausedModule, baselineList, warmup, iterations);
+    BenchStats timed =
+        RunTimed(pOptimizer, pPausedModule, timedList, warmup, iterations);
+
+    LogCommentFmt(L"%S: min %f ms, median %f ms, mean %f ms (baseline min "
+                  L"%f ms) over %u iterations",
+                  benchPass.Name, timed.MinMs, timed.MedianMs, timed.MeanMs,
+                  baseline.MinMs, iterations);
+
+    jsonStream << ", \"in_pipeline\": true"
+               << ", \"min_ms\": " << timed.MinMs
+               << ", \"median_ms\": " << timed.MedianMs
+               << ", \"mean_ms\": " << timed.MeanMs
+               << ", \"baseline_min_ms\": " << baseline.MinMs << " }";
+  }
+
+  jsonStream << "\n  ]\n}\n";
+  jsonStream.flush();
+
+  const char *pOutPath = std::getenv("HLSL_PASS_BENCH_OUT");
+  if (!pOutPath)
+    pOutPath = "pass-bench.json";
+  std::error_code EC;
+  llvm::raw_fd_ostream outFile(pOutPath, EC, llvm::sys::fs::F_Text);
+  VERIFY_IS_TRUE(!EC);
+  outFile << json;
+}